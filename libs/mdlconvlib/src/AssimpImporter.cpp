@@ -866,7 +866,7 @@ void AssimpImporter::importAnimations()
 				const aiVectorKey& key = asmpNodeAnim->mPositionKeys[t];
 
 				float keyTime = (float)(key.mTime / asmpAnim->mTicksPerSecond);
-				nodeKeyFrames.positionKeyFrames[keyTime] = fromAssimp(key.mValue);
+				nodeKeyFrames.positionKeyFrames.setKey(keyTime, fromAssimp(key.mValue));
 			}
 
 			// Rotation.
@@ -874,7 +874,7 @@ void AssimpImporter::importAnimations()
 				const aiQuatKey& key = asmpNodeAnim->mRotationKeys[t];
 
 				float keyTime = (float)(key.mTime / asmpAnim->mTicksPerSecond);
-				nodeKeyFrames.rotationKeyFrames[keyTime] = fromAssimp(key.mValue);
+				nodeKeyFrames.rotationKeyFrames.setKey(keyTime, fromAssimp(key.mValue));
 			}
 
 			// Scaling
@@ -882,7 +882,7 @@ void AssimpImporter::importAnimations()
 				const aiVectorKey& key = asmpNodeAnim->mScalingKeys[t];
 
 				float keyTime = (float)(key.mTime / asmpAnim->mTicksPerSecond);
-				nodeKeyFrames.scalingKeyFrames[keyTime] = fromAssimp(key.mValue);
+				nodeKeyFrames.scalingKeyFrames.setKey(keyTime, fromAssimp(key.mValue));
 			}
 
 			// Save the keyframes to the animation.
@@ -1356,7 +1356,7 @@ void FBXSDKParser::importAnimations()
 							vec3f const position =
 							    vec3f((float)fbxPos.mData[0], (float)fbxPos.mData[1], (float)fbxPos.mData[2]);
 
-							nodeKeyFrames.positionKeyFrames[keyTimeSeconds] = position;
+							nodeKeyFrames.positionKeyFrames.setKey(keyTimeSeconds, position);
 						}
 					}
 				}
@@ -1377,7 +1377,7 @@ void FBXSDKParser::importAnimations()
 							// Convert the keyframe to our own format and save it.
 							float const keyTimeSeconds = (float)fbxKeyTime.GetSecondDouble() - animationStart;
 							quatf const rotation = quatFromFbx(FbxEuler::eOrderXYZ, fRotation);
-							nodeKeyFrames.rotationKeyFrames[keyTimeSeconds] = rotation;
+							nodeKeyFrames.rotationKeyFrames.setKey(keyTimeSeconds, rotation);
 						}
 					}
 				}
@@ -1400,7 +1400,7 @@ void FBXSDKParser::importAnimations()
 							float const keyTimeSeconds = (float)fbxKeyTime.GetSecondDouble() - animationStart;
 							vec3f const scaling =
 							    vec3f((float)fScaling.mData[0], (float)fScaling.mData[1], (float)fScaling.mData[2]);
-							nodeKeyFrames.scalingKeyFrames[keyTimeSeconds] = scaling;
+							nodeKeyFrames.scalingKeyFrames.setKey(keyTimeSeconds, scaling);
 						}
 					}
 				}
@@ -1,196 +1,777 @@
 #include "AudioDevice.h"
+#include "sge_log/Log.h"
 #include "sge_utils/io/FileStream.h"
+#include "sge_utils/math/common.h"
+#include "sge_utils/math/simdMath.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 
 #define SAMPLE_FORMAT ma_format_f32
-#define CHANNEL_COUNT 2
-#define SAMPLE_RATE ma_standard_sample_rate_44100
 
 namespace sge {
 
-struct ma_mutex_raii {
-	[[nodiscard]] ma_mutex_raii(ma_mutex& mtx)
-	    : mtx(mtx)
-	{
-		ma_mutex_lock(&mtx);
+// The mixing assumes stereo output, see addScaledStereoBatch.
+static_assert(kAudioNumChannels == 2, "The mixed output is expected to be stereo");
+
+/// The amount of frames mixed or decoded at once.
+static constexpr int kAudioChunkFrames = 4096;
+
+/// The capacity of the ring buffer of each streamed voice, about 1.5 seconds.
+static constexpr int kStreamedFramesCapacity = kAudioSampleRate;
+
+/// The amount of frames decoded by the game thread when a streamed voice starts playing,
+/// so it doesn't start with silence while waiting for the streaming thread.
+static constexpr int kStreamedFramesDecodedOnPlay = kAudioSampleRate / 4;
+
+/// How often the streaming thread refills the ring buffers.
+static constexpr int kStreamingIntervalMs = 10;
+
+/// AudioVoice is one playback of an AudioDecoder.
+/// It is allocated by the game thread when the playback starts, used by the audio thread until it retires it,
+/// and freed by the game thread after that.
+struct AudioVoice {
+	AudioDataPtr audioData;
+
+	// Game thread only.
+	AudioDecoder* owner = nullptr;
+	int iSlot = -1;
+	uint64 startFrame = 0;
+
+	// Written by the game thread, read by the audio thread.
+	std::atomic<float> gainLeft = 1.f;
+	std::atomic<float> gainRight = 1.f;
+	/// The playback speed, changed by the doppler effect. Used only by pre-decoded voices.
+	std::atomic<float> pitch = 1.f;
+	std::atomic<bool> isLooping = false;
+	/// Virtual voices keep their play position, but are not mixed.
+	std::atomic<bool> isVirtual = false;
+
+	// Written by the audio thread, read by the game thread when the voice gets stopped.
+	/// The position in the data, in frames. Could be past the end of the data for looping streamed voices.
+	std::atomic<uint64> playPosition = 0;
+
+	// Audio thread only.
+	/// The position in AudioData::getPcmFrames() of pre-decoded voices, fractional when the pitch isn't 1.
+	double pcmPosition = 0.0;
+	/// The frames consumed from @streamedFrames by streamed voices.
+	uint64 numStreamedFramesConsumed = 0;
+
+	// Streamed voices only. The streaming thread decodes the data with @decoder and pushes the frames
+	// to @streamedFrames, the audio thread consumes them.
+	bool isStreamed = false;
+	ma_decoder decoder;
+	SPSCQueue<float> streamedFrames;
+	std::atomic<bool> isStreamEnded = false;
+	/// Streaming thread only. The frames decoded since the last time the decoder seeked to the beginning.
+	uint64 numFramesDecodedSinceLoop = 0;
+};
+
+/// Decodes up to @maxFrames frames of a streamed voice into its ring buffer. Stops earlier if the ring buffer
+/// gets full or the stream ends.
+static void decodeStreamedFrames(AudioVoice& voice, std::vector<float>& decodingTemp, int maxFrames)
+{
+	const int tempCapInFrames = int(decodingTemp.size()) / kAudioNumChannels;
+
+	while (maxFrames > 0 && !voice.isStreamEnded.load(std::memory_order_relaxed)) {
+		const int numFreeFrames =
+		    (voice.streamedFrames.capacity() - voice.streamedFrames.size()) / kAudioNumChannels;
+		const int numFramesToDecode = minOf(minOf(numFreeFrames, tempCapInFrames), maxFrames);
+		if (numFramesToDecode <= 0) {
+			break;
+		}
+
+		const ma_uint64 numDecoded =
+		    ma_decoder_read_pcm_frames(&voice.decoder, decodingTemp.data(), ma_uint64(numFramesToDecode));
+		voice.streamedFrames.pushMany(decodingTemp.data(), int(numDecoded) * kAudioNumChannels);
+		voice.numFramesDecodedSinceLoop += numDecoded;
+		maxFrames -= int(numDecoded);
+
+		if (numDecoded < ma_uint64(numFramesToDecode)) {
+			// Reached the end of the data. Looping voices start over, unless there is nothing to decode at all.
+			if (voice.isLooping.load(std::memory_order_relaxed) && voice.numFramesDecodedSinceLoop > 0) {
+				ma_decoder_seek_to_pcm_frame(&voice.decoder, 0);
+				voice.numFramesDecodedSinceLoop = 0;
+			}
+			else {
+				voice.isStreamEnded.store(true, std::memory_order_release);
+			}
+		}
 	}
+}
 
-	~ma_mutex_raii() { ma_mutex_unlock(&mtx); }
+/// Returns the volume multiplier of a 3D sound at the specified distance from the listener.
+static float computeAudioAttenuation(AudioAttenuationCurve curve, float distance, float minDistance, float maxDistance)
+{
+	if (distance <= minDistance) {
+		return 1.f;
+	}
 
-	ma_mutex& mtx;
-};
+	if (distance >= maxDistance) {
+		return 0.f;
+	}
+
+	switch (curve) {
+		case audioAttenuationCurve_inverse: {
+			// Shift and scale min distance / distance, so it is 1 at the min distance and 0 at the max one.
+			const float inverseAtMax = minDistance / maxDistance;
+			return (minDistance / distance - inverseAtMax) / (1.f - inverseAtMax);
+		}
+		case audioAttenuationCurve_linear: {
+			return 1.f - (distance - minDistance) / (maxDistance - minDistance);
+		}
+		default: {
+			return 1.f;
+		}
+	}
+}
+
+/// Returns the change of the playback speed caused by the doppler effect.
+/// @param [in] toListener the normalized direction from the sound to the listener.
+static float computeDopplerPitch(
+    const vec3f& toListener, const vec3f& soundVelocity, const vec3f& listenerVelocity, float dopplerFactor)
+{
+	// In units per second, assuming that a unit is a meter.
+	const float kSpeedOfSound = 343.f;
+
+	// Positive speeds are in the direction from the sound to the listener. They are clamped, as speeds near
+	// the speed of sound lead to extreme pitches.
+	const float kMaxSpeed = kSpeedOfSound * 0.5f;
+	const float soundSpeed = clamp(dot(soundVelocity, toListener) * dopplerFactor, -kMaxSpeed, kMaxSpeed);
+	const float listenerSpeed = clamp(dot(listenerVelocity, toListener) * dopplerFactor, -kMaxSpeed, kMaxSpeed);
+
+	return (kSpeedOfSound - listenerSpeed) / (kSpeedOfSound - soundSpeed);
+}
 
 //------------------------------------------------------------------
 // AudioDevice
 //------------------------------------------------------------------
-void AudioDevice::createAudioDevice()
+void AudioDevice::createAudioDevice(int maxVoices)
 {
-	ma_device_config deviceConfig;
+	create(maxVoices, true);
+}
 
-	deviceConfig = ma_device_config_init(ma_device_type_playback);
-	deviceConfig.playback.format = SAMPLE_FORMAT;
-	deviceConfig.playback.channels = CHANNEL_COUNT;
-	deviceConfig.sampleRate = SAMPLE_RATE;
-	deviceConfig.dataCallback = miniaudioDataCallback;
-	deviceConfig.pUserData = this;
+void AudioDevice::createNullAudioDevice(int maxVoices)
+{
+	create(maxVoices, false);
+}
 
-	if (ma_device_init(NULL, &deviceConfig, &device) != MA_SUCCESS) {
-		sgeAssertFalse("Failed to initialize AudioDevice");
-		ma_device_uninit(&device);
-	}
+void AudioDevice::create(int maxVoices, bool hasOutputDevice)
+{
+	clear();
+
+	sgeAssert(maxVoices > 0);
+	m_slots.resize(maxVoices);
+	m_voices.resize(maxVoices, nullptr);
+	m_mixTemp.resize(kAudioChunkFrames * kAudioNumChannels);
+
+	// Every allocated voice is retired once, so the retired voices queue can never overflow.
+	m_commands.create(maxVoices * 4);
+	m_retiredVoices.create(maxVoices * 4);
+
+	m_isCreated = true;
 
-	ma_mutex_init(&mutexDataLock);
+	m_shouldStopStreaming = false;
+	m_streamingThread = std::thread([this]() -> void { streamingThreadMain(); });
+
+	if (hasOutputDevice) {
+		ma_device_config deviceConfig = ma_device_config_init(ma_device_type_playback);
+		deviceConfig.playback.format = SAMPLE_FORMAT;
+		deviceConfig.playback.channels = kAudioNumChannels;
+		deviceConfig.sampleRate = kAudioSampleRate;
+		deviceConfig.dataCallback = miniaudioDataCallback;
+		deviceConfig.pUserData = this;
+
+		if (ma_device_init(NULL, &deviceConfig, &device) != MA_SUCCESS) {
+			sgeAssertFalse("Failed to initialize AudioDevice");
+			ma_device_uninit(&device);
+		}
+		else {
+			m_hasOutputDevice = true;
+		}
+	}
 }
 
 void AudioDevice::startAudioDevice()
 {
+	if (!m_hasOutputDevice) {
+		return;
+	}
+
 	if (ma_device_start(&device) != MA_SUCCESS) {
 		sgeAssertFalse("Failed to initialize AudioDevice");
 		ma_device_uninit(&device);
+		m_hasOutputDevice = false;
 	}
 }
 
 void AudioDevice::clear()
 {
-	ma_device_uninit(&device);
-	ma_mutex_uninit(&mutexDataLock);
+	if (!m_isCreated) {
+		return;
+	}
+
+	// Stop the audio and the streaming threads. After that the game thread is the only one using the voices.
+	if (m_hasOutputDevice) {
+		ma_device_uninit(&device);
+		m_hasOutputDevice = false;
+	}
+
+	{
+		const std::lock_guard<std::mutex> lock(m_streamsLock);
+		m_shouldStopStreaming = true;
+	}
+	m_streamingWakeUp.notify_all();
+	m_streamingThread.join();
+
+	// Every allocated voice is either used by the audio thread, retired or still waiting to be played.
+	std::vector<AudioVoice*> voicesToDelete;
+	for (AudioVoice* voice : m_voices) {
+		if (voice) {
+			voicesToDelete.push_back(voice);
+		}
+	}
+
+	AudioVoice* retiredVoice = nullptr;
+	while (m_retiredVoices.tryPop(retiredVoice)) {
+		voicesToDelete.push_back(retiredVoice);
+	}
+
+	Command command;
+	while (m_commands.tryPop(command)) {
+		if (command.type == commandType_play) {
+			voicesToDelete.push_back(command.voice);
+		}
+	}
+
+	for (const Command& pendingCommand : m_pendingCommands) {
+		if (pendingCommand.type == commandType_play) {
+			voicesToDelete.push_back(pendingCommand.voice);
+		}
+	}
+
+	for (AudioVoice* voice : voicesToDelete) {
+		deleteVoice(voice);
+	}
+
+	sgeAssert(m_numAllocatedVoices == 0);
+
+	m_slots.clear();
+	m_pendingCommands.clear();
+	m_voices.clear();
+	m_streamedVoices.clear();
+	m_numAllocatedVoices = 0;
+	m_isCreated = false;
 }
 
 void AudioDevice::play(AudioDecoder* decoder, bool ifAlreadyPlayingSeekToBegining)
 {
-	if (decoder) {
-		const ma_mutex_raii lock(mutexDataLock);
+	if (!m_isCreated || decoder == nullptr || !decoder->audioData || decoder->audioData->isEmpty()) {
+		return;
+	}
+
+	freeRetiredVoices();
+
+	if (decoder->playingDevice == this) {
+		// The sound is already playing.
+		return;
+	}
+
+	if (decoder->playingDevice != nullptr) {
+		sgeAssert(false && "AudioDecoder could be played only on one device!");
+		return;
+	}
+
+	if (ifAlreadyPlayingSeekToBegining) {
+		decoder->m_resumeFrame = 0;
+	}
+
+	if (m_numAllocatedVoices >= m_retiredVoices.capacity()) {
+		// The audio thread isn't keeping up with the play and stop requests.
+		sgeLogWarn("AudioDevice: too many sounds started at once, a sound was skipped.\n");
+		return;
+	}
+
+	const int iSlot = findSlotForNewVoice(decoder->state.priority);
+	if (iSlot < 0) {
+		// All voices are playing sounds with higher priority.
+		return;
+	}
+
+	const AudioData& audioData = *decoder->audioData;
+
+	AudioVoice* const voice = new AudioVoice();
+	voice->audioData = decoder->audioData;
+	voice->owner = decoder;
+	voice->iSlot = iSlot;
+	voice->startFrame = decoder->m_resumeFrame < audioData.getNumFrames() ? decoder->m_resumeFrame : 0;
+	voice->playPosition.store(voice->startFrame, std::memory_order_relaxed);
 
-		// if (decoder->playingDevice != nullptr) {
-		//	sgeAssert(false && "AudioDecoder could be played only on one device!");
-		//	return;
-		//}
+	// The limit of audible voices is applied by the next update.
+	const float loudness = applyVoiceState(*voice, *decoder);
+	voice->isVirtual.store(loudness < m_virtualizationThreshold, std::memory_order_relaxed);
 
-		if (decoder->playingDevice == this) {
-			// The sound is already playing.
+	if (audioData.isPreDecoded()) {
+		voice->pcmPosition = double(voice->startFrame);
+	}
+	else {
+		ma_decoder_config decoderConfig = ma_decoder_config_init(SAMPLE_FORMAT, kAudioNumChannels, kAudioSampleRate);
+		const std::vector<char>& encodedData = audioData.getData();
+		if (ma_decoder_init_memory(encodedData.data(), encodedData.size(), &decoderConfig, &voice->decoder) !=
+		    MA_SUCCESS) {
+			sgeAssertFalse("Failed to initialize the decoder of a streamed voice");
+			delete voice;
 			return;
 		}
 
-		if (ifAlreadyPlayingSeekToBegining) {
-			decoder->seekToBegining_noLock();
+		voice->isStreamed = true;
+		voice->streamedFrames.create(kStreamedFramesCapacity * kAudioNumChannels);
+		if (voice->startFrame != 0) {
+			ma_decoder_seek_to_pcm_frame(&voice->decoder, voice->startFrame);
 		}
 
+		std::vector<float> decodingTemp(kAudioChunkFrames * kAudioNumChannels);
+		decodeStreamedFrames(*voice, decodingTemp, kStreamedFramesDecodedOnPlay);
 
-		decoder->playingDevice = this;
-		m_playingDecoders.insert(decoder);
+		{
+			const std::lock_guard<std::mutex> lock(m_streamsLock);
+			m_streamedVoices.push_back(voice);
+		}
+		m_streamingWakeUp.notify_one();
 	}
+
+	m_numAllocatedVoices++;
+
+	m_slots[iSlot].voice = voice;
+	m_slots[iSlot].priority = decoder->state.priority;
+	m_slots[iSlot].playIndex = m_nextPlayIndex++;
+
+	decoder->playingDevice = this;
+	decoder->m_voice = voice;
+
+	Command command;
+	command.type = commandType_play;
+	command.iSlot = iSlot;
+	command.voice = voice;
+	postCommand(command);
 }
 
 void AudioDevice::stop(AudioDecoder* decoder)
 {
-	const ma_mutex_raii lock(mutexDataLock);
-	stop_noMutexLock(decoder);
+	if (decoder == nullptr || decoder->playingDevice == nullptr) {
+		return;
+	}
+
+	if (decoder->playingDevice != this) {
+		sgeAssert(false && "AudioDecoder could be played only on one device!");
+		return;
+	}
+
+	freeRetiredVoices();
+
+	// The voice might have finished playing by itself, in that case there is nothing to stop.
+	if (decoder->m_voice) {
+		stopVoice(decoder->m_voice);
+	}
 }
 
-void AudioDevice::stop_noMutexLock(AudioDecoder* decoder)
+void AudioDevice::update()
 {
-	if (decoder) {
-		if (decoder->playingDevice != this) {
-			sgeAssert(false && "AudioDecoder could be played only on one device!");
-			return;
-		}
+	if (!m_isCreated) {
+		return;
+	}
 
-		for (auto itr = m_playingDecoders.begin(); itr != m_playingDecoders.end(); itr++) {
-			if (*itr == decoder) {
-				m_playingDecoders.erase(itr);
-				decoder->playingDevice = nullptr;
-				break;
+	freeRetiredVoices();
+
+	m_audibleVoicesTemp.clear();
+	for (const VoiceSlot& slot : m_slots) {
+		if (slot.voice && slot.voice->owner) {
+			const float loudness = applyVoiceState(*slot.voice, *slot.voice->owner);
+			if (loudness >= m_virtualizationThreshold) {
+				m_audibleVoicesTemp.emplace_back(loudness, slot.voice);
+			}
+			else {
+				slot.voice->isVirtual.store(true, std::memory_order_relaxed);
 			}
 		}
 	}
+
+	// If there are too many audible voices, mix only the loudest ones.
+	m_numAudibleVoices = minOf(int(m_audibleVoicesTemp.size()), maxOf(m_maxAudibleVoices, 0));
+	if (m_numAudibleVoices < int(m_audibleVoicesTemp.size())) {
+		std::nth_element(
+		    m_audibleVoicesTemp.begin(),
+		    m_audibleVoicesTemp.begin() + m_numAudibleVoices,
+		    m_audibleVoicesTemp.end(),
+		    [](const auto& a, const auto& b) -> bool { return a.first > b.first; });
+	}
+
+	for (int t = 0; t < int(m_audibleVoicesTemp.size()); ++t) {
+		m_audibleVoicesTemp[t].second->isVirtual.store(t >= m_numAudibleVoices, std::memory_order_relaxed);
+	}
+
+	flushPendingCommands();
 }
 
-bool AudioDevice::readFramesFromDecoder(AudioDecoder& decoder, float* output, uint32 frameCount)
+float AudioDevice::applyVoiceState(AudioVoice& voice, const AudioDecoder& decoder) const
 {
-	// Caution:
-	// The fn assumes that @mutexDataLock is already locked!
-
-	bool isPlaybackDone = false;
-	const ma_uint32 tempCapInFrames = ma_uint32(decodingTemp.size()) / CHANNEL_COUNT;
+	const AudioDecoder::State& state = decoder.state;
+
+	float gainLeft = state.volume;
+	float gainRight = state.volume;
+	float pitch = 1.f;
+
+	if (state.is3D) {
+		const vec3f toSound = state.position - m_listener.position;
+		const float distance = toSound.length();
+		const float attenuation =
+		    computeAudioAttenuation(state.attenuation, distance, state.minDistance, state.maxDistance);
+
+		// Equal-power panning, scaled so sounds in front of the listener are at full volume in both channels.
+		// Sounds at the position of the listener have no direction, they are not panned.
+		float pan = 0.f;
+		if (distance > 1e-3f) {
+			const vec3f right = cross(m_listener.forward, m_listener.up).normalized0();
+			pan = clamp(dot(toSound / distance, right), -1.f, 1.f);
+		}
 
-	decoder.m_syncState = decoder.state;
+		const float panAngle = (pan + 1.f) * (sgePi * 0.25f);
+		gainLeft *= attenuation * minOf(1.f, cosf(panAngle) * sqrtf(2.f));
+		gainRight *= attenuation * minOf(1.f, sinf(panAngle) * sqrtf(2.f));
 
-	ma_uint64 totalFramesRead = 0;
-	while (totalFramesRead < frameCount) {
-		const ma_uint64 totalFramesRemaining = frameCount - totalFramesRead;
-		ma_uint64 framesToReadThisIteration = tempCapInFrames;
-		if (framesToReadThisIteration > totalFramesRemaining) {
-			framesToReadThisIteration = totalFramesRemaining;
+		if (state.dopplerFactor > 0.f && distance > 1e-3f) {
+			pitch = computeDopplerPitch(-toSound / distance, state.velocity, m_listener.velocity, state.dopplerFactor);
 		}
+	}
+
+	voice.gainLeft.store(gainLeft, std::memory_order_relaxed);
+	voice.gainRight.store(gainRight, std::memory_order_relaxed);
+	voice.pitch.store(pitch, std::memory_order_relaxed);
+	voice.isLooping.store(state.isLooping, std::memory_order_relaxed);
+
+	return maxOf(gainLeft, gainRight);
+}
+
+int AudioDevice::getNumPlayingVoices() const
+{
+	int numPlaying = 0;
+	for (const VoiceSlot& slot : m_slots) {
+		numPlaying += slot.voice != nullptr ? 1 : 0;
+	}
+	return numPlaying;
+}
+
+void AudioDevice::stopVoice(AudioVoice* voice)
+{
+	if (AudioDecoder* const owner = voice->owner) {
+		// Remember where the voice was, so playing the decoder again could continue from there.
+		const uint64 numFrames = voice->audioData->getNumFrames();
+		const uint64 playPosition = voice->playPosition.load(std::memory_order_relaxed);
+		owner->m_resumeFrame = numFrames > 0 ? playPosition % numFrames : 0;
+		owner->playingDevice = nullptr;
+		owner->m_voice = nullptr;
+		voice->owner = nullptr;
+	}
+
+	if (m_slots[voice->iSlot].voice == voice) {
+		m_slots[voice->iSlot] = VoiceSlot();
+	}
+
+	Command command;
+	command.type = commandType_stop;
+	command.iSlot = voice->iSlot;
+	command.voice = voice;
+	postCommand(command);
+}
 
-		ma_uint64 framesReadThisIteration = 0;
-		if (decoder.m_syncState.isLooping) {
-			ma_data_source_read_pcm_frames(
-			    &decoder.decoder,
-			    decodingTemp.data(),
-			    framesToReadThisIteration,
-			    &framesReadThisIteration,
-			    ma_bool32(true));
+int AudioDevice::findSlotForNewVoice(int priority)
+{
+	int iLowestPrioritySlot = -1;
+	for (int iSlot = 0; iSlot < int(m_slots.size()); ++iSlot) {
+		const VoiceSlot& slot = m_slots[iSlot];
+		if (slot.voice == nullptr) {
+			return iSlot;
 		}
-		else {
-			framesReadThisIteration =
-			    ma_decoder_read_pcm_frames(&decoder.decoder, decodingTemp.data(), framesToReadThisIteration);
+
+		if (iLowestPrioritySlot < 0) {
+			iLowestPrioritySlot = iSlot;
+			continue;
 		}
 
-		if (framesReadThisIteration == 0) {
-			isPlaybackDone = true;
-			break;
+		const VoiceSlot& lowest = m_slots[iLowestPrioritySlot];
+		const bool isOlder = slot.playIndex < lowest.playIndex;
+		if (slot.priority < lowest.priority || (slot.priority == lowest.priority && isOlder)) {
+			iLowestPrioritySlot = iSlot;
 		}
+	}
+
+	if (iLowestPrioritySlot >= 0 && m_slots[iLowestPrioritySlot].priority <= priority) {
+		stopVoice(m_slots[iLowestPrioritySlot].voice);
+		return iLowestPrioritySlot;
+	}
+
+	return -1;
+}
+
+void AudioDevice::postCommand(const Command& command)
+{
+	flushPendingCommands();
+
+	if (!m_pendingCommands.empty() || !m_commands.tryPush(command)) {
+		m_pendingCommands.push_back(command);
+	}
+}
 
-		// Mix the frames together.
-		for (ma_uint32 iSample = 0; iSample < framesReadThisIteration * CHANNEL_COUNT; ++iSample) {
-			output[totalFramesRead * CHANNEL_COUNT + iSample] += decodingTemp[iSample] * decoder.m_syncState.volume;
+void AudioDevice::flushPendingCommands()
+{
+	int numPushed = 0;
+	while (numPushed < int(m_pendingCommands.size()) && m_commands.tryPush(m_pendingCommands[numPushed])) {
+		numPushed++;
+	}
+
+	m_pendingCommands.erase(m_pendingCommands.begin(), m_pendingCommands.begin() + numPushed);
+}
+
+void AudioDevice::freeRetiredVoices()
+{
+	AudioVoice* voice = nullptr;
+	while (m_retiredVoices.tryPop(voice)) {
+		// Voices that still have an owner were not stopped, they have finished playing by themselves.
+		if (voice->owner && m_slots[voice->iSlot].voice == voice) {
+			m_slots[voice->iSlot] = VoiceSlot();
 		}
 
-		totalFramesRead += framesReadThisIteration;
+		deleteVoice(voice);
+	}
+}
 
-		if (framesReadThisIteration < framesToReadThisIteration) {
-			// Reached the end of the stream.
-			// Looping decoders never end.
-			isPlaybackDone = true;
-			break;
+void AudioDevice::deleteVoice(AudioVoice* voice)
+{
+	if (AudioDecoder* const owner = voice->owner) {
+		owner->m_resumeFrame = 0;
+		owner->playingDevice = nullptr;
+		owner->m_voice = nullptr;
+	}
+
+	if (voice->isStreamed) {
+		{
+			std::unique_lock<std::mutex> lock(m_streamsLock);
+			for (int t = 0; t < int(m_streamedVoices.size()); ++t) {
+				if (m_streamedVoices[t] == voice) {
+					m_streamedVoices.erase(m_streamedVoices.begin() + t);
+					break;
+				}
+			}
+
+			// The streaming thread could be decoding the voice right now, wait for it to finish that chunk.
+			m_streamedVoiceDecoded.wait(lock, [this, voice]() -> bool { return m_decodingVoice != voice; });
 		}
+
+		ma_decoder_uninit(&voice->decoder);
 	}
 
-	return isPlaybackDone && !decoder.m_syncState.isLooping;
+	delete voice;
+	m_numAllocatedVoices--;
 }
 
-void AudioDevice::dataCallback(void* pOutput, const void* UNUSED(pInput), ma_uint32 frameCount)
+void AudioDevice::mixOutput(float* output, uint32 frameCount)
 {
-	const ma_mutex_raii lock(mutexDataLock);
+	memset(output, 0, sizeof(float) * frameCount * kAudioNumChannels);
 
-	if (decodingTemp.size() < frameCount) {
-		decodingTemp.resize(frameCount);
+	if (!m_isCreated) {
+		return;
+	}
+
+	Command command;
+	while (m_commands.tryPop(command)) {
+		AudioVoice*& slotVoice = m_voices[command.iSlot];
+		if (command.type == commandType_play) {
+			if (slotVoice) {
+				retireVoice(slotVoice);
+			}
+			slotVoice = command.voice;
+		}
+		else if (slotVoice == command.voice) {
+			// Voices that have already finished are not in their slot anymore, there is nothing to stop for them.
+			retireVoice(slotVoice);
+			slotVoice = nullptr;
+		}
+	}
+
+	for (AudioVoice*& voice : m_voices) {
+		if (voice && mixVoice(*voice, output, frameCount)) {
+			retireVoice(voice);
+			voice = nullptr;
+		}
 	}
+}
+
+bool AudioDevice::mixVoice(AudioVoice& voice, float* output, uint32 frameCount)
+{
+	const float gainLeft = voice.gainLeft.load(std::memory_order_relaxed);
+	const float gainRight = voice.gainRight.load(std::memory_order_relaxed);
+	const bool isLooping = voice.isLooping.load(std::memory_order_relaxed);
+	const bool isVirtual = voice.isVirtual.load(std::memory_order_relaxed);
+
+	bool isPlaybackDone = false;
 
-	decodersToStopTemp.clear();
+	if (voice.isStreamed == false) {
+		const float* const pcmFrames = voice.audioData->getPcmFrames().data();
+		const uint64 numFrames = voice.audioData->getNumFrames();
+		const double pitch = double(voice.pitch.load(std::memory_order_relaxed));
+
+		if (isVirtual) {
+			// Just move forward, as if the frames were mixed.
+			voice.pcmPosition += double(frameCount) * pitch;
+			if (voice.pcmPosition >= double(numFrames)) {
+				if (isLooping) {
+					voice.pcmPosition = fmod(voice.pcmPosition, double(numFrames));
+				}
+				else {
+					isPlaybackDone = true;
+				}
+			}
+		}
+		else if (pitch == 1.0 && voice.pcmPosition == floor(voice.pcmPosition)) {
+			// The common case, the frames are mixed as they are.
+			uint64 cursor = uint64(voice.pcmPosition);
+			uint32 numFramesMixed = 0;
+			while (numFramesMixed < frameCount) {
+				if (cursor >= numFrames) {
+					if (!isLooping) {
+						isPlaybackDone = true;
+						break;
+					}
+					cursor = 0;
+				}
+
+				const uint32 numFramesToMix = uint32(minOf(uint64(frameCount - numFramesMixed), numFrames - cursor));
+				addScaledStereoBatch(
+				    output + numFramesMixed * kAudioNumChannels,
+				    pcmFrames + cursor * kAudioNumChannels,
+				    gainLeft,
+				    gainRight,
+				    int(numFramesToMix));
+
+				cursor += numFramesToMix;
+				numFramesMixed += numFramesToMix;
+			}
 
-	for (AudioDecoder* decoder : m_playingDecoders) {
-		if (decoder) {
-			bool isDone = readFramesFromDecoder(*decoder, (float*)pOutput, frameCount);
-			if (isDone) {
-				decodersToStopTemp.push_back(decoder);
+			voice.pcmPosition = double(cursor);
+		}
+		else {
+			// Resample with linear interpolation between the two nearest frames.
+			double position = voice.pcmPosition;
+			for (uint32 iFrame = 0; iFrame < frameCount; ++iFrame) {
+				if (position >= double(numFrames)) {
+					if (!isLooping) {
+						isPlaybackDone = true;
+						break;
+					}
+					position = fmod(position, double(numFrames));
+				}
+
+				const uint64 iFrame0 = uint64(position);
+				const uint64 iFrame1 = iFrame0 + 1 < numFrames ? iFrame0 + 1 : (isLooping ? 0 : iFrame0);
+				const float k = float(position - double(iFrame0));
+				const float* const frame0 = pcmFrames + iFrame0 * kAudioNumChannels;
+				const float* const frame1 = pcmFrames + iFrame1 * kAudioNumChannels;
+
+				float* const outputFrame = output + iFrame * kAudioNumChannels;
+				outputFrame[0] += (frame0[0] + (frame1[0] - frame0[0]) * k) * gainLeft;
+				outputFrame[1] += (frame0[1] + (frame1[1] - frame0[1]) * k) * gainRight;
+
+				position += pitch;
 			}
+
+			voice.pcmPosition = position;
 		}
+
+		voice.playPosition.store(uint64(voice.pcmPosition), std::memory_order_relaxed);
 	}
+	else {
+		// Virtual streamed voices still consume their frames, so they keep up with the streaming thread.
+		const uint32 tempCapInFrames = uint32(m_mixTemp.size()) / kAudioNumChannels;
+
+		uint32 numFramesMixed = 0;
+		while (numFramesMixed < frameCount) {
+			// Check for the end before reading the frames, so when the stream has ended all its frames are readable.
+			const bool isStreamEnded = voice.isStreamEnded.load(std::memory_order_acquire);
+
+			const uint32 numFramesWanted = minOf(frameCount - numFramesMixed, tempCapInFrames);
+			const int numFramesRead =
+			    voice.streamedFrames.popMany(m_mixTemp.data(), int(numFramesWanted) * kAudioNumChannels) /
+			    kAudioNumChannels;
+
+			if (!isVirtual) {
+				addScaledStereoBatch(
+				    output + numFramesMixed * kAudioNumChannels, m_mixTemp.data(), gainLeft, gainRight, numFramesRead);
+			}
+			numFramesMixed += uint32(numFramesRead);
 
-	for (AudioDecoder* decoder : decodersToStopTemp) {
-		stop_noMutexLock(decoder);
+			if (uint32(numFramesRead) < numFramesWanted) {
+				// Either the end of the stream or the streaming thread is late, in that case the rest is silence.
+				isPlaybackDone = isStreamEnded;
+				break;
+			}
+		}
+
+		voice.numStreamedFramesConsumed += numFramesMixed;
+		voice.playPosition.store(voice.startFrame + voice.numStreamedFramesConsumed, std::memory_order_relaxed);
 	}
+
+	return isPlaybackDone;
 }
 
-void AudioDevice::miniaudioDataCallback(ma_device* pDevice, void* pOutput, const void* pInput, ma_uint32 frameCount)
+void AudioDevice::retireVoice(AudioVoice* voice)
+{
+	[[maybe_unused]] const bool isPushed = m_retiredVoices.tryPush(voice);
+	sgeAssert(isPushed && "The retired voices queue should fit all allocated voices");
+}
+
+void AudioDevice::streamingThreadMain()
+{
+	std::vector<float> decodingTemp(kAudioChunkFrames * kAudioNumChannels);
+	std::vector<AudioVoice*> voicesToDecode;
+
+	// The lock is released while decoding, so play() and deleteVoice() on the game thread don't wait for all streams.
+	std::unique_lock<std::mutex> lock(m_streamsLock);
+	while (!m_shouldStopStreaming) {
+		voicesToDecode = m_streamedVoices;
+		for (AudioVoice* voice : voicesToDecode) {
+			// The voice might have been deleted while the previous one was decoded.
+			if (std::find(m_streamedVoices.begin(), m_streamedVoices.end(), voice) == m_streamedVoices.end()) {
+				continue;
+			}
+
+			m_decodingVoice = voice;
+			lock.unlock();
+			decodeStreamedFrames(*voice, decodingTemp, kStreamedFramesCapacity);
+			lock.lock();
+			m_decodingVoice = nullptr;
+			m_streamedVoiceDecoded.notify_all();
+		}
+
+		if (m_streamedVoices.empty()) {
+			m_streamingWakeUp.wait(
+			    lock, [this]() -> bool { return m_shouldStopStreaming || !m_streamedVoices.empty(); });
+		}
+		else {
+			m_streamingWakeUp.wait_for(lock, std::chrono::milliseconds(kStreamingIntervalMs));
+		}
+	}
+}
+
+void AudioDevice::miniaudioDataCallback(
+    ma_device* pDevice, void* pOutput, const void* UNUSED(pInput), ma_uint32 frameCount)
 {
 	if (pDevice == nullptr) {
 		return;
 	}
 
 	AudioDevice* audioDevice = reinterpret_cast<AudioDevice*>(pDevice->pUserData);
-	audioDevice->dataCallback(pOutput, pInput, frameCount);
+	audioDevice->mixOutput(reinterpret_cast<float*>(pOutput), frameCount);
 }
 
 //------------------------------------------------------------------
@@ -198,9 +779,50 @@ void AudioDevice::miniaudioDataCallback(ma_device* pDevice, void* pOutput, const
 //------------------------------------------------------------------
 void AudioData::createFromFile(const char* filename)
 {
-	fileData = std::vector<char>();
-	[[maybe_unused]] bool succeeded = FileReadStream::readFile(filename, fileData);
+	std::vector<char> encodedData;
+	[[maybe_unused]] bool succeeded = FileReadStream::readFile(filename, encodedData);
 	sgeAssert(succeeded);
+
+	createFromMemory(std::move(encodedData));
+}
+
+void AudioData::createFromMemory(std::vector<char> encodedData)
+{
+	fileData = std::move(encodedData);
+	pcmFrames = std::vector<float>();
+	numFrames = 0;
+
+	if (fileData.empty()) {
+		return;
+	}
+
+	ma_decoder decoder;
+	ma_decoder_config decoderConfig = ma_decoder_config_init(SAMPLE_FORMAT, kAudioNumChannels, kAudioSampleRate);
+	if (ma_decoder_init_memory(fileData.data(), fileData.size(), &decoderConfig, &decoder) != MA_SUCCESS) {
+		sgeAssertFalse("Failed to initialize the decoder of AudioData");
+		fileData = std::vector<char>();
+		return;
+	}
+
+	// The length could be unknown for some formats, these are always decoded while playing.
+	numFrames = ma_decoder_get_length_in_pcm_frames(&decoder);
+
+	if (numFrames > 0 && numFrames <= uint64(kMaxPreDecodedSeconds * kAudioSampleRate)) {
+		pcmFrames.resize(numFrames * kAudioNumChannels);
+		const ma_uint64 numDecoded = ma_decoder_read_pcm_frames(&decoder, pcmFrames.data(), numFrames);
+
+		if (numDecoded > 0) {
+			// The encoded data is no longer needed.
+			numFrames = numDecoded;
+			pcmFrames.resize(numFrames * kAudioNumChannels);
+			fileData = std::vector<char>();
+		}
+		else {
+			pcmFrames = std::vector<float>();
+		}
+	}
+
+	ma_decoder_uninit(&decoder);
 }
 
 //------------------------------------------------------------------
@@ -213,9 +835,8 @@ void AudioDecoder::clear()
 	}
 
 	audioData = nullptr;
-	ma_decoder_uninit(&decoder);
 	numFramesInDecoder = 0;
-	playingDevice = nullptr;
+	m_resumeFrame = 0;
 
 	state = State();
 }
@@ -225,36 +846,18 @@ void AudioDecoder::createDecoder(AudioDataPtr& audioData)
 	clear();
 
 	this->audioData = audioData;
-
-	if (audioData->isEmpty() == false) {
-		ma_decoder_config decoderConfig = ma_decoder_config_init(SAMPLE_FORMAT, CHANNEL_COUNT, SAMPLE_RATE);
-		if (ma_decoder_init_memory(
-		        audioData->getData().data(), audioData->getData().size(), &decoderConfig, &decoder) != MA_SUCCESS) {
-			sgeAssertFalse("Failed to initialize AudioDecoder");
-			ma_decoder_uninit(&decoder);
-		}
-	}
-
-	ma_decoder_get_available_frames(&decoder, &numFramesInDecoder);
+	numFramesInDecoder = audioData ? audioData->getNumFrames() : 0;
 }
 
 void AudioDecoder::seekToBegining()
 {
-	if (playingDevice) {
-		ma_mutex_lock(&playingDevice->getDataLockMutex());
-	}
-
-	seekToBegining_noLock();
+	m_resumeFrame = 0;
 
 	if (playingDevice) {
-		playingDevice->stop(this);
-		ma_mutex_unlock(&playingDevice->getDataLockMutex());
+		AudioDevice* const device = playingDevice;
+		device->stop(this);
+		device->play(this, true);
 	}
 }
 
-void AudioDecoder::seekToBegining_noLock()
-{
-	ma_decoder_seek_to_pcm_frame(&decoder, 0);
-}
-
 } // namespace sge
@@ -1,59 +1,230 @@
 #pragma once
 
 #include "miniaudio.h"
+#include "sge_utils/math/vec3f.h"
 #include "sge_utils/sge_utils.h"
+#include "sge_utils/threading/SPSCQueue.h"
+#include <atomic>
+#include <condition_variable>
 #include <memory>
-#include <set>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace sge {
 
 struct AudioDecoder;
 struct AudioData;
+struct AudioVoice;
 typedef std::shared_ptr<AudioData> AudioDataPtr;
 
-struct AudioDevice {
+/// All audio is converted to that format when decoded, it is the format of the mixed output as well.
+/// The frames are interleaved, a frame is one float per channel.
+static constexpr int kAudioNumChannels = 2;
+static constexpr int kAudioSampleRate = 44100;
+
+/// How the volume of a 3D sound decreases with the distance to the listener.
+/// With every curve the sound is at full volume up to the min distance and silent at the max distance.
+enum AudioAttenuationCurve : int {
+	/// min distance / distance, the physically based one. Remapped so it reaches 0 at the max distance.
+	audioAttenuationCurve_inverse,
+	/// Linear between the min and the max distance.
+	audioAttenuationCurve_linear,
+	/// Full volume up to the max distance.
+	audioAttenuationCurve_none,
+};
+
+/// The point from which the 3D sounds are heard, usually the game camera.
+struct AudioListener {
+	vec3f position = vec3f(0.f);
+	/// Used for the doppler effect, in units per second.
+	vec3f velocity = vec3f(0.f);
+	/// Normalized directions, the right direction is their cross product.
+	vec3f forward = vec3f(0.f, 0.f, -1.f);
+	vec3f up = vec3f(0.f, 1.f, 0.f);
+};
+
+/// AudioDevice mixes the playing AudioDecoders into the audio output.
+///
+/// The mixing is done on the audio thread (see @mixOutput) and it never takes a lock.
+/// The game thread doesn't touch the data used by the audio thread, it communicates with it through lock-free queues:
+/// @play and @stop post commands to the audio thread, and the audio thread sends back the voices it no longer uses,
+/// so the game thread could free them in @update.
+///
+/// Short clips are decoded to PCM when their AudioData is loaded, so playing them is just mixing the samples.
+/// Long ones (see AudioData::kMaxPreDecodedSeconds) are decoded while playing by a background thread into
+/// a ring buffer per voice.
+///
+/// There is a limit of voices that could be playing at once. When it is reached the new sound takes the voice of
+/// the lowest priority sound, unless it is of lower priority itself (see AudioDecoder::State::priority).
+///
+/// 3D sounds are attenuated, panned and pitched (the doppler effect) based on their position relative to
+/// the listener. Voices that are too quiet to be heard, or are beyond the limit of audible voices, are virtualized:
+/// they keep their play position, but are not mixed.
+struct AudioDevice : public NoCopyNoMove {
+	static constexpr int kDefaultMaxVoices = 64;
+
 	AudioDevice() = default;
 	~AudioDevice() { clear(); }
 
-	void createAudioDevice();
+	void createAudioDevice(int maxVoices = kDefaultMaxVoices);
+
+	/// Creates the device without an audio output. Nothing is heard and the mixing happens only when @mixOutput
+	/// is called by the user. Useful for tests and benchmarks.
+	void createNullAudioDevice(int maxVoices = kDefaultMaxVoices);
+
 	void startAudioDevice();
 	void clear();
 
-	ma_mutex& getDataLockMutex() { return mutexDataLock; }
-
+	/// Starts playing the decoder. If the decoder is already playing nothing happens.
+	/// @param [in] ifAlreadyPlayingSeekToBegining if true the playback starts from the begining, otherwise it
+	///        continues from where the decoder was last stopped.
 	void play(AudioDecoder* decoder, bool ifAlreadyPlayingSeekToBegining);
 	void stop(AudioDecoder* decoder);
 
+	/// Should be called by the game thread once per frame. Sends the changes of AudioDecoder::state to the audio
+	/// thread, decides which voices are virtual and frees the voices that have finished playing.
+	void update();
+
+	/// The listener of the 3D sounds, the changes are applied by @update.
+	void setListener(const AudioListener& listener) { m_listener = listener; }
+	const AudioListener& getListener() const { return m_listener; }
+
+	/// Voices with volume (after the attenuation) below the threshold are virtualized. 0 disables that.
+	void setVirtualizationThreshold(float threshold) { m_virtualizationThreshold = threshold; }
+
+	/// At most that many voices are mixed, the quietest ones above the limit are virtualized.
+	void setMaxAudibleVoices(int maxAudibleVoices) { m_maxAudibleVoices = maxAudibleVoices; }
+
+	/// Returns the number of voices that are mixed, as decided by the last @update.
+	int getNumAudibleVoices() const { return m_numAudibleVoices; }
+
+	/// Mixes the next @frameCount frames of all playing voices into @output, overwriting its contents.
+	/// Called on the audio thread, or by the user for devices created with @createNullAudioDevice.
+	/// The function never blocks and doesn't allocate memory.
+	void mixOutput(float* output, uint32 frameCount);
+
+	int getMaxVoices() const { return int(m_slots.size()); }
+
+	/// Returns the number of voices playing, as seen by the game thread.
+	int getNumPlayingVoices() const;
+
   private:
-	void stop_noMutexLock(AudioDecoder* decoder);
+	enum CommandType : int {
+		commandType_play,
+		commandType_stop,
+	};
 
-	void dataCallback(void* pOutput, const void* pInput, ma_uint32 frameCount);
+	/// A command sent from the game thread to the audio thread.
+	struct Command {
+		CommandType type = commandType_play;
+		int iSlot = -1;
+		AudioVoice* voice = nullptr;
+	};
 
-	/// @brief Returns true if the playing has done.
-	bool readFramesFromDecoder(AudioDecoder& decoder, float* output, uint32 frameCount);
+	/// The game thread view of a voice slot.
+	struct VoiceSlot {
+		AudioVoice* voice = nullptr;
+		int priority = 0;
+		/// Used to pick the oldest sound when there are multiple sounds with the lowest priority.
+		uint64 playIndex = 0;
+	};
+
+	void create(int maxVoices, bool hasOutputDevice);
+
+	/// Sends the volume, panning and pitch of the voice to the audio thread.
+	/// @retval the loudness of the voice, the bigger of its left and right gain.
+	float applyVoiceState(AudioVoice& voice, const AudioDecoder& decoder) const;
+
+	/// Detaches the voice from its decoder and its slot. The audio thread is told to stop it.
+	void stopVoice(AudioVoice* voice);
+
+	/// Returns the slot for a new sound with the specified priority, stopping the sound that was in it.
+	/// @retval -1 if all voices are taken by sounds of higher priority.
+	int findSlotForNewVoice(int priority);
+
+	void postCommand(const Command& command);
+	void flushPendingCommands();
+
+	/// Frees the voices that the audio thread is no longer using.
+	void freeRetiredVoices();
+	void deleteVoice(AudioVoice* voice);
+
+	/// Audio thread. Mixes a voice into @output. Returns true if the voice has finished playing.
+	bool mixVoice(AudioVoice& voice, float* output, uint32 frameCount);
+	void retireVoice(AudioVoice* voice);
+
+	/// The background thread that decodes the streamed voices.
+	void streamingThreadMain();
 
 	static void miniaudioDataCallback(ma_device* pDevice, void* pOutput, const void* pInput, ma_uint32 frameCount);
 
+  private:
 	ma_device device;
-	ma_mutex mutexDataLock;
+	bool m_isCreated = false;
+	bool m_hasOutputDevice = false;
+
+	// Game thread state.
+	std::vector<VoiceSlot> m_slots;
+	/// Commands that didn't fit in @m_commands. They are sent before any new ones.
+	std::vector<Command> m_pendingCommands;
+	/// The voices that are allocated and not freed yet, playing or not.
+	int m_numAllocatedVoices = 0;
+	uint64 m_nextPlayIndex = 0;
 
-	std::set<AudioDecoder*> m_playingDecoders;
-	std::vector<float> decodingTemp;
-	std::vector<AudioDecoder*> decodersToStopTemp;
+	AudioListener m_listener;
+	float m_virtualizationThreshold = 0.001f;
+	int m_maxAudibleVoices = kDefaultMaxVoices;
+	int m_numAudibleVoices = 0;
+	/// The audible voices and their loudness, used by @update to pick the ones that fit in @m_maxAudibleVoices.
+	std::vector<std::pair<float, AudioVoice*>> m_audibleVoicesTemp;
+
+	// The queues between the game and the audio thread.
+	SPSCQueue<Command> m_commands;
+	SPSCQueue<AudioVoice*> m_retiredVoices;
+
+	// Audio thread state.
+	std::vector<AudioVoice*> m_voices;
+	std::vector<float> m_mixTemp;
+
+	// Streaming thread state. @m_streamsLock is never taken by the audio thread.
+	// The voices are decoded without holding the lock, @m_decodingVoice is the one being decoded at the moment.
+	std::thread m_streamingThread;
+	std::mutex m_streamsLock;
+	std::condition_variable m_streamingWakeUp;
+	std::condition_variable m_streamedVoiceDecoded;
+	std::vector<AudioVoice*> m_streamedVoices;
+	AudioVoice* m_decodingVoice = nullptr;
+	bool m_shouldStopStreaming = false;
 };
 
 struct AudioData {
+	/// Clips up to that long are decoded to PCM when loaded, longer ones are decoded while playing.
+	static constexpr float kMaxPreDecodedSeconds = 8.f;
+
 	AudioData() = default;
 
 	void createFromFile(const char* filename);
 
+	/// @param [in] fileData the contents of an audio file in any of the formats supported by miniaudio.
+	void createFromMemory(std::vector<char> fileData);
+
+	/// Returns the encoded data, it is empty if the data has been pre-decoded.
 	const std::vector<char>& getData() const { return fileData; }
-	bool isEmpty() { return fileData.empty(); }
+	bool isEmpty() const { return fileData.empty() && pcmFrames.empty(); }
 
+	bool isPreDecoded() const { return !pcmFrames.empty(); }
+
+	/// Returns the decoded frames, empty if the data is decoded while playing (see @isPreDecoded).
+	const std::vector<float>& getPcmFrames() const { return pcmFrames; }
+
+	/// Returns the length in frames.
+	uint64 getNumFrames() const { return numFrames; }
 
   private:
 	std::vector<char> fileData;
+	std::vector<float> pcmFrames;
+	uint64 numFrames = 0;
 };
 
 struct AudioDecoder {
@@ -62,6 +233,21 @@ struct AudioDecoder {
 	struct State {
 		bool isLooping = false;
 		float volume = 1.f;
+		/// When all voices are taken, a sound could take the voice of a sound with lower or equal priority.
+		/// Read when the playing starts.
+		int priority = 0;
+
+		/// 3D sounds are attenuated, panned and pitched by the doppler effect based on their position relative to
+		/// the listener (see AudioDevice::setListener). The doppler effect applies only to pre-decoded data.
+		bool is3D = false;
+		vec3f position = vec3f(0.f);
+		/// Used for the doppler effect, in units per second.
+		vec3f velocity = vec3f(0.f);
+		float minDistance = 1.f;
+		float maxDistance = 50.f;
+		AudioAttenuationCurve attenuation = audioAttenuationCurve_inverse;
+		/// Scales the doppler effect, 0 disables it.
+		float dopplerFactor = 1.f;
 	};
 
   public:
@@ -71,23 +257,23 @@ struct AudioDecoder {
 	void clear();
 	void createDecoder(AudioDataPtr& audioData);
 
+	/// Makes the next playback start from the begining. If the decoder is playing it starts over.
 	void seekToBegining();
-	void seekToBegining_noLock();
 	bool isPlaying() const { return playingDevice != nullptr; }
 
-
   public:
 	AudioDataPtr audioData;
-	ma_decoder decoder;
-	ma_uint64 numFramesInDecoder = 0;
+	uint64 numFramesInDecoder = 0;
 
+	/// Changes are sent to the audio thread by AudioDevice::update.
 	State state;
 
   private:
 	AudioDevice* playingDevice = nullptr;
+	AudioVoice* m_voice = nullptr;
 
-	/// Sync state managed by the @AudioDevice when playing. Do not modify it. Modify @state instead.
-	State m_syncState;
+	/// The frame from which the next playback starts.
+	uint64 m_resumeFrame = 0;
 };
 
 } // namespace sge
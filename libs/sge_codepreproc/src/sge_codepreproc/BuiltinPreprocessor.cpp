@@ -0,0 +1,774 @@
+#include "sge_codepreproc/IncludeFilesCache.h"
+#include "sge_codepreproc/sge_codepreproc.h"
+
+#include "sge_utils/text/format.h"
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace sge {
+
+namespace {
+
+	bool isIdentifierStart(const char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+	bool isDigit(const char c) { return c >= '0' && c <= '9'; }
+	bool isIdentifierChar(const char c) { return isIdentifierStart(c) || isDigit(c); }
+	bool isSpace(const char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v'; }
+
+	std::string_view trimSpaces(std::string_view str)
+	{
+		while (!str.empty() && isSpace(str.front())) {
+			str.remove_prefix(1);
+		}
+		while (!str.empty() && isSpace(str.back())) {
+			str.remove_suffix(1);
+		}
+		return str;
+	}
+
+	/// Returns the identifier at the beginning of @str (after the spaces) and removes it from @str.
+	std::string_view takeIdentifier(std::string_view& str)
+	{
+		str = trimSpaces(str);
+		size_t length = 0;
+		if (!str.empty() && isIdentifierStart(str[0])) {
+			while (length < str.size() && isIdentifierChar(str[length])) {
+				length++;
+			}
+		}
+
+		const std::string_view identifier = str.substr(0, length);
+		str.remove_prefix(length);
+		return identifier;
+	}
+
+	/// Returns the length of the string or character literal at the beginning of @str, including the quotes.
+	/// Returns 0 if the literal isn't closed on the same line (like the apostrophe of "isn't" in a skipped block).
+	/// Scanning further would swallow the lines that follow.
+	size_t getQuotedLength(const std::string_view str)
+	{
+		const char quote = str[0];
+		for (size_t t = 1; t < str.size(); ++t) {
+			if (str[t] == '\n' || str[t] == '\r') {
+				return 0;
+			}
+			else if (str[t] == '\\') {
+				// Don't skip over a line continuation, it ends the scan above.
+				if (t + 1 < str.size() && str[t + 1] != '\n' && str[t + 1] != '\r') {
+					t++;
+				}
+			}
+			else if (str[t] == quote) {
+				return t + 1;
+			}
+		}
+		return 0;
+	}
+
+	/// Returns the length of the number at the beginning of @str (like 1, 0x1F, 1.5e-3f).
+	size_t getNumberLength(const std::string_view str)
+	{
+		size_t length = 1;
+		while (length < str.size()) {
+			const char c = str[length];
+			const char prev = str[length - 1];
+			const bool isExponentSign =
+			    (c == '+' || c == '-') && (prev == 'e' || prev == 'E' || prev == 'p' || prev == 'P');
+			if (!isIdentifierChar(c) && c != '.' && !isExponentSign) {
+				break;
+			}
+			length++;
+		}
+		return length;
+	}
+
+	/// Evaluates the expressions of #if and #elif after the macros have been expanded.
+	/// Everything is computed with 64-bit signed integers.
+	struct ExpressionEvaluator {
+		explicit ExpressionEvaluator(std::string_view expression)
+		    : m_rest(expression)
+		{
+		}
+
+		bool evaluate(sint64& result)
+		{
+			result = parseConditional();
+			skipSpaces();
+			return !m_hasErrors && m_rest.empty();
+		}
+
+	  private:
+		void skipSpaces() { m_rest = trimSpaces(m_rest); }
+
+		/// Consumes the operator if it is the next thing in the expression.
+		bool takeOperator(const std::string_view op)
+		{
+			skipSpaces();
+			if (m_rest.substr(0, op.size()) != op) {
+				return false;
+			}
+
+			// Do not mistake "<" for the beginning of "<<" or "<=", "&" for "&&" and so on.
+			if (op.size() == 1 && m_rest.size() > 1) {
+				const char next = m_rest[1];
+				const bool isLongerOperator = (op[0] == '<' && (next == '<' || next == '=')) ||
+				                              (op[0] == '>' && (next == '>' || next == '=')) ||
+				                              (op[0] == '&' && next == '&') || (op[0] == '|' && next == '|') ||
+				                              (op[0] == '!' && next == '=') || (op[0] == '=' && next == '=');
+				if (isLongerOperator) {
+					return false;
+				}
+			}
+
+			m_rest.remove_prefix(op.size());
+			return true;
+		}
+
+		sint64 parseConditional()
+		{
+			const sint64 condition = parseBinary(0);
+			if (takeOperator("?")) {
+				const sint64 ifTrue = parseConditional();
+				if (!takeOperator(":")) {
+					m_hasErrors = true;
+					return 0;
+				}
+				const sint64 ifFalse = parseConditional();
+				return condition ? ifTrue : ifFalse;
+			}
+			return condition;
+		}
+
+		/// Parses the binary operators with precedence at least @minLevel, see @kLevels.
+		sint64 parseBinary(const int minLevel)
+		{
+			// The binary operators grouped by precedence, from the lowest to the highest.
+			static const std::vector<std::vector<std::string_view>> kLevels = {
+			    {"||"}, {"&&"}, {"|"}, {"^"}, {"&"}, {"==", "!="}, {"<=", ">=", "<", ">"}, {"<<", ">>"}, {"+", "-"},
+			    {"*", "/", "%"}};
+
+			if (minLevel >= int(kLevels.size())) {
+				return parseUnary();
+			}
+
+			sint64 left = parseBinary(minLevel + 1);
+			while (!m_hasErrors) {
+				std::string_view op;
+				for (const std::string_view candidate : kLevels[minLevel]) {
+					if (takeOperator(candidate)) {
+						op = candidate;
+						break;
+					}
+				}
+
+				if (op.empty()) {
+					break;
+				}
+
+				const sint64 right = parseBinary(minLevel + 1);
+				left = applyBinary(op, left, right);
+			}
+
+			return left;
+		}
+
+		sint64 applyBinary(const std::string_view op, const sint64 left, const sint64 right)
+		{
+			if ((op == "/" || op == "%") && right == 0) {
+				m_hasErrors = true;
+				return 0;
+			}
+
+			// clang-format off
+			if (op == "||") return (left || right) ? 1 : 0;
+			if (op == "&&") return (left && right) ? 1 : 0;
+			if (op == "|") return left | right;
+			if (op == "^") return left ^ right;
+			if (op == "&") return left & right;
+			if (op == "==") return left == right ? 1 : 0;
+			if (op == "!=") return left != right ? 1 : 0;
+			if (op == "<=") return left <= right ? 1 : 0;
+			if (op == ">=") return left >= right ? 1 : 0;
+			if (op == "<") return left < right ? 1 : 0;
+			if (op == ">") return left > right ? 1 : 0;
+			if (op == "<<") return left << right;
+			if (op == ">>") return left >> right;
+			if (op == "+") return left + right;
+			if (op == "-") return left - right;
+			if (op == "*") return left * right;
+			if (op == "/") return left / right;
+			if (op == "%") return left % right;
+			// clang-format on
+
+			m_hasErrors = true;
+			return 0;
+		}
+
+		sint64 parseUnary()
+		{
+			if (takeOperator("!")) {
+				return parseUnary() ? 0 : 1;
+			}
+			if (takeOperator("~")) {
+				return ~parseUnary();
+			}
+			if (takeOperator("-")) {
+				return -parseUnary();
+			}
+			if (takeOperator("+")) {
+				return parseUnary();
+			}
+			return parsePrimary();
+		}
+
+		sint64 parsePrimary()
+		{
+			if (takeOperator("(")) {
+				const sint64 value = parseConditional();
+				if (!takeOperator(")")) {
+					m_hasErrors = true;
+				}
+				return value;
+			}
+
+			skipSpaces();
+			if (m_rest.empty() || !isDigit(m_rest[0])) {
+				m_hasErrors = true;
+				return 0;
+			}
+
+			const std::string number(m_rest.substr(0, getNumberLength(m_rest)));
+			m_rest.remove_prefix(number.size());
+
+			// Base 0 handles the hexadecimal and octal numbers. Only the integer suffixes may follow.
+			char* end = nullptr;
+			const sint64 value = sint64(strtoull(number.c_str(), &end, 0));
+			for (; *end != '\0'; ++end) {
+				if (*end != 'u' && *end != 'U' && *end != 'l' && *end != 'L') {
+					m_hasErrors = true;
+				}
+			}
+
+			return value;
+		}
+
+	  private:
+		std::string_view m_rest;
+		bool m_hasErrors = false;
+	};
+
+	/// BuiltinPreprocessor holds the state of a single @preprocessCodeBuiltin call.
+	struct BuiltinPreprocessor {
+		BuiltinPreprocessor(const std::string& includeDir, const char* const trackedMacro)
+		    : m_includeDir(includeDir)
+		    , m_trackedMacro(trackedMacro ? trackedMacro : "")
+		{
+		}
+
+		/// Defines a macro in the format of the command line "NAME" or "NAME=VALUE".
+		void defineFromCommandLine(const std::string_view definition)
+		{
+			const size_t equalsPos = definition.find('=');
+			if (equalsPos == std::string_view::npos) {
+				m_macros[std::string(definition)] = "1";
+			}
+			else {
+				m_macros[std::string(definition.substr(0, equalsPos))] = std::string(definition.substr(equalsPos + 1));
+			}
+		}
+
+		bool processFile(const std::string_view text, const std::string& filename);
+
+		std::string m_result;
+		std::set<std::string> m_includedFiles;
+		bool m_isTrackedMacroReferenced = false;
+
+	  private:
+		struct ConditionalBlock {
+			/// True if the code in the block is used.
+			bool isActive = false;
+			/// True if the code around the block is used.
+			bool isParentActive = false;
+			/// True if one of the branches of the block has been used.
+			bool hasTakenBranch = false;
+			bool hasSeenElse = false;
+		};
+
+		bool isActive() const { return m_conditionals.empty() || m_conditionals.back().isActive; }
+
+		/// Finds the macro, nullptr if it isn't defined.
+		const std::string* findMacro(const std::string_view name);
+
+		/// @param [out] outHasIncludedFile set to true if the directive has included a file.
+		bool processDirective(std::string_view directive, const std::string& filename, bool& outHasIncludedFile);
+
+		/// Appends @text to @m_result with all macros expanded.
+		bool expandText(const std::string_view text, const int depth);
+
+		/// Appends the expression to @result with all macros expanded, the defined() operators evaluated and the
+		/// remaining identifiers replaced with 0.
+		bool expandExpression(const std::string_view expression, std::string& result, const int depth);
+
+		bool evaluateExpression(const std::string_view expression, bool& result);
+
+	  private:
+		static constexpr int kMaxDepth = 64;
+
+		const std::string& m_includeDir;
+		const std::string_view m_trackedMacro;
+
+		std::unordered_map<std::string, std::string> m_macros;
+		/// Reused to find macros without allocating a new string every time.
+		std::string m_macroNameTemp;
+		/// The macros being expanded right now, they must not be expanded again in their own replacement.
+		std::vector<std::string_view> m_expandingMacros;
+
+		std::vector<ConditionalBlock> m_conditionals;
+		std::unordered_set<std::string> m_pragmaOnceFiles;
+		std::unordered_map<std::string, std::shared_ptr<const std::vector<char>>> m_loadedFiles;
+		int m_includeDepth = 0;
+	};
+
+	const std::string* BuiltinPreprocessor::findMacro(const std::string_view name)
+	{
+		if (name == m_trackedMacro) {
+			m_isTrackedMacroReferenced = true;
+		}
+
+		m_macroNameTemp.assign(name.data(), name.size());
+		auto itr = m_macros.find(m_macroNameTemp);
+		return itr != m_macros.end() ? &itr->second : nullptr;
+	}
+
+	bool BuiltinPreprocessor::processFile(const std::string_view text, const std::string& filename)
+	{
+		const size_t numConditionalsAtStart = m_conditionals.size();
+		m_result += string_format("#line 1 \"%s\"\n", filename.c_str());
+
+		std::string line;
+		bool isInBlockComment = false;
+		int lineNumber = 1;
+		size_t pos = 0;
+		while (pos < text.size()) {
+			// Join the lines ending with a backslash and replace the comments with spaces.
+			// The strings are kept as they are, in them "//" isn't a comment.
+			line.clear();
+			int numPhysicalLines = 1;
+			bool isLineStartingInComment = isInBlockComment;
+			while (pos < text.size() && text[pos] != '\n') {
+				const std::string_view rest = text.substr(pos);
+				if (isInBlockComment) {
+					if (rest.substr(0, 2) == "*/") {
+						isInBlockComment = false;
+						line.push_back(' ');
+						pos += 2;
+					}
+					else {
+						pos++;
+					}
+				}
+				else if (rest.substr(0, 2) == "/*") {
+					isInBlockComment = true;
+					pos += 2;
+				}
+				else if (rest.substr(0, 2) == "//") {
+					while (pos < text.size() && text[pos] != '\n') {
+						pos++;
+					}
+				}
+				else if (rest[0] == '"' || rest[0] == '\'') {
+					const size_t length = getQuotedLength(rest);
+					if (length == 0) {
+						return false;
+					}
+					line.append(rest.substr(0, length));
+					pos += length;
+				}
+				else if (rest[0] == '\\' && (rest.substr(1, 1) == "\n" || rest.substr(1, 2) == "\r\n")) {
+					pos += rest[1] == '\n' ? 2 : 3;
+					numPhysicalLines++;
+				}
+				else {
+					line.push_back(rest[0]);
+					pos++;
+				}
+			}
+
+			// Skip the new line.
+			pos++;
+
+			lineNumber += numPhysicalLines;
+
+			const std::string_view trimmed = trimSpaces(line);
+			bool hasIncludedFile = false;
+			if (!isLineStartingInComment && !trimmed.empty() && trimmed[0] == '#') {
+				if (!processDirective(trimmed.substr(1), filename, hasIncludedFile)) {
+					return false;
+				}
+			}
+			else if (isActive()) {
+				if (!expandText(line, 0)) {
+					return false;
+				}
+			}
+
+			// Keep the line numbers the same as the ones in the file, so the errors could be located.
+			// An included file moves the lines, so point them back to this file.
+			if (hasIncludedFile) {
+				m_result += string_format("#line %d \"%s\"\n", lineNumber, filename.c_str());
+			}
+			else {
+				m_result.append(numPhysicalLines, '\n');
+			}
+		}
+
+		// Every #if in the file should have its #endif.
+		return m_conditionals.size() == numConditionalsAtStart && !isInBlockComment;
+	}
+
+	bool BuiltinPreprocessor::processDirective(
+	    std::string_view directive, const std::string& filename, bool& outHasIncludedFile)
+	{
+		const std::string_view name = takeIdentifier(directive);
+		directive = trimSpaces(directive);
+
+		// The conditionals are processed even in the skipped code, in order to find the matching #endif.
+		if (name == "if" || name == "ifdef" || name == "ifndef") {
+			ConditionalBlock block;
+			block.isParentActive = isActive();
+			if (block.isParentActive) {
+				bool condition = false;
+				if (name == "if") {
+					if (!evaluateExpression(directive, condition)) {
+						return false;
+					}
+				}
+				else {
+					const std::string_view macroName = takeIdentifier(directive);
+					if (macroName.empty()) {
+						return false;
+					}
+					condition = (findMacro(macroName) != nullptr) == (name == "ifdef");
+				}
+				block.isActive = condition;
+				block.hasTakenBranch = condition;
+			}
+			m_conditionals.push_back(block);
+			return true;
+		}
+
+		if (name == "elif" || name == "else") {
+			if (m_conditionals.empty() || m_conditionals.back().hasSeenElse) {
+				return false;
+			}
+
+			ConditionalBlock& block = m_conditionals.back();
+			block.isActive = false;
+			if (block.isParentActive && !block.hasTakenBranch) {
+				bool condition = true;
+				if (name == "elif" && !evaluateExpression(directive, condition)) {
+					return false;
+				}
+				block.isActive = condition;
+				block.hasTakenBranch = condition;
+			}
+			block.hasSeenElse = name == "else";
+			return true;
+		}
+
+		if (name == "endif") {
+			if (m_conditionals.empty()) {
+				return false;
+			}
+			m_conditionals.pop_back();
+			return true;
+		}
+
+		// Any other directive in the skipped code is ignored, even the unknown ones.
+		if (!isActive() || (name.empty() && directive.empty())) {
+			return true;
+		}
+
+		if (name == "define") {
+			const std::string_view macroName = takeIdentifier(directive);
+			// A parenthesis right after the name means a function-like macro, # and ## are used only by them.
+			if (macroName.empty() || (!directive.empty() && directive[0] == '(') ||
+			    directive.find('#') != std::string_view::npos) {
+				return false;
+			}
+
+			findMacro(macroName);
+			m_macros[std::string(macroName)] = std::string(trimSpaces(directive));
+			return true;
+		}
+
+		if (name == "undef") {
+			const std::string_view macroName = takeIdentifier(directive);
+			if (macroName.empty()) {
+				return false;
+			}
+
+			findMacro(macroName);
+			m_macros.erase(m_macroNameTemp);
+			return true;
+		}
+
+		if (name == "include") {
+			// Only the simple forms #include "file" and #include <file>, not the ones using macros.
+			if (directive.size() < 2 || (directive[0] != '"' && directive[0] != '<')) {
+				return false;
+			}
+			const size_t closingPos = directive.find(directive[0] == '"' ? '"' : '>', 1);
+			if (closingPos == std::string_view::npos || !trimSpaces(directive.substr(closingPos + 1)).empty()) {
+				return false;
+			}
+
+			const std::string includeName(directive.substr(1, closingPos - 1));
+			const std::string fileToLoad = m_includeDir + "/" + includeName;
+			m_includedFiles.insert(fileToLoad);
+
+			if (m_pragmaOnceFiles.count(fileToLoad) != 0) {
+				return true;
+			}
+
+			if (m_includeDepth >= kMaxDepth) {
+				return false;
+			}
+
+			// The same file could be included many times, load it only once.
+			std::shared_ptr<const std::vector<char>>& contents = m_loadedFiles[fileToLoad];
+			if (contents == nullptr) {
+				contents = getIncludeFilesCache().load(fileToLoad);
+				if (contents == nullptr) {
+					return false;
+				}
+			}
+
+			// Keep the contents alive, @m_loadedFiles could be rehashed by the nested includes.
+			const std::shared_ptr<const std::vector<char>> includedText = contents;
+
+			outHasIncludedFile = true;
+			m_includeDepth++;
+			const bool succeeded =
+			    processFile(std::string_view(includedText->data(), includedText->size() - 1), includeName);
+			m_includeDepth--;
+
+			return succeeded;
+		}
+
+		if (name == "pragma") {
+			if (directive == "once") {
+				m_pragmaOnceFiles.insert(m_includeDir + "/" + filename);
+			}
+			else {
+				// Left for the compiler, like mcpp does.
+				m_result += "#pragma ";
+				m_result.append(directive);
+			}
+			return true;
+		}
+
+		// #error, #line and anything else is left to mcpp.
+		return false;
+	}
+
+	bool BuiltinPreprocessor::expandText(const std::string_view text, const int depth)
+	{
+		if (depth > kMaxDepth) {
+			return false;
+		}
+
+		size_t pos = 0;
+		while (pos < text.size()) {
+			const std::string_view rest = text.substr(pos);
+			size_t length = 1;
+			if (rest[0] == '"' || rest[0] == '\'') {
+				length = getQuotedLength(rest);
+				if (length == 0) {
+					return false;
+				}
+				m_result.append(rest.substr(0, length));
+			}
+			else if (isDigit(rest[0]) || (rest[0] == '.' && rest.size() > 1 && isDigit(rest[1]))) {
+				// The suffixes of the numbers (like "f" in 1.0f) are not identifiers.
+				length = getNumberLength(rest);
+				m_result.append(rest.substr(0, length));
+			}
+			else if (isIdentifierStart(rest[0])) {
+				while (length < rest.size() && isIdentifierChar(rest[length])) {
+					length++;
+				}
+
+				const std::string_view identifier = rest.substr(0, length);
+				if (identifier == "__LINE__" || identifier == "__FILE__" || identifier == "__COUNTER__") {
+					return false;
+				}
+
+				bool isExpanding = false;
+				for (const std::string_view expandingMacro : m_expandingMacros) {
+					isExpanding |= expandingMacro == identifier;
+				}
+
+				const std::string* const replacement = isExpanding ? nullptr : findMacro(identifier);
+				if (replacement) {
+					// Surrounded by spaces, so the replacement doesn't merge with the text around it.
+					m_result.push_back(' ');
+					m_expandingMacros.push_back(identifier);
+					const bool succeeded = expandText(*replacement, depth + 1);
+					m_expandingMacros.pop_back();
+					if (!succeeded) {
+						return false;
+					}
+					m_result.push_back(' ');
+				}
+				else {
+					m_result.append(identifier);
+				}
+			}
+			else {
+				m_result.push_back(rest[0]);
+			}
+
+			pos += length;
+		}
+
+		return true;
+	}
+
+	bool BuiltinPreprocessor::expandExpression(const std::string_view expression, std::string& result, const int depth)
+	{
+		if (depth > kMaxDepth) {
+			return false;
+		}
+
+		std::string_view rest = expression;
+		while (!rest.empty()) {
+			if (rest[0] == '"' || rest[0] == '\'') {
+				// Character literals are rarely used in #if, leave them to mcpp.
+				return false;
+			}
+
+			if (isDigit(rest[0])) {
+				const size_t length = getNumberLength(rest);
+				result.append(rest.substr(0, length));
+				rest.remove_prefix(length);
+				continue;
+			}
+
+			if (!isIdentifierStart(rest[0])) {
+				result.push_back(rest[0]);
+				rest.remove_prefix(1);
+				continue;
+			}
+
+			const std::string_view identifier = takeIdentifier(rest);
+			if (identifier == "defined") {
+				// Both "defined NAME" and "defined(NAME)".
+				rest = trimSpaces(rest);
+				const bool hasParenthesis = !rest.empty() && rest[0] == '(';
+				if (hasParenthesis) {
+					rest.remove_prefix(1);
+				}
+
+				const std::string_view macroName = takeIdentifier(rest);
+				if (macroName.empty()) {
+					return false;
+				}
+
+				if (hasParenthesis) {
+					rest = trimSpaces(rest);
+					if (rest.empty() || rest[0] != ')') {
+						return false;
+					}
+					rest.remove_prefix(1);
+				}
+
+				result += findMacro(macroName) ? " 1 " : " 0 ";
+				continue;
+			}
+
+			bool isExpanding = false;
+			for (const std::string_view expandingMacro : m_expandingMacros) {
+				isExpanding |= expandingMacro == identifier;
+			}
+
+			const std::string* const replacement = isExpanding ? nullptr : findMacro(identifier);
+			if (replacement) {
+				result.push_back(' ');
+				m_expandingMacros.push_back(identifier);
+				const bool succeeded = expandExpression(*replacement, result, depth + 1);
+				m_expandingMacros.pop_back();
+				if (!succeeded) {
+					return false;
+				}
+				result.push_back(' ');
+			}
+			else {
+				// Identifiers that are not macros are 0.
+				result += " 0 ";
+			}
+		}
+
+		return true;
+	}
+
+	bool BuiltinPreprocessor::evaluateExpression(const std::string_view expression, bool& result)
+	{
+		std::string expanded;
+		if (!expandExpression(expression, expanded, 0)) {
+			return false;
+		}
+
+		sint64 value = 0;
+		if (!ExpressionEvaluator(expanded).evaluate(value)) {
+			return false;
+		}
+
+		result = value != 0;
+		return true;
+	}
+
+} // namespace
+
+bool preprocessCodeBuiltin(
+    std::string& result,
+    const char* code,
+    const char* const codeFilename,
+    const char* const* macros,
+    const int numMacros,
+    const std::string& includeDir,
+    std::set<std::string>* outIncludedFiles,
+    const char* const trackedMacro,
+    bool* const outIsTrackedMacroReferenced)
+{
+	if (isStringEmpty(code) || isStringEmpty(codeFilename)) {
+		return false;
+	}
+
+	BuiltinPreprocessor preprocessor(includeDir, trackedMacro);
+	for (int t = 0; t < numMacros; ++t) {
+		preprocessor.defineFromCommandLine(macros[t]);
+	}
+
+	if (!preprocessor.processFile(code, codeFilename)) {
+		return false;
+	}
+
+	result = std::move(preprocessor.m_result);
+
+	if (outIncludedFiles != nullptr) {
+		outIncludedFiles->insert(preprocessor.m_includedFiles.begin(), preprocessor.m_includedFiles.end());
+	}
+
+	if (outIsTrackedMacroReferenced != nullptr) {
+		*outIsTrackedMacroReferenced = preprocessor.m_isTrackedMacroReferenced;
+	}
+
+	return true;
+}
+
+} // namespace sge
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "sge_utils/types.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sge {
+
+/// IncludeFilesCache keeps the contents of the included files, so they aren't read from the disk again for every
+/// shader permutation and every shader stage. It is shared by all threads.
+/// A file is read again if its modification time has changed, so the edited files are picked up when the shaders
+/// get reloaded.
+struct IncludeFilesCache {
+	/// Returns the contents of the file followed by a '\0' or nullptr if the file couldn't be read.
+	/// The returned contents stay valid even if the file gets read again by another thread.
+	std::shared_ptr<const std::vector<char>> load(const std::string& filename);
+
+  private:
+	struct Entry {
+		sint64 modTime = 0;
+		std::shared_ptr<const std::vector<char>> contents;
+	};
+
+	std::mutex m_lock;
+	std::unordered_map<std::string, Entry> m_entries;
+};
+
+/// Returns the cache used by all preprocessors.
+IncludeFilesCache& getIncludeFilesCache();
+
+} // namespace sge
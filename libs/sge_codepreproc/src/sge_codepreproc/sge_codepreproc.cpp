@@ -1,4 +1,5 @@
 #include "sge_codepreproc/sge_codepreproc.h"
+#include "sge_codepreproc/IncludeFilesCache.h"
 
 #include "sge_utils/io/FileStream.h"
 #include "sge_utils/text/format.h"
@@ -10,15 +11,87 @@
 
 namespace sge {
 
+std::shared_ptr<const std::vector<char>> IncludeFilesCache::load(const std::string& filename)
+{
+	const sint64 modTime = FileReadStream::getFileModTime(filename.c_str());
+	if (modTime == 0) {
+		return nullptr;
+	}
+
+	{
+		const std::lock_guard<std::mutex> lock(m_lock);
+		auto itr = m_entries.find(filename);
+		if (itr != m_entries.end() && itr->second.modTime == modTime) {
+			return itr->second.contents;
+		}
+	}
+
+	// The file is read without holding the lock, if a few threads read it at the same time the last one wins.
+	std::shared_ptr<std::vector<char>> contents = std::make_shared<std::vector<char>>();
+	if (FileReadStream::readFile(filename.c_str(), *contents) == false) {
+		return nullptr;
+	}
+	contents->emplace_back('\0');
+
+	const std::lock_guard<std::mutex> lock(m_lock);
+	Entry& entry = m_entries[filename];
+	entry.modTime = modTime;
+	entry.contents = std::move(contents);
+	return entry.contents;
+}
+
+IncludeFilesCache& getIncludeFilesCache()
+{
+	static IncludeFilesCache cache;
+	return cache;
+}
+
 /// UserData is a structures that holds the user state while parsing with mcpp.
 struct UserData {
 	const char* code = nullptr;
 	const char* codeFilename = nullptr;
 	const std::string& includeDir;
-	std::unordered_map<std::string, std::vector<char>>& includeFiles;
+	std::unordered_map<std::string, std::shared_ptr<const std::vector<char>>>& includeFiles;
 };
 
 std::string preprocessCode(
+    const char* code,
+    const char* const codeFilename,
+    const char* const* macros,
+    const int numMacros,
+    const std::string& includeDir,
+    std::set<std::string>* outIncludedFiles,
+    const char* const trackedMacro,
+    bool* const outIsTrackedMacroReferenced)
+{
+	if (isStringEmpty(code) || isStringEmpty(codeFilename)) {
+		return std::string();
+	}
+
+	std::string result;
+	if (preprocessCodeBuiltin(
+	        result,
+	        code,
+	        codeFilename,
+	        macros,
+	        numMacros,
+	        includeDir,
+	        outIncludedFiles,
+	        trackedMacro,
+	        outIsTrackedMacroReferenced)) {
+		return result;
+	}
+
+	// The code uses something that the built-in preprocessor doesn't support or has errors,
+	// in the later case mcpp is also the one that reports them.
+	if (outIsTrackedMacroReferenced != nullptr) {
+		*outIsTrackedMacroReferenced = true;
+	}
+
+	return preprocessCodeMcpp(code, codeFilename, macros, numMacros, includeDir, outIncludedFiles);
+}
+
+std::string preprocessCodeMcpp(
     const char* code,
     const char* const codeFilename,
     const char* const* macros,
@@ -27,10 +100,9 @@ std::string preprocessCode(
     std::set<std::string>* outIncludedFiles)
 {
 	if (isStringEmpty(code) || isStringEmpty(codeFilename)) {
-		return false;
+		return std::string();
 	}
 
-	// Not that anyone is going to do it but:
 	// mcpp uses some global state, so it isn't thread safe.
 	// That is why we need that lock.
 	static std::mutex mcppSafetyLock;
@@ -55,8 +127,8 @@ std::string preprocessCode(
 	}
 
 
-	// This variable will hold the contents of all included files.
-	std::unordered_map<std::string, std::vector<char>> includeFiles;
+	// This variable will hold the contents of all included files, it keeps them alive while mcpp is using them.
+	std::unordered_map<std::string, std::shared_ptr<const std::vector<char>>> includeFiles;
 
 	UserData udata = {code, codeFilename, includeDir, includeFiles};
 
@@ -80,20 +152,19 @@ std::string preprocessCode(
 		const std::string fileToLoad = udata.includeDir + std::string("/") + filename;
 
 		// Check if the file has already been read.
-		auto itrExisting = udata.includeFiles.find(fileToLoad.c_str());
-		std::vector<char>* pFileData = nullptr;
+		auto itrExisting = udata.includeFiles.find(fileToLoad);
+		const std::vector<char>* pFileData = nullptr;
 		if (itrExisting != udata.includeFiles.end()) {
-			pFileData = &itrExisting->second;
+			pFileData = itrExisting->second.get();
 		}
 		else {
-			std::vector<char> data;
-			if (sge::FileReadStream::readFile(fileToLoad.c_str(), data) == false) {
+			std::shared_ptr<const std::vector<char>> data = getIncludeFilesCache().load(fileToLoad);
+			if (data == nullptr) {
 				return 0;
 			}
-			data.emplace_back('\0');
 
+			pFileData = data.get();
 			udata.includeFiles[fileToLoad] = std::move(data);
-			pFileData = &udata.includeFiles[fileToLoad];
 		}
 
 		// Pass the file contents to mcpp if the file has been found.
@@ -8,6 +8,9 @@ namespace sge {
 
 
 /// Preprocesses the specified code using a C-style preprocessor.
+/// The built-in preprocessor is used (see @preprocessCodeBuiltin), if the code needs something that it doesn't support
+/// mcpp is used instead. The included files are cached between the calls, see IncludeFilesCache.
+/// Thread-safe, however the calls that end up using mcpp are done one at a time.
 /// @param [in] code the code to be compiled
 /// @param [in] codeFilename is the name of the file that contains the code (could be anything really that fits the
 /// command line).
@@ -17,7 +20,38 @@ namespace sge {
 /// that one directory).
 /// @param [out] outIncludedFiles optional list of all included files during the parsing, excluding @codeFilename if not
 /// included explicitly.
+/// @param [in] trackedMacro optional name of a macro, see @outIsTrackedMacroReferenced.
+/// @param [out] outIsTrackedMacroReferenced optional, set to false if the code never checks or uses @trackedMacro,
+/// meaning that the result would be the same no matter if it is defined or not. Always true if mcpp was used.
 std::string preprocessCode(
+    const char* code,
+    const char* const codeFilename,
+    const char* const* macros,
+    const int numMacros,
+    const std::string& includeDir,
+    std::set<std::string>* outIncludedFiles,
+    const char* const trackedMacro = nullptr,
+    bool* const outIsTrackedMacroReferenced = nullptr);
+
+/// The built-in preprocessor used by @preprocessCode. Unlike mcpp it has no global state and could be used by many
+/// threads at the same time. It supports only what the shaders need:
+/// #include, object-like #define, #undef, #if, #ifdef, #ifndef, #elif, #else, #endif and #pragma.
+/// Returns false if the code uses anything else (like function-like macros) or has errors, @result is undefined then.
+/// See @preprocessCode for the parameters.
+bool preprocessCodeBuiltin(
+    std::string& result,
+    const char* code,
+    const char* const codeFilename,
+    const char* const* macros,
+    const int numMacros,
+    const std::string& includeDir,
+    std::set<std::string>* outIncludedFiles,
+    const char* const trackedMacro = nullptr,
+    bool* const outIsTrackedMacroReferenced = nullptr);
+
+/// Preprocesses the code with mcpp only. mcpp uses some global state, so only one thread could use it at a time.
+/// See @preprocessCode for the parameters.
+std::string preprocessCodeMcpp(
     const char* code,
     const char* const codeFilename,
     const char* const* macros,
@@ -35,6 +35,11 @@
 #define kHasDiffuseTexForAlphaMasking_No 0
 #define kHasDiffuseTexForAlphaMasking_Yes 1
 
+// OPT_SpriteParticlesPass, see SpriteParticles.hlsl
+#define kSpriteParticlesPass_Color 0
+#define kSpriteParticlesPass_ShadowMap 1
+#define kSpriteParticlesPass_PointLightShadowMap 2
+
 #define kLightFlg_HasShadowMap 1
 
 // [LIGHTYPE_ENUM_COPY]
@@ -0,0 +1,90 @@
+//--------------------------------------------------------------------
+// Draws camera facing sprite particles as instances of a single quad.
+// Slot 0 holds the quad corners, slot 1 holds one SpriteParticleInstance per particle.
+// The shadow map passes write only the depth of the sprites, see OPT_SpriteParticlesPass in ShadeCommon.h.
+//--------------------------------------------------------------------
+#include "ShadeCommon.h"
+
+//--------------------------------------------------------------------
+// Uniforms.
+//--------------------------------------------------------------------
+uniform float4x4 uProjView;
+uniform float4 uCameraRightWs;
+uniform float4 uCameraUpWs;
+
+uniform sampler2D uTexture;
+
+#if OPT_SpriteParticlesPass == kSpriteParticlesPass_PointLightShadowMap
+// Point light shadow map building specifics, see FWDDefault_buildShadowMaps.hlsl.
+uniform float3 uPointLightPositionWs;
+uniform float uPointLightFarPlaneDistance;
+#endif
+
+//--------------------------------------------------------------------
+// Vertex Shader.
+//--------------------------------------------------------------------
+struct VS_INPUT
+{
+	// Per vertex data, the corner of the quad in [-1;1].
+	float2 a_corner : a_corner;
+
+	// Per instance data.
+	float3 a_instPosition : a_instPosition;
+	float2 a_instHalfSize : a_instHalfSize;
+	float4 a_instColor : a_instColor;
+	float4 a_instUVRegion : a_instUVRegion;
+};
+
+struct VS_OUTPUT {
+	float4 SV_Position : SV_Position;
+	float4 v_color : v_color;
+	float2 v_uv : v_uv;
+#if OPT_SpriteParticlesPass == kSpriteParticlesPass_PointLightShadowMap
+	float3 vertexPosWs : vertexPosWs;
+#endif
+};
+
+VS_OUTPUT vsMain(VS_INPUT vsin)
+{
+	VS_OUTPUT res;
+
+	const float2 offset = vsin.a_corner * vsin.a_instHalfSize;
+	const float3 worldPos = vsin.a_instPosition + uCameraRightWs.xyz * offset.x + uCameraUpWs.xyz * offset.y;
+
+	res.SV_Position = mul(uProjView, float4(worldPos, 1.0));
+	res.v_color = vsin.a_instColor;
+	res.v_uv = lerp(vsin.a_instUVRegion.xy, vsin.a_instUVRegion.zw, vsin.a_corner * 0.5 + 0.5);
+#if OPT_SpriteParticlesPass == kSpriteParticlesPass_PointLightShadowMap
+	res.vertexPosWs = worldPos;
+#endif
+
+	return res;
+}
+
+//--------------------------------------------------------------------
+// Pixel Shader.
+//--------------------------------------------------------------------
+struct PS_OUTPUT {
+	float4 target0 : SV_Target0;
+#if OPT_SpriteParticlesPass == kSpriteParticlesPass_PointLightShadowMap
+	float zDepth : SV_Depth;
+#endif
+};
+
+PS_OUTPUT psMain(VS_OUTPUT IN)
+{
+	PS_OUTPUT psOut;
+	psOut.target0 = tex2D(uTexture, IN.v_uv) * IN.v_color;
+
+	// Discard the (almost) fully transparent parts of the sprites, so they don't cast shadows either.
+	if (psOut.target0.w <= 0.1f) {
+		discard;
+	}
+
+#if OPT_SpriteParticlesPass == kSpriteParticlesPass_PointLightShadowMap
+	// The point light shadow maps store a linear depth, see [FWDDEF_POINTLIGHT_LINEAR_ZDEPTH].
+	psOut.zDepth = length(IN.vertexPosWs - uPointLightPositionWs) / uPointLightFarPlaneDistance;
+#endif
+
+	return psOut;
+}
@@ -3,8 +3,23 @@
 namespace sge {
 bool AssetAudio::loadAssetFromFile(const char* const path)
 {
-	m_audioData = std::make_shared<AudioData>();
-	m_audioData->createFromFile(path);
+	prepareLoadAssetFromFile(path);
+	return finalizeLoadAssetFromFile(path);
+}
+
+void AssetAudio::prepareLoadAssetFromFile(const char* const path)
+{
+	m_preparedAudioData = std::make_shared<AudioData>();
+	m_preparedAudioData->createFromFile(path);
+}
+
+bool AssetAudio::finalizeLoadAssetFromFile(const char* const path)
+{
+	if (!m_preparedAudioData) {
+		prepareLoadAssetFromFile(path);
+	}
+
+	m_audioData = std::move(m_preparedAudioData);
 
 	m_status = AssetStatus_Loaded;
 
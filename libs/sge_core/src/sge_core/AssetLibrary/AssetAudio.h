@@ -20,9 +20,15 @@ struct SGE_CORE_API AssetAudio : public Asset, public IAssetInterface_Audio {
 	virtual AudioDataPtr getAudioData() override { return m_audioData; }
 
 	bool loadAssetFromFile(const char* const path) override;
+	void prepareLoadAssetFromFile(const char* const path) override;
+	bool finalizeLoadAssetFromFile(const char* const path) override;
 
   public:
 	AudioDataPtr m_audioData;
+
+  private:
+	/// The audio data read by @prepareLoadAssetFromFile, it becomes @m_audioData once finalized.
+	AudioDataPtr m_preparedAudioData;
 };
 
 } // namespace sge
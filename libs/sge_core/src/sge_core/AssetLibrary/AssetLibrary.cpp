@@ -19,7 +19,10 @@
 #include "IAsset.h"
 #include "IAssetInterface.h"
 
+#include <algorithm>
 #include <filesystem>
+#include <functional>
+#include <unordered_set>
 
 namespace sge {
 
@@ -214,14 +217,15 @@ std::string AssetLibrary::resloveAssetPathToRelative(const char* pathRaw) const
 	return std::move(pathToAsset);
 }
 
-AssetPtr AssetLibrary::getAssetFromFile(const char* path, const char* localDirectory, bool loadIfMissing)
+std::string
+    AssetLibrary::resolveAssetPath(const char* path, const char* localDirectory, AssetIfaceType& outType) const
 {
+	outType = assetIface_unknown;
+
 	if (path == nullptr || path[0] == '\0') {
-		return nullptr;
+		return std::string();
 	}
 
-	const double loadStartTime = Timer::now_seconds();
-
 	std::string pathToAsset;
 	if (localDirectory) {
 		std::string localPath = std::string(localDirectory) + "/" + path;
@@ -234,12 +238,25 @@ AssetPtr AssetLibrary::getAssetFromFile(const char* path, const char* localDirec
 	}
 
 	if (pathToAsset.empty()) {
-		return nullptr;
+		return std::string();
 	}
 
-	const AssetIfaceType assetType = assetIface_guessFromExtension(extractFileExtension(path).c_str(), false);
-	if (assetType == assetIface_unknown) {
+	outType = assetIface_guessFromExtension(extractFileExtension(path).c_str(), false);
+	if (outType == assetIface_unknown) {
 		sgeAssert(false);
+		return std::string();
+	}
+
+	return pathToAsset;
+}
+
+AssetPtr AssetLibrary::getAssetFromFile(const char* path, const char* localDirectory, bool loadIfMissing)
+{
+	const double loadStartTime = Timer::now_seconds();
+
+	AssetIfaceType assetType = assetIface_unknown;
+	const std::string pathToAsset = resolveAssetPath(path, localDirectory, assetType);
+	if (pathToAsset.empty()) {
 		return nullptr;
 	}
 
@@ -249,6 +266,17 @@ AssetPtr AssetLibrary::getAssetFromFile(const char* path, const char* localDirec
 		return itrFindAssetByPath->second;
 	}
 
+	// If the asset is being loaded asynchronously, finish the loading now as the caller needs it.
+	if (itrFindAssetByPath != m_allAssets.end() && itrFindAssetByPath->second->getStatus() == AssetStatus_Loading) {
+		if (loadIfMissing) {
+			if (AsyncLoad* const asyncLoad = findAsyncLoad(itrFindAssetByPath->second.get())) {
+				finalizeAsyncLoad(*asyncLoad);
+			}
+		}
+
+		return itrFindAssetByPath->second;
+	}
+
 	if (!loadIfMissing) {
 		if (itrFindAssetByPath == m_allAssets.end()) {
 			// If the asset has not been created, create one but do not load it.
@@ -279,6 +307,205 @@ AssetPtr AssetLibrary::getAssetFromFile(const char* path, const char* localDirec
 	return assetToModify;
 }
 
+AssetPtr AssetLibrary::getAssetFromFileAsync(const char* path, const char* localDirectory)
+{
+	AssetIfaceType assetType = assetIface_unknown;
+	const std::string pathToAsset = resolveAssetPath(path, localDirectory, assetType);
+	if (pathToAsset.empty()) {
+		return nullptr;
+	}
+
+	// Check if the asset is already loaded or loading, if so just return it.
+	auto itrFindAssetByPath = m_allAssets.find(pathToAsset);
+	if (itrFindAssetByPath != m_allAssets.end()) {
+		const AssetStatus status = itrFindAssetByPath->second->getStatus();
+		if (status == AssetStatus_Loaded || status == AssetStatus_Loading) {
+			return itrFindAssetByPath->second;
+		}
+	}
+
+	AssetPtr asset =
+	    itrFindAssetByPath != m_allAssets.end() ? itrFindAssetByPath->second : newAsset(pathToAsset.c_str(), assetType);
+	sgeAssert(isAssetSupportingInteface(asset, assetType));
+
+	if (m_loadingThreadPool.isCreated() == false) {
+		// The main thread only finalizes the assets, so all the workers are background threads.
+		const int numLoadingWorkers =
+		    (m_numLoadingWorkers > 0) ? m_numLoadingWorkers : ThreadPool::getHardwareConcurrency();
+		m_loadingThreadPool.create(numLoadingWorkers + 1);
+	}
+
+	asset->m_status = AssetStatus_Loading;
+
+	m_asyncLoads.emplace_back(std::make_unique<AsyncLoad>());
+	AsyncLoad& asyncLoad = *m_asyncLoads.back();
+	asyncLoad.asset = asset;
+	asyncLoad.loadStartTime = Timer::now_seconds();
+
+	// The worker only touches the asset itself, the asset is kept alive by @asyncLoad until it gets finalized
+	// or cancelled, both wait for the job to finish.
+	AsyncLoad* const loadToPrepare = &asyncLoad;
+	m_loadingThreadPool.enqueue(
+	    [loadToPrepare]() -> void {
+		    if (loadToPrepare->isCancelled.load(std::memory_order_relaxed) == false) {
+			    Asset* const assetToPrepare = loadToPrepare->asset.get();
+			    assetToPrepare->prepareLoadAssetFromFile(assetToPrepare->getPath().c_str());
+		    }
+	    },
+	    &asyncLoad.prepareJob);
+
+	return asset;
+}
+
+int AssetLibrary::updateAsyncLoading()
+{
+	if (m_asyncLoads.empty()) {
+		return 0;
+	}
+
+	// If the pool has no background threads (for example in web builds) nobody else is going to decode the assets.
+	if (m_loadingThreadPool.getNumWorkers() <= 1) {
+		for (const std::unique_ptr<AsyncLoad>& asyncLoad : m_asyncLoads) {
+			m_loadingThreadPool.wait(asyncLoad->prepareJob);
+		}
+	}
+
+	// Queue the dependencies of the decoded assets, so they get decoded in parallel.
+	// The newly queued loads get appended and visited by this loop as well.
+	for (size_t t = 0; t < m_asyncLoads.size(); ++t) {
+		AsyncLoad& asyncLoad = *m_asyncLoads[t];
+		if (asyncLoad.isFinalized || asyncLoad.areDependenciesQueued || asyncLoad.prepareJob.isDone() == false) {
+			continue;
+		}
+
+		asyncLoad.areDependenciesQueued = true;
+
+		std::vector<AssetDependency> dependencies;
+		asyncLoad.asset->getPreparedDependencies(dependencies);
+		for (const AssetDependency& dependency : dependencies) {
+			const char* const localDirectory =
+			    dependency.localDirectory.empty() ? nullptr : dependency.localDirectory.c_str();
+			AssetPtr dependencyAsset = getAssetFromFileAsync(dependency.path.c_str(), localDirectory);
+			if (dependencyAsset) {
+				asyncLoad.dependencies.emplace_back(std::move(dependencyAsset));
+			}
+		}
+	}
+
+	// An asset is ready to be finalized when it and all its dependencies are decoded.
+	// This way finalizing it never waits for the workers.
+	// The assets could depend on each other (A -> B -> A), a load that is already visited is treated as ready.
+	// If it turns out not to be, the check that visited it first fails anyway.
+	std::unordered_set<const AsyncLoad*> visitedLoads;
+	std::function<bool(const AsyncLoad&)> isReadyForFinalize = [&](const AsyncLoad& asyncLoad) -> bool {
+		if (asyncLoad.isFinalized) {
+			return true;
+		}
+
+		if (asyncLoad.prepareJob.isDone() == false || asyncLoad.areDependenciesQueued == false) {
+			return false;
+		}
+
+		if (visitedLoads.insert(&asyncLoad).second == false) {
+			return true;
+		}
+
+		for (const AssetPtr& dependency : asyncLoad.dependencies) {
+			const AsyncLoad* const dependencyLoad = findAsyncLoad(dependency.get());
+			if (dependencyLoad && !isReadyForFinalize(*dependencyLoad)) {
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	for (size_t t = 0; t < m_asyncLoads.size(); ++t) {
+		AsyncLoad& asyncLoad = *m_asyncLoads[t];
+		visitedLoads.clear();
+		if (asyncLoad.isFinalized == false && isReadyForFinalize(asyncLoad)) {
+			finalizeAsyncLoad(asyncLoad);
+		}
+	}
+
+	m_asyncLoads.erase(
+	    std::remove_if(
+	        m_asyncLoads.begin(),
+	        m_asyncLoads.end(),
+	        [](const std::unique_ptr<AsyncLoad>& asyncLoad) -> bool { return asyncLoad->isFinalized; }),
+	    m_asyncLoads.end());
+
+	return int(m_asyncLoads.size());
+}
+
+void AssetLibrary::waitForAsyncLoading()
+{
+	while (updateAsyncLoading() > 0) {
+		// Help the workers with decoding the assets that are not ready yet.
+		for (const std::unique_ptr<AsyncLoad>& asyncLoad : m_asyncLoads) {
+			m_loadingThreadPool.wait(asyncLoad->prepareJob);
+		}
+	}
+}
+
+void AssetLibrary::cancelAsyncLoading()
+{
+	// Mark all loads first, so the workers skip the ones that haven't started while we wait for the rest.
+	for (const std::unique_ptr<AsyncLoad>& asyncLoad : m_asyncLoads) {
+		asyncLoad->isCancelled.store(true, std::memory_order_relaxed);
+	}
+
+	for (const std::unique_ptr<AsyncLoad>& asyncLoad : m_asyncLoads) {
+		m_loadingThreadPool.wait(asyncLoad->prepareJob);
+		if (asyncLoad->isFinalized == false) {
+			asyncLoad->asset->m_status = AssetStatus_NotLoaded;
+		}
+	}
+
+	m_asyncLoads.clear();
+}
+
+void AssetLibrary::setNumLoadingWorkers(int numWorkers)
+{
+	waitForAsyncLoading();
+
+	// The pool gets created again with the new number of workers on the next asynchronous load.
+	m_numLoadingWorkers = numWorkers;
+	m_loadingThreadPool.destroy();
+}
+
+AssetLibrary::AsyncLoad* AssetLibrary::findAsyncLoad(const Asset* const asset)
+{
+	for (const std::unique_ptr<AsyncLoad>& asyncLoad : m_asyncLoads) {
+		if (asyncLoad->asset.get() == asset && asyncLoad->isFinalized == false) {
+			return asyncLoad.get();
+		}
+	}
+
+	return nullptr;
+}
+
+void AssetLibrary::finalizeAsyncLoad(AsyncLoad& asyncLoad)
+{
+	if (asyncLoad.isFinalized) {
+		return;
+	}
+
+	// Mark it as finalized first, as the finalization might request the asset again via its dependencies.
+	asyncLoad.isFinalized = true;
+	m_loadingThreadPool.wait(asyncLoad.prepareJob);
+
+	Asset& asset = *asyncLoad.asset;
+	const bool loadSucceeded = asset.finalizeLoadAssetFromFile(asset.getPath().c_str());
+	asset.m_status = loadSucceeded ? AssetStatus_Loaded : AssetStatus_LoadFailed;
+	asset.m_loadAssetFromFileData.lastAcessTime = FileReadStream::getFileModTime(asset.getPath().c_str());
+
+	// Measure the loading time, including the time spent waiting for the workers.
+	const double loadEndTime = Timer::now_seconds();
+	sgeLogInfo(
+	    "Asset '%s' loaded asynchronously in %f seconds.\n", asset.getPath().c_str(), loadEndTime - asyncLoad.loadStartTime);
+}
+
 bool AssetLibrary::reloadAssetModified(AssetPtr& assetToModify)
 {
 	if (!assetToModify) {
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
 
 #include "sge_core/sgecore_api.h"
 #include "sge_utils/sge_utils.h"
+#include "sge_utils/threading/ThreadPool.h"
 
 #include "AssetAudio.h"
 #include "AssetMaterial.h"
@@ -47,7 +49,11 @@ SGE_CORE_API AssetIfaceType assetIface_guessFromExtension(const char* const ext,
 /// For example a 3D model might refer to a texture via a material.
 struct SGE_CORE_API AssetLibrary {
 	AssetLibrary() = default;
-	~AssetLibrary() = default;
+	~AssetLibrary()
+	{
+		cancelAsyncLoading();
+		m_loadingThreadPool.destroy();
+	}
 
 	/// Sets the specified directory to be a default asset directory.
 	/// While an asset could be loaded from any path (it is just a file after all)
@@ -61,6 +67,35 @@ struct SGE_CORE_API AssetLibrary {
 	/// (basically localDirectory + path), otherwise it would fallback to the currnet-working directory.
 	AssetPtr getAssetFromFile(const char* path, const char* localDirectory = nullptr, bool loadIfMissing = true);
 
+	/// Starts loading the requested asset on the loading worker threads and returns it immediately in
+	/// AssetStatus_Loading state. The files are read and decoded on the workers, while the GPU resources
+	/// get created on the main thread by @updateAsyncLoading. The dependencies of the asset (for example the materials
+	/// and the textures of a 3D model) start loading in parallel as soon as the asset is decoded.
+	/// If the asset gets requested with @getAssetFromFile while loading, it gets finished immediately.
+	/// The arguments are the same as @getAssetFromFile.
+	AssetPtr getAssetFromFileAsync(const char* path, const char* localDirectory = nullptr);
+
+	/// Finalizes the asynchronously loaded assets that are decoded (see @getAssetFromFileAsync).
+	/// Must be called on the main thread, usually once per frame.
+	/// Returns the number of assets that are still loading.
+	int updateAsyncLoading();
+
+	/// Blocks the calling (main) thread until all asynchronously loaded assets, including their dependencies, are
+	/// loaded. The calling thread helps with decoding the assets while waiting.
+	void waitForAsyncLoading();
+
+	/// Stops loading the assets requested with @getAssetFromFileAsync that aren't finalized yet.
+	/// The assets that are being decoded are waited for, the ones whose decoding hasn't started are skipped.
+	/// The cancelled assets go back to AssetStatus_NotLoaded, so they could be requested again.
+	void cancelAsyncLoading();
+
+	/// Returns the number of assets that are still loading asynchronously.
+	int getNumAsyncLoadsPending() const { return int(m_asyncLoads.size()); }
+
+	/// Changes the number of background threads used for loading assets asynchronously.
+	/// 0 or less means that one thread per hardware thread will be used.
+	void setNumLoadingWorkers(int numWorkers);
+
 	template <typename TAssetIface>
 	std::shared_ptr<TAssetIface>
 	    getLoadedAssetIface(const char* path, const char* localDirectory = nullptr, bool loadIfMissing = true)
@@ -124,10 +159,42 @@ struct SGE_CORE_API AssetLibrary {
 	std::string resloveAssetPathToRelative(const char* pathRaw) const;
 	AssetPtr newAsset(std::string assetPath, AssetIfaceType type);
 
+	/// Resolves the path the same way @getAssetFromFile does and guesses the type of the asset.
+	/// Returns an empty string if the path cannot be resolved.
+	std::string resolveAssetPath(const char* path, const char* localDirectory, AssetIfaceType& outType) const;
+
+	/// An asset being loaded asynchronously. See @getAssetFromFileAsync.
+	struct AsyncLoad {
+		AssetPtr asset;
+		double loadStartTime = 0.0;
+		/// Tracks the worker job calling Asset::prepareLoadAssetFromFile.
+		JobCounter prepareJob;
+		/// Set by @cancelAsyncLoading, the worker job skips the decoding if it hasn't started yet.
+		std::atomic<bool> isCancelled{false};
+		/// True once the dependencies of the asset have been queued for loading.
+		bool areDependenciesQueued = false;
+		/// The assets needed by @asset, they get finalized before it.
+		std::vector<AssetPtr> dependencies;
+		bool isFinalized = false;
+	};
+
+	/// Returns the pending asynchronous load of the specified asset or nullptr.
+	AsyncLoad* findAsyncLoad(const Asset* const asset);
+
+	/// Waits for the asset to get decoded and finalizes it on the calling thread.
+	void finalizeAsyncLoad(AsyncLoad& asyncLoad);
+
   private:
 	std::string m_gameAssetsDir;
 	std::map<std::string, AssetPtr> m_allAssets;
 	std::set<AssetPtr> m_assetsToReload;
+
+	/// The number of threads used to load assets asynchronously. See @setNumLoadingWorkers.
+	int m_numLoadingWorkers = 0;
+	/// Created on the first asynchronous load.
+	ThreadPool m_loadingThreadPool;
+	/// The assets being loaded asynchronously in the order they were requested.
+	std::vector<std::unique_ptr<AsyncLoad>> m_asyncLoads;
 };
 
 /// Returns true if the specified asset supports the specified interface.
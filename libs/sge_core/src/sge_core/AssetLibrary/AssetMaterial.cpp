@@ -1,20 +1,51 @@
 #include "AssetMaterial.h"
+#include "AssetLibrary.h"
 #include "sge_core/ICore.h"
 #include "sge_core/materials/MaterialFamilyList.h"
 #include "sge_utils/io/FileStream.h"
 #include "sge_utils/json/json.h"
 #include "sge_utils/text/Path.h"
+#include "sge_utils/text/format.h"
+#include <functional>
 
 namespace sge {
 
+AssetMaterial::AssetMaterial(std::string assetPath, AssetLibrary& ownerAssetLib)
+    : Asset(assetPath, ownerAssetLib)
+{
+}
+
+AssetMaterial::~AssetMaterial() = default;
+
 bool AssetMaterial::loadAssetFromFile(const char* const path)
 {
-	mtl.reset();
-	std::string jsonText;
+	prepareLoadAssetFromFile(path);
+	return finalizeLoadAssetFromFile(path);
+}
+
+void AssetMaterial::prepareLoadAssetFromFile(const char* const path)
+{
+	m_isPrepared = true;
+	m_preparedJson = std::make_unique<JsonParser>();
+
 	FileReadStream frs;
-	JsonParser jp;
-	if (frs.open(path) && jp.parse(&frs)) {
-		const JsonValue* jMtlRoot = jp.getRoot();
+	if (!frs.open(path) || !m_preparedJson->parse(&frs)) {
+		m_preparedJson.reset();
+	}
+}
+
+bool AssetMaterial::finalizeLoadAssetFromFile(const char* const path)
+{
+	if (!m_isPrepared) {
+		prepareLoadAssetFromFile(path);
+	}
+
+	const std::unique_ptr<JsonParser> jp = std::move(m_preparedJson);
+	m_isPrepared = false;
+
+	mtl.reset();
+	if (jp) {
+		const JsonValue* jMtlRoot = jp->getRoot();
 		std::string mtlDir = extractFileDir(path, true);
 		mtl = getCore()->getMaterialLib()->loadMaterialFromJson(jMtlRoot, mtlDir.c_str());
 	}
@@ -22,6 +53,38 @@ bool AssetMaterial::loadAssetFromFile(const char* const path)
 	return mtl != nullptr;
 }
 
+void AssetMaterial::getPreparedDependencies(std::vector<AssetDependency>& outDependencies) const
+{
+	if (!m_preparedJson || !m_preparedJson->getRoot()) {
+		return;
+	}
+
+	// The materials refer to textures relative to the material file (see DefaultPBRMtl::fromJson).
+	const std::string mtlDir = extractFileDir(getPath().c_str(), true);
+
+	const std::function<void(const JsonValue*)> collectAssetPaths = [&](const JsonValue* jValue) -> void {
+		if (jValue->isString()) {
+			const char* const str = jValue->GetString();
+			if (!isStringEmpty(str) &&
+			    assetIface_guessFromExtension(extractFileExtension(str).c_str(), false) != assetIface_unknown) {
+				outDependencies.push_back(AssetDependency{str, mtlDir});
+			}
+		}
+		else if (jValue->isMap()) {
+			for (const JsonMember& member : jValue->getMembers()) {
+				collectAssetPaths(member.value);
+			}
+		}
+		else if (jValue->isArray()) {
+			for (const JsonValue* const jElement : jValue->arr()) {
+				collectAssetPaths(jElement);
+			}
+		}
+	};
+
+	collectAssetPaths(m_preparedJson->getRoot());
+}
+
 bool AssetMaterial::saveAssetToFile(const char* const path) const
 {
 	if (mtl) {
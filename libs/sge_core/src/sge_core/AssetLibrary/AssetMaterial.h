@@ -6,6 +6,8 @@
 
 namespace sge {
 
+class JsonParser;
+
 struct SGE_CORE_API AssetIface_Material : public IAssetInterface {
 	AssetIface_Material() = default;
 	virtual ~AssetIface_Material() = default;
@@ -18,18 +20,31 @@ struct SGE_CORE_API AssetIface_Material_Simple : public AssetIface_Material {
 };
 
 struct SGE_CORE_API AssetMaterial : public Asset, public AssetIface_Material {
-	AssetMaterial(std::string assetPath, AssetLibrary& ownerAssetLib)
-	    : Asset(assetPath, ownerAssetLib)
-	{
-	}
+	AssetMaterial(std::string assetPath, AssetLibrary& ownerAssetLib);
+	~AssetMaterial();
 
 	IMaterial* getMaterial() const override { return mtl.get(); }
 
 	bool loadAssetFromFile(const char* const path) override;
 	bool saveAssetToFile(const char* const path) const;
 
+	/// Reads and parses the material json file.
+	void prepareLoadAssetFromFile(const char* const path) override;
+
+	/// Creates the material from the parsed json.
+	bool finalizeLoadAssetFromFile(const char* const path) override;
+
+	/// All the strings in the material json that look like paths to assets (usually textures).
+	void getPreparedDependencies(std::vector<AssetDependency>& outDependencies) const override;
+
   public:
 	std::unique_ptr<IMaterial> mtl;
+
+  private:
+	/// The parsed material file, produced by @prepareLoadAssetFromFile and consumed by @finalizeLoadAssetFromFile.
+	/// nullptr if the file could not be read or parsed.
+	std::unique_ptr<JsonParser> m_preparedJson;
+	bool m_isPrepared = false;
 };
 
 } // namespace sge
@@ -2,19 +2,25 @@
 #include "sge_core/ICore.h"
 #include "sge_core/model/ModelReader.h"
 #include "sge_log/Log.h"
-#include "sge_utils/io/FileStream.h"
 #include "sge_utils/text/Path.h"
+#include <filesystem>
 
 namespace sge {
 bool AssetModel3D::loadAssetFromFile(const char* const path)
 {
-	m_status = AssetStatus_LoadFailed;
+	prepareLoadAssetFromFile(path);
+	return finalizeLoadAssetFromFile(path);
+}
 
-	FileReadStream frs(path);
+void AssetModel3D::prepareLoadAssetFromFile(const char* const path)
+{
+	m_isPrepared = true;
+	m_isPrepareSucceeded = false;
 
-	if (frs.isOpened() == false) {
+	std::error_code fileCheckError;
+	if (!std::filesystem::is_regular_file(path, fileCheckError)) {
 		sgeLogError("Unable to find model asset: '%s'!\n", path);
-		return false;
+		return;
 	}
 
 	// Reset the option to a valid value.
@@ -23,11 +29,25 @@ bool AssetModel3D::loadAssetFromFile(const char* const path)
 	ModelLoadSettings loadSettings;
 	loadSettings.assetDir = extractFileDir(path, true);
 
+	// Binary model files get memory mapped, the json-headed ones are read with a stream.
 	ModelReader modelReader;
-	const bool succeeded = modelReader.loadModel(loadSettings, &frs, m_modelOpt.get());
+	m_isPrepareSucceeded = modelReader.loadModelFromFile(loadSettings, path, m_modelOpt.get());
 
-	if (!succeeded) {
+	if (!m_isPrepareSucceeded) {
 		sgeLogError("Unable to load model asset: '%s'!\n", path);
+	}
+}
+
+bool AssetModel3D::finalizeLoadAssetFromFile(const char* const path)
+{
+	m_status = AssetStatus_LoadFailed;
+
+	if (!m_isPrepared) {
+		prepareLoadAssetFromFile(path);
+	}
+
+	m_isPrepared = false;
+	if (!m_isPrepareSucceeded) {
 		return false;
 	}
 
@@ -36,10 +56,23 @@ bool AssetModel3D::loadAssetFromFile(const char* const path)
 	m_staticEval.initialize(m_modelOpt.getPtr());
 	m_staticEval.evaluateStatic();
 
-	if (succeeded) {
-		m_status = AssetStatus_Loaded;
-	}
+	m_status = AssetStatus_Loaded;
 
 	return m_status == AssetStatus_Loaded;
 }
+
+void AssetModel3D::getPreparedDependencies(std::vector<AssetDependency>& outDependencies) const
+{
+	if (!m_isPrepared || !m_isPrepareSucceeded) {
+		return;
+	}
+
+	for (int iMaterial = 0; iMaterial < m_modelOpt->numMaterials(); ++iMaterial) {
+		const ModelMaterial* const rawMaterial = m_modelOpt->materialAt(iMaterial);
+		if (!rawMaterial->assetForThisMaterial.empty()) {
+			outDependencies.push_back(
+			    AssetDependency{rawMaterial->assetForThisMaterial, m_modelOpt->getModelLoadSetting().assetDir});
+		}
+	}
+}
 } // namespace sge
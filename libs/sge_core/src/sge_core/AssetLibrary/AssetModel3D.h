@@ -37,9 +37,23 @@ struct SGE_CORE_API AssetModel3D : public Asset, public AssetIface_Model3D {
 
 	bool loadAssetFromFile(const char* const path) override;
 
+	/// Reads and parses the model file.
+	void prepareLoadAssetFromFile(const char* const path) override;
+
+	/// Creates the vertex and index buffers of the parsed model and loads its materials.
+	bool finalizeLoadAssetFromFile(const char* const path) override;
+
+	/// The materials used by the parsed model.
+	void getPreparedDependencies(std::vector<AssetDependency>& outDependencies) const override;
+
   public:
 	Optional<Model> m_modelOpt;
 	EvaluatedModel m_staticEval;
+
+  private:
+	/// True if @prepareLoadAssetFromFile has parsed the model in @m_modelOpt, but it is not yet finalized.
+	bool m_isPrepared = false;
+	bool m_isPrepareSucceeded = false;
 };
 
 } // namespace sge
@@ -4,10 +4,27 @@
 namespace sge {
 bool AssetText::loadAssetFromFile(const char* const path)
 {
-	m_status = AssetStatus_LoadFailed;
+	prepareLoadAssetFromFile(path);
+	return finalizeLoadAssetFromFile(path);
+}
 
+void AssetText::prepareLoadAssetFromFile(const char* const path)
+{
 	m_text.clear();
-	if (!FileReadStream::readTextFile(path, m_text)) {
+	m_isPrepared = true;
+	m_isPrepareSucceeded = FileReadStream::readTextFile(path, m_text);
+}
+
+bool AssetText::finalizeLoadAssetFromFile(const char* const path)
+{
+	m_status = AssetStatus_LoadFailed;
+
+	if (!m_isPrepared) {
+		prepareLoadAssetFromFile(path);
+	}
+
+	m_isPrepared = false;
+	if (!m_isPrepareSucceeded) {
 		return false;
 	}
 
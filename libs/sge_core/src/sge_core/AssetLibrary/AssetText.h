@@ -17,9 +17,13 @@ struct SGE_CORE_API AssetText : public Asset, public IAssetInterface_Text {
 	virtual const std::string& getText() const override { return m_text; }
 
 	bool loadAssetFromFile(const char* const path) override;
+	void prepareLoadAssetFromFile(const char* const path) override;
+	bool finalizeLoadAssetFromFile(const char* const path) override;
 
   private:
 	std::string m_text;
+	bool m_isPrepared = false;
+	bool m_isPrepareSucceeded = false;
 };
 
 
@@ -153,6 +153,10 @@ AssetTextureMeta loadAssetTextureMeta2(const std::string& baseAssetPath)
 
 			const JsonValue* jShoudGenerateMips = jRoot->getMember("shouldGenerateMips");
 			result.shouldGenerateMips = jShoudGenerateMips && jShoudGenerateMips->jid == JID_TRUE;
+
+			const JsonValue* jCompression = jRoot->getMember("compression");
+			result.compression = jCompression ? textureCompression_fromString(jCompression->GetString())
+			                                  : textureCompression_none;
 		}
 
 		return result;
@@ -166,32 +170,55 @@ AssetTextureMeta loadAssetTextureMeta2(const std::string& baseAssetPath)
 	return AssetTextureMeta();
 }
 
-AssetTexture2d::DDSLoadCode AssetTexture2d::loadDDS(const char* const rawPath)
+AssetTexture2d::PreparedTexture::~PreparedTexture()
+{
+	if (pixelsRGBA8 != nullptr) {
+		stbi_image_free(pixelsRGBA8);
+		pixelsRGBA8 = nullptr;
+	}
+}
+
+AssetTexture2d::DDSLoadCode AssetTexture2d::prepareDDS(const char* const rawPath, PreparedTexture& prepared)
 {
-	std::string const ddsPath = (extractFileExtension(rawPath) == "dds") ? rawPath : std::string(rawPath) + ".dds";
+	const bool isDDSRequested = extractFileExtension(rawPath) == "dds";
+	std::string const ddsPath = isDDSRequested ? rawPath : std::string(rawPath) + ".dds";
 
-	std::vector<char> ddsDataRaw;
-	if (FileReadStream::readFile(ddsPath.c_str(), ddsDataRaw) == false) {
+	if (FileReadStream::readFile(ddsPath.c_str(), prepared.ddsFileData) == false) {
+		return ddsLoadCode_fileDoesntExist;
+	}
+
+	// A cooked *.dds equivalent is left over from a compression setting that is no longer used.
+	// It might be out of date, so prefer the source file if there is one.
+	uint32 cookKey = 0;
+	const bool isCooked = readTextureCookKey(prepared.ddsFileData.data(), prepared.ddsFileData.size(), cookKey);
+	if (isDDSRequested == false && isCooked && FileReadStream(rawPath).isOpened()) {
+		prepared.ddsFileData.clear();
 		return ddsLoadCode_fileDoesntExist;
 	}
 
 	// Parse the file and generate the texture creation strctures.
 	DDSLoader loader;
-	TextureDesc desc;
-	std::vector<TextureData> initalData;
-
-	if (loader.load(ddsDataRaw.data(), ddsDataRaw.size(), desc, initalData) == false) {
+	if (loader.load(prepared.ddsFileData.data(), prepared.ddsFileData.size(), prepared.ddsDesc, prepared.ddsInitalData) ==
+	    false) {
 		return ddsLoadCode_importOrCreationFailed;
 	}
 
-	m_texture = getCore()->getDevice()->requestResource<Texture>();
+	return ddsLoadCode_fine;
+}
 
-	// Create the texture.
-	m_textureMeta = loadAssetTextureMeta2(rawPath);
-	bool const createSucceeded = m_texture->create(desc, &initalData[0], m_textureMeta.assetSamplerDesc);
+AssetTexture2d::DDSLoadCode AssetTexture2d::prepareCookedDDS(const char* const rawPath, PreparedTexture& prepared)
+{
+	// The texture gets cooked on the calling thread. When loading asynchronously the other textures
+	// are decoded and cooked in parallel on the other loading workers.
+	if (cookTextureAsset(rawPath, prepared.textureMeta, prepared.ddsFileData, nullptr) == false) {
+		// Fallback to the source file.
+		return ddsLoadCode_fileDoesntExist;
+	}
 
-	if (createSucceeded == false) {
-		m_texture.Release();
+	DDSLoader loader;
+	const bool loadSucceeded = loader.load(
+	    prepared.ddsFileData.data(), prepared.ddsFileData.size(), prepared.ddsDesc, prepared.ddsInitalData);
+	if (loadSucceeded == false) {
 		return ddsLoadCode_importOrCreationFailed;
 	}
 
@@ -200,34 +227,92 @@ AssetTexture2d::DDSLoadCode AssetTexture2d::loadDDS(const char* const rawPath)
 
 bool AssetTexture2d::loadAssetFromFile(const char* path)
 {
-	m_status = AssetStatus_LoadFailed;
+	prepareLoadAssetFromFile(path);
+	return finalizeLoadAssetFromFile(path);
+}
+
+void AssetTexture2d::prepareLoadAssetFromFile(const char* const path)
+{
+	m_prepared = std::make_unique<PreparedTexture>();
+	PreparedTexture& prepared = *m_prepared;
+
+	prepared.textureMeta = loadAssetTextureMeta2(path);
 
 #if !defined(__EMSCRIPTEN__)
-	DDSLoadCode const ddsLoadStatus = loadDDS(path);
+	// The *.dds files are used as they are, there is nothing to cook.
+	const bool shouldCook =
+	    prepared.textureMeta.compression != textureCompression_none && extractFileExtension(path) != "dds";
+	prepared.ddsLoadCode = shouldCook ? prepareCookedDDS(path, prepared) : prepareDDS(path, prepared);
+
+	// A broken *.dds equivalent should not prevent the source file from being used.
+	if (prepared.ddsLoadCode == ddsLoadCode_importOrCreationFailed && extractFileExtension(path) != "dds") {
+		sgeLogWarn("Failed to load the DDS equivalent to '%s', the source file is used instead!\n", path);
+		prepared.ddsFileData.clear();
+		prepared.ddsInitalData.clear();
+		prepared.ddsLoadCode = ddsLoadCode_fileDoesntExist;
+	}
+
+	if (prepared.ddsLoadCode != ddsLoadCode_fileDoesntExist) {
+		return;
+	}
+#endif
+
+	prepareSourceFile(path, prepared);
+}
+
+void AssetTexture2d::prepareSourceFile(const char* const path, PreparedTexture& prepared)
+{
+	// Now check for the actual asset that is requested.
+	prepared.isSourceFileFound = FileReadStream(path).isOpened();
+	if (prepared.isSourceFileFound) {
+		int components = 0;
+		prepared.pixelsRGBA8 = stbi_load(path, &prepared.width, &prepared.height, &components, 4);
+	}
+}
+
+bool AssetTexture2d::finalizeLoadAssetFromFile(const char* const path)
+{
+	m_status = AssetStatus_LoadFailed;
+
+	if (!m_prepared) {
+		prepareLoadAssetFromFile(path);
+	}
+
+	const std::unique_ptr<PreparedTexture> prepared = std::move(m_prepared);
+	m_textureMeta = prepared->textureMeta;
+
+	if (prepared->ddsLoadCode == ddsLoadCode_fine) {
+		// Create the texture.
+		m_texture = getCore()->getDevice()->requestResource<Texture>();
+		bool const createSucceeded =
+		    m_texture->create(prepared->ddsDesc, &prepared->ddsInitalData[0], m_textureMeta.assetSamplerDesc);
 
-	if (ddsLoadStatus == ddsLoadCode_fine) {
-		return true;
+		if (createSucceeded) {
+			return true;
+		}
+
+		m_texture.Release();
+		if (extractFileExtension(path) == "dds") {
+			sgeLogWarn("Failed to load the DDS texture '%s'!\n", path);
+			return false;
+		}
+
+		// The device might not support the format of the *.dds equivalent, try the source file.
+		sgeLogWarn("Failed to create the DDS equivalent to '%s', the source file is used instead!\n", path);
+		prepareSourceFile(path, *prepared);
 	}
-	else if (ddsLoadStatus == ddsLoadCode_importOrCreationFailed) {
+	else if (prepared->ddsLoadCode == ddsLoadCode_importOrCreationFailed) {
 		sgeLogWarn("Failed to load the DDS equivalent to '%s'!\n", path);
 		return false;
 	}
-#endif
 
-	// Now check for the actual asset that is requested.
-	FileReadStream frs(path);
-	if (!frs.isOpened()) {
+	if (!prepared->isSourceFileFound) {
 		sgeLogError("Unable to find texture2d asset: '%s'!\n", path);
 		return false;
 	}
 
-	int width, height, components;
-	const unsigned char* textureData = stbi_load(path, &width, &height, &components, 4);
-
 	TextureDesc textureDesc;
 
-	m_textureMeta = loadAssetTextureMeta2(path);
-
 	textureDesc.textureType = UniformType::Texture2D;
 	textureDesc.format = TextureFormat::R8G8B8A8_UNORM;
 	textureDesc.usage = TextureUsage::ImmutableResource;
@@ -235,23 +320,18 @@ bool AssetTexture2d::loadAssetFromFile(const char* path)
 	textureDesc.texture2D.numMips = 1;
 	textureDesc.texture2D.numSamples = 1;
 	textureDesc.texture2D.sampleQuality = 0;
-	textureDesc.texture2D.width = width;
-	textureDesc.texture2D.height = height;
+	textureDesc.texture2D.width = prepared->width;
+	textureDesc.texture2D.height = prepared->height;
 	textureDesc.generateMips = m_textureMeta.shouldGenerateMips;
 
 	TextureData textureDataDesc;
-	textureDataDesc.data = textureData;
-	textureDataDesc.rowByteSize = size_t(width) * 4;
+	textureDataDesc.data = prepared->pixelsRGBA8;
+	textureDataDesc.rowByteSize = size_t(prepared->width) * 4;
 
 	m_texture = getCore()->getDevice()->requestResource<Texture>();
 	m_texture->create(textureDesc, &textureDataDesc, m_textureMeta.assetSamplerDesc);
 	m_texture->setDebugName(path);
 
-	if (textureData != nullptr) {
-		stbi_image_free((void*)textureData);
-		textureData = nullptr;
-	}
-
 	if (m_texture.IsResourceValid()) {
 		m_status = AssetStatus_Loaded;
 	}
@@ -260,20 +340,102 @@ bool AssetTexture2d::loadAssetFromFile(const char* path)
 }
 
 bool AssetTexture2d::saveTextureSettingsToInfoFile() const
+{
+	return saveAssetTextureMeta(getPath(), m_textureMeta);
+}
+
+bool saveAssetTextureMeta(const std::string& baseAssetPath, const AssetTextureMeta& meta)
 {
 	// [TEXTURE_ASSET_INFO]
-	const std::string infoPath = getPath() + ".info";
+	const std::string infoPath = baseAssetPath + ".info";
 
 	JsonValueBuffer jvb;
 	auto jRoot = jvb(JID_MAP);
 	jRoot->setMember("version", jvb(1));
-	jRoot->setMember("sampler", samplerDesc_toJson(m_textureMeta.assetSamplerDesc, jvb));
-	jRoot->setMember("isSemiTransparent", jvb(m_textureMeta.isSemiTransparent));
-	jRoot->setMember("shouldGenerateMips", jvb(m_textureMeta.shouldGenerateMips));
+	jRoot->setMember("sampler", samplerDesc_toJson(meta.assetSamplerDesc, jvb));
+	jRoot->setMember("isSemiTransparent", jvb(meta.isSemiTransparent));
+	jRoot->setMember("shouldGenerateMips", jvb(meta.shouldGenerateMips));
+	jRoot->setMember("compression", jvb(textureCompression_toString(meta.compression)));
 
 	JsonWriter jsonWriter;
 	bool success = jsonWriter.WriteInFile(infoPath.c_str(), jRoot, true);
 	return success;
 }
 
+bool cookTextureAsset(
+    const char* const assetPath,
+    const AssetTextureMeta& meta,
+    std::vector<char>& outDDSFileData,
+    ThreadPool* const threadPool)
+{
+	outDDSFileData.clear();
+	const std::string ddsPath = std::string(assetPath) + ".dds";
+
+	TextureCookSettings cookSettings;
+	cookSettings.compression = meta.compression;
+	cookSettings.generateMips = meta.shouldGenerateMips;
+
+	// Without the source file (for example if only the cooked files are shipped) the cooked file is used as it is.
+	std::vector<char> sourceFileData;
+	if (FileReadStream::readFile(assetPath, sourceFileData) == false) {
+		return FileReadStream::readFile(ddsPath.c_str(), outDDSFileData);
+	}
+
+	const uint32 cookKey = computeTextureCookKey(sourceFileData.data(), sourceFileData.size(), cookSettings);
+
+	// The *.dds files that weren't made by the cooker are never overwritten.
+	if (FileReadStream::readFile(ddsPath.c_str(), outDDSFileData)) {
+		uint32 existingCookKey = 0;
+		if (readTextureCookKey(outDDSFileData.data(), outDDSFileData.size(), existingCookKey) == false ||
+		    existingCookKey == cookKey) {
+			return true;
+		}
+	}
+
+	int width = 0;
+	int height = 0;
+	int components = 0;
+	unsigned char* const pixelsRGBA8 = stbi_load_from_memory(
+	    (const stbi_uc*)sourceFileData.data(), int(sourceFileData.size()), &width, &height, &components, 4);
+	if (pixelsRGBA8 == nullptr) {
+		outDDSFileData.clear();
+		return false;
+	}
+
+	const bool cookSucceeded =
+	    cookTexture(outDDSFileData, pixelsRGBA8, width, height, cookSettings, cookKey, threadPool);
+	stbi_image_free(pixelsRGBA8);
+
+	if (cookSucceeded == false) {
+		return false;
+	}
+
+	// The file is written under a temporary name and then renamed, so a partially written file
+	// (for example if the process gets terminated) never ends up being loaded as the cooked texture.
+	const std::string ddsTempPath = ddsPath + ".tmp";
+	bool isSaved = false;
+	{
+		FileWriteStream fws;
+		isSaved = fws.open(ddsTempPath.c_str()) &&
+		          fws.write(outDDSFileData.data(), outDDSFileData.size()) == outDDSFileData.size();
+	}
+
+	std::error_code fileError;
+	if (isSaved) {
+		std::filesystem::rename(ddsTempPath, ddsPath, fileError);
+		isSaved = !fileError;
+	}
+
+	if (isSaved == false) {
+		// The cooked texture is still usable, it is going to be cooked again on the next load.
+		std::filesystem::remove(ddsTempPath, fileError);
+		sgeLogWarn("Failed to save the cooked texture '%s'!\n", ddsPath.c_str());
+	}
+	else {
+		sgeLogInfo("Cooked texture '%s' as %s.\n", assetPath, textureCompression_toString(meta.compression));
+	}
+
+	return true;
+}
+
 } // namespace sge
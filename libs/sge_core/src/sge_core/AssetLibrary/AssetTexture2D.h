@@ -1,8 +1,10 @@
 #pragma once
 
 #include "IAsset.h"
+#include "sge_core/dds/TextureCooker.h"
 #include "sge_renderer/renderer/renderer.h"
 #include <memory>
+#include <vector>
 
 namespace sge {
 
@@ -20,8 +22,29 @@ struct AssetTextureMeta {
 
 	/// True if mip maps need to be generated when the texture gets loaded.
 	bool shouldGenerateMips = true;
+
+	/// The block compression of the cooked *.dds equivalent of the texture.
+	/// If not none the texture gets cooked when loaded and the cooked file is used until the source file
+	/// or the settings change.
+	TextureCompression compression = textureCompression_none;
 };
 
+/// Loads the settings from the *.info file of the texture. If there is no such file the defaults are returned.
+SGE_CORE_API AssetTextureMeta loadAssetTextureMeta2(const std::string& baseAssetPath);
+
+/// Saves the settings to the *.info file of the texture.
+SGE_CORE_API bool saveAssetTextureMeta(const std::string& baseAssetPath, const AssetTextureMeta& meta);
+
+/// Cooks the block compressed *.dds equivalent of the texture if it is missing or out of date and returns
+/// the contents of the *.dds file. The *.dds files that weren't made by the cooker are used as they are.
+/// @param [in] threadPool (optional) the texture is compressed on the workers of the pool.
+/// Returns false if there is no *.dds equivalent and the texture couldn't be cooked.
+SGE_CORE_API bool cookTextureAsset(
+    const char* const assetPath,
+    const AssetTextureMeta& meta,
+    std::vector<char>& outDDSFileData,
+    ThreadPool* const threadPool);
+
 struct SGE_CORE_API AssetIface_Texture2D : public IAssetInterface {
 	AssetIface_Texture2D() = default;
 	virtual ~AssetIface_Texture2D() = default;
@@ -49,6 +72,14 @@ struct SGE_CORE_API AssetTexture2d : public Asset, public AssetIface_Texture2D {
 	/// Loads the specified asset form the specified path.
 	bool loadAssetFromFile(const char* const path) override;
 
+	/// Reads and decodes the texture file (and its *.dds equivalent if any).
+	/// If the texture should be compressed the *.dds equivalent is cooked if it is missing or out of date,
+	/// otherwise a cooked *.dds equivalent is ignored in favour of the source file.
+	void prepareLoadAssetFromFile(const char* const path) override;
+
+	/// Creates the texture from the data decoded by @prepareLoadAssetFromFile.
+	bool finalizeLoadAssetFromFile(const char* const path) override;
+
 	bool saveTextureSettingsToInfoFile() const;
 
   private:
@@ -58,11 +89,38 @@ struct SGE_CORE_API AssetTexture2d : public Asset, public AssetIface_Texture2D {
 		ddsLoadCode_importOrCreationFailed,
 	};
 
-	DDSLoadCode loadDDS(const char* const rawPath);
+	/// The decoded texture file, produced by @prepareLoadAssetFromFile and consumed by @finalizeLoadAssetFromFile.
+	struct PreparedTexture {
+		~PreparedTexture();
+
+		AssetTextureMeta textureMeta;
+
+		DDSLoadCode ddsLoadCode = ddsLoadCode_fileDoesntExist;
+		std::vector<char> ddsFileData; ///< The texture data of the *.dds files points here.
+		TextureDesc ddsDesc;
+		std::vector<TextureData> ddsInitalData;
+
+		bool isSourceFileFound = false;
+		int width = 0;
+		int height = 0;
+		unsigned char* pixelsRGBA8 = nullptr; ///< Allocated by stb_image.
+	};
+
+	DDSLoadCode prepareDDS(const char* const rawPath, PreparedTexture& prepared);
+
+	/// Loads the cooked *.dds equivalent of the texture, cooks it again if the source file or the settings
+	/// have changed. The *.dds files that weren't made by the cooker are used as they are.
+	DDSLoadCode prepareCookedDDS(const char* const rawPath, PreparedTexture& prepared);
+
+	/// Decodes the source file of the texture, used when there is no usable *.dds equivalent.
+	void prepareSourceFile(const char* const path, PreparedTexture& prepared);
 
   public:
 	GpuHandle<Texture> m_texture;
 	AssetTextureMeta m_textureMeta;
+
+  private:
+	std::unique_ptr<PreparedTexture> m_prepared;
 };
 
 } // namespace sge
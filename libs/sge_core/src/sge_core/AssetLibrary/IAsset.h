@@ -4,6 +4,7 @@
 #include "sge_utils/sge_utils.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace sge {
 
@@ -14,6 +15,14 @@ enum AssetStatus : int {
 	AssetStatus_NotLoaded,  ///< The assets seems to exist but it is not loaded.
 	AssetStatus_Loaded,     ///< The asset is loaded.
 	AssetStatus_LoadFailed, ///< Loading the asset failed. Maybe the files is broken or it does not exist.
+	AssetStatus_Loading,    ///< The asset is being loaded asynchronously, see AssetLibrary::getAssetFromFileAsync.
+};
+
+/// @brief Describes an asset that needs to be loaded by another asset, for example a texture used by a material.
+/// The arguments are the same as AssetLibrary::getAssetFromFile.
+struct AssetDependency {
+	std::string path;
+	std::string localDirectory;
 };
 
 struct SGE_CORE_API Asset {
@@ -32,6 +41,18 @@ struct SGE_CORE_API Asset {
 
 	virtual bool loadAssetFromFile(const char* filePath) = 0;
 
+	/// Asynchronous loading (see AssetLibrary::getAssetFromFileAsync) is split in two steps.
+	/// @prepareLoadAssetFromFile is called on a loading worker thread. It should read the files and do the CPU heavy
+	/// work (decoding, parsing), it must not access the rendering device or the AssetLibrary.
+	/// @finalizeLoadAssetFromFile is called on the main thread afterwards, it creates the GPU resources and finishes
+	/// the loading. Assets that do not support asynchronous loading do everything in @finalizeLoadAssetFromFile.
+	virtual void prepareLoadAssetFromFile(const char* const UNUSED(filePath)) {}
+	virtual bool finalizeLoadAssetFromFile(const char* const filePath) { return loadAssetFromFile(filePath); }
+
+	/// Called on the main thread after @prepareLoadAssetFromFile. Lists the assets that are going to be needed by
+	/// @finalizeLoadAssetFromFile, so they could be loaded in parallel.
+	virtual void getPreparedDependencies(std::vector<AssetDependency>& UNUSED(outDependencies)) const {}
+
   public:
 	struct LoadAssetFromFileData {
 		/// The the modification time of file when we last tried to loaded it (no matter if we succeeded or not).
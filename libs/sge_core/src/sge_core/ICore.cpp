@@ -13,6 +13,7 @@
 #include "sge_renderer/renderer/renderer.h"
 #include "sge_utils/io/FileStream.h"
 #include "sge_utils/sge_utils.h"
+#include "sge_utils/threading/ThreadPool.h"
 
 namespace sge {
 
@@ -45,6 +46,8 @@ struct Core : public ICore {
 
 	void setLastFrameStatistics(const FrameStatistics& stats) final { lastFrameStatistics = stats; }
 
+	ThreadPool* getWorkerThreadPool() final { return &m_workerThreadPool; }
+
   public:
 	SGEDevice* m_sgedev = nullptr; // The sge device attached to the main window.
 
@@ -61,6 +64,8 @@ struct Core : public ICore {
 	std::map<std::string, std::map<std::string, CallBack>> m_menuItems;
 
 	AudioDevice* m_audioDevice = nullptr;
+
+	ThreadPool m_workerThreadPool;
 };
 
 void Core::setup(SGEDevice* const sgedev, AudioDevice* const sgeAudioDevice)
@@ -71,6 +76,10 @@ void Core::setup(SGEDevice* const sgedev, AudioDevice* const sgeAudioDevice)
 
 	m_audioDevice = sgeAudioDevice;
 
+	if (m_workerThreadPool.isCreated() == false) {
+		m_workerThreadPool.create(ThreadPool::getHardwareConcurrency());
+	}
+
 	m_assetLibrary = std::make_unique<AssetLibrary>();
 	m_materialFamilyLib = std::make_unique<MaterialFamilyLibrary>();
 
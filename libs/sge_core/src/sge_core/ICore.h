@@ -16,6 +16,7 @@ struct DebugDraw;
 struct BasicModelDraw;
 struct SolidWireframeModelDraw;
 struct InputState;
+struct ThreadPool;
 
 struct SGE_CORE_API ICore {
 	// A group of commonly used by the editor graphics resources and render states.
@@ -71,6 +72,11 @@ struct SGE_CORE_API ICore {
 	virtual void setLastFrameStatistics(const FrameStatistics& stats) = 0;
 
 	virtual AudioDevice* getAudioDevice() = 0;
+
+	/// @brief Returns the worker threads shared by the tasks that want to finish a lot of work as fast as possible,
+	/// like translating shader permutations or cooking textures. The pool is created with the core, the thread
+	/// waiting for the jobs executes them as well.
+	virtual ThreadPool* getWorkerThreadPool() = 0;
 };
 
 
@@ -41,14 +41,15 @@ struct MultiObjectArena {
 
 	Handle newElement(TypeId typeId, void** ppNewElement)
 	{
-		Handle outHandle;
 		ObjectArenaUntyped* arena = nullptr;
+		int localTypeIndex = -1;
 
 		// Check if we've already create an arena for that specific type.
 		auto itrTypeIndex = typeIdToLocalTypeIndex.find(typeId);
 		if (itrTypeIndex != typeIdToLocalTypeIndex.end()) {
 			// Are for that type already exists. Just use it.
-			arena = perTypeArena[itrTypeIndex->second].get();
+			localTypeIndex = itrTypeIndex->second;
+			arena = perTypeArena[localTypeIndex].get();
 		}
 		else {
 			const TypeDesc* typeDesc = typeLib().find(typeId);
@@ -71,13 +72,13 @@ struct MultiObjectArena {
 			}
 
 			// Create a new arena for that type.
-			typeIdToLocalTypeIndex[typeId] = int(perTypeArena.size());
+			localTypeIndex = int(perTypeArena.size());
+			typeIdToLocalTypeIndex[typeId] = localTypeIndex;
 			perTypeArena.push_back(std::make_unique<ObjectArenaUntyped>());
 			std::unique_ptr<ObjectArenaUntyped>& newArena = perTypeArena.back();
 			newArena->initialize(typeInfo);
 
 			arena = newArena.get();
-			;
 		}
 
 		if (arena) {
@@ -87,7 +88,7 @@ struct MultiObjectArena {
 				*ppNewElement = arena->get(handleInTypeArena);
 			}
 
-			return Handle(handleInTypeArena, itrTypeIndex->second);
+			return Handle(handleInTypeArena, localTypeIndex);
 		}
 
 		sgeAssert(false && "Should never happen");
@@ -0,0 +1,307 @@
+#include "TextureCooker.h"
+#include "dds.h"
+#include "sge_utils/hash/hash_combine.h"
+#include "sge_utils/math/common.h"
+#include "sge_utils/threading/ThreadPool.h"
+
+#include "stb_dxt.h"
+#include <cstring>
+#include <mutex>
+
+namespace sge {
+
+/// Changing the output of the cooker should change the version, so the already cooked textures get cooked again.
+static constexpr uint32 kTextureCookerVersion = 1;
+
+/// Stored in DDS_HEADER::dwReserved1[0] of the cooked textures, followed by the cook key in dwReserved1[1].
+static constexpr uint32 kCookedTextureMarker =
+    uint32('S') | (uint32('G') << 8) | (uint32('E') << 16) | (uint32('C') << 24);
+
+/// The number of block rows compressed by a single job.
+static constexpr int kCookBlockRowsPerJob = 4;
+
+namespace {
+	constexpr uint32 makeFourCC(char c0, char c1, char c2, char c3)
+	{
+		return uint32(c0) | (uint32(c1) << 8) | (uint32(c2) << 16) | (uint32(c3) << 24);
+	}
+
+	/// A single mip level of the cooked texture.
+	struct CookMipImage {
+		int width = 0;
+		int height = 0;
+		const unsigned char* pixelsRGBA8 = nullptr;
+		/// The pixels of the generated mip levels, the top level points to the source image.
+		std::vector<unsigned char> ownPixels;
+	};
+
+	/// Halves the image by averaging each 2x2 pixels. For odd sizes the last row/column is dropped,
+	/// the same way the sizes of the mip levels get rounded down.
+	void downsampleMip(CookMipImage& dest, const CookMipImage& src)
+	{
+		dest.width = maxOf(src.width / 2, 1);
+		dest.height = maxOf(src.height / 2, 1);
+		dest.ownPixels.resize(size_t(dest.width) * size_t(dest.height) * 4);
+		dest.pixelsRGBA8 = dest.ownPixels.data();
+
+		for (int y = 0; y < dest.height; ++y) {
+			const int y0 = minOf(y * 2, src.height - 1);
+			const int y1 = minOf(y * 2 + 1, src.height - 1);
+			for (int x = 0; x < dest.width; ++x) {
+				const int x0 = minOf(x * 2, src.width - 1);
+				const int x1 = minOf(x * 2 + 1, src.width - 1);
+
+				const unsigned char* const p00 = src.pixelsRGBA8 + (size_t(y0) * src.width + x0) * 4;
+				const unsigned char* const p01 = src.pixelsRGBA8 + (size_t(y0) * src.width + x1) * 4;
+				const unsigned char* const p10 = src.pixelsRGBA8 + (size_t(y1) * src.width + x0) * 4;
+				const unsigned char* const p11 = src.pixelsRGBA8 + (size_t(y1) * src.width + x1) * 4;
+				unsigned char* const destPixel = dest.ownPixels.data() + (size_t(y) * dest.width + x) * 4;
+				for (int iChannel = 0; iChannel < 4; ++iChannel) {
+					destPixel[iChannel] =
+					    (unsigned char)((p00[iChannel] + p01[iChannel] + p10[iChannel] + p11[iChannel] + 2) / 4);
+				}
+			}
+		}
+	}
+
+	/// Copies the 4x4 block of pixels starting at (x, y). The pixels outside of the image are clamped to the edges.
+	void gatherBlock(unsigned char block[64], const CookMipImage& image, int x, int y)
+	{
+		for (int iRow = 0; iRow < 4; ++iRow) {
+			const int pixelY = minOf(y + iRow, image.height - 1);
+			for (int iColumn = 0; iColumn < 4; ++iColumn) {
+				const int pixelX = minOf(x + iColumn, image.width - 1);
+				const unsigned char* const pixel = image.pixelsRGBA8 + (size_t(pixelY) * image.width + pixelX) * 4;
+				memcpy(block + (iRow * 4 + iColumn) * 4, pixel, 4);
+			}
+		}
+	}
+
+	/// Compresses a single channel of the 4x4 RGBA8 block as a BC4 block (the same layout as the alpha of BC3).
+	/// The first endpoint is the max value, so the palette has 6 interpolated values between the endpoints.
+	void compressBC4Block(unsigned char dest[8], const unsigned char block[64], int iChannel)
+	{
+		int minValue = block[iChannel];
+		int maxValue = block[iChannel];
+		for (int iPixel = 1; iPixel < 16; ++iPixel) {
+			minValue = minOf(minValue, int(block[iPixel * 4 + iChannel]));
+			maxValue = maxOf(maxValue, int(block[iPixel * 4 + iChannel]));
+		}
+
+		dest[0] = (unsigned char)maxValue;
+		dest[1] = (unsigned char)minValue;
+
+		uint64 indices = 0;
+		const int range = maxValue - minValue;
+		if (range > 0) {
+			for (int iPixel = 0; iPixel < 16; ++iPixel) {
+				// The nearest of the 8 values between min (0) and max (7).
+				const int step = ((block[iPixel * 4 + iChannel] - minValue) * 14 + range) / (range * 2);
+				// Index 0 is the max, index 1 is the min and 2 to 7 go from the max towards the min.
+				const int index = (step == 7) ? 0 : ((step == 0) ? 1 : 8 - step);
+				indices |= uint64(index) << (iPixel * 3);
+			}
+		}
+
+		for (int iByte = 0; iByte < 6; ++iByte) {
+			dest[2 + iByte] = (unsigned char)(indices >> (iByte * 8));
+		}
+	}
+
+	/// Returns the size in bytes of the specified mip level compressed with the specified compression.
+	size_t getCompressedMipSize(int width, int height, TextureCompression compression)
+	{
+		const size_t numBlocks = size_t(maxOf((width + 3) / 4, 1)) * size_t(maxOf((height + 3) / 4, 1));
+		return numBlocks * ((compression == textureCompression_bc1) ? 8 : 16);
+	}
+
+	/// Compresses the mip level into @dest, the blocks are stored row by row.
+	void compressMip(
+	    unsigned char* dest, const CookMipImage& image, TextureCompression compression, ThreadPool* threadPool)
+	{
+		const int numBlocksX = maxOf((image.width + 3) / 4, 1);
+		const int numBlocksY = maxOf((image.height + 3) / 4, 1);
+		const size_t blockSize = (compression == textureCompression_bc1) ? 8 : 16;
+
+		const auto compressBlockRows = [&](int beginRow, int endRow) -> void {
+			unsigned char block[64];
+			for (int iBlockY = beginRow; iBlockY < endRow; ++iBlockY) {
+				for (int iBlockX = 0; iBlockX < numBlocksX; ++iBlockX) {
+					gatherBlock(block, image, iBlockX * 4, iBlockY * 4);
+
+					unsigned char* const destBlock = dest + (size_t(iBlockY) * numBlocksX + iBlockX) * blockSize;
+					if (compression == textureCompression_bc5) {
+						compressBC4Block(destBlock, block, 0);
+						compressBC4Block(destBlock + 8, block, 1);
+					}
+					else {
+						const int hasAlpha = (compression == textureCompression_bc3) ? 1 : 0;
+						stb_compress_dxt_block(destBlock, block, hasAlpha, STB_DXT_HIGHQUAL);
+					}
+				}
+			}
+		};
+
+		if (threadPool && numBlocksY > kCookBlockRowsPerJob) {
+			threadPool->parallelFor(numBlocksY, kCookBlockRowsPerJob, compressBlockRows);
+		}
+		else {
+			compressBlockRows(0, numBlocksY);
+		}
+	}
+} // namespace
+
+const char* textureCompression_toString(TextureCompression compression)
+{
+	switch (compression) {
+		case textureCompression_none:
+			return "none";
+		case textureCompression_auto:
+			return "auto";
+		case textureCompression_bc1:
+			return "bc1";
+		case textureCompression_bc3:
+			return "bc3";
+		case textureCompression_bc5:
+			return "bc5";
+	}
+
+	sgeAssert(false);
+	return "none";
+}
+
+TextureCompression textureCompression_fromString(const char* str)
+{
+	for (TextureCompression compression :
+	     {textureCompression_auto, textureCompression_bc1, textureCompression_bc3, textureCompression_bc5}) {
+		if (str != nullptr && strcmp(str, textureCompression_toString(compression)) == 0) {
+			return compression;
+		}
+	}
+
+	return textureCompression_none;
+}
+
+uint32 computeTextureCookKey(const char* sourceFileData, size_t sourceFileSize, const TextureCookSettings& settings)
+{
+	uint32 key = hash_djb2(sourceFileData, sourceFileSize);
+	key = hash_combine<uint32>(key, uint32(sourceFileSize));
+	key = hash_combine<uint32>(key, uint32(settings.compression));
+	key = hash_combine<uint32>(key, settings.generateMips ? 1 : 0);
+	key = hash_combine<uint32>(key, kTextureCookerVersion);
+	return key;
+}
+
+bool cookTexture(
+    std::vector<char>& outDDSFileData,
+    const unsigned char* pixelsRGBA8,
+    int width,
+    int height,
+    const TextureCookSettings& settings,
+    uint32 cookKey,
+    ThreadPool* threadPool)
+{
+	outDDSFileData.clear();
+
+	if (settings.compression == textureCompression_none || pixelsRGBA8 == nullptr || width <= 0 || height <= 0) {
+		return false;
+	}
+
+	// stb_dxt initializes its lookup tables on the first call, which isn't thread-safe.
+	static std::once_flag stbDxtInitFlag;
+	std::call_once(stbDxtInitFlag, []() -> void {
+		unsigned char block[64] = {0};
+		unsigned char compressed[16];
+		stb_compress_dxt_block(compressed, block, 1, STB_DXT_NORMAL);
+	});
+
+	TextureCompression compression = settings.compression;
+	if (compression == textureCompression_auto) {
+		compression = textureCompression_bc1;
+		const size_t numPixels = size_t(width) * size_t(height);
+		for (size_t iPixel = 0; iPixel < numPixels; ++iPixel) {
+			if (pixelsRGBA8[iPixel * 4 + 3] != 255) {
+				compression = textureCompression_bc3;
+				break;
+			}
+		}
+	}
+
+	// The full mip chain down to 1x1, each level is generated from the previous one.
+	std::vector<CookMipImage> mips(1);
+	mips[0].width = width;
+	mips[0].height = height;
+	mips[0].pixelsRGBA8 = pixelsRGBA8;
+	while (settings.generateMips && (mips.back().width > 1 || mips.back().height > 1)) {
+		CookMipImage nextMip;
+		downsampleMip(nextMip, mips.back());
+		mips.emplace_back(std::move(nextMip));
+	}
+
+	size_t dataSize = 0;
+	for (const CookMipImage& mip : mips) {
+		dataSize += getCompressedMipSize(mip.width, mip.height, compression);
+	}
+
+	DDS_HEADER header;
+	memset(&header, 0, sizeof(header));
+	header.dwSize = sizeof(DDS_HEADER);
+	header.dwFlags = DDSD_HELPER_TEXTURE | DDSD_LINEARSIZE | ((mips.size() > 1) ? DDSD_MIPMAPCOUNT : 0);
+	header.dwHeight = uint32(height);
+	header.dwWidth = uint32(width);
+	header.dwPitchOrLinearSize = uint32(getCompressedMipSize(width, height, compression));
+	header.dwMipMapCount = uint32(mips.size());
+	header.dwReserved1[0] = kCookedTextureMarker;
+	header.dwReserved1[1] = cookKey;
+	header.ddspf.dwSize = sizeof(DDS_PIXELFORMAT);
+	header.ddspf.dwFlags = DDPF_FOURCC;
+	header.dwCaps = DDSCAPS_TEXTURE | ((mips.size() > 1) ? (DDSCAPS_COMPLEX | DDSCAPS_MIPMAP) : 0);
+
+	switch (compression) {
+		case textureCompression_bc1:
+			header.ddspf.dwFourCC = makeFourCC('D', 'X', 'T', '1');
+			break;
+		case textureCompression_bc3:
+			header.ddspf.dwFourCC = makeFourCC('D', 'X', 'T', '5');
+			break;
+		case textureCompression_bc5:
+			header.ddspf.dwFourCC = makeFourCC('A', 'T', 'I', '2');
+			break;
+		default:
+			sgeAssert(false);
+			return false;
+	}
+
+	const uint32 magic = DDS_MAGIC_NUMBER;
+	outDDSFileData.resize(sizeof(magic) + sizeof(header) + dataSize);
+	memcpy(outDDSFileData.data(), &magic, sizeof(magic));
+	memcpy(outDDSFileData.data() + sizeof(magic), &header, sizeof(header));
+
+	unsigned char* mipData = (unsigned char*)outDDSFileData.data() + sizeof(magic) + sizeof(header);
+	for (const CookMipImage& mip : mips) {
+		compressMip(mipData, mip, compression, threadPool);
+		mipData += getCompressedMipSize(mip.width, mip.height, compression);
+	}
+
+	return true;
+}
+
+bool readTextureCookKey(const char* ddsFileData, size_t ddsFileSize, uint32& outCookKey)
+{
+	uint32 magic = 0;
+	DDS_HEADER header;
+	if (ddsFileData == nullptr || ddsFileSize < sizeof(magic) + sizeof(header)) {
+		return false;
+	}
+
+	memcpy(&magic, ddsFileData, sizeof(magic));
+	memcpy(&header, ddsFileData + sizeof(magic), sizeof(header));
+	if (magic != DDS_MAGIC_NUMBER || header.dwReserved1[0] != kCookedTextureMarker) {
+		return false;
+	}
+
+	outCookKey = header.dwReserved1[1];
+	return true;
+}
+
+} // namespace sge
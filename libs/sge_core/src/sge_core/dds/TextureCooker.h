@@ -0,0 +1,58 @@
+#pragma once
+
+#include "sge_core/sgecore_api.h"
+#include "sge_utils/sge_utils.h"
+#include <vector>
+
+namespace sge {
+
+struct ThreadPool;
+
+/// The block compression used when cooking a texture, see @cookTexture.
+enum TextureCompression : int {
+	/// The texture isn't cooked, the source file gets decoded on every load.
+	textureCompression_none,
+	/// BC3 if the texture has alpha values other than 255, BC1 otherwise.
+	textureCompression_auto,
+	/// 4 bits per pixel, RGB with no alpha.
+	textureCompression_bc1,
+	/// 8 bits per pixel, RGB with a separately compressed alpha.
+	textureCompression_bc3,
+	/// 8 bits per pixel, only the red and green channels are kept. Meant for two channel normal maps.
+	textureCompression_bc5,
+};
+
+SGE_CORE_API const char* textureCompression_toString(TextureCompression compression);
+
+/// Returns textureCompression_none if the string isn't recognized.
+SGE_CORE_API TextureCompression textureCompression_fromString(const char* str);
+
+/// The settings (from the *.info file of the texture) that affect the cooked texture.
+struct TextureCookSettings {
+	TextureCompression compression = textureCompression_auto;
+	bool generateMips = true;
+};
+
+/// Computes the key of a cooked texture. The cooked file is out of date if the source file or the settings
+/// have been changed since it was cooked.
+SGE_CORE_API uint32
+    computeTextureCookKey(const char* sourceFileData, size_t sourceFileSize, const TextureCookSettings& settings);
+
+/// Block-compresses the RGBA8 image and writes it as a *.dds file with a box filtered mip chain
+/// (if @settings.generateMips is true) in @outDDSFileData. The @cookKey is stored in the file header.
+/// @param [in] threadPool (optional) the blocks are compressed on the workers of the pool.
+/// Returns false if the compression isn't specified or the image is empty.
+SGE_CORE_API bool cookTexture(
+    std::vector<char>& outDDSFileData,
+    const unsigned char* pixelsRGBA8,
+    int width,
+    int height,
+    const TextureCookSettings& settings,
+    uint32 cookKey,
+    ThreadPool* threadPool);
+
+/// Returns true and the key of the cooked texture if the *.dds file was produced by @cookTexture.
+/// The *.dds files made by other tools have no key.
+SGE_CORE_API bool readTextureCookKey(const char* ddsFileData, size_t ddsFileSize, uint32& outCookKey);
+
+} // namespace sge
@@ -716,7 +716,7 @@ DDSLoader::SurfaceInfo
 
 		SurfaceInfo retval;
 
-		// TODO: so bpp is BITS per pixel and we magically end up with bytes?
+		// For the block compressed formats GetSizeBits returns the size of a block in bytes.
 		retval.rowSizeBytes = numBlocksWide * bpp;
 		retval.sliceSizeBytes = retval.rowSizeBytes * numBlocksHigh;
 
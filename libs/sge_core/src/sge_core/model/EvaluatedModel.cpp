@@ -199,6 +199,7 @@ bool EvaluatedModel::evaluate_getAllGeometries()
 			    evalMesh.geometry.hasVertexSkinning() ? mat4f::getIdentity() : evalNode.evalGlobalTransform;
 
 			geomInst.geometry = evalMesh.geometry;
+			geomInst.iMesh = meshAttachment.attachedMeshIndex;
 			geomInst.iMaterial = meshAttachment.attachedMaterialIndex;
 			geomInst.modelSpaceBBox = mesh->aabox.getTransformed(geomInst.modelSpaceTransform);
 
@@ -211,4 +212,85 @@ bool EvaluatedModel::evaluate_getAllGeometries()
 }
 
 
+float EvaluatedModel::intersectRay(const Ray& rayMs) const
+{
+	float closestT = FLT_MAX;
+
+	for (const EvaluatedMeshInstance& meshInst : m_evalAllMeshInstances) {
+		// Check the bounding box first, most of the meshes are going to be rejected here.
+		float tBoxEnter = 0.f;
+		float tBoxExit = 0.f;
+		if (!meshInst.modelSpaceBBox.intersect(rayMs.pos, rayMs.dir, tBoxEnter, tBoxExit) || tBoxExit < 0.f ||
+		    tBoxEnter >= closestT) {
+			continue;
+		}
+
+		const ModelMesh* const mesh = m_model->meshAt(meshInst.iMesh);
+		const bool canTestTriangles = mesh != nullptr && !meshInst.geometry.hasVertexSkinning() &&
+		                              mesh->primitiveTopology == PrimitiveTopology::TriangleList &&
+		                              mesh->vbPositionOffsetBytes >= 0;
+
+		if (!canTestTriangles) {
+			closestT = std::min(closestT, std::max(tBoxEnter, 0.f));
+			continue;
+		}
+
+		// Test the triangles in the space of the mesh.
+		const mat4f modelToMesh = inverse(meshInst.modelSpaceTransform);
+		const Ray rayMeshSpace(mat_mul_pos(modelToMesh, rayMs.pos), mat_mul_dir(modelToMesh, rayMs.dir));
+
+		const span<const char> vertexData = mesh->getVertexBufferData();
+		const span<const char> indexData = mesh->getIndexBufferData();
+
+		const auto getVertexPosition = [&](const uint32 iVertex, vec3f& outPosition) -> bool {
+			const size_t byteOffset = size_t(mesh->vbByteOffset) + size_t(iVertex) * size_t(mesh->stride) +
+			                          size_t(mesh->vbPositionOffsetBytes);
+			if (byteOffset + sizeof(vec3f) > vertexData.size()) {
+				return false;
+			}
+
+			memcpy(&outPosition, vertexData.data() + byteOffset, sizeof(vec3f));
+			return true;
+		};
+
+		const auto getIndex = [&](const int iElement) -> uint32 {
+			if (mesh->ibFmt == UniformType::Uint16) {
+				uint16 index = 0;
+				memcpy(&index, indexData.data() + mesh->ibByteOffset + iElement * sizeof(uint16), sizeof(uint16));
+				return index;
+			}
+
+			uint32 index = 0;
+			memcpy(&index, indexData.data() + mesh->ibByteOffset + iElement * sizeof(uint32), sizeof(uint32));
+			return index;
+		};
+
+		const bool hasIndexBuffer = mesh->ibFmt != UniformType::Unknown;
+		if (hasIndexBuffer) {
+			const size_t indexSize = mesh->ibFmt == UniformType::Uint16 ? sizeof(uint16) : sizeof(uint32);
+			if (size_t(mesh->ibByteOffset) + size_t(mesh->numElements) * indexSize > indexData.size()) {
+				continue;
+			}
+		}
+
+		for (int iElement = 0; iElement + 2 < mesh->numElements; iElement += 3) {
+			vec3f triangle[3];
+			bool isTriangleValid = true;
+			for (int iCorner = 0; iCorner < 3; ++iCorner) {
+				const uint32 iVertex = hasIndexBuffer ? getIndex(iElement + iCorner) : uint32(iElement + iCorner);
+				isTriangleValid &= getVertexPosition(iVertex, triangle[iCorner]);
+			}
+
+			if (isTriangleValid) {
+				const float t = IntersectRayTriangle(rayMeshSpace, triangle);
+				if (t >= 0.f && t < closestT) {
+					closestT = t;
+				}
+			}
+		}
+	}
+
+	return closestT;
+}
+
 } // namespace sge
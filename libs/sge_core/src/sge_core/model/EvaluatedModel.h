@@ -36,6 +36,9 @@ struct EvaluatedMeshInstance {
 	/// An assembled set of geometry ready for rendering.
 	Geometry geometry;
 
+	/// The index of the mesh in the owning Model.
+	int iMesh = -1;
+
 	/// The index of the material in the owning Model.
 	int iMaterial = -1;
 
@@ -86,6 +89,12 @@ struct SGE_CORE_API EvaluatedModel {
 
 	const std::vector<EvaluatedMeshInstance>& getEvalMeshInstances() const { return m_evalAllMeshInstances; }
 
+	/// Intersects a ray (in model space) with the triangles of all mesh instances.
+	/// Skinned meshes and meshes that aren't triangle lists are tested against their bounding box only,
+	/// as their triangles on the CPU do not match what is being rendered.
+	/// @return the ray parameter of the closest intersection or FLT_MAX if there is none.
+	float intersectRay(const Ray& rayMs) const;
+
   private:
 	bool evaluate_ApplyNodeGlobalTransforms(const ArrayView<const mat4f>& boneGlobalTrasnformOverrides);
 	bool evaluate_Skinning();
@@ -14,10 +14,11 @@ void Model::prepareForRendering(SGEDevice& sgedev, AssetLibrary& assetLib)
 	for (ModelMesh* const mesh : m_meshes) {
 		const ResourceUsage::Enum usage = ResourceUsage::Immutable;
 
-		if (mesh->vertexBufferRaw.size() != 0) {
+		const span<const char> vertexBufferData = mesh->getVertexBufferData();
+		if (vertexBufferData.size() != 0) {
 			mesh->vertexBuffer = sgedev.requestResource<Buffer>();
-			const BufferDesc vbd = BufferDesc::GetDefaultVertexBuffer((uint32)mesh->vertexBufferRaw.size(), usage);
-			mesh->vertexBuffer->create(vbd, mesh->vertexBufferRaw.data());
+			const BufferDesc vbd = BufferDesc::GetDefaultVertexBuffer((uint32)vertexBufferData.size(), usage);
+			mesh->vertexBuffer->create(vbd, vertexBufferData.data());
 
 			if (getModelLoadSetting().assetDir.empty()) {
 				mesh->vertexBuffer->setDebugName(
@@ -32,10 +33,11 @@ void Model::prepareForRendering(SGEDevice& sgedev, AssetLibrary& assetLib)
 			mesh->hasUsableTangetSpace = mesh->vbNormalOffsetBytes >= 0 && mesh->vbNormalOffsetBytes >= 0 &&
 			                             mesh->vbTangetOffsetBytes >= 0 && mesh->vbBinormalOffsetBytes >= 0;
 
-			if (mesh->indexBufferRaw.size() != 0) {
+			const span<const char> indexBufferData = mesh->getIndexBufferData();
+			if (indexBufferData.size() != 0) {
 				mesh->indexBuffer = sgedev.requestResource<Buffer>();
-				const BufferDesc ibd = BufferDesc::GetDefaultIndexBuffer((uint32)mesh->indexBufferRaw.size(), usage);
-				mesh->indexBuffer->create(ibd, mesh->indexBufferRaw.data());
+				const BufferDesc ibd = BufferDesc::GetDefaultIndexBuffer((uint32)indexBufferData.size(), usage);
+				mesh->indexBuffer->create(ibd, indexBufferData.data());
 
 				if (getModelLoadSetting().assetDir.empty()) {
 					mesh->indexBuffer->setDebugName(
@@ -253,88 +255,115 @@ int Model::getAnimationIndexByName(const std::string& name) const
 	return -1;
 }
 
-void KeyFrames::evaluate(transf3d& result, const float t) const
+/// Finds the two keyframes that need to be interpolated to get the value at time @t.
+/// @param [in,out] cursor the keyframe found by the previous search. When the time moves forward the answer is
+///                 usually the same keyframe or the next one, in that case no searching is needed.
+/// @param [out] k0,k1 the keyframes to be interpolated, they are the same if @t is outside of the keyframes range.
+/// @param [out] alpha the interpolation coefficient between @k0 and @k1.
+static void findKeyFramesToInterpolate(
+    const std::vector<float>& times, const float t, int& cursor, int& k0, int& k1, float& alpha)
 {
-	// Evaluate the translation.
-	if (positionKeyFrames.empty() == false) {
-		const auto& keyItr = positionKeyFrames.upper_bound(t);
-		if (keyItr == positionKeyFrames.end()) {
-			result.p = positionKeyFrames.rbegin()->second;
+	const int numKeys = int(times.size());
+	sgeAssert(numKeys > 0);
+
+	// Find the last keyframe with time <= t, -1 if t is before the first keyframe.
+	int iKey = -1;
+	if (cursor >= 0 && cursor < numKeys && times[cursor] <= t) {
+		if (cursor + 1 == numKeys || t < times[cursor + 1]) {
+			iKey = cursor;
 		}
-		else {
-			const auto& prevKeyItr = std::prev(keyItr);
+		else if (cursor + 2 == numKeys || t < times[cursor + 2]) {
+			iKey = cursor + 1;
+		}
+	}
 
-			if (prevKeyItr == positionKeyFrames.end()) {
-				result.p = keyItr->second;
-			}
-			else {
-				const float t0 = prevKeyItr->first;
-				const float t1 = keyItr->first;
-				const float dt = t1 - t0;
+	if (iKey < 0) {
+		iKey = int(std::upper_bound(times.begin(), times.end(), t) - times.begin()) - 1;
+	}
 
-				if (dt > 1e-6f) {
-					result.p = lerp(prevKeyItr->second, keyItr->second, (t - t0) / dt);
-				}
-				else {
-					result.p = keyItr->second;
-				}
-			}
-		}
+	cursor = iKey;
+	alpha = 0.f;
+
+	if (iKey < 0) {
+		k0 = k1 = 0;
+	}
+	else if (iKey == numKeys - 1) {
+		k0 = k1 = iKey;
 	}
+	else {
+		k0 = iKey;
+		k1 = iKey + 1;
 
-	// Evaluate the rotation.
-	if (rotationKeyFrames.empty() == false) {
-		const auto& keyItr = rotationKeyFrames.upper_bound(t);
-		if (keyItr == rotationKeyFrames.end()) {
-			result.r = rotationKeyFrames.rbegin()->second;
+		const float dt = times[k1] - times[k0];
+		if (dt > 1e-6f) {
+			alpha = (t - times[k0]) / dt;
 		}
 		else {
-			const auto& prevKeyItr = std::prev(keyItr);
+			k0 = k1;
+		}
+	}
+}
 
-			if (prevKeyItr == rotationKeyFrames.end()) {
-				result.r = keyItr->second;
-			}
-			else {
-				const float t0 = prevKeyItr->first;
-				const float t1 = keyItr->first;
-				const float dt = t1 - t0;
+void KeyFrames::quantizeRotations()
+{
+	if (hasQuantizedRotations() || rotationKeyFrames.empty()) {
+		return;
+	}
 
-				if (dt > 1e-6f) {
-					result.r = slerp(prevKeyItr->second, keyItr->second, (t - t0) / dt);
-				}
-				else {
-					result.r = keyItr->second;
-				}
-			}
-		}
+	rotationKeyFramesQuantized.resize(rotationKeyFrames.values.size());
+	for (int iKey = 0; iKey < rotationKeyFrames.size(); ++iKey) {
+		rotationKeyFramesQuantized[iKey] = QuantizedQuat::fromQuat(rotationKeyFrames.values[iKey]);
 	}
 
+	rotationKeyFrames.values.clear();
+	rotationKeyFrames.values.shrink_to_fit();
+}
 
-	// Evaluate the scaling.
-	if (scalingKeyFrames.empty() == false) {
-		const auto& keyItr = scalingKeyFrames.upper_bound(t);
-		if (keyItr == scalingKeyFrames.end()) {
-			result.s = scalingKeyFrames.rbegin()->second;
-		}
-		else {
-			const auto& prevKeyItr = std::prev(keyItr);
+void KeyFrames::evaluate(transf3d& result, const float t, KeyFramesCursor* const cursor) const
+{
+	quatf rotationTo;
+	float rotationAlpha = 0.f;
+	evaluateNoSlerp(result, t, cursor, rotationTo, rotationAlpha);
 
-			if (prevKeyItr == scalingKeyFrames.end()) {
-				result.s = keyItr->second;
-			}
-			else {
-				const float t0 = prevKeyItr->first;
-				const float t1 = keyItr->first;
-				const float dt = t1 - t0;
+	if (rotationAlpha != 0.f) {
+		result.r = slerp(result.r, rotationTo, rotationAlpha);
+	}
+}
 
-				if (dt > 1e-6f) {
-					result.s = lerp(prevKeyItr->second, keyItr->second, (t - t0) / dt);
-				}
-				else {
-					result.s = keyItr->second;
-				}
-			}
-		}
+void KeyFrames::evaluateNoSlerp(
+    transf3d& result, const float t, KeyFramesCursor* const cursor, quatf& rotationTo, float& rotationAlpha) const
+{
+	KeyFramesCursor localCursor;
+	KeyFramesCursor& c = cursor ? *cursor : localCursor;
+
+	int k0 = 0;
+	int k1 = 0;
+	float alpha = 0.f;
+
+	// Evaluate the translation.
+	if (positionKeyFrames.empty() == false) {
+		findKeyFramesToInterpolate(positionKeyFrames.times, t, c.positionKey, k0, k1, alpha);
+		const std::vector<vec3f>& values = positionKeyFrames.values;
+		result.p = (k0 == k1) ? values[k0] : lerp(values[k0], values[k1], alpha);
+	}
+
+	// Find the rotations to be interpolated.
+	if (rotationKeyFrames.empty() == false) {
+		findKeyFramesToInterpolate(rotationKeyFrames.times, t, c.rotationKey, k0, k1, alpha);
+		result.r = getRotationKeyValue(k0);
+		rotationTo = (k0 == k1) ? result.r : getRotationKeyValue(k1);
+		rotationAlpha = (k0 == k1) ? 0.f : alpha;
+	}
+	else {
+		rotationTo = result.r;
+		rotationAlpha = 0.f;
+	}
+
+	// Evaluate the scaling.
+	if (scalingKeyFrames.empty() == false) {
+		findKeyFramesToInterpolate(scalingKeyFrames.times, t, c.scalingKey, k0, k1, alpha);
+		const std::vector<vec3f>& values = scalingKeyFrames.values;
+		result.s = (k0 == k1) ? values[k0] : lerp(values[k0], values[k1], alpha);
 	}
 }
 
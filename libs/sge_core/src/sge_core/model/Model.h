@@ -1,11 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "sge_core/sgecore_api.h"
 #include "sge_renderer/renderer/renderer.h"
 #include "sge_utils/containers/ChunkContainer.h"
+#include "sge_utils/containers/span.h"
 #include "sge_utils/math/Box3f.h"
 #include "sge_utils/math/mat4f.h"
 #include "sge_utils/math/primitives.h"
@@ -18,6 +22,7 @@ namespace sge {
 struct AssetLibrary;
 struct AssetIface_Material;
 struct IMaterial;
+struct MemoryMappedFile;
 
 struct Model_CollisionShapeBox {
 	Model_CollisionShapeBox() = default;
@@ -84,6 +89,10 @@ struct ModelLoadSettings {
 	/// The directory of the file, used for dependacy(materials or textures)loading assets.
 	/// Needed when the model references other assets like textures.
 	std::string assetDir;
+
+	/// If true the rotation keyframes of the animations will be stored with 16 bits per component.
+	/// Uses half of the memory for rotations, with a small loss in precision.
+	bool quantizeAnimationRotations = false;
 };
 
 struct ModelMaterial {
@@ -149,6 +158,23 @@ struct SGE_CORE_API ModelMesh {
 	std::vector<char> vertexBufferRaw; ///< The raw data containing all vertices in the vertex buffer,
 	std::vector<char> indexBufferRaw;  ///< The raw data containing all indices in the vertex buffer,
 
+	/// When the model is loaded from a memory mapped binary model file, the vertex and index data isn't copied,
+	/// these point directly in the mapped file and @vertexBufferRaw and @indexBufferRaw are empty.
+	/// Use @getVertexBufferData and @getIndexBufferData to access the data no matter where it is stored.
+	span<const char> vertexBufferMapped;
+	span<const char> indexBufferMapped;
+
+	span<const char> getVertexBufferData() const
+	{
+		return vertexBufferRaw.empty() ? vertexBufferMapped
+		                               : span<const char>(vertexBufferRaw.data(), vertexBufferRaw.size());
+	}
+
+	span<const char> getIndexBufferData() const
+	{
+		return indexBufferRaw.empty() ? indexBufferMapped : span<const char>(indexBufferRaw.data(), indexBufferRaw.size());
+	}
+
 	Box3f aabox; ///< The bounding box around the vertices of the mesh, without any deformation by skinning or anything
 	             ///< else.
 
@@ -177,27 +203,151 @@ struct MeshAttachment {
 	int attachedMaterialIndex = -1;
 };
 
-struct KeyFrames {
-	std::map<float, vec3f> positionKeyFrames;
-	std::map<float, quatf> rotationKeyFrames;
-	std::map<float, vec3f> scalingKeyFrames;
+/// Keyframes for a single property of a node.
+/// The times and the values are stored in separate arrays sorted by time, so the times could be binary searched.
+template <typename T>
+struct KeyFrameTrack {
+	bool empty() const { return times.empty(); }
+	int size() const { return int(times.size()); }
+
+	/// Adds a keyframe at the specified time, keeping the keyframes sorted.
+	/// If there is already a keyframe at that time its value gets replaced.
+	void setKey(const float time, const T& value)
+	{
+		// Keyframes are usually added in order, so check the end first.
+		if (times.empty() || times.back() < time) {
+			times.push_back(time);
+			values.push_back(value);
+			return;
+		}
+
+		const auto itr = std::lower_bound(times.begin(), times.end(), time);
+		const ptrdiff_t index = itr - times.begin();
+		if (*itr == time) {
+			values[index] = value;
+		}
+		else {
+			times.insert(itr, time);
+			values.insert(values.begin() + index, value);
+		}
+	}
+
+	std::vector<float> times;
+	std::vector<T> values;
+};
+
+/// A quaternion stored with 16 bit signed normalized components.
+struct QuantizedQuat {
+	static QuantizedQuat fromQuat(const quatf& q)
+	{
+		const auto quantize = [](float v) -> sint16 {
+			v = clamp(v, -1.f, 1.f) * 32767.f;
+			return sint16(v < 0.f ? v - 0.5f : v + 0.5f);
+		};
+
+		QuantizedQuat result;
+		result.x = quantize(q.x);
+		result.y = quantize(q.y);
+		result.z = quantize(q.z);
+		result.w = quantize(q.w);
+		return result;
+	}
+
+	quatf toQuat() const
+	{
+		const float k = 1.f / 32767.f;
+		return quatf(float(x) * k, float(y) * k, float(z) * k, float(w) * k).normalized();
+	}
 
+	sint16 x = 0;
+	sint16 y = 0;
+	sint16 z = 0;
+	sint16 w = 32767;
+};
+
+/// Caches the last used keyframe in each track of a @KeyFrames.
+/// When the animation is played forward the needed keyframe is either the same or the next one,
+/// so they could be found without searching.
+struct KeyFramesCursor {
+	int positionKey = 0;
+	int rotationKey = 0;
+	int scalingKey = 0;
+};
+
+struct SGE_CORE_API KeyFrames {
 	bool hasAnyKeyFrames() const
 	{
 		return !positionKeyFrames.empty() || !rotationKeyFrames.empty() || !scalingKeyFrames.empty();
 	}
 
-	void evaluate(transf3d& result, const float t) const;
+	bool hasQuantizedRotations() const { return !rotationKeyFramesQuantized.empty(); }
+
+	/// Converts the rotation keyframe values to @QuantizedQuat.
+	void quantizeRotations();
+
+	/// Returns the value of the specified rotation keyframe, no matter if it is quantized or not.
+	quatf getRotationKeyValue(const int iKey) const
+	{
+		return hasQuantizedRotations() ? rotationKeyFramesQuantized[iKey].toQuat() : rotationKeyFrames.values[iKey];
+	}
+
+	/// Modifies the keyframed properties of @result with their values at the time @t.
+	/// @param [in,out] cursor (optional) the keyframes used by the previous evaluation, makes the evaluation faster
+	///                 when @t is close to the previously used time.
+	void evaluate(transf3d& result, const float t, KeyFramesCursor* const cursor = nullptr) const;
+
+	/// The same as @evaluate, but the rotation isn't interpolated. @result.r is set to the rotation of the
+	/// previous keyframe and it should be slerped with @rotationTo by @rotationAlpha.
+	/// Used for interpolating many rotations at once with slerpBatch().
+	void evaluateNoSlerp(
+	    transf3d& result, const float t, KeyFramesCursor* const cursor, quatf& rotationTo, float& rotationAlpha) const;
+
+	KeyFrameTrack<vec3f> positionKeyFrames;
+	/// If the rotations are quantized, the values are in @rotationKeyFramesQuantized and @rotationKeyFrames has only
+	/// the times.
+	KeyFrameTrack<quatf> rotationKeyFrames;
+	std::vector<QuantizedQuat> rotationKeyFramesQuantized;
+	KeyFrameTrack<vec3f> scalingKeyFrames;
 };
 
 struct ModelAnimation {
 	ModelAnimation() = default;
 
-	ModelAnimation(std::string animationName, float durationSec, std::map<int, KeyFrames> perNodeKeyFrames)
+	ModelAnimation(std::string animationName, float durationSec, const std::map<int, KeyFrames>& perNodeKeyFramesMap)
 	    : animationName(std::move(animationName))
 	    , durationSec(durationSec)
-	    , perNodeKeyFrames(std::move(perNodeKeyFrames))
 	{
+		for (const auto& itr : perNodeKeyFramesMap) {
+			getOrAddNodeKeyFrames(itr.first) = itr.second;
+		}
+	}
+
+	/// Returns the keyframes for the specified node, nullptr if the node isn't animated.
+	const KeyFrames* findNodeKeyFrames(const int nodeIndex) const
+	{
+		const bool isInRange = nodeIndex >= 0 && nodeIndex < int(perNodeKeyFrames.size());
+		if (isInRange && perNodeKeyFrames[nodeIndex].hasAnyKeyFrames()) {
+			return &perNodeKeyFrames[nodeIndex];
+		}
+		return nullptr;
+	}
+
+	/// Returns the keyframes for the specified node, allocates them if needed.
+	KeyFrames& getOrAddNodeKeyFrames(const int nodeIndex)
+	{
+		sgeAssert(nodeIndex >= 0);
+		if (nodeIndex >= int(perNodeKeyFrames.size())) {
+			perNodeKeyFrames.resize(nodeIndex + 1);
+		}
+		return perNodeKeyFrames[nodeIndex];
+	}
+
+	/// Converts the rotation keyframes of all nodes to @QuantizedQuat.
+	void quantizeRotations()
+	{
+		for (KeyFrames& keyFrames : perNodeKeyFrames) {
+			keyFrames.quantizeRotations();
+		}
 	}
 
 	/// Modifies the specified transform and amends the keyframed data. Non-keyframed data is not changed.
@@ -206,12 +356,13 @@ struct ModelAnimation {
 	/// @param [in,out] outTransform the transform to get modified.
 	/// @param [in] the keyframes for the targeted node.
 	/// @param [in] time is the time in the animation used to interpolate between keyframes.
+	/// @param [in,out] cursor (optional) the keyframes used the last time this node was evaluated.
 	/// @return true if there were keyframes for the node.
-	bool modifyTransformWithKeyFrames(transf3d& outTransform, const int nodeIndex, const float time) const
+	bool modifyTransformWithKeyFrames(
+	    transf3d& outTransform, const int nodeIndex, const float time, KeyFramesCursor* const cursor = nullptr) const
 	{
-		auto itr = perNodeKeyFrames.find(nodeIndex);
-		if (itr != perNodeKeyFrames.end()) {
-			itr->second.evaluate(outTransform, time);
+		if (const KeyFrames* const keyFrames = findNodeKeyFrames(nodeIndex)) {
+			keyFrames->evaluate(outTransform, time, cursor);
 			return true;
 		}
 		return false;
@@ -225,8 +376,9 @@ struct ModelAnimation {
 	/// The artist might need them for interpolation purposes.
 	float durationSec = 0;
 
-	/// The keyframes of all affected nodes in their local space (relative to their parents).
-	std::map<int, KeyFrames> perNodeKeyFrames;
+	/// The keyframes of all affected nodes in their local space (relative to their parents), indexed by node index.
+	/// Nodes that aren't affected by the animation have no keyframes.
+	std::vector<KeyFrames> perNodeKeyFrames;
 };
 
 struct ModelNode {
@@ -296,6 +448,9 @@ struct SGE_CORE_API Model {
 
 	const ModelLoadSettings& getModelLoadSetting() const { return m_loadSets; }
 
+	/// Keeps the specified memory mapped file alive as long as the model, as the model data points in it.
+	void setMappedFile(std::shared_ptr<MemoryMappedFile> mappedFile) { m_mappedFile = std::move(mappedFile); }
+
   private:
 	void loadMaterials(AssetLibrary& assetLib);
 
@@ -326,6 +481,9 @@ struct SGE_CORE_API Model {
 	/// Cached loading settings.
 	ModelLoadSettings m_loadSets;
 
+	/// The file the model was loaded from, if it was a memory mapped binary model file.
+	std::shared_ptr<MemoryMappedFile> m_mappedFile;
+
   public:
 	// TODO: make these private.
 	// TODO: Make these use the same strcture we have for the physics RigidBody creation.
@@ -3,7 +3,9 @@
 #include "sge_core/ICore.h"
 #include "sge_core/model/Model.h"
 #include "sge_utils/containers/Range.h"
-#include <functional>
+#include "sge_utils/math/simdMath.h"
+#include "sge_utils/threading/ThreadPool.h"
+#include <algorithm>
 
 namespace sge {
 
@@ -11,6 +13,41 @@ void ModelAnimator::create(Model& modelToBeAnimated)
 {
 	*this = ModelAnimator();
 	this->m_modelToAnimate = &modelToBeAnimated;
+	computeNodesParentSorted();
+}
+
+void ModelAnimator::computeNodesParentSorted()
+{
+	const int numNodes = m_modelToAnimate->numNodes();
+
+	m_nodesParentSorted.clear();
+	m_nodesParentSorted.reserve(numNodes);
+	m_nodeParents.assign(numNodes, -1);
+
+	const int iRoot = m_modelToAnimate->getRootNodeIndex();
+	if (iRoot < 0) {
+		return;
+	}
+
+	// Breadth first, so each node is added after its parent.
+	m_nodesParentSorted.push_back(iRoot);
+	for (int t = 0; t < int(m_nodesParentSorted.size()); ++t) {
+		const int iNode = m_nodesParentSorted[t];
+		for (const int iChild : m_modelToAnimate->nodeAt(iNode)->childNodes) {
+			m_nodeParents[iChild] = iNode;
+			m_nodesParentSorted.push_back(iChild);
+		}
+	}
+}
+
+void ModelAnimator::NodesSamples::resize(int numSamples)
+{
+	positions.resize(numSamples);
+	rotations.resize(numSamples);
+	rotationsTo.resize(numSamples);
+	rotationsAlpha.resize(numSamples);
+	scalings.resize(numSamples);
+	localMatrices.resize(numSamples);
 }
 
 
@@ -280,23 +317,18 @@ void ModelAnimator::computeModleNodesTrasnforms(mat4f* outNodeTransforms, int ou
 		return;
 	}
 
+	const int numNodes = m_modelToAnimate->numNodes();
+	if (int(m_nodeParents.size()) != numNodes) {
+		computeNodesParentSorted();
+	}
+
 	// If no tracks are playing then just use the static state.
 	if (m_playbacks.size() == 0) {
-		std::function<void(int, const mat4f&)> evalGlobalTransform = [&](int iNode,
-		                                                                 const mat4f& parentGlobalTform) -> void {
-			ModelNode* rawNode = m_modelToAnimate->nodeAt(iNode);
-			mat4f ownGlobalTransform = parentGlobalTform * rawNode->staticLocalTransform.toMatrix();
-
-			outNodeTransforms[iNode] = ownGlobalTransform;
-
-			for (int childIndex : rawNode->childNodes) {
-				evalGlobalTransform(childIndex, ownGlobalTransform);
-			}
-		};
-
-		const int iRoot = m_modelToAnimate->getRootNodeIndex();
-		evalGlobalTransform(iRoot, mat4f::getIdentity());
+		for (int iNode = 0; iNode < numNodes; ++iNode) {
+			outNodeTransforms[iNode] = m_modelToAnimate->nodeAt(iNode)->staticLocalTransform.toMatrix();
+		}
 
+		computeGlobalTransforms(outNodeTransforms);
 		return;
 	}
 
@@ -308,68 +340,170 @@ void ModelAnimator::computeModleNodesTrasnforms(mat4f* outNodeTransforms, int ou
 		}
 	}
 
+	m_samples.resize(numNodes);
+
 	// Evaluates the nodes. They may be effecte by multiple models (stealing animations and blending them)
-	for (const TrackPlayback& playback : m_playbacks) {
-		const AnimationTrack& track = m_tracks[playback.trackId];
-		const AnimationModelSrc& animSrc = track.animationSources[playback.trackAnimationIndex];
+	for (TrackPlayback& playback : m_playbacks) {
+		samplePlayback(playback, m_samples, 0);
 
-		const Model& animationSourceModel =
-		    (animSrc.modelAnimSouce != nullptr) ? *animSrc.modelAnimSouce : *m_modelToAnimate;
-		const ModelAnimation* const animationSourceAnimation =
-		    animationSourceModel.animationAt(animSrc.animIndexInAnimSource);
-
-		const float evalTime = playback.timeInAnimation;
-
-		const int numNodes = m_modelToAnimate->numNodes();
-		for (int iOrigNode = 0; iOrigNode < numNodes; ++iOrigNode) {
-			// Find the node index in the animation source model.
-			int donorNodeIndex = -1;
-			if (animSrc.modelAnimSouce) {
-				donorNodeIndex = m_perModel_srcNode_toNode[&animationSourceModel][iOrigNode];
-			}
-			else {
-				donorNodeIndex = iOrigNode;
+		NodesSamples& s = m_samples;
+		slerpBatch(s.rotations.data(), s.rotations.data(), s.rotationsTo.data(), s.rotationsAlpha.data(), numNodes);
+
+		if (isSingleTrackPlaying) {
+			composeTransformMatricesBatch(
+			    outNodeTransforms, s.positions.data(), s.rotations.data(), s.scalings.data(), numNodes);
+		}
+		else {
+			composeTransformMatricesBatch(
+			    s.localMatrices.data(), s.positions.data(), s.rotations.data(), s.scalings.data(), numNodes);
+			for (int iNode = 0; iNode < numNodes; ++iNode) {
+				outNodeTransforms[iNode] += s.localMatrices[iNode] * playback.normWeight;
 			}
+		}
+	}
 
-			// Now evaluate the transform of that node for the animation moment.
-			// If no such node was found use the default transformation from @m_model.
-			transf3d nodeLocalTransform;
-			if (donorNodeIndex >= 0) {
-				if (animationSourceAnimation != nullptr) {
-					nodeLocalTransform = animationSourceModel.nodeAt(donorNodeIndex)->staticLocalTransform;
-					animationSourceAnimation->modifyTransformWithKeyFrames(
-					    nodeLocalTransform, donorNodeIndex, evalTime);
-				}
+	// Evaluate the node global transform by traversing the node hierarchy using the
+	// local transform computed above.
+	computeGlobalTransforms(outNodeTransforms);
+}
+
+void ModelAnimator::computeModleNodesTrasnformsBatch(
+    ModelAnimator* const* animators, mat4f* const* outNodeTransforms, int numAnimators, ThreadPool* const threadPool)
+{
+	if (numAnimators <= 0) {
+		return;
+	}
+
+	const Model* const model = animators[0]->m_modelToAnimate;
+	const int numNodes = model->numNodes();
+
+	const auto evaluateAnimators = [&](int begin, int end) -> void {
+		// The animators playing a single track are sampled in a single array, so the rotations and the matrices
+		// of all of them are computed together.
+		std::vector<int> batchedAnimators;
+		batchedAnimators.reserve(end - begin);
+
+		for (int iAnimator = begin; iAnimator < end; ++iAnimator) {
+			ModelAnimator& animator = *animators[iAnimator];
+			sgeAssert(animator.m_modelToAnimate == model && "All animators must animate the same model!");
+
+			if (animator.m_playbacks.size() == 1) {
+				batchedAnimators.push_back(iAnimator);
 			}
 			else {
-				// In no matching node is found, apply the static transform that has no animation.
-				nodeLocalTransform = m_modelToAnimate->nodeAt(iOrigNode)->staticLocalTransform;
+				animator.computeModleNodesTrasnforms(outNodeTransforms[iAnimator], numNodes);
 			}
+		}
 
-			if (isSingleTrackPlaying) {
-				outNodeTransforms[iOrigNode] = nodeLocalTransform.toMatrix();
-			}
-			else {
-				outNodeTransforms[iOrigNode] += nodeLocalTransform.toMatrix() * playback.normWeight;
+		if (batchedAnimators.empty()) {
+			return;
+		}
+
+		// Use the scratch memory of the 1st animator in the chunk, no other thread touches it.
+		NodesSamples& s = animators[batchedAnimators[0]]->m_samples;
+		const int numSamples = int(batchedAnimators.size()) * numNodes;
+		s.resize(numSamples);
+
+		for (int t = 0; t < int(batchedAnimators.size()); ++t) {
+			ModelAnimator& animator = *animators[batchedAnimators[t]];
+			animator.samplePlayback(animator.m_playbacks[0], s, t * numNodes);
+		}
+
+		slerpBatch(s.rotations.data(), s.rotations.data(), s.rotationsTo.data(), s.rotationsAlpha.data(), numSamples);
+		composeTransformMatricesBatch(
+		    s.localMatrices.data(), s.positions.data(), s.rotations.data(), s.scalings.data(), numSamples);
+
+		for (int t = 0; t < int(batchedAnimators.size()); ++t) {
+			ModelAnimator& animator = *animators[batchedAnimators[t]];
+			if (int(animator.m_nodeParents.size()) != numNodes) {
+				animator.computeNodesParentSorted();
 			}
+
+			mat4f* const out = outNodeTransforms[batchedAnimators[t]];
+			std::copy_n(s.localMatrices.data() + t * numNodes, numNodes, out);
+			animator.computeGlobalTransforms(out);
 		}
+	};
+
+	// Small chunks are enough, each animator is a lot of work.
+	const int kChunkSize = 8;
+	if (threadPool != nullptr) {
+		threadPool->parallelFor(numAnimators, kChunkSize, evaluateAnimators);
 	}
+	else {
+		evaluateAnimators(0, numAnimators);
+	}
+}
 
-	// Evaluate the node global transform by traversing the node hierarchy using the
-	// local transform computed above.
-	std::function<void(mat4f*, Model*, int, mat4f)> traverseGlobalTransform;
-	traverseGlobalTransform =
-	    [&traverseGlobalTransform](
-	        mat4f* outNodeTransforms, Model* model, int iNode, const mat4f& parentTransfrom) -> void {
-		mat4f currNodeGlobalTransform = parentTransfrom * outNodeTransforms[iNode];
-		outNodeTransforms[iNode] = currNodeGlobalTransform;
-		for (const int childNodeIndex : model->nodeAt(iNode)->childNodes) {
-			traverseGlobalTransform(outNodeTransforms, model, childNodeIndex, currNodeGlobalTransform);
+void ModelAnimator::samplePlayback(TrackPlayback& playback, NodesSamples& samples, int samplesOffset)
+{
+	const AnimationTrack& track = m_tracks[playback.trackId];
+	const AnimationModelSrc& animSrc = track.animationSources[playback.trackAnimationIndex];
+
+	const Model& animationSourceModel =
+	    (animSrc.modelAnimSouce != nullptr) ? *animSrc.modelAnimSouce : *m_modelToAnimate;
+	const ModelAnimation* const animationSourceAnimation =
+	    animationSourceModel.animationAt(animSrc.animIndexInAnimSource);
+
+	const float evalTime = playback.timeInAnimation;
+
+	// The node remapping is the same for all nodes, find it once.
+	const std::vector<int>* const srcNodeToNode =
+	    animSrc.modelAnimSouce ? &m_perModel_srcNode_toNode[&animationSourceModel] : nullptr;
+
+	if (int(playback.keyFramesCursors.size()) != animationSourceModel.numNodes()) {
+		playback.keyFramesCursors.resize(animationSourceModel.numNodes());
+	}
+
+	const int numNodes = m_modelToAnimate->numNodes();
+	for (int iOrigNode = 0; iOrigNode < numNodes; ++iOrigNode) {
+		// Find the node index in the animation source model.
+		const int donorNodeIndex = srcNodeToNode ? (*srcNodeToNode)[iOrigNode] : iOrigNode;
+
+		// Now evaluate the transform of that node for the animation moment.
+		// If no such node was found use the default transformation from @m_model.
+		transf3d nodeLocalTransform;
+		quatf rotationTo = nodeLocalTransform.r;
+		float rotationAlpha = 0.f;
+		if (donorNodeIndex >= 0) {
+			if (animationSourceAnimation != nullptr) {
+				nodeLocalTransform = animationSourceModel.nodeAt(donorNodeIndex)->staticLocalTransform;
+				rotationTo = nodeLocalTransform.r;
+
+				if (const KeyFrames* const keyFrames = animationSourceAnimation->findNodeKeyFrames(donorNodeIndex)) {
+					keyFrames->evaluateNoSlerp(
+					    nodeLocalTransform,
+					    evalTime,
+					    &playback.keyFramesCursors[donorNodeIndex],
+					    rotationTo,
+					    rotationAlpha);
+				}
+			}
+		}
+		else {
+			// In no matching node is found, apply the static transform that has no animation.
+			nodeLocalTransform = m_modelToAnimate->nodeAt(iOrigNode)->staticLocalTransform;
+			rotationTo = nodeLocalTransform.r;
 		}
-	};
 
-	traverseGlobalTransform(
-	    outNodeTransforms, m_modelToAnimate, m_modelToAnimate->getRootNodeIndex(), mat4f::getIdentity());
+		const int iSample = samplesOffset + iOrigNode;
+		samples.positions[iSample] = nodeLocalTransform.p;
+		samples.rotations[iSample] = nodeLocalTransform.r;
+		samples.rotationsTo[iSample] = rotationTo;
+		samples.rotationsAlpha[iSample] = rotationAlpha;
+		samples.scalings[iSample] = nodeLocalTransform.s;
+	}
+}
+
+void ModelAnimator::computeGlobalTransforms(mat4f* inOutNodeTransforms) const
+{
+	// The parents are before their children, so the parent is already in global space when the child is reached.
+	for (const int iNode : m_nodesParentSorted) {
+		const int iParent = m_nodeParents[iNode];
+		if (iParent >= 0) {
+			inOutNodeTransforms[iNode] = mulMatricesSimd(inOutNodeTransforms[iParent], inOutNodeTransforms[iNode]);
+		}
+	}
 }
 
 } // namespace sge
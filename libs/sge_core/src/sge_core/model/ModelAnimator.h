@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sge_core/model/Model.h"
 #include "sge_core/sgecore_api.h"
 #include "sge_utils/containers/ArrayView.h"
 #include "sge_utils/math/mat4f.h"
@@ -13,6 +14,7 @@ namespace sge {
 
 struct EvaluatedModel;
 struct Model;
+struct ThreadPool;
 
 /// @brief Describes what should happen when an animation track finishes.
 enum TrackTransition : int {
@@ -66,6 +68,19 @@ struct SGE_CORE_API ModelAnimator {
 		computeModleNodesTrasnforms(outNodeTransforms.data(), (int)outNodeTransforms.size());
 	}
 
+	/// Computes the node transforms of multiple animators that animate the same @Model, for example a crowd of
+	/// identical characters. The keyframes of all animators are sampled first, then all rotations are interpolated
+	/// and all matrices are composed together with the batch functions from sge_utils/math/simdMath.h.
+	/// Animators that blend multiple tracks are evaluated with @computeModleNodesTrasnforms.
+	/// @param [in] animators the animators to be evaluated, all of them must animate the same model.
+	/// @param [out] outNodeTransforms for each animator, a pre-allocated array holding a trasnform for each node.
+	/// @param [in] threadPool (optional) if specified the animators are split in chunks evaluated on the workers.
+	static void computeModleNodesTrasnformsBatch(
+	    ModelAnimator* const* animators,
+	    mat4f* const* outNodeTransforms,
+	    int numAnimators,
+	    ThreadPool* const threadPool = nullptr);
+
 	int getNumNodes() const;
 
 	int getNumTacks() const { return int(m_tracks.size()); }
@@ -79,10 +94,36 @@ struct SGE_CORE_API ModelAnimator {
 	}
 
   private:
+	struct TrackPlayback;
+
+	/// The local transforms of nodes, sampled from the animation, stored in separate arrays
+	/// so they could be processed with the batch math functions.
+	struct NodesSamples {
+		void resize(int numSamples);
+
+		std::vector<vec3f> positions;
+		std::vector<quatf> rotations; ///< The rotations of the previous keyframes, slerped in place with @rotationsTo.
+		std::vector<quatf> rotationsTo;
+		std::vector<float> rotationsAlpha;
+		std::vector<vec3f> scalings;
+		std::vector<mat4f> localMatrices;
+	};
+
 	/// Create a @srcModel to @m_modelToAnimate node id remapping.
 	/// Used to find the matching nodes.
 	void createNodeToNodeRemapForModel(Model& srcModel);
 
+	/// Computes @m_nodesParentSorted and @m_nodeParents for @m_modelToAnimate.
+	void computeNodesParentSorted();
+
+	/// Samples the local transform of every node of @m_modelToAnimate for the specified playback, without
+	/// interpolating the rotations.
+	/// @param [in] samplesOffset the index in @samples where the 1st node should be written.
+	void samplePlayback(TrackPlayback& playback, NodesSamples& samples, int samplesOffset);
+
+	/// Converts the local node transforms to global ones.
+	void computeGlobalTransforms(mat4f* inOutNodeTransforms) const;
+
   private:
 	/// While models have animations in them it is not uncommon,
 	/// to share animations between multiple models.
@@ -126,6 +167,10 @@ struct SGE_CORE_API ModelAnimator {
 		/// The weight of the track to be used when computing the nodes trasnform.
 		/// It is computed in such a way that the sum of all of these for all playing tracks is 1.f.
 		float normWeight = 0.f;
+
+		/// The keyframes used by the last evaluation for each node in the animation source model.
+		/// As the animation usually moves forward, next time the needed keyframes are found without searching.
+		std::vector<KeyFramesCursor> keyFramesCursors;
 	};
 
   private:
@@ -142,6 +187,14 @@ struct SGE_CORE_API ModelAnimator {
 	std::vector<TrackPlayback> m_playbacks;
 
 	std::unordered_map<const Model*, std::vector<int>> m_perModel_srcNode_toNode;
+
+	/// The nodes of @m_modelToAnimate sorted so parents come before their children (starting form the root).
+	std::vector<int> m_nodesParentSorted;
+	/// The parent of each node of @m_modelToAnimate, -1 for the root node.
+	std::vector<int> m_nodeParents;
+
+	/// Scratch memory used in @computeModleNodesTrasnforms, kept to avoid allocating each time.
+	NodesSamples m_samples;
 };
 
 } // namespace sge
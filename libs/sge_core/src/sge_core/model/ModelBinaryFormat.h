@@ -0,0 +1,120 @@
+#pragma once
+
+#include "sge_utils/sge_utils.h"
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace sge {
+
+/// The binary model file format, an alternative to the json-headed format written by @ModelWriter::write.
+/// The file is designed to be memory mapped. It has the following layout:
+///   [ModelBinaryHeader][data chunks...][ModelBinaryChunkDesc * numChunks]
+/// Each data chunk starts at an offset aligned to @kModelBinaryChunkAlignment.
+/// The 1st chunk (@kModelBinaryMetadataChunkId) describes the nodes, materials, meshes, animations and collision
+/// shapes of the model (see ModelWriter::writeBinary for the exact order). All other chunks hold raw arrays (vertex and
+/// index buffers, keyframes and so on) that are referenced by their index in the chunk table.
+/// All values are in the native byte order, which is little endian on all supported platforms.
+static constexpr char kModelBinaryMagic[8] = {'S', 'G', 'E', 'M', 'D', 'L', 'B', '\0'};
+static constexpr uint32 kModelBinaryVersion = 1;
+static constexpr uint32 kModelBinaryChunkAlignment = 16;
+static constexpr uint32 kModelBinaryMetadataChunkId = 0;
+
+struct ModelBinaryHeader {
+	char magic[8];
+	uint32 version = 0;
+	uint32 numChunks = 0;
+	uint64 chunkTableByteOffset = 0;
+};
+
+struct ModelBinaryChunkDesc {
+	uint64 byteOffset = 0; ///< The offset from the beginning of the file.
+	uint64 sizeBytes = 0;
+};
+
+static_assert(sizeof(ModelBinaryHeader) == 24, "The binary model header must not have any padding.");
+static_assert(sizeof(ModelBinaryChunkDesc) == 16, "The binary model chunk desc must not have any padding.");
+
+/// Returns true if the specified memory starts with the binary model file magic.
+inline bool isModelBinaryMagic(const char* const data, const size_t sizeBytes)
+{
+	return sizeBytes >= sizeof(kModelBinaryMagic) && memcmp(data, kModelBinaryMagic, sizeof(kModelBinaryMagic)) == 0;
+}
+
+/// Appends values one after another in a blob, used to write the metadata chunk of the binary model format.
+struct ModelBinaryBlobWriter {
+	template <typename T>
+	void write(const T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only plain types could be written directly.");
+		writeRaw(&value, sizeof(T));
+	}
+
+	void writeRaw(const void* const src, const size_t sizeBytes)
+	{
+		const char* const srcBytes = (const char*)src;
+		data.insert(data.end(), srcBytes, srcBytes + sizeBytes);
+	}
+
+	void writeString(const std::string& str)
+	{
+		write(uint32(str.size()));
+		writeRaw(str.data(), str.size());
+	}
+
+	std::vector<char> data;
+};
+
+/// Reads the values written by @ModelBinaryBlobWriter.
+/// Every read is bounds checked, @isOk gets set to false if the blob is too short.
+struct ModelBinaryBlobReader {
+	ModelBinaryBlobReader(const char* const data, const size_t sizeBytes)
+	    : ptr(data)
+	    , end(data + sizeBytes)
+	{
+	}
+
+	template <typename T>
+	T read()
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only plain types could be read directly.");
+		T result = T();
+		readRaw(&result, sizeof(T));
+		return result;
+	}
+
+	void readRaw(void* const dest, const size_t sizeBytes)
+	{
+		if (!isOk || size_t(end - ptr) < sizeBytes) {
+			isOk = false;
+			return;
+		}
+
+		if (sizeBytes == 0) {
+			return;
+		}
+
+		memcpy(dest, ptr, sizeBytes);
+		ptr += sizeBytes;
+	}
+
+	std::string readString()
+	{
+		const uint32 length = read<uint32>();
+		if (!isOk || size_t(end - ptr) < length) {
+			isOk = false;
+			return std::string();
+		}
+
+		std::string result(ptr, length);
+		ptr += length;
+		return result;
+	}
+
+	const char* ptr = nullptr;
+	const char* end = nullptr;
+	bool isOk = true;
+};
+
+} // namespace sge
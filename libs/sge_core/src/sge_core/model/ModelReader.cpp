@@ -1,9 +1,11 @@
 #include "sge_utils/containers/vector_map.h"
 #include "sge_utils/io/FileStream.h"
+#include "sge_utils/io/MemoryMappedFile.h"
 #include "sge_utils/json/json.h"
 #include <stdexcept>
 
 #include "Model.h"
+#include "ModelBinaryFormat.h"
 #include "ModelReader.h"
 
 namespace sge {
@@ -60,6 +62,33 @@ UniformType::Enum UniformTypeFromString(const char* str)
 	throw ModelParseExcept("Unknown uniform type!");
 }
 
+/// Caches the offsets of the commonly used vertex semantics and the vertex stride of the mesh.
+static void cacheMeshVertexDeclOffsets(ModelMesh& mesh)
+{
+	for (const VertexDecl& decl : mesh.vertexDecl) {
+		if (decl.semantic == "a_position") {
+			mesh.vbPositionOffsetBytes = (int)decl.byteOffset;
+		}
+		else if (decl.semantic == "a_normal") {
+			mesh.vbNormalOffsetBytes = (int)decl.byteOffset;
+		}
+		else if (decl.semantic == "a_uv") {
+			mesh.vbUVOffsetBytes = (int)decl.byteOffset;
+		}
+		else if (decl.semantic == "a_tangent") {
+			mesh.vbTangetOffsetBytes = (int)decl.byteOffset;
+		}
+		else if (decl.semantic == "a_binormal") {
+			mesh.vbBinormalOffsetBytes = (int)decl.byteOffset;
+		}
+	}
+
+	// Bake the vertex stride.
+	if (!mesh.vertexDecl.empty()) {
+		mesh.stride = int(mesh.vertexDecl.back().byteOffset) + UniformType::GetSizeBytes(mesh.vertexDecl.back().format);
+	}
+}
+
 template <typename T>
 void ModelReader::loadDataChunk(std::vector<T>& resultBuffer, const int chunkId)
 {
@@ -132,6 +161,27 @@ const ModelReader::DataChunkDesc& ModelReader::FindDataChunkDesc(const int chunk
 
 bool ModelReader::loadModel(const ModelLoadSettings loadSets, IReadStream* const iReadStream, Model& model)
 {
+	// Check if this is a binary model file. These are loaded in memory as a whole as there is no json header.
+	{
+		const size_t startOffset = iReadStream->pointerOffset();
+		char magic[sizeof(kModelBinaryMagic)] = {0};
+		const size_t magicBytesRead = iReadStream->read(magic, sizeof(magic));
+		iReadStream->seek(SeekOrigin::Begining, startOffset);
+
+		if (isModelBinaryMagic(magic, magicBytesRead)) {
+			std::vector<char> fileData;
+			const size_t kReadBlockSize = 64 * 1024;
+			size_t numBytesRead = 0;
+			do {
+				fileData.resize(fileData.size() + kReadBlockSize);
+				numBytesRead = iReadStream->read(fileData.data() + fileData.size() - kReadBlockSize, kReadBlockSize);
+				fileData.resize(fileData.size() - kReadBlockSize + numBytesRead);
+			} while (numBytesRead == kReadBlockSize);
+
+			return loadModelBinary(loadSets, fileData.data(), fileData.size(), nullptr, model);
+		}
+	}
+
 	try {
 		dataChunksDesc.clear();
 		irs = iReadStream;
@@ -193,6 +243,8 @@ bool ModelReader::loadModel(const ModelLoadSettings loadSets, IReadStream* const
 					int nodeIndex = jNodeKeyFrames->getMember("nodeIndex")->getNumberAs<int>();
 					const JsonValue* jKeyFrames = jNodeKeyFrames->getMember("keyFrames");
 
+					KeyFrames& nodeKeyFrames = animation.getOrAddNodeKeyFrames(nodeIndex);
+
 					if (const JsonValue* jKeyFramesPos = jKeyFrames->getMember("positionKeyFrames_chunkId")) {
 						const int chunkId = jKeyFramesPos->getNumberAs<int>();
 						const DataChunkDesc& chunkDesc = FindDataChunkDesc(chunkId);
@@ -200,7 +252,7 @@ bool ModelReader::loadModel(const ModelLoadSettings loadSets, IReadStream* const
 						std::vector<char> chunkMemory(chunkDesc.sizeBytes);
 						loadDataChunkRaw(chunkMemory.data(), chunkMemory.size() * sizeof(chunkMemory[0]), chunkId);
 
-						const int valueTypeSizeBytes = sizeof(animation.perNodeKeyFrames[0].positionKeyFrames[0.f]);
+						const int valueTypeSizeBytes = sizeof(vec3f);
 
 						const int numPairsInChunk = int(chunkDesc.sizeBytes / (sizeof(float) + valueTypeSizeBytes));
 						const char* readPtr = chunkMemory.data();
@@ -210,7 +262,7 @@ bool ModelReader::loadModel(const ModelLoadSettings loadSets, IReadStream* const
 							const vec3f keyData = *(vec3f*)(readPtr);
 							readPtr += valueTypeSizeBytes;
 
-							animation.perNodeKeyFrames[nodeIndex].positionKeyFrames[keyTime] = keyData;
+							nodeKeyFrames.positionKeyFrames.setKey(keyTime, keyData);
 						}
 					}
 
@@ -222,7 +274,7 @@ bool ModelReader::loadModel(const ModelLoadSettings loadSets, IReadStream* const
 						std::vector<char> chunkMemory(chunkDesc.sizeBytes);
 						loadDataChunkRaw(chunkMemory.data(), chunkMemory.size() * sizeof(chunkMemory[0]), chunkId);
 
-						const int valueTypeSizeBytes = sizeof(animation.perNodeKeyFrames[0].rotationKeyFrames[0.f]);
+						const int valueTypeSizeBytes = sizeof(quatf);
 
 						const int numPairsInChunk = int(chunkDesc.sizeBytes / (sizeof(float) + valueTypeSizeBytes));
 						const char* readPtr = chunkMemory.data();
@@ -232,7 +284,7 @@ bool ModelReader::loadModel(const ModelLoadSettings loadSets, IReadStream* const
 							const quatf keyData = *(quatf*)(readPtr);
 							readPtr += valueTypeSizeBytes;
 
-							animation.perNodeKeyFrames[nodeIndex].rotationKeyFrames[keyTime] = keyData;
+							nodeKeyFrames.rotationKeyFrames.setKey(keyTime, keyData);
 						}
 					}
 
@@ -244,7 +296,7 @@ bool ModelReader::loadModel(const ModelLoadSettings loadSets, IReadStream* const
 						std::vector<char> chunkMemory(chunkDesc.sizeBytes);
 						loadDataChunkRaw(chunkMemory.data(), chunkMemory.size() * sizeof(chunkMemory[0]), chunkId);
 
-						const int valueTypeSizeBytes = sizeof(animation.perNodeKeyFrames[0].scalingKeyFrames[0.f]);
+						const int valueTypeSizeBytes = sizeof(vec3f);
 
 						const int numPairsInChunk = int(chunkDesc.sizeBytes / (sizeof(float) + valueTypeSizeBytes));
 						const char* readPtr = chunkMemory.data();
@@ -254,10 +306,14 @@ bool ModelReader::loadModel(const ModelLoadSettings loadSets, IReadStream* const
 							const vec3f keyData = *(vec3f*)(readPtr);
 							readPtr += valueTypeSizeBytes;
 
-							animation.perNodeKeyFrames[nodeIndex].scalingKeyFrames[keyTime] = keyData;
+							nodeKeyFrames.scalingKeyFrames.setKey(keyTime, keyData);
 						}
 					}
 				}
+
+				if (loadSets.quantizeAnimationRotations) {
+					animation.quantizeRotations();
+				}
 			}
 		}
 
@@ -358,28 +414,10 @@ bool ModelReader::loadModel(const ModelLoadSettings loadSets, IReadStream* const
 					decl.format = UniformTypeFromString(jDecl->getMember("format")->GetString());
 
 					mesh->vertexDecl.push_back(decl);
-
-					// Cache some commonly used semantics offsets.
-					if (decl.semantic == "a_position") {
-						mesh->vbPositionOffsetBytes = (int)decl.byteOffset;
-					}
-					else if (decl.semantic == "a_normal") {
-						mesh->vbNormalOffsetBytes = (int)decl.byteOffset;
-					}
-					else if (decl.semantic == "a_uv") {
-						mesh->vbUVOffsetBytes = (int)decl.byteOffset;
-					}
-					else if (decl.semantic == "a_tangent") {
-						mesh->vbTangetOffsetBytes = (int)decl.byteOffset;
-					}
-					else if (decl.semantic == "a_binormal") {
-						mesh->vbBinormalOffsetBytes = (int)decl.byteOffset;
-					}
 				}
 
-				// Bake the vertex stride.
-				mesh->stride =
-				    int(mesh->vertexDecl.back().byteOffset) + UniformType::GetSizeBytes(mesh->vertexDecl.back().format);
+				// Cache some commonly used semantics offsets.
+				cacheMeshVertexDeclOffsets(*mesh);
 
 				// The bones.
 				if (const JsonValue* const jBones = jMesh->getMember("bones")) {
@@ -589,4 +627,342 @@ bool ModelReader::loadModel(const ModelLoadSettings loadSets, IReadStream* const
 	return true;
 }
 
+bool ModelReader::loadModelFromFile(const ModelLoadSettings loadSets, const char* const filename, Model& model)
+{
+	std::shared_ptr<MemoryMappedFile> mappedFile = std::make_shared<MemoryMappedFile>();
+	if (mappedFile->open(filename) && isModelBinaryMagic(mappedFile->data(), mappedFile->size())) {
+		const char* const data = mappedFile->data();
+		const size_t sizeBytes = mappedFile->size();
+		return loadModelBinary(loadSets, data, sizeBytes, std::move(mappedFile), model);
+	}
+
+	// Not a binary model, fallback to the json-headed format.
+	mappedFile.reset();
+
+	FileReadStream frs(filename);
+	if (!frs.isOpened()) {
+		return false;
+	}
+
+	return loadModel(loadSets, &frs, model);
+}
+
+bool ModelReader::loadModelBinary(
+    const ModelLoadSettings& loadSets,
+    const char* const data,
+    const size_t sizeBytes,
+    std::shared_ptr<MemoryMappedFile> mappedFile,
+    Model& model)
+{
+	try {
+		model = Model();
+		model.setModelLoadSettings(loadSets);
+
+		if (sizeBytes < sizeof(ModelBinaryHeader) || !isModelBinaryMagic(data, sizeBytes)) {
+			throw ModelParseExcept("Not a binary model file!");
+		}
+
+		ModelBinaryHeader header;
+		memcpy(&header, data, sizeof(header));
+
+		if (header.version != kModelBinaryVersion) {
+			throw ModelParseExcept("Unsupported binary model file version!");
+		}
+
+		const uint64 chunkTableSizeBytes = uint64(header.numChunks) * sizeof(ModelBinaryChunkDesc);
+		// The checks are written so that a crafted file cannot overflow the sums.
+		if (header.numChunks == 0 || header.chunkTableByteOffset > sizeBytes ||
+		    chunkTableSizeBytes > sizeBytes - header.chunkTableByteOffset) {
+			throw ModelParseExcept("Invalid binary model chunk table!");
+		}
+
+		std::vector<ModelBinaryChunkDesc> chunkTable(header.numChunks);
+		memcpy(chunkTable.data(), data + header.chunkTableByteOffset, size_t(chunkTableSizeBytes));
+
+		for (const ModelBinaryChunkDesc& chunk : chunkTable) {
+			if (chunk.byteOffset > sizeBytes || chunk.sizeBytes > sizeBytes - chunk.byteOffset) {
+				throw ModelParseExcept("Binary model chunk is out of the file!");
+			}
+		}
+
+		const auto getChunk = [&](const sint32 chunkId) -> span<const char> {
+			if (chunkId < 0 || chunkId >= sint32(chunkTable.size())) {
+				throw ModelParseExcept("Chunk desc not found!");
+			}
+			const ModelBinaryChunkDesc& chunk = chunkTable[chunkId];
+			return span<const char>(data + chunk.byteOffset, size_t(chunk.sizeBytes));
+		};
+
+		// Copies the specified chunk in a std::vector, used for the data that the model doesn't reference directly.
+		const auto loadChunkToVector = [&](auto& resultBuffer, const sint32 chunkId) -> void {
+			const span<const char> chunk = getChunk(chunkId);
+			const size_t elemSizeBytes = sizeof(resultBuffer[0]);
+			if (chunk.size() % elemSizeBytes) {
+				throw ModelParseExcept("ChunkSize % sizeof(T) != 0!");
+			}
+
+			resultBuffer.resize(chunk.size() / elemSizeBytes);
+			if (!chunk.empty()) {
+				memcpy(resultBuffer.data(), chunk.data(), chunk.size());
+			}
+		};
+
+		const span<const char> metadataChunk = getChunk(kModelBinaryMetadataChunkId);
+		ModelBinaryBlobReader blob(metadataChunk.data(), metadataChunk.size());
+
+		// Reads the number of elements of an array in the metadata. Each element takes at least one byte, so a
+		// corrupted file cannot make us allocate a lot of memory.
+		const auto readCount = [&blob]() -> uint32 {
+			const uint32 count = blob.read<uint32>();
+			if (!blob.isOk || count > size_t(blob.end - blob.ptr)) {
+				throw ModelParseExcept("Binary model metadata is corrupted!");
+			}
+			return count;
+		};
+
+		const auto readTransform = [&blob]() -> transf3d {
+			transf3d tr = transf3d::getIdentity();
+			blob.readRaw(tr.p.data, sizeof(float) * 3);
+			blob.readRaw(tr.r.data, sizeof(float) * 4);
+			blob.readRaw(tr.s.data, sizeof(float) * 3);
+			return tr;
+		};
+
+		// Load the nodes.
+		const int rootNodeIndex = blob.read<sint32>();
+		const uint32 numNodes = readCount();
+		for (uint32 iNode = 0; iNode < numNodes; ++iNode) {
+			ModelNode* const node = model.nodeAt(model.makeNewNode());
+
+			node->name = blob.readString();
+			node->staticLocalTransform = readTransform();
+			node->limbLength = blob.read<float>();
+
+			const uint32 numAttachments = readCount();
+			node->meshAttachments.reserve(numAttachments);
+			for (uint32 iAttachment = 0; iAttachment < numAttachments; ++iAttachment) {
+				const int meshIndex = blob.read<sint32>();
+				const int materialIndex = blob.read<sint32>();
+				node->meshAttachments.push_back(MeshAttachment(meshIndex, materialIndex));
+			}
+
+			const uint32 numChildNodes = readCount();
+			node->childNodes.resize(numChildNodes);
+			blob.readRaw(node->childNodes.data(), numChildNodes * sizeof(sint32));
+		}
+		model.setRootNodeIndex(rootNodeIndex);
+
+		// Load the materials.
+		const uint32 numMaterials = readCount();
+		for (uint32 iMaterial = 0; iMaterial < numMaterials; ++iMaterial) {
+			ModelMaterial* const material = model.materialAt(model.makeNewMaterial());
+			material->name = blob.readString();
+			material->assetForThisMaterial = blob.readString();
+		}
+
+		// Load the meshes.
+		const uint32 numMeshes = readCount();
+		for (uint32 iMesh = 0; iMesh < numMeshes; ++iMesh) {
+			ModelMesh* const mesh = model.meshAt(model.makeNewMesh());
+
+			mesh->name = blob.readString();
+			mesh->primitiveTopology = PrimitiveTopology::Enum(blob.read<sint32>());
+			mesh->vbByteOffset = blob.read<sint32>();
+			mesh->ibByteOffset = blob.read<sint32>();
+			mesh->ibFmt = UniformType::Enum(blob.read<sint32>());
+			mesh->numElements = blob.read<sint32>();
+			mesh->numVertices = blob.read<sint32>();
+
+			// The vertex and index buffers point directly in the mapped file if there is one.
+			const sint32 vertexDataChunkId = blob.read<sint32>();
+			const sint32 indexDataChunkId = blob.read<sint32>();
+			if (vertexDataChunkId >= 0) {
+				if (mappedFile) {
+					mesh->vertexBufferMapped = getChunk(vertexDataChunkId);
+				}
+				else {
+					loadChunkToVector(mesh->vertexBufferRaw, vertexDataChunkId);
+				}
+			}
+
+			if (indexDataChunkId >= 0) {
+				if (mappedFile) {
+					mesh->indexBufferMapped = getChunk(indexDataChunkId);
+				}
+				else {
+					loadChunkToVector(mesh->indexBufferRaw, indexDataChunkId);
+				}
+			}
+
+			const uint32 numVertexDecls = readCount();
+			mesh->vertexDecl.resize(numVertexDecls);
+			for (VertexDecl& decl : mesh->vertexDecl) {
+				decl.bufferSlot = 0;
+				decl.semantic = blob.readString();
+				decl.byteOffset = blob.read<sint32>();
+				decl.format = UniformType::Enum(blob.read<sint32>());
+			}
+			cacheMeshVertexDeclOffsets(*mesh);
+
+			blob.readRaw(mesh->aabox.min.data, sizeof(float) * 3);
+			blob.readRaw(mesh->aabox.max.data, sizeof(float) * 3);
+
+			const uint32 numBones = readCount();
+			mesh->bones.resize(numBones);
+			for (ModelMeshBone& bone : mesh->bones) {
+				bone.nodeIdx = blob.read<sint32>();
+				bone.offsetMatrix = blob.read<mat4f>();
+			}
+		}
+
+		// The indices in the file are used directly to index the arrays of the model, make sure they are in range.
+		const auto isInRange = [](const int index, const int numElements) -> bool {
+			return index >= 0 && index < numElements;
+		};
+
+		if (model.numNodes() != 0 && !isInRange(rootNodeIndex, model.numNodes())) {
+			throw ModelParseExcept("Root node index is out of range!");
+		}
+
+		for (int iNode = 0; iNode < model.numNodes(); ++iNode) {
+			const ModelNode* const node = model.nodeAt(iNode);
+			for (const int childNodeIndex : node->childNodes) {
+				if (!isInRange(childNodeIndex, model.numNodes())) {
+					throw ModelParseExcept("Child node index is out of range!");
+				}
+			}
+
+			for (const MeshAttachment& attachment : node->meshAttachments) {
+				const bool isMaterialValid = attachment.attachedMaterialIndex == -1 ||
+				                             isInRange(attachment.attachedMaterialIndex, model.numMaterials());
+				if (!isInRange(attachment.attachedMeshIndex, model.numMeshes()) || !isMaterialValid) {
+					throw ModelParseExcept("Mesh attachment index is out of range!");
+				}
+			}
+		}
+
+		for (int iMesh = 0; iMesh < model.numMeshes(); ++iMesh) {
+			for (const ModelMeshBone& bone : model.meshAt(iMesh)->bones) {
+				if (!isInRange(bone.nodeIdx, model.numNodes())) {
+					throw ModelParseExcept("Bone node index is out of range!");
+				}
+			}
+		}
+
+		// Load the animations.
+		const uint32 numAnimations = readCount();
+		for (uint32 iAnim = 0; iAnim < numAnimations; ++iAnim) {
+			ModelAnimation& animation = *model.animationAt(model.makeNewAnim());
+
+			animation.animationName = blob.readString();
+			animation.durationSec = blob.read<float>();
+
+			// The times and the values of each track are stored in separate chunks, exactly like in @KeyFrameTrack,
+			// so each of them is a single copy.
+			const auto loadTrack = [&](auto& track) -> void {
+				const sint32 timesChunkId = blob.read<sint32>();
+				const sint32 valuesChunkId = blob.read<sint32>();
+				if (timesChunkId >= 0) {
+					loadChunkToVector(track.times, timesChunkId);
+					loadChunkToVector(track.values, valuesChunkId);
+					if (track.times.size() != track.values.size()) {
+						throw ModelParseExcept("Keyframe times and values count mismatch!");
+					}
+				}
+			};
+
+			const uint32 numAnimatedNodes = readCount();
+			for (uint32 iAnimatedNode = 0; iAnimatedNode < numAnimatedNodes; ++iAnimatedNode) {
+				const int nodeIndex = blob.read<sint32>();
+				if (!blob.isOk || nodeIndex < 0 || nodeIndex >= model.numNodes()) {
+					throw ModelParseExcept("Animated node index is out of range!");
+				}
+
+				KeyFrames& nodeKeyFrames = animation.getOrAddNodeKeyFrames(nodeIndex);
+				loadTrack(nodeKeyFrames.positionKeyFrames);
+				loadTrack(nodeKeyFrames.rotationKeyFrames);
+				loadTrack(nodeKeyFrames.scalingKeyFrames);
+			}
+
+			if (loadSets.quantizeAnimationRotations) {
+				animation.quantizeRotations();
+			}
+		}
+
+		// Load the collision geometry.
+		const auto loadCollisionMeshes = [&](std::vector<ModelCollisionMesh>& meshes) -> void {
+			const uint32 numCollisionMeshes = readCount();
+			for (uint32 iMesh = 0; iMesh < numCollisionMeshes; ++iMesh) {
+				const sint32 vertsChunkId = blob.read<sint32>();
+				const sint32 indicesChunkId = blob.read<sint32>();
+
+				std::vector<vec3f> verts;
+				loadChunkToVector(verts, vertsChunkId);
+
+				std::vector<int> indices;
+				loadChunkToVector(indices, indicesChunkId);
+
+				meshes.emplace_back(ModelCollisionMesh(std::move(verts), std::move(indices)));
+			}
+		};
+
+		loadCollisionMeshes(model.m_convexHulls);
+		loadCollisionMeshes(model.m_concaveHulls);
+
+		const uint32 numBoxes = readCount();
+		for (uint32 t = 0; t < numBoxes; ++t) {
+			Model_CollisionShapeBox shape;
+			shape.name = blob.readString();
+			shape.transform = readTransform();
+			blob.readRaw(shape.halfDiagonal.data, sizeof(float) * 3);
+			model.m_collisionBoxes.push_back(shape);
+		}
+
+		const uint32 numCapsules = readCount();
+		for (uint32 t = 0; t < numCapsules; ++t) {
+			Model_CollisionShapeCapsule shape;
+			shape.name = blob.readString();
+			shape.transform = readTransform();
+			shape.halfHeight = blob.read<float>();
+			shape.radius = blob.read<float>();
+			model.m_collisionCapsules.push_back(shape);
+		}
+
+		const uint32 numCylinders = readCount();
+		for (uint32 t = 0; t < numCylinders; ++t) {
+			Model_CollisionShapeCylinder shape;
+			shape.name = blob.readString();
+			shape.transform = readTransform();
+			blob.readRaw(shape.halfDiagonal.data, sizeof(float) * 3);
+			model.m_collisionCylinders.push_back(shape);
+		}
+
+		const uint32 numSpheres = readCount();
+		for (uint32 t = 0; t < numSpheres; ++t) {
+			Model_CollisionShapeSphere shape;
+			shape.name = blob.readString();
+			shape.transform = readTransform();
+			shape.radius = blob.read<float>();
+			model.m_collisionSpheres.push_back(shape);
+		}
+
+		if (!blob.isOk) {
+			throw ModelParseExcept("Binary model metadata is truncated!");
+		}
+
+		// The mesh data points in the mapped file, keep it alive as long as the model.
+		if (mappedFile) {
+			model.setMappedFile(std::move(mappedFile));
+		}
+	}
+	catch (const ModelParseExcept& UNUSED(except)) {
+		return false;
+	}
+	catch (...) {
+		return false;
+	}
+
+	return true;
+}
+
 } // namespace sge
@@ -3,17 +3,28 @@
 #include "Model.h"
 #include "sge_core/sgecore_api.h"
 #include "sge_utils/io/IStream.h"
+#include <memory>
 
 namespace sge {
 
+struct MemoryMappedFile;
+
 /// ModelReader is the class that can load the @Model form a file.
 /// All it does it just deserialized the information.
 struct SGE_CORE_API ModelReader {
 	ModelReader() = default;
 	~ModelReader() {}
 
+	/// Loads a model in any of the supported formats (json-headed or binary) from the stream.
+	/// Binary models are read in memory as a whole and the mesh data is copied out of it. Use @loadModelFromFile to
+	/// have the mesh data point directly in the memory mapped file.
 	bool loadModel(const ModelLoadSettings loadSets, IReadStream* const irs, Model& model);
 
+	/// Loads a model in any of the supported formats from the specified file.
+	/// Binary model files are memory mapped, the vertex and index buffers of the meshes point directly in the mapped
+	/// file (see ModelMesh::vertexBufferMapped) instead of being copied.
+	bool loadModelFromFile(const ModelLoadSettings loadSets, const char* const filename, Model& model);
+
   private:
 	struct DataChunkDesc {
 		int chunkId = 0;
@@ -27,6 +38,15 @@ struct SGE_CORE_API ModelReader {
 
 	const DataChunkDesc& FindDataChunkDesc(const int chunkId) const;
 
+	/// Loads a model in the binary model format (see ModelBinaryFormat.h) from memory.
+	/// @param [in] mappedFile if not null, @data is the contents of that file and the mesh data will point in it.
+	bool loadModelBinary(
+	    const ModelLoadSettings& loadSets,
+	    const char* const data,
+	    const size_t sizeBytes,
+	    std::shared_ptr<MemoryMappedFile> mappedFile,
+	    Model& model);
+
 	/// CAUTION: These functions assume that @irs points at the BEGINING of data chunks.
 	template <typename T>
 	void loadDataChunk(std::vector<T>& resultBuffer, const int chunkId);
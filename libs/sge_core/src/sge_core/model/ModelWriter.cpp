@@ -1,5 +1,6 @@
 #include "ModelWriter.h"
 #include "Model.h"
+#include "ModelBinaryFormat.h"
 #include "sge_utils/containers/Range.h"
 #include "sge_utils/io/FileStream.h"
 #include "sge_utils/json/json.h"
@@ -47,12 +48,12 @@ JsonValue* ModelWriter::generateKeyFrames(const KeyFrames& keyfames)
 		int chunkId = -1;
 		char* chunkData = newDataChunkWithSize(chunkSizeBytes, chunkId);
 
-		for (const auto& itr : keyfames.positionKeyFrames) {
-			*(float*)(chunkData) = itr.first;
+		for (int iKey = 0; iKey < numKeyFrames; ++iKey) {
+			*(float*)(chunkData) = keyfames.positionKeyFrames.times[iKey];
 			chunkData += sizeof(float);
 
-			*(vec3f*)(chunkData) = itr.second;
-			chunkData += sizeof(itr.second);
+			*(vec3f*)(chunkData) = keyfames.positionKeyFrames.values[iKey];
+			chunkData += sizeof(vec3f);
 		}
 
 		jKeyFrames->setMember("positionKeyFrames_chunkId", jvb(chunkId));
@@ -65,12 +66,13 @@ JsonValue* ModelWriter::generateKeyFrames(const KeyFrames& keyfames)
 		int chunkId = -1;
 		char* chunkData = newDataChunkWithSize(chunkSizeBytes, chunkId);
 
-		for (const auto& itr : keyfames.rotationKeyFrames) {
-			*(float*)(chunkData) = itr.first;
+		// The file format always stores the full rotations.
+		for (int iKey = 0; iKey < numKeyFrames; ++iKey) {
+			*(float*)(chunkData) = keyfames.rotationKeyFrames.times[iKey];
 			chunkData += sizeof(float);
 
-			*(quatf*)(chunkData) = itr.second;
-			chunkData += sizeof(itr.second);
+			*(quatf*)(chunkData) = keyfames.getRotationKeyValue(iKey);
+			chunkData += sizeof(quatf);
 		}
 
 		jKeyFrames->setMember("rotationKeyFrames_chunkId", jvb(chunkId));
@@ -83,12 +85,12 @@ JsonValue* ModelWriter::generateKeyFrames(const KeyFrames& keyfames)
 		int chunkId = -1;
 		char* chunkData = newDataChunkWithSize(chunkSizeBytes, chunkId);
 
-		for (const auto& itr : keyfames.scalingKeyFrames) {
-			*(float*)(chunkData) = itr.first;
+		for (int iKey = 0; iKey < numKeyFrames; ++iKey) {
+			*(float*)(chunkData) = keyfames.scalingKeyFrames.times[iKey];
 			chunkData += sizeof(float);
 
-			*(vec3f*)(chunkData) = itr.second;
-			chunkData += sizeof(itr.second);
+			*(vec3f*)(chunkData) = keyfames.scalingKeyFrames.values[iKey];
+			chunkData += sizeof(vec3f);
 		}
 
 		jKeyFrames->setMember("scalingKeyFrames_chunkId", jvb(chunkId));
@@ -117,11 +119,16 @@ void ModelWriter::writeAnimations()
 		// Serialize the actual key frames.
 		JsonValue* jAllNodesKeyFrames = jAnim->setMember("perNodeKeyFrames", jvb(JID_ARRAY));
 
-		for (const auto& itrPerNodeKeyframes : animation.perNodeKeyFrames) {
+		for (int iNode = 0; iNode < int(animation.perNodeKeyFrames.size()); ++iNode) {
+			const KeyFrames& nodeKeyFrames = animation.perNodeKeyFrames[iNode];
+			if (nodeKeyFrames.hasAnyKeyFrames() == false) {
+				continue;
+			}
+
 			JsonValue* jNodeKeyFrames = jvb(JID_MAP);
 
-			jNodeKeyFrames->setMember("nodeIndex", jvb(itrPerNodeKeyframes.first));
-			JsonValue* jKeyFrames = generateKeyFrames(itrPerNodeKeyframes.second);
+			jNodeKeyFrames->setMember("nodeIndex", jvb(iNode));
+			JsonValue* jKeyFrames = generateKeyFrames(nodeKeyFrames);
 			jNodeKeyFrames->setMember("keyFrames", jKeyFrames);
 
 			jAllNodesKeyFrames->arrPush(jNodeKeyFrames);
@@ -234,15 +241,17 @@ void ModelWriter::writeMeshes()
 		JsonValue* jMesh = jMeshes->arrPush(jvb(JID_MAP));
 
 		const ModelMesh* mesh = model->meshAt(iMesh);
+		const span<const char> vertexBufferData = mesh->getVertexBufferData();
+		const span<const char> indexBufferData = mesh->getIndexBufferData();
 
 		// Write the vertex/index buffers chunks.
-		if (mesh->vertexBufferRaw.size()) {
-			const int vertexBufferChunkId = newChunkFromStdVector(mesh->vertexBufferRaw);
+		if (vertexBufferData.size()) {
+			const int vertexBufferChunkId = newDataChunkFromPtr(vertexBufferData.data(), vertexBufferData.size());
 			jMesh->setMember("vertexDataChunkId", jvb(vertexBufferChunkId));
 		}
 
-		if (mesh->indexBufferRaw.size()) {
-			const int indexBufferChunkId = newChunkFromStdVector(mesh->indexBufferRaw);
+		if (indexBufferData.size()) {
+			const int indexBufferChunkId = newDataChunkFromPtr(indexBufferData.data(), indexBufferData.size());
 			jMesh->setMember("indexDataChunkId", jvb(indexBufferChunkId));
 		}
 
@@ -439,4 +448,251 @@ bool ModelWriter::write(const Model& modelToWrite, const char* const filename)
 
 	return write(modelToWrite, &fws);
 }
+
+void ModelWriter::writeBinaryKeyFrames(ModelBinaryBlobWriter& blob, const KeyFrames& keyFrames)
+{
+	// Each track is written as two chunks, the times and the values, so they could be loaded with a single copy.
+	if (!keyFrames.positionKeyFrames.empty()) {
+		blob.write(sint32(newChunkFromStdVector(keyFrames.positionKeyFrames.times)));
+		blob.write(sint32(newChunkFromStdVector(keyFrames.positionKeyFrames.values)));
+	}
+	else {
+		blob.write(sint32(-1));
+		blob.write(sint32(-1));
+	}
+
+	if (!keyFrames.rotationKeyFrames.empty()) {
+		blob.write(sint32(newChunkFromStdVector(keyFrames.rotationKeyFrames.times)));
+
+		if (keyFrames.hasQuantizedRotations()) {
+			// The file format always stores the full rotations.
+			int valuesChunkId = -1;
+			quatf* const values =
+			    (quatf*)newDataChunkWithSize(keyFrames.rotationKeyFrames.size() * sizeof(quatf), valuesChunkId);
+			for (int iKey = 0; iKey < keyFrames.rotationKeyFrames.size(); ++iKey) {
+				values[iKey] = keyFrames.getRotationKeyValue(iKey);
+			}
+			blob.write(sint32(valuesChunkId));
+		}
+		else {
+			blob.write(sint32(newChunkFromStdVector(keyFrames.rotationKeyFrames.values)));
+		}
+	}
+	else {
+		blob.write(sint32(-1));
+		blob.write(sint32(-1));
+	}
+
+	if (!keyFrames.scalingKeyFrames.empty()) {
+		blob.write(sint32(newChunkFromStdVector(keyFrames.scalingKeyFrames.times)));
+		blob.write(sint32(newChunkFromStdVector(keyFrames.scalingKeyFrames.values)));
+	}
+	else {
+		blob.write(sint32(-1));
+		blob.write(sint32(-1));
+	}
+}
+
+void ModelWriter::writeBinaryMetadata(ModelBinaryBlobWriter& blob)
+{
+	const auto writeTransform = [&blob](const transf3d& tr) -> void {
+		blob.writeRaw(tr.p.data, sizeof(float) * 3);
+		blob.writeRaw(tr.r.data, sizeof(float) * 4);
+		blob.writeRaw(tr.s.data, sizeof(float) * 3);
+	};
+
+	// Nodes.
+	blob.write(sint32(model->getRootNodeIndex()));
+	blob.write(uint32(model->numNodes()));
+	for (int iNode : RangeInt(model->numNodes())) {
+		const ModelNode* node = model->nodeAt(iNode);
+
+		blob.writeString(node->name);
+		writeTransform(node->staticLocalTransform);
+		blob.write(node->limbLength);
+
+		blob.write(uint32(node->meshAttachments.size()));
+		for (const MeshAttachment& attachment : node->meshAttachments) {
+			blob.write(sint32(attachment.attachedMeshIndex));
+			blob.write(sint32(attachment.attachedMaterialIndex));
+		}
+
+		blob.write(uint32(node->childNodes.size()));
+		for (const int childIndex : node->childNodes) {
+			blob.write(sint32(childIndex));
+		}
+	}
+
+	// Materials.
+	blob.write(uint32(model->numMaterials()));
+	for (const int iMtl : RangeInt(model->numMaterials())) {
+		const ModelMaterial* mtl = model->materialAt(iMtl);
+		blob.writeString(mtl->name);
+		blob.writeString(mtl->assetForThisMaterial);
+	}
+
+	// Meshes.
+	blob.write(uint32(model->numMeshes()));
+	for (const int iMesh : RangeInt(model->numMeshes())) {
+		const ModelMesh* mesh = model->meshAt(iMesh);
+		const span<const char> vertexBufferData = mesh->getVertexBufferData();
+		const span<const char> indexBufferData = mesh->getIndexBufferData();
+
+		blob.writeString(mesh->name);
+		blob.write(sint32(mesh->primitiveTopology));
+		blob.write(sint32(mesh->vbByteOffset));
+		blob.write(sint32(mesh->ibByteOffset));
+		blob.write(sint32(mesh->ibFmt));
+		blob.write(sint32(mesh->numElements));
+		blob.write(sint32(mesh->numVertices));
+		blob.write(sint32(
+		    vertexBufferData.empty() ? -1 : newDataChunkFromPtr(vertexBufferData.data(), vertexBufferData.size())));
+		blob.write(
+		    sint32(indexBufferData.empty() ? -1 : newDataChunkFromPtr(indexBufferData.data(), indexBufferData.size())));
+
+		blob.write(uint32(mesh->vertexDecl.size()));
+		for (const VertexDecl& decl : mesh->vertexDecl) {
+			blob.writeString(decl.semantic);
+			blob.write(sint32(decl.byteOffset));
+			blob.write(sint32(decl.format));
+		}
+
+		blob.writeRaw(mesh->aabox.min.data, sizeof(float) * 3);
+		blob.writeRaw(mesh->aabox.max.data, sizeof(float) * 3);
+
+		blob.write(uint32(mesh->bones.size()));
+		for (const ModelMeshBone& bone : mesh->bones) {
+			blob.write(sint32(bone.nodeIdx));
+			blob.write(bone.offsetMatrix);
+		}
+	}
+
+	// Animations.
+	blob.write(uint32(model->numAnimations()));
+	for (int iAnim : RangeInt(model->numAnimations())) {
+		const ModelAnimation& animation = *model->animationAt(iAnim);
+
+		blob.writeString(animation.animationName);
+		blob.write(animation.durationSec);
+
+		uint32 numAnimatedNodes = 0;
+		for (const KeyFrames& nodeKeyFrames : animation.perNodeKeyFrames) {
+			numAnimatedNodes += nodeKeyFrames.hasAnyKeyFrames() ? 1 : 0;
+		}
+
+		blob.write(numAnimatedNodes);
+		for (int iNode = 0; iNode < int(animation.perNodeKeyFrames.size()); ++iNode) {
+			const KeyFrames& nodeKeyFrames = animation.perNodeKeyFrames[iNode];
+			if (nodeKeyFrames.hasAnyKeyFrames()) {
+				blob.write(sint32(iNode));
+				writeBinaryKeyFrames(blob, nodeKeyFrames);
+			}
+		}
+	}
+
+	// Collision geometry.
+	const auto writeCollisionMeshes = [&](const std::vector<ModelCollisionMesh>& meshes) -> void {
+		blob.write(uint32(meshes.size()));
+		for (const ModelCollisionMesh& mesh : meshes) {
+			blob.write(sint32(newChunkFromStdVector(mesh.vertices)));
+			blob.write(sint32(newChunkFromStdVector(mesh.indices)));
+		}
+	};
+
+	writeCollisionMeshes(model->m_convexHulls);
+	writeCollisionMeshes(model->m_concaveHulls);
+
+	blob.write(uint32(model->m_collisionBoxes.size()));
+	for (const Model_CollisionShapeBox& shape : model->m_collisionBoxes) {
+		blob.writeString(shape.name);
+		writeTransform(shape.transform);
+		blob.writeRaw(shape.halfDiagonal.data, sizeof(float) * 3);
+	}
+
+	blob.write(uint32(model->m_collisionCapsules.size()));
+	for (const Model_CollisionShapeCapsule& shape : model->m_collisionCapsules) {
+		blob.writeString(shape.name);
+		writeTransform(shape.transform);
+		blob.write(shape.halfHeight);
+		blob.write(shape.radius);
+	}
+
+	blob.write(uint32(model->m_collisionCylinders.size()));
+	for (const Model_CollisionShapeCylinder& shape : model->m_collisionCylinders) {
+		blob.writeString(shape.name);
+		writeTransform(shape.transform);
+		blob.writeRaw(shape.halfDiagonal.data, sizeof(float) * 3);
+	}
+
+	blob.write(uint32(model->m_collisionSpheres.size()));
+	for (const Model_CollisionShapeSphere& shape : model->m_collisionSpheres) {
+		blob.writeString(shape.name);
+		writeTransform(shape.transform);
+		blob.write(shape.radius);
+	}
+}
+
+bool ModelWriter::writeBinary(const Model& modelToWrite, IWriteStream* iws)
+{
+	if (iws == nullptr) {
+		return false;
+	}
+
+	this->model = &modelToWrite;
+	dataChunks.clear();
+
+	// The 1st chunk is always the metadata. Its data is known after all other chunks are allocated.
+	ModelBinaryBlobWriter metadata;
+	dataChunks.emplace_back(DataChunk(kModelBinaryMetadataChunkId, nullptr, 0));
+	writeBinaryMetadata(metadata);
+	dataChunks[kModelBinaryMetadataChunkId].data = metadata.data.data();
+	dataChunks[kModelBinaryMetadataChunkId].sizeBytes = metadata.data.size();
+
+	// Compute where each chunk is going to be in the file.
+	std::vector<ModelBinaryChunkDesc> chunkTable(dataChunks.size());
+	uint64 fileOffset = sizeof(ModelBinaryHeader);
+	for (size_t iChunk = 0; iChunk < dataChunks.size(); ++iChunk) {
+		const uint64 alignment = kModelBinaryChunkAlignment;
+		fileOffset = (fileOffset + alignment - 1) / alignment * alignment;
+		chunkTable[iChunk].byteOffset = fileOffset;
+		chunkTable[iChunk].sizeBytes = dataChunks[iChunk].sizeBytes;
+		fileOffset += dataChunks[iChunk].sizeBytes;
+	}
+
+	ModelBinaryHeader header;
+	memcpy(header.magic, kModelBinaryMagic, sizeof(header.magic));
+	header.version = kModelBinaryVersion;
+	header.numChunks = uint32(dataChunks.size());
+	header.chunkTableByteOffset = fileOffset;
+
+	iws->write((const char*)&header, sizeof(header));
+
+	const char padding[kModelBinaryChunkAlignment] = {0};
+	uint64 writtenBytes = sizeof(ModelBinaryHeader);
+	for (size_t iChunk = 0; iChunk < dataChunks.size(); ++iChunk) {
+		iws->write(padding, size_t(chunkTable[iChunk].byteOffset - writtenBytes));
+		iws->write((const char*)dataChunks[iChunk].data, dataChunks[iChunk].sizeBytes);
+		writtenBytes = chunkTable[iChunk].byteOffset + chunkTable[iChunk].sizeBytes;
+	}
+
+	iws->write((const char*)chunkTable.data(), chunkTable.size() * sizeof(chunkTable[0]));
+
+	dataChunks.clear();
+	return true;
+}
+
+bool ModelWriter::writeBinary(const Model& modelToWrite, const char* const filename)
+{
+	if (filename == nullptr) {
+		return false;
+	}
+
+	FileWriteStream fws;
+	if (!fws.open(filename)) {
+		sgeAssert(false);
+		return false;
+	}
+
+	return writeBinary(modelToWrite, &fws);
+}
 } // namespace sge
@@ -8,6 +8,7 @@ namespace sge {
 
 struct Model;
 struct KeyFrames;
+struct ModelBinaryBlobWriter;
 
 class SGE_CORE_API ModelWriter {
   public:
@@ -32,6 +33,11 @@ class SGE_CORE_API ModelWriter {
 	bool write(const Model& modelToWrite, IWriteStream* iws);
 	bool write(const Model& modelToWrite, const char* const filename);
 
+	/// Writes the model in the binary model format (see ModelBinaryFormat.h).
+	/// These files load faster as they can be memory mapped and have no json to parse.
+	bool writeBinary(const Model& modelToWrite, IWriteStream* iws);
+	bool writeBinary(const Model& modelToWrite, const char* const filename);
+
 
   private:
 	// Returns the chunk id.
@@ -55,6 +61,10 @@ class SGE_CORE_API ModelWriter {
 	/// @brief Generates the json and allocated a data chunks for the specified keyframes.
 	JsonValue* generateKeyFrames(const KeyFrames& keyfames);
 
+	/// Writes the metadata chunk of the binary format and allocates the data chunks that it references.
+	void writeBinaryMetadata(ModelBinaryBlobWriter& blob);
+	void writeBinaryKeyFrames(ModelBinaryBlobWriter& blob, const KeyFrames& keyFrames);
+
 	JsonValueBuffer jvb;
 	std::vector<DataChunk> dataChunks; // A list of the data chunks that will end up written to the file.
 	JsonValue* root;                   // The file header json element.
@@ -5,9 +5,20 @@
 #include "sge_utils/hash/hash_combine.h"
 #include "sge_utils/io/FileStream.h"
 #include "sge_utils/text/format.h"
+#include "sge_utils/threading/ThreadPool.h"
+#include "sge_utils/time/Timer.h"
+#include <algorithm>
 
 namespace sge {
 
+/// The totals of all shader permutations compiled so far, see ShadingProgramPermuator::getCompilationStats().
+static ShadingProgramPermuator::CompilationStats g_shaderCompilationStats;
+
+ShadingProgramPermuator::CompilationStats ShadingProgramPermuator::getCompilationStats()
+{
+	return g_shaderCompilationStats;
+}
+
 bool ShadingProgramPermuator::createFromFile(
     SGEDevice* sgedev,
     const char* const filename,
@@ -90,8 +101,11 @@ bool ShadingProgramPermuator::createInternal(
 	if (kSgeRendApi == SGERendApi_D3D && !precompiledCacheFilePrefix.empty()) {
 		precompiledCacheFilePrefix += ".d3d";
 	}
+	else if (kSgeRendApi == SGERendApi_OpenGL && !precompiledCacheFilePrefix.empty()) {
+		precompiledCacheFilePrefix += ".gl";
+	}
 	else {
-		// Force shader cache to be used only with D3D, it is not implemented for other APIs.
+		// Force shader cache to be used only with D3D and OpenGL, it is not implemented for other APIs.
 		precompiledCacheFilePrefix.clear();
 	}
 
@@ -105,25 +119,68 @@ bool ShadingProgramPermuator::createInternal(
 
 	bool hadErrors = false;
 
-	const bool isCacheLoadedAndValid = isCacheLoaded && programCompiledCache.verifyThatCacheIsUpDoDate();
+	const bool isCacheLoadedAndValid = isCacheLoaded && programCompiledCache.perPermutBytecode.size() == numPerm &&
+	                                   programCompiledCache.verifyThatCacheIsUpDoDate();
 	if (isCacheLoadedAndValid) {
 		sgeLogCheck("For %s a vaild shader cache will be used.", shaderCodeFileName);
 
-		for (int iPerm = 0; iPerm < compileTimeOptionsPermutator.getAllPermunations().size(); ++iPerm) {
-			const auto& permCache = programCompiledCache.perPermutBytecode[iPerm];
+		const double loadStartTime = Timer::now_seconds();
+		int numProgramBinariesUsed = 0;
+		bool hasRejectedProgramBinaries = false;
 
+		for (int iPerm = 0; iPerm < numPerm; ++iPerm) {
+			auto& permCache = programCompiledCache.perPermutBytecode[iPerm];
+			perPermutationShadingProg[iPerm].shadingProgram = sgedev->requestResource<ShadingProgram>();
 
-			GpuHandle<Shader> vs = sgedev->requestResource<Shader>();
-			vs->createFromNativeBytecode(ShaderType::VertexShader, permCache.vsBytecode);
+			if (permCache.programBinary.empty() == false) {
+				// The API could load the whole linked program. The bytecode is the native code of the shaders
+				// and it is used only if the driver rejects the program binary.
+				const std::string vsCode(permCache.vsBytecode.begin(), permCache.vsBytecode.end());
+				const std::string psCode(permCache.psBytecode.begin(), permCache.psBytecode.end());
+
+				bool usedProgramBinary = false;
+				const CreateShaderResult createResult =
+				    perPermutationShadingProg[iPerm].shadingProgram->createFromProgramBinary(
+				        permCache.programBinary, vsCode.c_str(), psCode.c_str(), usedProgramBinary);
+
+				if (createResult.succeeded == false) {
+					perPermutationShadingProg[iPerm].debugCompilationErrors = createResult.errors;
+					sgeLogError("Shader Compilation Failed:\n%s", createResult.errors.c_str());
+					hadErrors = true;
+				}
+				else if (usedProgramBinary) {
+					numProgramBinariesUsed++;
+				}
+				else {
+					// Usually happens when the driver gets updated, grab the new binary so the cache could be updated.
+					permCache.programBinary.clear();
+					perPermutationShadingProg[iPerm].shadingProgram->getProgramBinary(permCache.programBinary);
+					hasRejectedProgramBinaries = true;
+				}
+			}
+			else {
+				GpuHandle<Shader> vs = sgedev->requestResource<Shader>();
+				vs->createFromNativeBytecode(ShaderType::VertexShader, permCache.vsBytecode);
 
-			GpuHandle<Shader> ps = sgedev->requestResource<Shader>();
-			ps->createFromNativeBytecode(ShaderType::PixelShader, permCache.psBytecode);
+				GpuHandle<Shader> ps = sgedev->requestResource<Shader>();
+				ps->createFromNativeBytecode(ShaderType::PixelShader, permCache.psBytecode);
 
-			perPermutationShadingProg[iPerm].shadingProgram = sgedev->requestResource<ShadingProgram>();
-			perPermutationShadingProg[iPerm].shadingProgram->create(vs, ps);
+				perPermutationShadingProg[iPerm].shadingProgram->create(vs, ps);
+			}
 		}
 
-		hadErrors = false;
+		if (hasRejectedProgramBinaries && !hadErrors) {
+			sgeLogWarn(
+			    "For %s some program binaries were rejected by the driver, updating the cache.", shaderCodeFileName);
+			programCompiledCache.saveToFile(precompiledCacheFilePrefix.c_str());
+		}
+
+		sgeLogInfo(
+		    "Loaded %d shader permutations of %s from the cache in %.3f seconds (%d of them from program binaries).\n",
+		    numPerm,
+		    shaderCodeFileName,
+		    Timer::now_seconds() - loadStartTime,
+		    numProgramBinariesUsed);
 	}
 	else {
 		if (!precompiledCacheFilePrefix.empty()) {
@@ -132,29 +189,63 @@ bool ShadingProgramPermuator::createInternal(
 		}
 
 		// No cache compile for real.
-		std::string shaderCodeFull;
-		size_t shaderCodeSize = strlen(shaderCode);
-		for (int iPerm = 0; iPerm < compileTimeOptionsPermutator.getAllPermunations().size(); ++iPerm) {
+		// The compilation is done in two steps. First the code of every permutation is preprocessed and translated
+		// to the native shading language. This doesn't touch the graphics API so it is done on multiple threads.
+		// After that the API objects are created here, on the rendering thread.
+		const double compileStartTime = Timer::now_seconds();
+
+		struct TranslatedPermutation {
+			CreateShaderResult translateResult;
+			std::string vsNativeCode;
+			std::string psNativeCode;
+			std::set<std::string> includedFiles;
+		};
+
+		std::vector<TranslatedPermutation> translatedPerms(numPerm);
+		const std::string shaderCodeStr = shaderCode;
+
+		const auto translatePermutation = [&](const int iPerm) -> void {
 			const auto& perm = compileTimeOptionsPermutator.getAllPermunations()[iPerm];
 
 			// Construct a string setting the values for this permutation.
-			std::string macrosToPreapend;
+			std::string shaderCodeFull;
 			for (int iOpt = 0; iOpt < compileTimeOptions.size(); ++iOpt) {
 				const OptionPermuataor::OptionDesc& desc = compileTimeOptions[iOpt];
-				macrosToPreapend += "#define " + desc.name + " " + desc.possibleValues[perm[iOpt]] + "\n";
+				shaderCodeFull += "#define " + desc.name + " " + desc.possibleValues[perm[iOpt]] + "\n";
+			}
+			shaderCodeFull += shaderCodeStr;
+
+			TranslatedPermutation& translated = translatedPerms[iPerm];
+			translated.translateResult = ShadingProgram::translateCustomHLSL(
+			    shaderCodeFull.c_str(),
+			    shaderCodeFull.c_str(),
+			    translated.vsNativeCode,
+			    translated.psNativeCode,
+			    &translated.includedFiles);
+		};
+
+		ThreadPool* const threadPool = getCore()->getWorkerThreadPool();
+		threadPool->parallelFor(numPerm, 1, [&](int begin, int end) -> void {
+			for (int iPerm = begin; iPerm < end; ++iPerm) {
+				translatePermutation(iPerm);
 			}
+		});
+
+		const double translateEndTime = Timer::now_seconds();
+
+		// Create the API objects.
+		for (int iPerm = 0; iPerm < numPerm; ++iPerm) {
+			TranslatedPermutation& translated = translatedPerms[iPerm];
+			dependantFilesForShaderCachemaking.insert(translated.includedFiles.begin(), translated.includedFiles.end());
 
 			perPermutationShadingProg[iPerm].shadingProgram = sgedev->requestResource<ShadingProgram>();
 			perPermutationShadingProg[iPerm].debugCompilationErrors.clear();
 
-			shaderCodeFull.clear();
-			shaderCodeFull += macrosToPreapend;
-			shaderCodeFull.append(shaderCode, shaderCodeSize);
-
-			// Compile the program and if succeeded, grab a reflection and cache the requested uniform locations.
-			const CreateShaderResult programCreateResult =
-			    perPermutationShadingProg[iPerm].shadingProgram->createFromCustomHLSL(
-			        shaderCodeFull.c_str(), shaderCodeFull.c_str(), &dependantFilesForShaderCachemaking);
+			CreateShaderResult programCreateResult = translated.translateResult;
+			if (programCreateResult.succeeded) {
+				programCreateResult = perPermutationShadingProg[iPerm].shadingProgram->createFromNativeCode(
+				    translated.vsNativeCode.c_str(), translated.psNativeCode.c_str());
+			}
 
 			if (programCreateResult.succeeded == false) {
 				perPermutationShadingProg[iPerm].debugCompilationErrors = programCreateResult.errors;
@@ -162,6 +253,21 @@ bool ShadingProgramPermuator::createInternal(
 				hadErrors = true;
 			}
 		}
+
+		const double compileEndTime = Timer::now_seconds();
+
+		g_shaderCompilationStats.numPermutations += numPerm;
+		g_shaderCompilationStats.wallTimeSeconds += compileEndTime - compileStartTime;
+
+		sgeLogInfo(
+		    "Compiled %d shader permutations of %s in %.3f seconds (translation on %d threads %.3f seconds, API "
+		    "objects creation %.3f seconds).\n",
+		    numPerm,
+		    shaderCodeFileName,
+		    compileEndTime - compileStartTime,
+		    std::min(numPerm, threadPool->getNumWorkers()),
+		    translateEndTime - compileStartTime,
+		    compileEndTime - translateEndTime);
 	}
 
 	// Cache the requested uniforms locations.
@@ -208,7 +314,10 @@ void ShadingProgramPermuator::generateShadingProgramsCompilationCache(const char
 		psBytecode.clear();
 		perm.shadingProgram->getPixelShader()->getCreationBytecode(psBytecode);
 
-		cacheFile.perPermutBytecode.push_back({std::move(vsBytecode), std::move(psBytecode)});
+		std::vector<char> programBinary;
+		perm.shadingProgram->getProgramBinary(programBinary);
+
+		cacheFile.perPermutBytecode.push_back({std::move(vsBytecode), std::move(psBytecode), std::move(programBinary)});
 	}
 
 	cacheFile.saveToFile(precompiledCacheFile);
@@ -54,11 +54,18 @@ struct SGE_CORE_API ShadingProgramPermuator {
 		}
 	};
 
+	/// Statistics about the shader permutations compiled (without using a compilation cache) so far.
+	struct CompilationStats {
+		int numPermutations = 0;
+		double wallTimeSeconds = 0.0;
+	};
+
   public:
 	/// Create a shader by using the specified filename as the root code.
 	/// Additional code may be #include-ed (currently force to core_shaders/ directory).
 	/// if a valid @precompiledCacheFile exists the shader bytecode is going to get loaded from there
-	/// avoiding the need to call the slow D3DCompile every time. If the cachefile doesn't exists a new one will be
+	/// avoiding the need to call the slow D3DCompile every time. On OpenGL the cache holds the translated GLSL code
+	/// and the linked program binaries (if the driver supports them). If the cachefile doesn't exists a new one will be
 	/// created. if you don't wanna use caching just pass nullptr for @precompiledCacheFile.
 	bool createFromFile(
 	    SGEDevice* sgedev,
@@ -80,6 +87,11 @@ struct SGE_CORE_API ShadingProgramPermuator {
 
 
 	const OptionPermuataor getCompileTimeOptionsPerm() const { return compileTimeOptionsPermutator; }
+
+	/// Returns the total number of shader permutations compiled by all permutators and the time it took.
+	/// Used to report how much of the startup time is spent compiling shaders.
+	/// Should be called on the rendering thread.
+	static CompilationStats getCompilationStats();
 	const std::vector<Permutation>& getShadersPerPerm() const { return perPermutationShadingProg; }
 
   private:
@@ -1,15 +1,80 @@
 #include "ShadingProgramPermuatorCache.h"
-#include "sge_utils/base64/base64.h"
 #include "sge_utils/hash/hash_combine.h"
 #include "sge_utils/io/FileStream.h"
-#include "sge_utils/json/json.h"
 #include "sge_utils/text/Path.h"
 #include "sge_utils/text/format.h"
 
 #include "sge_renderer/renderer/renderer.h"
+#include <cstring>
 
 namespace sge {
 
+/// The cache file layout. All values are in the native byte order:
+///   char[8] magic, uint32 version
+///   uint32 numSourceFiles, then for each: [string filename][uint32 hash]
+///   uint32 numPermutations, then for each: [blob vsBytecode][blob psBytecode][blob programBinary]
+/// Strings and blobs are stored as uint32 size followed by the bytes.
+static constexpr char kShaderCacheMagic[8] = {'S', 'G', 'E', 'S', 'H', 'D', 'C', '\0'};
+static constexpr uint32 kShaderCacheVersion = 1;
+
+namespace {
+	struct ShaderCacheWriter {
+		void writeU32(const uint32 value) { writeRaw(&value, sizeof(value)); }
+
+		void writeBlob(const char* const src, const size_t sizeBytes)
+		{
+			writeU32(uint32(sizeBytes));
+			writeRaw(src, sizeBytes);
+		}
+
+		void writeRaw(const void* const src, const size_t sizeBytes)
+		{
+			const char* const srcBytes = (const char*)src;
+			data.insert(data.end(), srcBytes, srcBytes + sizeBytes);
+		}
+
+		std::vector<char> data;
+	};
+
+	/// Bounds checked reading of the data written by ShaderCacheWriter, @isOk is set to false if the data is too short.
+	struct ShaderCacheReader {
+		uint32 readU32()
+		{
+			uint32 value = 0;
+			readRaw(&value, sizeof(value));
+			return value;
+		}
+
+		template <typename TContainer>
+		void readBlob(TContainer& outBlob)
+		{
+			const uint32 sizeBytes = readU32();
+			if (!isOk || data.size() - offset < sizeBytes) {
+				isOk = false;
+				return;
+			}
+
+			outBlob.assign(data.begin() + offset, data.begin() + offset + sizeBytes);
+			offset += sizeBytes;
+		}
+
+		void readRaw(void* const dest, const size_t sizeBytes)
+		{
+			if (!isOk || data.size() - offset < sizeBytes) {
+				isOk = false;
+				return;
+			}
+
+			memcpy(dest, data.data() + offset, sizeBytes);
+			offset += sizeBytes;
+		}
+
+		const std::vector<char>& data;
+		size_t offset = 0;
+		bool isOk = true;
+	};
+} // namespace
+
 bool ShadingProgramPermuatorCache::saveToFile(const char* cacheFilename) const
 {
 	std::string fileDir = extractFileDir(cacheFilename, true);
@@ -17,99 +82,87 @@ bool ShadingProgramPermuatorCache::saveToFile(const char* cacheFilename) const
 		createDirectory(fileDir.c_str());
 	}
 
-	JsonValueBuffer jvb;
-
-	JsonValue* jRoot = jvb(JID_MAP);
-	JsonValue* jSrcFiles = jRoot->setMember("sourceFiles", jvb(JID_ARRAY));
+	ShaderCacheWriter writer;
+	writer.writeRaw(kShaderCacheMagic, sizeof(kShaderCacheMagic));
+	writer.writeU32(kShaderCacheVersion);
 
-	// Find all files that are used for compiling the shader and compute a hash based on their contents.
+	// The hashes of the contents of all files used for compiling the shader.
 	// Later this hash is going to be used to see if the file has been changed or not.
+	writer.writeU32(uint32(sourceFileContentsHash.size()));
 	for (const auto& fileNameHashPair : sourceFileContentsHash) {
-		JsonValue* jFileHashPair = jSrcFiles->arrPush(jvb(JID_MAP));
-		jFileHashPair->setMember("file", jvb(fileNameHashPair.first));
-		jFileHashPair->setMember("hash", jvb(fileNameHashPair.second));
+		writer.writeBlob(fileNameHashPair.first.data(), fileNameHashPair.first.size());
+		writer.writeU32(fileNameHashPair.second);
 	}
 
-	// Grab the bytecode for each shading program shaders,
-	// and encode it to base64 (in order for it to be a valid json string).
-	JsonValue* jPermutationsBytecodes = jRoot->setMember("shaderBytecodesPerPermutation", jvb(JID_ARRAY));
+	writer.writeU32(uint32(perPermutBytecode.size()));
 	for (const ShadingProgramByteCode& bytecode : perPermutBytecode) {
-		JsonValue* jShadeProgByteCode = jPermutationsBytecodes->arrPush(jvb(JID_MAP));
-
-		std::string vsDataEncoded =
-		    base64Encode(bytecode.vsBytecode.data(), bytecode.vsBytecode.size() * sizeof(bytecode.vsBytecode[0]));
-		std::string psDataEncoded =
-		    base64Encode(bytecode.psBytecode.data(), bytecode.psBytecode.size() * sizeof(bytecode.psBytecode[0]));
+		writer.writeBlob(bytecode.vsBytecode.data(), bytecode.vsBytecode.size());
+		writer.writeBlob(bytecode.psBytecode.data(), bytecode.psBytecode.size());
+		writer.writeBlob(bytecode.programBinary.data(), bytecode.programBinary.size());
+	}
 
-		jShadeProgByteCode->setMember("vsDataEncoded", jvb(vsDataEncoded));
-		jShadeProgByteCode->setMember("psDataEncoded", jvb(psDataEncoded));
+	FileWriteStream fws;
+	if (fws.open(cacheFilename) == false) {
+		return false;
 	}
 
-	// Write the created json to a file.
-	JsonWriter jw;
-	bool succeeded = jw.WriteInFile(cacheFilename, jRoot, true);
+	const bool succeeded = fws.write(writer.data.data(), writer.data.size()) == writer.data.size();
 	return succeeded;
 }
 
 bool ShadingProgramPermuatorCache::loadCacheFile(const char* cacheFilename)
 {
-	try {
-		// Reset the structure to its default state.
-		*this = ShadingProgramPermuatorCache();
-
-		if (isStringEmpty(cacheFilename)) {
-			return false;
-		}
+	// Reset the structure to its default state.
+	*this = ShadingProgramPermuatorCache();
 
-		FileReadStream frs;
-		if (frs.open(cacheFilename) == false) {
-			return false;
-		}
-
-		JsonParser jp;
-		if (jp.parse(&frs) == false) {
-			sgeAssert(false && "The shader cache file seems to be broken.");
-			return false;
-		}
+	if (isStringEmpty(cacheFilename)) {
+		return false;
+	}
 
-		const JsonValue* jRoot = jp.getRoot();
+	std::vector<char> fileData;
+	if (FileReadStream::readFile(cacheFilename, fileData) == false) {
+		return false;
+	}
 
-		// Load the file hashes.
-		const JsonValue& jSrcFiles = jRoot->getMemberOrThrow("sourceFiles");
-		for (int iFilePair = 0; iFilePair < jSrcFiles.arrSize(); ++iFilePair) {
-			const JsonValue* jFileHashPair = jSrcFiles.arrAt(iFilePair);
-			std::string file = jFileHashPair->getMemberOrThrow("file").GetStringOrThrow();
-			unsigned hash = (unsigned)jFileHashPair->getMemberOrThrow("hash").getNumberAs<int>();
+	ShaderCacheReader reader{fileData};
 
-			this->sourceFileContentsHash[file] = hash;
-		}
-
-		// Load the shaders bytecode.
-		const JsonValue& jPermutationsBytecodes = jRoot->getMemberOrThrow("shaderBytecodesPerPermutation");
-		for (int iPerm = 0; iPerm < jPermutationsBytecodes.arrSize(); ++iPerm) {
-			const JsonValue* jShadeProgByteCode = jPermutationsBytecodes.arrAt(iPerm);
-			std::string vsBytecodeEncoded = jShadeProgByteCode->getMemberOrThrow("vsDataEncoded").GetStringOrThrow();
-			std::string psBytecodeEncoded = jShadeProgByteCode->getMemberOrThrow("psDataEncoded").GetStringOrThrow();
+	// Files in an older format are not an error, they are just going to get regenerated.
+	char magic[sizeof(kShaderCacheMagic)] = {0};
+	reader.readRaw(magic, sizeof(magic));
+	const uint32 version = reader.readU32();
+	if (!reader.isOk || memcmp(magic, kShaderCacheMagic, sizeof(magic)) != 0 || version != kShaderCacheVersion) {
+		return false;
+	}
 
-			std::vector<char> vsDecoded;
-			base64Decode(vsBytecodeEncoded.data(), vsBytecodeEncoded.size(), vsDecoded);
+	// Load the file hashes.
+	const uint32 numSourceFiles = reader.readU32();
+	for (uint32 iFile = 0; iFile < numSourceFiles && reader.isOk; ++iFile) {
+		std::string file;
+		reader.readBlob(file);
+		const unsigned hash = reader.readU32();
 
-			std::vector<char> psDecoded;
-			base64Decode(psBytecodeEncoded.data(), psBytecodeEncoded.size(), psDecoded);
+		this->sourceFileContentsHash[file] = hash;
+	}
 
-			perPermutBytecode.emplace_back(ShadingProgramByteCode{std::move(vsDecoded), std::move(psDecoded)});
-		}
+	// Load the shaders bytecode.
+	const uint32 numPermutations = reader.readU32();
+	for (uint32 iPerm = 0; iPerm < numPermutations && reader.isOk; ++iPerm) {
+		ShadingProgramByteCode bytecode;
+		reader.readBlob(bytecode.vsBytecode);
+		reader.readBlob(bytecode.psBytecode);
+		reader.readBlob(bytecode.programBinary);
 
-		return true;
+		perPermutBytecode.emplace_back(std::move(bytecode));
 	}
-	catch (...) {
+
+	if (!reader.isOk) {
 		sgeAssertFalse("The cache file seems to be broken");
 		*this = ShadingProgramPermuatorCache();
 		return false;
 	}
-}
-
 
+	return true;
+}
 
 bool ShadingProgramPermuatorCache::verifyThatCacheIsUpDoDate() const
 {
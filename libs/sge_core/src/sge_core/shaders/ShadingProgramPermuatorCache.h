@@ -13,6 +13,9 @@ namespace sge {
 /// reuse the compiled bytecode, bypassing the slow compilation.
 /// If the source file of the shader has been changed, the @verifyThatCacheIsUpDoDate method
 /// would return false, meaning that we should compile the shaders again.
+/// On OpenGL there is no portable bytecode, the cache stores the translated GLSL code and (where supported)
+/// the driver specific program binaries.
+/// The cache file is a compact binary container (see ShadingProgramPermuatorCache.cpp for the layout).
 struct ShadingProgramPermuatorCache {
 	/// Saves the cache to the specified file.
 	bool saveToFile(const char* cacheFilename) const;
@@ -29,6 +32,8 @@ struct ShadingProgramPermuatorCache {
 	struct ShadingProgramByteCode {
 		std::vector<char> vsBytecode;
 		std::vector<char> psBytecode;
+		/// The result of ShadingProgram::getProgramBinary, empty if not supported by the API.
+		std::vector<char> programBinary;
 	};
 
 	std::map<std::string, unsigned> sourceFileContentsHash;
@@ -0,0 +1,166 @@
+#include "SpriteParticlesShader.h"
+#include "sge_core/ICore.h"
+#include "sge_core/shaders/LightDesc.h"
+#include "sge_renderer/renderer/renderer.h"
+
+// Caution:
+// this include is an exception do not include anything else like it.
+#include "../core_shaders/ShadeCommon.h"
+
+namespace sge {
+
+static_assert(sizeof(SpriteParticleInstance) == 13 * sizeof(float), "The instance stream must not have any padding.");
+
+void SpriteParticlesShader::draw(
+    const RenderDestination& rdest,
+    const vec3f& camPos,
+    const mat4f& projView,
+    const mat4f& view,
+    const ShadowMapBuildInfo* const shadowMapBuildInfo,
+    Buffer* const instanceBuffer,
+    const uint32 instanceBufferByteOffset,
+    const int numInstances,
+    Texture* const texture)
+{
+	if (instanceBuffer == nullptr || numInstances <= 0 || texture == nullptr) {
+		return;
+	}
+
+	enum {
+		OPT_SpriteParticlesPass,
+		kNumOptions,
+	};
+
+	enum : int {
+		uProjView,
+		uCameraRightWs,
+		uCameraUpWs,
+		uTexture,
+		uPointLightPositionWs,
+		uPointLightFarPlaneDistance,
+	};
+
+	SGEDevice* const sgedev = rdest.getDevice();
+
+	if (shadingPermut.isValid() == false) {
+		shadingPermut = ShadingProgramPermuator();
+
+		const std::vector<OptionPermuataor::OptionDesc> compileTimeOptions = {
+		    {OPT_SpriteParticlesPass,
+		     "OPT_SpriteParticlesPass",
+		     {SGE_MACRO_STR(kSpriteParticlesPass_Color),
+		      SGE_MACRO_STR(kSpriteParticlesPass_ShadowMap),
+		      SGE_MACRO_STR(kSpriteParticlesPass_PointLightShadowMap)}},
+		};
+
+		// Caution: It is important that the order of the elements here MATCHES the order in the enum above.
+		const std::vector<ShadingProgramPermuator::Unform> uniformsToCache = {
+		    {uProjView, "uProjView", ShaderType::VertexShader},
+		    {uCameraRightWs, "uCameraRightWs", ShaderType::VertexShader},
+		    {uCameraUpWs, "uCameraUpWs", ShaderType::VertexShader},
+		    {uTexture, "uTexture", ShaderType::PixelShader},
+		    {uPointLightPositionWs, "uPointLightPositionWs", ShaderType::PixelShader},
+		    {uPointLightFarPlaneDistance, "uPointLightFarPlaneDistance", ShaderType::PixelShader},
+		};
+
+		shadingPermut->createFromFile(
+		    sgedev,
+		    "core_shaders/SpriteParticles.hlsl",
+		    "shader_cache/SpriteParticles.shadercache",
+		    compileTimeOptions,
+		    uniformsToCache);
+	}
+
+	// The quad that gets instanced for every particle.
+	if (m_quadVB.IsResourceValid() == false) {
+		const vec2f corners[4] = {
+		    vec2f(-1.f, -1.f),
+		    vec2f(+1.f, -1.f),
+		    vec2f(+1.f, +1.f),
+		    vec2f(-1.f, +1.f),
+		};
+
+		const uint16 indices[6] = {0, 1, 2, 0, 2, 3};
+
+		m_quadVB = sgedev->requestResource<Buffer>();
+		m_quadVB->create(BufferDesc::GetDefaultVertexBuffer(sizeof(corners)), corners);
+
+		m_quadIB = sgedev->requestResource<Buffer>();
+		m_quadIB->create(BufferDesc::GetDefaultIndexBuffer(sizeof(indices)), indices);
+
+		const VertexDecl vertexDecl[] = {
+		    VertexDecl(0, "a_corner", UniformType::Float2, 0),
+		    VertexDecl(1, "a_instPosition", UniformType::Float3, 0, true),
+		    VertexDecl(1, "a_instHalfSize", UniformType::Float2, 3 * sizeof(float), true),
+		    VertexDecl(1, "a_instColor", UniformType::Float4, 5 * sizeof(float), true),
+		    VertexDecl(1, "a_instUVRegion", UniformType::Float4, 9 * sizeof(float), true),
+		};
+
+		m_vertexDeclIdx = sgedev->getVertexDeclIndex(vertexDecl, SGE_ARRSZ(vertexDecl));
+	}
+
+	int optPass = kSpriteParticlesPass_Color;
+	if (shadowMapBuildInfo != nullptr) {
+		optPass = shadowMapBuildInfo->isPointLight ? kSpriteParticlesPass_PointLightShadowMap
+		                                           : kSpriteParticlesPass_ShadowMap;
+	}
+
+	const OptionPermuataor::OptionChoice optionChoice[kNumOptions] = {
+	    {OPT_SpriteParticlesPass, optPass},
+	};
+
+	const int iShaderPerm = shadingPermut->getCompileTimeOptionsPerm().computePermutationIndex(
+	    optionChoice, SGE_ARRSZ(optionChoice));
+	if (iShaderPerm < 0) {
+		return;
+	}
+
+	const ShadingProgramPermuator::Permutation& shaderPerm = shadingPermut->getShadersPerPerm()[iShaderPerm];
+
+	// The axes used to make the quads face the camera.
+	mat4f faceCameraMtx = view;
+	faceCameraMtx.c3 = vec4f(0.f, 0.f, 0.f, 1.f); // kill the translation.
+	faceCameraMtx = inverse(faceCameraMtx);
+	const vec4f cameraRightWs = vec4f(faceCameraMtx.c0.xyz(), 0.f);
+	const vec4f cameraUpWs = vec4f(faceCameraMtx.c1.xyz(), 0.f);
+
+	stateGroup.setProgram(shaderPerm.shadingProgram.GetPtr());
+	stateGroup.setVBDeclIndex(m_vertexDeclIdx);
+	stateGroup.setVB(0, m_quadVB, 0, sizeof(vec2f));
+	stateGroup.setVB(1, instanceBuffer, instanceBufferByteOffset, sizeof(SpriteParticleInstance));
+	stateGroup.setIB(m_quadIB, UniformType::Uint16, 0);
+	stateGroup.setPrimitiveTopology(PrimitiveTopology::TriangleList);
+
+	if (shadowMapBuildInfo != nullptr) {
+		stateGroup.setRenderState(
+		    getCore()->getGraphicsResources().RS_noCulling, getCore()->getGraphicsResources().DSS_default_lessEqual);
+	}
+	else {
+		// The particles are sorted back to front, so they do not need to write the depth.
+		stateGroup.setRenderState(
+		    getCore()->getGraphicsResources().RS_noCulling,
+		    getCore()->getGraphicsResources().DSS_default_lessEqual_noWrite,
+		    getCore()->getGraphicsResources().BS_backToFrontAlpha);
+	}
+
+	StaticArray<BoundUniform, 8> uniforms;
+	shaderPerm.bind<8>(uniforms, uProjView, (void*)&projView);
+	shaderPerm.bind<8>(uniforms, uCameraRightWs, (void*)&cameraRightWs);
+	shaderPerm.bind<8>(uniforms, uCameraUpWs, (void*)&cameraUpWs);
+	shaderPerm.bind<8>(uniforms, uTexture, texture);
+
+	if (optPass == kSpriteParticlesPass_PointLightShadowMap) {
+		shaderPerm.bind<8>(uniforms, uPointLightPositionWs, (void*)&camPos);
+		shaderPerm.bind<8>(
+		    uniforms, uPointLightFarPlaneDistance, (void*)&shadowMapBuildInfo->pointLightFarPlaneDistance);
+	}
+
+	DrawCall dc;
+	dc.setUniforms(uniforms.data(), uniforms.size());
+	dc.setStateGroup(&stateGroup);
+	dc.drawIndexed(6, 0, 0, numInstances);
+
+	rdest.sgecon->executeDrawCall(dc, rdest.frameTarget, &rdest.viewport);
+}
+
+} // namespace sge
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "ShadingProgramPermuator.h"
+#include "sge_core/sgecore_api.h"
+#include "sge_utils/containers/Optional.h"
+#include "sge_utils/math/mat4f.h"
+
+namespace sge {
+
+struct ShadowMapBuildInfo;
+
+/// The per-instance data for a single sprite particle, as expected by @SpriteParticlesShader.
+/// All particles are drawn as instances of a single camera facing quad.
+struct SpriteParticleInstance {
+	vec3f position = vec3f(0.f); ///< The center of the particle in world space.
+	vec2f halfSize = vec2f(0.f); ///< Half the width and the height of the particle in world space.
+	vec4f color = vec4f(1.f);
+	vec4f uvRegion = vec4f(0.f, 0.f, 1.f, 1.f); ///< (xy) - the uv of the bottom left corner, (zw) - of the top right.
+};
+
+/// SpriteParticlesShader draws sprite particles, described by a buffer of @SpriteParticleInstance,
+/// as camera facing quads with alpha blending. The particles are drawn in the order they appear in the buffer,
+/// so they are expected to be sorted back to front.
+/// The (almost) fully transparent parts of the sprites are discarded. In shadow maps the sprites write only their
+/// depth, in any order.
+struct SGE_CORE_API SpriteParticlesShader {
+  public:
+	SpriteParticlesShader() = default;
+
+	/// @param camPos the position of the camera, for point light shadow maps the position of the light.
+	/// @param shadowMapBuildInfo if not nullptr the particles are drawn into that shadow map.
+	/// @param instanceBuffer a vertex buffer holding @numInstances @SpriteParticleInstance elements,
+	///        starting at @instanceBufferByteOffset.
+	void draw(
+	    const RenderDestination& rdest,
+	    const vec3f& camPos,
+	    const mat4f& projView,
+	    const mat4f& view,
+	    const ShadowMapBuildInfo* const shadowMapBuildInfo,
+	    Buffer* const instanceBuffer,
+	    const uint32 instanceBufferByteOffset,
+	    const int numInstances,
+	    Texture* const texture);
+
+  private:
+	Optional<ShadingProgramPermuator> shadingPermut;
+	StateGroup stateGroup;
+
+	GpuHandle<Buffer> m_quadVB;
+	GpuHandle<Buffer> m_quadIB;
+	VertexDeclIndex m_vertexDeclIdx = VertexDeclIndex_Null;
+};
+
+} // namespace sge
@@ -46,7 +46,7 @@ void* MemberChain::follow(void* root) const
 			return nullptr;
 		}
 
-		const TypeDesc* const type = typeLib().find(knot.mfd->typeId);
+		const TypeDesc* const type = knot.mfd->getTypeDesc();
 
 		if (type == nullptr) {
 			sgeAssert(false); // Should never happen.
@@ -60,7 +60,7 @@ struct SGE_CORE_API MemberChain {
 	{
 		if (knots.size() == 0)
 			return nullptr;
-		const TypeDesc* const type = typeLib().find(knots.back().mfd->typeId);
+		const TypeDesc* const type = knots.back().mfd->getTypeDesc();
 		if (type == nullptr)
 			return nullptr;
 
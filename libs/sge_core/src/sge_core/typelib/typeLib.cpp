@@ -121,6 +121,7 @@ void TypeLib::performRegistration()
 		fn();
 	}
 	functionsToBeCalledThatWillRegisterTypes.clear();
+	registrationVersion++;
 
 	while (true) {
 		bool areAllCompleted = true;
@@ -166,6 +167,37 @@ void TypeLib::performRegistration()
 			break;
 		}
 	}
+
+	resolveMemberTypes();
+}
+
+void TypeLib::addToLookupTables(TypeDesc& typeDesc, int typeIndex)
+{
+	if (typeIndex < 0) {
+		typeIndex = int(m_typesByIndex.size());
+		m_typesByIndex.push_back(&typeDesc);
+	}
+	else {
+		// The type is registered again, its name might be different.
+		for (auto itr = m_nameToDesc.begin(); itr != m_nameToDesc.end();) {
+			itr = itr->second == &typeDesc ? m_nameToDesc.erase(itr) : std::next(itr);
+		}
+	}
+
+	typeDesc.typeIndex = typeIndex;
+	m_typeIdToDesc[typeDesc.typeId] = &typeDesc;
+	if (typeDesc.name) {
+		m_nameToDesc[typeDesc.name] = &typeDesc;
+	}
+}
+
+void TypeLib::resolveMemberTypes()
+{
+	for (TypeDesc* const typeDesc : m_typesByIndex) {
+		for (MemberDesc& member : typeDesc->members) {
+			member.typeDesc = find(member.typeId);
+		}
+	}
 }
 
 } // namespace sge
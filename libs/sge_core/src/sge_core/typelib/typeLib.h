@@ -8,6 +8,7 @@
 #include <map>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace sge {
@@ -66,9 +67,13 @@ struct TypeId {
 
 	bool operator>(const TypeId& r) const { return hash > r.hash; }
 
-	bool operator==(const TypeId& r) const { return hash == r.hash && strcmp(name, r.name) == 0; }
+	// The names usually come from the same string literal, so compare the pointers before the strings.
+	bool operator==(const TypeId& r) const
+	{
+		return hash == r.hash && (name == r.name || (name && r.name && strcmp(name, r.name) == 0));
+	}
 
-	bool operator!=(const TypeId& r) const { return hash != r.hash || strcmp(name, r.name) != 0; }
+	bool operator!=(const TypeId& r) const { return !(*this == r); }
 #endif
 };
 
@@ -106,14 +111,16 @@ namespace sge {
 template <typename T>
 TypeId sgeTypeIdFn();
 #else
+/// The id is computed once per type, as hashing the function signature on every call is not cheap.
 template <typename T>
 TypeId sgeTypeIdFn()
 {
 	#ifdef WIN32
-	return TypeId(__FUNCSIG__); // TODO: make this cross-compiler safe.
+	static const TypeId typeId(__FUNCSIG__); // TODO: make this cross-compiler safe.
 	#else
-	return TypeId(__FUNCSIG__);
+	static const TypeId typeId(__FUNCSIG__);
 	#endif
+	return typeId;
 }
 #endif
 
@@ -208,6 +215,15 @@ enum MemberFieldFlags : unsigned {
 	MFF_PrefabDontCopy = 1 << 6,
 };
 
+/// A set of additional flags that could be applied on types.
+enum TypeFlags : unsigned {
+	/// The objects of this type only modify their own state when updated (see GameObject::update),
+	/// which allows them to get updated in parallel.
+	TF_ParallelUpdate = 1 << 0,
+	/// The type does not override GameObject::update, so there is no need to call it.
+	TF_NoUpdate = 1 << 1,
+};
+
 /// A structure describing a single member (property) of a class:
 /// its byte offset, name, type etc.
 struct SGE_CORE_API MemberDesc {
@@ -227,6 +243,12 @@ struct SGE_CORE_API MemberDesc {
 	TypeId inheritedForm;
 	unsigned int flags = 0;
 
+	/// The TypeDesc of @typeId, resolved by TypeLib::performRegistration. Use getTypeDesc() to access it.
+	const TypeDesc* typeDesc = nullptr;
+
+	/// Returns the TypeDesc of the type of the member, without searching the type library if possible.
+	const TypeDesc* getTypeDesc() const;
+
 	bool isEditable() const { return (flags & MFF_NonEditable) == 0; }
 
 	bool isSaveable() const { return (flags & MFF_NonSaveable) == 0; }
@@ -472,6 +494,13 @@ struct SGE_CORE_API TypeDesc {
 		return *this;
 	}
 
+	/// Adds a flag (see @TypeFlags) to the type.
+	TypeDesc& addTypeFlag(unsigned flag)
+	{
+		typeFlags |= flag;
+		return *this;
+	}
+
 	/// If applicable controls the UI range of the values in case the type is a float.
 	TypeDesc& uiRange(float vmin, float vmax, float sliderSpeed);
 
@@ -520,7 +549,10 @@ struct SGE_CORE_API TypeDesc {
   public:
 	const char* name = nullptr;
 	TypeId typeId;
+	/// A dense index assigned when the type gets registered, see TypeLib::findByIndex.
+	int typeIndex = -1;
 	int sizeBytes = 0;
+	unsigned typeFlags = 0; ///< A set of @TypeFlags.
 
 	TypeId
 	    enumUnderlayingType; ///< The type that is used to represent an enum. If the type is not enum this is nullptr.
@@ -591,8 +623,11 @@ struct SGE_CORE_API TypeLib {
 #endif
 
 		TypeDesc& retval = m_registeredTypes[sgeTypeId(T)];
+		const int typeIndex = retval.typeIndex;
 		retval = TypeDesc::create<T>(name);
 		isCompleted[sgeTypeId(T)] = false;
+		registrationVersion++;
+		addToLookupTables(retval, typeIndex);
 
 		// FInd the traits of that type.
 		if constexpr (std::is_enum<T>::value) {
@@ -624,22 +659,22 @@ struct SGE_CORE_API TypeLib {
 
 	TypeDesc* find(TypeId const typeId)
 	{
-		MapTypes::iterator itr = m_registeredTypes.find(typeId);
-		if (itr == std::end(m_registeredTypes)) {
+		auto itr = m_typeIdToDesc.find(typeId);
+		if (itr == std::end(m_typeIdToDesc)) {
 			return nullptr;
 		}
 
-		return &itr->second;
+		return itr->second;
 	}
 
 	const TypeDesc* find(TypeId const typeId) const
 	{
-		MapTypes::const_iterator itr = m_registeredTypes.find(typeId);
-		if (itr == std::end(m_registeredTypes)) {
+		auto itr = m_typeIdToDesc.find(typeId);
+		if (itr == std::end(m_typeIdToDesc)) {
 			return nullptr;
 		}
 
-		return &itr->second;
+		return itr->second;
 	}
 
 	/// Searches for the reflection data of type @T
@@ -651,15 +686,31 @@ struct SGE_CORE_API TypeLib {
 
 	TypeDesc* findByName(const char* const name)
 	{
-		for (MapTypes::iterator itr = m_registeredTypes.begin(); itr != m_registeredTypes.end(); ++itr) {
-			if (strcmp(itr->second.name, name) == 0) {
-				return &itr->second;
-			}
+		if (name == nullptr) {
+			return nullptr;
 		}
 
-		return nullptr;
+		auto itr = m_nameToDesc.find(name);
+		if (itr == std::end(m_nameToDesc)) {
+			return nullptr;
+		}
+
+		return itr->second;
 	}
 
+	/// Returns the type with the specified TypeDesc::typeIndex.
+	TypeDesc* findByIndex(const int typeIndex)
+	{
+		if (typeIndex < 0 || typeIndex >= int(m_typesByIndex.size())) {
+			return nullptr;
+		}
+
+		return m_typesByIndex[typeIndex];
+	}
+
+	/// The number of registered types, all TypeDesc::typeIndex are in [0, getNumTypes()).
+	int getNumTypes() const { return int(m_typesByIndex.size()); }
+
 	/// Searches for a member of the specified type.
 	/// A bit shorter way of calling this is by using the @sgeFindMember macro.
 	template <typename T, typename M>
@@ -676,8 +727,35 @@ struct SGE_CORE_API TypeLib {
 
 	void performRegistration();
 
+  private:
+	/// Adds the newly (re)registered type to the lookup tables.
+	/// @param [in] typeIndex the index of the type if it was already registered, -1 otherwise.
+	void addToLookupTables(TypeDesc& typeDesc, int typeIndex);
+
+	/// Caches the TypeDesc of every member (see MemberDesc::typeDesc).
+	void resolveMemberTypes();
+
+	struct CStringHash {
+		size_t operator()(const char* const str) const { return hashCString_djb2(str); }
+	};
+
+	struct CStringEquals {
+		bool operator()(const char* const a, const char* const b) const { return a == b || strcmp(a, b) == 0; }
+	};
+
+	/// The lookup tables used by the find* functions, the TypeDescs are owned by @m_registeredTypes.
+	std::unordered_map<TypeId, TypeDesc*> m_typeIdToDesc;
+	std::unordered_map<const char*, TypeDesc*, CStringHash, CStringEquals> m_nameToDesc;
+	std::vector<TypeDesc*> m_typesByIndex;
+
+  public:
+	/// All registered types, it is fine to iterate over them, but use the find* functions for searching.
 	MapTypes m_registeredTypes;
 
+	/// Incremented every time the registered types change. Data cached per TypeDesc
+	/// (like the serialization plans) should be rebuilt when this changes.
+	int registrationVersion = 0;
+
 	std::map<TypeId, bool> isCompleted;
 	std::vector<void (*)()> functionsToBeCalledThatWillRegisterTypes;
 };
@@ -736,6 +814,12 @@ inline TypeDesc& TypeDesc::inherits()
 /// This is just to reduce tying.
 #define sgeFindMember(Type, Member) typeLib().find<Type>()->findMember(&Type::Member)
 
+inline const TypeDesc* MemberDesc::getTypeDesc() const
+{
+	// The types registered after TypeLib::performRegistration are not resolved yet.
+	return typeDesc ? typeDesc : typeLib().find(typeId);
+}
+
 // The function will work only if the very 1st type is used for @T (basically the root of the hierarchy)
 // Or if the same type of the owner of this member is used. No types in between.
 template <typename T, typename M>
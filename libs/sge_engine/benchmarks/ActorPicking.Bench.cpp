@@ -0,0 +1,150 @@
+#include "doctest/doctest.h"
+#include "sge_core/Camera.h"
+#include "sge_engine/ActorPicking.h"
+#include "sge_engine/GameWorld.h"
+#include "sge_engine/typelibHelper.h"
+#include "sge_renderer/renderer/renderer.h"
+#include "sge_utils/math/Random.h"
+#include "sge_utils/time/Timer.h"
+
+#include <cstdio>
+
+namespace sge {
+
+/// An actor with a bounding box only, it gets picked by its box.
+struct ABenchPickable : public Actor {
+	Box3f getBBoxOS() const override { return Box3f::getFromHalfDiagonal(halfDiagonal); }
+	void create() override {}
+
+	vec3f halfDiagonal = vec3f(0.5f);
+};
+
+ReflBlock()
+{
+	ReflAddActor(ABenchPickable);
+}
+
+TEST_CASE("ActorPicker 5k actors vs brute force")
+{
+	const int kNumActors = 5000;
+	const int kNumRays = 1000;
+
+	GameWorld world;
+	world.create();
+
+	Random rnd;
+	for (int t = 0; t < kNumActors; ++t) {
+		ABenchPickable* const actor = world.allocObjectT<ABenchPickable>();
+		actor->setPosition(
+		    vec3f(rnd.nextInRange(-100.f, 100.f), rnd.nextInRange(0.f, 20.f), rnd.nextInRange(-100.f, 100.f)));
+		actor->halfDiagonal =
+		    vec3f(rnd.nextInRange(0.25f, 2.f), rnd.nextInRange(0.25f, 2.f), rnd.nextInRange(0.25f, 2.f));
+	}
+
+	// The 1st update adds the objects to the playing list.
+	world.update(GameUpdateSets(1.f / 60.f, false, InputState()));
+
+	const vec3f camPos = vec3f(0.f, 60.f, 150.f);
+	const mat4f view = mat4f::getLookAtRH(camPos, vec3f(0.f), vec3f(0.f, 1.f, 0.f));
+	const RawCamera camera(
+	    camPos, view, mat4f::getPerspectiveFovRH(deg2rad(60.f), 1.f, 0.1f, 10000.f, 0.f, kIsTexcoordStyleD3D));
+
+	// The brute force reference, the same as what the picker does but without the hierarchy.
+	std::vector<Box3f> boxesWs;
+	for (const auto& objects : world.playingObjects) {
+		for (GameObject* const object : objects.second) {
+			const Actor* const actor = object->getActor();
+			boxesWs.push_back(actor ? actor->getBBoxOS().getTransformed(actor->getTransformMtx()) : Box3f());
+		}
+	}
+
+	const auto pickRayBruteForce = [&](const Ray& ray) -> int {
+		int closestItem = -1;
+		float closestT = FLT_MAX;
+		for (int iItem = 0; iItem < int(boxesWs.size()); ++iItem) {
+			if (boxesWs[iItem].isEmpty()) {
+				continue;
+			}
+
+			float tEnter = 0.f;
+			float tExit = 0.f;
+			if (boxesWs[iItem].intersect(ray.pos, ray.dir, tEnter, tExit) && tExit >= 0.f) {
+				tEnter = std::max(tEnter, 0.f);
+				if (tEnter < closestT) {
+					closestT = tEnter;
+					closestItem = iItem;
+				}
+			}
+		}
+		return closestItem;
+	};
+
+	ActorPicker picker;
+	Timer timer;
+	picker.build(world, camera);
+	timer.tick();
+	const float buildMs = timer.diff_seconds() * 1000.f;
+	REQUIRE(picker.getNumItems() == int(boxesWs.size()));
+
+	std::vector<Ray> rays(kNumRays);
+	for (Ray& ray : rays) {
+		ray = camera.perspectivePickWs(vec2f(rnd.next01(), rnd.next01()));
+	}
+
+	std::vector<int> bvhHits(kNumRays);
+	timer.tick();
+	for (int t = 0; t < kNumRays; ++t) {
+		bvhHits[t] = picker.pickRay(rays[t]);
+	}
+	timer.tick();
+	const float bvhRayMs = timer.diff_seconds() * 1000.f / float(kNumRays);
+
+	std::vector<int> bruteForceHits(kNumRays);
+	timer.tick();
+	for (int t = 0; t < kNumRays; ++t) {
+		bruteForceHits[t] = pickRayBruteForce(rays[t]);
+	}
+	timer.tick();
+	const float bruteForceRayMs = timer.diff_seconds() * 1000.f / float(kNumRays);
+
+	CHECK(bvhHits == bruteForceHits);
+
+	// A marquee selection covering the middle of the screen.
+	const RawCamera marqueeCamera(
+	    camPos,
+	    view,
+	    mat4f::getPerspectiveOffCenterRH(-0.02f, 0.03f, -0.02f, 0.01f, 0.1f, 10000.f, kIsTexcoordStyleD3D));
+	const Frustum& marqueeFrustum = *marqueeCamera.getFrustumWS();
+
+	std::vector<int> bvhSelection;
+	timer.tick();
+	picker.pickFrustum(marqueeFrustum, bvhSelection);
+	timer.tick();
+	const float bvhFrustumMs = timer.diff_seconds() * 1000.f;
+
+	std::vector<int> bruteForceSelection;
+	timer.tick();
+	for (int iItem = 0; iItem < int(boxesWs.size()); ++iItem) {
+		if (!boxesWs[iItem].isEmpty() && !marqueeFrustum.isBoxOutside(boxesWs[iItem])) {
+			bruteForceSelection.push_back(iItem);
+		}
+	}
+	timer.tick();
+	const float bruteForceFrustumMs = timer.diff_seconds() * 1000.f;
+
+	std::sort(bvhSelection.begin(), bvhSelection.end());
+	CHECK(bvhSelection == bruteForceSelection);
+
+	printf(
+	    "ActorPicker %d actors: build %.3f ms, ray %.4f ms (brute force %.4f ms), "
+	    "frustum %.4f ms (brute force %.4f ms), %d selected\n",
+	    kNumActors,
+	    buildMs,
+	    bvhRayMs,
+	    bruteForceRayMs,
+	    bvhFrustumMs,
+	    bruteForceFrustumMs,
+	    int(bvhSelection.size()));
+}
+
+} // namespace sge
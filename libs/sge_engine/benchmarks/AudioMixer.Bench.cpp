@@ -0,0 +1,357 @@
+#include "doctest/doctest.h"
+#include "sge_audio/AudioDevice.h"
+#include "sge_utils/math/Random.h"
+#include "sge_utils/time/Timer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sge {
+
+/// Returns the contents of a 16-bit stereo wav file with a sine wave, used instead of loading an audio file.
+static std::vector<char> makeBenchWavFile(float seconds, float frequency)
+{
+	const uint32 numFrames = uint32(seconds * float(kAudioSampleRate));
+	const uint32 dataSize = numFrames * kAudioNumChannels * sizeof(short);
+
+	std::vector<char> wav(44 + dataSize);
+	char* p = wav.data();
+	const auto write = [&p](const void* data, size_t size) -> void {
+		memcpy(p, data, size);
+		p += size;
+	};
+	const auto writeU32 = [&write](uint32 value) -> void { write(&value, 4); };
+	const auto writeU16 = [&write](unsigned short value) -> void { write(&value, 2); };
+
+	write("RIFF", 4);
+	writeU32(36 + dataSize);
+	write("WAVEfmt ", 8);
+	writeU32(16);
+	writeU16(1); // PCM
+	writeU16(kAudioNumChannels);
+	writeU32(kAudioSampleRate);
+	writeU32(kAudioSampleRate * kAudioNumChannels * sizeof(short));
+	writeU16(kAudioNumChannels * sizeof(short));
+	writeU16(16);
+	write("data", 4);
+	writeU32(dataSize);
+
+	for (uint32 iFrame = 0; iFrame < numFrames; ++iFrame) {
+		const float t = float(iFrame) / float(kAudioSampleRate);
+		const short sample = short(std::sin(t * frequency * 6.2831853f) * 8000.f);
+		for (int iChannel = 0; iChannel < kAudioNumChannels; ++iChannel) {
+			write(&sample, sizeof(sample));
+		}
+	}
+
+	return wav;
+}
+
+/// Mixes the voices the way AudioDevice did before the lock-free mixer, used as a reference:
+/// under a lock, decoding every voice in the audio callback and mixing it with a scalar loop.
+struct BenchDecodingInCallbackMixer {
+	explicit BenchDecodingInCallbackMixer(const std::vector<char>& wavFile, int numVoices)
+	    : decoders(numVoices)
+	{
+		ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, kAudioNumChannels, kAudioSampleRate);
+		for (ma_decoder& decoder : decoders) {
+			ma_decoder_init_memory(wavFile.data(), wavFile.size(), &decoderConfig, &decoder);
+		}
+	}
+
+	~BenchDecodingInCallbackMixer()
+	{
+		for (ma_decoder& decoder : decoders) {
+			ma_decoder_uninit(&decoder);
+		}
+	}
+
+	void mixOutput(float* output, uint32 frameCount)
+	{
+		const std::lock_guard<std::mutex> lock(dataLock);
+
+		if (decodingTemp.size() < frameCount * kAudioNumChannels) {
+			decodingTemp.resize(frameCount * kAudioNumChannels);
+		}
+
+		memset(output, 0, sizeof(float) * frameCount * kAudioNumChannels);
+		for (ma_decoder& decoder : decoders) {
+			ma_uint64 numFramesRead = 0;
+			ma_data_source_read_pcm_frames(&decoder, decodingTemp.data(), frameCount, &numFramesRead, ma_bool32(true));
+			for (ma_uint64 iSample = 0; iSample < numFramesRead * kAudioNumChannels; ++iSample) {
+				output[iSample] += decodingTemp[iSample] * 0.5f;
+			}
+		}
+	}
+
+	std::mutex dataLock;
+	std::vector<ma_decoder> decoders;
+	std::vector<float> decodingTemp;
+};
+
+TEST_CASE("AudioDevice mixing 64 voices on a null device, decoding in the callback vs pre-decoded")
+{
+	const int kNumVoices = 64;
+	const int kNumBuffers = 2000;
+	const uint32 kBufferFrames = 512;
+	const float kBufferBudgetMs = float(kBufferFrames) / float(kAudioSampleRate) * 1000.f;
+
+	const std::vector<char> clipWav = makeBenchWavFile(0.5f, 440.f);
+	AudioDataPtr clip = std::make_shared<AudioData>();
+	clip->createFromMemory(clipWav);
+	REQUIRE(clip->isPreDecoded());
+	REQUIRE(clip->getNumFrames() == uint64(kAudioSampleRate / 2));
+
+	AudioDevice device;
+	device.createNullAudioDevice(kNumVoices);
+
+	std::vector<AudioDecoder> decoders(kNumVoices);
+	for (AudioDecoder& decoder : decoders) {
+		decoder.createDecoder(clip);
+		decoder.state.isLooping = true;
+		decoder.state.volume = 0.5f;
+		device.play(&decoder, true);
+	}
+
+	CHECK(device.getNumPlayingVoices() == kNumVoices);
+
+	std::vector<float> output(kBufferFrames * kAudioNumChannels);
+	Timer timer;
+
+	const auto bench = [&](const char* const name, const auto& mixFn) -> float {
+		float maxMs = 0.f;
+		float totalMs = 0.f;
+		for (int iBuffer = 0; iBuffer < kNumBuffers; ++iBuffer) {
+			timer.tick();
+			mixFn(output.data(), kBufferFrames);
+			timer.tick();
+			maxMs = maxOf(maxMs, timer.diff_seconds() * 1000.f);
+			totalMs += timer.diff_seconds() * 1000.f;
+		}
+
+		const float avgMs = totalMs / float(kNumBuffers);
+		printf(
+		    "Audio mixing %d voices, %s: %.4f ms per buffer on average, %.4f ms max (budget %.2f ms)\n",
+		    kNumVoices,
+		    name,
+		    avgMs,
+		    maxMs,
+		    kBufferBudgetMs);
+		return avgMs;
+	};
+
+	BenchDecodingInCallbackMixer reference(clipWav, kNumVoices);
+	const float referenceMs = bench("decoding in the callback", [&](float* out, uint32 frameCount) {
+		reference.mixOutput(out, frameCount);
+	});
+	const std::vector<float> referenceOutput = output;
+
+	const float mixerMs = bench("pre-decoded", [&](float* out, uint32 frameCount) {
+		device.mixOutput(out, frameCount);
+	});
+
+	printf("Audio mixing pre-decoded voices is %.1fx faster\n", referenceMs / mixerMs);
+
+	// Both played the same amount of looping frames, so the last buffers should be the same.
+	bool isSameOutput = true;
+	for (int t = 0; t < int(output.size()); ++t) {
+		isSameOutput &= std::abs(output[t] - referenceOutput[t]) < 1e-3f;
+	}
+	CHECK(isSameOutput);
+	CHECK(mixerMs < kBufferBudgetMs);
+	CHECK(device.getNumPlayingVoices() == kNumVoices);
+
+	for (AudioDecoder& decoder : decoders) {
+		device.stop(&decoder);
+		CHECK_FALSE(decoder.isPlaying());
+	}
+}
+
+TEST_CASE("AudioDevice playing 2000 one-shots from the game thread while the audio thread mixes")
+{
+	const int kMaxVoices = 32;
+	const int kNumOneShots = 2000;
+	const uint32 kBufferFrames = 256;
+
+	AudioDataPtr clip = std::make_shared<AudioData>();
+	clip->createFromMemory(makeBenchWavFile(0.05f, 880.f));
+	AudioDataPtr track = std::make_shared<AudioData>();
+	track->createFromMemory(makeBenchWavFile(AudioData::kMaxPreDecodedSeconds + 2.f, 220.f));
+	REQUIRE(clip->isPreDecoded());
+	REQUIRE_FALSE(track->isPreDecoded());
+
+	AudioDevice device;
+	device.createNullAudioDevice(kMaxVoices);
+
+	// The music is streamed and has the highest priority, so it never gets stolen by the one-shots.
+	AudioDecoder music;
+	music.createDecoder(track);
+	music.state.isLooping = true;
+	music.state.priority = 100;
+	device.play(&music, true);
+
+	// Plays the role of the audio thread of a real output device.
+	std::atomic<bool> isMixing = true;
+	std::atomic<int> numSilentBuffers = 0;
+	std::atomic<int> numMixedBuffers = 0;
+	std::thread audioThread([&]() -> void {
+		std::vector<float> output(kBufferFrames * kAudioNumChannels);
+		while (isMixing) {
+			device.mixOutput(output.data(), kBufferFrames);
+
+			float peak = 0.f;
+			for (float sample : output) {
+				peak = maxOf(peak, std::abs(sample));
+			}
+			numSilentBuffers += peak == 0.f ? 1 : 0;
+			numMixedBuffers++;
+
+			std::this_thread::sleep_for(std::chrono::microseconds(500));
+		}
+	});
+
+	Random rnd;
+	std::vector<AudioDecoder> oneShots(kNumOneShots);
+	int maxPlayingVoices = 0;
+
+	Timer timer;
+	timer.tick();
+	for (int t = 0; t < kNumOneShots; ++t) {
+		oneShots[t].createDecoder(clip);
+		oneShots[t].state.priority = rnd.nextIntBefore(4);
+		device.play(&oneShots[t], true);
+
+		if (t % 16 == 0) {
+			device.update();
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+		}
+
+		maxPlayingVoices = maxOf(maxPlayingVoices, device.getNumPlayingVoices());
+	}
+	timer.tick();
+
+	printf(
+	    "Audio %d one-shots started in %.2f ms (%.4f ms per play), %d buffers mixed meanwhile\n",
+	    kNumOneShots,
+	    timer.diff_seconds() * 1000.f,
+	    timer.diff_seconds() * 1000.f / float(kNumOneShots),
+	    numMixedBuffers.load());
+
+	CHECK(maxPlayingVoices <= kMaxVoices);
+	CHECK(music.isPlaying());
+
+	// The one-shots are short, after a while all of them should finish by themselves.
+	for (int iWait = 0; iWait < 200 && device.getNumPlayingVoices() > 1; ++iWait) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		device.update();
+	}
+
+	int numStillPlaying = 0;
+	for (const AudioDecoder& oneShot : oneShots) {
+		numStillPlaying += oneShot.isPlaying() ? 1 : 0;
+	}
+	CHECK(numStillPlaying == 0);
+	CHECK(music.isPlaying());
+	CHECK(device.getNumPlayingVoices() == 1);
+
+	device.stop(&music);
+	CHECK_FALSE(music.isPlaying());
+
+	isMixing = false;
+	audioThread.join();
+
+	// The music plays through the whole test, so no buffer should be silent.
+	CHECK(numSilentBuffers == 0);
+}
+
+TEST_CASE("AudioDevice mixing 1000 3D emitters, with and without voice virtualization")
+{
+	const int kNumEmitters = 1000;
+	const int kNumFrames = 300;
+	const uint32 kBufferFrames = 512;
+	const float kWorldSize = 400.f;
+
+	AudioDataPtr clip = std::make_shared<AudioData>();
+	clip->createFromMemory(makeBenchWavFile(1.f, 330.f));
+	REQUIRE(clip->isPreDecoded());
+
+	AudioDevice device;
+	device.createNullAudioDevice(kNumEmitters);
+
+	// The emitters are spread over the world and most of them are too far to be heard by the listener in the middle.
+	Random rnd;
+	std::vector<AudioDecoder> emitters(kNumEmitters);
+	for (AudioDecoder& emitter : emitters) {
+		emitter.createDecoder(clip);
+		emitter.state.isLooping = true;
+		emitter.state.is3D = true;
+		emitter.state.position = vec3f(rnd.nextSnorm(), 0.f, rnd.nextSnorm()) * kWorldSize * 0.5f;
+		emitter.state.velocity = vec3f(rnd.nextSnorm(), 0.f, rnd.nextSnorm()) * 5.f;
+		emitter.state.minDistance = 2.f;
+		emitter.state.maxDistance = 40.f;
+		device.play(&emitter, true);
+	}
+
+	REQUIRE(device.getNumPlayingVoices() == kNumEmitters);
+
+	std::vector<float> output(kBufferFrames * kAudioNumChannels);
+	Timer timer;
+
+	// A game frame moves the listener, updates the device and mixes one buffer.
+	const auto bench = [&](const char* const name) -> float {
+		float updateMs = 0.f;
+		float mixMs = 0.f;
+		for (int iFrame = 0; iFrame < kNumFrames; ++iFrame) {
+			AudioListener listener;
+			listener.position = vec3f(std::sin(float(iFrame) * 0.01f) * 20.f, 0.f, 0.f);
+			listener.velocity = vec3f(std::cos(float(iFrame) * 0.01f) * 12.f, 0.f, 0.f);
+			device.setListener(listener);
+
+			timer.tick();
+			device.update();
+			timer.tick();
+			updateMs += timer.diff_seconds() * 1000.f;
+
+			device.mixOutput(output.data(), kBufferFrames);
+			timer.tick();
+			mixMs += timer.diff_seconds() * 1000.f;
+		}
+
+		printf(
+		    "Audio %d 3D emitters, %s: update %.4f ms, mixing %.4f ms per buffer, %d voices audible\n",
+		    kNumEmitters,
+		    name,
+		    updateMs / float(kNumFrames),
+		    mixMs / float(kNumFrames),
+		    device.getNumAudibleVoices());
+		return mixMs / float(kNumFrames);
+	};
+
+	device.setVirtualizationThreshold(0.f);
+	device.setMaxAudibleVoices(kNumEmitters);
+	const float allMixedMs = bench("virtualization off");
+	CHECK(device.getNumAudibleVoices() == kNumEmitters);
+
+	device.setVirtualizationThreshold(0.001f);
+	device.setMaxAudibleVoices(AudioDevice::kDefaultMaxVoices);
+	const float virtualizedMs = bench("virtualization on");
+	CHECK(device.getNumAudibleVoices() <= AudioDevice::kDefaultMaxVoices);
+	CHECK(device.getNumAudibleVoices() > 0);
+
+	printf("Audio mixing with virtualization is %.1fx faster\n", allMixedMs / virtualizedMs);
+	CHECK(virtualizedMs < allMixedMs);
+
+	// Virtual voices keep playing, so they continue from the right place when they become audible again.
+	CHECK(device.getNumPlayingVoices() == kNumEmitters);
+
+	for (AudioDecoder& emitter : emitters) {
+		device.stop(&emitter);
+	}
+	CHECK(device.getNumPlayingVoices() == 0);
+}
+
+} // namespace sge
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "sge_engine/actors/ANavMesh_btCollisionShapeToTriangles.h"
+#include "sge_engine/actors/NavMeshBuilder.h"
+#include "sge_engine/physics/BulletHelper.h"
+#include "sge_utils/math/Random.h"
+
+namespace sge {
+
+/// A big flat level with box obstacles scattered around.
+struct BenchNavMeshLevel {
+	BenchNavMeshLevel(int numObstacles, float levelSize)
+	    : groundShape(btVector3(levelSize * 0.5f, 0.5f, levelSize * 0.5f))
+	    , obstacleShape(btVector3(1.f, 1.f, 1.f))
+	{
+		Random rnd;
+		const float spawnRange = levelSize * 0.5f - 4.f;
+		for (int t = 0; t < numObstacles; ++t) {
+			obstaclesPositions.push_back(
+			    vec3f(rnd.nextInRange(-spawnRange, spawnRange), 1.f, rnd.nextInRange(-spawnRange, spawnRange)));
+		}
+	}
+
+	void generateTriangles(NavMeshInputGeometry& outGeometry) const
+	{
+		outGeometry.vertices.clear();
+		outGeometry.indices.clear();
+
+		bulletCollisionShapeToTriangles(
+		    &groundShape, btTransform(btQuaternion::getIdentity(), btVector3(0.f, -0.5f, 0.f)), outGeometry.vertices,
+		    outGeometry.indices);
+
+		for (const vec3f& position : obstaclesPositions) {
+			bulletCollisionShapeToTriangles(
+			    &obstacleShape, btTransform(btQuaternion::getIdentity(), toBullet(position)), outGeometry.vertices,
+			    outGeometry.indices);
+		}
+	}
+
+	Box3f getObstacleBox(int iObstacle) const
+	{
+		return Box3f::getFromHalfDiagonal(vec3f(1.f), obstaclesPositions[iObstacle]);
+	}
+
+	btBoxShape groundShape;
+	btBoxShape obstacleShape;
+	std::vector<vec3f> obstaclesPositions;
+};
+
+} // namespace sge
@@ -0,0 +1,97 @@
+#include "doctest/doctest.h"
+#include "sge_engine/GameWorld.h"
+#include "sge_engine/typelibHelper.h"
+#include "sge_utils/math/Random.h"
+#include "sge_utils/time/Timer.h"
+
+#include <cstdio>
+
+namespace sge {
+
+/// An actor that only touches its own state when updated, something like a simple gameplay agent.
+struct ABenchWanderer : public Actor {
+	Box3f getBBoxOS() const override { return Box3f(vec3f(-0.5f), vec3f(0.5f)); }
+	void create() override {}
+
+	void update(const GameUpdateSets& u) override
+	{
+		// Some arbitrary work, steer towards a target that moves around a circle.
+		transf3d tr = getTransform();
+		for (int iStep = 0; iStep < 16; ++iStep) {
+			phase += u.dt;
+			const vec3f target = vec3f(cosf(phase), 0.f, sinf(phase)) * 10.f;
+			const vec3f toTarget = target - tr.p;
+			velocity += toTarget.normalized0() * u.dt;
+			velocity *= 0.99f;
+			tr.p += velocity * u.dt;
+			tr.r = quatf::getAxisAngle(vec3f::getAxis(1), phase);
+		}
+
+		setTransformEx(tr, false, false, false);
+	}
+
+	float phase = 0.f;
+	vec3f velocity = vec3f(0.f);
+};
+
+/// Same as ABenchWanderer, but marked as safe to be updated in parallel.
+struct ABenchWandererParallel : public ABenchWanderer {};
+
+// clang-format off
+ReflBlock()
+{
+	ReflAddActor(ABenchWanderer);
+	ReflAddType(ABenchWandererParallel) ReflInherits(ABenchWandererParallel, ABenchWanderer)
+		.addTypeFlag(TF_ParallelUpdate);
+}
+// clang-format on
+
+/// Creates a world with the specified amount of actors and measures the average time GameWorld::update takes.
+template <typename TActor>
+float measureWorldUpdateMs(int numActors, int numWorkers, int numFrames)
+{
+	GameWorld world;
+	world.create();
+	world.setNumUpdateWorkers(numWorkers);
+
+	Random rnd;
+	for (int t = 0; t < numActors; ++t) {
+		TActor* const actor = world.allocObjectT<TActor>();
+		actor->setPosition(vec3f(rnd.nextInRange(-100.f, 100.f), 0.f, rnd.nextInRange(-100.f, 100.f)));
+		actor->phase = rnd.nextInRange(0.f, sgePi);
+	}
+
+	const GameUpdateSets updateSets(1.f / 60.f, false, InputState());
+
+	// The 1st update adds the objects to the playing list and creates the thread pool.
+	world.update(updateSets);
+
+	Timer timer;
+	for (int iFrame = 0; iFrame < numFrames; ++iFrame) {
+		world.update(updateSets);
+	}
+	timer.tick();
+
+	return timer.diff_seconds() * 1000.f / float(numFrames);
+}
+
+TEST_CASE("GameWorld update 10k actors")
+{
+	const int kNumActors = 10000;
+	const int kNumFrames = 60;
+
+	const float serialMs = measureWorldUpdateMs<ABenchWanderer>(kNumActors, 1, kNumFrames);
+	printf("GameWorld::update %d actors, serial types: %.3f ms\n", kNumActors, serialMs);
+
+	for (int numWorkers : {1, 2, 4, 8}) {
+		const float parallelMs = measureWorldUpdateMs<ABenchWandererParallel>(kNumActors, numWorkers, kNumFrames);
+		printf(
+		    "GameWorld::update %d actors, TF_ParallelUpdate, %d workers: %.3f ms (%.2fx)\n",
+		    kNumActors,
+		    numWorkers,
+		    parallelMs,
+		    serialMs / parallelMs);
+	}
+}
+
+} // namespace sge
@@ -0,0 +1,171 @@
+#include "doctest/doctest.h"
+#include "sge_utils/io/FileStream.h"
+#include "sge_utils/io/IStream.h"
+#include "sge_utils/json/json.h"
+#include "sge_utils/math/Random.h"
+#include "sge_utils/time/Timer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+namespace sge {
+
+/// Creates a json with the shape of a saved level (see serializeGameWorld): a few world settings
+/// and an array of actors, each with a transform, a model, a few other properties and a script.
+static JsonValue* createBenchLevelJson(JsonValueBuffer& jvb, int numActors)
+{
+	Random rnd;
+	const auto randomFloats = [&](int count) -> JsonValue* {
+		JsonValue* const jArray = jvb(JID_ARRAY);
+		for (int t = 0; t < count; ++t) {
+			jArray->arrPush(jvb(rnd.nextInRange(-100.f, 100.f)));
+		}
+		return jArray;
+	};
+
+	JsonValue* const jWorld = jvb(JID_MAP);
+	jWorld->setMember("version", jvb(1));
+	jWorld->setMember("nextActorId", jvb(numActors + 1));
+	jWorld->setMember("ambientLightColor", randomFloats(3));
+	jWorld->setMember("defaultGravity", randomFloats(3));
+
+	JsonValue* const jActors = jWorld->setMember("actors", jvb(JID_ARRAY));
+	jActors->arrReserve(numActors);
+	for (int iActor = 0; iActor < numActors; ++iActor) {
+		const std::string name = "Actor_" + std::to_string(iActor);
+
+		JsonValue* const jActor = jActors->arrPush(jvb(JID_MAP));
+		jActor->setMember("actorType", jvb("sge::AStaticObstacle"));
+		jActor->setMember("id", jvb(iActor + 1));
+
+		JsonValue* const jMembers = jActor->setMember("members", jvb(JID_MAP));
+		jMembers->setMember("m_displayName", jvb(name));
+		jMembers->setMember("m_enabled", jvb(true));
+
+		JsonValue* const jTransform = jMembers->setMember("m_logicTransform", jvb(JID_MAP));
+		jTransform->setMember("p", randomFloats(3));
+		jTransform->setMember("r", randomFloats(4));
+		jTransform->setMember("s", randomFloats(3));
+
+		JsonValue* const jModel = jMembers->setMember("m_traitModel", jvb(JID_MAP));
+		jModel->setMember("m_assetPath", jvb("assets/props/crate_" + std::to_string(iActor % 50) + ".mdl"));
+		jModel->setMember("m_isFixedModelsSize", jvb(false));
+		jModel->setMember("m_tint", randomFloats(4));
+
+		JsonValue* const jRigidBody = jMembers->setMember("m_traitRB", jvb(JID_MAP));
+		jRigidBody->setMember("m_mass", jvb(0.f));
+		jRigidBody->setMember("m_friction", jvb(0.5f));
+		jRigidBody->setMember("m_noResponse", jvb(false));
+
+		JsonValue* const jScripts = jMembers->setMember("m_scripts", jvb(JID_ARRAY));
+		jScripts->arrPush(jvb("// " + name + "\n\tonUpdate(\"crate\");"));
+	}
+
+	return jWorld;
+}
+
+/// Returns the sum of all numbers in the level, used to check that two parsed levels have the same content.
+static double sumLevelActorsNumbers(const JsonValue* const jWorld)
+{
+	double sum = 0.0;
+	for (const JsonValue* const jActor : jWorld->getMember("actors")->arr()) {
+		const JsonValue* const jMembers = jActor->getMember("members");
+		sum += jActor->getMember("id")->getNumberAs<double>();
+		for (const JsonValue* const jNum : jMembers->getMember("m_logicTransform")->getMember("p")->arr()) {
+			sum += jNum->getNumberAs<double>();
+		}
+		sum += jMembers->getMember("m_traitRB")->getMember("m_friction")->getNumberAs<double>();
+	}
+	return sum;
+}
+
+TEST_CASE("Json parse and serialize a 50MB level")
+{
+	const int kNumActors = 100000;
+
+	Timer timer;
+	JsonValueBuffer jvb;
+	const JsonValue* const jSourceWorld = createBenchLevelJson(jvb, kNumActors);
+	timer.tick();
+	const float buildMs = timer.diff_seconds() * 1000.f;
+
+	WriteStdStringStream levelStream;
+	JsonWriter writer;
+	timer.tick();
+	REQUIRE(writer.write(&levelStream, jSourceWorld, false));
+	timer.tick();
+	const float serializeMs = timer.diff_seconds() * 1000.f;
+
+	const std::string& levelJson = levelStream.serializedString;
+	const float levelSizeMB = float(levelJson.size()) / (1024.f * 1024.f);
+
+	printf(
+	    "Json level %d actors, %.1f MB: building the DOM %.1f ms, serializing %.1f ms (%.0f MB/s)\n",
+	    kNumActors,
+	    levelSizeMB,
+	    buildMs,
+	    serializeMs,
+	    levelSizeMB / (serializeMs / 1000.f));
+
+	const std::filesystem::path levelPath = std::filesystem::temp_directory_path() / "sge_bench_level.lvl";
+	{
+		FileWriteStream fws;
+		REQUIRE(fws.open(levelPath.string().c_str()));
+		fws.write(levelJson.data(), levelJson.size());
+	}
+
+	const double sourceSum = sumLevelActorsNumbers(jSourceWorld);
+
+	const auto benchParsing = [&](const char* const sourceName, const auto& parseFn) -> void {
+		JsonParser parser;
+		timer.tick();
+		const bool succeeded = parseFn(parser);
+		timer.tick();
+		const float parseMs = timer.diff_seconds() * 1000.f;
+
+		REQUIRE(succeeded);
+		REQUIRE(parser.getRoot() != nullptr);
+
+		// Look up every member of every actor.
+		timer.tick();
+		const double parsedSum = sumLevelActorsNumbers(parser.getRoot());
+		timer.tick();
+		const float lookupMs = timer.diff_seconds() * 1000.f;
+
+		printf(
+		    "Json level parsing from %s: %.1f ms (%.0f MB/s), walking all actors with getMember %.2f ms\n",
+		    sourceName,
+		    parseMs,
+		    levelSizeMB / (parseMs / 1000.f),
+		    lookupMs);
+
+		CHECK(parsedSum == doctest::Approx(sourceSum));
+		CHECK(parser.getRoot()->getMember("actors")->arrSize() == kNumActors);
+
+		// Writing the parsed level again must produce the same text.
+		WriteStdStringStream roundTripStream;
+		JsonWriter().write(&roundTripStream, parser.getRoot(), false);
+		CHECK(roundTripStream.serializedString.size() == levelJson.size());
+		CHECK(roundTripStream.serializedString == levelJson);
+	};
+
+	benchParsing("memory", [&](JsonParser& parser) -> bool {
+		return parser.parse(levelJson.c_str(), levelJson.size());
+	});
+
+	benchParsing("memory mapped file", [&](JsonParser& parser) -> bool {
+		return parser.parseFile(levelPath.string().c_str());
+	});
+
+	benchParsing("file stream", [&](JsonParser& parser) -> bool {
+		FileReadStream frs;
+		return frs.open(levelPath.string().c_str()) && parser.parse(&frs);
+	});
+
+	std::error_code removeError;
+	std::filesystem::remove(levelPath, removeError);
+}
+
+} // namespace sge
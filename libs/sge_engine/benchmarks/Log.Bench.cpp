@@ -0,0 +1,158 @@
+#include "doctest/doctest.h"
+#include "sge_log/Log.h"
+#include "sge_utils/text/format.h"
+#include "sge_utils/time/Timer.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sge {
+
+/// Logs the way Log did before the ring-buffer backend: formatting into a new std::string on the calling thread and
+/// appending it to an unbounded vector. A lock is added, otherwise concurrent writers would corrupt the vector.
+struct BenchFormatOnWriteLog {
+	void write(const char* format, ...)
+	{
+		va_list args;
+		va_start(args, format);
+		std::string buffer;
+		string_format(buffer, format, args);
+		va_end(args);
+
+		const std::lock_guard<std::mutex> lock(messagesLock);
+		messages.emplace_back(Log::Message(Log::messageType_log, buffer));
+	}
+
+	std::mutex messagesLock;
+	std::vector<Log::Message> messages;
+};
+
+TEST_CASE("Log with many concurrent writers, formatting on write vs deferred formatting")
+{
+	const int kMaxThreads = 8;
+	const int kNumMessagesPerThread = 10000;
+
+	// Returns the average time of a write call in nanoseconds, the time of all threads divided by the messages.
+	const auto bench = [&](const char* const name, int numThreads, const auto& writeFn) -> float {
+		Timer timer;
+		timer.tick();
+
+		std::vector<std::thread> threads;
+		for (int iThread = 0; iThread < numThreads; ++iThread) {
+			threads.emplace_back([&writeFn, iThread]() -> void {
+				for (int t = 0; t < kNumMessagesPerThread; ++t) {
+					writeFn(iThread, t);
+				}
+			});
+		}
+
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		timer.tick();
+
+		const float nsPerWrite = timer.diff_seconds() * 1e9f / float(numThreads * kNumMessagesPerThread);
+		printf(
+		    "Log %d threads writing %d messages each, %s: %.1f ns per write\n",
+		    numThreads,
+		    kNumMessagesPerThread,
+		    name,
+		    nsPerWrite);
+		return nsPerWrite;
+	};
+
+	for (const int numThreads : {1, kMaxThreads}) {
+		const int numMessages = numThreads * kNumMessagesPerThread;
+
+		BenchFormatOnWriteLog reference;
+		const float referenceNs = bench("formatting on write", numThreads, [&reference](int iThread, int t) -> void {
+			reference.write("Thread %d moved the object %s to (%f, %f), step %d", iThread, "Player", 1.5f, float(t), t);
+		});
+		CHECK(int(reference.messages.size()) == numMessages);
+
+		// A queue that can hold all messages, so none of them is dropped.
+		Log log(numMessages);
+		log.setRetentionCap(numMessages);
+		// Starts the background thread and allocates the queue, so that isn't measured.
+		log.flush();
+		const float deferredNs = bench("deferred formatting", numThreads, [&log](int iThread, int t) -> void {
+			log.writeDeferred(
+			    Log::messageType_log,
+			    "Thread %d moved the object %s to (%f, %f), step %d",
+			    iThread,
+			    "Player",
+			    1.5f,
+			    float(t),
+			    t);
+		});
+
+		Timer timer;
+		timer.tick();
+		log.flush();
+		timer.tick();
+
+		printf(
+		    "Log deferred formatting is %.1fx faster for the writers, the messages were processed %.2f ms later\n",
+		    referenceNs / deferredNs,
+		    timer.diff_seconds() * 1000.f);
+
+		CHECK(log.getNumDroppedMessages() == 0);
+		CHECK(log.getNumProcessedMessages() == uint64(numMessages));
+
+		// The messages should be the same as the ones formatted on write.
+		std::vector<Log::Message> messages;
+		log.copyMessages(messages);
+		REQUIRE(int(messages.size()) == numMessages);
+
+		std::vector<std::string> expected;
+		std::vector<std::string> actual;
+		for (int t = 0; t < numMessages; ++t) {
+			expected.push_back(reference.messages[t].message);
+			actual.push_back(messages[t].message);
+		}
+		std::sort(expected.begin(), expected.end());
+		std::sort(actual.begin(), actual.end());
+		CHECK(expected == actual);
+	}
+}
+
+TEST_CASE("Log with a small queue drops messages instead of blocking and keeps only the last ones")
+{
+	const int kNumMessages = 100000;
+
+	Log log(256);
+	log.setRetentionCap(1000);
+
+	Timer timer;
+	timer.tick();
+	for (int t = 0; t < kNumMessages; ++t) {
+		log.writeDeferred(Log::messageType_warning, "Message %d, %s", t, "long enough to not be a no-op");
+	}
+	timer.tick();
+	log.flush();
+
+	// A message too long for a record is formatted on the writing thread.
+	const std::string longText(1000, 'a');
+	log.writeDeferred(Log::messageType_error, "Long message %s", longText.c_str());
+	log.flush();
+
+	printf(
+	    "Log %d messages written in %.2f ms, %d dropped\n",
+	    kNumMessages,
+	    timer.diff_seconds() * 1000.f,
+	    int(log.getNumDroppedMessages()));
+
+	std::vector<Log::Message> messages;
+	log.copyMessages(messages);
+	CHECK(int(messages.size()) <= 1000);
+	REQUIRE_FALSE(messages.empty());
+	CHECK(messages.back().type == Log::messageType_error);
+	CHECK(messages.back().message == "Long message " + longText);
+	CHECK(log.getNumProcessedMessages() + log.getNumDroppedMessages() >= uint64(kNumMessages + 1));
+}
+
+} // namespace sge
@@ -0,0 +1,147 @@
+#include "doctest/doctest.h"
+#include "sge_core/model/Model.h"
+#include "sge_core/model/ModelAnimator.h"
+#include "sge_utils/threading/ThreadPool.h"
+#include "sge_utils/time/Timer.h"
+
+#include <cstdio>
+
+namespace sge {
+
+/// Creates a model with a skeleton made of a few chains of nodes (like a spine, arms and legs)
+/// and a single looping animation, that has keyframes for every node.
+static void createBenchSkeleton(Model& model, int numChains, int chainLength, int numKeys)
+{
+	const int iRoot = model.makeNewNode();
+	model.setRootNodeIndex(iRoot);
+
+	for (int iChain = 0; iChain < numChains; ++iChain) {
+		int iParent = iRoot;
+		for (int iLink = 0; iLink < chainLength; ++iLink) {
+			const int iNode = model.makeNewNode();
+			model.nodeAt(iNode)->staticLocalTransform.p = vec3f(0.f, 1.f, 0.f);
+			model.nodeAt(iParent)->childNodes.push_back(iNode);
+			iParent = iNode;
+		}
+	}
+
+	const float duration = 1.f;
+	ModelAnimation* const anim = model.animationAt(model.makeNewAnim());
+	anim->animationName = "bench";
+	anim->durationSec = duration;
+
+	for (int iNode = 0; iNode < model.numNodes(); ++iNode) {
+		KeyFrames& keyFrames = anim->getOrAddNodeKeyFrames(iNode);
+		for (int iKey = 0; iKey < numKeys; ++iKey) {
+			const float k = float(iKey) / float(numKeys - 1);
+			const float t = k * duration;
+			keyFrames.positionKeyFrames.setKey(t, vec3f(0.f, 1.f + 0.1f * k, 0.f));
+			keyFrames.rotationKeyFrames.setKey(
+			    t, quatf::getAxisAngle(vec3f::getAxis(iNode % 3), sin(k * two_pi() + float(iNode)) * 0.5f));
+			keyFrames.scalingKeyFrames.setKey(t, vec3f(1.f));
+		}
+	}
+}
+
+TEST_CASE("ModelAnimator batch evaluation 500 characters")
+{
+	const int kNumCharacters = 500;
+	const int kNumFrames = 30;
+
+	Model model;
+	createBenchSkeleton(model, 5, 12, 30);
+	const int numNodes = model.numNodes();
+
+	std::vector<ModelAnimator> animators(kNumCharacters);
+	std::vector<ModelAnimator*> animatorPtrs(kNumCharacters);
+	std::vector<std::vector<mat4f>> nodeTransforms(kNumCharacters);
+	std::vector<mat4f*> nodeTransformsPtrs(kNumCharacters);
+	for (int t = 0; t < kNumCharacters; ++t) {
+		animators[t].create(model);
+		animators[t].trackAddAmim(0, nullptr, 0);
+		// Offset the characters, so they do not sample the same keyframes.
+		animators[t].forceTrack(0, float(t % 97) / 97.f);
+
+		nodeTransforms[t].resize(numNodes);
+		animatorPtrs[t] = &animators[t];
+		nodeTransformsPtrs[t] = nodeTransforms[t].data();
+	}
+
+	const auto advanceAll = [&]() -> void {
+		for (ModelAnimator& animator : animators) {
+			animator.advanceAnimation(1.f / 60.f);
+		}
+	};
+
+	{
+		Timer timer;
+		for (int iFrame = 0; iFrame < kNumFrames; ++iFrame) {
+			advanceAll();
+			for (int t = 0; t < kNumCharacters; ++t) {
+				animators[t].computeModleNodesTrasnforms(nodeTransforms[t]);
+			}
+		}
+		timer.tick();
+
+		printf(
+		    "ModelAnimator %d characters, %d nodes, per character evaluation: %.3f ms\n",
+		    kNumCharacters,
+		    numNodes,
+		    timer.diff_seconds() * 1000.f / float(kNumFrames));
+	}
+
+	{
+		Timer timer;
+		for (int iFrame = 0; iFrame < kNumFrames; ++iFrame) {
+			advanceAll();
+			ModelAnimator::computeModleNodesTrasnformsBatch(
+			    animatorPtrs.data(), nodeTransformsPtrs.data(), kNumCharacters);
+		}
+		timer.tick();
+
+		printf(
+		    "ModelAnimator %d characters, %d nodes, batch evaluation: %.3f ms\n",
+		    kNumCharacters,
+		    numNodes,
+		    timer.diff_seconds() * 1000.f / float(kNumFrames));
+	}
+
+	{
+		ThreadPool threadPool(ThreadPool::getHardwareConcurrency());
+
+		Timer timer;
+		for (int iFrame = 0; iFrame < kNumFrames; ++iFrame) {
+			advanceAll();
+			ModelAnimator::computeModleNodesTrasnformsBatch(
+			    animatorPtrs.data(), nodeTransformsPtrs.data(), kNumCharacters, &threadPool);
+		}
+		timer.tick();
+
+		printf(
+		    "ModelAnimator %d characters, %d nodes, batch evaluation on %d workers: %.3f ms\n",
+		    kNumCharacters,
+		    numNodes,
+		    ThreadPool::getHardwareConcurrency(),
+		    timer.diff_seconds() * 1000.f / float(kNumFrames));
+	}
+
+	// Sanity check, the batched result of the last character must match a fresh animator advanced by the same time.
+	std::vector<mat4f> reference;
+	ModelAnimator referenceAnimator;
+	referenceAnimator.create(model);
+	referenceAnimator.trackAddAmim(0, nullptr, 0);
+	referenceAnimator.forceTrack(0, float((kNumCharacters - 1) % 97) / 97.f);
+	for (int iFrame = 0; iFrame < kNumFrames * 3; ++iFrame) {
+		referenceAnimator.advanceAnimation(1.f / 60.f);
+	}
+	referenceAnimator.computeModleNodesTrasnforms(reference);
+
+	const mat4f& batched = nodeTransforms[kNumCharacters - 1][numNodes - 1];
+	for (int c = 0; c < 4; ++c) {
+		for (int r = 0; r < 4; ++r) {
+			CHECK(std::abs(batched.data[c][r] - reference[numNodes - 1].data[c][r]) < 1e-3f);
+		}
+	}
+}
+
+} // namespace sge
@@ -0,0 +1,150 @@
+#include "doctest/doctest.h"
+#include "sge_core/model/Model.h"
+#include "sge_core/model/ModelReader.h"
+#include "sge_core/model/ModelWriter.h"
+#include "sge_utils/time/Timer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace sge {
+
+/// Creates a model with the size of a big imported FBX scene: many meshes with position/normal/uv vertices,
+/// a node per mesh and a long animation affecting all nodes.
+static void createBenchModel(Model& model, int numMeshes, int numVerticesPerMesh, int numKeys)
+{
+	const int iRoot = model.makeNewNode();
+	model.setRootNodeIndex(iRoot);
+	model.nodeAt(iRoot)->name = "root";
+
+	const int iMaterial = model.makeNewMaterial();
+	model.materialAt(iMaterial)->name = "material";
+	model.materialAt(iMaterial)->assetForThisMaterial = "material.mtl";
+
+	const int stride = int(sizeof(vec3f) * 2 + sizeof(vec2f));
+	for (int iMesh = 0; iMesh < numMeshes; ++iMesh) {
+		ModelMesh* const mesh = model.meshAt(model.makeNewMesh());
+		mesh->name = "mesh";
+		mesh->primitiveTopology = PrimitiveTopology::TriangleList;
+		mesh->vertexDecl.push_back(VertexDecl(0, "a_position", UniformType::Float3, 0));
+		mesh->vertexDecl.push_back(VertexDecl(0, "a_normal", UniformType::Float3, sizeof(vec3f)));
+		mesh->vertexDecl.push_back(VertexDecl(0, "a_uv", UniformType::Float2, sizeof(vec3f) * 2));
+		mesh->stride = stride;
+		mesh->numVertices = numVerticesPerMesh;
+		mesh->numElements = numVerticesPerMesh;
+		mesh->ibFmt = UniformType::Uint;
+
+		mesh->vertexBufferRaw.resize(size_t(numVerticesPerMesh) * stride);
+		for (size_t t = 0; t < mesh->vertexBufferRaw.size(); ++t) {
+			mesh->vertexBufferRaw[t] = char(t * 7 + iMesh);
+		}
+
+		mesh->indexBufferRaw.resize(size_t(numVerticesPerMesh) * sizeof(uint32));
+		uint32* const indices = (uint32*)mesh->indexBufferRaw.data();
+		for (int t = 0; t < numVerticesPerMesh; ++t) {
+			indices[t] = uint32(t);
+		}
+
+		mesh->aabox = Box3f(vec3f(-1.f), vec3f(1.f));
+
+		const int iNode = model.makeNewNode();
+		model.nodeAt(iNode)->name = "node";
+		model.nodeAt(iNode)->meshAttachments.push_back(MeshAttachment(iMesh, iMaterial));
+		model.nodeAt(iRoot)->childNodes.push_back(iNode);
+	}
+
+	ModelAnimation* const anim = model.animationAt(model.makeNewAnim());
+	anim->animationName = "bench";
+	anim->durationSec = 1.f;
+	for (int iNode = 0; iNode < model.numNodes(); ++iNode) {
+		KeyFrames& keyFrames = anim->getOrAddNodeKeyFrames(iNode);
+		for (int iKey = 0; iKey < numKeys; ++iKey) {
+			const float t = float(iKey) / float(numKeys - 1);
+			keyFrames.positionKeyFrames.setKey(t, vec3f(t, 0.f, 0.f));
+			keyFrames.rotationKeyFrames.setKey(t, quatf::getAxisAngle(vec3f::getAxis(1), t));
+			keyFrames.scalingKeyFrames.setKey(t, vec3f(1.f + t));
+		}
+	}
+}
+
+TEST_CASE("Model loading json-headed vs binary format")
+{
+	const int kNumMeshes = 40;
+	const int kNumVerticesPerMesh = 30000;
+	const int kNumKeys = 300;
+	const int kNumLoads = 5;
+
+	Model sourceModel;
+	createBenchModel(sourceModel, kNumMeshes, kNumVerticesPerMesh, kNumKeys);
+
+	const std::filesystem::path tempDir = std::filesystem::temp_directory_path();
+	const std::string jsonModelPath = (tempDir / "sge_bench_model_json.mdl").string();
+	const std::string binaryModelPath = (tempDir / "sge_bench_model_binary.mdl").string();
+
+	ModelWriter().write(sourceModel, jsonModelPath.c_str());
+	ModelWriter().writeBinary(sourceModel, binaryModelPath.c_str());
+
+	const auto benchLoading = [&](const std::string& path, const char* const formatName, Model& model) -> bool {
+		bool allSucceeded = true;
+
+		Timer timer;
+		for (int t = 0; t < kNumLoads; ++t) {
+			ModelReader modelReader;
+			allSucceeded &= modelReader.loadModelFromFile(ModelLoadSettings(), path.c_str(), model);
+		}
+		timer.tick();
+
+		printf(
+		    "Model loading %d meshes, %d vertices each, %d animation keys per node, %s format: %.3f ms\n",
+		    kNumMeshes,
+		    kNumVerticesPerMesh,
+		    kNumKeys,
+		    formatName,
+		    timer.diff_seconds() * 1000.f / float(kNumLoads));
+
+		return allSucceeded;
+	};
+
+	Model jsonModel;
+	CHECK(benchLoading(jsonModelPath, "json-headed", jsonModel));
+
+	Model binaryModel;
+	CHECK(benchLoading(binaryModelPath, "binary memory mapped", binaryModel));
+
+	// Sanity check, both formats must produce the same model.
+	REQUIRE(binaryModel.numMeshes() == jsonModel.numMeshes());
+	REQUIRE(binaryModel.numNodes() == jsonModel.numNodes());
+	for (int iMesh = 0; iMesh < binaryModel.numMeshes(); ++iMesh) {
+		const span<const char> jsonVertices = jsonModel.meshAt(iMesh)->getVertexBufferData();
+		const span<const char> binaryVertices = binaryModel.meshAt(iMesh)->getVertexBufferData();
+		REQUIRE(jsonVertices.size() == binaryVertices.size());
+		CHECK(memcmp(jsonVertices.data(), binaryVertices.data(), jsonVertices.size()) == 0);
+		CHECK(binaryModel.meshAt(iMesh)->stride == jsonModel.meshAt(iMesh)->stride);
+	}
+
+	const KeyFrames& jsonKeyFrames = jsonModel.animationAt(0)->perNodeKeyFrames[1];
+	const KeyFrames& binaryKeyFrames = binaryModel.animationAt(0)->perNodeKeyFrames[1];
+	CHECK(binaryKeyFrames.rotationKeyFrames.times == jsonKeyFrames.rotationKeyFrames.times);
+	CHECK(binaryKeyFrames.positionKeyFrames.values == jsonKeyFrames.positionKeyFrames.values);
+
+	// The geometry of the mapped model must survive writing it in the json-headed format.
+	ModelWriter().write(binaryModel, jsonModelPath.c_str());
+	Model rewrittenModel;
+	REQUIRE(ModelReader().loadModelFromFile(ModelLoadSettings(), jsonModelPath.c_str(), rewrittenModel));
+	REQUIRE(rewrittenModel.numMeshes() == binaryModel.numMeshes());
+	for (int iMesh = 0; iMesh < rewrittenModel.numMeshes(); ++iMesh) {
+		const ModelMesh* const binaryMesh = binaryModel.meshAt(iMesh);
+		const ModelMesh* const rewrittenMesh = rewrittenModel.meshAt(iMesh);
+		CHECK(rewrittenMesh->getVertexBufferData().size() == binaryMesh->getVertexBufferData().size());
+		CHECK(rewrittenMesh->getIndexBufferData().size() == binaryMesh->getIndexBufferData().size());
+	}
+
+	// The mapped file is released together with the model.
+	binaryModel = Model();
+	std::error_code removeError;
+	std::filesystem::remove(jsonModelPath, removeError);
+	std::filesystem::remove(binaryModelPath, removeError);
+}
+
+} // namespace sge
@@ -0,0 +1,187 @@
+#include "BenchNavMeshLevel.h"
+#include "doctest/doctest.h"
+#include "sge_engine/actors/NavigationService.h"
+#include "sge_utils/time/Timer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace sge {
+
+TEST_CASE("NavigationService 500 agents repathing across a 256x256m level")
+{
+	const int kNumAgents = 500;
+	const int kNumObstacles = 500;
+	const float kLevelSize = 256.f;
+	const float kPathQueriesBudgetMs = 2.f;
+	const float kFrameDt = 1.f / 30.f;
+
+	// Build the level.
+	BenchNavMeshLevel level(kNumObstacles, kLevelSize);
+	NavMeshInputGeometry geometry;
+	level.generateTriangles(geometry);
+
+	NavMeshBuildSets buildSets;
+	const Box3f boundsWs(
+	    vec3f(-kLevelSize * 0.5f, -1.f, -kLevelSize * 0.5f), vec3f(kLevelSize * 0.5f, 5.f, kLevelSize * 0.5f));
+
+	ThreadPool buildThreadPool(0);
+	dtNavMeshWrapper navMesh;
+	TiledNavMeshBuilder builder;
+	REQUIRE(builder.create(navMesh.object, buildSets, boundsWs));
+	builder.setGeometry(geometry);
+	builder.buildAllTiles(&buildThreadPool);
+
+	// Every agent goes from one side of the level to the other.
+	Random rnd;
+	std::vector<vec3f> startPoints;
+	std::vector<vec3f> endPoints;
+	const float halfLevelSize = kLevelSize * 0.5f;
+	for (int t = 0; t < kNumAgents; ++t) {
+		const float sideX = rnd.nextInRange(halfLevelSize - 24.f, halfLevelSize - 4.f);
+		startPoints.push_back(vec3f(-sideX, 0.f, rnd.nextInRange(-halfLevelSize + 4.f, halfLevelSize - 4.f)));
+		endPoints.push_back(vec3f(sideX, 0.f, rnd.nextInRange(-halfLevelSize + 4.f, halfLevelSize - 4.f)));
+	}
+
+	const vec3f searchHalfDiagonal = vec3f(2.f);
+
+	// All paths searched immediately on the calling thread, the way INavMesh::findPath does it.
+	std::vector<std::vector<vec3f>> syncPaths(kNumAgents);
+	int numSyncPathsFound = 0;
+	{
+		dtNavMeshQueryWrapper query;
+		query->init(navMesh.object, 2048);
+
+		Timer timer;
+		for (int t = 0; t < kNumAgents; ++t) {
+			if (findNavMeshPath(*query.object, syncPaths[t], startPoints[t], endPoints[t], searchHalfDiagonal)) {
+				numSyncPathsFound++;
+			}
+		}
+		timer.tick();
+
+		printf(
+		    "NavigationService %d paths found synchronously in a single frame: %.2f ms\n",
+		    kNumAgents,
+		    timer.diff_seconds() * 1000.f);
+	}
+
+	REQUIRE(numSyncPathsFound == kNumAgents);
+
+	// The same paths as batched requests, spread over frames and threads.
+	for (int numWorkers : {1, 2, 4, 8}) {
+		ThreadPool threadPool(numWorkers);
+		NavigationService navigation;
+		REQUIRE(navigation.create(navMesh.object, kNumAgents, 1.f, numWorkers));
+		navigation.setPathQueriesBudgetMs(kPathQueriesBudgetMs);
+
+		std::vector<NavPathRequestId> requests;
+		for (int t = 0; t < kNumAgents; ++t) {
+			requests.push_back(navigation.requestPath(startPoints[t], endPoints[t], searchHalfDiagonal));
+		}
+
+		int numFrames = 0;
+		float maxFrameMs = 0.f;
+		Timer totalTimer;
+		while (navigation.getNumPendingPathRequests() > 0 && numFrames < 10000) {
+			Timer frameTimer;
+			navigation.update(kFrameDt, &threadPool);
+			frameTimer.tick();
+			maxFrameMs = std::max(maxFrameMs, frameTimer.diff_seconds() * 1000.f);
+			numFrames++;
+		}
+		totalTimer.tick();
+
+		int numBatchedPathsFound = 0;
+		int numPathsMatchingSync = 0;
+		std::vector<vec3f> path;
+		for (int t = 0; t < kNumAgents; ++t) {
+			CHECK(navigation.getPathRequestStatus(requests[t]) != navPathRequestStatus_pending);
+			if (navigation.takePathResult(requests[t], path)) {
+				numBatchedPathsFound++;
+				// The sliced search may choose a different route between equally good ones, but it should end
+				// at the same place.
+				if ((path.back() - syncPaths[t].back()).length() < 1e-3f) {
+					numPathsMatchingSync++;
+				}
+			}
+		}
+
+		CHECK(navigation.getPathRequestStatus(requests[0]) == navPathRequestStatus_invalid);
+		CHECK(numBatchedPathsFound == numSyncPathsFound);
+		CHECK(numPathsMatchingSync == numSyncPathsFound);
+
+		printf(
+		    "NavigationService %d batched paths, %d workers: %d frames, %.2f ms total, the slowest frame %.2f ms\n",
+		    kNumAgents,
+		    numWorkers,
+		    numFrames,
+		    totalTimer.diff_seconds() * 1000.f,
+		    maxFrameMs);
+	}
+
+	// Crowd agents walking across the level, then all of them turning back on the same frame.
+	{
+		ThreadPool threadPool(0);
+		NavigationService navigation;
+		REQUIRE(navigation.create(navMesh.object, kNumAgents, 1.f, threadPool.getNumWorkers()));
+
+		NavAgentParams agentParams;
+		agentParams.radius = 0.4f;
+		std::vector<int> agents;
+		for (int t = 0; t < kNumAgents; ++t) {
+			agents.push_back(navigation.addAgent(startPoints[t], agentParams));
+			CHECK(navigation.setAgentTarget(agents.back(), endPoints[t]));
+		}
+
+		CHECK(navigation.getNumActiveAgents() == kNumAgents);
+
+		const auto getAverageDistanceToEnd = [&]() -> float {
+			float totalDistance = 0.f;
+			for (int t = 0; t < kNumAgents; ++t) {
+				totalDistance += (navigation.getAgentPosition(agents[t]) - endPoints[t]).length();
+			}
+			return totalDistance / float(kNumAgents);
+		};
+
+		const auto simulateFrames = [&](int numFrames, float& outAverageMs, float& outMaxMs) -> void {
+			outMaxMs = 0.f;
+			Timer totalTimer;
+			for (int iFrame = 0; iFrame < numFrames; ++iFrame) {
+				Timer frameTimer;
+				navigation.update(kFrameDt, &threadPool);
+				frameTimer.tick();
+				outMaxMs = std::max(outMaxMs, frameTimer.diff_seconds() * 1000.f);
+			}
+			totalTimer.tick();
+			outAverageMs = totalTimer.diff_seconds() * 1000.f / float(numFrames);
+		};
+
+		const float distanceBeforeWalking = getAverageDistanceToEnd();
+
+		float walkAverageMs = 0.f;
+		float walkMaxMs = 0.f;
+		simulateFrames(90, walkAverageMs, walkMaxMs);
+
+		// The agents should have made some progress towards their targets.
+		CHECK(getAverageDistanceToEnd() < distanceBeforeWalking - 1.f);
+
+		for (int t = 0; t < kNumAgents; ++t) {
+			CHECK(navigation.setAgentTarget(agents[t], startPoints[t]));
+		}
+
+		float repathAverageMs = 0.f;
+		float repathMaxMs = 0.f;
+		simulateFrames(30, repathAverageMs, repathMaxMs);
+
+		printf(
+		    "NavigationService %d crowd agents: update %.2f ms (max %.2f ms), after all repath %.2f ms (max %.2f ms)\n",
+		    kNumAgents,
+		    walkAverageMs,
+		    walkMaxMs,
+		    repathAverageMs,
+		    repathMaxMs);
+	}
+}
+
+} // namespace sge
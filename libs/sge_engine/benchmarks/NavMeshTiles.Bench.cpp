@@ -0,0 +1,132 @@
+#include "BenchNavMeshLevel.h"
+#include "doctest/doctest.h"
+#include "sge_utils/time/Timer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace sge {
+
+/// Returns true if there is a walkable polygon near the specified point.
+static bool hasPolygonNear(const dtNavMesh& navMesh, const vec3f& point)
+{
+	dtNavMeshQueryWrapper query;
+	query->init(&navMesh, 512);
+
+	const vec3f halfExtents = vec3f(0.1f, 0.5f, 0.1f);
+	dtQueryFilter filter;
+	dtPolyRef polyRef = 0;
+	query->findNearestPoly(point.data, halfExtents.data, &filter, &polyRef, nullptr);
+	return polyRef != 0;
+}
+
+/// Returns true if there is a path between the two points.
+static bool hasPathBetween(const dtNavMesh& navMesh, const vec3f& start, const vec3f& end)
+{
+	dtNavMeshQueryWrapper query;
+	query->init(&navMesh, 4096);
+
+	const vec3f halfExtents = vec3f(1.f);
+	dtQueryFilter filter;
+	dtPolyRef startRef = 0;
+	dtPolyRef endRef = 0;
+	query->findNearestPoly(start.data, halfExtents.data, &filter, &startRef, nullptr);
+	query->findNearestPoly(end.data, halfExtents.data, &filter, &endRef, nullptr);
+	if (startRef == 0 || endRef == 0) {
+		return false;
+	}
+
+	dtPolyRef path[1024];
+	int pathLength = 0;
+	query->findPath(startRef, endRef, start.data, end.data, &filter, path, &pathLength, SGE_ARRSZ(path));
+	return pathLength > 0 && path[pathLength - 1] == endRef;
+}
+
+TEST_CASE("NavMesh solo vs tiled build, 256x256m level, 500 obstacles")
+{
+	const int kNumObstacles = 500;
+	const float kLevelSize = 256.f;
+
+	NavMeshBuildSets buildSets;
+	buildSets.tileSize = 32.f;
+
+	BenchNavMeshLevel level(kNumObstacles, kLevelSize);
+	NavMeshInputGeometry geometry;
+	level.generateTriangles(geometry);
+
+	const Box3f boundsWs(
+	    vec3f(-kLevelSize * 0.5f, -1.f, -kLevelSize * 0.5f), vec3f(kLevelSize * 0.5f, 5.f, kLevelSize * 0.5f));
+	const vec3f pathStart = vec3f(-kLevelSize * 0.5f + 1.f, 0.f, -kLevelSize * 0.5f + 1.f);
+	const vec3f pathEnd = vec3f(kLevelSize * 0.5f - 1.f, 0.f, kLevelSize * 0.5f - 1.f);
+
+	// The whole level as a single piece, on a single thread.
+	Timer timer;
+	unsigned char* soloNavData = nullptr;
+	int soloNavDataSize = 0;
+	REQUIRE(buildNavMeshData(buildSets, boundsWs, 0, 0, 0, geometry, nullptr, soloNavData, soloNavDataSize));
+	REQUIRE(soloNavData != nullptr);
+	dtNavMeshWrapper soloNavMesh;
+	REQUIRE(dtStatusSucceed(soloNavMesh->init(soloNavData, soloNavDataSize, DT_TILE_FREE_DATA)));
+	timer.tick();
+	const float soloBuildMs = timer.diff_seconds() * 1000.f;
+	CHECK(hasPathBetween(*soloNavMesh.object, pathStart, pathEnd));
+
+	printf("NavMesh %d triangles, solo build: %.1f ms\n", geometry.getNumTriangles(), soloBuildMs);
+
+	for (int numWorkers : {1, 2, 4, 8}) {
+		ThreadPool threadPool(numWorkers);
+		dtNavMeshWrapper tiledNavMesh;
+		TiledNavMeshBuilder builder;
+
+		timer.tick();
+		REQUIRE(builder.create(tiledNavMesh.object, buildSets, boundsWs));
+		builder.setGeometry(geometry);
+		builder.buildAllTiles(&threadPool);
+		timer.tick();
+		const float tiledBuildMs = timer.diff_seconds() * 1000.f;
+
+		CHECK(hasPathBetween(*tiledNavMesh.object, pathStart, pathEnd));
+
+		// Move a single obstacle, only the tiles around its old and new location need to be rebuilt.
+		const int iMovedObstacle = 0;
+		const Box3f oldObstacleBox = level.getObstacleBox(iMovedObstacle);
+		const vec3f oldObstacleGround = oldObstacleBox.center() * vec3f(1.f, 0.f, 1.f);
+		CHECK(hasPolygonNear(*tiledNavMesh.object, oldObstacleGround) == false);
+
+		level.obstaclesPositions[iMovedObstacle] = vec3f(0.5f, 1.f, 0.5f);
+		const Box3f newObstacleBox = level.getObstacleBox(iMovedObstacle);
+
+		timer.tick();
+		NavMeshInputGeometry movedGeometry;
+		level.generateTriangles(movedGeometry);
+
+		std::vector<int> dirtyTiles;
+		builder.findTilesOverlapping(oldObstacleBox, dirtyTiles);
+		builder.findTilesOverlapping(newObstacleBox, dirtyTiles);
+		std::sort(dirtyTiles.begin(), dirtyTiles.end());
+		dirtyTiles.erase(std::unique(dirtyTiles.begin(), dirtyTiles.end()), dirtyTiles.end());
+
+		builder.setGeometry(std::move(movedGeometry));
+		builder.buildTiles(dirtyTiles, &threadPool);
+		timer.tick();
+		const float incrementalUpdateMs = timer.diff_seconds() * 1000.f;
+
+		CHECK(hasPolygonNear(*tiledNavMesh.object, oldObstacleGround));
+		CHECK(hasPolygonNear(*tiledNavMesh.object, newObstacleBox.center() * vec3f(1.f, 0.f, 1.f)) == false);
+		CHECK(hasPathBetween(*tiledNavMesh.object, pathStart, pathEnd));
+
+		printf(
+		    "NavMesh %d tiles, %d workers: full build %.1f ms (%.2fx solo), 1 obstacle moved: %d tiles in %.2f ms\n",
+		    builder.getNumTiles(),
+		    numWorkers,
+		    tiledBuildMs,
+		    soloBuildMs / tiledBuildMs,
+		    int(dirtyTiles.size()),
+		    incrementalUpdateMs);
+
+		// Put the obstacle back for the next run.
+		level.obstaclesPositions[iMovedObstacle] = oldObstacleBox.center();
+	}
+}
+
+} // namespace sge
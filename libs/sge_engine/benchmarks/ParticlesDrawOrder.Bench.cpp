@@ -0,0 +1,87 @@
+#include "doctest/doctest.h"
+#include "sge_engine/traits/TraitParticles.h"
+#include "sge_utils/time/Timer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace sge {
+
+TEST_CASE("ParticleGroupState draw order 100k particles")
+{
+	const int kNumParticles = 100000;
+	const int kNumFrames = 60;
+	const float kDt = 1.f / 60.f;
+
+	ParticleGroupDesc desc;
+	desc.m_name = "bench";
+	desc.birth.instantBirthCount = kNumParticles;
+	desc.birth.maxLife = 100.f;
+	desc.birthShape.shapeType = birthShape_sphere;
+	desc.birthShape.sphere.sphereIsVolume = true;
+	desc.birthShape.sphere.sphereRadius = 10.f;
+	desc.initialVelocty.forceType = VelictyForce_spherical;
+	desc.initialVelocty.spherical.velocityAmount = 0.5f;
+
+	ParticleGroupState state;
+	state.update(true, mat4f::getIdentity(), desc, kDt);
+	REQUIRE(state.getParticles().size() == kNumParticles);
+
+	const vec3f camLookWs = normalized(vec3f(-1.f, -0.5f, -1.f));
+	const auto getCameraPosition = [&](int iFrame) -> vec3f {
+		// The camera slowly orbits around the particles.
+		const float angle = float(iFrame) * 0.01f;
+		return vec3f(30.f * cosf(angle), 15.f, 30.f * sinf(angle));
+	};
+
+	const auto computeDepth = [&](const vec3f& camPosWs, int iParticle) -> float {
+		return dot(state.getParticles().getPosition(iParticle) - camPosWs, camLookWs);
+	};
+
+	// The reference, sorting all particles with std::sort every frame.
+	std::vector<Pair<float, int>> referenceOrder(kNumParticles);
+	Timer timer;
+	for (int iFrame = 0; iFrame < kNumFrames; ++iFrame) {
+		const vec3f camPosWs = getCameraPosition(iFrame);
+		for (int t = 0; t < kNumParticles; ++t) {
+			referenceOrder[t] = Pair<float, int>(computeDepth(camPosWs, t), t);
+		}
+		std::sort(referenceOrder.begin(), referenceOrder.end(), [](const auto& a, const auto& b) -> bool {
+			return a.first > b.first;
+		});
+		state.update(true, mat4f::getIdentity(), desc, kDt);
+	}
+	timer.tick();
+	const float stdSortMs = timer.diff_seconds() * 1000.f / float(kNumFrames);
+
+	timer.reset();
+	bool isBackToFront = true;
+	for (int iFrame = 0; iFrame < kNumFrames; ++iFrame) {
+		const vec3f camPosWs = getCameraPosition(iFrame);
+		const std::vector<uint32>& drawOrder = state.computeDrawOrder(camPosWs, camLookWs);
+
+		// Validate a frame, the depth is quantized so allow some error.
+		if (iFrame == kNumFrames / 2) {
+			const float kMaxDepthError = 1e-3f;
+			for (size_t t = 1; t < drawOrder.size(); ++t) {
+				isBackToFront &=
+				    computeDepth(camPosWs, drawOrder[t - 1]) + kMaxDepthError >= computeDepth(camPosWs, drawOrder[t]);
+			}
+		}
+
+		state.update(true, mat4f::getIdentity(), desc, kDt);
+	}
+	timer.tick();
+	const float radixSortMs = timer.diff_seconds() * 1000.f / float(kNumFrames);
+
+	printf(
+	    "ParticleGroupState draw order %d particles (including simulation): std::sort %.3f ms, warm started radix sort "
+	    "%.3f ms per frame\n",
+	    kNumParticles,
+	    stdSortMs,
+	    radixSortMs);
+
+	CHECK(isBackToFront);
+}
+
+} // namespace sge
@@ -0,0 +1,87 @@
+#include "doctest/doctest.h"
+#include "sge_engine/traits/TraitParticles.h"
+#include "sge_utils/threading/ThreadPool.h"
+#include "sge_utils/time/Timer.h"
+
+#include <cstdio>
+
+namespace sge {
+
+/// Creates a particle group that spawns @instantBirthCount particles at once, that are pulled down and towards a point,
+/// slowed down by drag and faded in and out. Most of the particles die during the benchmark.
+static ParticleGroupDesc createBenchParticleGroup(int instantBirthCount)
+{
+	ParticleGroupDesc desc;
+	desc.m_name = "bench";
+	desc.birth.instantBirthCount = instantBirthCount;
+	desc.birth.passiveBirthCountPerSecond = instantBirthCount / 4;
+	desc.birth.maxLife = 1.5f;
+	desc.birth.maxLifeVariation = 0.5f;
+	desc.birthShape.shapeType = birthShape_sphere;
+	desc.birthShape.sphere.sphereIsVolume = true;
+	desc.birthShape.sphere.sphereRadius = 5.f;
+
+	desc.initialVelocty.forceType = VelictyForce_spherical;
+	desc.initialVelocty.spherical.velocityAmount = 2.f;
+
+	Velocity gravity;
+	gravity.forceType = VelictyForce_directional;
+	gravity.directional.velocityAmount = 0.1f;
+	desc.velocityForces.push_back(gravity);
+
+	Velocity attractor;
+	attractor.forceType = VelictyForce_towardsPoint;
+	attractor.towardsPoint.pointLocation = vec3f(0.f, 10.f, 0.f);
+	attractor.towardsPoint.velocityAmount = 0.05f;
+	desc.velocityForces.push_back(attractor);
+
+	desc.velocityDrag = vec3f(0.5f);
+	desc.alpha.fadeInTimeAfterBirth = 0.2f;
+	desc.alpha.fadeOutTimeBeforeDeath = 0.3f;
+
+	return desc;
+}
+
+TEST_CASE("ParticleGroupState simulation 100k particles")
+{
+	const int kNumParticles = 100000;
+	const int kNumFrames = 120;
+	const float kDt = 1.f / 60.f;
+
+	const ParticleGroupDesc desc = createBenchParticleGroup(kNumParticles);
+	const mat4f node2world = mat4f::getTranslation(1.f, 2.f, 3.f);
+
+	const auto benchSimulation = [&](ThreadPool* const threadPool, const char* const modeName) -> void {
+		ParticleGroupState state;
+
+		// The 1st update spawns all particles.
+		state.update(true, node2world, desc, kDt, threadPool);
+		CHECK(state.getParticles().size() >= kNumParticles);
+
+		int maxParticlesAlive = 0;
+		Timer timer;
+		for (int iFrame = 0; iFrame < kNumFrames; ++iFrame) {
+			state.update(true, node2world, desc, kDt, threadPool);
+			maxParticlesAlive = std::max(maxParticlesAlive, state.getParticles().size());
+		}
+		timer.tick();
+
+		printf(
+		    "ParticleGroupState %d particles (max %d alive), %s: %.3f ms per frame\n",
+		    kNumParticles,
+		    maxParticlesAlive,
+		    modeName,
+		    timer.diff_seconds() * 1000.f / float(kNumFrames));
+
+		// After 2 seconds all the initial particles must be dead and only the passively spawned remain.
+		CHECK(state.getParticles().size() < kNumParticles);
+		CHECK(state.getBBox().isEmpty() == false);
+	};
+
+	benchSimulation(nullptr, "single thread");
+
+	ThreadPool threadPool(ThreadPool::getHardwareConcurrency());
+	benchSimulation(&threadPool, "multiple threads");
+}
+
+} // namespace sge
@@ -0,0 +1,133 @@
+#include "doctest/doctest.h"
+#include "sge_engine/GameWorld.h"
+#include "sge_engine/traits/TraitRigidBody.h"
+#include "sge_engine/typelibHelper.h"
+#include "sge_utils/time/Timer.h"
+
+#include <cstdio>
+
+namespace sge {
+
+/// A dynamic unit box.
+struct ABenchPhysicsBox : public Actor {
+	Box3f getBBoxOS() const override { return Box3f::getFromHalfDiagonal(vec3f(0.5f)); }
+
+	void create() override
+	{
+		registerTrait(m_traitRB);
+		m_traitRB.getRigidBody()->create(this, CollsionShapeDesc::createBox(getBBoxOS()), 1.f, false);
+	}
+
+	TraitRigidBody m_traitRB;
+};
+
+/// A static box the stacks are standing on, its top is at y = 0.
+struct ABenchPhysicsGround : public Actor {
+	Box3f getBBoxOS() const override { return Box3f(vec3f(-100.f, -1.f, -100.f), vec3f(100.f, 0.f, 100.f)); }
+
+	void create() override
+	{
+		registerTrait(m_traitRB);
+		m_traitRB.getRigidBody()->create(this, CollsionShapeDesc::createBox(getBBoxOS()), 0.f, false);
+	}
+
+	TraitRigidBody m_traitRB;
+};
+
+ReflBlock()
+{
+	ReflAddActor(ABenchPhysicsBox);
+	ReflAddActor(ABenchPhysicsGround);
+}
+
+struct PhysicsStackingResult {
+	float updateMs = 0.f;
+	int numManifolds = 0;
+	int numBoxesWithContacts = 0;
+	int numBoxesFallenThrough = 0;
+};
+
+/// Creates a grid of box stacks, simulates them and measures the average time GameWorld::update takes.
+/// Each stack is a separate simulation island, so the solver pool has something to work on in parallel.
+PhysicsStackingResult measurePhysicsStacking(int numStacksPerSide, int stackHeight, int numWorkers, int numFrames)
+{
+	GameWorld world;
+	world.setNumPhysicsWorkers(numWorkers);
+	world.setNumUpdateWorkers(numWorkers);
+	world.create();
+
+	world.allocObjectT<ABenchPhysicsGround>();
+
+	std::vector<ABenchPhysicsBox*> boxes;
+	const float stackSpacing = 1.5f;
+	const float stacksOffset = -0.5f * stackSpacing * float(numStacksPerSide - 1);
+	for (int iX = 0; iX < numStacksPerSide; ++iX) {
+		for (int iZ = 0; iZ < numStacksPerSide; ++iZ) {
+			for (int iY = 0; iY < stackHeight; ++iY) {
+				ABenchPhysicsBox* const box = world.allocObjectT<ABenchPhysicsBox>();
+				box->setPosition(vec3f(
+				    stacksOffset + float(iX) * stackSpacing,
+				    0.5f + float(iY) * 1.01f,
+				    stacksOffset + float(iZ) * stackSpacing));
+				boxes.push_back(box);
+			}
+		}
+	}
+
+	const GameUpdateSets updateSets(1.f / 60.f, false, InputState());
+
+	// The 1st update adds the objects to the playing list and to the physics world.
+	world.update(updateSets);
+
+	Timer timer;
+	for (int iFrame = 0; iFrame < numFrames; ++iFrame) {
+		world.update(updateSets);
+	}
+	timer.tick();
+
+	PhysicsStackingResult result;
+	result.updateMs = timer.diff_seconds() * 1000.f / float(numFrames);
+	result.numManifolds = world.physicsWorld.dynamicsWorld->getDispatcher()->getNumManifolds();
+	for (ABenchPhysicsBox* const box : boxes) {
+		if (world.getRigidBodyManifolds(box->m_traitRB.getRigidBody()).size() != 0) {
+			result.numBoxesWithContacts++;
+		}
+
+		if (box->getPosition().y < 0.f) {
+			result.numBoxesFallenThrough++;
+		}
+	}
+
+	return result;
+}
+
+TEST_CASE("PhysicsWorld stacked boxes, 1 to 8 workers")
+{
+	const int kNumStacksPerSide = 12;
+	const int kStackHeight = 20;
+	const int kNumFrames = 120;
+	const int kNumBoxes = kNumStacksPerSide * kNumStacksPerSide * kStackHeight;
+
+	float singleThreadedMs = 0.f;
+	for (int numWorkers = 1; numWorkers <= 8; ++numWorkers) {
+		const PhysicsStackingResult result =
+		    measurePhysicsStacking(kNumStacksPerSide, kStackHeight, numWorkers, kNumFrames);
+		if (numWorkers == 1) {
+			singleThreadedMs = result.updateMs;
+		}
+
+		printf(
+		    "Physics %d stacked boxes, %d workers: update %.3f ms (%.2fx), %d manifolds\n",
+		    kNumBoxes,
+		    numWorkers,
+		    result.updateMs,
+		    singleThreadedMs / result.updateMs,
+		    result.numManifolds);
+
+		// Every box lies on the ground or on another box.
+		CHECK(result.numBoxesWithContacts == kNumBoxes);
+		CHECK(result.numBoxesFallenThrough == 0);
+	}
+}
+
+} // namespace sge
@@ -0,0 +1,14 @@
+#define DOCTEST_CONFIG_IMPLEMENT
+#include "doctest/doctest.h"
+#include "sge_core/typelib/typeLib.h"
+
+int main(int argc, char* argv[])
+{
+	// The benchmarks create game objects, so the reflection must be ready.
+	sge::typeLib().performRegistration();
+
+	doctest::Context ctx;
+	ctx.applyCommandLine(argc, argv);
+
+	return ctx.run();
+}
@@ -0,0 +1,184 @@
+#include "doctest/doctest.h"
+#include "sge_codepreproc/sge_codepreproc.h"
+#include "sge_renderer/renderer/HLSLTranslator.h"
+#include "sge_utils/io/FileStream.h"
+#include "sge_utils/text/format.h"
+#include "sge_utils/threading/ThreadPool.h"
+#include "sge_utils/time/Timer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace sge {
+
+/// A shader from core_shaders with the names of its compile time options, every option is either 0 or 1.
+struct BenchCoreShader {
+	const char* filename;
+	std::vector<const char*> options;
+};
+
+/// The native code of both stages of a shader permutation.
+struct BenchShaderStages {
+	bool succeeded = false;
+	std::string vsNativeCode;
+	std::string psNativeCode;
+};
+
+TEST_CASE("Translating all core shader permutations, mcpp vs the built-in preprocessor")
+{
+	// The same shaders and options as the ones used by sge_core.
+	const std::string includeDir = SGE_BENCH_CORE_SHADERS_DIR;
+	const std::vector<BenchCoreShader> shaders = {
+	    {"ConstantColor.hlsl", {"OPT_HasVertexSkinning"}},
+	    {"FWDDefault_buildShadowMaps.hlsl",
+	     {"OPT_LightType", "OPT_HasVertexSkinning", "OPT_HasDiffuseTexForAlphaMasking"}},
+	    {"FWDDefault_shading.hlsl",
+	     {"OPT_HasVertexColor", "OPT_HasUV", "OPT_HasTangentSpace", "OPT_HasVertexSkinning"}},
+	    {"FWDSimpleTriplanar.hlsl", {}},
+	    {"SkyGradient.hlsl", {}},
+	    {"SpriteParticles.hlsl", {}},
+	};
+
+	// The options are defined at the top of the code, like ShadingProgramPermuator does.
+	std::vector<std::string> permutations;
+	for (const BenchCoreShader& shader : shaders) {
+		std::string shaderCode;
+		REQUIRE(FileReadStream::readTextFile((includeDir + "/" + shader.filename).c_str(), shaderCode));
+
+		const int numOptions = int(shader.options.size());
+		for (int iPerm = 0; iPerm < (1 << numOptions); ++iPerm) {
+			std::string code;
+			for (int iOpt = 0; iOpt < numOptions; ++iOpt) {
+				code += string_format("#define %s %d\n", shader.options[iOpt], (iPerm >> iOpt) & 1);
+			}
+			permutations.emplace_back(code + shaderCode);
+		}
+	}
+
+	const int numPerms = int(permutations.size());
+	std::vector<const char*> vsMacros;
+	if (ShadingLanguage::ApiNative == ShadingLanguage::GLSL) {
+		vsMacros.push_back("OpenGL");
+	}
+	std::vector<const char*> psMacros = vsMacros;
+	psMacros.push_back("SGE_PIXEL_SHADER");
+
+	ThreadPool threadPool;
+	threadPool.create(std::min(numPerms, ThreadPool::getHardwareConcurrency()));
+
+	// Does the same steps as ShadingProgram::translateCustomHLSL with the include directory of the sources.
+	// @preprocessFn preprocesses the code of both stages.
+	const auto translateAll = [&](const char* const name, const auto& preprocessFn) -> std::vector<BenchShaderStages> {
+		std::vector<BenchShaderStages> translated(numPerms);
+
+		Timer timer;
+		timer.tick();
+		threadPool.parallelFor(numPerms, 1, [&](int begin, int end) -> void {
+			for (int iPerm = begin; iPerm < end; ++iPerm) {
+				std::string vsCode;
+				std::string psCode;
+				preprocessFn(permutations[iPerm], vsCode, psCode);
+
+				std::string errors;
+				BenchShaderStages& result = translated[iPerm];
+				result.succeeded = translatePreprocessedHLSL(
+				                       vsCode,
+				                       ShadingLanguage::ApiNative,
+				                       ShaderType::VertexShader,
+				                       result.vsNativeCode,
+				                       errors) &&
+				                   translatePreprocessedHLSL(
+				                       psCode,
+				                       ShadingLanguage::ApiNative,
+				                       ShaderType::PixelShader,
+				                       result.psNativeCode,
+				                       errors);
+			}
+		});
+		timer.tick();
+
+		printf(
+		    "Shader translation of %d permutations on %d threads, %s: %.2f ms\n",
+		    numPerms,
+		    threadPool.getNumWorkers(),
+		    name,
+		    timer.diff_seconds() * 1000.f);
+		return translated;
+	};
+
+	// Each stage is preprocessed by mcpp, one permutation at a time as mcpp isn't thread-safe.
+	const std::vector<BenchShaderStages> mcppTranslated =
+	    translateAll("mcpp", [&](const std::string& code, std::string& vsCode, std::string& psCode) -> void {
+		    vsCode = preprocessCodeMcpp(
+		        code.c_str(), "<NO-FILE>", vsMacros.data(), int(vsMacros.size()), includeDir, nullptr);
+		    psCode = preprocessCodeMcpp(
+		        code.c_str(), "<NO-FILE>", psMacros.data(), int(psMacros.size()), includeDir, nullptr);
+	    });
+
+	// The built-in preprocessor runs on all threads and the stages share the result if the code doesn't check
+	// SGE_PIXEL_SHADER.
+	const std::vector<BenchShaderStages> builtinTranslated =
+	    translateAll("built-in", [&](const std::string& code, std::string& vsCode, std::string& psCode) -> void {
+		    bool isShaderTypeDependant = true;
+		    vsCode = preprocessCode(
+		        code.c_str(),
+		        "<NO-FILE>",
+		        vsMacros.data(),
+		        int(vsMacros.size()),
+		        includeDir,
+		        nullptr,
+		        "SGE_PIXEL_SHADER",
+		        &isShaderTypeDependant);
+		    if (isShaderTypeDependant) {
+			    psCode = preprocessCode(
+			        code.c_str(), "<NO-FILE>", psMacros.data(), int(psMacros.size()), includeDir, nullptr);
+		    }
+		    else {
+			    psCode = vsCode;
+		    }
+	    });
+
+	// The results should be the same and the built-in preprocessor should support everything used in core_shaders.
+	int numBuiltinFailed = 0;
+	int numSharedStages = 0;
+	for (int iPerm = 0; iPerm < numPerms; ++iPerm) {
+		std::string code;
+		bool isShaderTypeDependant = true;
+		const bool isSupported = preprocessCodeBuiltin(
+		    code,
+		    permutations[iPerm].c_str(),
+		    "<NO-FILE>",
+		    vsMacros.data(),
+		    int(vsMacros.size()),
+		    includeDir,
+		    nullptr,
+		    "SGE_PIXEL_SHADER",
+		    &isShaderTypeDependant);
+		numBuiltinFailed += isSupported ? 0 : 1;
+		numSharedStages += isShaderTypeDependant ? 0 : 1;
+
+		CHECK(mcppTranslated[iPerm].succeeded);
+		CHECK(builtinTranslated[iPerm].succeeded);
+		CHECK(mcppTranslated[iPerm].vsNativeCode == builtinTranslated[iPerm].vsNativeCode);
+		CHECK(mcppTranslated[iPerm].psNativeCode == builtinTranslated[iPerm].psNativeCode);
+	}
+
+	printf("Shader translation, %d of %d permutations preprocessed once for both stages\n", numSharedStages, numPerms);
+	CHECK(numBuiltinFailed == 0);
+}
+
+TEST_CASE("The built-in preprocessor leaves unterminated literals to mcpp")
+{
+	// The apostrophe would otherwise be closed by the one in the second block, swallowing the lines between them.
+	const char* const code = "#if 0\nThis isn't used.\n#endif\n#if 0\n'\n#endif\nfloat4 color;\n";
+	std::string result;
+	CHECK(!preprocessCodeBuiltin(result, code, "<NO-FILE>", nullptr, 0, "", nullptr));
+
+	const char* const closedCode = "#if 0\nchar a = 'a'; \"b\"\n#endif\nfloat4 color;\n";
+	CHECK(preprocessCodeBuiltin(result, closedCode, "<NO-FILE>", nullptr, 0, "", nullptr));
+	CHECK(result.find("float4 color;") != std::string::npos);
+}
+
+} // namespace sge
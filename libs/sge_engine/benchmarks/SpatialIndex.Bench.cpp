@@ -0,0 +1,155 @@
+#include "doctest/doctest.h"
+#include "sge_core/Camera.h"
+#include "sge_engine/GameWorld.h"
+#include "sge_engine/typelibHelper.h"
+#include "sge_renderer/renderer/renderer.h"
+#include "sge_utils/math/Random.h"
+#include "sge_utils/time/Timer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace sge {
+
+/// A static actor, like the props that make most of a level. It is never updated.
+struct ABenchStaticProp : public Actor {
+	Box3f getBBoxOS() const override { return Box3f(vec3f(-1.f), vec3f(1.f)); }
+	void create() override {}
+};
+
+ReflBlock()
+{
+	ReflAddActor(ABenchStaticProp);
+}
+
+/// The culling done by DefaultGameDrawer before the spatial index, a bounding sphere test for every playing actor.
+static void cullByWalkingTheScene(GameWorld& world, const Frustum& frustumWs, std::vector<Actor*>& outActors)
+{
+	world.iterateOverPlayingObjects(
+	    [&](GameObject* object) -> bool {
+		    if (Actor* actor = object->getActor()) {
+			    const Box3f bboxOS = actor->getBBoxOS();
+			    const transf3d& tr = actor->getTransform();
+			    const vec3f spherePos = mat_mul_pos(actor->getTransformMtx(), bboxOS.center());
+			    const float sphereRadius = bboxOS.halfDiagonal().length() * tr.s.componentMaxAbs();
+			    if (!frustumWs.isSphereOutside(spherePos, sphereRadius)) {
+				    outActors.push_back(actor);
+			    }
+		    }
+		    return true;
+	    },
+	    false);
+}
+
+TEST_CASE("GameWorld spatial index 20k actors, 8 shadowed point lights")
+{
+	const int kNumActors = 20000;
+	const int kNumPointLights = 8;
+	const int kNumFrames = 10;
+
+	GameWorld world;
+	world.create();
+
+	Random rnd;
+	for (int t = 0; t < kNumActors; ++t) {
+		ABenchStaticProp* const actor = world.allocObjectT<ABenchStaticProp>();
+		actor->setPosition(
+		    vec3f(rnd.nextInRange(-500.f, 500.f), rnd.nextInRange(0.f, 10.f), rnd.nextInRange(-500.f, 500.f)));
+	}
+
+	// The 1st update adds the objects to the playing list and to the spatial index.
+	const GameUpdateSets updateSets(1.f / 60.f, false, InputState());
+	world.update(updateSets);
+
+	// The main camera and 6 cube map face cameras for each point light.
+	std::vector<RawCamera> cameras;
+	const vec3f mainCamPos = vec3f(0.f, 30.f, 200.f);
+	cameras.emplace_back(
+	    mainCamPos,
+	    mat4f::getLookAtRH(mainCamPos, vec3f(0.f), vec3f(0.f, 1.f, 0.f)),
+	    mat4f::getPerspectiveFovRH(deg2rad(60.f), 16.f / 9.f, 0.1f, 500.f, 0.f, kIsTexcoordStyleD3D));
+
+	for (int iLight = 0; iLight < kNumPointLights; ++iLight) {
+		const vec3f lightPos = vec3f(rnd.nextInRange(-100.f, 100.f), 5.f, rnd.nextInRange(-100.f, 100.f));
+		for (int iSignedAxis = 0; iSignedAxis < 6; ++iSignedAxis) {
+			const vec3f faceDir = vec3f::getAxis(iSignedAxis % 3) * (iSignedAxis < 3 ? 1.f : -1.f);
+			const vec3f up = (iSignedAxis % 3) == 1 ? vec3f(0.f, 0.f, 1.f) : vec3f(0.f, 1.f, 0.f);
+			cameras.emplace_back(
+			    lightPos,
+			    mat4f::getLookAtRH(lightPos, lightPos + faceDir, up),
+			    mat4f::getPerspectiveFovRH(deg2rad(90.f), 1.f, 0.1f, 30.f, 0.f, kIsTexcoordStyleD3D));
+		}
+	}
+
+	std::vector<Actor*> walkResult;
+	std::vector<Actor*> indexResult;
+
+	Timer timer;
+	for (int iFrame = 0; iFrame < kNumFrames; ++iFrame) {
+		walkResult.clear();
+		for (const RawCamera& camera : cameras) {
+			cullByWalkingTheScene(world, *camera.getFrustumWS(), walkResult);
+		}
+	}
+	timer.tick();
+	const float walkMs = timer.diff_seconds() * 1000.f / float(kNumFrames);
+
+	for (int iFrame = 0; iFrame < kNumFrames; ++iFrame) {
+		indexResult.clear();
+		for (const RawCamera& camera : cameras) {
+			world.queryActorsInFrustum(
+			    *camera.getFrustumWS(), [&](Actor* const actor) -> void { indexResult.push_back(actor); });
+		}
+	}
+	timer.tick();
+	const float indexMs = timer.diff_seconds() * 1000.f / float(kNumFrames);
+
+	// Nothing moves, so the update should not touch the spatial index at all.
+	for (int iFrame = 0; iFrame < kNumFrames; ++iFrame) {
+		world.update(updateSets);
+	}
+	timer.tick();
+	const float updateMs = timer.diff_seconds() * 1000.f / float(kNumFrames);
+
+	printf(
+	    "Culling %d actors for %d cameras: scene walks %.3f ms, spatial index %.3f ms (%.1fx), world update %.3f ms\n",
+	    kNumActors,
+	    int(cameras.size()),
+	    walkMs,
+	    indexMs,
+	    walkMs / indexMs,
+	    updateMs);
+
+	// The spatial index uses enlarged boxes, so it may report more actors than a box test, but never less.
+	const Frustum& mainFrustumWs = *cameras[0].getFrustumWS();
+	std::vector<Actor*> boxTestResult;
+	world.iterateOverPlayingObjects(
+	    [&](GameObject* object) -> bool {
+		    Actor* const actor = object->getActor();
+		    if (actor && !mainFrustumWs.isBoxOutside(actor->getBBoxOS().getTransformed(actor->getTransformMtx()))) {
+			    boxTestResult.push_back(actor);
+		    }
+		    return true;
+	    },
+	    false);
+
+	indexResult.clear();
+	world.queryActorsInFrustum(mainFrustumWs, [&](Actor* const actor) -> void { indexResult.push_back(actor); });
+
+	std::sort(boxTestResult.begin(), boxTestResult.end());
+	std::sort(indexResult.begin(), indexResult.end());
+	REQUIRE(boxTestResult.empty() == false);
+	CHECK(std::includes(indexResult.begin(), indexResult.end(), boxTestResult.begin(), boxTestResult.end()));
+
+	// Move an actor, the spatial index should follow it.
+	Actor* const movedActor = boxTestResult.front();
+	movedActor->setPosition(vec3f(10000.f));
+
+	bool isMovedActorFound = false;
+	world.queryActorsInBox(Box3f::getFromHalfDiagonal(vec3f(2.f), vec3f(10000.f)), [&](Actor* const actor) -> void {
+		isMovedActorFound |= actor == movedActor;
+	});
+	CHECK(isMovedActorFound);
+}
+
+} // namespace sge
@@ -0,0 +1,318 @@
+#include "doctest/doctest.h"
+#include "sge_core/AssetLibrary/AssetTexture2D.h"
+#include "sge_core/dds/TextureCooker.h"
+#include "sge_core/dds/dds.h"
+#include "sge_utils/io/FileStream.h"
+#include "sge_utils/threading/ThreadPool.h"
+#include "sge_utils/time/Timer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+// The benchmark has its own copy of stb_image as sge_core doesn't export it.
+#if defined(_MSC_VER)
+	#pragma warning(push, 0)
+#endif
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#define STB_IMAGE_WRITE_STATIC
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+#if defined(_MSC_VER)
+	#pragma warning(pop)
+#endif
+
+namespace sge {
+
+/// Creates an image with smooth gradients and a bit of noise, so it doesn't compress unrealistically well as a png.
+static std::vector<unsigned char> createBenchTexturePixels(int width, int height, bool hasAlpha)
+{
+	std::vector<unsigned char> pixels(size_t(width) * size_t(height) * 4);
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			const int noise = int((unsigned(x * 7919 + y * 104729) * 2654435761u) >> 29) - 4;
+			const float values[4] = {
+			    128.f + 120.f * sinf(float(x) * 0.021f + float(y) * 0.013f),
+			    128.f + 120.f * sinf(float(x) * 0.005f - float(y) * 0.031f),
+			    128.f + 120.f * cosf(float(x + y) * 0.017f),
+			    hasAlpha ? 128.f + 127.f * sinf(float(x - y) * 0.011f) : 255.f,
+			};
+
+			unsigned char* const pixel = pixels.data() + (size_t(y) * width + x) * 4;
+			for (int iChannel = 0; iChannel < 4; ++iChannel) {
+				const int value = int(values[iChannel]) + ((iChannel < 3) ? noise : 0);
+				pixel[iChannel] = (unsigned char)(value < 0 ? 0 : (value > 255 ? 255 : value));
+			}
+		}
+	}
+
+	return pixels;
+}
+
+/// Decodes a BC4 block (or the alpha of a BC3 block) into the specified channel of the 4x4 RGBA8 block.
+static void decodeBenchBC4Block(unsigned char outBlock[64], const unsigned char* const src, int iChannel)
+{
+	int palette[8] = {src[0], src[1]};
+	for (int t = 2; t < 8; ++t) {
+		if (src[0] > src[1]) {
+			palette[t] = ((8 - t) * src[0] + (t - 1) * src[1]) / 7;
+		}
+		else {
+			palette[t] = (t < 6) ? ((6 - t) * src[0] + (t - 1) * src[1]) / 5 : ((t == 6) ? 0 : 255);
+		}
+	}
+
+	uint64 indices = 0;
+	for (int iByte = 0; iByte < 6; ++iByte) {
+		indices |= uint64(src[2 + iByte]) << (iByte * 8);
+	}
+
+	for (int iPixel = 0; iPixel < 16; ++iPixel) {
+		outBlock[iPixel * 4 + iChannel] = (unsigned char)palette[(indices >> (iPixel * 3)) & 7];
+	}
+}
+
+/// Decodes the color part of a BC1/BC3 block into the RGB channels of the 4x4 RGBA8 block.
+static void decodeBenchColorBlock(unsigned char outBlock[64], const unsigned char* const src, bool isBC1)
+{
+	const int c0 = src[0] | (src[1] << 8);
+	const int c1 = src[2] | (src[3] << 8);
+
+	int palette[4][3];
+	for (int iEndpoint = 0; iEndpoint < 2; ++iEndpoint) {
+		const int c = (iEndpoint == 0) ? c0 : c1;
+		palette[iEndpoint][0] = (((c >> 11) & 31) << 3) | (((c >> 11) & 31) >> 2);
+		palette[iEndpoint][1] = (((c >> 5) & 63) << 2) | (((c >> 5) & 63) >> 4);
+		palette[iEndpoint][2] = ((c & 31) << 3) | ((c & 31) >> 2);
+	}
+
+	for (int iChannel = 0; iChannel < 3; ++iChannel) {
+		if (c0 > c1 || !isBC1) {
+			palette[2][iChannel] = (2 * palette[0][iChannel] + palette[1][iChannel]) / 3;
+			palette[3][iChannel] = (palette[0][iChannel] + 2 * palette[1][iChannel]) / 3;
+		}
+		else {
+			palette[2][iChannel] = (palette[0][iChannel] + palette[1][iChannel]) / 2;
+			palette[3][iChannel] = 0;
+		}
+	}
+
+	const uint32 indices = uint32(src[4]) | (uint32(src[5]) << 8) | (uint32(src[6]) << 16) | (uint32(src[7]) << 24);
+	for (int iPixel = 0; iPixel < 16; ++iPixel) {
+		for (int iChannel = 0; iChannel < 3; ++iChannel) {
+			outBlock[iPixel * 4 + iChannel] = (unsigned char)palette[(indices >> (iPixel * 2)) & 3][iChannel];
+		}
+	}
+}
+
+/// Decodes the top mip level of the cooked texture and returns the PSNR compared to the source pixels.
+/// Only the channels kept by the compression are compared.
+static float computeBenchCookedPSNR(
+    const TextureDesc& desc, const TextureData& topMip, const std::vector<unsigned char>& sourcePixels)
+{
+	const int width = desc.texture2D.width;
+	const int height = desc.texture2D.height;
+	const int numChannels =
+	    (desc.format == TextureFormat::BC1_UNORM) ? 3 : ((desc.format == TextureFormat::BC5_UNORM) ? 2 : 4);
+	const int blockSize = (desc.format == TextureFormat::BC1_UNORM) ? 8 : 16;
+
+	double sumSquaredError = 0.0;
+	for (int iBlockY = 0; iBlockY < height / 4; ++iBlockY) {
+		for (int iBlockX = 0; iBlockX < width / 4; ++iBlockX) {
+			const unsigned char* const src =
+			    (const unsigned char*)topMip.data + iBlockY * topMip.rowByteSize + iBlockX * blockSize;
+
+			unsigned char block[64] = {0};
+			if (desc.format == TextureFormat::BC1_UNORM) {
+				decodeBenchColorBlock(block, src, true);
+			}
+			else if (desc.format == TextureFormat::BC3_UNORM) {
+				decodeBenchBC4Block(block, src, 3);
+				decodeBenchColorBlock(block, src + 8, false);
+			}
+			else {
+				decodeBenchBC4Block(block, src, 0);
+				decodeBenchBC4Block(block, src + 8, 1);
+			}
+
+			for (int iPixel = 0; iPixel < 16; ++iPixel) {
+				const int x = iBlockX * 4 + iPixel % 4;
+				const int y = iBlockY * 4 + iPixel / 4;
+				for (int iChannel = 0; iChannel < numChannels; ++iChannel) {
+					const double sourceValue = double(sourcePixels[(size_t(y) * width + x) * 4 + iChannel]);
+					const double diff = double(block[iPixel * 4 + iChannel]) - sourceValue;
+					sumSquaredError += diff * diff;
+				}
+			}
+		}
+	}
+
+	const double meanSquaredError = sumSquaredError / (double(width) * double(height) * double(numChannels));
+	return float(10.0 * log10(255.0 * 255.0 / maxOf(meanSquaredError, 1e-6)));
+}
+
+TEST_CASE("Texture loading, decoding the png on every load vs the cooked block compressed texture")
+{
+	const int kSize = 1024;
+	const int kNumLoads = 5;
+
+	struct BenchTextureVariant {
+		const char* name;
+		bool hasAlpha;
+		TextureCompression compression;
+		TextureFormat::Enum expectedFormat;
+		const char* formatName;
+	};
+
+	const BenchTextureVariant variants[] = {
+	    {"opaque", false, textureCompression_auto, TextureFormat::BC1_UNORM, "BC1"},
+	    {"with alpha", true, textureCompression_auto, TextureFormat::BC3_UNORM, "BC3"},
+	    {"two channel", false, textureCompression_bc5, TextureFormat::BC5_UNORM, "BC5"},
+	};
+
+	ThreadPool threadPool;
+	threadPool.create(ThreadPool::getHardwareConcurrency());
+
+	const std::filesystem::path tempDir = std::filesystem::temp_directory_path();
+	const std::string sourcePath = (tempDir / "sge_bench_texture.png").string();
+	const std::string cookedPath = sourcePath + ".dds";
+
+	for (const BenchTextureVariant& variant : variants) {
+		const std::vector<unsigned char> pixels = createBenchTexturePixels(kSize, kSize, variant.hasAlpha);
+		REQUIRE(stbi_write_png(sourcePath.c_str(), kSize, kSize, 4, pixels.data(), kSize * 4) != 0);
+
+		std::error_code removeError;
+		std::filesystem::remove(cookedPath, removeError);
+
+		// What AssetTexture2d does without a cooked texture, the mips are then generated by the driver.
+		Timer timer;
+		for (int t = 0; t < kNumLoads; ++t) {
+			int width = 0;
+			int height = 0;
+			int components = 0;
+			unsigned char* const decoded = stbi_load(sourcePath.c_str(), &width, &height, &components, 4);
+			REQUIRE(decoded != nullptr);
+			stbi_image_free(decoded);
+		}
+		timer.tick();
+		const float sourceLoadMs = timer.diff_seconds() * 1000.f / float(kNumLoads);
+
+		AssetTextureMeta meta;
+		meta.compression = variant.compression;
+
+		// Cooking, done once when the texture gets imported or its settings change.
+		std::vector<char> cookedSingleThread;
+		std::vector<char> cookedMultiThread;
+		const TextureCookSettings cookSettings = {variant.compression, true};
+
+		timer.tick();
+		REQUIRE(cookTexture(cookedSingleThread, pixels.data(), kSize, kSize, cookSettings, 0, nullptr));
+		timer.tick();
+		const float cookSingleThreadMs = timer.diff_seconds() * 1000.f;
+
+		REQUIRE(cookTexture(cookedMultiThread, pixels.data(), kSize, kSize, cookSettings, 0, &threadPool));
+		timer.tick();
+		const float cookMultiThreadMs = timer.diff_seconds() * 1000.f;
+		CHECK(cookedSingleThread == cookedMultiThread);
+
+		std::vector<char> ddsFileData;
+		REQUIRE(cookTextureAsset(sourcePath.c_str(), meta, ddsFileData, &threadPool));
+		REQUIRE(std::filesystem::exists(cookedPath));
+
+		// What AssetTexture2d does with an up to date cooked texture.
+		TextureDesc desc;
+		std::vector<TextureData> initialData;
+		timer.tick();
+		for (int t = 0; t < kNumLoads; ++t) {
+			initialData.clear();
+			REQUIRE(cookTextureAsset(sourcePath.c_str(), meta, ddsFileData, nullptr));
+			REQUIRE(DDSLoader().load(ddsFileData.data(), ddsFileData.size(), desc, initialData));
+		}
+		timer.tick();
+		const float cookedLoadMs = timer.diff_seconds() * 1000.f / float(kNumLoads);
+
+		REQUIRE(desc.format == variant.expectedFormat);
+		REQUIRE(desc.texture2D.width == kSize);
+		REQUIRE(desc.texture2D.height == kSize);
+		REQUIRE(desc.texture2D.numMips == 11);
+		REQUIRE(int(initialData.size()) == desc.texture2D.numMips);
+
+		// The cooked file is the one cooked on all threads, it is the same as the one cooked on a single thread
+		// apart from the key in the header.
+		CHECK(ddsFileData.size() == cookedSingleThread.size());
+		uint32 cookKey = 0;
+		CHECK(readTextureCookKey(ddsFileData.data(), ddsFileData.size(), cookKey));
+
+		std::vector<char> sourceFileData;
+		REQUIRE(FileReadStream::readFile(sourcePath.c_str(), sourceFileData));
+		CHECK(cookKey == computeTextureCookKey(sourceFileData.data(), sourceFileData.size(), cookSettings));
+
+		// The driver generated mips of an RGBA8 texture vs the cooked mips.
+		size_t rgbaBytes = 0;
+		size_t cookedBytes = 0;
+		for (int iMip = 0; iMip < desc.texture2D.numMips; ++iMip) {
+			const size_t mipSize = size_t(maxOf(kSize >> iMip, 1));
+			rgbaBytes += mipSize * mipSize * 4;
+			cookedBytes += initialData[iMip].sliceByteSize;
+		}
+
+		const float psnr = computeBenchCookedPSNR(desc, initialData[0], pixels);
+
+		printf(
+		    "Texture %dx%d %s, png decode %.2f ms, cooked load %.2f ms, cooking %.2f ms on 1 thread, %.2f ms on %d\n",
+		    kSize,
+		    kSize,
+		    variant.name,
+		    sourceLoadMs,
+		    cookedLoadMs,
+		    cookSingleThreadMs,
+		    cookMultiThreadMs,
+		    threadPool.getNumWorkers());
+		printf(
+		    "Texture %dx%d %s, %.2f MB as RGBA8 vs %.2f MB as %s, PSNR %.1f dB\n",
+		    kSize,
+		    kSize,
+		    variant.name,
+		    float(rgbaBytes) / (1024.f * 1024.f),
+		    float(cookedBytes) / (1024.f * 1024.f),
+		    variant.formatName,
+		    psnr);
+
+		// BC1 is an eighth and BC3/BC5 a quarter of the size, apart from the smallest mips that are padded to a block.
+		CHECK(float(cookedBytes) / float(rgbaBytes) < 0.26f);
+		CHECK(psnr > 30.f);
+
+		// Changing the settings makes the cooked texture out of date.
+		meta.shouldGenerateMips = false;
+		REQUIRE(cookTextureAsset(sourcePath.c_str(), meta, ddsFileData, nullptr));
+		initialData.clear();
+		REQUIRE(DDSLoader().load(ddsFileData.data(), ddsFileData.size(), desc, initialData));
+		CHECK(desc.texture2D.numMips == 1);
+
+		std::filesystem::remove(cookedPath, removeError);
+	}
+
+	// The *.dds files not made by the cooker are never overwritten.
+	{
+		const std::vector<char> notCooked = {'n', 'o', 't', ' ', 'c', 'o', 'o', 'k', 'e', 'd'};
+		FileWriteStream fws;
+		REQUIRE(fws.open(cookedPath.c_str()));
+		fws.write(notCooked.data(), notCooked.size());
+		fws.close();
+
+		AssetTextureMeta meta;
+		meta.compression = textureCompression_auto;
+		std::vector<char> ddsFileData;
+		REQUIRE(cookTextureAsset(sourcePath.c_str(), meta, ddsFileData, nullptr));
+		CHECK(ddsFileData == notCooked);
+	}
+
+	std::error_code removeError;
+	std::filesystem::remove(sourcePath, removeError);
+	std::filesystem::remove(cookedPath, removeError);
+}
+
+} // namespace sge
@@ -0,0 +1,155 @@
+#include "doctest/doctest.h"
+#include "sge_engine/GameWorld.h"
+#include "sge_engine/typelibHelper.h"
+#include "sge_utils/time/Timer.h"
+
+#include <cstdio>
+
+namespace sge {
+
+/// An actor that does nothing, used to build deep hierarchies.
+struct ABenchHierarchyNode : public Actor {
+	Box3f getBBoxOS() const override { return Box3f(vec3f(-0.5f), vec3f(0.5f)); }
+	void create() override {}
+};
+
+// clang-format off
+ReflBlock()
+{
+	ReflAddActor(ABenchHierarchyNode);
+}
+// clang-format on
+
+/// Creates chains of @hierarchyDepth actors, each actor is a child of the previous one.
+/// @param [out] allActors all created actors, parents are before their children.
+/// @param [out] roots the root of each chain.
+/// @param [out] leafs the deepest actor of each chain.
+static void createHierarchies(
+    GameWorld& world,
+    int numActors,
+    int hierarchyDepth,
+    std::vector<Actor*>& allActors,
+    std::vector<Actor*>& roots,
+    std::vector<Actor*>& leafs)
+{
+	const int numHierarchies = numActors / hierarchyDepth;
+	for (int iHierarchy = 0; iHierarchy < numHierarchies; ++iHierarchy) {
+		Actor* parent = nullptr;
+		for (int iLevel = 0; iLevel < hierarchyDepth; ++iLevel) {
+			Actor* const actor = world.allocObjectT<ABenchHierarchyNode>();
+			actor->setPosition(vec3f(float(iHierarchy), float(iLevel), 0.f));
+			allActors.push_back(actor);
+
+			if (parent) {
+				world.setParentOf(actor->getId(), parent->getId());
+			}
+			else {
+				roots.push_back(actor);
+			}
+
+			parent = actor;
+		}
+
+		leafs.push_back(parent);
+	}
+
+	// Start playing the objects.
+	world.update(GameUpdateSets(1.f / 60.f, false, InputState()));
+}
+
+TEST_CASE("Transform hierarchy 10k actors, 5 levels")
+{
+	const int kNumActors = 10000;
+	const int kHierarchyDepth = 5;
+	const int kNumFrames = 60;
+	const int kNumMovesPerFrame = 4;
+
+	GameWorld world;
+	world.create();
+
+	std::vector<Actor*> allActors;
+	std::vector<Actor*> roots;
+	std::vector<Actor*> leafs;
+	createHierarchies(world, kNumActors, kHierarchyDepth, allActors, roots, leafs);
+
+	// The roots get moved multiple times per frame (like an animated parent), the children are resolved once.
+	{
+		Timer timer;
+		for (int iFrame = 0; iFrame < kNumFrames; ++iFrame) {
+			for (int iMove = 0; iMove < kNumMovesPerFrame; ++iMove) {
+				for (Actor* const root : roots) {
+					transf3d tr = root->getTransform();
+					tr.p.y += 0.01f;
+					tr.r = quatf::getAxisAngle(vec3f::getAxis(1), float(iFrame * kNumMovesPerFrame + iMove) * 0.01f);
+					root->setTransform(tr, false);
+				}
+			}
+
+			world.resolveDirtyTransforms();
+		}
+		timer.tick();
+
+		printf(
+		    "Transform hierarchy %d actors, %d levels, %d root moves per frame, single resolve: %.3f ms\n",
+		    kNumActors,
+		    kHierarchyDepth,
+		    kNumMovesPerFrame,
+		    timer.diff_seconds() * 1000.f / float(kNumFrames));
+	}
+
+	// Same as above, but the deepest child gets read after each move, forcing the hierarchy to get resolved on demand.
+	// This is close to the amount of work needed if the children were moved immediately.
+	{
+		Timer timer;
+		for (int iFrame = 0; iFrame < kNumFrames; ++iFrame) {
+			for (int iMove = 0; iMove < kNumMovesPerFrame; ++iMove) {
+				for (int iHierarchy = 0; iHierarchy < int(roots.size()); ++iHierarchy) {
+					transf3d tr = roots[iHierarchy]->getTransform();
+					tr.p.y -= 0.01f;
+					roots[iHierarchy]->setTransform(tr, false);
+					leafs[iHierarchy]->getTransform();
+				}
+			}
+
+			world.resolveDirtyTransforms();
+		}
+		timer.tick();
+
+		printf(
+		    "Transform hierarchy %d actors, %d levels, %d root moves per frame, leaf read after each move: %.3f ms\n",
+		    kNumActors,
+		    kHierarchyDepth,
+		    kNumMovesPerFrame,
+		    timer.diff_seconds() * 1000.f / float(kNumFrames));
+	}
+
+	// Every actor in the hierarchy moves once per frame, parents before the children.
+	{
+		Timer timer;
+		for (int iFrame = 0; iFrame < kNumFrames; ++iFrame) {
+			for (Actor* const actor : allActors) {
+				transf3d tr = actor->getTransform();
+				tr.p.x += 0.01f;
+				actor->setTransform(tr, false);
+			}
+
+			world.resolveDirtyTransforms();
+		}
+		timer.tick();
+
+		printf(
+		    "Transform hierarchy %d actors, %d levels, all actors moved once per frame: %.3f ms\n",
+		    kNumActors,
+		    kHierarchyDepth,
+		    timer.diff_seconds() * 1000.f / float(kNumFrames));
+	}
+
+	// Sanity check, the deepest child must follow its root.
+	const Actor* const leafParent = world.getParentActor(leafs[0]->getId());
+	const transf3d expectedLeafTransform =
+	    transf3d::applyBindingTransform(leafs[0]->m_bindingToParentTransform, leafParent->getTransform());
+	CHECK(leafs[0]->getTransform().p.x == doctest::Approx(expectedLeafTransform.p.x));
+	CHECK(leafs[0]->getTransform().p.y == doctest::Approx(expectedLeafTransform.p.y));
+}
+
+} // namespace sge
@@ -0,0 +1,111 @@
+#include "doctest/doctest.h"
+#include "sge_core/typelib/typeLib.h"
+#include "sge_utils/math/Random.h"
+#include "sge_utils/time/Timer.h"
+
+#include <cstdio>
+#include <map>
+#include <vector>
+
+namespace sge {
+
+/// The searches done by TypeLib before the lookup tables, used as a reference.
+struct BenchTypeLibReferenceLookup {
+	explicit BenchTypeLibReferenceLookup(TypeLib& lib)
+	{
+		for (auto& typePair : lib.m_registeredTypes) {
+			typesById[typePair.first] = &typePair.second;
+		}
+	}
+
+	const TypeDesc* find(const TypeId typeId) const
+	{
+		auto itr = typesById.find(typeId);
+		return itr != typesById.end() ? itr->second : nullptr;
+	}
+
+	const TypeDesc* findByName(const char* const name) const
+	{
+		for (auto& typePair : typesById) {
+			if (strcmp(typePair.second->name, name) == 0) {
+				return typePair.second;
+			}
+		}
+		return nullptr;
+	}
+
+	std::map<TypeId, const TypeDesc*> typesById;
+};
+
+TEST_CASE("TypeLib lookups, std::map and linear search vs lookup tables")
+{
+	const int kNumLookups = 1000000;
+
+	TypeLib& lib = typeLib();
+	const BenchTypeLibReferenceLookup reference(lib);
+	REQUIRE(lib.getNumTypes() == int(lib.m_registeredTypes.size()));
+
+	// The types are searched in random order, like the serialization does.
+	Random rnd;
+	std::vector<const TypeDesc*> typesToFind;
+	typesToFind.reserve(kNumLookups);
+	for (int t = 0; t < kNumLookups; ++t) {
+		typesToFind.push_back(lib.findByIndex(rnd.nextIntBefore(lib.getNumTypes())));
+	}
+
+	Timer timer;
+	const auto bench = [&](const char* const name, const auto& findFn) -> float {
+		int numFound = 0;
+		timer.tick();
+		for (const TypeDesc* const typeDesc : typesToFind) {
+			numFound += findFn(typeDesc) == typeDesc ? 1 : 0;
+		}
+		timer.tick();
+		const float ms = timer.diff_seconds() * 1000.f;
+
+		printf("TypeLib %d lookups %s: %.2f ms\n", kNumLookups, name, ms);
+		CHECK(numFound == kNumLookups);
+		return ms;
+	};
+
+	const float mapMs = bench("by id, std::map", [&](const TypeDesc* td) { return reference.find(td->typeId); });
+	const float idMs = bench("by id, TypeLib::find", [&](const TypeDesc* td) { return lib.find(td->typeId); });
+	const float linearMs =
+	    bench("by name, linear search", [&](const TypeDesc* td) { return reference.findByName(td->name); });
+	const float nameMs =
+	    bench("by name, TypeLib::findByName", [&](const TypeDesc* td) { return lib.findByName(td->name); });
+
+	printf(
+	    "TypeLib lookups by id %.1fx faster, by name %.1fx faster (%d types)\n",
+	    mapMs / idMs,
+	    linearMs / nameMs,
+	    lib.getNumTypes());
+
+	// Walking the members of every type, like the serialization and the property editor do.
+	const auto benchMembers = [&](const char* const name, const auto& getMemberTypeFn) -> void {
+		int numResolved = 0;
+		timer.tick();
+		for (int iPass = 0; iPass < 100; ++iPass) {
+			for (auto& typePair : lib.m_registeredTypes) {
+				for (const MemberDesc& member : typePair.second.members) {
+					numResolved += getMemberTypeFn(member) != nullptr ? 1 : 0;
+				}
+			}
+		}
+		timer.tick();
+
+		printf("TypeLib member types %s: %.2f ms (%d members)\n", name, timer.diff_seconds() * 1000.f, numResolved);
+		CHECK(numResolved > 0);
+	};
+
+	benchMembers("searched in std::map", [&](const MemberDesc& member) { return reference.find(member.typeId); });
+	benchMembers("cached", [&](const MemberDesc& member) { return member.getTypeDesc(); });
+
+	for (auto& typePair : lib.m_registeredTypes) {
+		for (const MemberDesc& member : typePair.second.members) {
+			CHECK(member.getTypeDesc() == reference.find(member.typeId));
+		}
+	}
+}
+
+} // namespace sge
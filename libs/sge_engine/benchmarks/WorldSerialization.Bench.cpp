@@ -0,0 +1,188 @@
+#include "doctest/doctest.h"
+#include "sge_engine/GameSerialization.h"
+#include "sge_engine/GameWorld.h"
+#include "sge_engine/typelibHelper.h"
+#include "sge_utils/math/Random.h"
+#include "sge_utils/time/Timer.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace sge {
+
+/// A prop with a few properties of different types, like the actors that make most of a level.
+struct ABenchSavedProp : public Actor {
+	Box3f getBBoxOS() const override { return Box3f(vec3f(-1.f), vec3f(1.f)); }
+	void create() override {}
+
+	std::string m_label;
+	std::vector<float> m_weights;
+	float m_health = 100.f;
+	int m_team = 0;
+	bool m_isBreakable = false;
+};
+
+// clang-format off
+ReflBlock()
+{
+	ReflAddActor(ABenchSavedProp)
+		ReflMember(ABenchSavedProp, m_label)
+		ReflMember(ABenchSavedProp, m_weights)
+		ReflMember(ABenchSavedProp, m_health)
+		ReflMember(ABenchSavedProp, m_team)
+		ReflMember(ABenchSavedProp, m_isBreakable);
+}
+// clang-format on
+
+/// Fills the world with @numActors props, every 8 consecutive props form a hierarchy.
+static void createBenchSavedLevel(GameWorld& world, int numActors)
+{
+	Random rnd;
+	ObjectId parentId;
+	for (int t = 0; t < numActors; ++t) {
+		ABenchSavedProp* const actor = world.allocObjectT<ABenchSavedProp>();
+		transf3d transform;
+		transform.p =
+		    vec3f(rnd.nextInRange(-500.f, 500.f), rnd.nextInRange(0.f, 10.f), rnd.nextInRange(-500.f, 500.f));
+		if (t % 3 == 0) {
+			transform.s = vec3f(rnd.nextInRange(0.5f, 2.f));
+		}
+		actor->setTransform(transform);
+
+		actor->m_label = "Prop_" + std::to_string(t);
+		actor->m_weights = {rnd.next01(), rnd.next01(), rnd.next01(), rnd.next01()};
+		actor->m_health = rnd.nextInRange(10.f, 100.f);
+		actor->m_team = t % 4;
+		actor->m_isBreakable = (t % 2) == 0;
+
+		if (t % 8 == 0) {
+			parentId = actor->getId();
+		}
+		else {
+			world.setParentOf(actor->getId(), parentId);
+		}
+	}
+
+	world.update(GameUpdateSets(0.f, true, InputState()));
+}
+
+/// Returns true if @loadedWorld has the same props as @sourceWorld.
+/// The json stores the numbers with 6 decimal places, so the floats are compared with a small tolerance.
+static bool areBenchSavedLevelsEqual(GameWorld& sourceWorld, GameWorld& loadedWorld)
+{
+	const auto isNear = [](float a, float b) -> bool { return isEpsEqual(a, b, 1e-3f); };
+	const auto isNearVec = [&](const float* a, const float* b, int numFloats) -> bool {
+		for (int t = 0; t < numFloats; ++t) {
+			if (!isNear(a[t], b[t])) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	int numComparedProps = 0;
+	bool areEqual = true;
+	sourceWorld.iterateOverPlayingObjects(
+	    [&](GameObject* object) -> bool {
+		    const ABenchSavedProp* const source = dynamic_cast<ABenchSavedProp*>(object);
+		    const ABenchSavedProp* const loaded =
+		        dynamic_cast<ABenchSavedProp*>(loadedWorld.getObjectById(object->getId()));
+		    if (source == nullptr || loaded == nullptr || source->m_weights.size() != loaded->m_weights.size()) {
+			    areEqual = false;
+			    return false;
+		    }
+
+		    const transf3d& sourceTr = source->getTransform();
+		    const transf3d& loadedTr = loaded->getTransform();
+		    areEqual = isNearVec(sourceTr.p.data, loadedTr.p.data, 3) &&
+		               isNearVec(sourceTr.r.data, loadedTr.r.data, 4) &&
+		               isNearVec(sourceTr.s.data, loadedTr.s.data, 3) &&
+		               isNearVec(source->m_weights.data(), loaded->m_weights.data(), int(source->m_weights.size())) &&
+		               isNear(source->m_health, loaded->m_health) && source->m_label == loaded->m_label &&
+		               source->m_team == loaded->m_team && source->m_isBreakable == loaded->m_isBreakable &&
+		               sourceWorld.getParentId(source->getId()) == loadedWorld.getParentId(loaded->getId());
+		    numComparedProps++;
+		    return areEqual;
+	    },
+	    false);
+
+	return areEqual && numComparedProps > 0;
+}
+
+TEST_CASE("GameWorld serialization 20k actors, json vs binary")
+{
+	const int kNumActors = 20000;
+
+	GameWorld sourceWorld;
+	sourceWorld.create();
+	createBenchSavedLevel(sourceWorld, kNumActors);
+
+	Timer timer;
+
+	// Saving.
+	timer.tick();
+	const std::string levelJson = serializeGameWorld(&sourceWorld);
+	timer.tick();
+	const float saveJsonMs = timer.diff_seconds() * 1000.f;
+
+	timer.tick();
+	const std::vector<char> levelBinary = serializeGameWorldBinary(&sourceWorld);
+	timer.tick();
+	const float saveBinaryMs = timer.diff_seconds() * 1000.f;
+
+	REQUIRE(isBinaryGameWorldData(levelBinary.data(), levelBinary.size()));
+	REQUIRE(!isBinaryGameWorldData(levelJson.data(), levelJson.size()));
+
+	// Loading.
+	GameWorld jsonWorld;
+	timer.tick();
+	REQUIRE(loadGameWorldFromMemory(&jsonWorld, levelJson.data(), levelJson.size(), false));
+	timer.tick();
+	const float loadJsonMs = timer.diff_seconds() * 1000.f;
+
+	GameWorld binaryWorld;
+	timer.tick();
+	REQUIRE(loadGameWorldFromMemory(&binaryWorld, levelBinary.data(), levelBinary.size(), false));
+	timer.tick();
+	const float loadBinaryMs = timer.diff_seconds() * 1000.f;
+
+	printf(
+	    "World serialization %d actors: json %.2f MB, saving %.1f ms, loading %.1f ms | binary %.2f MB, saving %.1f "
+	    "ms, loading %.1f ms (%.1fx faster loading)\n",
+	    kNumActors,
+	    float(levelJson.size()) / (1024.f * 1024.f),
+	    saveJsonMs,
+	    loadJsonMs,
+	    float(levelBinary.size()) / (1024.f * 1024.f),
+	    saveBinaryMs,
+	    loadBinaryMs,
+	    loadJsonMs / loadBinaryMs);
+
+	CHECK(areBenchSavedLevelsEqual(sourceWorld, jsonWorld));
+	CHECK(areBenchSavedLevelsEqual(sourceWorld, binaryWorld));
+	CHECK(binaryWorld.m_nextObjectId == sourceWorld.m_nextObjectId);
+
+	// Entering the play mode in the editor, the world gets copied to a new one.
+	const auto benchSnapshot = [&](const char* const formatName, const auto& copyWorldFn) -> void {
+		GameWorld playedWorld;
+		timer.tick();
+		copyWorldFn(playedWorld);
+		timer.tick();
+		printf("Play mode world snapshot (%s): %.1f ms\n", formatName, timer.diff_seconds() * 1000.f);
+
+		CHECK(areBenchSavedLevelsEqual(sourceWorld, playedWorld));
+	};
+
+	benchSnapshot("json", [&](GameWorld& playedWorld) -> void {
+		const std::string snapshot = serializeGameWorld(&sourceWorld);
+		loadGameWorldFromMemory(&playedWorld, snapshot.data(), snapshot.size(), false);
+	});
+
+	benchSnapshot("binary", [&](GameWorld& playedWorld) -> void {
+		const std::vector<char> snapshot = serializeGameWorldBinary(&sourceWorld);
+		loadGameWorldFromMemory(&playedWorld, snapshot.data(), snapshot.size(), false);
+	});
+}
+
+} // namespace sge
@@ -23,9 +23,11 @@ ReflBlock()
 
 const mat4f& Actor::getTransformMtx() const
 {
+	// Resolving a dirty transform invalidates the matrix, so do it first.
+	const transf3d& transform = getTransform();
 	if (!m_isTrasformAsMtxValid) {
+		m_trasformAsMtx = transform.toMatrix();
 		m_isTrasformAsMtxValid = true;
-		m_trasformAsMtx = m_logicTransform.toMatrix();
 	}
 	return m_trasformAsMtx;
 }
@@ -81,13 +83,21 @@ void Actor::setOrientation(const quatf& r, bool killVelocity)
 void Actor::setTransformEx(
     const transf3d& newTransform, bool killVelocity, bool recomputeBinding, bool shouldChangeRigidBodyTransform)
 {
-	transf3d oldTransform = m_logicTransform;
 	m_isTrasformAsMtxValid = false;
 	m_logicTransform = newTransform;
+	m_isLogicTransformDirty = false;
+	m_isRigidBodyTransformDirty = false;
+	m_shouldKillVelocityOnRigidBodyUpdate = false;
 
 	if (shouldChangeRigidBodyTransform) {
 		TraitRigidBody* const traitRB = getTrait<TraitRigidBody>(this);
-		if (traitRB) {
+		if (traitRB && getWorld()->isUpdatingInParallel()) {
+			// Moving the rigid body changes the Bullet broadphase, which is shared by all actors.
+			// GameWorld moves it after the parallel update.
+			m_isRigidBodyTransformDirty = true;
+			m_shouldKillVelocityOnRigidBodyUpdate = killVelocity;
+		}
+		else if (traitRB) {
 			traitRB->setTrasnform(newTransform, killVelocity);
 		}
 	}
@@ -107,20 +117,39 @@ void Actor::setTransformEx(
 		}
 	}
 
-	const vector_set<ObjectId>* pAllChildren = getWorld()->getChildensOf(getId());
-	if (pAllChildren != nullptr) {
-		sgeAssert(pAllChildren->size() != 0); // The pointer should be null in that case!
-		for (int t = 0; t < pAllChildren->size(); ++t) {
-			Actor* const child = getWorld()->getActorById(pAllChildren->data()[t]);
-			if (child) {
-				transf3d childNewTransformWS =
-				    transf3d::applyBindingTransform(child->m_bindingToParentTransform, m_logicTransform);
-				child->setTransformEx(childNewTransformWS, killVelocity, recomputeBinding, true);
-			}
-		}
+	// The children will get their new transforms when they are needed.
+	getWorld()->markChildTransformsDirty(this, killVelocity);
+
+	markBBoxDirty();
+}
+
+void Actor::markBBoxDirty()
+{
+	if (getWorld()->isUpdatingInParallel()) {
+		// The list is shared by all actors, the actor gets added to it after the parallel update.
+		m_isSpatialIndexDirtyDeferred = true;
+	}
+	else if (m_isSpatialIndexDirty == false) {
+		m_isSpatialIndexDirty = true;
+		getWorld()->addSpatialIndexDirtyActor(this);
 	}
 }
 
+void Actor::resolveDirtyLogicTransform() const
+{
+	getWorldMutable()->resolveDirtyTransform(this);
+}
+
+void Actor::resolveLogicTransformFromParent(const transf3d& parentTransform)
+{
+	m_isTrasformAsMtxValid = false;
+	m_logicTransform = transf3d::applyBindingTransform(m_bindingToParentTransform, parentTransform);
+	m_isLogicTransformDirty = false;
+	m_isRigidBodyTransformDirty = true;
+
+	markBBoxDirty();
+}
+
 
 /// This function tells the editor that the actor provides sub-objects that can be edited in the viewport.
 /// For example the Splines have control points that we can move via the transform tools.
@@ -18,15 +18,22 @@ struct SGE_ENGINE_API Actor : public GameObject {
 	virtual ~Actor() = default;
 
 	/// Returns the transform of the actor in world space.
-	const transf3d& getTransform() const { return m_logicTransform; }
+	/// If a parent actor has been moved since the last time the transform was computed, it gets resolved here.
+	const transf3d& getTransform() const
+	{
+		if (m_isLogicTransformDirty) {
+			resolveDirtyLogicTransform();
+		}
+		return m_logicTransform;
+	}
 
 	/// Returns the transform of the actor in world space as a matrix.
 	/// The computation is cached in roder to compute it every time we need it.
 	const mat4f& getTransformMtx() const;
 
 	/// Shorthand for getting the position of the actor in world space.
-	const vec3f& getPosition() const { return m_logicTransform.p; }
-	const quatf& getOrientation() const { return m_logicTransform.r; }
+	const vec3f& getPosition() const { return getTransform().p; }
+	const quatf& getOrientation() const { return getTransform().r; }
 
 	/// Shorthand for retrieving the cardinal directions of an axis in world space according to this actor's transform.
 	const vec3f getDirX() const { return getTransformMtx().c0.xyz(); }
@@ -50,6 +57,8 @@ struct SGE_ENGINE_API Actor : public GameObject {
 	/// Called after the physics simulation has ended and before update().
 	/// It is used so the physics engine can change the transformation of the actor without looping back to the physics
 	/// engine.
+	/// The children of the actor are not moved here, they are only marked as dirty. Their transforms get resolved
+	/// by GameWorld::resolveDirtyTransforms() or when getTransform() is called for them.
 	void setTransformEx(
 	    const transf3d& transform, bool killVelocity, bool recomputeBinding, bool shouldChangeRigidBodyTransform);
 
@@ -58,6 +67,12 @@ struct SGE_ENGINE_API Actor : public GameObject {
 	/// This should be used for the editor and the rendering.
 	virtual Box3f getBBoxOS() const = 0;
 
+	/// Tells the world that the box returned by getBBoxOS() has changed, so the actor gets moved in the spatial index
+	/// of the world. Changing the transform of the actor does this automatically. Everything else that changes the
+	/// bounding box (animations, particles, edited points, reloaded assets) needs to call it.
+	/// Safe to call from parallel updates.
+	void markBBoxDirty();
+
 	/// These functions tells the editor that the actor provides sub-objects that can be edited in the viewport.
 	/// For example the Splines have control points that we can move via the transform tools.
 	virtual int getNumItemsInMode(EditMode const mode) const;
@@ -72,6 +87,15 @@ struct SGE_ENGINE_API Actor : public GameObject {
 	    const transf3d& initalTrasform,
 	    const transf3d& newTransform);
 
+  private:
+	friend struct GameWorld;
+
+	void resolveDirtyLogicTransform() const;
+
+	/// Recomputes m_logicTransform from the binding transform and the world space transform of the parent.
+	/// The rigid body (if any) is updated later by GameWorld::resolveDirtyTransforms().
+	void resolveLogicTransformFromParent(const transf3d& parentTransform);
+
   public:
 	/// The transform of the actor in world space. this is the transform that
 	/// specifies the actual position of the actor.
@@ -86,6 +110,27 @@ struct SGE_ENGINE_API Actor : public GameObject {
 	/// Covertinf form transf3d to matrix could be slow so we use this pair of values to get it cached.
 	mutable mat4f m_trasformAsMtx;
 	mutable bool m_isTrasformAsMtxValid = false;
+
+	/// True if a parent actor has moved and m_logicTransform needs to be recomputed from m_bindingToParentTransform.
+	bool m_isLogicTransformDirty = false;
+	/// True if m_logicTransform was resolved (or changed during a parallel update) but the rigid body of the actor
+	/// (if any) hasn't been moved yet.
+	bool m_isRigidBodyTransformDirty = false;
+	bool m_shouldKillVelocityOnRigidBodyUpdate = false;
+
+	/// The location of the actor in GameWorld::m_transformNodes. The index is valid only if
+	/// @m_transformNodesVersion matches the version of the world, otherwise the actor isn't part of any hierarchy.
+	int m_transformNodeIndex = -1;
+	unsigned m_transformNodesVersion = 0;
+
+	/// The proxy of the actor in GameWorld::m_spatialIndex, -1 if the actor isn't in it.
+	int m_spatialIndexProxyId = -1;
+	/// The index of the actor in GameWorld::m_actorsWithoutBBox, -1 if the actor isn't in it.
+	int m_actorsWithoutBBoxIndex = -1;
+	/// True if the actor is in GameWorld::m_spatialIndexDirtyActors.
+	bool m_isSpatialIndexDirty = false;
+	/// True if markBBoxDirty() was called during a parallel update, GameWorld adds the actor to the list after it.
+	bool m_isSpatialIndexDirtyDeferred = false;
 };
 
 } // namespace sge
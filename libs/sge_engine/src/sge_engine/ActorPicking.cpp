@@ -0,0 +1,325 @@
+#include "ActorPicking.h"
+#include "sge_core/AssetLibrary/AssetModel3D.h"
+#include "sge_core/Camera.h"
+#include "sge_engine/Actor.h"
+#include "sge_engine/GameWorld.h"
+#include "sge_engine/traits/TraitModel.h"
+#include "sge_engine/traits/TraitPath.h"
+#include "sge_engine/traits/TraitRigidBody.h"
+#include "sge_engine/traits/TraitViewportIcon.h"
+
+namespace sge {
+
+namespace {
+	/// Returns the evaluated model that gets rendered for the specified model entry, nullptr if none.
+	const EvaluatedModel* getRenderedEvalModel(ModelEntry& modelEntry)
+	{
+		if (modelEntry.customEvalModel.hasValue()) {
+			return &modelEntry.customEvalModel.get();
+		}
+
+		AssetIface_Model3D* const modelIface = modelEntry.m_assetProperty.getAssetInterface<AssetIface_Model3D>();
+		if (modelIface) {
+			return &modelIface->getStaticEval();
+		}
+
+		return nullptr;
+	}
+
+	/// The icon quad lies in the YZ plane of the icon node, see anchor_getPlaneAlignMatrix.
+	const Box3f kIconQuadBoxOs = Box3f(vec3f(0.f), vec3f(0.f, 1.f, 1.f));
+
+	/// Actors without a bounding box (like empty helper actors) still need to be pickable.
+	const float kEmptyActorBoxHalfSize = 0.5f;
+
+	/// The number of segments of the polyline sampled along each path.
+	const int kNumPathSegments = 128;
+
+	/// The pick radius around a path, in world units per unit of distance from the ray origin (about half a degree).
+	const float kPathPickRadiusPerDistance = 0.01f;
+
+	/// Returns true if any of the 8 corners of the transformed box (an oriented box) is not outside of the frustum.
+	bool isOrientedBoxInFrustum(const Box3f& boxOs, const mat4f& obj2world, const Frustum& frustumWs)
+	{
+		vec3f pointsWs[8];
+		for (int iPt = 0; iPt < 8; ++iPt) {
+			pointsWs[iPt] = mat_mul_pos(obj2world, boxOs.getPoint(iPt));
+		}
+
+		return !frustumWs.is8PointConvexHullOutside(pointsWs);
+	}
+} // namespace
+
+void ActorPicker::build(GameWorld& world, const ICamera& camera)
+{
+	clear();
+
+	// CAUTION: The ordering must match the one in SelectionToolModeActors.
+	for (const auto& objects : world.playingObjects) {
+		for (GameObject* const object : objects.second) {
+			Item item;
+			Box3f boxWs;
+
+			item.actor = dynamic_cast<Actor*>(object);
+			if (item.actor != nullptr) {
+				const TraitViewportIcon* const traitIcon = getTrait<TraitViewportIcon>(item.actor);
+				item.traitModel = getTrait<TraitModel>(item.actor);
+
+				TraitPath3D* const traitPath = getTrait<TraitPath3D>(item.actor);
+				const mat4f actor2world = item.actor->getTransformMtx();
+
+				if (item.traitModel == nullptr && traitIcon != nullptr && traitIcon->getIconTexture() != nullptr) {
+					item.isViewportIcon = true;
+					item.iconNode2world = traitIcon->computeNodeToWorldMtx(camera);
+					boxWs = kIconQuadBoxOs.getTransformed(item.iconNode2world);
+				}
+				else {
+					boxWs = item.actor->getBBoxOS().getTransformed(actor2world);
+				}
+
+				if (traitPath != nullptr && !traitPath->isEmpty()) {
+					const float totalLength = traitPath->getTotalLength();
+					float maxCameraDistance = 0.f;
+					item.pathPointsStart = int(m_pathPointsWs.size());
+					for (int iPt = 0; iPt <= kNumPathSegments; ++iPt) {
+						const float distance = totalLength * float(iPt) / float(kNumPathSegments);
+						vec3f ptOs;
+						if (traitPath->evaluateAtDistance(&ptOs, nullptr, distance)) {
+							m_pathPointsWs.push_back(mat_mul_pos(actor2world, ptOs));
+							boxWs.expand(m_pathPointsWs.back());
+							maxCameraDistance = std::max(
+							    maxCameraDistance, (m_pathPointsWs.back() - camera.getCameraPosition()).length());
+						}
+					}
+					item.numPathPoints = int(m_pathPointsWs.size()) - item.pathPointsStart;
+
+					// Grow the box by the pick radius, otherwise the rays passing near the path would miss it.
+					const vec3f pickRadius = vec3f(kPathPickRadiusPerDistance * maxCameraDistance);
+					boxWs.min -= pickRadius;
+					boxWs.max += pickRadius;
+				}
+
+				TraitRigidBody* const traitRB = getTrait<TraitRigidBody>(item.actor);
+				if (traitRB != nullptr && traitRB->getRigidBody()->isValid()) {
+					item.traitRB = traitRB;
+				}
+
+				if (boxWs.isEmpty()) {
+					boxWs = Box3f::getFromHalfDiagonal(vec3f(kEmptyActorBoxHalfSize), item.actor->getPosition());
+				}
+			}
+
+			m_items.push_back(item);
+			m_itemBoxesWs.push_back(boxWs);
+		}
+	}
+
+	m_bvh.build(m_itemBoxesWs.data(), int(m_itemBoxesWs.size()));
+}
+
+void ActorPicker::clear()
+{
+	m_items.clear();
+	m_itemBoxesWs.clear();
+	m_pathPointsWs.clear();
+	m_bvh.clear();
+}
+
+int ActorPicker::pickRay(const Ray& rayWs, float* const outT) const
+{
+	return m_bvh.raycast(
+	    rayWs.pos,
+	    rayWs.dir,
+	    [&](const int iItem, const float tBoxEnter) -> float { return intersectItem(iItem, rayWs, tBoxEnter); },
+	    outT);
+}
+
+void ActorPicker::pickFrustum(const Frustum& frustumWs, std::vector<int>& outItems) const
+{
+	m_bvh.queryFrustum(frustumWs, [&](const int iItem) -> void {
+		if (isItemInFrustum(iItem, frustumWs)) {
+			outItems.push_back(iItem);
+		}
+	});
+}
+
+Actor* ActorPicker::getItemActor(int const itemIndex) const
+{
+	if (itemIndex < 0 || itemIndex >= int(m_items.size())) {
+		return nullptr;
+	}
+
+	return m_items[itemIndex].actor;
+}
+
+float ActorPicker::intersectItem(int const itemIndex, const Ray& rayWs, float const tBoxEnter) const
+{
+	const Item& item = m_items[itemIndex];
+
+	// Actors with an icon or a path are picked only by them, the bounding box would cover a lot of empty space.
+	if (item.isViewportIcon || item.numPathPoints > 0) {
+		float closestT = FLT_MAX;
+
+		if (item.isViewportIcon) {
+			const vec3f quadOrigin = mat_mul_pos(item.iconNode2world, vec3f(0.f));
+			const vec3f quadEdgeY = mat_mul_dir(item.iconNode2world, vec3f(0.f, 1.f, 0.f));
+			const vec3f quadEdgeZ = mat_mul_dir(item.iconNode2world, vec3f(0.f, 0.f, 1.f));
+			const float t = IntersectRayQuad(rayWs, quadOrigin, quadEdgeY, quadEdgeZ);
+			if (t >= 0.f) {
+				closestT = t;
+			}
+		}
+
+		// The pick radius grows with the distance so the path is equally easy to click at any distance.
+		const float rayDirLength = rayWs.dir.length();
+		for (int iPt = 1; iPt < item.numPathPoints; ++iPt) {
+			const vec3f& a = m_pathPointsWs[item.pathPointsStart + iPt - 1];
+			const vec3f& b = m_pathPointsWs[item.pathPointsStart + iPt];
+
+			float t = 0.f;
+			const float distance = getRaySegmentDistance(rayWs.pos, rayWs.dir, a, b, &t);
+			if (t > 0.f && distance <= kPathPickRadiusPerDistance * t * rayDirLength) {
+				closestT = std::min(closestT, t);
+			}
+		}
+
+		return closestT;
+	}
+
+	const mat4f actor2world = item.actor->getTransformMtx();
+
+	if (item.traitModel != nullptr) {
+		float closestT = FLT_MAX;
+		bool hasAnyModel = false;
+
+		for (ModelEntry& modelEntry : item.traitModel->m_models) {
+			if (!modelEntry.isRenderable) {
+				continue;
+			}
+
+			const EvaluatedModel* const evalModel = getRenderedEvalModel(modelEntry);
+			if (evalModel == nullptr) {
+				continue;
+			}
+
+			hasAnyModel = true;
+
+			// Transforming the ray without normalizing its direction keeps the ray parameter the same in both spaces.
+			const mat4f world2model = inverse(actor2world * modelEntry.m_additionalTransform);
+			const Ray rayMs(mat_mul_pos(world2model, rayWs.pos), mat_mul_dir(world2model, rayWs.dir));
+
+			closestT = std::min(closestT, evalModel->intersectRay(rayMs));
+		}
+
+		// If the trait has no models loaded, fallback to the shapes below.
+		if (hasAnyModel) {
+			return closestT;
+		}
+	}
+
+	const Box3f bboxOs = item.actor->getBBoxOS();
+
+	if (item.traitRB != nullptr) {
+		// Cast the ray through the whole bounding box of the item, the hit fraction is relative to that length.
+		const float tRayEnd = tBoxEnter + m_itemBoxesWs[itemIndex].diagonal().length() / rayWs.dir.length();
+
+		btTransform rayFrom;
+		rayFrom.setIdentity();
+		rayFrom.setOrigin(toBullet(rayWs.pos));
+		btTransform rayTo;
+		rayTo.setIdentity();
+		rayTo.setOrigin(toBullet(rayWs.pos + rayWs.dir * tRayEnd));
+
+		btCollisionObject* const collisionObject = item.traitRB->getRigidBody()->getBulletCollisionObject();
+		btCollisionWorld::ClosestRayResultCallback rayResult(rayFrom.getOrigin(), rayTo.getOrigin());
+		btCollisionWorld::rayTestSingle(
+		    rayFrom,
+		    rayTo,
+		    collisionObject,
+		    collisionObject->getCollisionShape(),
+		    collisionObject->getWorldTransform(),
+		    rayResult);
+
+		const float t = rayResult.m_closestHitFraction * tRayEnd;
+		return rayResult.hasHit() && t > 0.f ? t : FLT_MAX;
+	}
+
+	if (bboxOs.isEmpty()) {
+		return tBoxEnter > 0.f ? tBoxEnter : FLT_MAX;
+	}
+
+	// Test the oriented bounding box, a ray starting inside of it doesn't hit it, otherwise the actor would
+	// be picked instead of the actors around the camera.
+	const mat4f world2actor = inverse(actor2world);
+	const vec3f rayDirOs = mat_mul_dir(world2actor, rayWs.dir);
+	const vec3f invRayDirOs = vec3f(1.f / rayDirOs.x, 1.f / rayDirOs.y, 1.f / rayDirOs.z);
+
+	float t = 0.f;
+	if (bboxOs.intersectFast(mat_mul_pos(world2actor, rayWs.pos), invRayDirOs, t) && t > 0.f) {
+		return t;
+	}
+
+	return FLT_MAX;
+}
+
+bool ActorPicker::isItemInFrustum(int const itemIndex, const Frustum& frustumWs) const
+{
+	const Item& item = m_items[itemIndex];
+
+	if (item.isViewportIcon || item.numPathPoints > 0) {
+		if (item.isViewportIcon && !frustumWs.isBoxOutside(kIconQuadBoxOs.getTransformed(item.iconNode2world))) {
+			return true;
+		}
+
+		for (int iPt = 1; iPt < item.numPathPoints; ++iPt) {
+			Box3f segmentBoxWs;
+			segmentBoxWs.expand(m_pathPointsWs[item.pathPointsStart + iPt - 1]);
+			segmentBoxWs.expand(m_pathPointsWs[item.pathPointsStart + iPt]);
+			if (!frustumWs.isBoxOutside(segmentBoxWs)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	const mat4f actor2world = item.actor->getTransformMtx();
+
+	if (item.traitModel != nullptr) {
+		bool hasAnyModel = false;
+
+		for (ModelEntry& modelEntry : item.traitModel->m_models) {
+			if (!modelEntry.isRenderable) {
+				continue;
+			}
+
+			const EvaluatedModel* const evalModel = getRenderedEvalModel(modelEntry);
+			if (evalModel == nullptr) {
+				continue;
+			}
+
+			hasAnyModel = true;
+
+			const mat4f model2world = actor2world * modelEntry.m_additionalTransform;
+			for (const EvaluatedMeshInstance& meshInst : evalModel->getEvalMeshInstances()) {
+				if (!frustumWs.isBoxOutside(meshInst.modelSpaceBBox.getTransformed(model2world))) {
+					return true;
+				}
+			}
+		}
+
+		// If the trait has no models loaded, fallback to the bounding box below.
+		if (hasAnyModel) {
+			return false;
+		}
+	}
+
+	const Box3f bboxOs = item.actor->getBBoxOS();
+	if (bboxOs.isEmpty()) {
+		return !frustumWs.isSphereOutside(item.actor->getPosition(), kEmptyActorBoxHalfSize);
+	}
+
+	return isOrientedBoxInFrustum(bboxOs, actor2world, frustumWs);
+}
+
+} // namespace sge
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "sge_engine_api.h"
+#include "sge_utils/math/BoxBVH.h"
+#include "sge_utils/math/mat4f.h"
+#include "sge_utils/math/primitives.h"
+#include <vector>
+
+namespace sge {
+
+struct Actor;
+struct GameWorld;
+struct ICamera;
+struct TraitModel;
+struct TraitRigidBody;
+
+/// ActorPicker finds the actors under the cursor (a ray) or inside a selection rectangle (a frustum) on the CPU.
+/// It holds a BVH of the world space bounding boxes of all actors in the world at the time of @build.
+/// Ray hits are refined with ray/triangle tests against the 3D models of the actors (see TraitModel), viewport icons
+/// (see TraitViewportIcon) are tested against their billboarded quad and paths (see TraitPath3D) against a polyline
+/// sampled along them. Actors with only a rigid body are tested against its collision shape, all other actors are
+/// tested against their oriented bounding box. A ray starting inside of a box doesn't hit it.
+/// The returned item indices follow the order of GameWorld::playingObjects (the same as SelectionToolModeActors),
+/// game objects that aren't actors get an index but are never returned.
+struct SGE_ENGINE_API ActorPicker {
+	/// Collects the bounding boxes of all actors and builds the BVH.
+	/// @param [in] camera is used to compute the billboarded quads of the viewport icons.
+	void build(GameWorld& world, const ICamera& camera);
+
+	void clear();
+
+	/// Returns the index of the closest actor hit by the ray (in world space) or -1 if nothing was hit.
+	/// @param [out] outT the ray parameter of the closest hit.
+	int pickRay(const Ray& rayWs, float* const outT = nullptr) const;
+
+	/// Appends the indices of all actors touching the frustum (in world space) to @outItems.
+	void pickFrustum(const Frustum& frustumWs, std::vector<int>& outItems) const;
+
+	/// Returns the actor of the specified item or nullptr if the item isn't an actor.
+	Actor* getItemActor(int const itemIndex) const;
+
+	int getNumItems() const { return int(m_items.size()); }
+
+  private:
+	struct Item {
+		Actor* actor = nullptr;
+		TraitModel* traitModel = nullptr;
+		bool isViewportIcon = false;
+		/// The transform of the billboarded icon quad, valid only if @isViewportIcon is true.
+		mat4f iconNode2world = mat4f::getIdentity();
+		/// The range in @m_pathPointsWs of the polyline sampled along the TraitPath3D of the actor.
+		int pathPointsStart = 0;
+		int numPathPoints = 0;
+		/// Used for actors without a model, icon and path, nullptr if the actor has no valid rigid body.
+		TraitRigidBody* traitRB = nullptr;
+	};
+
+	/// Returns the ray parameter of the exact intersection with the item or FLT_MAX if there is none.
+	float intersectItem(int const itemIndex, const Ray& rayWs, float const tBoxEnter) const;
+
+	/// Returns true if the item touches the frustum. The bounding box of the item is already known to touch it.
+	bool isItemInFrustum(int const itemIndex, const Frustum& frustumWs) const;
+
+  private:
+	std::vector<Item> m_items;
+	std::vector<Box3f> m_itemBoxesWs;
+	std::vector<vec3f> m_pathPointsWs;
+	BoxBVH m_bvh;
+};
+
+} // namespace sge
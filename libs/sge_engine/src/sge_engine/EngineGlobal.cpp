@@ -135,6 +135,14 @@ void EngineGlobal::initialize()
 
 void EngineGlobal::update(float dt)
 {
+	// Finalize the assets that were loaded asynchronously.
+	getCore()->getAssetLib()->updateAsyncLoading();
+
+	// Send the changes of the playing sounds to the audio thread and free the ones that have finished.
+	if (AudioDevice* const audioDevice = getCore()->getAudioDevice()) {
+		audioDevice->update();
+	}
+
 	// Delete expiered notification messages.
 	for (int t = 0; t < int(m_notifications.size()); ++t) {
 		m_notifications[t].timeDisplayed += dt;
@@ -507,21 +507,29 @@ void DefaultGameDrawer::drawWorld(const GameDrawSets& drawSets, const DrawReason
 {
 	clearRenderItems();
 
-	// Get the render items for all actors in the scene.
-	getWorld()->iterateOverPlayingObjects(
-	    [this, &drawSets, &drawReason](GameObject* object) -> bool {
-		    // TODO: Skip this check for whole types. We know they are not actors...
-		    if (Actor* actor = object->getActor()) {
-			    Box3f actorBboxOS = actor->getBBoxOS();
-			    SelectedItemDirect item;
-			    item.editMode = editMode_actors;
-			    item.gameObject = actor;
-			    getRenderItemsForActor(drawSets, item, drawReason);
-		    }
-
-		    return true;
-	    },
-	    false);
+	const auto addActorRenderItems = [this, &drawSets, &drawReason](Actor* const actor) -> void {
+		SelectedItemDirect item;
+		item.editMode = editMode_actors;
+		item.gameObject = actor;
+		getRenderItemsForActor(drawSets, item, drawReason);
+	};
+
+	// Get the render items for all actors that might be visible. The spatial index of the world culls the rest
+	// without touching them, this matters a lot for the shadow maps, as they get drawn many times per frame.
+	if (const Frustum* const frustumWs = drawSets.drawCamera->getFrustumWS()) {
+		getWorld()->queryActorsInFrustum(*frustumWs, addActorRenderItems);
+	}
+	else {
+		getWorld()->iterateOverPlayingObjects(
+		    [&addActorRenderItems](GameObject* object) -> bool {
+			    if (Actor* actor = object->getActor()) {
+				    addActorRenderItems(actor);
+			    }
+
+			    return true;
+		    },
+		    false);
+	}
 
 	// Draw the render items.
 	drawCurrentRenderItems(drawSets, drawReason, true);
@@ -718,20 +726,22 @@ void DefaultGameDrawer::drawRenderItem_TraitParticlesSimple(
 		{
 			const auto& itr = ttParticles->m_pgroupState.find(pdesc.m_name);
 			if (itr != ttParticles->m_pgroupState.end()) {
-				const mat4f n2w = mat4f::getIdentity();
+				const bool isShadowMap = drawReason == drawReason_gameplayShadow;
 
 				ParticleGroupState& pstate = itr->second;
 				ParticleGroupState::SpriteRendData* srd =
-				    pstate.computeSpriteRenderData(*drawSets.rdest.sgecon, pdesc, *drawSets.drawCamera);
+				    pstate.computeSpriteRenderData(*drawSets.rdest.sgecon, pdesc, *drawSets.drawCamera, !isShadowMap);
 				if (srd != nullptr) {
-					drawGeometry(
+					m_spriteParticlesShader.draw(
 					    drawSets.rdest,
-					    *drawSets.drawCamera,
-					    n2w,
-					    lighting,
-					    srd->geometry,
-					    &srd->material,
-					    InstanceDrawMods());
+					    camPos,
+					    drawSets.drawCamera->getProjView(),
+					    drawSets.drawCamera->getView(),
+					    isShadowMap ? drawSets.shadowMapBuildInfo : nullptr,
+					    srd->instanceBuffer,
+					    srd->instancesByteOffset,
+					    srd->numInstances,
+					    srd->texture);
 				}
 			}
 		}
@@ -4,6 +4,7 @@
 #include "sge_core/shaders/ConstantColorShader.h"
 #include "sge_core/shaders/FWDBuildShadowMapShader.h"
 #include "sge_core/shaders/SkyShader.h"
+#include "sge_core/shaders/SpriteParticlesShader.h"
 #include "sge_engine/GameDrawer/GameDrawer.h"
 #include "sge_engine/GameObject.h"
 #include "sge_engine/TexturedPlaneDraw.h"
@@ -125,6 +126,7 @@ struct SGE_ENGINE_API DefaultGameDrawer : public IGameDrawer {
 	FWDBuildShadowMapShader m_shadowMapBuilder;
 	ConstantColorWireShader m_constantColorShader;
 	SkyShader m_skyShader;
+	SpriteParticlesShader m_spriteParticlesShader;
 	TexturedPlaneDraw m_texturedPlaneDraw;
 	ParticleRenderDataGen m_partRendDataGen;
 
@@ -82,6 +82,13 @@ struct SGE_ENGINE_API GameObject : public NoCopy {
 	// For example during update() the object shouldn't delete it's rigid bodies
 	// as other object may rely on the contact manifolds with that object.
 	// use the postUpdate() for such manipulations.
+	// If the type is registered with TF_ParallelUpdate, update() gets called from worker threads
+	// at the same time for other objects of that type. In that case the object must not change anything but itself
+	// (no allocating, deleting or re-parenting objects, no changes in other objects, no direct calls to the physics).
+	// Moving the actor is fine, its rigid body is moved to the new transform after all objects of the type are updated.
+	// The actors that have a parent or children are always updated serially, as moving them changes the transforms
+	// of the other actors in their hierarchy.
+	// No engine type is marked with TF_ParallelUpdate, it is meant for game types with many simple objects.
 	virtual void update(const GameUpdateSets& UNUSED(updateSets)) {}
 
 	/// Called when the object enters or leaves the game.
@@ -162,6 +169,18 @@ struct SGE_ENGINE_API GameObject : public NoCopy {
 	std::vector<TraitRegistration> m_traits;
 };
 
+/// @brief Computes the @TypeFlags that could be deduced at compile time for the specified game object type.
+/// Used by the ReflAddActor, ReflAddObject and ReflAddScript macros.
+template <typename T>
+constexpr unsigned computeGameObjectTypeFlags()
+{
+	// If T (or any of its bases) doesn't override GameObject::update, &T::update is the GameObject method itself.
+	constexpr bool isUpdateOverriden =
+	    !std::is_same<decltype(&T::update), void (GameObject::*)(const GameUpdateSets&)>::value;
+
+	return isUpdateOverriden ? 0u : unsigned(TF_NoUpdate);
+}
+
 /// @brief A structure describing a selection in SGEEditor.
 struct SelectedItem {
 	SelectedItem() = default;
@@ -1,13 +1,22 @@
 #include "GameSerialization.h"
 #include "GameInspector.h"
 #include "GameWorld.h"
+#include "SerializationPlan.h"
 #include "sge_core/AssetLibrary/AssetLibrary.h"
 #include "sge_core/ICore.h"
 #include "sge_log/Log.h"
 #include "sge_utils/io/FileStream.h"
+#include "sge_utils/io/MemoryMappedFile.h"
 #include "sge_utils/json/json.h"
 #include "sge_utils/math/transform.h"
+#include "sge_utils/text/Path.h"
 #include "sge_utils/text/format.h"
+#include "sge_utils/time/Timer.h"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace sge {
 
@@ -24,411 +33,367 @@ JsonValue* serializeVariableT(const T& value, JsonValueBuffer& jvb)
 	return serializeVariable(typeLib().find(sgeTypeId(T)), (char*)&value, jvb);
 }
 
+/// Returns the path of the asset used as @assetIface. An empty string means no asset is specified.
+/// Or the <TAssetIface> does not inherit Asset so we canot just save a path.
 /// @T needs to be somethings that inherits IAssetInterface.
 template <typename TAssetIface>
-JsonValue* serializeAssetInterface(std::shared_ptr<TAssetIface>& assetIface, JsonValueBuffer& jvb)
+std::string getAssetInterfacePath(const std::shared_ptr<TAssetIface>& assetIface)
 {
 	AssetPtr asset = std::dynamic_pointer_cast<Asset>(assetIface);
 	if (isAssetLoaded(asset)) {
-		return jvb(asset->getPath());
+		return asset->getPath();
 	}
-	// An empty string means no asset is specified. Or the <TAssetIface> does not inherit Asset so we canot just save a
-	// path.
-	return jvb("");
+	return std::string();
 }
 
 /// @T needs to be somethings that inherits IAssetInterface.
 template <typename TAssetIface>
-void deserializeAssetInterface(std::shared_ptr<TAssetIface>& assetIface, const JsonValue* jValue)
+void loadAssetInterface(std::shared_ptr<TAssetIface>& assetIface, const char* const assetPath)
 {
-	if (jValue->isString()) {
-		const char* const assetPath = jValue->GetString();
-		if (!isStringEmpty(assetPath)) {
-			AssetPtr assets = getCore()->getAssetLib()->getAssetFromFile(assetPath, nullptr, true);
-			assetIface = std::dynamic_pointer_cast<TAssetIface>(assets);
-		}
+	if (!isStringEmpty(assetPath)) {
+		AssetPtr assets = getCore()->getAssetLib()->getAssetFromFile(assetPath, nullptr, true);
+		assetIface = std::dynamic_pointer_cast<TAssetIface>(assets);
 	}
 }
 
-JsonValue* serializeVariable(const TypeDesc* const typeDesc, const char* const data, JsonValueBuffer& jvb)
+/// Returns true if the member of the transform pointed by @transformData has its default value.
+/// Caution:
+/// [TRANSF3D_GAME_SERIALIZATION]
+/// As a lot of comoments in a trasform are usually default (particularly rotation or scaling),
+/// we could save a lot of space by not serializing them and using the defaults for them.
+/// Each object has at least two transforms so this is a quite benefitial optimization.
+static bool isTransformMemberDefault(const SerializationPlan::Member& member, const char* const transformData)
 {
-	if (typeDesc == NULL) {
-		sgeLogError("[SERIALIZATION] No TypeDesc was specified to %s\n", __func__);
-		sgeAssert(false);
-		return nullptr;
-	}
+	static const transf3d defaultTransform;
 
-	if (data == NULL) {
-		sgeLogError("[SERIALIZATION] No data was specified to %s for type %s\n", __func__, typeDesc->name);
-		sgeAssert(false);
-		return nullptr;
-	}
+	const TypeDesc* const memberTypeDesc = member.plan->typeDesc;
+	const int byteOffset = member.memberDesc->byteOffset;
+	return memberTypeDesc->equalsFn != nullptr &&
+	       memberTypeDesc->equalsFn(transformData + byteOffset, (const char*)&defaultTransform + byteOffset);
+}
 
-	// Check if this is a primitive type.
-	if (typeDesc->typeId == sgeTypeId(unsigned)) {
-		return jvb(*(unsigned*)data);
-	}
-	else if (typeDesc->typeId == sgeTypeId(int)) {
-		return jvb(*(int*)data);
-	}
-	else if (typeDesc->typeId == sgeTypeId(float)) {
-		return jvb(*(float*)data);
-	}
-	else if (typeDesc->typeId == sgeTypeId(char)) {
-		return jvb(*(char*)data);
-	}
-	else if (typeDesc->typeId == sgeTypeId(bool)) {
-		return jvb(*(bool*)data);
-	}
-	else if (typeDesc->typeId == sgeTypeId(std::string)) {
-		return jvb(*(std::string*)data);
-	}
-	else if (typeDesc->typeId == sgeTypeId(transf3d)) {
-		// Caution:
-		// [TRANSF3D_GAME_SERIALIZATION]
-		// As a lot of comoments in a trasform are usually default (particularly rotation or scaling),
-		// we could save a lot of space by not serializing them and using the defaults for them.
-		// Each object has at least two transforms so this is a quite benefitial optimization.
-		const transf3d& transf = *reinterpret_cast<const transf3d*>(data);
-		JsonValue* const jTransform = jvb(JID_MAP);
-		if (transf.p != vec3f(0.f)) {
-			jTransform->setMember(
-			    "p", serializeVariable(typeLib().find(sgeTypeId(decltype(transf.p))), (char*)&transf.p, jvb));
-		}
-		if (transf.r != quatf::getIdentity()) {
-			jTransform->setMember(
-			    "r", serializeVariable(typeLib().find(sgeTypeId(decltype(transf.r))), (char*)&transf.r, jvb));
-		}
-		if (transf.s != vec3f(1.f)) {
-			jTransform->setMember(
-			    "s", serializeVariable(typeLib().find(sgeTypeId(decltype(transf.s))), (char*)&transf.s, jvb));
-		}
+static JsonValue* serializeVariableByPlan(const SerializationPlan& plan, const char* const data, JsonValueBuffer& jvb);
 
-		return jTransform;
+/// Serializes the specified member of the struct pointed by @structData.
+static JsonValue*
+    serializeMemberByPlan(const SerializationPlan::Member& member, const char* const structData, JsonValueBuffer& jvb)
+{
+	const MemberDesc& mfd = *member.memberDesc;
+	if (mfd.byteOffset >= 0) {
+		return serializeVariableByPlan(*member.plan, structData + mfd.byteOffset, jvb);
 	}
-	else if (typeDesc->typeId == sgeTypeId(AssetPtr)) {
-		AssetPtr& asset = *(AssetPtr*)data;
-		if (asset) {
-			return jvb(asset->getPath());
+
+	// The member is accessed with a getter.
+	const TypeDesc* const memberTypeDesc = member.plan->typeDesc;
+	char* const memberData = (char*)alloca(mfd.sizeBytes);
+	memberTypeDesc->constructorFn(memberData);
+	mfd.getDataFn((void*)structData, memberData);
+
+	JsonValue* const jMember = serializeVariableByPlan(*member.plan, memberData, jvb);
+	memberTypeDesc->destructorFn(memberData);
+
+	return jMember;
+}
+
+static JsonValue* serializeVariableByPlan(const SerializationPlan& plan, const char* const data, JsonValueBuffer& jvb)
+{
+	switch (plan.kind) {
+		case serializedKind_int:
+			return jvb(*(const int*)data);
+		case serializedKind_unsigned:
+			return jvb(*(const unsigned*)data);
+		case serializedKind_float:
+			return jvb(*(const float*)data);
+		case serializedKind_char:
+			return jvb(*(const char*)data);
+		case serializedKind_bool:
+			return jvb(*(const bool*)data);
+		case serializedKind_string:
+			return jvb(*(const std::string*)data);
+		case serializedKind_transf3d: {
+			// See [TRANSF3D_GAME_SERIALIZATION].
+			JsonValue* const jTransform = jvb(JID_MAP);
+			for (const SerializationPlan::Member& member : plan.members) {
+				if (isTransformMemberDefault(member, data) == false) {
+					jTransform->setMember(
+					    member.memberDesc->name,
+					    serializeVariableByPlan(*member.plan, data + member.memberDesc->byteOffset, jvb));
+				}
+			}
+
+			return jTransform;
 		}
-		else {
-			return jvb("");
+		case serializedKind_assetPtr: {
+			const AssetPtr& asset = *(const AssetPtr*)data;
+			if (asset) {
+				return jvb(asset->getPath());
+			}
+			else {
+				return jvb("");
+			}
 		}
-	}
-	else if (typeDesc->typeId == sgeTypeId(std::shared_ptr<AssetIface_Material>)) {
-		std::shared_ptr<AssetIface_Material>* pAssetIface = (std::shared_ptr<AssetIface_Material>*)data;
-		return serializeAssetInterface<AssetIface_Material>(*pAssetIface, jvb);
-	}
-	else if (typeDesc->typeId == sgeTypeId(std::shared_ptr<AssetIface_Model3D>)) {
-		std::shared_ptr<AssetIface_Model3D>* pAssetIface = (std::shared_ptr<AssetIface_Model3D>*)data;
-		return serializeAssetInterface<AssetIface_Model3D>(*pAssetIface, jvb);
-	}
-	else if (typeDesc->typeId == sgeTypeId(std::shared_ptr<AssetIface_Texture2D>)) {
-		std::shared_ptr<AssetIface_Texture2D>* pAssetIface = (std::shared_ptr<AssetIface_Texture2D>*)data;
-		return serializeAssetInterface<AssetIface_Texture2D>(*pAssetIface, jvb);
-	}
-	else if (typeDesc->enumUnderlayingType.isValid()) {
-		// This is an enum. Pass this to be serailized as its underlying type.
-		// TODO: Concider adding the text in some way.
-		return serializeVariable(typeLib().find(typeDesc->enumUnderlayingType), data, jvb);
-	}
-	else if (typeDesc->stdVectorUnderlayingType.isValid()) {
-		// The type is std::vector
-		JsonValue* result = jvb(JID_ARRAY);
+		case serializedKind_assetIfaceMaterial:
+			return jvb(getAssetInterfacePath(*(const std::shared_ptr<AssetIface_Material>*)data));
+		case serializedKind_assetIfaceModel3D:
+			return jvb(getAssetInterfacePath(*(const std::shared_ptr<AssetIface_Model3D>*)data));
+		case serializedKind_assetIfaceTexture2D:
+			return jvb(getAssetInterfacePath(*(const std::shared_ptr<AssetIface_Texture2D>*)data));
+		case serializedKind_stdVector: {
+			const TypeDesc* const typeDesc = plan.typeDesc;
+			JsonValue* const jArray = jvb(JID_ARRAY);
+
+			const size_t numElements = typeDesc->stdVectorSize(data);
+			jArray->arrReserve(numElements);
+			for (size_t t = 0; t < numElements; ++t) {
+				const char* const elementData = (const char*)typeDesc->stdVectorGetElementConst(data, t);
+				jArray->arrPush(serializeVariableByPlan(*plan.elementPlan, elementData, jvb));
+			}
 
-		size_t const numElements = typeDesc->stdVectorSize(data);
-		for (int t = 0; t < numElements; ++t) {
-			const char* const elementData = (const char*)typeDesc->stdVectorGetElementConst(data, t);
-			result->arrPush(serializeVariable(typeLib().find(typeDesc->stdVectorUnderlayingType), elementData, jvb));
+			return jArray;
 		}
+		case serializedKind_stdMap: {
+			const TypeDesc* const typeDesc = plan.typeDesc;
+			const TypeDesc* const keyTd = plan.elementPlan->typeDesc;
+			const TypeDesc* const valueTd = plan.mapValuePlan->typeDesc;
 
-		return result;
-	}
-	else if (typeDesc->stdMapKeyType.isValid() && typeDesc->stdMapKeyType.isValid()) {
-		const TypeDesc* keyTd = typeLib().find(typeDesc->stdMapKeyType);
-		const TypeDesc* ValueTd = typeLib().find(typeDesc->stdMapValueType);
-
-		// The type is std::map
-		JsonValue* jMapAsArray = jvb(JID_ARRAY);
+			// The map is saved as an array of key-value pairs.
+			JsonValue* const jMapAsArray = jvb(JID_ARRAY);
 
-		const size_t mapSize = typeDesc->stdMapSize((void*)data);
+			const size_t mapSize = typeDesc->stdMapSize((void*)data);
 
-		void* tempKey = keyTd->newFn();
-		void* tempValue = ValueTd->newFn();
-
-		for (size_t t = 0; t < mapSize; ++t) {
-			if (t != 0) {
-				// the new, call already called the constructor.
-				keyTd->constructorFn(tempKey);
-				ValueTd->constructorFn(tempValue);
-			}
+			void* tempKey = keyTd->newFn();
+			void* tempValue = valueTd->newFn();
 
-			typeDesc->stdMapGetNthPair((void*)data, t, tempKey, tempValue);
+			for (size_t t = 0; t < mapSize; ++t) {
+				if (t != 0) {
+					// Reset the temporaries, the last ones are destroyed by deleteFn.
+					keyTd->destructorFn(tempKey);
+					valueTd->destructorFn(tempValue);
+					keyTd->constructorFn(tempKey);
+					valueTd->constructorFn(tempValue);
+				}
 
-			JsonValue* jKey = serializeVariable(typeLib().find(typeDesc->stdMapKeyType), (char*)tempKey, jvb);
-			JsonValue* jValue = serializeVariable(typeLib().find(typeDesc->stdMapValueType), (char*)tempValue, jvb);
+				typeDesc->stdMapGetNthPair((void*)data, t, tempKey, tempValue);
 
-			JsonValue* jMapEntry = jvb(JID_MAP);
-			jMapEntry->setMember("key", jKey);
-			jMapEntry->setMember("value", jValue);
+				JsonValue* const jMapEntry = jMapAsArray->arrPush(jvb(JID_MAP));
+				jMapEntry->setMember("key", serializeVariableByPlan(*plan.elementPlan, (char*)tempKey, jvb));
+				jMapEntry->setMember("value", serializeVariableByPlan(*plan.mapValuePlan, (char*)tempValue, jvb));
+			}
 
-			jMapAsArray->arrPush(jMapEntry);
+			// Delete the allocated memory.
+			keyTd->deleteFn(tempKey);
+			valueTd->deleteFn(tempValue);
 
-			// Call the destructor.
-			keyTd->destructorFn(tempKey);
-			ValueTd->destructorFn(tempValue);
+			return jMapAsArray;
 		}
+		case serializedKind_struct: {
+			JsonValue* const jResult = jvb(JID_MAP);
 
-		// Delete the allocated memory.
-		keyTd->deleteFn(tempKey);
-		tempKey = nullptr;
-		ValueTd->deleteFn(tempValue);
-		tempValue = nullptr;
+			for (const SerializationPlan::Member& member : plan.members) {
+				JsonValue* const jMember = serializeMemberByPlan(member, data, jvb);
+				if (jMember) {
+					jResult->setMember(member.memberDesc->name, jMember);
+				}
+				else {
+					sgeLogError(
+					    "[SERIALIZATION] Failed to serialize member %s::%s\n",
+					    plan.typeDesc->name,
+					    member.memberDesc->name);
+					sgeAssert(false);
+				}
+			}
 
-		return jMapAsArray;
+			return jResult;
+		}
+		default: {
+			sgeLogError("[SERIALIZATION] Unknown type type %s\n", plan.typeDesc->name);
+			sgeAssert(false);
+			return nullptr;
+		}
 	}
+}
 
-	// Assume that this is a struct.
-	if (typeDesc->members.size() == 0) {
-		sgeLogError("[SERIALIZATION] Unknown type type %s\n", typeDesc->name);
+JsonValue* serializeVariable(const TypeDesc* const typeDesc, const char* const data, JsonValueBuffer& jvb)
+{
+	if (typeDesc == NULL) {
+		sgeLogError("[SERIALIZATION] No TypeDesc was specified to %s\n", __func__);
 		sgeAssert(false);
 		return nullptr;
 	}
 
-	JsonValue* const jResult = jvb(JID_MAP);
+	if (data == NULL) {
+		sgeLogError("[SERIALIZATION] No data was specified to %s for type %s\n", __func__, typeDesc->name);
+		sgeAssert(false);
+		return nullptr;
+	}
 
-	for (int iMember = 0; iMember < typeDesc->members.size(); ++iMember) {
-		const MemberDesc& mfd = typeDesc->members[iMember];
-		TypeDesc* const memberTypeDesc = typeLib().find(mfd.typeId);
-		if (mfd.isSaveable()) {
-			if (memberTypeDesc != nullptr) {
-				if (mfd.byteOffset >= 0) {
-					const char* const memberData = (char*)(data) + mfd.byteOffset;
-					JsonValue* const serializedMember = serializeVariable(memberTypeDesc, memberData, jvb);
+	return serializeVariableByPlan(*getSerializationPlan(typeDesc), data, jvb);
+}
 
-					if (serializedMember) {
-						jResult->setMember(mfd.name, serializedMember);
-					}
-					else {
-						sgeLogError("[SERIALIZATION] Failed to serialize member %s::%s\n", typeDesc->name, mfd.name);
-						sgeAssert(false);
-					}
-				}
-				else if (mfd.getDataFn != nullptr) {
-					char* const memberData = (char*)alloca(mfd.sizeBytes);
-					memberTypeDesc->constructorFn(memberData);
-					mfd.getDataFn((void*)data, memberData);
+static bool deserializeVariableByPlan(char* const valueData, const JsonValue* jValue, const SerializationPlan& plan);
 
-					JsonValue* const serializedMember = serializeVariable(memberTypeDesc, memberData, jvb);
+/// Deserializes the specified member of the struct pointed by @structData.
+static bool deserializeMemberByPlan(
+    const SerializationPlan::Member& member, char* const structData, const JsonValue* const jMember)
+{
+	const MemberDesc& mfd = *member.memberDesc;
+	if (mfd.byteOffset >= 0) {
+		return deserializeVariableByPlan(structData + mfd.byteOffset, jMember, *member.plan);
+	}
 
-					if (serializedMember) {
-						jResult->setMember(mfd.name, serializedMember);
-					}
-					else {
-						sgeLogError("[SERIALIZATION] Failed to serialize member %s::%s\n", typeDesc->name, mfd.name);
-						sgeAssert(false);
-					}
-				}
-			}
-			else {
-				sgeLogError("[SERIALIZATION] Found a member without a TypeDesc - %s::%s\n", typeDesc->name, mfd.name);
-				sgeAssert(false);
-			}
-		}
+	// Members that only have a getter cannot be loaded.
+	if (mfd.setDataFn == nullptr) {
+		return true;
 	}
 
-	return jResult;
+	const TypeDesc* const memberTypeDesc = member.plan->typeDesc;
+	char* const memberData = (char*)alloca(mfd.sizeBytes);
+	memberTypeDesc->constructorFn(memberData);
+
+	const bool succeeded = deserializeVariableByPlan(memberData, jMember, *member.plan);
+	mfd.setDataFn(structData, memberData);
+	memberTypeDesc->destructorFn(memberData);
+
+	return succeeded;
 }
 
-bool deserializeVariable(char* const valueData, const JsonValue* jValue, const TypeDesc* const typeDesc)
+static bool deserializeVariableByPlan(char* const valueData, const JsonValue* jValue, const SerializationPlan& plan)
 {
-	if (typeDesc == nullptr || jValue == nullptr || valueData == nullptr) {
+	if (jValue == nullptr) {
 		return false;
 	}
 
-	if (typeDesc->typeId == sgeTypeId(unsigned)) {
-		*(unsigned*)(valueData) = jValue->getNumberAs<unsigned>();
-		return true;
-	}
-	else if (typeDesc->typeId == sgeTypeId(int)) {
-		*(int*)(valueData) = jValue->getNumberAs<int>();
-		return true;
-	}
-	else if (typeDesc->typeId == sgeTypeId(float)) {
-		*(float*)(valueData) = jValue->getNumberAs<float>();
-		return true;
-	}
-	else if (typeDesc->typeId == sgeTypeId(char)) {
-		*(char*)(valueData) = jValue->getNumberAs<char>();
-		return true;
-	}
-	else if (typeDesc->typeId == sgeTypeId(bool)) {
-		*(bool*)(valueData) = jValue->getNumberAs<bool>();
-		return true;
-	}
-	else if (typeDesc->typeId == sgeTypeId(std::string)) {
-		*(std::string*)(valueData) = jValue->GetString();
-		return true;
-	}
-	else if (typeDesc->typeId == sgeTypeId(transf3d)) {
-		// Caution:
-		// [TRANSF3D_GAME_SERIALIZATION]
-		// As a lot of comoments in a trasform are usually default (particularly rotation or scaling),
-		// we could save a lot of space by not serializing them and using the defaults for them.
-		// Each object has at least two transforms so this is a quite benefitial optimization.
-		const JsonValue* jPosition = jValue->getMember("p");
-		const JsonValue* jRotation = jValue->getMember("r");
-		const JsonValue* jScale = jValue->getMember("s");
-
-		transf3d& transf = *reinterpret_cast<transf3d*>(valueData);
-		bool succeeded = true;
-		if (jPosition != nullptr) {
-			succeeded &=
-			    deserializeVariable((char*)&transf.p, jPosition, typeLib().find(sgeTypeId(decltype(transf.p))));
-		}
-		if (jRotation != nullptr) {
-			succeeded &=
-			    deserializeVariable((char*)&transf.r, jRotation, typeLib().find(sgeTypeId(decltype(transf.r))));
-		}
-		if (jScale != nullptr) {
-			succeeded &= deserializeVariable((char*)&transf.s, jScale, typeLib().find(sgeTypeId(decltype(transf.s))));
+	switch (plan.kind) {
+		case serializedKind_int:
+			*(int*)(valueData) = jValue->getNumberAs<int>();
+			return true;
+		case serializedKind_unsigned:
+			*(unsigned*)(valueData) = jValue->getNumberAs<unsigned>();
+			return true;
+		case serializedKind_float:
+			*(float*)(valueData) = jValue->getNumberAs<float>();
+			return true;
+		case serializedKind_char:
+			*(char*)(valueData) = jValue->getNumberAs<char>();
+			return true;
+		case serializedKind_bool:
+			*(bool*)(valueData) = jValue->getNumberAs<bool>();
+			return true;
+		case serializedKind_string: {
+			const char* const str = jValue->GetString();
+			*(std::string*)(valueData) = str ? str : "";
+			return true;
 		}
+		case serializedKind_transf3d: {
+			// See [TRANSF3D_GAME_SERIALIZATION], the missing members keep their default values.
+			bool succeeded = true;
+			for (const SerializationPlan::Member& member : plan.members) {
+				if (const JsonValue* const jMember = jValue->getMember(member.memberDesc->name)) {
+					succeeded &= deserializeMemberByPlan(member, valueData, jMember);
+				}
+			}
 
-		return succeeded;
-	}
-	else if (typeDesc->typeId == sgeTypeId(AssetPtr)) {
-		AssetPtr& asset = *reinterpret_cast<AssetPtr*>(valueData);
-
-		if (jValue->isString()) {
-			asset = getCore()->getAssetLib()->getAssetFromFile(jValue->GetString());
+			return succeeded;
 		}
-		return true;
-	}
-	else if (typeDesc->typeId == sgeTypeId(std::shared_ptr<AssetIface_Material>)) {
-		std::shared_ptr<AssetIface_Material>& assetIface =
-		    *reinterpret_cast<std::shared_ptr<AssetIface_Material>*>(valueData);
-		deserializeAssetInterface<AssetIface_Material>(assetIface, jValue);
-		return true;
-	}
-	else if (typeDesc->typeId == sgeTypeId(std::shared_ptr<AssetIface_Model3D>)) {
-		std::shared_ptr<AssetIface_Model3D>& assetIface =
-		    *reinterpret_cast<std::shared_ptr<AssetIface_Model3D>*>(valueData);
-		deserializeAssetInterface<AssetIface_Model3D>(assetIface, jValue);
-		return true;
-	}
-	else if (typeDesc->typeId == sgeTypeId(std::shared_ptr<AssetIface_Texture2D>)) {
-		std::shared_ptr<AssetIface_Texture2D>& assetIface =
-		    *reinterpret_cast<std::shared_ptr<AssetIface_Texture2D>*>(valueData);
-		deserializeAssetInterface<AssetIface_Texture2D>(assetIface, jValue);
-		return true;
-	}
-	else if (typeDesc->enumUnderlayingType.isValid()) {
-		// This is an enum. Pass this to be deserialized as its underlying type.
-		// TODO: Concider adding the text in some way.
-		return deserializeVariable(valueData, jValue, typeLib().find(typeDesc->enumUnderlayingType));
-	}
-	else if (typeDesc->stdVectorUnderlayingType.isValid()) {
-		// this is a std::vector<T>
-		int const numElements = int(jValue->arrSize());
-		typeDesc->stdVectorResize(valueData, numElements);
-
-		for (int t = 0; t < numElements; ++t) {
-			bool succeeded = deserializeVariable(
-			    (char*)typeDesc->stdVectorGetElement(valueData, t),
-			    jValue->arrAt(t),
-			    typeLib().find(typeDesc->stdVectorUnderlayingType));
-			if (!succeeded) {
-				return false;
+		case serializedKind_assetPtr: {
+			AssetPtr& asset = *reinterpret_cast<AssetPtr*>(valueData);
+			if (jValue->isString()) {
+				asset = getCore()->getAssetLib()->getAssetFromFile(jValue->GetString());
 			}
+			return true;
 		}
+		case serializedKind_assetIfaceMaterial:
+			loadAssetInterface(
+			    *reinterpret_cast<std::shared_ptr<AssetIface_Material>*>(valueData), jValue->GetString());
+			return true;
+		case serializedKind_assetIfaceModel3D:
+			loadAssetInterface(*reinterpret_cast<std::shared_ptr<AssetIface_Model3D>*>(valueData), jValue->GetString());
+			return true;
+		case serializedKind_assetIfaceTexture2D:
+			loadAssetInterface(
+			    *reinterpret_cast<std::shared_ptr<AssetIface_Texture2D>*>(valueData), jValue->GetString());
+			return true;
+		case serializedKind_stdVector: {
+			const TypeDesc* const typeDesc = plan.typeDesc;
+			const size_t numElements = jValue->arrSize();
+			typeDesc->stdVectorResize(valueData, numElements);
+
+			for (size_t t = 0; t < numElements; ++t) {
+				char* const elementData = (char*)typeDesc->stdVectorGetElement(valueData, t);
+				if (!deserializeVariableByPlan(elementData, jValue->arrAt(int(t)), *plan.elementPlan)) {
+					return false;
+				}
+			}
 
-		return true;
-	}
-	else if (typeDesc->stdMapKeyType.isValid() && typeDesc->stdMapKeyType.isValid()) {
-		// The type is std::map
-		int const numMapPairs = int(jValue->arrSize());
+			return true;
+		}
+		case serializedKind_stdMap: {
+			const TypeDesc* const typeDesc = plan.typeDesc;
+			const TypeDesc* const keyTd = plan.elementPlan->typeDesc;
+			const TypeDesc* const valueTd = plan.mapValuePlan->typeDesc;
 
-		const TypeDesc* keyTd = typeLib().find(typeDesc->stdMapKeyType);
-		const TypeDesc* ValueTd = typeLib().find(typeDesc->stdMapValueType);
+			const int numMapPairs = int(jValue->arrSize());
 
-		if (keyTd && ValueTd) {
 			void* tempKey = keyTd->newFn();
-			void* tempValue = ValueTd->newFn();
+			void* tempValue = valueTd->newFn();
 			for (int iPair = 0; iPair < numMapPairs; ++iPair) {
 				const JsonValue* const jPair = jValue->arrAt(iPair);
 
 				if (iPair != 0) {
-					// the new, call already called the constructor.
+					// Reset the temporaries, the last ones are destroyed by deleteFn.
+					keyTd->destructorFn(tempKey);
+					valueTd->destructorFn(tempValue);
 					keyTd->constructorFn(tempKey);
-					ValueTd->constructorFn(tempValue);
+					valueTd->constructorFn(tempValue);
 				}
 
-				deserializeVariable((char*)tempKey, jPair->getMember("key"), keyTd);
-				deserializeVariable((char*)tempValue, jPair->getMember("value"), ValueTd);
-
-				// Call the destructor.
-				keyTd->destructorFn(tempKey);
-				ValueTd->destructorFn(tempValue);
+				deserializeVariableByPlan((char*)tempKey, jPair->getMember("key"), *plan.elementPlan);
+				deserializeVariableByPlan((char*)tempValue, jPair->getMember("value"), *plan.mapValuePlan);
 
 				typeDesc->stdMapInsert(valueData, tempKey, tempValue);
 			}
 
 			keyTd->deleteFn(tempKey);
-			tempKey = nullptr;
-			ValueTd->deleteFn(tempValue);
-			tempValue = nullptr;
+			valueTd->deleteFn(tempValue);
 			return true;
 		}
-		else {
-			sgeAssert(false && "std::map types not defined");
-		}
-	}
-
-
-	// Assume that this is a struct.
-	if (jValue->jid != JID_MAP) {
-		return false;
-	}
-
-	for (int iMember = 0; iMember < typeDesc->members.size(); ++iMember) {
-		const MemberDesc& mfd = typeDesc->members[iMember];
-
-		if (mfd.isSaveable() == false) {
-			continue;
-		}
-
-		const JsonValue* const jMember = jValue->getMember(mfd.name);
-
-		if (jMember == nullptr) {
-			sgeLogWarn(
-			    "[DESERIALIZATION] Missing %s::%s, deserialization will be skipped.\n", typeDesc->name, mfd.name);
-			continue;
-		}
-		else {
-			bool succeeded = false;
-			if (mfd.byteOffset >= 0) {
-				succeeded = deserializeVariable(valueData + mfd.byteOffset, jMember, typeLib().find(mfd.typeId));
+		case serializedKind_struct: {
+			if (jValue->jid != JID_MAP) {
+				return false;
 			}
-			else if (mfd.setDataFn != nullptr) {
-				const TypeDesc* const memberTypeDesc = typeLib().find(mfd.typeId);
 
-				if (memberTypeDesc) {
-					char* const memberData = (char*)alloca(mfd.sizeBytes);
-					memberTypeDesc->constructorFn(memberData);
+			for (const SerializationPlan::Member& member : plan.members) {
+				const MemberDesc& mfd = *member.memberDesc;
+				const JsonValue* const jMember = jValue->getMember(mfd.name);
 
-					succeeded = deserializeVariable(memberData, jMember, memberTypeDesc);
-					mfd.setDataFn(valueData, memberData);
+				if (jMember == nullptr) {
+					sgeLogWarn(
+					    "[DESERIALIZATION] Missing %s::%s, deserialization will be skipped.\n",
+					    plan.typeDesc->name,
+					    mfd.name);
+					continue;
 				}
-			}
 
-			if (!succeeded) {
-				sgeLogError("[SERIALIZATION] Failed to deserialize %s::%s\n", typeDesc->name, mfd.name);
-				return false;
+				if (!deserializeMemberByPlan(member, valueData, jMember)) {
+					sgeLogError("[SERIALIZATION] Failed to deserialize %s::%s\n", plan.typeDesc->name, mfd.name);
+					return false;
+				}
 			}
+
+			return true;
 		}
+		default:
+			return false;
 	}
+}
 
-	return true;
+bool deserializeVariable(char* const valueData, const JsonValue* jValue, const TypeDesc* const typeDesc)
+{
+	if (typeDesc == nullptr || jValue == nullptr || valueData == nullptr) {
+		return false;
+	}
+
+	return deserializeVariableByPlan(valueData, jValue, *getSerializationPlan(typeDesc));
 }
 
 JsonValue* serializeObject(const GameObject* object, JsonValueBuffer& jvb)
@@ -445,25 +410,25 @@ JsonValue* serializeObject(const GameObject* object, JsonValueBuffer& jvb)
 
 	// Write the type of the object.
 	// [TODO] Save the id in a prettier way maybe.
-	jObject->setMember("type", jvb(typeLib().find(object->getType())->name));
+	jObject->setMember("type", jvb(typeDesc->name));
 	jObject->setMember("id", jvb(object->getId().id));
 	static_assert(sizeof(ObjectId) == sizeof(int), "");
 
 	JsonValue* const jMembers = jObject->setMember("members", jvb(JID_MAP));
 
-	for (const MemberDesc& mfd : typeDesc->members) {
-		const char* const objBytes = (char*)object;
-		const char* const memberBytes = objBytes + mfd.byteOffset;
+	// The members are read directly, make sure that the transform isn't waiting on a moved parent to get resolved.
+	if (const Actor* const actor = dynamic_cast<const Actor*>(object)) {
+		actor->getTransform();
+	}
 
-		if (mfd.isSaveable()) {
-			JsonValue* const jMember = serializeVariable(typeLib().find(mfd.typeId), memberBytes, jvb);
+	for (const SerializationPlan::Member& member : getSerializationPlan(typeDesc)->members) {
+		JsonValue* const jMember = serializeMemberByPlan(member, (const char*)object, jvb);
 
-			if (jMember) {
-				jMembers->setMember(mfd.name, jMember);
-			}
-			else {
-				sgeAssert(false);
-			}
+		if (jMember) {
+			jMembers->setMember(member.memberDesc->name, jMember);
+		}
+		else {
+			sgeAssert(false);
 		}
 	}
 
@@ -487,6 +452,13 @@ std::string serializeObject(const GameObject* object)
 	return wss.serializedString;
 }
 
+/// Returns true if the member is Actor::m_logicTransform, which needs to be loaded with Actor::setTransform.
+static bool isActorLogicTransform(const SerializationPlan::Member& member)
+{
+	// Check the kind first, MemberDesc::is() needs to search the type library.
+	return member.plan->kind == serializedKind_transf3d && member.memberDesc->is(&Actor::m_logicTransform);
+}
+
 GameObject* deserializeObject(
     GameWorld* const world, const JsonValue* const jObject, const bool shouldGenerateNewId, ObjectId* outOriginalId)
 {
@@ -528,12 +500,8 @@ GameObject* deserializeObject(
 	// Load the members
 	const JsonValue* const jMembers = jObject->getMember("members");
 
-	for (int iMember = 0; iMember < actorTypeDesc->members.size(); ++iMember) {
-		const MemberDesc& mfd = actorTypeDesc->members[iMember];
-
-		if (mfd.isSaveable() == false) {
-			continue;
-		}
+	for (const SerializationPlan::Member& member : getSerializationPlan(actorTypeDesc)->members) {
+		const MemberDesc& mfd = *member.memberDesc;
 
 		if (shouldGenerateNewId) {
 			if (mfd.flags & MFF_PrefabDontCopy) {
@@ -545,28 +513,15 @@ GameObject* deserializeObject(
 
 		if (jMember != nullptr) {
 			bool succeeded = false;
-			bool const isLogicTransform = mfd.is(&Actor::m_logicTransform);
 
-			if (isLogicTransform) {
+			if (isActorLogicTransform(member)) {
 				transf3d logicTransform;
-				succeeded = deserializeVariable((char*)&logicTransform, jMember, typeLib().find(mfd.typeId));
+				succeeded = deserializeVariableByPlan((char*)&logicTransform, jMember, *member.plan);
 				Actor* actor = object->getActor();
 				if_checked(actor) { actor->setTransform(logicTransform); }
 			}
-			else if (mfd.byteOffset >= 0) {
-				char* const memberData = (char*)(object) + mfd.byteOffset;
-				succeeded = deserializeVariable(memberData, jMember, typeLib().find(mfd.typeId));
-			}
-			else if (mfd.setDataFn != nullptr) {
-				const TypeDesc* const memberTypeDesc = typeLib().find(mfd.typeId);
-
-				if (memberTypeDesc) {
-					char* const memberData = (char*)alloca(mfd.sizeBytes);
-					memberTypeDesc->constructorFn(memberData);
-
-					succeeded = deserializeVariable(memberData, jMember, memberTypeDesc);
-					mfd.setDataFn(object, memberData);
-				}
+			else {
+				succeeded = deserializeMemberByPlan(member, (char*)object, jMember);
 			}
 
 			if (!succeeded) {
@@ -590,8 +545,7 @@ GameObject* deserializeObjectFromJson(
     GameWorld* const world, const std::string& json, const bool shouldGenerateNewId, ObjectId* outOriginalId)
 {
 	JsonParser parser;
-	ReadCStringStream crs(json.c_str());
-	if (!parser.parse(&crs)) {
+	if (!parser.parse(json.c_str(), json.size())) {
 		return nullptr;
 	}
 
@@ -668,23 +622,131 @@ std::string serializeGameWorld(const GameWorld* world)
 	return std::move(ss.serializedString);
 }
 
-bool loadGameWorldFromStream(GameWorld* world, IReadStream* stream)
+/// Starts loading asynchronously the specified asset if it is an existing file with a known asset extension.
+static void queueAsyncLoadForLevelAsset(const char* const assetPath, AssetLibrary& assetLib)
 {
-	if (!world || !stream) {
-		return false;
+	if (!isStringEmpty(assetPath) &&
+	    assetIface_guessFromExtension(extractFileExtension(assetPath).c_str(), false) != assetIface_unknown) {
+		std::error_code fileCheckError;
+		if (std::filesystem::is_regular_file(assetPath, fileCheckError)) {
+			assetLib.getAssetFromFileAsync(assetPath);
+		}
+	}
+}
+
+/// Starts loading asynchronously the assets referenced by the specified json value.
+/// The value is walked with the serialization plan of its type, so only the strings stored in asset members are
+/// concidered, other strings that happen to look like a path to a file are left alone.
+static void queueAsyncLoadsForLevelAssetsByPlan(
+    const JsonValue* const jValue, const SerializationPlan& plan, AssetLibrary& assetLib)
+{
+	if (jValue == nullptr) {
+		return;
 	}
 
+	switch (plan.kind) {
+		case serializedKind_assetPtr:
+		case serializedKind_assetIfaceMaterial:
+		case serializedKind_assetIfaceModel3D:
+		case serializedKind_assetIfaceTexture2D:
+			if (jValue->isString()) {
+				queueAsyncLoadForLevelAsset(jValue->GetString(), assetLib);
+			}
+			break;
+		case serializedKind_stdVector:
+			for (size_t t = 0; t < jValue->arrSize(); ++t) {
+				queueAsyncLoadsForLevelAssetsByPlan(jValue->arrAt(int(t)), *plan.elementPlan, assetLib);
+			}
+			break;
+		case serializedKind_stdMap:
+			for (size_t t = 0; t < jValue->arrSize(); ++t) {
+				const JsonValue* const jPair = jValue->arrAt(int(t));
+				queueAsyncLoadsForLevelAssetsByPlan(jPair->getMember("key"), *plan.elementPlan, assetLib);
+				queueAsyncLoadsForLevelAssetsByPlan(jPair->getMember("value"), *plan.mapValuePlan, assetLib);
+			}
+			break;
+		case serializedKind_struct:
+			if (jValue->jid == JID_MAP) {
+				for (const SerializationPlan::Member& member : plan.members) {
+					const JsonValue* const jMember = jValue->getMember(member.memberDesc->name);
+					queueAsyncLoadsForLevelAssetsByPlan(jMember, *member.plan, assetLib);
+				}
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+/// Starts loading asynchronously every asset referenced by the actors of the specified level json.
+static void queueAsyncLoadsForLevelAssets(const JsonValue* const jActors, AssetLibrary& assetLib)
+{
+	for (int t = 0; t < jActors->arrSize(); ++t) {
+		const JsonValue* const jActor = jActors->arrAt(t);
+		const JsonValue* const jType = jActor->getMember("type");
+		const TypeDesc* const actorTypeDesc = jType ? typeLib().findByName(jType->GetString()) : nullptr;
+		if (actorTypeDesc == nullptr) {
+			continue;
+		}
+
+		const JsonValue* const jMembers = jActor->getMember("members");
+		if (jMembers == nullptr) {
+			continue;
+		}
+
+		for (const SerializationPlan::Member& member : getSerializationPlan(actorTypeDesc)->members) {
+			queueAsyncLoadsForLevelAssetsByPlan(jMembers->getMember(member.memberDesc->name), *member.plan, assetLib);
+		}
+	}
+}
+
+/// Prepares the world for loading a level in it.
+static void beginLoadingGameWorld(GameWorld* world)
+{
 	world->clear();
 	world->create();
 
 	if (world->inspector) {
 		world->inspector->m_disableAutoStepping = true;
 	}
+}
 
-	JsonParser jsonParser;
-	jsonParser.parse(stream);
+/// Set each trasnform of the newly created actors again in order to enforce it to the physics.
+/// This is a bit hacky IMHO.
+static void reapplyTransformsOfLoadedActors(GameWorld* world)
+{
+	for (int t = 0; t < world->objectsAwaitingCreation.size(); ++t) {
+		Actor* actor = dynamic_cast<Actor*>(world->objectsAwaitingCreation[t]);
+		if (actor) {
+			actor->setTransform(actor->getTransform());
+		}
+	}
+}
+
+/// Called when all game objects in the level have been created.
+/// @param [in] loadStartTime the time when the loading has started, used for logging.
+/// @param [in] formatName the format of the loaded level, used for logging.
+static void finishLoadingGameWorld(
+    GameWorld* world, const double loadStartTime, bool preloadAssetsAsync, const char* const formatName)
+{
+	world->physicsWorld.setGravity(world->m_defaultGravity);
+	world->update(GameUpdateSets(0.f, true, InputState()));
+	world->onWorldLoaded.invokeEvent();
+
+	const double loadEndTime = Timer::now_seconds();
+	sgeLogInfo(
+	    "Level loaded from %s in %f seconds (%s asset loading).\n",
+	    formatName,
+	    loadEndTime - loadStartTime,
+	    preloadAssetsAsync ? "parallel" : "serial");
+}
 
-	const JsonValue* const jWorld = jsonParser.getRoot();
+/// Loads the world from the json parsed by the loadGameWorldFrom* functions.
+/// @param [in] loadStartTime the time when the loading has started, used for logging.
+static bool loadGameWorldFromJson(
+    GameWorld* world, const JsonValue* const jWorld, const double loadStartTime, bool preloadAssetsAsync)
+{
+	beginLoadingGameWorld(world);
 
 	if (!jWorld) {
 		return false;
@@ -745,19 +807,20 @@ bool loadGameWorldFromStream(GameWorld* world, IReadStream* stream)
 
 	// Load the playing objects.
 	const JsonValue* const jActors = jWorld->getMember("actors");
+
+	// Decode all assets in parallel, so the objects find them already loaded.
+	if (preloadAssetsAsync && jActors) {
+		AssetLibrary* const assetLib = getCore()->getAssetLib();
+		queueAsyncLoadsForLevelAssets(jActors, *assetLib);
+		assetLib->waitForAsyncLoading();
+	}
+
 	for (int t = 0; t < jActors->arrSize(); ++t) {
 		const JsonValue* const jActor = jActors->arrAt(t);
 		deserializeObject(world, jActor, false, nullptr);
 	}
 
-	// Set each trasnform again in order to enforce it to the physics.
-	// This is a bit hacky IMHO.
-	for (int t = 0; t < world->objectsAwaitingCreation.size(); ++t) {
-		Actor* actor = dynamic_cast<Actor*>(world->objectsAwaitingCreation[t]);
-		if (actor) {
-			actor->setTransform(actor->getTransform());
-		}
-	}
+	reapplyTransformsOfLoadedActors(world);
 
 	// Restore the hierarchial relationships between actors.
 	const JsonValue* const jHierarchy = jWorld->getMember("hierarchy");
@@ -775,39 +838,1119 @@ bool loadGameWorldFromStream(GameWorld* world, IReadStream* stream)
 		}
 	}
 
-	// Save the filename that we are working with.
-	world->physicsWorld.setGravity(world->m_defaultGravity);
-	world->update(GameUpdateSets(0.f, true, InputState()));
-	world->onWorldLoaded.invokeEvent();
+	finishLoadingGameWorld(world, loadStartTime, preloadAssetsAsync, "json");
 
 	return true;
 }
 
-bool loadGameWorldFromString(GameWorld* world, const char* const levelJson)
-{
-	ReadCStringStream rs(levelJson);
-	return loadGameWorldFromStream(world, &rs);
-}
+//----------------------------------------------------------------------------------------
+// Binary levels
+//----------------------------------------------------------------------------------------
+// The binary format stores the same data as the json, without any names or separators:
+//   - "SGEB", the version of the format and what is stored (a whole world or a single game object).
+//   - A table of all the types used in the file: their names, SerializedKind and depending on the kind
+//     the element type (std::vector), the key and value types (std::map) or the members as
+//     (name, type index) pairs (structs and transf3d).
+//   - The paths of all referenced assets, so they could be loaded in parallel before creating the objects.
+//   - The contents, the values are written one after another in the order described by the types table.
+// When loading, the types table gets matched against the current types once, so values of removed or changed members
+// are skipped and new members keep their default values, just like with the json.
+// Numbers are stored as they are in memory (little-endian), the counts and the lengths as LEB128 varints.
+namespace {
+	const char kBinaryLevelMagic[4] = {'S', 'G', 'E', 'B'};
+	const uint64_t kBinaryLevelVersion = 1;
+
+	/// The maximum nesting of values, protects from stack overflows when reading broken files.
+	const int kBinaryLevelMaxDepth = 64;
+
+	enum BinaryLevelContent : uint64_t {
+		binaryLevelContent_world = 0,
+		binaryLevelContent_object = 1,
+	};
 
-bool loadGameWorldFromFile(GameWorld* world, const char* const filename)
-{
-	if (!filename || filename[0] == '\0') {
-		return false;
+	static_assert(sizeof(int) == 4 && sizeof(unsigned) == 4 && sizeof(float) == 4, "");
+	static_assert(sizeof(ObjectId) == sizeof(int), "");
+
+	/// Returns the number of bytes used to store a value of a primitive type, 0 for the other kinds.
+	size_t getSerializedKindPrimitiveSize(const SerializedKind kind)
+	{
+		switch (kind) {
+			case serializedKind_int:
+			case serializedKind_unsigned:
+			case serializedKind_float:
+				return 4;
+			case serializedKind_char:
+			case serializedKind_bool:
+				return 1;
+			default:
+				return 0;
+		}
 	}
 
-	if (world->inspector) {
-		world->inspector->m_disableAutoStepping = true;
+	/// Returns true if a std::vector with elements described by @elementPlan could be copied as a single block.
+	bool canCopyElementsAsBlock(const SerializationPlan& elementPlan)
+	{
+		const size_t primitiveSize = getSerializedKindPrimitiveSize(elementPlan.kind);
+		return elementPlan.kind != serializedKind_bool && primitiveSize != 0 &&
+		       size_t(elementPlan.typeDesc->sizeBytes) == primitiveSize;
 	}
 
-	// Load and parse the json.
-	FileReadStream frs;
-	if (!frs.open(filename)) {
+	void writeBinaryBytes(std::vector<char>& out, const void* const bytes, const size_t numBytes)
+	{
+		out.insert(out.end(), (const char*)bytes, (const char*)bytes + numBytes);
+	}
+
+	void writeBinaryVarUint(std::vector<char>& out, uint64_t value)
+	{
+		while (value >= 0x80) {
+			out.push_back(char((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		out.push_back(char(value));
+	}
+
+	void writeBinaryString(std::vector<char>& out, const char* const str, const size_t length)
+	{
+		writeBinaryVarUint(out, length);
+		writeBinaryBytes(out, str, length);
+	}
+
+	/// Calls @fn(const char* name, void* data, TypeId typeId) for the state of the world that gets saved
+	/// together with the game objects. The names are the same as the ones used in the json.
+	template <typename TFn>
+	void forEachSavedWorldSetting(GameWorld& world, TFn&& fn)
+	{
+		fn("nextNameIndex", &world.m_nextNameIndex, sgeTypeId(decltype(world.m_nextNameIndex)));
+		fn("nextActorId", &world.m_nextObjectId, sgeTypeId(decltype(world.m_nextObjectId)));
+		fn("cameraProvider", &world.m_cameraPovider, sgeTypeId(decltype(world.m_cameraPovider)));
+		fn("ambientLightColor", &world.m_ambientLight, sgeTypeId(decltype(world.m_ambientLight)));
+		fn("ambientLightIntensity", &world.m_ambientLightIntensity, sgeTypeId(decltype(world.m_ambientLightIntensity)));
+		fn("ambientLightFakeDetailAmount",
+		   &world.m_ambientLightFakeDetailAmount,
+		   sgeTypeId(decltype(world.m_ambientLightFakeDetailAmount)));
+		fn("gridShouldDraw", &world.gridShouldDraw, sgeTypeId(decltype(world.gridShouldDraw)));
+		fn("gridNumSegments", &world.gridNumSegments, sgeTypeId(decltype(world.gridNumSegments)));
+		fn("gridSegmentsSpacing", &world.gridSegmentsSpacing, sgeTypeId(decltype(world.gridSegmentsSpacing)));
+		fn("defaultGravity", &world.m_defaultGravity, sgeTypeId(decltype(world.m_defaultGravity)));
+		fn("physicsSimNumSubSteps", &world.m_physicsSimNumSubSteps, sgeTypeId(decltype(world.m_physicsSimNumSubSteps)));
+		fn("worldScripts", &world.m_scriptObjects, sgeTypeId(decltype(world.m_scriptObjects)));
+	}
+
+	/// Writes values in the binary format, collecting the types and the assets that they use.
+	struct BinaryLevelWriter {
+		/// Returns the index of the type in the types table, adding the type (and the types it uses) if needed.
+		uint64_t getTypeIndex(const SerializationPlan* const plan)
+		{
+			auto itr = typeIndices.find(plan);
+			if (itr != typeIndices.end()) {
+				return itr->second;
+			}
+
+			const uint64_t typeIndex = types.size();
+			typeIndices[plan] = typeIndex;
+			types.push_back(plan);
+
+			if (plan->elementPlan) {
+				getTypeIndex(plan->elementPlan);
+			}
+			if (plan->mapValuePlan) {
+				getTypeIndex(plan->mapValuePlan);
+			}
+			for (const SerializationPlan::Member& member : plan->members) {
+				getTypeIndex(member.plan);
+			}
+
+			return typeIndex;
+		}
+
+		void writeAssetPath(const std::string& assetPath)
+		{
+			writeBinaryString(contents, assetPath.c_str(), assetPath.size());
+			if (assetPath.empty() == false && assetPathsSet.insert(assetPath).second) {
+				assetPaths.push_back(assetPath);
+			}
+		}
+
+		void writeMember(const SerializationPlan::Member& member, const char* const structData)
+		{
+			const MemberDesc& mfd = *member.memberDesc;
+			if (mfd.byteOffset >= 0) {
+				writeValue(*member.plan, structData + mfd.byteOffset);
+				return;
+			}
+
+			// The member is accessed with a getter.
+			const TypeDesc* const memberTypeDesc = member.plan->typeDesc;
+			char* const memberData = (char*)alloca(mfd.sizeBytes);
+			memberTypeDesc->constructorFn(memberData);
+			mfd.getDataFn((void*)structData, memberData);
+			writeValue(*member.plan, memberData);
+			memberTypeDesc->destructorFn(memberData);
+		}
+
+		void writeValue(const SerializationPlan& plan, const char* const data)
+		{
+			switch (plan.kind) {
+				case serializedKind_int:
+				case serializedKind_unsigned:
+				case serializedKind_float:
+				case serializedKind_char:
+					writeBinaryBytes(contents, data, getSerializedKindPrimitiveSize(plan.kind));
+					break;
+				case serializedKind_bool:
+					contents.push_back(*(const bool*)data ? 1 : 0);
+					break;
+				case serializedKind_string: {
+					const std::string& str = *(const std::string*)data;
+					writeBinaryString(contents, str.c_str(), str.size());
+				} break;
+				case serializedKind_transf3d: {
+					// See [TRANSF3D_GAME_SERIALIZATION]. A mask tells which of the members are stored.
+					sgeAssert(plan.members.size() <= 8);
+					unsigned char storedMembersMask = 0;
+					for (size_t t = 0; t < plan.members.size(); ++t) {
+						if (isTransformMemberDefault(plan.members[t], data) == false) {
+							storedMembersMask |= 1 << t;
+						}
+					}
+
+					contents.push_back(char(storedMembersMask));
+					for (size_t t = 0; t < plan.members.size(); ++t) {
+						if (storedMembersMask & (1 << t)) {
+							writeMember(plan.members[t], data);
+						}
+					}
+				} break;
+				case serializedKind_assetPtr: {
+					const AssetPtr& asset = *(const AssetPtr*)data;
+					writeAssetPath(asset ? asset->getPath() : std::string());
+				} break;
+				case serializedKind_assetIfaceMaterial:
+					writeAssetPath(getAssetInterfacePath(*(const std::shared_ptr<AssetIface_Material>*)data));
+					break;
+				case serializedKind_assetIfaceModel3D:
+					writeAssetPath(getAssetInterfacePath(*(const std::shared_ptr<AssetIface_Model3D>*)data));
+					break;
+				case serializedKind_assetIfaceTexture2D:
+					writeAssetPath(getAssetInterfacePath(*(const std::shared_ptr<AssetIface_Texture2D>*)data));
+					break;
+				case serializedKind_stdVector: {
+					const TypeDesc* const typeDesc = plan.typeDesc;
+					const size_t numElements = typeDesc->stdVectorSize(data);
+					writeBinaryVarUint(contents, numElements);
+
+					if (numElements > 0 && canCopyElementsAsBlock(*plan.elementPlan)) {
+						// The elements are stored as they are in memory, copy all of them at once.
+						writeBinaryBytes(
+						    contents,
+						    typeDesc->stdVectorGetElementConst(data, 0),
+						    numElements * getSerializedKindPrimitiveSize(plan.elementPlan->kind));
+					}
+					else {
+						for (size_t t = 0; t < numElements; ++t) {
+							writeValue(*plan.elementPlan, (const char*)typeDesc->stdVectorGetElementConst(data, t));
+						}
+					}
+				} break;
+				case serializedKind_stdMap: {
+					const TypeDesc* const typeDesc = plan.typeDesc;
+					const TypeDesc* const keyTd = plan.elementPlan->typeDesc;
+					const TypeDesc* const valueTd = plan.mapValuePlan->typeDesc;
+
+					const size_t mapSize = typeDesc->stdMapSize((void*)data);
+					writeBinaryVarUint(contents, mapSize);
+
+					void* const tempKey = keyTd->newFn();
+					void* const tempValue = valueTd->newFn();
+					for (size_t t = 0; t < mapSize; ++t) {
+						if (t != 0) {
+							// Reset the temporaries, the last ones are destroyed by deleteFn.
+							keyTd->destructorFn(tempKey);
+							valueTd->destructorFn(tempValue);
+							keyTd->constructorFn(tempKey);
+							valueTd->constructorFn(tempValue);
+						}
+
+						typeDesc->stdMapGetNthPair((void*)data, t, tempKey, tempValue);
+						writeValue(*plan.elementPlan, (const char*)tempKey);
+						writeValue(*plan.mapValuePlan, (const char*)tempValue);
+					}
+					keyTd->deleteFn(tempKey);
+					valueTd->deleteFn(tempValue);
+				} break;
+				case serializedKind_struct: {
+					for (const SerializationPlan::Member& member : plan.members) {
+						writeMember(member, data);
+					}
+				} break;
+				default: {
+					sgeLogError("[SERIALIZATION] Unknown type type %s\n", plan.typeDesc->name);
+					sgeAssert(false);
+				} break;
+			}
+		}
+
+		bool writeObject(const GameObject* const object)
+		{
+			const SerializationPlan* const plan = getSerializationPlan(typeLib().find(object->getType()));
+			if (plan == nullptr || plan->kind != serializedKind_struct) {
+				sgeLogError("GameObject of unregistered type!\n");
+				sgeAssert(false);
+				return false;
+			}
+
+			// The members are read directly, make sure that the transform isn't waiting on a moved parent to get
+			// resolved.
+			if (const Actor* const actor = dynamic_cast<const Actor*>(object)) {
+				actor->getTransform();
+			}
+
+			const int id = object->getId().id;
+			writeBinaryVarUint(contents, getTypeIndex(plan));
+			writeBinaryBytes(contents, &id, sizeof(id));
+			writeValue(*plan, (const char*)object);
+
+			return true;
+		}
+
+		/// Writes the header, the types table and the asset paths followed by the written contents to @outData.
+		void finish(const BinaryLevelContent content, std::vector<char>& outData) const
+		{
+			outData.clear();
+			outData.reserve(contents.size() + types.size() * 64 + assetPaths.size() * 64 + 64);
+
+			writeBinaryBytes(outData, kBinaryLevelMagic, sizeof(kBinaryLevelMagic));
+			writeBinaryVarUint(outData, kBinaryLevelVersion);
+			writeBinaryVarUint(outData, content);
+
+			writeBinaryVarUint(outData, types.size());
+			for (const SerializationPlan* const plan : types) {
+				writeBinaryString(outData, plan->typeDesc->name, strlen(plan->typeDesc->name));
+				outData.push_back(char(plan->kind));
+
+				if (plan->kind == serializedKind_stdVector) {
+					writeBinaryVarUint(outData, typeIndices.at(plan->elementPlan));
+				}
+				else if (plan->kind == serializedKind_stdMap) {
+					writeBinaryVarUint(outData, typeIndices.at(plan->elementPlan));
+					writeBinaryVarUint(outData, typeIndices.at(plan->mapValuePlan));
+				}
+				else if (plan->kind == serializedKind_struct || plan->kind == serializedKind_transf3d) {
+					writeBinaryVarUint(outData, plan->members.size());
+					for (const SerializationPlan::Member& member : plan->members) {
+						writeBinaryString(outData, member.memberDesc->name, strlen(member.memberDesc->name));
+						writeBinaryVarUint(outData, typeIndices.at(member.plan));
+					}
+				}
+			}
+
+			writeBinaryVarUint(outData, assetPaths.size());
+			for (const std::string& assetPath : assetPaths) {
+				writeBinaryString(outData, assetPath.c_str(), assetPath.size());
+			}
+
+			writeBinaryBytes(outData, contents.data(), contents.size());
+		}
+
+		std::vector<char> contents;
+
+		std::unordered_map<const SerializationPlan*, uint64_t> typeIndices;
+		std::vector<const SerializationPlan*> types;
+
+		std::unordered_set<std::string> assetPathsSet;
+		std::vector<std::string> assetPaths;
+	};
+
+	/// A type as described in the types table of a binary file, matched against the current types.
+	struct BinaryFileType {
+		struct Member {
+			std::string name;
+			uint64_t fileTypeIndex = 0;
+			/// The current member that receives the stored value, nullptr if the value should be skipped.
+			const SerializationPlan::Member* target = nullptr;
+			/// True if the member is Actor::m_logicTransform, see isActorLogicTransform().
+			bool isActorLogicTransform = false;
+		};
+
+		std::string name;
+		SerializedKind kind = serializedKind_unknown;
+		uint64_t elementFileTypeIndex = 0;
+		uint64_t mapValueFileTypeIndex = 0;
+		std::vector<Member> members;
+
+		/// The current type with the same name and kind, nullptr if there isn't one.
+		const SerializationPlan* plan = nullptr;
+		/// For std::vector and std::map, true if the stored elements (keys and values) could be loaded.
+		bool areElementsCompatible = false;
+	};
+
+	/// Reads data written by BinaryLevelWriter.
+	struct BinaryLevelReader {
+		/// Reads the header, the types table and the asset paths. Returns false if the data isn't a valid binary
+		/// level of the specified content. @data must stay alive while the reader is used.
+		bool begin(const char* const data, const size_t sizeBytes, const BinaryLevelContent expectedContent)
+		{
+			pos = data;
+			end = data + sizeBytes;
+			failed = false;
+
+			if (sizeBytes < sizeof(kBinaryLevelMagic) || memcmp(data, kBinaryLevelMagic, sizeof(kBinaryLevelMagic))) {
+				return false;
+			}
+			pos += sizeof(kBinaryLevelMagic);
+
+			const uint64_t version = readVarUint();
+			if (version != kBinaryLevelVersion) {
+				sgeLogError("[DESERIALIZATION] Unsupported binary level version %d.\n", int(version));
+				return false;
+			}
+
+			if (readVarUint() != expectedContent) {
+				return false;
+			}
+
+			// The types table.
+			const uint64_t numTypes = readVarUint();
+			if (failed || numTypes > remainingBytes()) {
+				return false;
+			}
+
+			fileTypes.resize(size_t(numTypes));
+			for (BinaryFileType& fileType : fileTypes) {
+				fileType.name = readStdString();
+
+				unsigned char kind = 0;
+				readBytes(&kind, 1);
+				if (kind == serializedKind_unknown || kind >= serializedKind_count) {
+					return false;
+				}
+				fileType.kind = SerializedKind(kind);
+
+				if (fileType.kind == serializedKind_stdVector) {
+					fileType.elementFileTypeIndex = readVarUint();
+				}
+				else if (fileType.kind == serializedKind_stdMap) {
+					fileType.elementFileTypeIndex = readVarUint();
+					fileType.mapValueFileTypeIndex = readVarUint();
+				}
+				else if (fileType.kind == serializedKind_struct || fileType.kind == serializedKind_transf3d) {
+					const uint64_t numMembers = readVarUint();
+					const uint64_t maxMembers = fileType.kind == serializedKind_transf3d ? 8 : remainingBytes();
+					if (numMembers == 0 || numMembers > maxMembers) {
+						return false;
+					}
+
+					fileType.members.resize(size_t(numMembers));
+					for (BinaryFileType::Member& member : fileType.members) {
+						member.name = readStdString();
+						member.fileTypeIndex = readVarUint();
+						if (member.fileTypeIndex >= numTypes) {
+							return false;
+						}
+					}
+				}
+
+				if (failed || fileType.elementFileTypeIndex >= numTypes || fileType.mapValueFileTypeIndex >= numTypes) {
+					return false;
+				}
+			}
+
+			matchFileTypesToCurrentTypes();
+
+			// The referenced assets.
+			const uint64_t numAssetPaths = readVarUint();
+			if (failed || numAssetPaths > remainingBytes()) {
+				return false;
+			}
+
+			assetPaths.resize(size_t(numAssetPaths));
+			for (std::string& assetPath : assetPaths) {
+				assetPath = readStdString();
+			}
+
+			return !failed;
+		}
+
+		/// Resolves once what the loading of each stored type is going to do.
+		void matchFileTypesToCurrentTypes()
+		{
+			for (BinaryFileType& fileType : fileTypes) {
+				const SerializationPlan* const plan = getSerializationPlan(typeLib().findByName(fileType.name.c_str()));
+				if (plan != nullptr && plan->kind == fileType.kind) {
+					fileType.plan = plan;
+				}
+				else if (plan != nullptr) {
+					sgeLogWarn(
+					    "[DESERIALIZATION] The type %s has changed, its stored values will be skipped.\n",
+					    fileType.name.c_str());
+				}
+			}
+
+			for (BinaryFileType& fileType : fileTypes) {
+				if (fileType.plan == nullptr) {
+					continue;
+				}
+
+				if (fileType.kind == serializedKind_stdVector) {
+					fileType.areElementsCompatible =
+					    isCompatible(fileTypes[fileType.elementFileTypeIndex], fileType.plan->elementPlan);
+				}
+				else if (fileType.kind == serializedKind_stdMap) {
+					fileType.areElementsCompatible =
+					    isCompatible(fileTypes[fileType.elementFileTypeIndex], fileType.plan->elementPlan) &&
+					    isCompatible(fileTypes[fileType.mapValueFileTypeIndex], fileType.plan->mapValuePlan);
+				}
+
+				for (BinaryFileType::Member& member : fileType.members) {
+					for (const SerializationPlan::Member& planMember : fileType.plan->members) {
+						if (member.name != planMember.memberDesc->name) {
+							continue;
+						}
+
+						if (isCompatible(fileTypes[member.fileTypeIndex], planMember.plan)) {
+							member.target = &planMember;
+							member.isActorLogicTransform = isActorLogicTransform(planMember);
+						}
+						else {
+							sgeLogWarn(
+							    "[DESERIALIZATION] The type of %s::%s has changed, its values will be skipped.\n",
+							    fileType.name.c_str(),
+							    member.name.c_str());
+						}
+						break;
+					}
+				}
+			}
+		}
+
+		/// Returns true if values stored as @fileType could be loaded in values of the type described by @plan.
+		bool isCompatible(const BinaryFileType& fileType, const SerializationPlan* const plan) const
+		{
+			if (plan == nullptr || plan->kind != fileType.kind) {
+				return false;
+			}
+
+			// Containers and structs need to be the same type, the others just need to be stored in the same way
+			// (for example an enum with int as underlying type and an int).
+			const bool isContainerOrStruct = fileType.kind == serializedKind_stdVector ||
+			                                 fileType.kind == serializedKind_stdMap ||
+			                                 fileType.kind == serializedKind_struct;
+			return !isContainerOrStruct || fileType.plan == plan;
+		}
+
+		size_t remainingBytes() const { return size_t(end - pos); }
+
+		bool readBytes(void* const dest, const size_t numBytes)
+		{
+			if (failed || remainingBytes() < numBytes) {
+				failed = true;
+				return false;
+			}
+
+			memcpy(dest, pos, numBytes);
+			pos += numBytes;
+			return true;
+		}
+
+		bool skipBytes(const size_t numBytes)
+		{
+			if (failed || remainingBytes() < numBytes) {
+				failed = true;
+				return false;
+			}
+
+			pos += numBytes;
+			return true;
+		}
+
+		uint64_t readVarUint()
+		{
+			uint64_t value = 0;
+			for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+				const unsigned char byte = (unsigned char)(*pos++);
+				value |= uint64_t(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0) {
+					return value;
+				}
+			}
+
+			failed = true;
+			return 0;
+		}
+
+		/// Returns a pointer to the stored characters (not null terminated) or nullptr if the data is broken.
+		const char* readString(size_t& outLength)
+		{
+			outLength = size_t(readVarUint());
+			const char* const str = pos;
+			return skipBytes(outLength) ? str : nullptr;
+		}
+
+		std::string readStdString()
+		{
+			size_t length = 0;
+			const char* const str = readString(length);
+			return str ? std::string(str, length) : std::string();
+		}
+
+		/// Reads the value of a member stored as @member in the struct pointed by @structData.
+		bool readMember(const BinaryFileType::Member& member, char* const structData)
+		{
+			const BinaryFileType& memberFileType = fileTypes[member.fileTypeIndex];
+			if (member.target == nullptr) {
+				return skipValue(memberFileType);
+			}
+
+			const MemberDesc& mfd = *member.target->memberDesc;
+			if (mfd.byteOffset >= 0) {
+				return readValue(memberFileType, structData + mfd.byteOffset);
+			}
+
+			// Members that only have a getter cannot be loaded.
+			if (mfd.setDataFn == nullptr) {
+				return skipValue(memberFileType);
+			}
+
+			const TypeDesc* const memberTypeDesc = member.target->plan->typeDesc;
+			char* const memberData = (char*)alloca(mfd.sizeBytes);
+			memberTypeDesc->constructorFn(memberData);
+			readValue(memberFileType, memberData);
+			mfd.setDataFn(structData, memberData);
+			memberTypeDesc->destructorFn(memberData);
+
+			return !failed;
+		}
+
+		/// Reads a value stored as @fileType in @data. The type of @data must be compatible (see isCompatible()).
+		bool readValue(const BinaryFileType& fileType, char* const data)
+		{
+			if (failed || depth >= kBinaryLevelMaxDepth) {
+				failed = true;
+				return false;
+			}
+
+			depth++;
+			switch (fileType.kind) {
+				case serializedKind_int:
+				case serializedKind_unsigned:
+				case serializedKind_float:
+				case serializedKind_char:
+					readBytes(data, getSerializedKindPrimitiveSize(fileType.kind));
+					break;
+				case serializedKind_bool: {
+					char value = 0;
+					readBytes(&value, 1);
+					*(bool*)data = value != 0;
+				} break;
+				case serializedKind_string: {
+					size_t length = 0;
+					if (const char* const str = readString(length)) {
+						((std::string*)data)->assign(str, length);
+					}
+				} break;
+				case serializedKind_transf3d: {
+					unsigned char storedMembersMask = 0;
+					readBytes(&storedMembersMask, 1);
+					for (size_t t = 0; t < fileType.members.size(); ++t) {
+						if (storedMembersMask & (1 << t)) {
+							readMember(fileType.members[t], data);
+						}
+					}
+				} break;
+				case serializedKind_assetPtr: {
+					const std::string assetPath = readStdString();
+					if (assetPath.empty() == false) {
+						*(AssetPtr*)data = getCore()->getAssetLib()->getAssetFromFile(assetPath.c_str());
+					}
+				} break;
+				case serializedKind_assetIfaceMaterial:
+					loadAssetInterface(*(std::shared_ptr<AssetIface_Material>*)data, readStdString().c_str());
+					break;
+				case serializedKind_assetIfaceModel3D:
+					loadAssetInterface(*(std::shared_ptr<AssetIface_Model3D>*)data, readStdString().c_str());
+					break;
+				case serializedKind_assetIfaceTexture2D:
+					loadAssetInterface(*(std::shared_ptr<AssetIface_Texture2D>*)data, readStdString().c_str());
+					break;
+				case serializedKind_stdVector: {
+					const BinaryFileType& elementFileType = fileTypes[fileType.elementFileTypeIndex];
+					const uint64_t numElements = readVarUint();
+					// Every element takes at least a byte.
+					if (failed || numElements > remainingBytes()) {
+						failed = true;
+						break;
+					}
+
+					if (fileType.areElementsCompatible == false) {
+						for (uint64_t t = 0; t < numElements && !failed; ++t) {
+							skipValue(elementFileType);
+						}
+						break;
+					}
+
+					const TypeDesc* const typeDesc = fileType.plan->typeDesc;
+					typeDesc->stdVectorResize(data, size_t(numElements));
+					if (numElements > 0 && canCopyElementsAsBlock(*fileType.plan->elementPlan)) {
+						readBytes(
+						    typeDesc->stdVectorGetElement(data, 0),
+						    size_t(numElements) * getSerializedKindPrimitiveSize(elementFileType.kind));
+					}
+					else {
+						for (size_t t = 0; t < numElements && !failed; ++t) {
+							readValue(elementFileType, (char*)typeDesc->stdVectorGetElement(data, t));
+						}
+					}
+				} break;
+				case serializedKind_stdMap: {
+					const BinaryFileType& keyFileType = fileTypes[fileType.elementFileTypeIndex];
+					const BinaryFileType& valueFileType = fileTypes[fileType.mapValueFileTypeIndex];
+					const uint64_t numPairs = readVarUint();
+					if (failed || numPairs > remainingBytes()) {
+						failed = true;
+						break;
+					}
+
+					if (fileType.areElementsCompatible == false) {
+						for (uint64_t t = 0; t < numPairs && !failed; ++t) {
+							skipValue(keyFileType);
+							skipValue(valueFileType);
+						}
+						break;
+					}
+
+					const TypeDesc* const typeDesc = fileType.plan->typeDesc;
+					const TypeDesc* const keyTd = fileType.plan->elementPlan->typeDesc;
+					const TypeDesc* const valueTd = fileType.plan->mapValuePlan->typeDesc;
+
+					void* const tempKey = keyTd->newFn();
+					void* const tempValue = valueTd->newFn();
+					for (uint64_t t = 0; t < numPairs && !failed; ++t) {
+						if (t != 0) {
+							// Reset the temporaries, the last ones are destroyed by deleteFn.
+							keyTd->destructorFn(tempKey);
+							valueTd->destructorFn(tempValue);
+							keyTd->constructorFn(tempKey);
+							valueTd->constructorFn(tempValue);
+						}
+
+						readValue(keyFileType, (char*)tempKey);
+						readValue(valueFileType, (char*)tempValue);
+						typeDesc->stdMapInsert(data, tempKey, tempValue);
+					}
+					keyTd->deleteFn(tempKey);
+					valueTd->deleteFn(tempValue);
+				} break;
+				case serializedKind_struct: {
+					for (const BinaryFileType::Member& member : fileType.members) {
+						readMember(member, data);
+					}
+				} break;
+				default: {
+					failed = true;
+				} break;
+			}
+			depth--;
+
+			return !failed;
+		}
+
+		/// Skips a value stored as @fileType.
+		bool skipValue(const BinaryFileType& fileType)
+		{
+			if (failed || depth >= kBinaryLevelMaxDepth) {
+				failed = true;
+				return false;
+			}
+
+			depth++;
+			switch (fileType.kind) {
+				case serializedKind_int:
+				case serializedKind_unsigned:
+				case serializedKind_float:
+				case serializedKind_char:
+				case serializedKind_bool:
+					skipBytes(getSerializedKindPrimitiveSize(fileType.kind));
+					break;
+				case serializedKind_string:
+				case serializedKind_assetPtr:
+				case serializedKind_assetIfaceMaterial:
+				case serializedKind_assetIfaceModel3D:
+				case serializedKind_assetIfaceTexture2D: {
+					size_t length = 0;
+					readString(length);
+				} break;
+				case serializedKind_transf3d: {
+					unsigned char storedMembersMask = 0;
+					readBytes(&storedMembersMask, 1);
+					for (size_t t = 0; t < fileType.members.size(); ++t) {
+						if (storedMembersMask & (1 << t)) {
+							skipValue(fileTypes[fileType.members[t].fileTypeIndex]);
+						}
+					}
+				} break;
+				case serializedKind_stdVector: {
+					const BinaryFileType& elementFileType = fileTypes[fileType.elementFileTypeIndex];
+					const uint64_t numElements = readVarUint();
+					if (failed || numElements > remainingBytes()) {
+						failed = true;
+						break;
+					}
+
+					const size_t primitiveSize = getSerializedKindPrimitiveSize(elementFileType.kind);
+					if (primitiveSize != 0) {
+						skipBytes(size_t(numElements) * primitiveSize);
+					}
+					else {
+						for (uint64_t t = 0; t < numElements && !failed; ++t) {
+							skipValue(elementFileType);
+						}
+					}
+				} break;
+				case serializedKind_stdMap: {
+					const uint64_t numPairs = readVarUint();
+					if (failed || numPairs > remainingBytes()) {
+						failed = true;
+						break;
+					}
+
+					for (uint64_t t = 0; t < numPairs && !failed; ++t) {
+						skipValue(fileTypes[fileType.elementFileTypeIndex]);
+						skipValue(fileTypes[fileType.mapValueFileTypeIndex]);
+					}
+				} break;
+				case serializedKind_struct: {
+					for (const BinaryFileType::Member& member : fileType.members) {
+						skipValue(fileTypes[member.fileTypeIndex]);
+					}
+				} break;
+				default: {
+					failed = true;
+				} break;
+			}
+			depth--;
+
+			return !failed;
+		}
+
+		/// Reads a game object written by BinaryLevelWriter::writeObject and creates it in @world.
+		/// Objects of unknown types are skipped.
+		GameObject* readObject(GameWorld* const world, const bool shouldGenerateNewId, ObjectId* const outOriginalId)
+		{
+			const uint64_t fileTypeIndex = readVarUint();
+			int storedId = 0;
+			readBytes(&storedId, sizeof(storedId));
+			if (failed || fileTypeIndex >= fileTypes.size() || fileTypes[fileTypeIndex].kind != serializedKind_struct) {
+				failed = true;
+				return nullptr;
+			}
+
+			const BinaryFileType& objectFileType = fileTypes[fileTypeIndex];
+			ObjectId id(storedId);
+
+			if (outOriginalId != nullptr) {
+				*outOriginalId = id;
+			}
+
+			if (objectFileType.plan == nullptr) {
+				sgeLogError(
+				    "[DESERIALIZATION] Unknown game object type %s, the object is skipped.\n",
+				    objectFileType.name.c_str());
+				skipValue(objectFileType);
+				return nullptr;
+			}
+
+			if (shouldGenerateNewId) {
+				id = ObjectId();
+			}
+
+			// Create the game object itself.
+			GameObject* const object = world->allocObject(objectFileType.plan->typeDesc->typeId, id);
+			if (!object) {
+				sgeAssert(false);
+				skipValue(objectFileType);
+				return nullptr;
+			}
+
+			if (shouldGenerateNewId == false) {
+				sgeAssert(object->getId() == id);
+			}
+
+			// Load the members.
+			for (const BinaryFileType::Member& member : objectFileType.members) {
+				const bool isPrefabDontCopy =
+				    member.target != nullptr && (member.target->memberDesc->flags & MFF_PrefabDontCopy) != 0;
+				const bool shouldSkip = member.target == nullptr || (shouldGenerateNewId && isPrefabDontCopy);
+				if (shouldSkip) {
+					skipValue(fileTypes[member.fileTypeIndex]);
+				}
+				else if (member.isActorLogicTransform) {
+					transf3d logicTransform;
+					readValue(fileTypes[member.fileTypeIndex], (char*)&logicTransform);
+					Actor* actor = object->getActor();
+					if_checked(actor) { actor->setTransform(logicTransform); }
+				}
+				else {
+					readMember(member, (char*)object);
+				}
+			}
+
+			object->makeDirtyExternal();
+			object->onMemberChanged();
+
+			return object;
+		}
+
+		const char* pos = nullptr;
+		const char* end = nullptr;
+		bool failed = false;
+		int depth = 0;
+
+		std::vector<BinaryFileType> fileTypes;
+		std::vector<std::string> assetPaths;
+	};
+} // namespace
+
+bool isBinaryGameWorldData(const char* const data, const size_t sizeBytes)
+{
+	return data != nullptr && sizeBytes >= sizeof(kBinaryLevelMagic) &&
+	       memcmp(data, kBinaryLevelMagic, sizeof(kBinaryLevelMagic)) == 0;
+}
+
+void serializeGameWorldBinary(const GameWorld* world, std::vector<char>& outData)
+{
+	BinaryLevelWriter writer;
+	GameWorld& worldRef = const_cast<GameWorld&>(*world);
+
+	// The state of the world.
+	int numWorldSettings = 0;
+	forEachSavedWorldSetting(worldRef, [&](const char*, void*, TypeId) -> void { numWorldSettings++; });
+	writeBinaryVarUint(writer.contents, numWorldSettings);
+	forEachSavedWorldSetting(worldRef, [&](const char* const name, void* const data, const TypeId typeId) -> void {
+		const SerializationPlan* const plan = getSerializationPlan(typeLib().find(typeId));
+		writeBinaryString(writer.contents, name, strlen(name));
+		writeBinaryVarUint(writer.contents, writer.getTypeIndex(plan));
+		writer.writeValue(*plan, (const char*)data);
+	});
+
+	// The game objects.
+	std::vector<const GameObject*> objects;
+	world->iterateOverPlayingObjects(
+	    [&](const GameObject* object) -> bool {
+		    objects.push_back(object);
+		    return true;
+	    },
+	    true);
+
+	writeBinaryVarUint(writer.contents, objects.size());
+	for (const GameObject* const object : objects) {
+		[[maybe_unused]] const bool succeeded = writer.writeObject(object);
+		sgeAssert(succeeded);
+	}
+
+	// Hierarchical relationships. Like in the json m_parentOf is restored from this.
+	writeBinaryVarUint(writer.contents, world->m_childernOf.size());
+	for (const auto& itrParentToChildren : world->m_childernOf) {
+		writeBinaryBytes(writer.contents, &itrParentToChildren.first.id, sizeof(int));
+		writeBinaryVarUint(writer.contents, itrParentToChildren.second.size());
+		for (const ObjectId childId : itrParentToChildren.second) {
+			writeBinaryBytes(writer.contents, &childId.id, sizeof(int));
+		}
+	}
+
+	writer.finish(binaryLevelContent_world, outData);
+}
+
+std::vector<char> serializeGameWorldBinary(const GameWorld* world)
+{
+	std::vector<char> data;
+	serializeGameWorldBinary(world, data);
+	return data;
+}
+
+/// Loads the world from data written by serializeGameWorldBinary.
+/// @param [in] loadStartTime the time when the loading has started, used for logging.
+static bool loadGameWorldFromBinary(
+    GameWorld* world,
+    const char* const data,
+    const size_t sizeBytes,
+    const double loadStartTime,
+    bool preloadAssetsAsync)
+{
+	beginLoadingGameWorld(world);
+
+	BinaryLevelReader reader;
+	if (!reader.begin(data, sizeBytes, binaryLevelContent_world)) {
+		sgeLogError("[DESERIALIZATION] The binary level is broken or isn't a level.\n");
+		return false;
+	}
+
+	// Decode all assets in parallel, so the objects find them already loaded.
+	if (preloadAssetsAsync) {
+		AssetLibrary* const assetLib = getCore()->getAssetLib();
+		for (const std::string& assetPath : reader.assetPaths) {
+			queueAsyncLoadForLevelAsset(assetPath.c_str(), *assetLib);
+		}
+		assetLib->waitForAsyncLoading();
+	}
+
+	// The state of the world.
+	const uint64_t numWorldSettings = reader.readVarUint();
+	for (uint64_t iSetting = 0; iSetting < numWorldSettings && !reader.failed; ++iSetting) {
+		const std::string name = reader.readStdString();
+		const uint64_t fileTypeIndex = reader.readVarUint();
+		if (reader.failed || fileTypeIndex >= reader.fileTypes.size()) {
+			reader.failed = true;
+			break;
+		}
+
+		void* settingData = nullptr;
+		const SerializationPlan* settingPlan = nullptr;
+		forEachSavedWorldSetting(*world, [&](const char* const settingName, void* const data, const TypeId typeId) {
+			if (name == settingName) {
+				settingData = data;
+				settingPlan = getSerializationPlan(typeLib().find(typeId));
+			}
+		});
+
+		const BinaryFileType& settingFileType = reader.fileTypes[fileTypeIndex];
+		if (settingData != nullptr && reader.isCompatible(settingFileType, settingPlan)) {
+			reader.readValue(settingFileType, (char*)settingData);
+		}
+		else {
+			reader.skipValue(settingFileType);
+		}
+	}
+
+	// The game objects.
+	const uint64_t numObjects = reader.readVarUint();
+	for (uint64_t t = 0; t < numObjects && !reader.failed; ++t) {
+		reader.readObject(world, false, nullptr);
+	}
+
+	reapplyTransformsOfLoadedActors(world);
+
+	// Restore the hierarchial relationships between actors.
+	const uint64_t numParents = reader.readVarUint();
+	for (uint64_t iParent = 0; iParent < numParents && !reader.failed; ++iParent) {
+		ObjectId parentId;
+		reader.readBytes(&parentId.id, sizeof(int));
+		const uint64_t numChildren = reader.readVarUint();
+		if (reader.failed || numChildren > reader.remainingBytes()) {
+			reader.failed = true;
+			break;
+		}
+
+		auto& childList = world->m_childernOf[parentId];
+		for (uint64_t iChild = 0; iChild < numChildren; ++iChild) {
+			ObjectId childId;
+			if (!reader.readBytes(&childId.id, sizeof(int))) {
+				break;
+			}
+			childList.add(childId);
+			world->m_parentOf[childId] = parentId;
+		}
+	}
+
+	if (reader.failed) {
+		sgeLogError("[DESERIALIZATION] The binary level is broken, only a part of it got loaded.\n");
+	}
+
+	finishLoadingGameWorld(world, loadStartTime, preloadAssetsAsync, "binary");
+
+	return !reader.failed;
+}
+
+void serializeObjectBinary(const GameObject* object, std::vector<char>& outData)
+{
+	BinaryLevelWriter writer;
+	writer.writeObject(object);
+	writer.finish(binaryLevelContent_object, outData);
+}
+
+GameObject* deserializeObjectFromBinary(
+    GameWorld* const world,
+    const char* const data,
+    const size_t sizeBytes,
+    const bool shouldGenerateNewId,
+    ObjectId* outOriginalId)
+{
+	BinaryLevelReader reader;
+	if (!reader.begin(data, sizeBytes, binaryLevelContent_object)) {
+		return nullptr;
+	}
+
+	return reader.readObject(world, shouldGenerateNewId, outOriginalId);
+}
+
+bool loadGameWorldFromStream(GameWorld* world, IReadStream* stream, bool preloadAssetsAsync)
+{
+	if (!world || !stream) {
+		return false;
+	}
+
+	const double loadStartTime = Timer::now_seconds();
+
+	JsonParser jsonParser;
+	jsonParser.parse(stream);
+
+	return loadGameWorldFromJson(world, jsonParser.getRoot(), loadStartTime, preloadAssetsAsync);
+}
+
+bool loadGameWorldFromString(GameWorld* world, const char* const levelJson, bool preloadAssetsAsync)
+{
+	if (!world || !levelJson) {
+		return false;
+	}
+
+	return loadGameWorldFromMemory(world, levelJson, strlen(levelJson), preloadAssetsAsync);
+}
+
+bool loadGameWorldFromMemory(GameWorld* world, const char* const data, const size_t sizeBytes, bool preloadAssetsAsync)
+{
+	if (!world || !data) {
+		return false;
+	}
+
+	const double loadStartTime = Timer::now_seconds();
+
+	if (isBinaryGameWorldData(data, sizeBytes)) {
+		return loadGameWorldFromBinary(world, data, sizeBytes, loadStartTime, preloadAssetsAsync);
+	}
+
+	JsonParser jsonParser;
+	jsonParser.parse(data, sizeBytes);
+
+	return loadGameWorldFromJson(world, jsonParser.getRoot(), loadStartTime, preloadAssetsAsync);
+}
+
+bool loadGameWorldFromFile(GameWorld* world, const char* const filename, bool preloadAssetsAsync)
+{
+	if (!filename || filename[0] == '\0') {
+		return false;
+	}
+
+	if (world->inspector) {
+		world->inspector->m_disableAutoStepping = true;
+	}
+
+	const double loadStartTime = Timer::now_seconds();
+
+	// The file is memory mapped instead of being read through a stream.
+	MemoryMappedFile levelFile;
+	if (!levelFile.open(filename)) {
 		sgeLogError("Unable to open world file '%s'\n", filename);
 		sgeAssert(false);
 		return false;
 	}
 
-	return loadGameWorldFromStream(world, &frs);
+	if (isBinaryGameWorldData(levelFile.data(), levelFile.size())) {
+		return loadGameWorldFromBinary(world, levelFile.data(), levelFile.size(), loadStartTime, preloadAssetsAsync);
+	}
+
+	JsonParser jsonParser;
+	jsonParser.parse(levelFile.data(), levelFile.size());
+
+	return loadGameWorldFromJson(world, jsonParser.getRoot(), loadStartTime, preloadAssetsAsync);
 }
 
 } // namespace sge
@@ -2,6 +2,7 @@
 
 #include "sge_engine_api.h"
 #include <string>
+#include <vector>
 
 namespace sge {
 
@@ -18,9 +19,32 @@ struct TypeDesc;
 SGE_ENGINE_API JsonValue* serializeGameWorld(const GameWorld* world, JsonValueBuffer& jvb);
 SGE_ENGINE_API std::string serializeGameWorld(const GameWorld* world);
 
-SGE_ENGINE_API bool loadGameWorldFromStream(GameWorld* world, IReadStream* stream);
-SGE_ENGINE_API bool loadGameWorldFromString(GameWorld* world, const char* const levelJson);
-SGE_ENGINE_API bool loadGameWorldFromFile(GameWorld* world, const char* const filename);
+/// Loads the level described in @stream into @world. The total loading time gets logged.
+/// @param [in] preloadAssetsAsync if true, all assets referenced by the level are loaded in parallel
+///             (see AssetLibrary::getAssetFromFileAsync) before the game objects get created.
+///             Otherwise each asset is loaded on the calling thread when a game object needs it.
+///             Finding the referenced assets scans the whole level, so it is meant for opening levels, not for
+///             reloading the world that is already open (entering play mode, undo/redo).
+SGE_ENGINE_API bool loadGameWorldFromStream(GameWorld* world, IReadStream* stream, bool preloadAssetsAsync = false);
+SGE_ENGINE_API bool
+    loadGameWorldFromString(GameWorld* world, const char* const levelJson, bool preloadAssetsAsync = false);
+/// Loads the level stored in the specified file. Both json and binary levels (see serializeGameWorldBinary) are
+/// supported, the format is detected from the contents of the file.
+SGE_ENGINE_API bool
+    loadGameWorldFromFile(GameWorld* world, const char* const filename, bool preloadAssetsAsync = false);
+/// Loads the level stored in memory, either as json or in the binary format (see serializeGameWorldBinary).
+SGE_ENGINE_API bool loadGameWorldFromMemory(
+    GameWorld* world, const char* const data, const size_t sizeBytes, bool preloadAssetsAsync = false);
+
+/// Saves the world in a compact binary format. The contents are the same as in the json, but the names of the types
+/// and the members are stored only once in a table at the beginning of the data, the values follow without any names.
+/// Loading binary levels is several times faster than loading json, use it for shipping levels and for snapshots of
+/// the world that are going to be loaded right away (like entering the play mode).
+/// Binary levels could be loaded with loadGameWorldFromMemory and loadGameWorldFromFile.
+SGE_ENGINE_API void serializeGameWorldBinary(const GameWorld* world, std::vector<char>& outData);
+SGE_ENGINE_API std::vector<char> serializeGameWorldBinary(const GameWorld* world);
+/// Returns true if the data starts like the data written by serializeGameWorldBinary.
+SGE_ENGINE_API bool isBinaryGameWorldData(const char* const data, const size_t sizeBytes);
 
 SGE_ENGINE_API JsonValue* serializeObject(const GameObject* object, JsonValueBuffer& jvb);
 SGE_ENGINE_API std::string serializeObject(const GameObject* object);
@@ -37,6 +61,16 @@ SGE_ENGINE_API std::string serializeObject(const GameObject* object);
 SGE_ENGINE_API GameObject* deserializeObjectFromJson(
     GameWorld* const world, const std::string& json, const bool shouldGenerateNewId, ObjectId* outOriginalId);
 
+/// Saves the specified game object in the binary format (see serializeGameWorldBinary).
+SGE_ENGINE_API void serializeObjectBinary(const GameObject* object, std::vector<char>& outData);
+/// The same as deserializeObjectFromJson but for data written by serializeObjectBinary.
+SGE_ENGINE_API GameObject* deserializeObjectFromBinary(
+    GameWorld* const world,
+    const char* const data,
+    const size_t sizeBytes,
+    const bool shouldGenerateNewId,
+    ObjectId* outOriginalId);
+
 
 SGE_ENGINE_API JsonValue*
     serializeVariable(const TypeDesc* const typeDesc, const char* const data, JsonValueBuffer& jvb);
@@ -9,14 +9,21 @@
 #include "sge_engine/InspectorCmds.h"
 #include "sge_engine/physics/RigidBody.h"
 #include "sge_engine/traits/TraitCamera.h"
+#include "sge_engine/traits/TraitRigidBody.h"
 #include "sge_utils/text/format.h"
 #include "sge_utils/time/Timer.h"
 
+#include <algorithm>
 #include <functional>
 #include <thread>
 
 namespace sge {
 
+namespace {
+	/// Below that many contact manifolds gathering them on a single thread is faster than waking up the workers.
+	constexpr int kMinManifoldsForParallelGather = 512;
+} // namespace
+
 ObjectId GameWorld::getNewId()
 {
 	ObjectId id(m_nextObjectId);
@@ -250,7 +257,7 @@ void GameWorld::objectDelete(const ObjectId& id)
 
 void GameWorld::create()
 {
-	physicsWorld.create();
+	physicsWorld.create(m_numPhysicsWorkers);
 	physicsWorld.dynamicsWorld->setGravity(toBullet(m_defaultGravity));
 	physicsWorld.dynamicsWorld->setDebugDrawer(&m_physicsDebugDraw);
 }
@@ -274,6 +281,8 @@ void GameWorld::clear()
 	// }
 
 	playingObjects.clear();
+	m_typesToUpdate.clear();
+	m_isTypesToUpdateDirty = true;
 
 	/*for (GameObject* const object : objectsAwaitingCreation) {
 	    delete object;
@@ -290,9 +299,18 @@ void GameWorld::clear()
 
 	m_childernOf.clear();
 	m_parentOf.clear();
+	m_transformNodes.clear();
+	m_isTransformNodesDirty = true;
+	m_hasDirtyTransforms = false;
+
+	m_spatialIndex.clear();
+	m_actorsWithoutBBox.clear();
+	m_spatialIndexDirtyActors.clear();
 
 	physicsWorld.destroy();
-	m_physicsManifoldList.clear();
+	for (auto& manifoldList : m_physicsManifoldList) {
+		manifoldList.clear();
+	}
 
 	onWorldLoaded.discardAllCallbacks();
 
@@ -325,11 +343,18 @@ void GameWorld::update(const GameUpdateSets& updateSets)
 		std::this_thread::sleep_for(std::chrono::milliseconds(debug.forceSleepMs));
 	}
 
+	m_numSkippedAnimationEvaluationsLastUpdate = m_numSkippedAnimationEvaluations.exchange(0);
+
 	// Add the objects that were created during the last update to the list of playing objects.
 	for (int t = 0; t < objectsAwaitingCreation.size(); ++t) {
 		GameObject* const object = objectsAwaitingCreation[t];
 		playingObjects[object->getType()].emplace_back(object);
 		object->onPlayStateChanged(true);
+		m_isTypesToUpdateDirty = true;
+
+		if (Actor* const actor = object->getActor()) {
+			addActorToSpatialIndex(actor);
+		}
 	}
 	objectsAwaitingCreation.clear();
 
@@ -355,6 +380,7 @@ void GameWorld::update(const GameUpdateSets& updateSets)
 					// Unparent the object, so it's current parent no longer thinks that the deleted object
 					// is present.
 					if (objectToKill->isActor()) {
+						removeActorFromSpatialIndex(objectToKill->getActor());
 						setParentOf(objectToKill->getId(), ObjectId());
 
 						// Unparent all childrend objects.
@@ -375,6 +401,7 @@ void GameWorld::update(const GameUpdateSets& updateSets)
 
 					// Deallocate the object, call its destructor.
 					gameObjectsOfType.erase(gameObjectsOfType.begin() + t);
+					m_isTypesToUpdateDirty = true;
 					auto objectMemoryHandleItr = gameObjectIdToHandle.find(objectToKill->getId());
 					if (objectMemoryHandleItr != gameObjectIdToHandle.end()) {
 						gameObjectsArena.deleteElement(objectMemoryHandleItr->second);
@@ -415,41 +442,121 @@ void GameWorld::update(const GameUpdateSets& updateSets)
 		// Get all collision manifolds and store them in a data structure
 		// so it would be easier for the gameplay logic to find collision between actors.
 		// Keep in mind that not all rigid bodies represent an actor.
-		m_physicsManifoldList.clear();
+		// The manifolds are first bucketed by the shard of their rigid bodies in a single pass, then each job fills
+		// a range of shards, so with a lot of contacts the expensive part is split between the update workers.
+		const btDispatcher* const dispatcher = physicsWorld.dynamicsWorld->getDispatcher();
+		const int numManifolds = dispatcher->getNumManifolds();
+
+		for (auto& manifoldsOfShard : m_physicsManifoldsByShard) {
+			manifoldsOfShard.clear();
+		}
 
-		btDynamicsWorld* const dworld = physicsWorld.dynamicsWorld.get();
-		int const numManifolds = dworld->getDispatcher()->getNumManifolds();
 		for (int t = 0; t < numManifolds; ++t) {
 			// Obtain the two rigid bodies that participate in the manifold and add them to
 			// our list of manifolds for both rigid bodies.
-			const btPersistentManifold* const manifold = dworld->getDispatcher()->getManifoldByIndexInternal(t);
+			const btPersistentManifold* const manifold = dispatcher->getManifoldByIndexInternal(t);
 			if (manifold->getNumContacts() != 0) {
 				if (const RigidBody* const rb0 = fromBullet(manifold->getBody0())) {
-					m_physicsManifoldList[rb0].emplace_back(manifold);
+					m_physicsManifoldsByShard[getPhysicsManifoldListShard(rb0)].emplace_back(rb0, manifold);
 				}
 				if (const RigidBody* const rb1 = fromBullet(manifold->getBody1())) {
-					m_physicsManifoldList[rb1].emplace_back(manifold);
+					m_physicsManifoldsByShard[getPhysicsManifoldListShard(rb1)].emplace_back(rb1, manifold);
+				}
+			}
+		}
+
+		const auto gatherManifoldsForShards = [this](int beginShard, int endShard) -> void {
+			for (int iShard = beginShard; iShard < endShard; ++iShard) {
+				m_physicsManifoldList[iShard].clear();
+				for (const auto& rbAndManifold : m_physicsManifoldsByShard[iShard]) {
+					m_physicsManifoldList[iShard][rbAndManifold.first].emplace_back(rbAndManifold.second);
 				}
 			}
+		};
+
+		ThreadPool* const threadPool = numManifolds >= kMinManifoldsForParallelGather ? getUpdateThreadPool() : nullptr;
+		if (threadPool != nullptr) {
+			threadPool->parallelFor(kNumPhysicsManifoldListShards, 1, gatherManifoldsForShards);
+		}
+		else {
+			gatherManifoldsForShards(0, kNumPhysicsManifoldListShards);
 		}
 	}
 
-	// Call GameObject::update for all playing game objects.
-	for (auto& itrActorByType : playingObjects) {
-		// TODO: it would be neat to skip this for all types that did not override GameObject::update().
-		// The link below might be useful:
-		// https://stackoverflow.com/questions/4741271/ways-to-detect-whether-a-c-virtual-function-has-been-redefined-in-a-derived-cl
-		for (int t = 0; t < itrActorByType.second.size(); ++t) {
-			GameObject* const object = itrActorByType.second[t];
+	// Call GameObject::update for all playing game objects, types that do not override it are skipped.
+	// The objects of types marked with TF_ParallelUpdate are split into chunks and updated by the worker threads,
+	// all other types are updated serially. In both cases a type is fully updated before moving to the next one.
+	if (m_isTypesToUpdateDirty) {
+		rebuildTypesToUpdate();
+	}
+
+	for (const TypeToUpdate& typeToUpdate : m_typesToUpdate) {
+		const std::vector<GameObject*>& objectsOfType = *typeToUpdate.objects;
+
+		const auto updateObject = [&updateSets](GameObject* const object) -> void {
 			if (object != nullptr) {
 				object->update(updateSets);
 			}
 			else {
 				sgeAssertFalse("It is expected that all actors in GameWorld::playingObjects are not nullptr!");
 			}
+		};
+
+		const int numObjects = int(objectsOfType.size());
+		const bool shouldUpdateInParallel =
+		    typeToUpdate.isParallelUpdate && m_numUpdateWorkers != 1 && numObjects > m_parallelUpdateChunkSize;
+
+		if (shouldUpdateInParallel) {
+			// Moving actors uses the transform hierarchy, make sure it is up to date as it can't be rebuilt
+			// from the worker threads.
+			if (m_isTransformNodesDirty) {
+				rebuildTransformNodes();
+			}
+
+			// Moving an actor in a hierarchy marks its children as dirty and reading a dirty transform resolves it up
+			// the parent chain, so the workers would race on the hierarchy. The actors in a hierarchy are updated
+			// serially after the others and no transform is left dirty for the workers to resolve.
+			resolveDirtyTransforms();
+
+			const auto isInTransformHierarchy = [this](GameObject* const object) -> bool {
+				const Actor* const actor = object != nullptr ? object->getActor() : nullptr;
+				return actor != nullptr && findTransformNode(actor) >= 0;
+			};
+
+			const auto updateObjectsInRange = [&](int begin, int end) -> void {
+				for (int t = begin; t < end; ++t) {
+					if (isInTransformHierarchy(objectsOfType[t]) == false) {
+						updateObject(objectsOfType[t]);
+					}
+				}
+			};
+
+			m_isUpdatingInParallel = true;
+			getUpdateThreadPool()->parallelFor(numObjects, m_parallelUpdateChunkSize, updateObjectsInRange);
+			m_isUpdatingInParallel = false;
+
+			for (GameObject* const object : objectsOfType) {
+				if (isInTransformHierarchy(object)) {
+					updateObject(object);
+				}
+				else if (Actor* const actor = object->getActor()) {
+					syncActorUpdatedInParallel(actor);
+				}
+			}
+		}
+		else {
+			for (GameObject* const object : objectsOfType) {
+				updateObject(object);
+			}
 		}
 	}
 
+	// Move the children of the actors that have moved during the update.
+	resolveDirtyTransforms();
+
+	// Move the actors whose bounding boxes have changed in the spatial index.
+	updateSpatialIndex();
+
 	// Call postUpdate for world scripts.
 	for (ObjectId scriptObj : m_scriptObjects) {
 		if (IWorldScript* script = dynamic_cast<IWorldScript*>(getObjectById(scriptObj))) {
@@ -465,6 +572,307 @@ void GameWorld::update(const GameUpdateSets& updateSets)
 	}
 }
 
+void GameWorld::rebuildTypesToUpdate()
+{
+	m_typesToUpdate.clear();
+	m_isTypesToUpdateDirty = false;
+
+	// Keep the order of playingObjects, so the order of the updates is the same as if we've iterated it directly.
+	for (auto& itrObjectsByType : playingObjects) {
+		if (itrObjectsByType.second.empty()) {
+			continue;
+		}
+
+		// Types without reflection are updated just in case.
+		const TypeDesc* const typeDesc = typeLib().find(itrObjectsByType.first);
+		const unsigned typeFlags = typeDesc ? typeDesc->typeFlags : 0;
+
+		if ((typeFlags & TF_NoUpdate) == 0) {
+			TypeToUpdate typeToUpdate;
+			typeToUpdate.typeId = itrObjectsByType.first;
+			typeToUpdate.isParallelUpdate = (typeFlags & TF_ParallelUpdate) != 0;
+			typeToUpdate.objects = &itrObjectsByType.second;
+
+			m_typesToUpdate.push_back(typeToUpdate);
+		}
+	}
+}
+
+void GameWorld::rebuildTransformNodes()
+{
+	m_transformNodes.clear();
+	m_isTransformNodesDirty = false;
+
+	// Changing the version invalidates the node indices stored in the actors.
+	m_transformNodesVersion++;
+
+	// Sets the end of the sub-trees for the nodes starting from @iNode and going up to its parents until @iStop.
+	const auto closeTransformSubtrees = [this](int iNode, int iStop, int subtreeEnd) -> void {
+		for (; iNode != iStop; iNode = m_transformNodes[iNode].parentIndex) {
+			m_transformNodes[iNode].subtreeEnd = subtreeEnd;
+		}
+	};
+
+	// Walk each hierarchy in depth-first order starting from the root actors.
+	std::vector<std::pair<Actor*, int>> stack; // The actor to add and the index of its parent node.
+	for (const auto& itrChildrenOf : m_childernOf) {
+		const bool isRoot = m_parentOf.count(itrChildrenOf.first) == 0;
+		if (isRoot == false) {
+			continue;
+		}
+
+		Actor* const rootActor = getActorById(itrChildrenOf.first);
+		if (rootActor == nullptr) {
+			sgeAssertFalse("Actors in the hierarchy are expected to exist!");
+			continue;
+		}
+
+		stack.emplace_back(rootActor, -1);
+		while (stack.empty() == false) {
+			Actor* const actor = stack.back().first;
+			const int parentIndex = stack.back().second;
+			stack.pop_back();
+
+			// In depth-first order the parent of the node is on the path from the last added node to the root.
+			// The sub-trees of the nodes on that path, below the parent, end here.
+			const int nodeIndex = int(m_transformNodes.size());
+			closeTransformSubtrees(nodeIndex - 1, parentIndex, nodeIndex);
+
+			TransformNode node;
+			node.actor = actor;
+			node.parentIndex = parentIndex;
+			m_transformNodes.push_back(node);
+
+			actor->m_transformNodeIndex = nodeIndex;
+			actor->m_transformNodesVersion = m_transformNodesVersion;
+
+			if (const vector_set<ObjectId>* const children = getChildensOf(actor->getId())) {
+				for (int iChild = int(children->size()) - 1; iChild >= 0; --iChild) {
+					Actor* const child = getActorById(children->getNth(iChild));
+					if (child != nullptr) {
+						stack.emplace_back(child, nodeIndex);
+					}
+					else {
+						sgeAssertFalse("Actors in the hierarchy are expected to exist!");
+					}
+				}
+			}
+		}
+
+		// This hierarchy is done, close all sub-trees that are still open.
+		const int numNodes = int(m_transformNodes.size());
+		closeTransformSubtrees(numNodes - 1, -1, numNodes);
+	}
+}
+
+int GameWorld::findTransformNode(const Actor* const actor)
+{
+	if (m_isTransformNodesDirty) {
+		rebuildTransformNodes();
+	}
+
+	if (actor->m_transformNodesVersion != m_transformNodesVersion) {
+		return -1;
+	}
+
+	sgeAssert(actor->m_transformNodeIndex >= 0 && actor->m_transformNodeIndex < int(m_transformNodes.size()));
+	return actor->m_transformNodeIndex;
+}
+
+void GameWorld::markChildTransformsDirty(Actor* const actor, bool killVelocity)
+{
+	const int nodeIndex = findTransformNode(actor);
+	if (nodeIndex < 0) {
+		return;
+	}
+
+	sgeAssert(m_isUpdatingInParallel == false && "Actors in a hierarchy cannot be moved from the update workers!");
+
+	const int subtreeEnd = m_transformNodes[nodeIndex].subtreeEnd;
+	for (int iNode = nodeIndex + 1; iNode < subtreeEnd; ++iNode) {
+		Actor* const child = m_transformNodes[iNode].actor;
+		child->m_isLogicTransformDirty = true;
+		child->m_shouldKillVelocityOnRigidBodyUpdate |= killVelocity;
+	}
+
+	if (subtreeEnd > nodeIndex + 1) {
+		m_hasDirtyTransforms = true;
+	}
+}
+
+void GameWorld::resolveDirtyTransform(const Actor* const actor)
+{
+	int nodeIndex = findTransformNode(actor);
+	if (nodeIndex < 0) {
+		sgeAssertFalse("Only actors in a hierarchy could have dirty transforms!");
+		return;
+	}
+
+	sgeAssert(m_isUpdatingInParallel == false && "Dirty transforms cannot be resolved from the update workers!");
+
+	// Find the top-most dirty parent. Roots never get dirty so there is always a clean one above it.
+	while (m_transformNodes[m_transformNodes[nodeIndex].parentIndex].actor->m_isLogicTransformDirty) {
+		nodeIndex = m_transformNodes[nodeIndex].parentIndex;
+	}
+
+	// Resolve the dirty nodes down to the requested actor. The siblings of these are left dirty.
+	int iNode = nodeIndex;
+	while (true) {
+		TransformNode& node = m_transformNodes[iNode];
+		node.actor->resolveLogicTransformFromParent(m_transformNodes[node.parentIndex].actor->m_logicTransform);
+
+		if (node.actor == actor) {
+			break;
+		}
+
+		// Find the child of this node that is a parent of the requested actor.
+		const int targetIndex = actor->m_transformNodeIndex;
+		int iChild = iNode + 1;
+		while (m_transformNodes[iChild].subtreeEnd <= targetIndex) {
+			iChild = m_transformNodes[iChild].subtreeEnd;
+		}
+		iNode = iChild;
+	}
+}
+
+void GameWorld::resolveDirtyTransforms()
+{
+	if (m_hasDirtyTransforms == false) {
+		return;
+	}
+
+	m_hasDirtyTransforms = false;
+	sgeAssert(m_isTransformNodesDirty == false);
+
+	// Parents are always before their children, so when a node is reached its parent is already resolved.
+	for (TransformNode& node : m_transformNodes) {
+		Actor* const actor = node.actor;
+		if (actor->m_isLogicTransformDirty) {
+			actor->resolveLogicTransformFromParent(m_transformNodes[node.parentIndex].actor->m_logicTransform);
+		}
+
+		moveDirtyRigidBody(actor);
+	}
+}
+
+void GameWorld::syncActorUpdatedInParallel(Actor* const actor)
+{
+	// The rigid bodies share the Bullet broadphase and the dirty list is shared by all actors.
+	moveDirtyRigidBody(actor);
+
+	if (actor->m_isSpatialIndexDirtyDeferred) {
+		actor->m_isSpatialIndexDirtyDeferred = false;
+		actor->markBBoxDirty();
+	}
+}
+
+void GameWorld::moveDirtyRigidBody(Actor* const actor)
+{
+	if (actor->m_isRigidBodyTransformDirty) {
+		if (TraitRigidBody* const traitRB = getTrait<TraitRigidBody>(actor)) {
+			traitRB->setTrasnform(actor->m_logicTransform, actor->m_shouldKillVelocityOnRigidBodyUpdate);
+		}
+
+		actor->m_isRigidBodyTransformDirty = false;
+		actor->m_shouldKillVelocityOnRigidBodyUpdate = false;
+	}
+}
+
+void GameWorld::updateSpatialIndex()
+{
+	// Refreshing an actor might resolve its transform, which could mark other actors as dirty, so the list may grow
+	// while iterating it.
+	for (size_t t = 0; t < m_spatialIndexDirtyActors.size(); ++t) {
+		Actor* const actor = m_spatialIndexDirtyActors[t];
+		refreshActorInSpatialIndex(actor);
+		actor->m_isSpatialIndexDirty = false;
+	}
+
+	m_spatialIndexDirtyActors.clear();
+}
+
+void GameWorld::addSpatialIndexDirtyActor(Actor* const actor)
+{
+	sgeAssert(m_isUpdatingInParallel == false);
+	m_spatialIndexDirtyActors.push_back(actor);
+}
+
+void GameWorld::addActorToSpatialIndex(Actor* const actor)
+{
+	sgeAssert(actor->m_spatialIndexProxyId < 0 && actor->m_actorsWithoutBBoxIndex < 0);
+
+	const Box3f bboxOS = actor->getBBoxOS();
+	if (bboxOS.isEmpty()) {
+		actor->m_actorsWithoutBBoxIndex = int(m_actorsWithoutBBox.size());
+		m_actorsWithoutBBox.push_back(actor);
+	}
+	else {
+		actor->m_spatialIndexProxyId =
+		    m_spatialIndex.createProxy(bboxOS.getTransformed(actor->getTransformMtx()), actor);
+	}
+}
+
+void GameWorld::removeActorFromSpatialIndex(Actor* const actor)
+{
+	if (actor->m_spatialIndexProxyId >= 0) {
+		m_spatialIndex.destroyProxy(actor->m_spatialIndexProxyId);
+		actor->m_spatialIndexProxyId = -1;
+	}
+
+	if (actor->m_actorsWithoutBBoxIndex >= 0) {
+		eraseActorWithoutBBox(actor);
+	}
+
+	if (actor->m_isSpatialIndexDirty) {
+		m_spatialIndexDirtyActors.erase(
+		    std::remove(m_spatialIndexDirtyActors.begin(), m_spatialIndexDirtyActors.end(), actor),
+		    m_spatialIndexDirtyActors.end());
+		actor->m_isSpatialIndexDirty = false;
+	}
+}
+
+void GameWorld::refreshActorInSpatialIndex(Actor* const actor)
+{
+	// The actor isn't playing (yet or anymore).
+	if (actor->m_spatialIndexProxyId < 0 && actor->m_actorsWithoutBBoxIndex < 0) {
+		return;
+	}
+
+	const Box3f bboxOS = actor->getBBoxOS();
+	if (bboxOS.isEmpty()) {
+		if (actor->m_spatialIndexProxyId >= 0) {
+			m_spatialIndex.destroyProxy(actor->m_spatialIndexProxyId);
+			actor->m_spatialIndexProxyId = -1;
+
+			actor->m_actorsWithoutBBoxIndex = int(m_actorsWithoutBBox.size());
+			m_actorsWithoutBBox.push_back(actor);
+		}
+	}
+	else {
+		const Box3f bboxWs = bboxOS.getTransformed(actor->getTransformMtx());
+		if (actor->m_spatialIndexProxyId >= 0) {
+			m_spatialIndex.moveProxy(actor->m_spatialIndexProxyId, bboxWs);
+		}
+		else {
+			eraseActorWithoutBBox(actor);
+			actor->m_spatialIndexProxyId = m_spatialIndex.createProxy(bboxWs, actor);
+		}
+	}
+}
+
+void GameWorld::eraseActorWithoutBBox(Actor* const actor)
+{
+	sgeAssert(actor->m_actorsWithoutBBoxIndex >= 0 && m_actorsWithoutBBox[actor->m_actorsWithoutBBoxIndex] == actor);
+
+	// The order doesn't matter, move the last actor in the place of the removed one.
+	Actor* const lastActor = m_actorsWithoutBBox.back();
+	lastActor->m_actorsWithoutBBoxIndex = actor->m_actorsWithoutBBoxIndex;
+	m_actorsWithoutBBox[actor->m_actorsWithoutBBoxIndex] = lastActor;
+	m_actorsWithoutBBox.pop_back();
+
+	actor->m_actorsWithoutBBoxIndex = -1;
+}
+
 // Used for giving object unique names (However the GameWorld still supports objects with same name).
 int GameWorld::getNextNameIndex()
 {
@@ -500,10 +908,15 @@ bool GameWorld::setParentOf(ObjectId const childId, ObjectId const newParentId,
 		return false;
 	}
 
+	// The hierarchy is about to change, compute all pending transforms while m_transformNodes is still valid.
+	resolveDirtyTransforms();
+
 	// Unparent from exsiting parent
 	{
 		auto itr = m_parentOf.find(childId);
 		if (itr != m_parentOf.end()) {
+			m_isTransformNodesDirty = true;
+
 			// Remove from the parent't list of child nodes.
 			const ObjectId oldParent = itr->second;
 			m_childernOf[oldParent].eraseKey(childId);
@@ -525,6 +938,7 @@ bool GameWorld::setParentOf(ObjectId const childId, ObjectId const newParentId,
 		{
 			m_parentOf[childId] = newParentId;
 			m_childernOf[newParentId].add(childId);
+			m_isTransformNodesDirty = true;
 
 			transf3d const parentWs = newParent->getTransform();
 			transf3d const bindingTransform = child->getTransform().computeBindingTransform(parentWs);
@@ -643,15 +1057,30 @@ void GameWorld::instantiatePrefabFromJsonString(
     bool createHistory,
     bool shouldGenerateNewObjectIds,
     const Optional<transf3d>& offsetWorldSpace)
+{
+	if (prefabJson == nullptr) {
+		return;
+	}
+
+	instantiatePrefabFromMemory(
+	    prefabJson, strlen(prefabJson), createHistory, shouldGenerateNewObjectIds, offsetWorldSpace);
+}
+
+void GameWorld::instantiatePrefabFromMemory(
+    const char* prefabData,
+    size_t prefabDataSizeBytes,
+    bool createHistory,
+    bool shouldGenerateNewObjectIds,
+    const Optional<transf3d>& offsetWorldSpace)
 {
 	GameWorld prefabWorld;
-	bool succeeded = loadGameWorldFromString(&prefabWorld, prefabJson);
+	bool succeeded = loadGameWorldFromMemory(&prefabWorld, prefabData, prefabDataSizeBytes);
 
 	if (succeeded) {
 		instantiatePrefab(prefabWorld, createHistory, shouldGenerateNewObjectIds, nullptr, nullptr, offsetWorldSpace);
 	}
 	else {
-		sgeLogError("Failed to instantiage game objects from json describing game world");
+		sgeLogError("Failed to instantiage game objects from data describing game world");
 	}
 }
 
@@ -666,6 +1095,7 @@ void sge::GameWorld::instantiatePrefab(
 	std::vector<GameObject*> createdObjects;
 	std::unordered_map<ObjectId, ObjectId> oldToNew;
 	std::unordered_map<ObjectId, ObjectId> oldParentOf;
+	std::vector<char> serializedPrefabObject;
 
 	const auto shouldInstantiateObject = [&](const ObjectId objectId) -> bool {
 		if (pOblectsToInstantiate == nullptr) {
@@ -684,10 +1114,15 @@ void sge::GameWorld::instantiatePrefab(
 		// Kind of a lazy solution here...
 		// To instantiate the entities from a prefab we serialize the entity we've just loaded in the prefabWorld
 		// and then deserialize it back in the current world, while creating a new entity id for it.
-		std::string serialziedPrefabObject = serializeObject(prefabObject);
+		// The binary format is used as it is much faster than the json and the buffer is reused between the objects.
+		serializeObjectBinary(prefabObject, serializedPrefabObject);
 		ObjectId originalId;
-		GameObject* const newObject =
-		    deserializeObjectFromJson(this, serialziedPrefabObject.c_str(), shouldGenerateNewObjectIds, &originalId);
+		GameObject* const newObject = deserializeObjectFromBinary(
+		    this,
+		    serializedPrefabObject.data(),
+		    serializedPrefabObject.size(),
+		    shouldGenerateNewObjectIds,
+		    &originalId);
 
 		// Fill the output list of all created object ids
 		if (newObjectIds) {
@@ -819,8 +1254,9 @@ ArrayView<const btPersistentManifold* const> sge::GameWorld::getRigidBodyManifol
 		return {};
 	}
 
-	auto itrFind = m_physicsManifoldList.find(rb);
-	if (itrFind == m_physicsManifoldList.end()) {
+	const auto& manifoldList = m_physicsManifoldList[getPhysicsManifoldListShard(rb)];
+	auto itrFind = manifoldList.find(rb);
+	if (itrFind == manifoldList.end()) {
 		return {};
 	}
 
@@ -830,8 +1266,9 @@ ArrayView<const btPersistentManifold* const> sge::GameWorld::getRigidBodyManifol
 
 void GameWorld::removeRigidBodyManifold(RigidBody* const rb)
 {
-	auto itrFind = m_physicsManifoldList.find(rb);
-	if (itrFind == m_physicsManifoldList.end()) {
+	auto& manifoldList = m_physicsManifoldList[getPhysicsManifoldListShard(rb)];
+	auto itrFind = manifoldList.find(rb);
+	if (itrFind == manifoldList.end()) {
 		return;
 	}
 
@@ -842,8 +1279,9 @@ void GameWorld::removeRigidBodyManifold(RigidBody* const rb)
 		const btCollisionObject* otherCollsionObject = getOtherFromManifold(manifold, coToRemove);
 		const RigidBody* otherRigidBody = fromBullet(otherCollsionObject);
 		if (otherRigidBody) {
-			auto otherRBManifolds = m_physicsManifoldList.find(otherRigidBody);
-			if (otherRBManifolds != m_physicsManifoldList.end()) {
+			auto& otherManifoldList = m_physicsManifoldList[getPhysicsManifoldListShard(otherRigidBody)];
+			auto otherRBManifolds = otherManifoldList.find(otherRigidBody);
+			if (otherRBManifolds != otherManifoldList.end()) {
 				for (int iOtherManifold = 0; iOtherManifold < otherRBManifolds->second.size(); ++iOtherManifold) {
 					const btCollisionObject* probablyRBCOToDelete =
 					    getOtherFromManifold(otherRBManifolds->second[iOtherManifold], otherCollsionObject);
@@ -859,7 +1297,7 @@ void GameWorld::removeRigidBodyManifold(RigidBody* const rb)
 	}
 
 	// Finally remove the manifolds for the specified rigid body.
-	m_physicsManifoldList.erase(itrFind);
+	manifoldList.erase(itrFind);
 }
 
 void GameWorld::addPostSceneTask(IPostSceneUpdateTask* const task)
@@ -879,6 +1317,30 @@ void GameWorld::addPostSceneTaskLoadWorldFormFile(const char* filename)
 }
 
 
+void GameWorld::setNumUpdateWorkers(int numWorkers)
+{
+	if (m_numUpdateWorkers == numWorkers) {
+		return;
+	}
+
+	// The thread pool will get recreated with the new number of workers when needed.
+	m_numUpdateWorkers = numWorkers;
+	m_updateThreadPool.destroy();
+}
+
+ThreadPool* GameWorld::getUpdateThreadPool()
+{
+	if (m_numUpdateWorkers == 1) {
+		return nullptr;
+	}
+
+	if (m_updateThreadPool.isCreated() == false) {
+		m_updateThreadPool.create(m_numUpdateWorkers);
+	}
+
+	return &m_updateThreadPool;
+}
+
 void GameWorld::setDefaultGravity(const vec3f& gravity)
 {
 	physicsWorld.dynamicsWorld->setGravity(toBullet(gravity));
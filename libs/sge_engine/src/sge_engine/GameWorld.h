@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <string>
 #include <unordered_map>
@@ -14,7 +15,9 @@
 #include "sge_renderer/renderer/renderer.h"
 #include "sge_utils/containers/ArrayView.h"
 #include "sge_utils/containers/vector_set.h"
+#include "sge_utils/math/DynamicAABBTree.h"
 #include "sge_utils/react/Event.h"
+#include "sge_utils/threading/ThreadPool.h"
 
 namespace sge {
 
@@ -206,6 +209,35 @@ struct SGE_ENGINE_API GameWorld {
 	/// The values are appended to the list.
 	void getAllRelativesOf(vector_set<ObjectId>& result, ObjectId actorId) const;
 
+	/// @brief Computes the world space transforms of all actors whose parents have moved since the last call.
+	/// Called automatically during update(). Call it manually if you need all actor transforms to be up to date
+	/// (for example before iterating over the actors to read their transform members directly).
+	void resolveDirtyTransforms();
+
+	/// @brief Marks all children (and their children) of the specified actor as needing their transforms resolved.
+	/// Called by Actor::setTransformEx.
+	void markChildTransformsDirty(Actor* const actor, bool killVelocity);
+
+	/// @brief Resolves the transform of the specified dirty actor and its dirty parents, used by Actor::getTransform.
+	void resolveDirtyTransform(const Actor* const actor);
+
+	/// @brief Moves the actors whose transform or bounding box has changed in the spatial index.
+	/// Called automatically at the end of update() and before each spatial query.
+	void updateSpatialIndex();
+
+	/// @brief Adds the actor to the list of actors to be moved in the spatial index. Used by Actor::markBBoxDirty.
+	void addSpatialIndexDirtyActor(Actor* const actor);
+
+	/// @brief Calls @fn "void (Actor*)" for every playing actor whose bounding box (in world space) might be inside the
+	/// frustum. Actors with an empty bounding box cannot be culled and are always reported.
+	template <typename TFn>
+	void queryActorsInFrustum(const Frustum& frustumWs, TFn&& fn);
+
+	/// @brief Calls @fn "void (Actor*)" for every playing actor whose bounding box (in world space) might overlap
+	/// @boxWs. Actors with an empty bounding box are not reported.
+	template <typename TFn>
+	void queryActorsInBox(const Box3f& boxWs, TFn&& fn);
+
 	/// @brief Instantients the specified world into the current world.
 	/// @param [in] prefabPath a path the world file to be instantiated.
 	/// @param [in] createHistory pass true if the changes should be added to undo/redo history.
@@ -224,6 +256,15 @@ struct SGE_ENGINE_API GameWorld {
 	    bool shouldGenerateNewObjectIds,
 	    const Optional<transf3d>& offsetWorldSpace);
 
+	/// The same as instantiatePrefabFromJsonString, but the world could be either json or binary
+	/// (see serializeGameWorldBinary).
+	void instantiatePrefabFromMemory(
+	    const char* prefabData,
+	    size_t prefabDataSizeBytes,
+	    bool createHistory,
+	    bool shouldGenerateNewObjectIds,
+	    const Optional<transf3d>& offsetWorldSpace);
+
 	/// Instantients the specified prefabWorld into the current world.
 	/// In result new objects will be generated in the current world, however for obvious reasions
 	/// they will have different ids.
@@ -282,6 +323,52 @@ struct SGE_ENGINE_API GameWorld {
 
 	ICamera* getRenderCamera();
 
+	/// @brief Changes the number of threads used to update the game object types marked with @TF_ParallelUpdate.
+	/// @param [in] numWorkers 1 means that everything gets updated serially on the calling thread,
+	///             0 or less means that all hardware threads will be used.
+	void setNumUpdateWorkers(int numWorkers);
+
+	/// @brief Returns the worker threads used for updating the game objects. Game objects with a lot of work (like
+	/// big particle systems) could use them to split it. Returns nullptr if the update is configured to be serial.
+	/// Should be called only during the update, the pool gets created on the first call.
+	ThreadPool* getUpdateThreadPool();
+
+	/// @brief Returns true while the update workers are updating objects, see @TF_ParallelUpdate.
+	bool isUpdatingInParallel() const { return m_isUpdatingInParallel; }
+
+	/// @brief Changes the number of threads used by the physics simulation. Takes effect on the next call to @create.
+	/// @param [in] numWorkers 1 means the single threaded Bullet world, anything else creates the multithreaded one,
+	///             0 or less means that all hardware threads will be used. See @PhysicsWorld::create.
+	void setNumPhysicsWorkers(int numWorkers) { m_numPhysicsWorkers = numWorkers; }
+
+	/// @brief Returns the number of animated models that did not evaluate their animation during the last update.
+	/// See @TraitModel::shouldEvaluateAnimation.
+	int getNumSkippedAnimationEvaluations() const { return m_numSkippedAnimationEvaluationsLastUpdate; }
+
+	/// @brief Counts an animation evaluation skipped during the current update. Safe to call from parallel updates.
+	void addSkippedAnimationEvaluation() { m_numSkippedAnimationEvaluations.fetch_add(1, std::memory_order_relaxed); }
+
+  private:
+	/// Recomputes @m_typesToUpdate from @playingObjects.
+	void rebuildTypesToUpdate();
+	/// Recomputes @m_transformNodes from @m_childernOf.
+	void rebuildTransformNodes();
+	/// Returns the index of the actor in @m_transformNodes or -1 if the actor isn't part of any hierarchy.
+	int findTransformNode(const Actor* const actor);
+	/// Moves the rigid body of the actor to its transform if it is marked with Actor::m_isRigidBodyTransformDirty.
+	void moveDirtyRigidBody(Actor* const actor);
+	/// Does what the update workers couldn't do for an actor updated in parallel, see @TF_ParallelUpdate.
+	void syncActorUpdatedInParallel(Actor* const actor);
+
+	/// Adds a playing actor to @m_spatialIndex (or to @m_actorsWithoutBBox).
+	void addActorToSpatialIndex(Actor* const actor);
+	/// Removes an actor that stops playing from the spatial index.
+	void removeActorFromSpatialIndex(Actor* const actor);
+	/// Recomputes the world space bounding box of the actor and moves it in the spatial index.
+	void refreshActorInSpatialIndex(Actor* const actor);
+	/// Removes the actor from @m_actorsWithoutBBox.
+	void eraseActorWithoutBBox(Actor* const actor);
+
   public:
 	/// The projection settings specified by the user. (Some of them are window dependad and we update them manully).
 	/// TODO: This is an old idea, and no longer has its place in the game world.
@@ -307,6 +394,19 @@ struct SGE_ENGINE_API GameWorld {
 	std::vector<GameObject*> objectsAwaitingCreation;
 	// All playing game object sorted by type.
 	std::unordered_map<TypeId, std::vector<GameObject*>> playingObjects;
+
+	/// A type from @playingObjects that needs its objects to get updated.
+	struct TypeToUpdate {
+		TypeId typeId;
+		bool isParallelUpdate = false; ///< True if the type is marked with @TF_ParallelUpdate.
+		std::vector<GameObject*>* objects = nullptr; ///< Points to the list in @playingObjects.
+	};
+
+	/// A compact list of the playing types that override GameObject::update and have objects.
+	/// Types marked with @TF_NoUpdate (done by @computeGameObjectTypeFlags for the ones that don't) are not in it.
+	/// Rebuilt at the beginning of the update if any object has started or stopped playing.
+	std::vector<TypeToUpdate> m_typesToUpdate;
+	bool m_isTypesToUpdateDirty = true;
 	/// A set of actors that are going to be compleatley deleted for the game world.
 	vector_set<ObjectId> objectsWantingPermanentKill;
 
@@ -318,6 +418,33 @@ struct SGE_ENGINE_API GameWorld {
 	std::unordered_map<ObjectId, vector_set<ObjectId>> m_childernOf;
 	std::unordered_map<ObjectId, ObjectId> m_parentOf;
 
+	/// An actor that is part of a hierarchy (has a parent or children) in @m_transformNodes.
+	struct TransformNode {
+		Actor* actor = nullptr;
+		int parentIndex = -1; ///< The index of the parent node, -1 for root nodes.
+		int subtreeEnd = 0;   ///< The index after the last node in the sub-tree of this node.
+	};
+
+	/// All actors that participate in a hierarchy sorted in depth-first order, so parents always come before their
+	/// children and the sub-tree of each node is the contiguous range (nodeIndex, subtreeEnd).
+	/// Moving an actor only marks its sub-tree as dirty, the transforms of the children are resolved with a single
+	/// linear pass by resolveDirtyTransforms(), or on demand if someone asks for them before that.
+	/// Rebuilt lazily when the hierarchy changes. Any dirty transforms are resolved before changing the hierarchy,
+	/// so there are no dirty transforms while the array is outdated.
+	std::vector<TransformNode> m_transformNodes;
+	/// Incremented on each rebuild of @m_transformNodes. See Actor::m_transformNodesVersion.
+	unsigned m_transformNodesVersion = 0;
+	bool m_isTransformNodesDirty = true;
+	bool m_hasDirtyTransforms = false;
+
+	/// A dynamic tree of the bounding boxes (in world space) of all playing actors. Used for culling when rendering
+	/// and for overlap queries. The user data of each proxy is the Actor.
+	DynamicAABBTree m_spatialIndex;
+	/// Playing actors with empty bounding boxes, they cannot be culled so they aren't in @m_spatialIndex.
+	std::vector<Actor*> m_actorsWithoutBBox;
+	/// Actors whose transform or bounding box has changed since the last updateSpatialIndex().
+	std::vector<Actor*> m_spatialIndexDirtyActors;
+
 	// Events:
 
 	/// Each subscriber will get called after the update step has finished.
@@ -329,9 +456,26 @@ struct SGE_ENGINE_API GameWorld {
 	PhysicsWorld physicsWorld;
 	BulletPhysicsDebugDraw m_physicsDebugDraw;
 
+	/// The number of shards of @m_physicsManifoldList.
+	static constexpr int kNumPhysicsManifoldListShards = 16;
+
+	/// Returns the shard of @m_physicsManifoldList that holds the manifolds of the specified rigid body.
+	static int getPhysicsManifoldListShard(const RigidBody* rb)
+	{
+		const uint64 hash = uint64(uintptr_t(rb) >> 4) * 0x9E3779B97F4A7C15ull;
+		return int((hash >> 32) % kNumPhysicsManifoldListShards);
+	}
+
 	/// Per frame physics contact manifold list.
 	/// Updated each frame after the physics simulation has ended and refresh if a game object is deleted.
-	std::unordered_map<const RigidBody*, std::vector<const btPersistentManifold*>> m_physicsManifoldList;
+	/// The list is split into shards by the rigid body, so the shards could be filled in parallel without locking.
+	std::unordered_map<const RigidBody*, std::vector<const btPersistentManifold*>>
+	    m_physicsManifoldList[kNumPhysicsManifoldListShards];
+
+	/// The contacting rigid bodies of the current frame bucketed by shard of @m_physicsManifoldList.
+	/// Used only while gathering the manifolds, kept here to reuse the memory between the frames.
+	std::vector<std::pair<const RigidBody*, const btPersistentManifold*>>
+	    m_physicsManifoldsByShard[kNumPhysicsManifoldListShards];
 
 	/// The next free game object id.
 	int m_nextObjectId = 1;
@@ -342,6 +486,11 @@ struct SGE_ENGINE_API GameWorld {
 	int totalStepsTaken = 0;      ///< The number of updates done, both paused and playing.
 	float timeSpendPlaying = 0.f; ///< The total time spend playing in seconds.
 
+	/// The animation evaluations skipped during the current update, see @addSkippedAnimationEvaluation.
+	std::atomic<int> m_numSkippedAnimationEvaluations{0};
+	/// The animation evaluations skipped during the last update, see @getNumSkippedAnimationEvaluations.
+	int m_numSkippedAnimationEvaluationsLastUpdate = 0;
+
 	int m_physicsSimNumSubSteps = 3;
 	vec3f m_defaultGravity = vec3f(0.f, -10.f, 0.f);
 
@@ -353,6 +502,18 @@ struct SGE_ENGINE_API GameWorld {
 	/// Script objects to get called.
 	std::vector<ObjectId> m_scriptObjects;
 
+	/// The number of threads used to update types marked with @TF_ParallelUpdate. See @setNumUpdateWorkers.
+	int m_numUpdateWorkers = 0;
+	/// The number of threads used by the physics simulation. See @setNumPhysicsWorkers.
+	int m_numPhysicsWorkers = 1;
+	/// The number of objects of the same type updated by a single job when updating in parallel.
+	int m_parallelUpdateChunkSize = 64;
+	/// True while the update workers are updating the objects of a type marked with @TF_ParallelUpdate.
+	bool m_isUpdatingInParallel = false;
+	/// The workers used for updating types marked with @TF_ParallelUpdate.
+	/// Created on the first update that needs them, as most of the worlds (prefabs, the editor) never do.
+	ThreadPool m_updateThreadPool;
+
 	/// True if the game is in edit mode
 	bool isEdited = true;
 
@@ -403,4 +564,26 @@ T* GameWorld::getActor(const ObjectId& id)
 	return static_cast<T*>(actor);
 }
 
+template <typename TFn>
+void GameWorld::queryActorsInFrustum(const Frustum& frustumWs, TFn&& fn)
+{
+	updateSpatialIndex();
+
+	m_spatialIndex.queryFrustum(
+	    frustumWs, [this, &fn](const int proxyId) -> void { fn((Actor*)m_spatialIndex.getUserData(proxyId)); });
+
+	for (Actor* const actor : m_actorsWithoutBBox) {
+		fn(actor);
+	}
+}
+
+template <typename TFn>
+void GameWorld::queryActorsInBox(const Box3f& boxWs, TFn&& fn)
+{
+	updateSpatialIndex();
+
+	m_spatialIndex.queryBox(
+	    boxWs, [this, &fn](const int proxyId) -> void { fn((Actor*)m_spatialIndex.getUserData(proxyId)); });
+}
+
 } // namespace sge
@@ -108,6 +108,9 @@ void CmdMemberChange::apply(GameInspector* inspector)
 		typeDesc->copyFn(dest, m_newData.get());
 
 	actor->onMemberChanged();
+	if (Actor* const changedActor = actor->getActor()) {
+		changedActor->markBBoxDirty();
+	}
 
 	// HACK: When we've got a node selected with the transform tool and move it a few time,
 	// if we undo while selected the gizmo with override the transform.
@@ -135,6 +138,9 @@ void CmdMemberChange::undo(GameInspector* inspector)
 		typeDesc->copyFn(dest, m_orginaldata.get());
 
 	actor->onMemberChanged();
+	if (Actor* const changedActor = actor->getActor()) {
+		changedActor->markBBoxDirty();
+	}
 
 	// HACK: When we've got a node selected with the transform tool and move it a few time,
 	// if we undo while selected the gizmo with override the transform.
@@ -242,6 +248,9 @@ void CmdDynamicProperyChanged::apply(GameInspector* inspector)
 	typeDesc->copyFn(dest, m_newData.get());
 
 	object->onMemberChanged();
+	if (Actor* const changedActor = object->getActor()) {
+		changedActor->markBBoxDirty();
+	}
 
 	// HACK: When we've got a node selected with the transform tool and move it a few time,
 	// if we undo while selected the gizmo with override the transform.
@@ -284,6 +293,9 @@ void CmdDynamicProperyChanged::undo(GameInspector* inspector)
 	typeDesc->copyFn(dest, m_orginaldata.get());
 
 	object->onMemberChanged();
+	if (Actor* const changedActor = object->getActor()) {
+		changedActor->markBBoxDirty();
+	}
 
 	// HACK: When we've got a node selected with the transform tool and move it a few time,
 	// if we undo while selected the gizmo with override the transform.
@@ -368,16 +380,18 @@ GameObject* duplicateGameObjectIncompleate(const GameObject* const srcObject)
 		const char* const srcMemberBytes = (const char*)srcObject + mfd.byteOffset;
 
 		if ((mfd.flags & MFF_NonEditable) == 0) {
-			const TypeDesc* const memberTypeDesc = typeLib().find(mfd.typeId);
+			const TypeDesc* const memberTypeDesc = mfd.getTypeDesc();
 
 			const bool isActorTransform = mfd.is(&Actor::m_logicTransform);
 			const bool isDisplayName = mfd.is(&Actor::m_displayName);
 
 			// Handle the special cases first.
 			if (isActorTransform) {
+				// Use getTransform() as the member of the source might be waiting on a moved parent.
+				const Actor* srcActor = srcObject->getActor();
 				Actor* destActor = dynamic_cast<Actor*>(destObject);
-				if (destActor) {
-					destActor->setTransform(*(transf3d*)(srcMemberBytes));
+				if (srcActor && destActor) {
+					destActor->setTransform(srcActor->getTransform());
 				}
 			}
 			else if (isDisplayName) {
@@ -498,7 +512,7 @@ void CmdObjectDeletion::setupDeletion(GameWorld& world, vector_set<ObjectId> obj
 
 	GameWorld deletedObjectsInAPrefab;
 	world.createPrefab(deletedObjectsInAPrefab, true, &m_deletedObjectIds);
-	m_prefabWorldJson = serializeGameWorld(&deletedObjectsInAPrefab);
+	serializeGameWorldBinary(&deletedObjectsInAPrefab, m_prefabWorldData);
 }
 
 void CmdObjectDeletion::apply(GameInspector* inspector)
@@ -518,7 +532,8 @@ void CmdObjectDeletion::redo(GameInspector* inspector)
 void CmdObjectDeletion::undo(GameInspector* inspector)
 {
 	GameWorld* world = inspector->getWorld();
-	world->instantiatePrefabFromJsonString(m_prefabWorldJson.c_str(), false, false, NullOptional());
+	world->instantiatePrefabFromMemory(
+	    m_prefabWorldData.data(), m_prefabWorldData.size(), false, false, NullOptional());
 
 	// Restore the hierarchy of the deleted objects.
 	for (auto& pair : m_originalHierarchy) {
@@ -547,7 +562,7 @@ void CmdExistingObjectCreation::setup(GameWorld& world, vector_set<ObjectId> tar
 
 	GameWorld prefabWorld;
 	world.createPrefab(prefabWorld, true, &m_targetObjectIds);
-	m_prefabWorldJson = serializeGameWorld(&prefabWorld);
+	serializeGameWorldBinary(&prefabWorld, m_prefabWorldData);
 }
 
 void CmdExistingObjectCreation::apply(GameInspector* UNUSED(inspector))
@@ -560,7 +575,8 @@ void CmdExistingObjectCreation::apply(GameInspector* UNUSED(inspector))
 void CmdExistingObjectCreation::redo(GameInspector* inspector)
 {
 	GameWorld* world = inspector->getWorld();
-	world->instantiatePrefabFromJsonString(m_prefabWorldJson.c_str(), false, false, NullOptional());
+	world->instantiatePrefabFromMemory(
+	    m_prefabWorldData.data(), m_prefabWorldData.size(), false, false, NullOptional());
 
 	// Restore the hierarchy of the deleted objects.
 	for (auto& pair : m_originalHierarchy) {
@@ -63,6 +63,8 @@ struct SGE_ENGINE_API CmdMemberChange : public InspectorCmd {
 
 	void setupLogicTransformChange(Actor& actor, const transf3d& initalTransform, const transf3d& newTransform)
 	{
+		// The command follows the chain to the member directly, make sure it isn't waiting on a moved parent.
+		actor.getTransform();
 		setup(
 		    &actor,
 		    MemberChain(typeLib().findMember(&Actor::m_logicTransform)),
@@ -164,7 +166,8 @@ struct SGE_ENGINE_API CmdObjectDeletion : public InspectorCmd {
   private:
 	vector_set<ObjectId> m_deletedObjectIds;
 	std::unordered_map<ObjectId, ParentAndChilds> m_originalHierarchy;
-	std::string m_prefabWorldJson;
+	/// The removed objects saved with serializeGameWorldBinary.
+	std::vector<char> m_prefabWorldData;
 };
 
 //--------------------------------------------------------------------
@@ -187,7 +190,8 @@ struct SGE_ENGINE_API CmdExistingObjectCreation : public InspectorCmd {
   private:
 	vector_set<ObjectId> m_targetObjectIds;
 	std::unordered_map<ObjectId, ParentAndChilds> m_originalHierarchy;
-	std::string m_prefabWorldJson;
+	/// The target objects saved with serializeGameWorldBinary.
+	std::vector<char> m_prefabWorldData;
 };
 
 
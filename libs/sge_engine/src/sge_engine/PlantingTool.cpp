@@ -99,9 +99,6 @@ InspectorToolResult PlantingTool::updateTool(
 	if (rayResult.hasHit()) {
 		const vec3f hitNormal = normalized0(fromBullet(rayResult.m_hitNormalWorld));
 
-		MemberChain mfc;
-		mfc.add(typeLib().findMember(&Actor::m_logicTransform));
-
 		const vec3f rotateAxis = cross(vec3f::getAxis(1), hitNormal);
 		const float rotationAngle = asinf(rotateAxis.length());
 
@@ -86,8 +86,8 @@ bool addCollisionShapeBasedOnModelRenderGeom(
 		for (MeshAttachment& meshAttachment : modelNode->meshAttachments) {
 			ModelMesh* modelMesh = evaluatedModel.m_model->meshAt(meshAttachment.attachedMeshIndex);
 
-			const char* vertexBuffer = modelMesh->vertexBufferRaw.data();
-			const char* indexBuffer = modelMesh->indexBufferRaw.data();
+			const char* vertexBuffer = modelMesh->getVertexBufferData().data();
+			const char* indexBuffer = modelMesh->getIndexBufferData().data();
 
 			const int numTriangles = modelMesh->numElements / 3;
 			const int vertexStide = modelMesh->stride;
@@ -1,4 +1,7 @@
 #include "SceneInstance.h"
+#include "sge_audio/AudioDevice.h"
+#include "sge_core/Camera.h"
+#include "sge_core/ICore.h"
 #include "sge_utils/io/FileStream.h"
 #include "sge_utils/json/json.h"
 
@@ -15,9 +18,14 @@ void SceneInstance::newScene()
 }
 
 void SceneInstance::loadWorldFromJson(const char* const json, bool disableAutoSepping)
+{
+	if_checked(json) { loadWorldFromMemory(json, strlen(json), disableAutoSepping); }
+}
+
+void SceneInstance::loadWorldFromMemory(const char* const data, const size_t sizeBytes, bool disableAutoSepping)
 {
 	newScene();
-	[[maybe_unused]] bool success = loadGameWorldFromString(&m_world, json);
+	[[maybe_unused]] bool success = loadGameWorldFromMemory(&m_world, data, sizeBytes);
 	sgeAssert(success);
 
 	getInspector().m_disableAutoStepping = disableAutoSepping;
@@ -25,22 +33,29 @@ void SceneInstance::loadWorldFromJson(const char* const json, bool disableAutoSe
 
 void SceneInstance::loadWorldFromFile(const char* const filename, bool disableAutoSepping)
 {
-	std::vector<char> fileContents;
-	if (FileReadStream::readFile(filename, fileContents)) {
-		fileContents.push_back('\0');
-		loadWorldFromJson(fileContents.data(), disableAutoSepping);
-		return;
-	}
+	newScene();
+	[[maybe_unused]] bool success = loadGameWorldFromFile(&m_world, filename, true);
+	sgeAssert(success);
 
-	sgeAssert(false);
+	getInspector().m_disableAutoStepping = disableAutoSepping;
 }
 
-bool SceneInstance::saveWorldToFile(const char* const filename)
+bool SceneInstance::saveWorldToFile(const char* const filename, bool saveAsBinary)
 {
 	if (!filename) {
 		return false;
 	}
 
+	if (saveAsBinary) {
+		const std::vector<char> worldData = serializeGameWorldBinary(&m_world);
+		FileWriteStream fws;
+		if (!fws.open(filename)) {
+			return false;
+		}
+
+		return fws.write(worldData.data(), worldData.size()) == worldData.size();
+	}
+
 	JsonValueBuffer jvb;
 	JsonValue* const jWorld = serializeGameWorld(&m_world, jvb);
 	if_checked(jWorld)
@@ -58,6 +73,7 @@ void SceneInstance::update(float dt, const InputState& is)
 	dt = clamp(minOf(dt, 1.f), 0.f, 1.f / 15.f);
 	const GameUpdateSets updateSets(dt, !m_inspector.isSteppingAllowed(), is);
 	m_world.update(updateSets);
+	updateAudioListener(updateSets);
 
 	for (int t = 0; t < m_world.m_postSceneUpdateTasks.size(); ++t) {
 		IPostSceneUpdateTask* const task = m_world.m_postSceneUpdateTasks[t].get();
@@ -65,8 +81,8 @@ void SceneInstance::update(float dt, const InputState& is)
 		PostSceneUpdateTaskSetWorldState* const taskChangeWorldJson =
 		    dynamic_cast<PostSceneUpdateTaskSetWorldState*>(task);
 		if (taskChangeWorldJson != nullptr) {
-			taskChangeWorldJson->newWorldStateJson;
-			loadWorldFromJson(taskChangeWorldJson->newWorldStateJson.c_str(), false);
+			loadWorldFromMemory(
+			    taskChangeWorldJson->newWorldStateJson.data(), taskChangeWorldJson->newWorldStateJson.size(), false);
 			m_inspector.m_disableAutoStepping = !taskChangeWorldJson->noPauseNoEditorCamera;
 			m_world.m_useEditorCamera = !taskChangeWorldJson->noPauseNoEditorCamera;
 		}
@@ -83,4 +99,25 @@ void SceneInstance::update(float dt, const InputState& is)
 	m_world.m_postSceneUpdateTasks.clear();
 }
 
+void SceneInstance::updateAudioListener(const GameUpdateSets& updateSets)
+{
+	AudioDevice* const audioDevice = getCore()->getAudioDevice();
+	ICamera* const camera = m_world.getRenderCamera();
+	if (audioDevice == nullptr || camera == nullptr || updateSets.isSimulationPaused()) {
+		m_hasAudioListener = false;
+		return;
+	}
+
+	AudioListener listener;
+	listener.position = camera->getCameraPosition();
+	listener.forward = camera->getCameraLookDir();
+	listener.up = camera->getView().getRow(1).xyz();
+	if (m_hasAudioListener && updateSets.dt > 0.f) {
+		listener.velocity = (listener.position - audioDevice->getListener().position) / updateSets.dt;
+	}
+
+	audioDevice->setListener(listener);
+	m_hasAudioListener = true;
+}
+
 } // namespace sge
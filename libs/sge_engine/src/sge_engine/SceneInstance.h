@@ -20,14 +20,24 @@ struct SGE_ENGINE_API SceneInstance {
 
 	void newScene();
 	void loadWorldFromJson(const char* const json, bool disableAutoSepping);
+	/// Loads the world from a json or a binary level (see serializeGameWorldBinary).
+	void loadWorldFromMemory(const char* const data, const size_t sizeBytes, bool disableAutoSepping);
+	/// Opens the level stored in the file, the assets referenced by it are preloaded in parallel.
 	void loadWorldFromFile(const char* const filename, bool disableAutoSepping);
-	bool saveWorldToFile(const char* const filename);
+	/// @param [in] saveAsBinary if true the world is saved with serializeGameWorldBinary, otherwise as json.
+	bool saveWorldToFile(const char* const filename, bool saveAsBinary = false);
 
 	void update(float dt, const InputState& is);
 
+  private:
+	/// Makes the render camera the listener of the 3D sounds, while the game is playing.
+	void updateAudioListener(const GameUpdateSets& updateSets);
+
   private:
 	GameInspector m_inspector;
 	GameWorld m_world;
+	/// True if the listener was set by the previous update, used to compute its velocity.
+	bool m_hasAudioListener = false;
 };
 
 } // namespace sge
@@ -1,6 +1,7 @@
 #include "imgui/imgui.h"
 
 #include "Actor.h"
+#include "ActorPicking.h"
 #include "GameInspector.h"
 #include "sge_core/QuickDraw/QuickDraw.h"
 #include "sge_engine/GameDrawer/GameDrawer.h"
@@ -284,22 +285,6 @@ void SelectionTool::performPicking(
 		selectionRectCS.expand(selectionRectCS.min - vec2f(1.f, 1.f));
 	}
 
-	// Determing size of the picking render target.
-	SGEContext* const sgecon = drawSets.rdest.sgecon;
-	SGEDevice* const sgedev = sgecon->getDevice();
-
-	// Create the picking frame target.
-	if (m_renderTarget == NULL) {
-		m_renderTarget = sgedev->requestResource<FrameTarget>();
-		sgeAssert(m_renderTarget != NULL);
-	}
-
-	vec2f const pickingTargetSize = selectionRectCS.size();
-
-	if (!m_renderTarget->isSizeEqual(pickingTargetSize) && pickingTargetSize != vec2f(0.f, 0.f)) {
-		m_renderTarget->create2D((int)pickingTargetSize.x, (int)pickingTargetSize.y);
-	}
-
 	vec2f const viewportSize = drawSets.rdest.viewport.getSizeFloats();
 	vec2f minPickingNDC = vec2f(selectionRectCS.min.x, selectionRectCS.max.y) / viewportSize;
 	vec2f maxPickingNDC = vec2f(selectionRectCS.max.x, selectionRectCS.min.y) / viewportSize;
@@ -334,16 +319,6 @@ void SelectionTool::performPicking(
 	    isOrthographic ? mat4f::getOrthoRH(l, r, b, t, 0.1f, 10000.f, kIsTexcoordStyleD3D)
 	                   : mat4f::getPerspectiveOffCenterRH(l, r, b, t, 0.1f, 10000.f, kIsTexcoordStyleD3D));
 
-	GameDrawSets pickingDrawSets;
-	pickingDrawSets.setup(
-	    sgecon, m_renderTarget, drawSets.quickDraw, &pickingCamera, drawSets.gameCamera, drawSets.gameDrawer);
-
-	GpuHandle<Query> query = sgecon->getDevice()->requestResource<Query>();
-	query->create(QueryType::NumSamplesPassedDepthStencilTest);
-
-	sgecon->clearColor(m_renderTarget, -1, vec4f(0.f, 0.f, 0.f, 1.f).data);
-	sgecon->clearDepth(m_renderTarget, 1.f);
-
 	SelectionToolMode* const toolMode =
 	    inspector->editMode == editMode_actors ? (SelectionToolMode*)&m_modeActors : (SelectionToolMode*)&m_modePoints;
 
@@ -356,29 +331,72 @@ void SelectionTool::performPicking(
 
 	std::vector<int> affectedItemIndices;
 
-	const int numItems = toolMode->getNumItems(inspector);
-	for (int iItem = 0; iItem < numItems; ++iItem) {
-		// Draw the item and check if any pixels made it to the final target.
-		sgecon->beginQuery(query);
-		toolMode->drawItem(inspector, iItem, pickingDrawSets);
-		sgecon->endQuery(query);
-
-		uint64 numPixelsThatMadeIt;
-		while (!sgecon->getQueryData(query, numPixelsThatMadeIt))
-			;
-
-		if (numPixelsThatMadeIt != 0) {
-			if (singleClickSelection) {
-				affectedItemIndices.resize(1);
-				affectedItemIndices[0] = iItem;
-			}
-			else {
+	if (toolMode == &m_modeActors) {
+		// Actors are picked on the CPU, a ray is used for single clicks and the picking frustum for rectangles.
+		m_actorPicker.build(*inspector->m_world, *drawSets.drawCamera);
+
+		if (singleClickSelection) {
+			const Ray pickRayWs = drawSets.drawCamera->perspectivePickWs(selectionRectCS.center() / viewportSize);
+			const int iItem = m_actorPicker.pickRay(pickRayWs);
+			if (iItem >= 0) {
 				affectedItemIndices.push_back(iItem);
 			}
 		}
+		else {
+			m_actorPicker.pickFrustum(*pickingCamera.getFrustumWS(), affectedItemIndices);
+		}
+	}
+	else {
+		// Points are picked by drawing every item and checking if any pixels made it to the picking render target.
+		SGEContext* const sgecon = drawSets.rdest.sgecon;
+		SGEDevice* const sgedev = sgecon->getDevice();
+
+		// Create the picking frame target.
+		if (m_renderTarget == NULL) {
+			m_renderTarget = sgedev->requestResource<FrameTarget>();
+			sgeAssert(m_renderTarget != NULL);
+		}
+
+		vec2f const pickingTargetSize = selectionRectCS.size();
+
+		if (!m_renderTarget->isSizeEqual(pickingTargetSize) && pickingTargetSize != vec2f(0.f, 0.f)) {
+			m_renderTarget->create2D((int)pickingTargetSize.x, (int)pickingTargetSize.y);
+		}
+
+		GameDrawSets pickingDrawSets;
+		pickingDrawSets.setup(
+		    sgecon, m_renderTarget, drawSets.quickDraw, &pickingCamera, drawSets.gameCamera, drawSets.gameDrawer);
+
+		GpuHandle<Query> query = sgecon->getDevice()->requestResource<Query>();
+		query->create(QueryType::NumSamplesPassedDepthStencilTest);
+
+		sgecon->clearColor(m_renderTarget, -1, vec4f(0.f, 0.f, 0.f, 1.f).data);
+		sgecon->clearDepth(m_renderTarget, 1.f);
 
-		if (!singleClickSelection) {
-			sgecon->clearDepth(m_renderTarget, 1.f);
+		const int numItems = toolMode->getNumItems(inspector);
+		for (int iItem = 0; iItem < numItems; ++iItem) {
+			// Draw the item and check if any pixels made it to the final target.
+			sgecon->beginQuery(query);
+			toolMode->drawItem(inspector, iItem, pickingDrawSets);
+			sgecon->endQuery(query);
+
+			uint64 numPixelsThatMadeIt;
+			while (!sgecon->getQueryData(query, numPixelsThatMadeIt))
+				;
+
+			if (numPixelsThatMadeIt != 0) {
+				if (singleClickSelection) {
+					affectedItemIndices.resize(1);
+					affectedItemIndices[0] = iItem;
+				}
+				else {
+					affectedItemIndices.push_back(iItem);
+				}
+			}
+
+			if (!singleClickSelection) {
+				sgecon->clearDepth(m_renderTarget, 1.f);
+			}
 		}
 	}
 
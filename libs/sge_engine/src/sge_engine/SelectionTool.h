@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ActorPicking.h"
 #include "InspectorTool.h"
 #include "sge_engine/GameObject.h"
 #include "sge_renderer/renderer/renderer.h"
@@ -74,7 +75,8 @@ struct SGE_ENGINE_API SelectionTool : public IInspectorTool {
 	vec2f m_pickingPointStartCS;
 	vec2f m_lastUpdateCursorPos;
 
-	GpuHandle<FrameTarget> m_renderTarget;
+	GpuHandle<FrameTarget> m_renderTarget; ///< Used for picking points, actors are picked with @m_actorPicker.
+	ActorPicker m_actorPicker;
 
 	SelectionToolModeActors m_modeActors;
 	SelectionToolModePoints m_modePoints;
@@ -0,0 +1,172 @@
+#include "SerializationPlan.h"
+#include "sge_core/AssetLibrary/AssetLibrary.h"
+#include "sge_core/typelib/typeLib.h"
+#include "sge_log/Log.h"
+#include "sge_utils/math/transform.h"
+#include <memory>
+#include <unordered_map>
+
+namespace sge {
+
+namespace {
+	struct SerializationPlansCache {
+		std::unordered_map<const TypeDesc*, std::unique_ptr<SerializationPlan>> plans;
+		/// The TypeLib::registrationVersion that the plans were built for.
+		int registrationVersion = -1;
+	};
+
+	SerializationPlansCache& getPlansCache()
+	{
+		static SerializationPlansCache cache;
+		return cache;
+	}
+
+	SerializedKind findSerializedKind(const TypeDesc& typeDesc)
+	{
+		const TypeId typeId = typeDesc.typeId;
+
+		if (typeId == sgeTypeId(int)) {
+			return serializedKind_int;
+		}
+		else if (typeId == sgeTypeId(unsigned)) {
+			return serializedKind_unsigned;
+		}
+		else if (typeId == sgeTypeId(float)) {
+			return serializedKind_float;
+		}
+		else if (typeId == sgeTypeId(char)) {
+			return serializedKind_char;
+		}
+		else if (typeId == sgeTypeId(bool)) {
+			return serializedKind_bool;
+		}
+		else if (typeId == sgeTypeId(std::string)) {
+			return serializedKind_string;
+		}
+		else if (typeId == sgeTypeId(transf3d)) {
+			return serializedKind_transf3d;
+		}
+		else if (typeId == sgeTypeId(AssetPtr)) {
+			return serializedKind_assetPtr;
+		}
+		else if (typeId == sgeTypeId(std::shared_ptr<AssetIface_Material>)) {
+			return serializedKind_assetIfaceMaterial;
+		}
+		else if (typeId == sgeTypeId(std::shared_ptr<AssetIface_Model3D>)) {
+			return serializedKind_assetIfaceModel3D;
+		}
+		else if (typeId == sgeTypeId(std::shared_ptr<AssetIface_Texture2D>)) {
+			return serializedKind_assetIfaceTexture2D;
+		}
+		else if (typeDesc.stdVectorUnderlayingType.isValid()) {
+			return serializedKind_stdVector;
+		}
+		else if (typeDesc.stdMapKeyType.isValid() && typeDesc.stdMapValueType.isValid()) {
+			return serializedKind_stdMap;
+		}
+		else if (typeDesc.members.empty() == false) {
+			return serializedKind_struct;
+		}
+
+		return serializedKind_unknown;
+	}
+
+	const SerializationPlan* buildPlan(const TypeDesc* const typeDesc, SerializationPlansCache& cache)
+	{
+		if (typeDesc == nullptr) {
+			return nullptr;
+		}
+
+		auto itr = cache.plans.find(typeDesc);
+		if (itr != cache.plans.end()) {
+			return itr->second.get();
+		}
+
+		// Add the plan to the cache before resolving the members as the type could contain itself (in a std::vector).
+		SerializationPlan& plan = *cache.plans.emplace(typeDesc, std::make_unique<SerializationPlan>()).first->second;
+		plan.typeDesc = typeDesc;
+
+		if (typeDesc->enumUnderlayingType.isValid()) {
+			// Enums are saved as their underlying type.
+			const TypeDesc* const underlyingTypeDesc = typeLib().find(typeDesc->enumUnderlayingType);
+			plan.kind = underlyingTypeDesc ? findSerializedKind(*underlyingTypeDesc) : serializedKind_unknown;
+			if (isSerializedKindPrimitive(plan.kind) == false) {
+				sgeLogError("[SERIALIZATION] Unsupported underlying type of the enum %s\n", typeDesc->name);
+				plan.kind = serializedKind_unknown;
+			}
+			return &plan;
+		}
+
+		plan.kind = findSerializedKind(*typeDesc);
+
+		if (plan.kind == serializedKind_stdVector) {
+			plan.elementPlan = buildPlan(typeLib().find(typeDesc->stdVectorUnderlayingType), cache);
+			if (plan.elementPlan == nullptr) {
+				sgeLogError("[SERIALIZATION] Found a std::vector of unregistered elements - %s\n", typeDesc->name);
+				plan.kind = serializedKind_unknown;
+			}
+		}
+		else if (plan.kind == serializedKind_stdMap) {
+			plan.elementPlan = buildPlan(typeLib().find(typeDesc->stdMapKeyType), cache);
+			plan.mapValuePlan = buildPlan(typeLib().find(typeDesc->stdMapValueType), cache);
+			if (plan.elementPlan == nullptr || plan.mapValuePlan == nullptr) {
+				sgeLogError("[SERIALIZATION] Found a std::map of unregistered types - %s\n", typeDesc->name);
+				plan.kind = serializedKind_unknown;
+			}
+		}
+		else if (plan.kind == serializedKind_struct || plan.kind == serializedKind_transf3d) {
+			// transf3d is a struct that gets saved in a special way, but its members are still needed.
+			plan.members.reserve(typeDesc->members.size());
+			for (const MemberDesc& mfd : typeDesc->members) {
+				if (mfd.isSaveable() == false) {
+					continue;
+				}
+
+				const TypeDesc* const memberTypeDesc = mfd.getTypeDesc();
+				if (memberTypeDesc == nullptr) {
+					sgeLogError(
+					    "[SERIALIZATION] Found a member without a TypeDesc - %s::%s\n", typeDesc->name, mfd.name);
+					continue;
+				}
+
+				if (mfd.byteOffset < 0 && mfd.getDataFn == nullptr) {
+					continue;
+				}
+
+				SerializationPlan::Member member;
+				member.memberDesc = &mfd;
+				member.plan = buildPlan(memberTypeDesc, cache);
+				if (member.plan->kind == serializedKind_unknown) {
+					sgeLogError(
+					    "[SERIALIZATION] The type of %s::%s cannot be saved, the member is skipped.\n",
+					    typeDesc->name,
+					    mfd.name);
+					continue;
+				}
+
+				plan.members.push_back(member);
+			}
+		}
+
+		return &plan;
+	}
+} // namespace
+
+const SerializationPlan* getSerializationPlan(const TypeDesc* typeDesc)
+{
+	if (typeDesc == nullptr) {
+		return nullptr;
+	}
+
+	SerializationPlansCache& cache = getPlansCache();
+
+	// The plans point to the TypeDescs and their MemberDescs, which change when the types get registered again.
+	if (cache.registrationVersion != typeLib().registrationVersion) {
+		cache.plans.clear();
+		cache.registrationVersion = typeLib().registrationVersion;
+	}
+
+	return buildPlan(typeDesc, cache);
+}
+
+} // namespace sge
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "sge_engine_api.h"
+#include <vector>
+
+namespace sge {
+
+struct TypeDesc;
+struct MemberDesc;
+
+/// Describes how values of a type are stored by the game serialization (see GameSerialization.h).
+/// Enums use the kind of their underlying type.
+enum SerializedKind : unsigned char {
+	serializedKind_unknown = 0,
+	serializedKind_int,
+	serializedKind_unsigned,
+	serializedKind_float,
+	serializedKind_char,
+	serializedKind_bool,
+	serializedKind_string,
+	serializedKind_transf3d,
+	serializedKind_assetPtr,
+	serializedKind_assetIfaceMaterial,
+	serializedKind_assetIfaceModel3D,
+	serializedKind_assetIfaceTexture2D,
+	serializedKind_stdVector,
+	serializedKind_stdMap,
+	serializedKind_struct,
+
+	serializedKind_count,
+};
+
+/// Returns true if values of that kind are stored as a fixed number of bytes copied from memory.
+inline bool isSerializedKindPrimitive(const SerializedKind kind)
+{
+	return kind == serializedKind_int || kind == serializedKind_unsigned || kind == serializedKind_float ||
+	       kind == serializedKind_char || kind == serializedKind_bool;
+}
+
+/// SerializationPlan is the reflection of a type, flattened for the serialization.
+/// Walking the TypeDesc directly means finding the TypeDesc of every member (and of every element of a std::vector)
+/// for every serialized value. The plan resolves all of that once per type, the serialization just follows the
+/// pointers.
+struct SerializationPlan {
+	struct Member {
+		const MemberDesc* memberDesc = nullptr;
+		const SerializationPlan* plan = nullptr;
+	};
+
+	const TypeDesc* typeDesc = nullptr;
+	SerializedKind kind = serializedKind_unknown;
+
+	/// The plan of the elements for std::vector, the plan of the keys for std::map.
+	const SerializationPlan* elementPlan = nullptr;
+	/// The plan of the values for std::map.
+	const SerializationPlan* mapValuePlan = nullptr;
+
+	/// The members of structs and transf3d that get saved: the ones without MFF_NonSaveable with a supported type.
+	std::vector<Member> members;
+};
+
+/// Returns the serialization plan of the specified type. The plans are built on the first use and are rebuilt
+/// when the registered types change (see TypeLib::registrationVersion).
+/// Like the type library itself the function isn't thread-safe.
+/// @retval nullptr if @typeDesc is nullptr, otherwise a plan (with serializedKind_unknown for unsupported types).
+SGE_ENGINE_API const SerializationPlan* getSerializationPlan(const TypeDesc* typeDesc);
+
+} // namespace sge
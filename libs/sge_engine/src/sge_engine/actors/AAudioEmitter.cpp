@@ -0,0 +1,100 @@
+#include "AAudioEmitter.h"
+#include "sge_core/AssetLibrary/AssetAudio.h"
+#include "sge_core/ICore.h"
+#include "sge_engine/EngineGlobal.h"
+#include "sge_engine/GameWorld.h"
+
+namespace sge {
+
+// clang-format off
+ReflAddTypeId(AudioAttenuationCurve, 26'10'17'0002);
+ReflAddTypeId(AAudioEmitter, 26'10'17'0003);
+
+ReflBlock() {
+	ReflAddType(AudioAttenuationCurve)
+		ReflEnumVal(audioAttenuationCurve_inverse, "Inverse")
+		ReflEnumVal(audioAttenuationCurve_linear, "Linear")
+		ReflEnumVal(audioAttenuationCurve_none, "None")
+	;
+
+	ReflAddActor(AAudioEmitter)
+		ReflMember(AAudioEmitter, m_audioAsset)
+		ReflMember(AAudioEmitter, m_volume).uiRange(0.f, 1.f, 0.01f)
+		ReflMember(AAudioEmitter, m_isLooping)
+		ReflMember(AAudioEmitter, m_priority)
+		ReflMember(AAudioEmitter, m_minDistance).uiRange(0.f, 10000.f, 0.1f)
+		ReflMember(AAudioEmitter, m_maxDistance).uiRange(0.f, 10000.f, 0.1f)
+		ReflMember(AAudioEmitter, m_attenuation)
+		ReflMember(AAudioEmitter, m_dopplerFactor).uiRange(0.f, 10.f, 0.01f)
+	;
+}
+// clang-format on
+
+void AAudioEmitter::create()
+{
+	registerTrait(ttViewportIcon);
+	ttViewportIcon.setTexture(
+	    getEngineGlobal()->getEngineAssets().getIconForObjectType(sgeTypeId(AAudioEmitter)), true);
+}
+
+void AAudioEmitter::update(const GameUpdateSets& updateSets)
+{
+	if (m_audioAsset.update()) {
+		IAssetInterface_Audio* const audioIface = m_audioAsset.getAssetInterface<IAssetInterface_Audio>();
+		AudioDataPtr audioData = audioIface ? audioIface->getAudioData() : nullptr;
+		m_decoder.createDecoder(audioData);
+		m_hasStarted = false;
+	}
+
+	AudioDevice* const audioDevice = getCore()->getAudioDevice();
+	if (audioDevice == nullptr || m_decoder.audioData == nullptr) {
+		return;
+	}
+
+	// While paused the sound is stopped, it continues from the same place when the game continues.
+	if (updateSets.isSimulationPaused()) {
+		if (m_decoder.isPlaying()) {
+			audioDevice->stop(&m_decoder);
+			m_hasStarted = false;
+		}
+		return;
+	}
+
+	const vec3f position = getPosition();
+
+	AudioDecoder::State& state = m_decoder.state;
+	state.isLooping = m_isLooping;
+	state.volume = m_volume;
+	state.priority = m_priority;
+	state.is3D = true;
+	state.position = position;
+	state.velocity = (m_hasStarted && updateSets.dt > 0.f) ? (position - m_lastPosition) / updateSets.dt : vec3f(0.f);
+	state.minDistance = m_minDistance;
+	state.maxDistance = m_maxDistance;
+	state.attenuation = m_attenuation;
+	state.dopplerFactor = m_dopplerFactor;
+
+	m_lastPosition = position;
+
+	if (!m_hasStarted) {
+		audioDevice->play(&m_decoder, false);
+		m_hasStarted = true;
+	}
+}
+
+void AAudioEmitter::onPlayStateChanged(bool const isStartingToPlay)
+{
+	Actor::onPlayStateChanged(isStartingToPlay);
+
+	// The sound is heard only while the emitter is part of the playing world.
+	if (AudioDevice* const audioDevice = getCore()->getAudioDevice()) {
+		audioDevice->stop(&m_decoder);
+	}
+
+	if (isStartingToPlay) {
+		m_decoder.seekToBegining();
+		m_hasStarted = false;
+	}
+}
+
+} // namespace sge
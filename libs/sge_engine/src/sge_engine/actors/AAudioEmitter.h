@@ -0,0 +1,47 @@
+#pragma once
+
+#include "sge_audio/AudioDevice.h"
+#include "sge_engine/Actor.h"
+#include "sge_engine/traits/TraitViewportIcon.h"
+
+namespace sge {
+
+/// AAudioEmitter plays an audio asset as a 3D sound at its position, while the game is playing.
+/// Parent it to other actors to make them emit the sound. The listener is the game camera (see SceneInstance::update).
+struct SGE_ENGINE_API AAudioEmitter : public Actor {
+	AAudioEmitter()
+	    : m_audioAsset(assetIface_audio)
+	{
+	}
+
+	Box3f getBBoxOS() const override { return Box3f(); }
+
+	void create() override;
+	void update(const GameUpdateSets& updateSets) override;
+	void onPlayStateChanged(bool const isStartingToPlay) override;
+
+	bool isPlaying() const { return m_decoder.isPlaying(); }
+
+  public:
+	TraitViewportIcon ttViewportIcon;
+
+	AssetProperty m_audioAsset;
+	float m_volume = 1.f;
+	bool m_isLooping = true;
+	/// See AudioDecoder::State::priority.
+	int m_priority = 0;
+
+	float m_minDistance = 1.f;
+	float m_maxDistance = 50.f;
+	AudioAttenuationCurve m_attenuation = audioAttenuationCurve_inverse;
+	float m_dopplerFactor = 1.f;
+
+  private:
+	AudioDecoder m_decoder;
+	/// True if the sound has been started since the game started or continued playing, one-shots are played once.
+	bool m_hasStarted = false;
+	/// The position in the previous update, used to compute the velocity for the doppler effect.
+	vec3f m_lastPosition = vec3f(0.f);
+};
+
+} // namespace sge
@@ -48,8 +48,11 @@ void ABlockingObstacle::onPlayStateChanged(bool const isStartingToPlay)
 	}
 }
 
-void ABlockingObstacle::update(const GameUpdateSets& UNUSED(u))
+void ABlockingObstacle::postUpdate(const GameUpdateSets& UNUSED(updateSets))
 {
+	m_textureX.update();
+	m_textureY.update();
+
 	material = SimpleTriplanarMtlData();
 
 	material.diffuseTextureX = m_textureX.getAssetInterface<AssetIface_Texture2D>()
@@ -62,12 +65,6 @@ void ABlockingObstacle::update(const GameUpdateSets& UNUSED(u))
 
 	material.uvwTransform = mat4f::getScaling(m_textureXScale, m_textureYScale, m_textureXScale);
 	material.sharpness = 64.f;
-}
-
-void ABlockingObstacle::postUpdate(const GameUpdateSets& UNUSED(updateSets))
-{
-	m_textureX.update();
-	m_textureY.update();
 
 	// Check if the description of the obstacle has changed.
 	// If so update the object,
@@ -77,6 +77,7 @@ void ACRSpline::onMemberChanged()
 {
 	makeDirty();
 	computeSegmentsLength();
+	markBBoxDirty();
 }
 
 bool ACRSpline::evalute(vec3f* outPosition, vec3f* outTanget, float t)
@@ -69,9 +69,5 @@ Box3f ALight::getBBoxOS() const
 	}
 }
 
-void ALight::update(const GameUpdateSets& UNUSED(updateSets))
-{
-}
-
 
 } // namespace sge
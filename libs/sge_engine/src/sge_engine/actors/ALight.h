@@ -13,7 +13,6 @@ struct SGE_ENGINE_API ALight : public Actor {
 
 	void create() final;
 	Box3f getBBoxOS() const final;
-	void update(const GameUpdateSets& updateSets) final;
 	const LightDesc& getLightDesc() const { return m_lightDesc; }
 
 	/// Get the light forward direction. This is the -Z axis.
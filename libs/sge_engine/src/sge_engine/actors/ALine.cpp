@@ -82,6 +82,7 @@ Box3f ALine::getBBoxOS() const
 void ALine::onMemberChanged()
 {
 	makeDirty();
+	markBBoxDirty();
 }
 
 void ALine::computeSegmentsLength()
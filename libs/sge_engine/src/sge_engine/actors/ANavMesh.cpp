@@ -15,6 +15,8 @@
 
 #include "sge_engine_ui/windows/PropertyEditorWindow.h"
 
+#include <algorithm>
+
 namespace sge {
 
 struct ABlockingObstacle;
@@ -33,11 +35,16 @@ ReflBlock() {
 		ReflMemberNamed(NavMeshBuildSets, minRoomHeight, "minRoomHeight").uiRange(0.f, 1000.f, 0.001f)
 		ReflMemberNamed(NavMeshBuildSets, agentRadius, "agentRadius").uiRange(0.f, 1000.f, 0.001f)
 		ReflMemberNamed(NavMeshBuildSets, agentHeight, "agentHeight").uiRange(0.f, 1000.f, 0.001f)
+		ReflMemberNamed(NavMeshBuildSets, useTiles, "useTiles")
+		ReflMemberNamed(NavMeshBuildSets, tileSize, "tileSize").uiRange(1.f, 10000.f, 0.1f)
 	;
 
 	ReflAddActor(ANavMesh)
 		ReflMemberNamed(ANavMesh, m_buildSettings, "buildSettings")
 		ReflMember(ANavMesh, m_typesToUse)
+		ReflMember(ANavMesh, m_maxCrowdAgents).uiRange(1, 100000, 1.f)
+		ReflMember(ANavMesh, m_maxCrowdAgentRadius).uiRange(0.01f, 1000.f, 0.01f)
+		ReflMember(ANavMesh, m_pathQueriesBudgetMs).uiRange(0.01f, 1000.f, 0.01f)
 	;
 
 }
@@ -60,6 +67,20 @@ void ANavMesh::create()
 		build();
 		onWorldLoadedCBHandle.unsubscribe();
 	});
+
+	m_onRigidBodyChangedSub =
+	    GameObject::getWorld()->physicsWorld.onRigidBodyChanged.subscribe([this](const RigidBody* rigidBody) {
+		    // Only the tiled nav mesh gets updated, the other one is always fully rebuilt.
+		    if (m_buildSettings.useTiles == false || m_tiledNavMeshBuilder.isCreated() == false ||
+		        rigidBody->actor == nullptr) {
+			    return;
+		    }
+
+		    const TypeId actorType = rigidBody->actor->getType();
+		    if (std::find(m_typesToUse.begin(), m_typesToUse.end(), actorType) != m_typesToUse.end()) {
+			    m_changedRigidBodies.push_back(rigidBody->actor->getId());
+		    }
+	    });
 }
 
 Box3f ANavMesh::getBBoxOS() const
@@ -91,72 +112,14 @@ bool ANavMesh::findPath(
     const vec3f& targetEndPos,
     const vec3f nearestPointSearchHalfDiagonal)
 {
-	const int kMaxPathPolyCount = 256; // TODO: Fine tune this variable.
-
-	outPath.clear();
-
 	if (m_detourNavMeshQuery.object == nullptr || m_detourNavMeshQuery->getNodePool() == nullptr) {
 		// The navmesh isn't initialzied yet or no navmesh was generated for the input geometry.
+		outPath.clear();
 		return false;
 	}
 
-	dtQueryFilter queryPolyFilter;
-
-	dtPolyRef startPolyRef = 0;
-	m_detourNavMeshQuery->findNearestPoly(
-	    startPos.data, nearestPointSearchHalfDiagonal.data, &queryPolyFilter, &startPolyRef, 0);
-
-	dtPolyRef endPolyRef = 0;
-	m_detourNavMeshQuery->findNearestPoly(
-	    targetEndPos.data, nearestPointSearchHalfDiagonal.data, &queryPolyFilter, &endPolyRef, 0);
-
-	if (startPolyRef == 0 || endPolyRef == 0) {
-		return false; // No path could be found.
-	}
-
-	dtPolyRef polygonsAlongPath[kMaxPathPolyCount];
-	int numPolygonsAlongPath = 0;
-	m_detourNavMeshQuery->findPath(
-	    startPolyRef,
-	    endPolyRef,
-	    startPos.data,
-	    targetEndPos.data,
-	    &queryPolyFilter,
-	    polygonsAlongPath,
-	    &numPolygonsAlongPath,
-	    SGE_ARRSZ(polygonsAlongPath));
-
-	if (numPolygonsAlongPath > 0) {
-		outPath.resize(kMaxPathPolyCount);
-		// In case of partial path, make sure the end point is clamped to the last polygon.
-		// Partial path means that the points isn't reachable, but the library generated a path which
-		// takes you closer to the end point.
-		vec3f acutualEndPos = targetEndPos;
-		if (polygonsAlongPath[numPolygonsAlongPath - 1] != endPolyRef) {
-			m_detourNavMeshQuery->closestPointOnPoly(
-			    polygonsAlongPath[numPolygonsAlongPath - 1], targetEndPos.data, acutualEndPos.data, 0);
-		}
-
-		int numPointsInPath = 0;
-		const int streightPathOptions = 0;
-		unsigned char straightPathFlags[kMaxPathPolyCount];
-		m_detourNavMeshQuery->findStraightPath(
-		    startPos.data,
-		    acutualEndPos.data,
-		    polygonsAlongPath,
-		    numPolygonsAlongPath,
-		    (float*)outPath.data(),
-		    straightPathFlags,
-		    nullptr,
-		    &numPointsInPath,
-		    kMaxPathPolyCount,
-		    streightPathOptions);
-
-		outPath.resize(numPointsInPath);
-		return true;
-	}
-
-	return false;
+	return findNavMeshPath(
+	    *m_detourNavMeshQuery.object, outPath, startPos, targetEndPos, nearestPointSearchHalfDiagonal);
 }
 
 vec3f ANavMesh::moveAlongNavMesh(const vec3f& start, const vec3f& end)
@@ -200,15 +163,74 @@ vec3f ANavMesh::moveAlongNavMesh(const vec3f& start, const vec3f& end)
 }
 
 
-void ANavMesh::update(const GameUpdateSets& UNUSED(updateSets))
+void ANavMesh::update(const GameUpdateSets& updateSets)
 {
+	if (m_buildSettings.useTiles && m_tiledNavMeshBuilder.isCreated()) {
+		// Swap in the tiles that were built in the background.
+		if (m_tiledNavMeshBuilder.tryFinishBuildingTiles()) {
+			getNavMeshDebugTriangles(*m_detourNavMesh.object, m_debugDrawNavMeshTriListWs);
+		}
+
+		std::sort(m_changedRigidBodies.begin(), m_changedRigidBodies.end());
+		m_changedRigidBodies.erase(
+		    std::unique(m_changedRigidBodies.begin(), m_changedRigidBodies.end()), m_changedRigidBodies.end());
+		for (const ObjectId actorId : m_changedRigidBodies) {
+			updateTrackedRigidBody(actorId);
+		}
+		m_changedRigidBodies.clear();
+
+		// If there are tiles still being built the changes will get picked the next time.
+		if (m_dirtyAreasWs.empty() == false && m_tiledNavMeshBuilder.isBuildingTiles() == false) {
+			startRebuildingDirtyTiles();
+		}
+	}
+
+	// The nav mesh must not change while the navigation is updated, the tiles get swapped above.
+	if (updateSets.isSimulationPaused() == false) {
+		m_navigationService.setPathQueriesBudgetMs(m_pathQueriesBudgetMs);
+		m_navigationService.update(updateSets.dt, GameObject::getWorld()->getUpdateThreadPool());
+	}
 }
 
-void ANavMesh::build()
+namespace {
+	/// Appends the triangles of the rigid body of the specified game object, if it has one.
+	void appendRigidBodyTriangles(const GameObject* const object, NavMeshInputGeometry& outGeometry)
+	{
+		const TraitRigidBody* const traitRb = getTrait<TraitRigidBody>(object);
+		if (traitRb != nullptr && traitRb->getRigidBody()->isValid()) {
+			const btTransform bodyWorldTransform = traitRb->m_rigidBody.getBulletRigidBody()->getWorldTransform();
+			const btCollisionShape* const shape = traitRb->m_rigidBody.getBulletRigidBody()->getCollisionShape();
+			bulletCollisionShapeToTriangles(shape, bodyWorldTransform, outGeometry.vertices, outGeometry.indices);
+		}
+	}
+} // namespace
+
+void ANavMesh::gatherInputGeometry(NavMeshInputGeometry& outGeometry, const std::vector<int>* tilesToBuild)
 {
-	// Generate triangles representing each object that could be used as a walkable area by the navmesh.
-	std::vector<vec3f> trianglesVerticesWorldSpace;
-	std::vector<int> trianglesIndices;
+	outGeometry.vertices.clear();
+	outGeometry.indices.clear();
+
+	if (tilesToBuild != nullptr) {
+		// Only the rigid bodies overlapping the tiles matter, the tracked bounding boxes are up to date.
+		std::vector<bool> isTileToBuild(m_tiledNavMeshBuilder.getNumTiles(), false);
+		for (const int iTile : *tilesToBuild) {
+			isTileToBuild[iTile] = true;
+		}
+
+		std::vector<int> bodyTiles;
+		for (const auto& trackedRigidBody : m_trackedRigidBodies) {
+			bodyTiles.clear();
+			m_tiledNavMeshBuilder.findTilesOverlapping(trackedRigidBody.second, bodyTiles);
+
+			const bool overlapsTileToBuild =
+			    std::any_of(bodyTiles.begin(), bodyTiles.end(), [&](int iTile) { return isTileToBuild[iTile]; });
+			if (overlapsTileToBuild) {
+				appendRigidBodyTriangles(GameObject::getWorld()->getActorById(trackedRigidBody.first), outGeometry);
+			}
+		}
+
+		return;
+	}
 
 	for (const TypeId actorType : m_typesToUse) {
 		const std::vector<GameObject*>* pAllObjsOfType = GameObject::getWorld()->getObjects(actorType);
@@ -216,279 +238,158 @@ void ANavMesh::build()
 			continue;
 		}
 
-		for (const GameObject* const object : *GameObject::getWorld()->getObjects(actorType)) {
-			const TraitRigidBody* const traitRb = getTrait<TraitRigidBody>(object);
-			if (traitRb != nullptr && traitRb->getRigidBody()->isValid()) {
-				const btTransform bodyWorldTransform = traitRb->m_rigidBody.getBulletRigidBody()->getWorldTransform();
-				const btCollisionShape* const shape = traitRb->m_rigidBody.getBulletRigidBody()->getCollisionShape();
-				bulletCollisionShapeToTriangles(
-				    shape, bodyWorldTransform, trianglesVerticesWorldSpace, trianglesIndices);
-			}
+		for (const GameObject* const object : *pAllObjsOfType) {
+			appendRigidBodyTriangles(object, outGeometry);
 		}
 	}
+}
 
-	const int numTriangles = int(trianglesIndices.size()) / 3;
-
-	if (numTriangles == 0) {
-		sgeLogWarn("NavMesh did not find any triangles to be used for building the navmesh!");
+void ANavMesh::updateTrackedRigidBody(const ObjectId actorId)
+{
+	const Actor* const actor = GameObject::getWorld()->getActorById(actorId);
+	const TraitRigidBody* const traitRb = getTrait<TraitRigidBody>(actor);
+	const bool hasRigidBody = traitRb != nullptr && traitRb->getRigidBody()->isValid();
+
+	auto itrTracked = m_trackedRigidBodies.find(actorId);
+	if (hasRigidBody == false) {
+		// The rigid body has been removed.
+		if (itrTracked != m_trackedRigidBodies.end()) {
+			m_dirtyAreasWs.push_back(itrTracked->second);
+			m_trackedRigidBodies.erase(itrTracked);
+		}
 		return;
 	}
 
-	// Generate the navmesh itself.
-	rcConfig recastCfg;
-
-	memset(&recastCfg, 0, sizeof(recastCfg));
-	recastCfg.cs = m_buildSettings.cellXZSize;
-	recastCfg.ch = m_buildSettings.cellYSize;
-	recastCfg.walkableSlopeAngle = rad2deg(m_buildSettings.climbableSlopeAngle);
-	recastCfg.walkableHeight = (int)ceilf(m_buildSettings.minRoomHeight / recastCfg.ch);
-	recastCfg.walkableClimb = (int)floorf(m_buildSettings.cimbableStairHeight / recastCfg.ch);
-	recastCfg.walkableRadius = (int)ceilf(m_buildSettings.agentRadius / recastCfg.cs);
-	recastCfg.maxEdgeLen = (int)(m_buildSettings.polygonsMaxEdgeLength / recastCfg.cs); // Why does this exists?
-	recastCfg.maxSimplificationError = 1.3f;                                            // What is a good default?
-	recastCfg.minRegionArea = (int)rcSqr(8);                          // Note: area = size*size // WTF is this?
-	recastCfg.mergeRegionArea = (int)rcSqr(20);                       // Note: area = size*size // WTF is this?
-	recastCfg.maxVertsPerPoly = (int)6;                               // Why does this exists?
-	recastCfg.detailSampleDist = 6.f < 0.9f ? 0 : recastCfg.cs * 6.f; // WTF is this?
-	recastCfg.detailSampleMaxError = 1.f;                             // WTF is this?
+	btVector3 aabbMin;
+	btVector3 aabbMax;
+	traitRb->m_rigidBody.getBulletRigidBody()->getAabb(aabbMin, aabbMax);
+	const Box3f bboxWs(fromBullet(aabbMin), fromBullet(aabbMax));
 
-	// Set the area where the navigation will be build.
-	// Here the bounds of the input mesh are used, but the
-	// area could be specified by an user defined box, etc.
-	Box3f navMeshBBox = getBBoxOS().getTransformed(getTransformMtx());
-
-	recastCfg.bmin[0] = navMeshBBox.min.x;
-	recastCfg.bmin[1] = navMeshBBox.min.y;
-	recastCfg.bmin[2] = navMeshBBox.min.z;
-
-	recastCfg.bmax[0] = navMeshBBox.max.x;
-	recastCfg.bmax[1] = navMeshBBox.max.y;
-	recastCfg.bmax[2] = navMeshBBox.max.z;
-
-	rcCalcGridSize(recastCfg.bmin, recastCfg.bmax, recastCfg.cs, &recastCfg.width, &recastCfg.height);
-	rcHeightfieldWrapper recastHeightFiled;
-	rcContext recastLogging = rcContext(false);
-
-	if (!rcCreateHeightfield(
-	        &recastLogging,
-	        recastHeightFiled.ref(),
-	        recastCfg.width,
-	        recastCfg.height,
-	        recastCfg.bmin,
-	        recastCfg.bmax,
-	        recastCfg.cs,
-	        recastCfg.ch)) {
-		sgeAssert(false && "rcCreateHeightfield failed!");
-		clearRecastAndDetourState();
-		return;
+	if (itrTracked == m_trackedRigidBodies.end()) {
+		// A new rigid body.
+		m_dirtyAreasWs.push_back(bboxWs);
+		m_trackedRigidBodies[actorId] = bboxWs;
 	}
-
-	// Mark all walkable triangles.
-	std::vector<unsigned char> recastPerTriangleFlags(numTriangles, 0);
-	rcMarkWalkableTriangles(
-	    &recastLogging,
-	    recastCfg.walkableSlopeAngle,
-	    (float*)trianglesVerticesWorldSpace.data(),
-	    int(trianglesVerticesWorldSpace.size()),
-	    trianglesIndices.data(),
-	    numTriangles,
-	    recastPerTriangleFlags.data());
-
-	// Voxelize the triangles.
-	if (!rcRasterizeTriangles(
-	        &recastLogging,
-	        (float*)trianglesVerticesWorldSpace.data(),
-	        int(trianglesVerticesWorldSpace.size()),
-	        trianglesIndices.data(),
-	        recastPerTriangleFlags.data(),
-	        numTriangles,
-	        recastHeightFiled.ref(),
-	        recastCfg.walkableClimb)) {
-		sgeAssert(false && "rcRasterizeTriangles failed!");
-		clearRecastAndDetourState();
-		return;
+	else if (itrTracked->second != bboxWs) {
+		// The rigid body has moved (or changed its shape), both the old and the new areas are affected.
+		m_dirtyAreasWs.push_back(itrTracked->second);
+		m_dirtyAreasWs.push_back(bboxWs);
+		itrTracked->second = bboxWs;
 	}
+}
 
-	// Filter walkables surfaces.
-	// Once all geoemtry is rasterized, we do initial pass of filtering to
-	// remove unwanted overhangs caused by the conservative rasterization
-	// as well as filter spans where the character cannot possibly stand.
-	rcFilterLowHangingWalkableObstacles(&recastLogging, recastCfg.walkableClimb, recastHeightFiled.ref());
-	rcFilterLedgeSpans(&recastLogging, recastCfg.walkableHeight, recastCfg.walkableClimb, recastHeightFiled.ref());
-	rcFilterWalkableLowHeightSpans(&recastLogging, recastCfg.walkableHeight, recastHeightFiled.ref());
-
-	rcCompactHeightfieldWrapper compactHeightField;
-	if (!rcBuildCompactHeightfield(
-	        &recastLogging,
-	        recastCfg.walkableHeight,
-	        recastCfg.walkableClimb,
-	        recastHeightFiled.ref(),
-	        compactHeightField.ref())) {
-		sgeAssert(false && "rcBuildCompactHeightfield failed!");
-		clearRecastAndDetourState();
-		return;
+void ANavMesh::startRebuildingDirtyTiles()
+{
+	std::vector<int> dirtyTiles;
+	for (const Box3f& dirtyAreaWs : m_dirtyAreasWs) {
+		m_tiledNavMeshBuilder.findTilesOverlapping(dirtyAreaWs, dirtyTiles);
 	}
+	m_dirtyAreasWs.clear();
 
-	// Clean-up the height field as we aren't going to use it anymore.
-	recastHeightFiled.freeExisting();
+	std::sort(dirtyTiles.begin(), dirtyTiles.end());
+	dirtyTiles.erase(std::unique(dirtyTiles.begin(), dirtyTiles.end()), dirtyTiles.end());
 
-	if (!rcErodeWalkableArea(&recastLogging, recastCfg.walkableRadius, compactHeightField.ref())) {
-		sgeAssert(false && "rcErodeWalkableArea failed!");
-		clearRecastAndDetourState();
+	if (dirtyTiles.empty()) {
 		return;
 	}
 
-	// Here I've skipped a step where we mark different area types
+	// The triangles are generated here, as the rigid bodies cannot be accessed from the worker threads.
+	// Only the rigid bodies overlapping the dirty tiles are used, as only these tiles will get voxelized.
+	NavMeshInputGeometry geometry;
+	gatherInputGeometry(geometry, &dirtyTiles);
+	setDebugDrawBuildTriangles(geometry);
 
-	// Partition the walkable surface into simple regions without holes.
-	if (!rcBuildDistanceField(&recastLogging, compactHeightField.ref())) {
-		sgeAssert(false && "rcBuildDistanceField failed!");
-		clearRecastAndDetourState();
-		return;
-	}
+	m_tiledNavMeshBuilder.setGeometry(std::move(geometry), &dirtyTiles);
+	m_tiledNavMeshBuilder.startBuildingTiles(dirtyTiles, getBuildThreadPool());
+}
 
-	if (!rcBuildRegions(
-	        &recastLogging, compactHeightField.ref(), 0, recastCfg.minRegionArea, recastCfg.mergeRegionArea)) {
-		sgeAssert(false && "rcBuildRegions failed!");
-		clearRecastAndDetourState();
-		return;
+ThreadPool* ANavMesh::getBuildThreadPool()
+{
+	if (m_buildThreadPool.isCreated() == false) {
+		m_buildThreadPool.create(std::max(2, ThreadPool::getHardwareConcurrency()));
 	}
 
-	rcContourSetWrapper contourSet;
-	if (!rcBuildContours(
-	        &recastLogging,
-	        compactHeightField.ref(),
-	        recastCfg.maxSimplificationError,
-	        recastCfg.maxEdgeLen,
-	        contourSet.ref())) {
-		sgeAssert(false && "rcBuildContours failed!");
-		clearRecastAndDetourState();
-		return;
-	}
+	return &m_buildThreadPool;
+}
 
-	// Build the recast poly mesh.
-	m_recastPolyMesh.createNew();
-	if (!rcBuildPolyMesh(&recastLogging, contourSet.ref(), recastCfg.maxVertsPerPoly, m_recastPolyMesh.ref())) {
-		sgeAssert(false && "rcBuildPolyMesh failed!");
-		clearRecastAndDetourState();
-		return;
+void ANavMesh::setDebugDrawBuildTriangles(const NavMeshInputGeometry& geometry)
+{
+	m_debugDrawNavMeshBuildTriListWs.clear();
+	for (const int iVertex : geometry.indices) {
+		m_debugDrawNavMeshBuildTriListWs.push_back(geometry.vertices[iVertex]);
 	}
+}
+
+void ANavMesh::build()
+{
+	// Drop any tiles that are being built as they are going to be replaced.
+	m_tiledNavMeshBuilder.destroy();
+
+	// Generate triangles representing each object that could be used as a walkable area by the navmesh.
+	NavMeshInputGeometry geometry;
+	gatherInputGeometry(geometry);
 
-	rcPolyMeshDetailWrapper recastDetailMesh;
-	if (!rcBuildPolyMeshDetail(
-	        &recastLogging,
-	        m_recastPolyMesh.ref(),
-	        compactHeightField.ref(),
-	        recastCfg.detailSampleDist,
-	        recastCfg.detailSampleMaxError,
-	        recastDetailMesh.ref())) {
-		sgeAssert(false && "rcBuildPolyMeshDetail failed");
-		clearRecastAndDetourState();
+	if (geometry.getNumTriangles() == 0) {
+		sgeLogWarn("NavMesh did not find any triangles to be used for building the navmesh!");
 		return;
 	}
 
-	// Mark all resulting polygons as walkable
-	for (int iPoly = 0; iPoly < m_recastPolyMesh->npolys; ++iPoly) {
-		m_recastPolyMesh->areas[iPoly] = RC_WALKABLE_AREA;
-		m_recastPolyMesh->flags[iPoly] = 1;
+	// Remember the rigid bodies used for this build, so we could find the areas affected when they change.
+	m_trackedRigidBodies.clear();
+	m_changedRigidBodies.clear();
+	for (const TypeId actorType : m_typesToUse) {
+		if (const std::vector<GameObject*>* pAllObjsOfType = GameObject::getWorld()->getObjects(actorType)) {
+			for (const GameObject* const object : *pAllObjsOfType) {
+				updateTrackedRigidBody(object->getId());
+			}
+		}
 	}
+	m_dirtyAreasWs.clear();
 
-	if (m_recastPolyMesh->npolys == 0) {
-		// No geomety has been found, there will be no navmesh.
-		clearRecastAndDetourState();
-		return;
-	}
+	// Set the area where the navigation will be build.
+	// Here the bounds of the input mesh are used, but the
+	// area could be specified by an user defined box, etc.
+	const Box3f navMeshBBox = getBBoxOS().getTransformed(getTransformMtx());
 
-	// Build the path-finding mesh for Detour.
-	if (recastCfg.maxVertsPerPoly > DT_VERTS_PER_POLYGON) {
-		// Should never happen.
-		sgeAssert(false && "recastCfg.maxVertsPerPoly > DT_VERTS_PER_POLYGON failed");
-		clearRecastAndDetourState();
-		return;
+	if (m_buildSettings.useTiles) {
+		m_detourNavMesh.createNew();
+		if (m_tiledNavMeshBuilder.create(m_detourNavMesh.object, m_buildSettings, navMeshBBox) == false) {
+			clearRecastAndDetourState();
+			return;
+		}
+
+		m_tiledNavMeshBuilder.setGeometry(geometry);
+		m_tiledNavMeshBuilder.buildAllTiles(getBuildThreadPool());
 	}
 	else {
-		dtNavMeshCreateParams params;
-		memset(&params, 0, sizeof(params));
-		params.verts = m_recastPolyMesh->verts;
-		params.vertCount = m_recastPolyMesh->nverts;
-		params.polys = m_recastPolyMesh->polys;
-		params.polyAreas = m_recastPolyMesh->areas;
-		params.polyFlags = m_recastPolyMesh->flags;
-		params.polyCount = m_recastPolyMesh->npolys;
-		params.nvp = m_recastPolyMesh->nvp;
-		params.detailMeshes = recastDetailMesh->meshes;
-		params.detailVerts = recastDetailMesh->verts;
-		params.detailVertsCount = recastDetailMesh->nverts;
-		params.detailTris = recastDetailMesh->tris;
-		params.detailTriCount = recastDetailMesh->ntris;
-		// params.offMeshConVerts = m_geom->getOffMeshConnectionVerts();
-		// params.offMeshConRad = m_geom->getOffMeshConnectionRads();
-		// params.offMeshConDir = m_geom->getOffMeshConnectionDirs();
-		// params.offMeshConAreas = m_geom->getOffMeshConnectionAreas();
-		// params.offMeshConFlags = m_geom->getOffMeshConnectionFlags();
-		// params.offMeshConUserID = m_geom->getOffMeshConnectionId();
-		// params.offMeshConCount = m_geom->getOffMeshConnectionCount();
-		params.walkableHeight = m_buildSettings.agentHeight;
-		params.walkableRadius = m_buildSettings.agentRadius;
-		params.walkableClimb = m_buildSettings.cimbableStairHeight;
-		rcVcopy(params.bmin, m_recastPolyMesh->bmin);
-		rcVcopy(params.bmax, m_recastPolyMesh->bmax);
-		params.cs = recastCfg.cs;
-		params.ch = recastCfg.ch;
-		params.buildBvTree = true;
-
 		unsigned char* navData = nullptr;
 		int navDataSize = 0;
-		if (!dtCreateNavMeshData(&params, &navData, &navDataSize)) {
-			dtFree(navData); // If the function succeedes the bookkeeping of the data is done with m_detourNavMesh
-			navData = nullptr;
-			sgeAssert(false);
+		if (buildNavMeshData(m_buildSettings, navMeshBBox, 0, 0, 0, geometry, nullptr, navData, navDataSize) == false ||
+		    navData == nullptr) {
+			// Either something failed or no walkable geomety has been found, there will be no navmesh.
+			clearRecastAndDetourState();
+			return;
 		}
 
+		// If the function succeedes the bookkeeping of the data is done with m_detourNavMesh
 		m_detourNavMesh.createNew();
 		[[maybe_unused]] dtStatus status = m_detourNavMesh->init(navData, navDataSize, DT_TILE_FREE_DATA);
-		m_detourNavMeshQuery.createNew();
-		m_detourNavMeshQuery->init(m_detourNavMesh.object, 2048); // TODO: Why 2048?
 	}
 
+	m_detourNavMeshQuery.createNew();
+	m_detourNavMeshQuery->init(m_detourNavMesh.object, 2048); // TODO: Why 2048?
 
-	// Build the debug draw mesh.
-	{
-		const int nvp = m_recastPolyMesh->nvp;
-		const float cs = m_recastPolyMesh->cs;
-		const float ch = m_recastPolyMesh->ch;
-		const vec3f orig = vec3f(m_recastPolyMesh->bmin[0], m_recastPolyMesh->bmin[1], m_recastPolyMesh->bmin[2]);
-
-		m_debugDrawNavMeshTriListWs.clear();
-
-		for (int iPoly = 0; iPoly < m_recastPolyMesh->npolys; ++iPoly) {
-			const unsigned short* p = &m_recastPolyMesh->polys[iPoly * nvp * 2];
-
-			unsigned short vi[3];
-			for (int j = 2; j < nvp; ++j) {
-				if (p[j] == RC_MESH_NULL_IDX) {
-					break;
-				}
-				vi[0] = p[0];
-				vi[1] = p[j - 1];
-				vi[2] = p[j];
-				for (int k = 0; k < 3; ++k) {
-					const unsigned short* v = &m_recastPolyMesh->verts[vi[k] * 3];
-					const float x = orig[0] + v[0] * cs;
-					const float y = orig[1] + (v[1] + 1) * ch;
-					const float z = orig[2] + v[2] * cs;
-					m_debugDrawNavMeshTriListWs.push_back(vec3f(x, y, z));
-				}
-			}
-		}
-	}
+	// Use a path query lane per update thread, so the batched path requests are searched on all of them.
+	ThreadPool* const updateThreadPool = GameObject::getWorld()->getUpdateThreadPool();
+	m_navigationService.create(
+	    m_detourNavMesh.object,
+	    m_maxCrowdAgents,
+	    m_maxCrowdAgentRadius,
+	    updateThreadPool ? updateThreadPool->getNumWorkers() : 1);
 
-	m_debugDrawNavMeshBuildTriListWs.clear();
-	for (int iTri = 0; iTri < numTriangles; iTri++) {
-		m_debugDrawNavMeshBuildTriListWs.push_back(trianglesVerticesWorldSpace[trianglesIndices[iTri * 3 + 0]]);
-		m_debugDrawNavMeshBuildTriListWs.push_back(trianglesVerticesWorldSpace[trianglesIndices[iTri * 3 + 1]]);
-		m_debugDrawNavMeshBuildTriListWs.push_back(trianglesVerticesWorldSpace[trianglesIndices[iTri * 3 + 2]]);
-	}
+	// Build the debug draw mesh.
+	getNavMeshDebugTriangles(*m_detourNavMesh.object, m_debugDrawNavMeshTriListWs);
+	setDebugDrawBuildTriangles(geometry);
 }
 
 } // namespace sge
@@ -1,28 +1,18 @@
 #pragma once
 
 #include "DetourNavMesh.h"
+#include "NavMeshBuilder.h"
+#include "NavigationService.h"
 #include "RecastDetourWrapper.h"
 #include "sge_engine/Actor.h"
 #include "sge_engine/traits/TraitCustomAE.h"
 #include "sge_engine/traits/TraitViewportIcon.h"
 #include "sge_utils/react/Event.h"
+#include "sge_utils/threading/ThreadPool.h"
 
-namespace sge {
-
-struct NavMeshBuildSets {
-	float cellXZSize = 0.25f;
-	float cellYSize = 0.1f;
-	float climbableSlopeAngle = deg2rad(45.f);
-	float cimbableStairHeight = 0.2f;
-	// Imagine that the mesh is a multiple stories flat, recast needs to know how high the rooms are.
-	float minRoomHeight = 0.1f;
+#include <unordered_map>
 
-	// How wide an area should be to be concidered walkable.
-	float agentRadius = 0.01f;
-	float agentHeight = 0.005f;
-
-	float polygonsMaxEdgeLength = 10.f;
-};
+namespace sge {
 
 struct SGE_ENGINE_API INavMesh {
 	INavMesh() = default;
@@ -47,8 +37,17 @@ struct SGE_ENGINE_API ANavMesh : public Actor, public IActorCustomAttributeEdito
 	Box3f getBBoxOS() const final;
 	void update(const GameUpdateSets& updateSets) final;
 
+	/// @brief Builds the whole nav mesh from the rigid bodies of @m_typesToUse.
+	/// If the nav mesh is tiled (see @NavMeshBuildSets::useTiles), the tiles are built in parallel and later, during
+	/// the update, only the tiles affected by added, removed or moved rigid bodies are rebuilt in the background.
+	/// Only the movements done by the actors are noticed (see @PhysicsWorld::onRigidBodyChanged), the rigid bodies
+	/// moved by the simulation are not tracked as the nav mesh is meant for static or kinematic geometry.
 	void build();
 
+	/// @brief Forces the tiles overlapping the specified area to be rebuilt in the background.
+	/// Has no effect if the nav mesh isn't tiled.
+	void markAreaDirty(const Box3f& boxWs) { m_dirtyAreasWs.push_back(boxWs); }
+
 	// From IActorCustomAttributeEditorTrait:
 	void doAttributeEditor(GameInspector* inspector) override;
 
@@ -62,9 +61,15 @@ struct SGE_ENGINE_API ANavMesh : public Actor, public IActorCustomAttributeEdito
 
 	vec3f moveAlongNavMesh(const vec3f& start, const vec3f& end) final;
 
+	/// @brief Returns the crowd agents and the batched path requests for this nav mesh.
+	/// The service is recreated, along with its agents and requests, each time the whole nav mesh gets built.
+	NavigationService& getNavigationService() { return m_navigationService; }
+
   private:
 	void clearRecastAndDetourState()
 	{
+		m_navigationService.destroy();
+		m_tiledNavMeshBuilder.destroy();
 		m_detourNavMesh.freeExisting();
 		m_detourNavMeshQuery.freeExisting();
 
@@ -72,13 +77,50 @@ struct SGE_ENGINE_API ANavMesh : public Actor, public IActorCustomAttributeEdito
 		m_debugDrawNavMeshTriListWs = std::vector<vec3f>();
 	}
 
+	/// Generates the triangles of the rigid bodies of @m_typesToUse.
+	/// @param [in] tilesToBuild if specified, only the rigid bodies overlapping these tiles are used.
+	void gatherInputGeometry(NavMeshInputGeometry& outGeometry, const std::vector<int>* tilesToBuild = nullptr);
+
+	/// Compares the bounding box of the rigid body of the specified actor with the tracked one and adds the areas
+	/// affected by the change to @m_dirtyAreasWs.
+	void updateTrackedRigidBody(const ObjectId actorId);
+
+	/// Starts rebuilding the tiles overlapping @m_dirtyAreasWs in the background.
+	void startRebuildingDirtyTiles();
+
+	/// Returns the threads used for building the tiles. There is always at least one thread that doesn't
+	/// participate in the game update, so the tiles could get built in the background.
+	ThreadPool* getBuildThreadPool();
+
+	void setDebugDrawBuildTriangles(const NavMeshInputGeometry& geometry);
+
   public:
 	NavMeshBuildSets m_buildSettings;
-	rcPolyMeshWrapper m_recastPolyMesh;
 
 	dtNavMeshWrapper m_detourNavMesh;
 	dtNavMeshQueryWrapper m_detourNavMeshQuery;
 
+	/// The threads used for building the tiles, created the first time a tiled nav mesh is built.
+	ThreadPool m_buildThreadPool;
+	/// Builds the tiles of @m_detourNavMesh, used only if the nav mesh is tiled.
+	TiledNavMeshBuilder m_tiledNavMeshBuilder;
+
+	/// Moves the crowd agents and searches the batched path requests, updated with the actor.
+	NavigationService m_navigationService;
+	/// The settings used to create @m_navigationService.
+	int m_maxCrowdAgents = 128;
+	float m_maxCrowdAgentRadius = 1.f;
+	/// How much time the batched path requests could take per update, in milliseconds.
+	float m_pathQueriesBudgetMs = 1.f;
+
+	/// The bounding boxes of the rigid bodies used by the tiles, used to find the areas affected when they change.
+	std::unordered_map<ObjectId, Box3f> m_trackedRigidBodies;
+	/// The actors of @m_typesToUse whose rigid bodies were added, removed or moved since the last update.
+	std::vector<ObjectId> m_changedRigidBodies;
+	EventSubscription m_onRigidBodyChangedSub;
+	/// The areas where the geometry has changed since the last time the tiles were rebuilt.
+	std::vector<Box3f> m_dirtyAreasWs;
+
 	TraitViewportIcon m_traitViewportIcon;
 
 	std::vector<vec3f> m_debugDrawNavMeshBuildTriListWs;
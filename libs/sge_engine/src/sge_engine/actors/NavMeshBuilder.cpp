@@ -0,0 +1,526 @@
+#include "NavMeshBuilder.h"
+#include "DetourCommon.h"
+#include "sge_log/Log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace sge {
+
+bool buildNavMeshData(
+    const NavMeshBuildSets& buildSets,
+    const Box3f& buildBoxWs,
+    int tileX,
+    int tileY,
+    int borderSizeCells,
+    const NavMeshInputGeometry& geometry,
+    const std::vector<int>* triangles,
+    unsigned char*& outData,
+    int& outDataSize)
+{
+	outData = nullptr;
+	outDataSize = 0;
+
+	// Pick the triangles to be voxelized.
+	const int* trianglesIndices = geometry.indices.data();
+	int numTriangles = geometry.getNumTriangles();
+
+	std::vector<int> trianglesSubsetIndices;
+	if (triangles != nullptr) {
+		trianglesSubsetIndices.reserve(triangles->size() * 3);
+		for (const int iTri : *triangles) {
+			trianglesSubsetIndices.push_back(geometry.indices[iTri * 3 + 0]);
+			trianglesSubsetIndices.push_back(geometry.indices[iTri * 3 + 1]);
+			trianglesSubsetIndices.push_back(geometry.indices[iTri * 3 + 2]);
+		}
+
+		trianglesIndices = trianglesSubsetIndices.data();
+		numTriangles = int(triangles->size());
+	}
+
+	if (numTriangles == 0) {
+		// Nothing to walk on.
+		return true;
+	}
+
+	rcConfig recastCfg;
+
+	memset(&recastCfg, 0, sizeof(recastCfg));
+	recastCfg.cs = buildSets.cellXZSize;
+	recastCfg.ch = buildSets.cellYSize;
+	recastCfg.walkableSlopeAngle = rad2deg(buildSets.climbableSlopeAngle);
+	recastCfg.walkableHeight = (int)ceilf(buildSets.minRoomHeight / recastCfg.ch);
+	recastCfg.walkableClimb = (int)floorf(buildSets.cimbableStairHeight / recastCfg.ch);
+	recastCfg.walkableRadius = (int)ceilf(buildSets.agentRadius / recastCfg.cs);
+	recastCfg.maxEdgeLen = (int)(buildSets.polygonsMaxEdgeLength / recastCfg.cs); // Why does this exists?
+	recastCfg.maxSimplificationError = 1.3f;                                       // What is a good default?
+	recastCfg.minRegionArea = (int)rcSqr(8);                          // Note: area = size*size // WTF is this?
+	recastCfg.mergeRegionArea = (int)rcSqr(20);                       // Note: area = size*size // WTF is this?
+	recastCfg.maxVertsPerPoly = (int)6;                               // Why does this exists?
+	recastCfg.detailSampleDist = 6.f < 0.9f ? 0 : recastCfg.cs * 6.f; // WTF is this?
+	recastCfg.detailSampleMaxError = 1.f;                             // WTF is this?
+	recastCfg.borderSize = borderSizeCells;
+
+	// Set the area where the navigation will be build, enlarged with the border.
+	const float borderSizeWs = float(borderSizeCells) * recastCfg.cs;
+
+	recastCfg.bmin[0] = buildBoxWs.min.x - borderSizeWs;
+	recastCfg.bmin[1] = buildBoxWs.min.y;
+	recastCfg.bmin[2] = buildBoxWs.min.z - borderSizeWs;
+
+	recastCfg.bmax[0] = buildBoxWs.max.x + borderSizeWs;
+	recastCfg.bmax[1] = buildBoxWs.max.y;
+	recastCfg.bmax[2] = buildBoxWs.max.z + borderSizeWs;
+
+	rcCalcGridSize(recastCfg.bmin, recastCfg.bmax, recastCfg.cs, &recastCfg.width, &recastCfg.height);
+	rcHeightfieldWrapper recastHeightFiled;
+	rcContext recastLogging = rcContext(false);
+
+	if (!rcCreateHeightfield(
+	        &recastLogging,
+	        recastHeightFiled.ref(),
+	        recastCfg.width,
+	        recastCfg.height,
+	        recastCfg.bmin,
+	        recastCfg.bmax,
+	        recastCfg.cs,
+	        recastCfg.ch)) {
+		sgeAssert(false && "rcCreateHeightfield failed!");
+		return false;
+	}
+
+	// Mark all walkable triangles.
+	std::vector<unsigned char> recastPerTriangleFlags(numTriangles, 0);
+	rcMarkWalkableTriangles(
+	    &recastLogging,
+	    recastCfg.walkableSlopeAngle,
+	    (const float*)geometry.vertices.data(),
+	    int(geometry.vertices.size()),
+	    trianglesIndices,
+	    numTriangles,
+	    recastPerTriangleFlags.data());
+
+	// Voxelize the triangles.
+	if (!rcRasterizeTriangles(
+	        &recastLogging,
+	        (const float*)geometry.vertices.data(),
+	        int(geometry.vertices.size()),
+	        trianglesIndices,
+	        recastPerTriangleFlags.data(),
+	        numTriangles,
+	        recastHeightFiled.ref(),
+	        recastCfg.walkableClimb)) {
+		sgeAssert(false && "rcRasterizeTriangles failed!");
+		return false;
+	}
+
+	// Filter walkables surfaces.
+	// Once all geoemtry is rasterized, we do initial pass of filtering to
+	// remove unwanted overhangs caused by the conservative rasterization
+	// as well as filter spans where the character cannot possibly stand.
+	rcFilterLowHangingWalkableObstacles(&recastLogging, recastCfg.walkableClimb, recastHeightFiled.ref());
+	rcFilterLedgeSpans(&recastLogging, recastCfg.walkableHeight, recastCfg.walkableClimb, recastHeightFiled.ref());
+	rcFilterWalkableLowHeightSpans(&recastLogging, recastCfg.walkableHeight, recastHeightFiled.ref());
+
+	rcCompactHeightfieldWrapper compactHeightField;
+	if (!rcBuildCompactHeightfield(
+	        &recastLogging,
+	        recastCfg.walkableHeight,
+	        recastCfg.walkableClimb,
+	        recastHeightFiled.ref(),
+	        compactHeightField.ref())) {
+		sgeAssert(false && "rcBuildCompactHeightfield failed!");
+		return false;
+	}
+
+	// Clean-up the height field as we aren't going to use it anymore.
+	recastHeightFiled.freeExisting();
+
+	if (!rcErodeWalkableArea(&recastLogging, recastCfg.walkableRadius, compactHeightField.ref())) {
+		sgeAssert(false && "rcErodeWalkableArea failed!");
+		return false;
+	}
+
+	// Here I've skipped a step where we mark different area types
+
+	// Partition the walkable surface into simple regions without holes.
+	if (!rcBuildDistanceField(&recastLogging, compactHeightField.ref())) {
+		sgeAssert(false && "rcBuildDistanceField failed!");
+		return false;
+	}
+
+	if (!rcBuildRegions(
+	        &recastLogging,
+	        compactHeightField.ref(),
+	        recastCfg.borderSize,
+	        recastCfg.minRegionArea,
+	        recastCfg.mergeRegionArea)) {
+		sgeAssert(false && "rcBuildRegions failed!");
+		return false;
+	}
+
+	rcContourSetWrapper contourSet;
+	if (!rcBuildContours(
+	        &recastLogging,
+	        compactHeightField.ref(),
+	        recastCfg.maxSimplificationError,
+	        recastCfg.maxEdgeLen,
+	        contourSet.ref())) {
+		sgeAssert(false && "rcBuildContours failed!");
+		return false;
+	}
+
+	// Build the recast poly mesh.
+	rcPolyMeshWrapper recastPolyMesh;
+	if (!rcBuildPolyMesh(&recastLogging, contourSet.ref(), recastCfg.maxVertsPerPoly, recastPolyMesh.ref())) {
+		sgeAssert(false && "rcBuildPolyMesh failed!");
+		return false;
+	}
+
+	rcPolyMeshDetailWrapper recastDetailMesh;
+	if (!rcBuildPolyMeshDetail(
+	        &recastLogging,
+	        recastPolyMesh.ref(),
+	        compactHeightField.ref(),
+	        recastCfg.detailSampleDist,
+	        recastCfg.detailSampleMaxError,
+	        recastDetailMesh.ref())) {
+		sgeAssert(false && "rcBuildPolyMeshDetail failed");
+		return false;
+	}
+
+	// Mark all resulting polygons as walkable
+	for (int iPoly = 0; iPoly < recastPolyMesh->npolys; ++iPoly) {
+		recastPolyMesh->areas[iPoly] = RC_WALKABLE_AREA;
+		recastPolyMesh->flags[iPoly] = 1;
+	}
+
+	if (recastPolyMesh->npolys == 0) {
+		// No walkable geomety has been found, there will be no navmesh here.
+		return true;
+	}
+
+	// Build the path-finding mesh for Detour.
+	if (recastCfg.maxVertsPerPoly > DT_VERTS_PER_POLYGON) {
+		// Should never happen.
+		sgeAssert(false && "recastCfg.maxVertsPerPoly > DT_VERTS_PER_POLYGON failed");
+		return false;
+	}
+
+	dtNavMeshCreateParams params;
+	memset(&params, 0, sizeof(params));
+	params.verts = recastPolyMesh->verts;
+	params.vertCount = recastPolyMesh->nverts;
+	params.polys = recastPolyMesh->polys;
+	params.polyAreas = recastPolyMesh->areas;
+	params.polyFlags = recastPolyMesh->flags;
+	params.polyCount = recastPolyMesh->npolys;
+	params.nvp = recastPolyMesh->nvp;
+	params.detailMeshes = recastDetailMesh->meshes;
+	params.detailVerts = recastDetailMesh->verts;
+	params.detailVertsCount = recastDetailMesh->nverts;
+	params.detailTris = recastDetailMesh->tris;
+	params.detailTriCount = recastDetailMesh->ntris;
+	params.walkableHeight = buildSets.agentHeight;
+	params.walkableRadius = buildSets.agentRadius;
+	params.walkableClimb = buildSets.cimbableStairHeight;
+	params.tileX = tileX;
+	params.tileY = tileY;
+	params.tileLayer = 0;
+	rcVcopy(params.bmin, recastPolyMesh->bmin);
+	rcVcopy(params.bmax, recastPolyMesh->bmax);
+	params.cs = recastCfg.cs;
+	params.ch = recastCfg.ch;
+	params.buildBvTree = true;
+
+	if (!dtCreateNavMeshData(&params, &outData, &outDataSize)) {
+		dtFree(outData);
+		outData = nullptr;
+		outDataSize = 0;
+		sgeAssert(false && "dtCreateNavMeshData failed");
+		return false;
+	}
+
+	return true;
+}
+
+void getNavMeshDebugTriangles(const dtNavMesh& navMesh, std::vector<vec3f>& outTriListWs)
+{
+	outTriListWs.clear();
+
+	for (int iTile = 0; iTile < navMesh.getMaxTiles(); ++iTile) {
+		const dtMeshTile* const tile = navMesh.getTile(iTile);
+		if (tile == nullptr || tile->header == nullptr) {
+			continue;
+		}
+
+		for (int iPoly = 0; iPoly < tile->header->polyCount; ++iPoly) {
+			const dtPoly& poly = tile->polys[iPoly];
+			if (poly.getType() == DT_POLYTYPE_OFFMESH_CONNECTION) {
+				continue;
+			}
+
+			// Triangulate the convex polygon as a fan.
+			const vec3f* const verts = (const vec3f*)tile->verts;
+			for (int iVert = 2; iVert < poly.vertCount; ++iVert) {
+				outTriListWs.push_back(verts[poly.verts[0]]);
+				outTriListWs.push_back(verts[poly.verts[iVert - 1]]);
+				outTriListWs.push_back(verts[poly.verts[iVert]]);
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------
+// TiledNavMeshBuilder
+//--------------------------------------------------------
+bool TiledNavMeshBuilder::create(dtNavMesh* navMesh, const NavMeshBuildSets& buildSets, const Box3f& boundsWs)
+{
+	waitForPendingTiles();
+
+	m_navMesh = navMesh;
+	m_buildSets = buildSets;
+	m_boundsWs = boundsWs;
+	m_geometry.reset();
+
+	const float cs = buildSets.cellXZSize;
+	m_tileSizeCells = std::max(1, int(buildSets.tileSize / cs));
+	m_tileSizeWs = float(m_tileSizeCells) * cs;
+	m_borderSizeCells = int(ceilf(buildSets.agentRadius / cs)) + 3;
+
+	const vec3f boundsSize = boundsWs.size();
+	m_numTilesX = std::max(1, int(ceilf(boundsSize.x / m_tileSizeWs)));
+	m_numTilesZ = std::max(1, int(ceilf(boundsSize.z / m_tileSizeWs)));
+
+	// Detour encodes the tile and the polygon index in 22 bits of each polygon reference,
+	// the rest of the bits are used to detect references to tiles that were rebuilt.
+	const int tileBits = std::min(int(dtIlog2(dtNextPow2(unsigned(getNumTiles())))), 14);
+	const int polyBits = 22 - tileBits;
+
+	dtNavMeshParams params;
+	memset(&params, 0, sizeof(params));
+	rcVcopy(params.orig, boundsWs.min.data);
+	params.tileWidth = m_tileSizeWs;
+	params.tileHeight = m_tileSizeWs;
+	params.maxTiles = 1 << tileBits;
+	params.maxPolys = 1 << polyBits;
+
+	if (getNumTiles() > params.maxTiles) {
+		sgeLogError(
+		    "The nav mesh needs %d tiles, the limit is %d. Increase the tile size!", getNumTiles(), params.maxTiles);
+		m_navMesh = nullptr;
+		return false;
+	}
+
+	if (dtStatusFailed(m_navMesh->init(&params))) {
+		sgeAssert(false && "dtNavMesh::init failed");
+		m_navMesh = nullptr;
+		return false;
+	}
+
+	return true;
+}
+
+void TiledNavMeshBuilder::destroy()
+{
+	waitForPendingTiles();
+	m_navMesh = nullptr;
+	m_geometry.reset();
+}
+
+void TiledNavMeshBuilder::setGeometry(NavMeshInputGeometry geometry, const std::vector<int>* tiles)
+{
+	std::shared_ptr<TiledGeometry> tiledGeometry = std::make_shared<TiledGeometry>();
+	tiledGeometry->geometry = std::move(geometry);
+	tiledGeometry->trianglesPerTile.resize(getNumTiles());
+
+	const std::vector<vec3f>& vertices = tiledGeometry->geometry.vertices;
+	const std::vector<int>& indices = tiledGeometry->geometry.indices;
+
+	std::vector<bool> isTileUsed(getNumTiles(), tiles == nullptr);
+	if (tiles != nullptr) {
+		for (const int iTile : *tiles) {
+			isTileUsed[iTile] = true;
+		}
+	}
+
+	std::vector<int> trianglesTiles;
+	for (int iTri = 0; iTri < tiledGeometry->geometry.getNumTriangles(); ++iTri) {
+		Box3f triangleBox;
+		triangleBox.expand(vertices[indices[iTri * 3 + 0]]);
+		triangleBox.expand(vertices[indices[iTri * 3 + 1]]);
+		triangleBox.expand(vertices[indices[iTri * 3 + 2]]);
+
+		trianglesTiles.clear();
+		findTilesOverlapping(triangleBox, trianglesTiles);
+		for (const int iTile : trianglesTiles) {
+			if (isTileUsed[iTile]) {
+				tiledGeometry->trianglesPerTile[iTile].push_back(iTri);
+			}
+		}
+	}
+
+	m_geometry = std::move(tiledGeometry);
+}
+
+void TiledNavMeshBuilder::findTilesOverlapping(const Box3f& boxWs, std::vector<int>& outTiles) const
+{
+	if (boxWs.isEmpty() || getNumTiles() == 0) {
+		return;
+	}
+
+	// The tiles are voxelized with a border around them, so anything in the border affects them as well.
+	const float borderSizeWs = float(m_borderSizeCells) * m_buildSets.cellXZSize;
+	const float minX = (boxWs.min.x - borderSizeWs - m_boundsWs.min.x) / m_tileSizeWs;
+	const float minZ = (boxWs.min.z - borderSizeWs - m_boundsWs.min.z) / m_tileSizeWs;
+	const float maxX = (boxWs.max.x + borderSizeWs - m_boundsWs.min.x) / m_tileSizeWs;
+	const float maxZ = (boxWs.max.z + borderSizeWs - m_boundsWs.min.z) / m_tileSizeWs;
+
+	if (maxX < 0.f || maxZ < 0.f || minX >= float(m_numTilesX) || minZ >= float(m_numTilesZ)) {
+		return;
+	}
+
+	const int firstX = std::max(0, int(floorf(minX)));
+	const int firstZ = std::max(0, int(floorf(minZ)));
+	const int lastX = std::min(m_numTilesX - 1, int(floorf(maxX)));
+	const int lastZ = std::min(m_numTilesZ - 1, int(floorf(maxZ)));
+
+	for (int z = firstZ; z <= lastZ; ++z) {
+		for (int x = firstX; x <= lastX; ++x) {
+			outTiles.push_back(x + z * m_numTilesX);
+		}
+	}
+}
+
+Box3f TiledNavMeshBuilder::getTileBox(int const iTile) const
+{
+	const int x = iTile % m_numTilesX;
+	const int z = iTile / m_numTilesX;
+
+	Box3f tileBox;
+	tileBox.min = vec3f(
+	    m_boundsWs.min.x + float(x) * m_tileSizeWs, m_boundsWs.min.y, m_boundsWs.min.z + float(z) * m_tileSizeWs);
+	tileBox.max = vec3f(tileBox.min.x + m_tileSizeWs, m_boundsWs.max.y, tileBox.min.z + m_tileSizeWs);
+	return tileBox;
+}
+
+void TiledNavMeshBuilder::startBuildingTiles(const std::vector<int>& tiles, ThreadPool* const threadPool)
+{
+	if (isBuildingTiles() || m_navMesh == nullptr || m_geometry == nullptr) {
+		return;
+	}
+
+	m_pendingTilesThreadPool = threadPool;
+	m_pendingTiles.resize(tiles.size());
+
+	for (size_t t = 0; t < tiles.size(); ++t) {
+		PendingTile& pendingTile = m_pendingTiles[t];
+		pendingTile.iTile = tiles[t];
+
+		// The job has its own copy of everything it needs, as the builder might change while it is running.
+		// The pending tiles array doesn't change until all jobs are done.
+		const auto buildTile = [geometry = m_geometry,
+		                        buildSets = m_buildSets,
+		                        tileBox = getTileBox(pendingTile.iTile),
+		                        tileX = pendingTile.iTile % m_numTilesX,
+		                        tileZ = pendingTile.iTile / m_numTilesX,
+		                        borderSizeCells = m_borderSizeCells,
+		                        &pendingTile]() -> void {
+			buildNavMeshData(
+			    buildSets,
+			    tileBox,
+			    tileX,
+			    tileZ,
+			    borderSizeCells,
+			    geometry->geometry,
+			    &geometry->trianglesPerTile[pendingTile.iTile],
+			    pendingTile.data,
+			    pendingTile.dataSize);
+		};
+
+		if (threadPool != nullptr) {
+			threadPool->enqueue(buildTile, &m_pendingTilesCounter);
+		}
+		else {
+			buildTile();
+		}
+	}
+}
+
+bool TiledNavMeshBuilder::tryFinishBuildingTiles()
+{
+	if (isBuildingTiles() == false || m_pendingTilesCounter.isDone() == false) {
+		return false;
+	}
+
+	for (PendingTile& pendingTile : m_pendingTiles) {
+		const int tileX = pendingTile.iTile % m_numTilesX;
+		const int tileZ = pendingTile.iTile / m_numTilesX;
+
+		// Remove the old version of the tile. Any references to its polygons become invalid.
+		const dtTileRef oldTileRef = m_navMesh->getTileRefAt(tileX, tileZ, 0);
+		if (oldTileRef != 0) {
+			m_navMesh->removeTile(oldTileRef, nullptr, nullptr);
+		}
+
+		if (pendingTile.data != nullptr) {
+			const dtStatus status =
+			    m_navMesh->addTile(pendingTile.data, pendingTile.dataSize, DT_TILE_FREE_DATA, 0, nullptr);
+			if (dtStatusFailed(status)) {
+				sgeAssert(false && "dtNavMesh::addTile failed");
+				dtFree(pendingTile.data);
+			}
+		}
+	}
+
+	m_pendingTiles.clear();
+	m_pendingTilesThreadPool = nullptr;
+	return true;
+}
+
+void TiledNavMeshBuilder::buildTiles(const std::vector<int>& tiles, ThreadPool* const threadPool)
+{
+	// Finish the previously started tiles first, as they would overwrite the new ones.
+	if (isBuildingTiles()) {
+		if (m_pendingTilesThreadPool != nullptr) {
+			m_pendingTilesThreadPool->wait(m_pendingTilesCounter);
+		}
+		tryFinishBuildingTiles();
+	}
+
+	startBuildingTiles(tiles, threadPool);
+	if (threadPool != nullptr) {
+		threadPool->wait(m_pendingTilesCounter);
+	}
+	tryFinishBuildingTiles();
+}
+
+void TiledNavMeshBuilder::buildAllTiles(ThreadPool* const threadPool)
+{
+	std::vector<int> tiles(getNumTiles());
+	for (int iTile = 0; iTile < getNumTiles(); ++iTile) {
+		tiles[iTile] = iTile;
+	}
+
+	buildTiles(tiles, threadPool);
+}
+
+void TiledNavMeshBuilder::waitForPendingTiles()
+{
+	if (isBuildingTiles() == false) {
+		return;
+	}
+
+	if (m_pendingTilesThreadPool != nullptr) {
+		m_pendingTilesThreadPool->wait(m_pendingTilesCounter);
+	}
+
+	for (PendingTile& pendingTile : m_pendingTiles) {
+		dtFree(pendingTile.data);
+	}
+
+	m_pendingTiles.clear();
+	m_pendingTilesThreadPool = nullptr;
+}
+
+} // namespace sge
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "RecastDetourWrapper.h"
+#include "sge_engine/sge_engine_api.h"
+#include "sge_utils/math/Box3f.h"
+#include "sge_utils/threading/ThreadPool.h"
+
+#include <memory>
+#include <vector>
+
+namespace sge {
+
+struct NavMeshBuildSets {
+	float cellXZSize = 0.25f;
+	float cellYSize = 0.1f;
+	float climbableSlopeAngle = deg2rad(45.f);
+	float cimbableStairHeight = 0.2f;
+	// Imagine that the mesh is a multiple stories flat, recast needs to know how high the rooms are.
+	float minRoomHeight = 0.1f;
+
+	// How wide an area should be to be concidered walkable.
+	float agentRadius = 0.01f;
+	float agentHeight = 0.005f;
+
+	float polygonsMaxEdgeLength = 10.f;
+
+	// If true the nav mesh is split into square tiles, which are built in parallel and could be rebuilt individually
+	// when the geometry in them changes. Otherwise the whole nav mesh is built as a single piece.
+	bool useTiles = false;
+	// The size of each tile along X and Z in world space.
+	float tileSize = 32.f;
+};
+
+/// The triangles used to build a nav mesh, in world space.
+struct NavMeshInputGeometry {
+	std::vector<vec3f> vertices;
+	std::vector<int> indices;
+
+	int getNumTriangles() const { return int(indices.size()) / 3; }
+};
+
+/// @brief Runs the Recast pipeline over the specified triangles and produces the data for a Detour nav mesh tile.
+/// @param [in] buildBoxWs the area where the nav mesh is going to be built (for tiled nav meshes, the tile bounds).
+/// @param [in] tileX, tileY the location of the tile in the tile grid, 0 if the nav mesh isn't tiled.
+/// @param [in] borderSizeCells how many cells around the box are also voxelized, so the tile edges would match the
+///             neighbouring tiles. Should be 0 if the nav mesh isn't tiled.
+/// @param [in] triangles the indices of the triangles in @geometry to be used, if nullptr all triangles are used.
+/// @param [out] outData the data to be added to a dtNavMesh, the caller is responsible for freeing it with dtFree.
+///              nullptr if the area has no walkable polygons.
+/// @return false if Recast or Detour failed.
+SGE_ENGINE_API bool buildNavMeshData(
+    const NavMeshBuildSets& buildSets,
+    const Box3f& buildBoxWs,
+    int tileX,
+    int tileY,
+    int borderSizeCells,
+    const NavMeshInputGeometry& geometry,
+    const std::vector<int>* triangles,
+    unsigned char*& outData,
+    int& outDataSize);
+
+/// @brief Generates a triangle list in world space representing the polygons of all tiles in the nav mesh.
+SGE_ENGINE_API void getNavMeshDebugTriangles(const dtNavMesh& navMesh, std::vector<vec3f>& outTriListWs);
+
+/// TiledNavMeshBuilder builds a Detour nav mesh split into a grid of square tiles.
+/// Each tile is built from the triangles overlapping it, independently of the other tiles, so they are built in
+/// parallel. When the geometry changes only the tiles affected by the change need to be rebuilt.
+/// Tiles are built by the worker threads and swapped in the nav mesh by the thread that owns it, this could be done
+/// without waiting, see @startBuildingTiles and @tryFinishBuildingTiles.
+struct SGE_ENGINE_API TiledNavMeshBuilder : public NoCopy {
+	TiledNavMeshBuilder() = default;
+	~TiledNavMeshBuilder() { destroy(); }
+
+	/// @brief Initializes @navMesh for tiled use, covering @boundsWs. Removes all previously built tiles.
+	/// @param [in] navMesh the nav mesh to be filled with tiles, it must outlive the builder.
+	bool create(dtNavMesh* navMesh, const NavMeshBuildSets& buildSets, const Box3f& boundsWs);
+
+	/// @brief Discards the tiles being built and detaches the builder from the nav mesh.
+	void destroy();
+
+	bool isCreated() const { return m_navMesh != nullptr; }
+
+	/// @brief Changes the triangles used for building the tiles. Already built tiles aren't affected.
+	/// Could be called while tiles are being built, they will use the geometry they were started with.
+	/// @param [in] tiles if specified, the triangles are sorted only into these tiles and only they could be built
+	///                   with this geometry. Useful when @geometry has only the triangles near the tiles to be rebuilt.
+	void setGeometry(NavMeshInputGeometry geometry, const std::vector<int>* tiles = nullptr);
+
+	/// @brief Appends the indices of all tiles whose area (including the border) overlaps @boxWs.
+	void findTilesOverlapping(const Box3f& boxWs, std::vector<int>& outTiles) const;
+
+	/// @brief Starts building the specified tiles using the current geometry.
+	/// If @threadPool is nullptr the tiles are built on the calling thread before returning.
+	/// Does nothing if there are tiles still being built, check with @isBuildingTiles.
+	void startBuildingTiles(const std::vector<int>& tiles, ThreadPool* const threadPool);
+
+	/// @brief If all started tiles are built, replaces the old tiles in the nav mesh with them.
+	/// @return true if the started tiles were finished and swapped in.
+	bool tryFinishBuildingTiles();
+
+	/// @brief Builds the specified tiles and waits for them to finish, see @startBuildingTiles.
+	void buildTiles(const std::vector<int>& tiles, ThreadPool* const threadPool);
+
+	/// @brief Builds all tiles of the nav mesh and waits for them to finish.
+	void buildAllTiles(ThreadPool* const threadPool);
+
+	bool isBuildingTiles() const { return m_pendingTiles.empty() == false; }
+
+	int getNumTiles() const { return m_numTilesX * m_numTilesZ; }
+
+	/// @brief Returns the bounding box of the tile, without the border.
+	Box3f getTileBox(int const iTile) const;
+
+  private:
+	/// The result of building a single tile.
+	struct PendingTile {
+		int iTile = -1;
+		unsigned char* data = nullptr;
+		int dataSize = 0;
+	};
+
+	/// Buckets of triangles overlapping each tile (including the border).
+	struct TiledGeometry {
+		NavMeshInputGeometry geometry;
+		std::vector<std::vector<int>> trianglesPerTile;
+	};
+
+	/// Waits for the tiles being built and discards them.
+	void waitForPendingTiles();
+
+  private:
+	dtNavMesh* m_navMesh = nullptr;
+	NavMeshBuildSets m_buildSets;
+	Box3f m_boundsWs;
+
+	int m_numTilesX = 0;
+	int m_numTilesZ = 0;
+	/// The size of the tile, without the border, in cells and in world space.
+	int m_tileSizeCells = 0;
+	float m_tileSizeWs = 0.f;
+	/// How many cells around each tile are voxelized, so the edges of the neighbouring tiles would match.
+	int m_borderSizeCells = 0;
+
+	/// The geometry is shared with the tiles being built, it is never modified, only replaced.
+	std::shared_ptr<const TiledGeometry> m_geometry;
+
+	ThreadPool* m_pendingTilesThreadPool = nullptr;
+	JobCounter m_pendingTilesCounter;
+	std::vector<PendingTile> m_pendingTiles;
+};
+
+} // namespace sge
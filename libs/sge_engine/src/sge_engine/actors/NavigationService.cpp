@@ -0,0 +1,472 @@
+#include "NavigationService.h"
+#include "sge_utils/time/Timer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace sge {
+
+namespace {
+	/// The maximum number of polygons in a path, longer paths are cut.
+	const int kMaxPathPolyCount = 256;
+	/// The maximum number of nodes the A* search of each query could visit.
+	const int kMaxPathQueryNodes = 2048;
+	/// How many A* iterations are done before checking if the lane has run out of time.
+	const int kPathQueryIterationsPerSlice = 32;
+
+	/// Converts a list of polygons from the start polygon to (or towards) @endPolyRef to a list of points.
+	bool findStraightPathAlongPolygons(
+	    dtNavMeshQuery& query,
+	    std::vector<vec3f>& outPath,
+	    const vec3f& startPos,
+	    const vec3f& targetEndPos,
+	    dtPolyRef endPolyRef,
+	    const dtPolyRef* polygonsAlongPath,
+	    int numPolygonsAlongPath)
+	{
+		outPath.clear();
+
+		if (numPolygonsAlongPath <= 0) {
+			return false;
+		}
+
+		outPath.resize(kMaxPathPolyCount);
+		// In case of partial path, make sure the end point is clamped to the last polygon.
+		// Partial path means that the points isn't reachable, but the library generated a path which
+		// takes you closer to the end point.
+		vec3f acutualEndPos = targetEndPos;
+		if (polygonsAlongPath[numPolygonsAlongPath - 1] != endPolyRef) {
+			query.closestPointOnPoly(
+			    polygonsAlongPath[numPolygonsAlongPath - 1], targetEndPos.data, acutualEndPos.data, 0);
+		}
+
+		int numPointsInPath = 0;
+		const int streightPathOptions = 0;
+		unsigned char straightPathFlags[kMaxPathPolyCount];
+		query.findStraightPath(
+		    startPos.data,
+		    acutualEndPos.data,
+		    polygonsAlongPath,
+		    numPolygonsAlongPath,
+		    (float*)outPath.data(),
+		    straightPathFlags,
+		    nullptr,
+		    &numPointsInPath,
+		    kMaxPathPolyCount,
+		    streightPathOptions);
+
+		outPath.resize(numPointsInPath);
+		return numPointsInPath > 0;
+	}
+} // namespace
+
+bool findNavMeshPath(
+    dtNavMeshQuery& query,
+    std::vector<vec3f>& outPath,
+    const vec3f& startPos,
+    const vec3f& endPos,
+    const vec3f& nearestPointSearchHalfDiagonal)
+{
+	outPath.clear();
+
+	dtQueryFilter queryPolyFilter;
+
+	dtPolyRef startPolyRef = 0;
+	query.findNearestPoly(startPos.data, nearestPointSearchHalfDiagonal.data, &queryPolyFilter, &startPolyRef, 0);
+
+	dtPolyRef endPolyRef = 0;
+	query.findNearestPoly(endPos.data, nearestPointSearchHalfDiagonal.data, &queryPolyFilter, &endPolyRef, 0);
+
+	if (startPolyRef == 0 || endPolyRef == 0) {
+		return false; // No path could be found.
+	}
+
+	dtPolyRef polygonsAlongPath[kMaxPathPolyCount];
+	int numPolygonsAlongPath = 0;
+	query.findPath(
+	    startPolyRef,
+	    endPolyRef,
+	    startPos.data,
+	    endPos.data,
+	    &queryPolyFilter,
+	    polygonsAlongPath,
+	    &numPolygonsAlongPath,
+	    SGE_ARRSZ(polygonsAlongPath));
+
+	return findStraightPathAlongPolygons(
+	    query, outPath, startPos, endPos, endPolyRef, polygonsAlongPath, numPolygonsAlongPath);
+}
+
+//--------------------------------------------------------
+// NavigationService
+//--------------------------------------------------------
+bool NavigationService::create(dtNavMesh* navMesh, int maxAgents, float maxAgentRadius, int numPathQueryLanes)
+{
+	destroy();
+
+	if (navMesh == nullptr) {
+		return false;
+	}
+
+	m_crowd.createNew();
+	if (m_crowd->init(maxAgents, maxAgentRadius, navMesh) == false) {
+		sgeAssert(false && "dtCrowd::init failed");
+		m_crowd.freeExisting();
+		return false;
+	}
+
+	// All agents use the cheapest obstacle avoidance, as it runs for every agent on every update.
+	dtObstacleAvoidanceParams avoidanceParams;
+	memcpy(&avoidanceParams, m_crowd->getObstacleAvoidanceParams(0), sizeof(avoidanceParams));
+	avoidanceParams.velBias = 0.5f;
+	avoidanceParams.adaptiveDivs = 5;
+	avoidanceParams.adaptiveRings = 2;
+	avoidanceParams.adaptiveDepth = 1;
+	m_crowd->setObstacleAvoidanceParams(0, &avoidanceParams);
+
+	for (int t = 0; t < std::max(1, numPathQueryLanes); ++t) {
+		std::unique_ptr<PathQueryLane> lane = std::make_unique<PathQueryLane>();
+		if (dtStatusFailed(lane->query->init(navMesh, kMaxPathQueryNodes))) {
+			sgeAssert(false && "dtNavMeshQuery::init failed");
+			destroy();
+			return false;
+		}
+
+		m_pathQueryLanes.emplace_back(std::move(lane));
+	}
+
+	m_navMesh = navMesh;
+	return true;
+}
+
+void NavigationService::destroy()
+{
+	m_navMesh = nullptr;
+	m_crowd.freeExisting();
+	m_pathQueryLanes.clear();
+	m_pathRequests.clear();
+	m_freePathRequests.clear();
+	m_numPendingPathRequests = 0;
+}
+
+void NavigationService::update(float dt, ThreadPool* const threadPool)
+{
+	if (isCreated() == false) {
+		return;
+	}
+
+	if (m_numPendingPathRequests > 0) {
+		const int numLanes = int(m_pathQueryLanes.size());
+		const int numWorkers = threadPool ? std::min(threadPool->getNumWorkers(), numLanes) : 1;
+
+		// If there are fewer threads than lanes, some lanes are going to be processed one after another,
+		// split the budget so the whole update stays within it.
+		const uint64 laneBudgetNs = uint64(m_pathQueriesBudgetMs * 1e6f * float(numWorkers) / float(numLanes));
+
+		const auto processLanesInRange = [this, laneBudgetNs](int begin, int end) -> void {
+			for (int iLane = begin; iLane < end; ++iLane) {
+				processPathQueryLane(*m_pathQueryLanes[iLane], laneBudgetNs);
+			}
+		};
+
+		if (numWorkers > 1) {
+			threadPool->parallelFor(numLanes, 1, processLanesInRange);
+		}
+		else {
+			processLanesInRange(0, numLanes);
+		}
+
+		for (const std::unique_ptr<PathQueryLane>& lane : m_pathQueryLanes) {
+			m_numPendingPathRequests -= lane->numFinishedRequests;
+			lane->numFinishedRequests = 0;
+		}
+	}
+
+	m_crowd->update(dt, nullptr);
+}
+
+bool NavigationService::isPathRequestPending(const NavPathRequestId& requestId) const
+{
+	return getPathRequestStatus(requestId) == navPathRequestStatus_pending;
+}
+
+void NavigationService::processPathQueryLane(PathQueryLane& lane, uint64 const budgetNs)
+{
+	dtNavMeshQuery& query = *lane.query.object;
+	const uint64 deadlineNs = Timer::now_nanoseconds_int() + budgetNs;
+
+	while (Timer::now_nanoseconds_int() < deadlineNs) {
+		// The current request might have been cancelled since the last update.
+		if (lane.currentRequest.isValid() && isPathRequestPending(lane.currentRequest) == false) {
+			lane.currentRequest = NavPathRequestId();
+		}
+
+		if (lane.currentRequest.isValid() == false) {
+			if (lane.queuedRequests.empty()) {
+				break;
+			}
+
+			const NavPathRequestId requestId = lane.queuedRequests.front();
+			lane.queuedRequests.pop_front();
+			if (isPathRequestPending(requestId) == false) {
+				continue;
+			}
+
+			lane.currentRequest = requestId;
+			const PathRequest& request = m_pathRequests[requestId.index];
+
+			dtPolyRef startPolyRef = 0;
+			lane.currentEndPolyRef = 0;
+			query.findNearestPoly(
+			    request.startPos.data,
+			    request.nearestPointSearchHalfDiagonal.data,
+			    &m_pathQueryFilter,
+			    &startPolyRef,
+			    nullptr);
+			query.findNearestPoly(
+			    request.endPos.data,
+			    request.nearestPointSearchHalfDiagonal.data,
+			    &m_pathQueryFilter,
+			    &lane.currentEndPolyRef,
+			    nullptr);
+
+			if (startPolyRef == 0 || lane.currentEndPolyRef == 0) {
+				finishCurrentPathRequest(lane, false);
+				continue;
+			}
+
+			const dtStatus initStatus = query.initSlicedFindPath(
+			    startPolyRef, lane.currentEndPolyRef, request.startPos.data, request.endPos.data, &m_pathQueryFilter);
+			if (dtStatusFailed(initStatus)) {
+				finishCurrentPathRequest(lane, false);
+				continue;
+			}
+		}
+
+		const dtStatus status = query.updateSlicedFindPath(kPathQueryIterationsPerSlice, nullptr);
+		if (dtStatusInProgress(status) == false) {
+			finishCurrentPathRequest(lane, dtStatusSucceed(status));
+		}
+	}
+}
+
+void NavigationService::finishCurrentPathRequest(PathQueryLane& lane, bool const isPathFound)
+{
+	PathRequest& request = m_pathRequests[lane.currentRequest.index];
+	request.status = navPathRequestStatus_failed;
+
+	if (isPathFound) {
+		dtPolyRef polygonsAlongPath[kMaxPathPolyCount];
+		int numPolygonsAlongPath = 0;
+		if (dtStatusSucceed(
+		        lane.query->finalizeSlicedFindPath(polygonsAlongPath, &numPolygonsAlongPath, kMaxPathPolyCount)) &&
+		    findStraightPathAlongPolygons(
+		        *lane.query.object,
+		        request.path,
+		        request.startPos,
+		        request.endPos,
+		        lane.currentEndPolyRef,
+		        polygonsAlongPath,
+		        numPolygonsAlongPath)) {
+			request.status = navPathRequestStatus_done;
+		}
+	}
+
+	lane.currentRequest = NavPathRequestId();
+	lane.currentEndPolyRef = 0;
+	lane.numFinishedRequests++;
+}
+
+int NavigationService::addAgent(const vec3f& position, const NavAgentParams& params)
+{
+	if (isCreated() == false) {
+		return -1;
+	}
+
+	dtCrowdAgentParams agentParams;
+	memset(&agentParams, 0, sizeof(agentParams));
+	agentParams.radius = params.radius;
+	agentParams.height = params.height;
+	agentParams.maxAcceleration = params.maxAcceleration;
+	agentParams.maxSpeed = params.maxSpeed;
+	agentParams.collisionQueryRange = params.radius * 12.f;
+	agentParams.pathOptimizationRange = params.radius * 30.f;
+	agentParams.separationWeight = params.separationWeight;
+	agentParams.updateFlags = DT_CROWD_ANTICIPATE_TURNS | DT_CROWD_OPTIMIZE_VIS | DT_CROWD_OPTIMIZE_TOPO;
+	if (params.avoidOtherAgents) {
+		agentParams.updateFlags |= DT_CROWD_OBSTACLE_AVOIDANCE | DT_CROWD_SEPARATION;
+	}
+	agentParams.obstacleAvoidanceType = 0;
+	agentParams.queryFilterType = 0;
+
+	return m_crowd->addAgent(position.data, &agentParams);
+}
+
+void NavigationService::removeAgent(int const iAgent)
+{
+	if (isCreated()) {
+		m_crowd->removeAgent(iAgent);
+	}
+}
+
+bool NavigationService::setAgentTarget(int const iAgent, const vec3f& target)
+{
+	if (isAgentActive(iAgent) == false) {
+		return false;
+	}
+
+	dtPolyRef targetPolyRef = 0;
+	vec3f targetOnNavMesh = target;
+	m_crowd->getNavMeshQuery()->findNearestPoly(
+	    target.data, m_crowd->getQueryExtents(), m_crowd->getFilter(0), &targetPolyRef, targetOnNavMesh.data);
+
+	if (targetPolyRef == 0) {
+		return false;
+	}
+
+	return m_crowd->requestMoveTarget(iAgent, targetPolyRef, targetOnNavMesh.data);
+}
+
+void NavigationService::stopAgent(int const iAgent)
+{
+	if (isAgentActive(iAgent)) {
+		m_crowd->resetMoveTarget(iAgent);
+	}
+}
+
+bool NavigationService::isAgentActive(int const iAgent) const
+{
+	if (isCreated() == false || iAgent < 0 || iAgent >= m_crowd->getAgentCount()) {
+		return false;
+	}
+
+	return m_crowd->getAgent(iAgent)->active;
+}
+
+vec3f NavigationService::getAgentPosition(int const iAgent) const
+{
+	if (isAgentActive(iAgent) == false) {
+		return vec3f(0.f);
+	}
+
+	vec3f result;
+	result.set_data(m_crowd->getAgent(iAgent)->npos);
+	return result;
+}
+
+vec3f NavigationService::getAgentVelocity(int const iAgent) const
+{
+	if (isAgentActive(iAgent) == false) {
+		return vec3f(0.f);
+	}
+
+	vec3f result;
+	result.set_data(m_crowd->getAgent(iAgent)->vel);
+	return result;
+}
+
+int NavigationService::getNumActiveAgents() const
+{
+	if (isCreated() == false) {
+		return 0;
+	}
+
+	int numActiveAgents = 0;
+	for (int iAgent = 0; iAgent < m_crowd->getAgentCount(); ++iAgent) {
+		if (m_crowd->getAgent(iAgent)->active) {
+			numActiveAgents++;
+		}
+	}
+
+	return numActiveAgents;
+}
+
+NavPathRequestId NavigationService::requestPath(
+    const vec3f& startPos, const vec3f& endPos, const vec3f& nearestPointSearchHalfDiagonal)
+{
+	if (isCreated() == false) {
+		return NavPathRequestId();
+	}
+
+	NavPathRequestId requestId;
+	if (m_freePathRequests.empty() == false) {
+		requestId.index = m_freePathRequests.back();
+		m_freePathRequests.pop_back();
+	}
+	else {
+		requestId.index = int(m_pathRequests.size());
+		m_pathRequests.emplace_back();
+	}
+
+	PathRequest& request = m_pathRequests[requestId.index];
+	request.startPos = startPos;
+	request.endPos = endPos;
+	request.nearestPointSearchHalfDiagonal = nearestPointSearchHalfDiagonal;
+	request.status = navPathRequestStatus_pending;
+	request.path.clear();
+	requestId.generation = request.generation;
+
+	// Give the request to the lane with the least amount of work.
+	PathQueryLane* bestLane = nullptr;
+	for (const std::unique_ptr<PathQueryLane>& lane : m_pathQueryLanes) {
+		if (bestLane == nullptr || lane->queuedRequests.size() < bestLane->queuedRequests.size()) {
+			bestLane = lane.get();
+		}
+	}
+
+	bestLane->queuedRequests.push_back(requestId);
+	m_numPendingPathRequests++;
+
+	return requestId;
+}
+
+NavPathRequestStatus NavigationService::getPathRequestStatus(const NavPathRequestId& requestId) const
+{
+	if (requestId.index < 0 || requestId.index >= int(m_pathRequests.size())) {
+		return navPathRequestStatus_invalid;
+	}
+
+	const PathRequest& request = m_pathRequests[requestId.index];
+	if (request.generation != requestId.generation) {
+		return navPathRequestStatus_invalid;
+	}
+
+	return request.status;
+}
+
+bool NavigationService::takePathResult(const NavPathRequestId& requestId, std::vector<vec3f>& outPath)
+{
+	outPath.clear();
+
+	const NavPathRequestStatus status = getPathRequestStatus(requestId);
+	if (status == navPathRequestStatus_invalid || status == navPathRequestStatus_pending) {
+		return false;
+	}
+
+	PathRequest& request = m_pathRequests[requestId.index];
+	outPath.swap(request.path);
+	cancelPathRequest(requestId);
+
+	return status == navPathRequestStatus_done;
+}
+
+void NavigationService::cancelPathRequest(const NavPathRequestId& requestId)
+{
+	const NavPathRequestStatus status = getPathRequestStatus(requestId);
+	if (status == navPathRequestStatus_invalid) {
+		return;
+	}
+
+	if (status == navPathRequestStatus_pending) {
+		// The lane is going to skip it, as the generation will not match.
+		m_numPendingPathRequests--;
+	}
+
+	PathRequest& request = m_pathRequests[requestId.index];
+	request.status = navPathRequestStatus_invalid;
+	request.generation++;
+	request.path.clear();
+	m_freePathRequests.push_back(requestId.index);
+}
+
+} // namespace sge
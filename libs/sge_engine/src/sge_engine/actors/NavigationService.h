@@ -0,0 +1,163 @@
+#pragma once
+
+#include "DetourCrowd.h"
+#include "RecastDetourWrapper.h"
+#include "sge_engine/sge_engine_api.h"
+#include "sge_utils/math/vec3f.h"
+#include "sge_utils/threading/ThreadPool.h"
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace sge {
+
+using dtCrowdWrapper = RecastObject<dtCrowd, dtAllocCrowd, dtFreeCrowd>;
+
+/// @brief Finds a path between the two points and converts it to a list of points to be followed.
+/// The search is done immediately on the calling thread.
+/// @param [in] nearestPointSearchHalfDiagonal the size of the box used to find the polygons of the two points.
+/// @return false if there is no path. If the end point isn't reachable, the path goes as close as possible to it.
+SGE_ENGINE_API bool findNavMeshPath(
+    dtNavMeshQuery& query,
+    std::vector<vec3f>& outPath,
+    const vec3f& startPos,
+    const vec3f& endPos,
+    const vec3f& nearestPointSearchHalfDiagonal);
+
+/// The settings of an agent moving with the crowd, see @NavigationService::addAgent.
+struct NavAgentParams {
+	float radius = 0.5f;
+	float height = 2.f;
+	float maxAcceleration = 8.f;
+	float maxSpeed = 3.5f;
+	/// How strongly the agent tries to stay away from the agents around it.
+	float separationWeight = 2.f;
+	/// If true the agent steers around the other agents. This is the most expensive part of the crowd update.
+	bool avoidOtherAgents = true;
+};
+
+/// Identifies a path request made with @NavigationService::requestPath.
+struct NavPathRequestId {
+	bool isValid() const { return index >= 0; }
+
+	int index = -1;
+	int generation = 0;
+};
+
+enum NavPathRequestStatus : int {
+	/// The request has been cancelled, its result has been taken or it never existed.
+	navPathRequestStatus_invalid,
+	navPathRequestStatus_pending,
+	/// The path has been found, if the end point isn't reachable it goes as close as possible to it.
+	navPathRequestStatus_done,
+	navPathRequestStatus_failed,
+};
+
+/// NavigationService moves agents across a Detour nav mesh and finds paths for the game code.
+/// - The agents are moved with dtCrowd, they follow their paths and steer around each other.
+/// - Path requests are queued and searched in small slices during @update, spread over a few lanes.
+///   Each lane has its own dtNavMeshQuery and the lanes are processed in parallel on the specified thread pool.
+///   The time spent on path requests in a single update is limited, see @setPathQueriesBudgetMs,
+///   so many agents requesting paths at once are handled over a few frames instead of stalling a single one.
+/// The nav mesh may be modified (for example tiles rebuilt) only between the updates.
+/// The paths that went over the modified polygons fail and have to be requested again.
+struct SGE_ENGINE_API NavigationService : public NoCopy {
+	NavigationService() = default;
+	~NavigationService() { destroy(); }
+
+	/// @brief Prepares the service for the specified nav mesh, which must outlive the service.
+	/// @param [in] maxAgents the maximum number of agents moving in the crowd at once.
+	/// @param [in] maxAgentRadius the radius of the largest agent, used to search for agents around each agent.
+	/// @param [in] numPathQueryLanes how many path requests could be searched in parallel.
+	bool create(dtNavMesh* navMesh, int maxAgents, float maxAgentRadius, int numPathQueryLanes);
+	void destroy();
+
+	bool isCreated() const { return m_navMesh != nullptr; }
+
+	/// @brief Searches the pending path requests and moves the crowd agents.
+	/// @param [in] threadPool (optional) used to process the path query lanes in parallel.
+	void update(float dt, ThreadPool* const threadPool);
+
+	/// @brief Adds an agent to the crowd at the nearest point of the nav mesh.
+	/// @return the index of the agent or -1 if there is no space for more agents.
+	int addAgent(const vec3f& position, const NavAgentParams& params);
+	void removeAgent(int const iAgent);
+
+	/// @brief Makes the agent move towards the point of the nav mesh nearest to @target.
+	/// The path is searched during the next updates.
+	bool setAgentTarget(int const iAgent, const vec3f& target);
+
+	/// @brief Makes the agent stop at its current location.
+	void stopAgent(int const iAgent);
+
+	bool isAgentActive(int const iAgent) const;
+	vec3f getAgentPosition(int const iAgent) const;
+	vec3f getAgentVelocity(int const iAgent) const;
+
+	/// @brief Returns the number of agents currently in the crowd.
+	int getNumActiveAgents() const;
+
+	/// @brief Queues a search for a path between the two points. The search is done during the next updates,
+	/// check the status with @getPathRequestStatus and get the result with @takePathResult.
+	NavPathRequestId requestPath(
+	    const vec3f& startPos, const vec3f& endPos, const vec3f& nearestPointSearchHalfDiagonal = vec3f(0.5f));
+
+	NavPathRequestStatus getPathRequestStatus(const NavPathRequestId& requestId) const;
+
+	/// @brief Retrieves the path of a finished request and frees the request.
+	/// @return false if the request isn't done yet or the path couldn't be found.
+	bool takePathResult(const NavPathRequestId& requestId, std::vector<vec3f>& outPath);
+
+	/// @brief Frees the request, no matter if it is done or not.
+	void cancelPathRequest(const NavPathRequestId& requestId);
+
+	/// @brief Returns the number of path requests that are still being searched.
+	int getNumPendingPathRequests() const { return m_numPendingPathRequests; }
+
+	/// @brief Sets how much time, in milliseconds, each lane may spend searching paths in a single @update.
+	void setPathQueriesBudgetMs(float const budgetMs) { m_pathQueriesBudgetMs = budgetMs; }
+
+  private:
+	struct PathRequest {
+		vec3f startPos = vec3f(0.f);
+		vec3f endPos = vec3f(0.f);
+		vec3f nearestPointSearchHalfDiagonal = vec3f(0.f);
+		NavPathRequestStatus status = navPathRequestStatus_invalid;
+		int generation = 0;
+		std::vector<vec3f> path;
+	};
+
+	/// A lane searches its path requests one by one, as a dtNavMeshQuery can do only one sliced search at a time.
+	struct PathQueryLane {
+		dtNavMeshQueryWrapper query;
+		std::deque<NavPathRequestId> queuedRequests;
+		/// The request currently being searched by @query.
+		NavPathRequestId currentRequest;
+		dtPolyRef currentEndPolyRef = 0;
+		/// The number of requests finished during the current update.
+		int numFinishedRequests = 0;
+	};
+
+	bool isPathRequestPending(const NavPathRequestId& requestId) const;
+
+	/// Searches the requests of the lane until it runs out of time or requests.
+	/// Called from the worker threads, it changes only the requests queued in this lane.
+	void processPathQueryLane(PathQueryLane& lane, uint64 const budgetNs);
+
+	/// Sets the result of the request searched in the lane and moves to the next one.
+	void finishCurrentPathRequest(PathQueryLane& lane, bool const isPathFound);
+
+  private:
+	dtNavMesh* m_navMesh = nullptr;
+	dtCrowdWrapper m_crowd;
+
+	dtQueryFilter m_pathQueryFilter;
+	std::vector<std::unique_ptr<PathQueryLane>> m_pathQueryLanes;
+	std::vector<PathRequest> m_pathRequests;
+	std::vector<int> m_freePathRequests;
+	int m_numPendingPathRequests = 0;
+	float m_pathQueriesBudgetMs = 1.f;
+};
+
+} // namespace sge
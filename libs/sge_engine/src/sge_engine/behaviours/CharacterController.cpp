@@ -86,8 +86,8 @@ CharaterCtrlOutcome CharacterCtrlDynamic::update(const GameUpdateSets& updateSet
 	// The velocity that is going to be applied.
 	vec3f velocityToApply(0.f);
 
-	const std::vector<const btPersistentManifold*>& manifolds =
-	    world->m_physicsManifoldList[myRigidBody->getRigidBody()];
+	const ArrayView<const btPersistentManifold* const> manifolds =
+	    world->getRigidBodyManifolds(myRigidBody->getRigidBody());
 
 	vec3f correctedWalkDir = m_walkDirSmoothAccumulator;
 
@@ -3,22 +3,72 @@
 #include "PhysicsAction.h"
 #include "RigidBody.h"
 #include "SgeCollisionDispatcher.h"
+#include "sge_log/Log.h"
+
+SGE_NO_WARN_BEGIN
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <LinearMath/btThreads.h>
+SGE_NO_WARN_END
+
+#include <algorithm>
+#include <thread>
 
 namespace sge {
 
+namespace {
+	/// Returns the Bullet task scheduler used by all multithreaded physics worlds, creates it on the first call.
+	/// Returns nullptr if Bullet has been built without BT_THREADSAFE.
+	btITaskScheduler* getPhysicsTaskScheduler()
+	{
+		static btITaskScheduler* const taskScheduler = []() -> btITaskScheduler* {
+			btITaskScheduler* const scheduler = btCreateDefaultTaskScheduler();
+			if (scheduler != nullptr) {
+				btSetTaskScheduler(scheduler);
+			}
+			return scheduler;
+		}();
+
+		return taskScheduler;
+	}
+} // namespace
+
 //-------------------------------------------------------------------------
 // PhysicsWorld
 //-------------------------------------------------------------------------
-void PhysicsWorld::create()
+void PhysicsWorld::create(int numWorkers)
 {
 	destroy();
 
+	if (numWorkers <= 0) {
+		numWorkers = int(std::thread::hardware_concurrency());
+	}
+
+	btITaskScheduler* const taskScheduler = numWorkers > 1 ? getPhysicsTaskScheduler() : nullptr;
+	if (numWorkers > 1 && taskScheduler == nullptr) {
+		sgeLogWarn("Bullet is built without SGE_PHYSICS_MULTITHREADED, the physics world will be single threaded!");
+	}
+
 	broadphase.reset(new btDbvtBroadphase());
 	collisionConfiguration.reset(new btDefaultCollisionConfiguration());
-	dispatcher.reset(new SgeCollisionDispatcher(collisionConfiguration.get()));
-	solver.reset(new btSequentialImpulseConstraintSolver());
-	dynamicsWorld.reset(
-	    new btDiscreteDynamicsWorld(dispatcher.get(), broadphase.get(), solver.get(), collisionConfiguration.get()));
+
+	if (taskScheduler != nullptr) {
+		taskScheduler->setNumThreads(std::min(numWorkers, taskScheduler->getMaxNumThreads()));
+
+		// The solver pool solves each island on a single thread, the islands bigger than the
+		// minimum solver batch size (like a big pile of objects) get solved by the multithreaded solver.
+		dispatcher.reset(new SgeCollisionDispatcherMt(collisionConfiguration.get()));
+		solverPool.reset(new btConstraintSolverPoolMt(taskScheduler->getNumThreads()));
+		solver.reset(new btSequentialImpulseConstraintSolverMt());
+		dynamicsWorld.reset(new btDiscreteDynamicsWorldMt(
+		    dispatcher.get(), broadphase.get(), solverPool.get(), solver.get(), collisionConfiguration.get()));
+	}
+	else {
+		dispatcher.reset(new SgeCollisionDispatcher(collisionConfiguration.get()));
+		solver.reset(new btSequentialImpulseConstraintSolver());
+		dynamicsWorld.reset(
+		    new btDiscreteDynamicsWorld(dispatcher.get(), broadphase.get(), solver.get(), collisionConfiguration.get()));
+	}
+
 	dynamicsWorld->setForceUpdateAllAabbs(false);
 
 	// [SGE_BULLET_GHOSTS]
@@ -30,6 +80,7 @@ void PhysicsWorld::destroy()
 {
 	dynamicsWorld.reset();
 	solver.reset();
+	solverPool.reset();
 	dispatcher.reset();
 	collisionConfiguration.reset();
 	broadphase.reset();
@@ -54,10 +105,16 @@ void PhysicsWorld::addPhysicsObject(RigidBody& obj)
 		dynamicsWorld->addCollisionObject(
 		    obj.m_collisionObject.get(), btBroadphaseProxy::AllFilter, btBroadphaseProxy::AllFilter);
 	}
+
+	onRigidBodyChanged.invokeEvent(&obj);
 }
 
 void PhysicsWorld::removePhysicsObject(RigidBody& obj)
 {
+	if (obj.isInWorld()) {
+		onRigidBodyChanged.invokeEvent(&obj);
+	}
+
 	if (obj.getBulletRigidBody()) {
 		if (obj.isInWorld()) {
 			dynamicsWorld->removeRigidBody(obj.getBulletRigidBody());
@@ -3,12 +3,14 @@
 #include "BulletHelper.h"
 #include "sge_engine/sge_engine_api.h"
 #include "sge_utils/math/transform.h"
+#include "sge_utils/react/Event.h"
 #include "sge_utils/sge_utils.h"
 
 SGE_NO_WARN_BEGIN
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 #include <BulletCollision/CollisionShapes/btTriangleMesh.h>
 #include <BulletCollision/CollisionShapes/btTriangleMeshShape.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <btBulletDynamicsCommon.h>
 SGE_NO_WARN_END
 
@@ -26,9 +28,19 @@ struct SGE_ENGINE_API PhysicsWorld {
 	PhysicsWorld() = default;
 	~PhysicsWorld() { destroy(); }
 
-	void create();
+	/// @brief Creates the physics world.
+	/// @param [in] numWorkers 1 means the classic single threaded world. Any other value creates the multithreaded
+	///             world, where the narrowphase, the integration and the constraint solving of the islands are
+	///             executed in parallel by the Bullet task scheduler. 0 or less means all hardware threads.
+	///             CAUTION: The Bullet task scheduler is global, all multithreaded worlds share its worker threads.
+	///             Bullet has the task scheduler only when built with SGE_PHYSICS_MULTITHREADED (see the CMake option),
+	///             otherwise the world is always single threaded.
+	void create(int numWorkers = 1);
 	void destroy();
 
+	/// @brief Returns true if the world was created with more than one worker.
+	bool isMultithreaded() const { return solverPool != nullptr; }
+
 	/// Adds a physics object to the world.
 	/// If you are doing this manually
 	/// Make sure to add it and remove in @GameObject::onPlayStateChanged.
@@ -53,9 +65,17 @@ struct SGE_ENGINE_API PhysicsWorld {
 	std::unique_ptr<btBroadphaseInterface> broadphase;
 	std::unique_ptr<btDefaultCollisionConfiguration> collisionConfiguration;
 	std::unique_ptr<btCollisionDispatcher> dispatcher;
-	std::unique_ptr<btSequentialImpulseConstraintSolver> solver;
+	/// The solver used for the single threaded world, for the multithreaded world it solves the islands that are too
+	/// big to be solved by a single thread.
+	std::unique_ptr<btConstraintSolver> solver;
+	/// A pool of solvers used to solve the islands in parallel, nullptr if the world isn't multithreaded.
+	std::unique_ptr<btConstraintSolverPoolMt> solverPool;
 
 	btGhostPairCallback m_ghostPairCallback;
+
+	/// Invoked when a rigid body gets added to or removed from the world and when it is moved by its actor
+	/// (see TraitRigidBody::setTrasnform). The movements done by the simulation are not reported.
+	EventEmitter<const RigidBody*> onRigidBodyChanged;
 };
 
 
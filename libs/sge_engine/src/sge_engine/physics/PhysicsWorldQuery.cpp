@@ -146,7 +146,7 @@ void findActorsOnTop(vector_map<Actor*, FindActorsOnTopResult>& result, Actor* c
 		}
 		processedRigidBodies.insert(rbContactsToProcess);
 
-		for (const btPersistentManifold* const manifold : world.m_physicsManifoldList[rbContactsToProcess]) {
+		for (const btPersistentManifold* const manifold : world.getRigidBodyManifolds(rbContactsToProcess)) {
 			if (manifold == nullptr) {
 				sgeAssert(false && "Manifolds are expected to be non-null");
 				continue;
@@ -2,20 +2,31 @@
 #include "RigidBody.h"
 
 namespace sge {
-bool SgeCollisionDispatcher::needsCollision(const btCollisionObject* body0, const btCollisionObject* body1)
-{
-	RigidBody* rb0 = (RigidBody*)body0->getUserPointer();
-	RigidBody* rb1 = (RigidBody*)body1->getUserPointer();
 
-	bool needsToCollide = true;
-	if (rb0 && rb1) {
-		bool agree0 = rb0->getMaskIdentifiesAs() & rb1->getMaskCollidesWith();
-		bool agree1 = rb1->getMaskIdentifiesAs() & rb0->getMaskCollidesWith();
+namespace {
+	/// Checks if the collision masks of the rigid bodies (if any) allow them to collide.
+	bool doMasksAllowCollision(const btCollisionObject* body0, const btCollisionObject* body1)
+	{
+		RigidBody* rb0 = (RigidBody*)body0->getUserPointer();
+		RigidBody* rb1 = (RigidBody*)body1->getUserPointer();
+
+		if (rb0 && rb1) {
+			bool agree0 = rb0->getMaskIdentifiesAs() & rb1->getMaskCollidesWith();
+			bool agree1 = rb1->getMaskIdentifiesAs() & rb0->getMaskCollidesWith();
+
+			return agree0 || agree1;
+		}
 
-		needsToCollide = agree0 || agree1;
+		return true;
 	}
+} // namespace
 
-	if (needsToCollide) {
+//-------------------------------------------------------------------------
+// SgeCollisionDispatcher
+//-------------------------------------------------------------------------
+bool SgeCollisionDispatcher::needsCollision(const btCollisionObject* body0, const btCollisionObject* body1)
+{
+	if (doMasksAllowCollision(body0, body1)) {
 		return btCollisionDispatcher::needsCollision(body0, body1);
 	}
 	else {
@@ -27,4 +38,22 @@ bool SgeCollisionDispatcher::needsResponse(const btCollisionObject* body0, const
 {
 	return btCollisionDispatcher::needsResponse(body0, body1);
 }
+
+//-------------------------------------------------------------------------
+// SgeCollisionDispatcherMt
+//-------------------------------------------------------------------------
+bool SgeCollisionDispatcherMt::needsCollision(const btCollisionObject* body0, const btCollisionObject* body1)
+{
+	if (doMasksAllowCollision(body0, body1)) {
+		return btCollisionDispatcherMt::needsCollision(body0, body1);
+	}
+	else {
+		return false;
+	}
+}
+
+bool SgeCollisionDispatcherMt::needsResponse(const btCollisionObject* body0, const btCollisionObject* body1)
+{
+	return btCollisionDispatcherMt::needsResponse(body0, body1);
+}
 } // namespace sge
@@ -4,6 +4,7 @@
 
 SGE_NO_WARN_BEGIN
 #include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 SGE_NO_WARN_END
 class btCollisionConfiguration;
 
@@ -21,4 +22,17 @@ struct SgeCollisionDispatcher : public btCollisionDispatcher {
 
 	bool needsResponse(const btCollisionObject* body0, const btCollisionObject* body1) override;
 };
+
+/// SgeCollisionDispatcherMt is the same as SgeCollisionDispatcher but used with the multithreaded physics world.
+/// The narrowphase of the collision pairs is executed in parallel by the Bullet task scheduler.
+struct SgeCollisionDispatcherMt : public btCollisionDispatcherMt {
+	SgeCollisionDispatcherMt(btCollisionConfiguration* collisionConfiguration)
+	    : btCollisionDispatcherMt(collisionConfiguration)
+	{
+	}
+
+	bool needsCollision(const btCollisionObject* body0, const btCollisionObject* body1) override;
+
+	bool needsResponse(const btCollisionObject* body0, const btCollisionObject* body1) override;
+};
 } // namespace sge
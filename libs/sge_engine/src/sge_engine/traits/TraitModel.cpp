@@ -1,6 +1,7 @@
 #include "TraitModel.h"
 #include "IconsForkAwesome/IconsForkAwesome.h"
 #include "sge_core/AssetLibrary/AssetMaterial.h"
+#include "sge_core/Camera.h"
 #include "sge_core/SGEImGui.h"
 #include "sge_core/materials/DefaultPBRMtl/DefaultPBRMtl.h"
 #include "sge_core/typelib/MemberChain.h"
@@ -24,7 +25,16 @@ namespace sge {
 ReflAddTypeId(TraitModel, 20'03'01'0004);
 ReflAddTypeId(ModelEntry, 21'07'11'0002);
 ReflAddTypeId(std::vector<ModelEntry>, 21'07'11'0003);
+ReflAddTypeId(AnimationLODSettings, 26'10'17'0001);
 ReflBlock() {
+	ReflAddType(AnimationLODSettings)
+		ReflMember(AnimationLODSettings, enabled)
+		ReflMember(AnimationLODSettings, skipWhenOffscreen)
+		ReflMember(AnimationLODSettings, fullRateScreenSize).uiRange(0.f, 1.f, 0.01f)
+		ReflMember(AnimationLODSettings, minRateScreenSize).uiRange(0.f, 1.f, 0.01f)
+		ReflMember(AnimationLODSettings, minRateFrameInterval).uiRange(1, 60, 0.1f)
+	;
+
 	ReflAddType(ModelEntry)
 		ReflMember(ModelEntry, isRenderable)
 		ReflMember(ModelEntry, m_assetProperty)
@@ -35,6 +45,7 @@ ReflBlock() {
 	ReflAddType(TraitModel)
 		ReflMember(TraitModel, isRenderable)
 		ReflMember(TraitModel, m_models)
+		ReflMember(TraitModel, animationLOD)
 	;
 }
 // clang-format on
@@ -195,6 +206,48 @@ void TraitModel::invalidateCachedAssets()
 	}
 }
 
+bool TraitModel::shouldEvaluateAnimation(const ICamera* const camera)
+{
+	if (animationLOD.enabled == false || camera == nullptr) {
+		m_animationFramesToSkip = 0;
+		return true;
+	}
+
+	const Box3f bboxWs = getBBoxOS().getTransformed(getActor()->getTransformMtx());
+	if (bboxWs.isEmpty()) {
+		m_animationFramesToSkip = 0;
+		return true;
+	}
+
+	// Models that aren't visible keep their last pose. Once they become visible they get evaluated immediately.
+	const Frustum* const frustumWs = camera->getFrustumWS();
+	if (animationLOD.skipWhenOffscreen && frustumWs && frustumWs->isBoxOutside(bboxWs)) {
+		m_animationFramesToSkip = 0;
+		getWorld()->addSkippedAnimationEvaluation();
+		return false;
+	}
+
+	if (m_animationFramesToSkip > 0) {
+		m_animationFramesToSkip--;
+		getWorld()->addSkippedAnimationEvaluation();
+		return false;
+	}
+
+	// Approximate the fraction of the screen height covered by the model using its bounding sphere.
+	// For perspective projections the [1][1] element of the projection matrix is 1/tan(fovY/2).
+	const float radius = bboxWs.halfDiagonal().length();
+	const float distance = (bboxWs.center() - camera->getCameraPosition()).length();
+	const float screenSize = (distance > radius) ? radius * camera->getProj().data[1][1] / distance : 1.f;
+
+	const float sizeRange = animationLOD.fullRateScreenSize - animationLOD.minRateScreenSize;
+	const float k = sizeRange > 0.f ? clamp01((screenSize - animationLOD.minRateScreenSize) / sizeRange)
+	                                : float(screenSize >= animationLOD.fullRateScreenSize);
+	const int frameInterval = int(lerp(float(maxOf(animationLOD.minRateFrameInterval, 1)), 1.f, k) + 0.5f);
+
+	m_animationFramesToSkip = frameInterval - 1;
+	return true;
+}
+
 bool TraitModel::updateAssetProperties()
 {
 	bool hasChange = false;
@@ -202,6 +255,10 @@ bool TraitModel::updateAssetProperties()
 		hasChange |= model.updateAssetProperty();
 	}
 
+	if (hasChange && getActor() != nullptr) {
+		getActor()->markBBoxDirty();
+	}
+
 	return hasChange;
 }
 
@@ -62,9 +62,33 @@ struct SGE_ENGINE_API ModelEntry {
 	// This holds the evaluated 3D model to be rendered and if specified
 	// the @m_assetProperty will be compleatly ignored.
 	// This one is not serializable and does not appear in the user interface in any shape of form.
+	// After evaluating it call Actor::markBBoxDirty(), as the bounding box of the actor depends on it.
 	Optional<EvaluatedModel> customEvalModel;
 };
 
+/// Settings for reducing the cost of animated models that are small on the screen or not visible at all.
+/// See @TraitModel::shouldEvaluateAnimation.
+/// Disabled by default, as a skipped evaluation leaves the pose stale for everything else that uses it (shadows,
+/// objects attached to bones, gameplay code reading the nodes). Enable it for actors whose pose is only seen.
+struct SGE_ENGINE_API AnimationLODSettings {
+	/// If false the animation is evaluated every frame.
+	bool enabled = false;
+
+	/// If true models outside of the camera frustum are never evaluated, they keep their last pose.
+	/// Their shadows may still be visible, so leave it off for models casting shadows into the view.
+	bool skipWhenOffscreen = false;
+
+	/// Models taking at least this fraction of the screen height are evaluated every frame.
+	float fullRateScreenSize = 0.25f;
+
+	/// Models taking this fraction of the screen height (or less) are evaluated every @minRateFrameInterval frames.
+	/// Models between @minRateScreenSize and @fullRateScreenSize get an interval in between.
+	float minRateScreenSize = 0.05f;
+
+	/// The number of frames between two evaluations of the smallest models.
+	int minRateFrameInterval = 4;
+};
+
 /// @brief TraitModel is a trait designed to be attached in an Actor.
 /// It provides a simple way to assign a renderable 3D Model to the game object (both animated and static).
 /// The trait is not automatically updateable, the user needs to manually call @postUpdate() method in their objects.
@@ -108,6 +132,14 @@ struct SGE_ENGINE_API TraitModel : public Trait {
 
 	void invalidateCachedAssets();
 
+	/// Decides if the animated models in the trait should be evaluated this frame, based on @animationLOD and
+	/// how big the models are on the screen. Actors that animate their models should call this before evaluating the
+	/// animation. When it returns false the animation should still be advanced (ModelAnimator::advanceAnimation),
+	/// but the nodes and the skinning should not be evaluated, and the last evaluated pose gets rendered.
+	/// The skipped evaluations are counted in @GameWorld::getNumSkippedAnimationEvaluations.
+	/// @param [in] camera the camera used for rendering. If nullptr the animation is always evaluated.
+	bool shouldEvaluateAnimation(const ICamera* const camera);
+
   private:
 	bool updateAssetProperties();
 
@@ -117,6 +149,11 @@ struct SGE_ENGINE_API TraitModel : public Trait {
 	bool uiDontOfferResizingModelCount =
 	    true; ///< if true the interface will not offer adding/removing more models to the trait.
 	bool forceNoShadows = false;
+
+	AnimationLODSettings animationLOD; ///< Settings for skipping animation evaluations, see @shouldEvaluateAnimation.
+
+	/// The number of frames left before the animation gets evaluated again.
+	int m_animationFramesToSkip = 0;
 };
 
 } // namespace sge
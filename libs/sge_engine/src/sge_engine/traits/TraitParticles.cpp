@@ -2,6 +2,9 @@
 #include "sge_core/Camera.h"
 #include "sge_engine/GameDrawer/RenderItems/TraitParticlesRenderItem.h"
 #include "sge_engine/GameWorld.h"
+#include "sge_utils/math/simdMath.h"
+#include "sge_utils/other/RadixSort.h"
+#include "sge_utils/threading/ThreadPool.h"
 
 namespace sge {
 
@@ -232,7 +235,169 @@ vec3f computeAddedVelocity(Random& rnd, const vec3f& particlePosition, const Vel
 	return velocity;
 }
 
-void ParticleGroupState::update(bool isInWorldSpace, const mat4f node2world, const ParticleGroupDesc& pgDesc, float dt)
+void ParticleGroupState::ParticlesSoA::reserve(size_t capacity)
+{
+	for (std::vector<float>* const arr : {&posX, &posY, &posZ, &velX, &velY, &velZ, &scale, &maxLife, &timeSpendAlive,
+	                                      &opacity, &spriteIndex}) {
+		arr->reserve(capacity);
+	}
+}
+
+void ParticleGroupState::ParticlesSoA::clear()
+{
+	for (std::vector<float>* const arr : {&posX, &posY, &posZ, &velX, &velY, &velZ, &scale, &maxLife, &timeSpendAlive,
+	                                      &opacity, &spriteIndex}) {
+		arr->clear();
+	}
+}
+
+void ParticleGroupState::ParticlesSoA::add(const vec3f& pos, const vec3f& velocity, float scale_, float maxLife_)
+{
+	posX.push_back(pos.x);
+	posY.push_back(pos.y);
+	posZ.push_back(pos.z);
+	velX.push_back(velocity.x);
+	velY.push_back(velocity.y);
+	velZ.push_back(velocity.z);
+	scale.push_back(scale_);
+	maxLife.push_back(maxLife_);
+	timeSpendAlive.push_back(0.f);
+	opacity.push_back(1.f);
+	spriteIndex.push_back(0.f);
+}
+
+void ParticleGroupState::ParticlesSoA::swapRemove(int index)
+{
+	for (std::vector<float>* const arr : {&posX, &posY, &posZ, &velX, &velY, &velZ, &scale, &maxLife, &timeSpendAlive,
+	                                      &opacity, &spriteIndex}) {
+		(*arr)[index] = arr->back();
+		arr->pop_back();
+	}
+}
+
+/// The values needed to simulate the particles, that are the same for all of them during an update.
+struct ParticlesSimulationParams {
+	const ParticleGroupDesc* pgDesc = nullptr;
+	float dt = 0.f;
+	/// The sum of all directional velocity forces (in the simulation space). They do not depend on the particle.
+	vec3f directionalForcesVelocity = vec3f(0.f);
+	/// True if there are forces that depend on the particle position.
+	bool hasPositionalForces = false;
+	/// If valid, the velocity added by the forces needs to be transformed with it.
+	Optional<mat4f> forcesTransform;
+};
+
+/// Simulates the particles in range [begin, end) for a single time step: computes their opacity, applies the velocity
+/// forces and drag and moves them. Returns the bounding box of the simulated particles.
+/// The particles are processed in small blocks, so the temporary data stays in the cache, each step runs as a SIMD
+/// kernel over the arrays of the block.
+static Box3f simulateParticlesRange(
+    ParticleGroupState::ParticlesSoA& particles, const ParticlesSimulationParams& params, int begin, int end)
+{
+	const ParticleGroupDesc& pgDesc = *params.pgDesc;
+	const float dt = params.dt;
+
+	Box3f bbox;
+
+	const int kBlockSize = 256;
+	float addedVelX[kBlockSize];
+	float addedVelY[kBlockSize];
+	float addedVelZ[kBlockSize];
+
+	for (int blockBegin = begin; blockBegin < end; blockBegin += kBlockSize) {
+		const int n = std::min(kBlockSize, end - blockBegin);
+
+		float* const posX = particles.posX.data() + blockBegin;
+		float* const posY = particles.posY.data() + blockBegin;
+		float* const posZ = particles.posZ.data() + blockBegin;
+		float* const velX = particles.velX.data() + blockBegin;
+		float* const velY = particles.velY.data() + blockBegin;
+		float* const velZ = particles.velZ.data() + blockBegin;
+		float* const timeSpendAlive = particles.timeSpendAlive.data() + blockBegin;
+
+		// Compute the opacity of the particles, fade-in after birth and fade-out before death.
+		computeFadeInOutBatch(
+		    particles.opacity.data() + blockBegin,
+		    timeSpendAlive,
+		    particles.maxLife.data() + blockBegin,
+		    pgDesc.alpha.fadeInTimeAfterBirth,
+		    pgDesc.alpha.fadeOutTimeBeforeDeath,
+		    n);
+
+		// Apply the velocity forces.
+		if (params.directionalForcesVelocity != vec3f(0.f)) {
+			addBatch(velX, params.directionalForcesVelocity.x, n);
+			addBatch(velY, params.directionalForcesVelocity.y, n);
+			addBatch(velZ, params.directionalForcesVelocity.z, n);
+		}
+
+		if (params.hasPositionalForces) {
+			std::fill(addedVelX, addedVelX + n, 0.f);
+			std::fill(addedVelY, addedVelY + n, 0.f);
+			std::fill(addedVelZ, addedVelZ + n, 0.f);
+
+			for (const Velocity& vel : pgDesc.velocityForces) {
+				if (vel.forceType == VelictyForce_towardsPoint) {
+					addDirectionsTowardsPointBatch(
+					    addedVelX,
+					    addedVelY,
+					    addedVelZ,
+					    posX,
+					    posY,
+					    posZ,
+					    vel.towardsPoint.pointLocation,
+					    vel.towardsPoint.velocityAmount,
+					    n);
+				}
+				else if (vel.forceType == VelictyForce_spherical) {
+					// Spherical is the same as towards point but in the opposite direction.
+					addDirectionsTowardsPointBatch(
+					    addedVelX,
+					    addedVelY,
+					    addedVelZ,
+					    posX,
+					    posY,
+					    posZ,
+					    vel.spherical.sphereCenter,
+					    -vel.spherical.velocityAmount,
+					    n);
+				}
+			}
+
+			if (params.forcesTransform.isValid()) {
+				transformDirectionsBatch(params.forcesTransform.get(), addedVelX, addedVelY, addedVelZ, n);
+			}
+
+			addScaledBatch(velX, addedVelX, 1.f, n);
+			addScaledBatch(velY, addedVelY, 1.f, n);
+			addScaledBatch(velZ, addedVelZ, 1.f, n);
+		}
+
+		// Apply the drag, the same as velocity -= velocity * drag * dt.
+		if (pgDesc.velocityDrag != vec3f(0.f)) {
+			mulBatch(velX, 1.f - pgDesc.velocityDrag.x * dt, n);
+			mulBatch(velY, 1.f - pgDesc.velocityDrag.y * dt, n);
+			mulBatch(velZ, 1.f - pgDesc.velocityDrag.z * dt, n);
+		}
+
+		addBatch(particles.spriteIndex.data() + blockBegin, dt * pgDesc.m_spriteFPS, n);
+
+		// Apply the velocity and acommodate the time change.
+		addScaledBatch(posX, velX, dt, n);
+		addScaledBatch(posY, velY, dt, n);
+		addScaledBatch(posZ, velZ, dt, n);
+		addBatch(timeSpendAlive, dt, n);
+
+		expandMinMaxBatch(posX, n, bbox.min.x, bbox.max.x);
+		expandMinMaxBatch(posY, n, bbox.min.y, bbox.max.y);
+		expandMinMaxBatch(posZ, n, bbox.min.z, bbox.max.z);
+	}
+
+	return bbox;
+}
+
+void ParticleGroupState::update(
+    bool isInWorldSpace, const mat4f node2world, const ParticleGroupDesc& pgDesc, float dt, ThreadPool* const threadPool)
 {
 	m_bboxFromLastUpdate = Box3f();
 	m_isInWorldSpace = isInWorldSpace;
@@ -242,12 +407,13 @@ void ParticleGroupState::update(bool isInWorldSpace, const mat4f node2world, con
 
 	const Optional<mat4f> spawnLocationMtx = m_isInWorldSpace ? Optional<mat4f>(node2world) : NullOptional();
 
-	// Delete all dead particles.
-	for (int t = 0; t < int(m_particles.size()); ++t) {
-		if (m_particles[t].isDead()) {
-			m_particles.erase(m_particles.begin() + t);
-			t--;
-			continue;
+	// Delete all dead particles. The last particle is moved in place of the dead one, so deleting is O(1).
+	for (int t = 0; t < m_particles.size();) {
+		if (m_particles.isDead(t)) {
+			m_particles.swapRemove(t);
+		}
+		else {
+			++t;
 		}
 	}
 
@@ -351,87 +517,118 @@ void ParticleGroupState::update(bool isInWorldSpace, const mat4f node2world, con
 			scale += m_rnd.nextInRange(pgDesc.birth.sizeScaleVariation);
 		}
 
-		const ParticleState newParticle = {
-		    spawnPos,
-		    initalVelocity,
-		    scale,
-		    life,
-		};
-
-		m_particles.emplace_back(newParticle);
+		m_particles.add(spawnPos, initalVelocity, scale, life);
 	}
 
 	// Update the particles - their position, velocity, scale and alpha.
-	for (ParticleState& particle : m_particles) {
-		// Compute the opacity of the particle.
-		particle.opacity = 1.f;
-
-		// Fade-in after birth.
-		if (pgDesc.alpha.fadeInTimeAfterBirth > 1e-3f &&
-		    particle.m_timeSpendAlive < pgDesc.alpha.fadeInTimeAfterBirth) {
-			particle.opacity *= sqr(clamp01(particle.m_timeSpendAlive / pgDesc.alpha.fadeInTimeAfterBirth));
+	ParticlesSimulationParams simParams;
+	simParams.pgDesc = &pgDesc;
+	simParams.dt = dt;
+	simParams.forcesTransform = spawnLocationMtx;
+	for (const Velocity& vel : pgDesc.velocityForces) {
+		if (vel.forceType == VelictyForce_directional) {
+			simParams.directionalForcesVelocity += computeAddedVelocity(m_rnd, vec3f(0.f), vel);
 		}
-
-		// Fade-out before death.
-		if (pgDesc.alpha.fadeOutTimeBeforeDeath > 1e-3f &&
-		    (particle.m_timeSpendAlive > particle.m_maxLife - pgDesc.alpha.fadeOutTimeBeforeDeath)) {
-			particle.opacity *=
-			    sqr(clamp01((particle.m_maxLife - particle.m_timeSpendAlive) / pgDesc.alpha.fadeOutTimeBeforeDeath));
+		else if (vel.forceType == VelictyForce_towardsPoint || vel.forceType == VelictyForce_spherical) {
+			simParams.hasPositionalForces = true;
 		}
+	}
 
-		vec3f addedVelocity = vec3f(0.f);
+	if (spawnLocationMtx.isValid()) {
+		simParams.directionalForcesVelocity = mat_mul_dir(spawnLocationMtx.get(), simParams.directionalForcesVelocity);
+	}
 
-		for (const Velocity& vel : pgDesc.velocityForces) {
-			addedVelocity += computeAddedVelocity(m_rnd, particle.pos, vel);
-		}
+	const int numParticles = m_particles.size();
+	if (threadPool != nullptr && numParticles >= kMinParticlesForParallelUpdate) {
+		// Split the particles in chunks, each producing its own bounding box that gets merged later.
+		const int chunkSize = kMinParticlesForParallelUpdate / 4;
+		std::vector<Box3f> chunkBBoxes((numParticles + chunkSize - 1) / chunkSize);
+		threadPool->parallelFor(numParticles, chunkSize, [&](int begin, int end) -> void {
+			chunkBBoxes[begin / chunkSize] = simulateParticlesRange(m_particles, simParams, begin, end);
+		});
 
-		if (spawnLocationMtx.isValid()) {
-			addedVelocity = mat_mul_dir(spawnLocationMtx.get(), addedVelocity);
+		for (const Box3f& chunkBBox : chunkBBoxes) {
+			m_bboxFromLastUpdate.expand(chunkBBox);
 		}
-
-		particle.velocity += addedVelocity;
-
-		particle.velocity -= particle.velocity * pgDesc.velocityDrag * dt;
-
-		particle.m_fSpriteIndex += dt * pgDesc.m_spriteFPS;
-
-		// Apply the velocity and acommodate the time change.
-		particle.pos += particle.velocity * dt;
-		particle.m_timeSpendAlive += dt;
-		m_bboxFromLastUpdate.expand(particle.pos);
+	}
+	else {
+		m_bboxFromLastUpdate = simulateParticlesRange(m_particles, simParams, 0, numParticles);
 	}
 
 	m_timeRunning += dt;
 }
 
-ParticleGroupState::SpriteRendData* ParticleGroupState::computeSpriteRenderData(
-    SGEContext& sgecon, const ParticleGroupDesc& pdesc, const ICamera& camera)
+const std::vector<uint32>& ParticleGroupState::computeDrawOrder(const vec3f& camPosWs, const vec3f& camLookWs)
 {
-	struct Vertex {
-		vec3f pos = vec3f(0.f);
-		vec4f color = vec4f(1.f);
-		vec3f normal = vec3f(1.f, 0.f, 0.f);
-		vec2f uv = vec2f(0.f);
+	const uint32 numParticles = uint32(m_particles.size());
+	const uint32 numParticlesPrev = uint32(m_drawOrder.size());
+
+	// Start from the order computed in the previous frame. The dead particles were swap-removed, so the indices
+	// that are now out of range are dropped and the particles born since then are appended at the end.
+	m_drawOrder.erase(
+	    std::remove_if(
+	        m_drawOrder.begin(), m_drawOrder.end(), [numParticles](uint32 idx) -> bool { return idx >= numParticles; }),
+	    m_drawOrder.end());
+	for (uint32 iParticle = numParticlesPrev; iParticle < numParticles; ++iParticle) {
+		m_drawOrder.push_back(iParticle);
+	}
+	sgeAssert(m_drawOrder.size() == numParticles);
+
+	if (numParticles == 0) {
+		return m_drawOrder;
+	}
+
+	// The depth of a particle is dot(n2w * position - camPosWs, camLookWs), which is linear in the position
+	// so it could be computed without transforming each particle in world space.
+	const mat4f particlesToWorld = getParticlesToWorldMtx();
+	const vec3f depthAxis = vec3f(
+	    dot(particlesToWorld.c0.xyz(), camLookWs),
+	    dot(particlesToWorld.c1.xyz(), camLookWs),
+	    dot(particlesToWorld.c2.xyz(), camLookWs));
+	const float depthOffset = dot(particlesToWorld.c3.xyz() - camPosWs, camLookWs);
+
+	const auto computeDepth = [&](const uint32 iParticle) -> float {
+		return m_particles.posX[iParticle] * depthAxis.x + m_particles.posY[iParticle] * depthAxis.y +
+		       m_particles.posZ[iParticle] * depthAxis.z + depthOffset;
 	};
 
-	if (m_particles.empty()) {
-		return nullptr;
+	float minDepth = FLT_MAX;
+	float maxDepth = -FLT_MAX;
+	for (uint32 iParticle = 0; iParticle < numParticles; ++iParticle) {
+		const float depth = computeDepth(iParticle);
+		minDepth = std::min(minDepth, depth);
+		maxDepth = std::max(maxDepth, depth);
 	}
 
-	// Sort the particles along the ray, so the generated vertex buffer have them sorted
-	// so they could be blender correctly during rendering.
-	vec3f const camPosWs = camera.getCameraPosition();
-	vec3f const camLookWs = camera.getCameraLookDir();
+	// Quantize the depth to 16 bits. The particles are drawn back to front, so the farthest particle gets the
+	// smallest key.
+	const float depthRange = maxDepth - minDepth;
+	const float depthToKey = depthRange > 1e-6f ? 65535.f / depthRange : 0.f;
 
-	indicesForSorting.resize(m_particles.size());
-	for (int t = 0; t < int(indicesForSorting.size()); ++t) {
-		indicesForSorting[t].index = t;
-		indicesForSorting[t].distanceAlongRay = projectPointOnLine(camPosWs, camLookWs, m_particles[t].pos);
+	m_drawOrderDepthKeys.resize(numParticles);
+	for (uint32 t = 0; t < numParticles; ++t) {
+		m_drawOrderDepthKeys[t] = uint16((maxDepth - computeDepth(m_drawOrder[t])) * depthToKey);
 	}
 
-	std::sort(indicesForSorting.begin(), indicesForSorting.end(), [&](const SortingData& a, const SortingData& b) {
-		return a.distanceAlongRay > b.distanceAlongRay;
-	});
+	// Most of the time the particles barely move between frames and the previous order is still correct.
+	if (isSortedByKey16(m_drawOrderDepthKeys.data(), numParticles) == false) {
+		radixSortByKey16(
+		    m_drawOrder.data(),
+		    m_drawOrderDepthKeys.data(),
+		    numParticles,
+		    m_drawOrderScratch,
+		    m_drawOrderDepthKeysScratch);
+	}
+
+	return m_drawOrder;
+}
+
+ParticleGroupState::SpriteRendData* ParticleGroupState::computeSpriteRenderData(
+    SGEContext& sgecon, const ParticleGroupDesc& pdesc, const ICamera& camera, const bool sortBackToFront)
+{
+	if (m_particles.empty()) {
+		return nullptr;
+	}
 
 	// Obtain the sprite texture and check if it is valid.
 	const AssetIface_Texture2D* texIface = pdesc.m_particlesSprite.getAssetInterface<AssetIface_Texture2D>();
@@ -441,6 +638,12 @@ ParticleGroupState::SpriteRendData* ParticleGroupState::computeSpriteRenderData(
 		return nullptr;
 	}
 
+	// Sort the particles along the ray, so the generated instances have them sorted
+	// so they could be blender correctly during rendering.
+	if (sortBackToFront) {
+		computeDrawOrder(camera.getCameraPosition(), camera.getCameraLookDir());
+	}
+
 	// Compute the sprite sub-images UV regions.
 	const int numFrames = std::max(pdesc.m_spriteGrid.volume(), 0);
 	if (numFrames != spriteFramesUVCache.size()) {
@@ -464,114 +667,74 @@ ParticleGroupState::SpriteRendData* ParticleGroupState::computeSpriteRenderData(
 	const float particleWidthWs = sprite->getDesc().texture2D.width / pdesc.m_spritePixelsPerUnit;
 	const float particleHeightWs = sprite->getDesc().texture2D.width / pdesc.m_spritePixelsPerUnit;
 
-	const float hx = particleWidthWs * 0.5f;
-	const float hy = particleHeightWs * 0.5f;
-
-	std::vector<Vertex> vertices;
-	vertices.reserve(int(m_particles.size()) * 6);
-
-	mat4f faceCameraMtx = camera.getView();
-	faceCameraMtx.c3 = vec4f(0.f, 0.f, 0.f, 1.f); // kill the translation.
-	faceCameraMtx = inverse(faceCameraMtx);       // TODO: Optimize.
-
-	// Generate the vertices so they are oriented towards the camera.
-	for (const SortingData& sortedData : indicesForSorting) {
-		const ParticleState& p = m_particles[sortedData.index];
-		// Compute the transformation that will make the particle face the camera.
-		vec3f particlePosRaw = p.pos;
-		vec3f particlePosTransformed = (!m_isInWorldSpace) ? m_n2w.transfPos(particlePosRaw) : particlePosRaw;
-
-		mat4f orientationMtx = mat4f::getTranslation(particlePosTransformed) * faceCameraMtx;
-
-		vec2f uv0 = vec2f(0.f);
-		vec2f uv1 = vec2f(1.f);
-		int frmIndex = int(p.m_fSpriteIndex) % int(spriteFramesUVCache.size());
-		if (frmIndex >= 0 && frmIndex < spriteFramesUVCache.size()) {
-			uv0 = spriteFramesUVCache[frmIndex].first;
-			uv1 = spriteFramesUVCache[frmIndex].second;
-		}
-
-		// A template vertices represeting a quad, centered at (0,0,0) with correct size,
-		// later we are going to transform these vertices to get the final transform
-		// for the vertex buffer.
-
-		vec4f particleColor = vec4f(1.f, 1.f, 1.f, p.opacity);
-
-		const Vertex templateVetex[6] = {
-		    Vertex{vec3f(-hx, -hy, 0.f), particleColor, vec3f::getAxis(2), uv0},
-		    Vertex{vec3f(+hx, -hy, 0.f), particleColor, vec3f::getAxis(2), vec2f(uv1.x, uv0.y)},
-		    Vertex{vec3f(+hx, +hy, 0.f), particleColor, vec3f::getAxis(2), vec2f(uv1.x, uv1.y)},
-
-		    Vertex{vec3f(-hx, -hy, 0.f), particleColor, vec3f::getAxis(2), vec2f(uv0.x, uv0.y)},
-		    Vertex{vec3f(+hx, +hy, 0.f), particleColor, vec3f::getAxis(2), uv1},
-		    Vertex{vec3f(-hx, +hy, 0.f), particleColor, vec3f::getAxis(2), vec2f(uv0.x, uv1.y)},
-		};
-
-		for (const Vertex& templateVtx : templateVetex) {
-			Vertex vtx = templateVtx;
-			vtx.pos *= fabsf(p.scale) * m_n2w.extractUnsignedScalingVector();
-			vtx.pos = mat_mul_pos(orientationMtx, vtx.pos);
-			vtx.normal = mat_mul_dir(orientationMtx, vtx.normal); // TODO: inverse transpose.
-			vertices.push_back(vtx);
+	const vec3f n2wScaling = m_n2w.extractUnsignedScalingVector();
+	const vec2f halfSizeWs = vec2f(particleWidthWs * n2wScaling.x, particleHeightWs * n2wScaling.y) * 0.5f;
+
+	// Generate one instance per particle, the quads get oriented towards the camera in the vertex shader.
+	m_spriteInstances.resize(m_particles.size());
+	for (size_t t = 0; t < m_spriteInstances.size(); ++t) {
+		const uint32 iParticle = sortBackToFront ? m_drawOrder[t] : uint32(t);
+		SpriteParticleInstance& instance = m_spriteInstances[t];
+
+		const vec3f particlePosRaw = m_particles.getPosition(iParticle);
+		instance.position = (!m_isInWorldSpace) ? m_n2w.transfPos(particlePosRaw) : particlePosRaw;
+		instance.halfSize = halfSizeWs * fabsf(m_particles.scale[iParticle]);
+		instance.color = vec4f(1.f, 1.f, 1.f, m_particles.opacity[iParticle]);
+		instance.uvRegion = vec4f(0.f, 0.f, 1.f, 1.f);
+
+		if (spriteFramesUVCache.empty() == false) {
+			const int frmIndex = int(m_particles.spriteIndex[iParticle]) % int(spriteFramesUVCache.size());
+			if (frmIndex >= 0) {
+				const Pair<vec2f, vec2f>& uvRegion = spriteFramesUVCache[frmIndex];
+				instance.uvRegion = vec4f(uvRegion.first.x, uvRegion.first.y, uvRegion.second.x, uvRegion.second.y);
+			}
 		}
 	}
 
-	// Generate the Geometry data.
 	if (spriteRenderData.isValid() == false) {
 		spriteRenderData = SpriteRendData();
 	}
 
-	const int strideSizeBytes = sizeof(vertices[0]);
-	const int neededVtxBufferByteSize = int(vertices.size()) * strideSizeBytes;
+	// Upload the instances to the ring buffer. The buffer is big enough to hold the instances for a few frames,
+	// it only gets reallocated when the number of particles grows.
+	const uint32 kNumFramesInRingBuffer = 3;
+	const uint32 neededByteSize = uint32(m_spriteInstances.size() * sizeof(SpriteParticleInstance));
 
-	const bool isVtxBufferCorrectSize = spriteRenderData->vertexBuffer.IsResourceValid() &&
-	                                    spriteRenderData->vertexBuffer->getDesc().sizeBytes == neededVtxBufferByteSize;
+	SpriteRendData& srd = spriteRenderData.get();
+	if (srd.instanceBuffer.IsResourceValid() == false || srd.instanceBuffer->getDesc().sizeBytes < neededByteSize) {
+		uint32 capacityBytes = 4096;
+		while (capacityBytes < neededByteSize * kNumFramesInRingBuffer) {
+			capacityBytes *= 2;
+		}
 
-	if (isVtxBufferCorrectSize == false) {
-		BufferDesc const vbDesc = BufferDesc::GetDefaultVertexBuffer(neededVtxBufferByteSize, ResourceUsage::Dynamic);
-		spriteRenderData->vertexBuffer = sgecon.getDevice()->requestResource<Buffer>();
-		spriteRenderData->vertexBuffer->create(vbDesc, vertices.data());
+		BufferDesc const vbDesc = BufferDesc::GetDefaultVertexBuffer(capacityBytes, ResourceUsage::Dynamic);
+		srd.instanceBuffer = sgecon.getDevice()->requestResource<Buffer>();
+		srd.instanceBuffer->create(vbDesc, nullptr);
+		srd.ringWriteByteOffset = 0;
 	}
-	else {
-		// The vertex buffer is large enough, just update it's contents.
-		void* mappedMem = sgecon.map(spriteRenderData->vertexBuffer, Map::WriteDiscard);
-		if (mappedMem) {
-			memcpy(mappedMem, vertices.data(), neededVtxBufferByteSize);
-		}
-		sgecon.unMap(spriteRenderData->vertexBuffer);
+
+	// Append after the instances from the previous frames, they might still be in use by the GPU.
+	// When there is no more space, start from the beginning and let the driver give us a new memory for the buffer.
+	Map::Enum mapMode = Map::WriteNoOverwrite;
+	if (srd.ringWriteByteOffset + neededByteSize > srd.instanceBuffer->getDesc().sizeBytes) {
+		mapMode = Map::WriteDiscard;
+		srd.ringWriteByteOffset = 0;
 	}
 
-	VertexDecl vertexDecl[4] = {
-	    VertexDecl(0, "a_position", UniformType::Float3, 0),
-	    VertexDecl(0, "a_color", UniformType::Float4, 3 * sizeof(float)),
-	    VertexDecl(0, "a_normal", UniformType::Float3, 7 * sizeof(float)),
-	    VertexDecl(0, "a_uv", UniformType::Float2, 10 * sizeof(float)),
-	};
+	char* const mappedMem = (char*)sgecon.map(srd.instanceBuffer, mapMode);
+	if (mappedMem == nullptr) {
+		return nullptr;
+	}
 
-	VertexDeclIndex vertexDeclIdx = sgecon.getDevice()->getVertexDeclIndex(vertexDecl, SGE_ARRSZ(vertexDecl));
+	memcpy(mappedMem + srd.ringWriteByteOffset, m_spriteInstances.data(), neededByteSize);
+	sgecon.unMap(srd.instanceBuffer);
 
-	spriteRenderData->geometry = Geometry(
-	    spriteRenderData->vertexBuffer,
-	    nullptr,
-	    nullptr,
-	    -1,
-	    vertexDeclIdx,
-	    true,
-	    true,
-	    true,
-	    false,
-	    PrimitiveTopology::TriangleList,
-	    0,
-	    0,
-	    strideSizeBytes,
-	    UniformType::Unknown,
-	    int(vertices.size()));
+	srd.instancesByteOffset = srd.ringWriteByteOffset;
+	srd.numInstances = int(m_spriteInstances.size());
+	srd.texture = sprite;
+	srd.ringWriteByteOffset += neededByteSize;
 
-	spriteRenderData->material.diffuseColorSrc = DefaultPBRMtlData::diffuseColorSource_diffuseMap;
-	spriteRenderData->material.diffuseTexture = sprite;
-	spriteRenderData->material.tintByVertexColor = true;
-	spriteRenderData->material.forceNoLighting = true;
-	return &spriteRenderData.get();
+	return &srd;
 }
 
 //--------------------------------------------------------------
@@ -589,8 +752,11 @@ void TraitParticlesSimple::update(const GameUpdateSets& u)
 		desc.m_particlesSprite.update();
 
 		// TODO: handle duplicated names!
-		m_pgroupState[desc.m_name].update(m_isInWorldSpace, getActor()->getTransformMtx(), desc, u.dt);
+		m_pgroupState[desc.m_name].update(
+		    m_isInWorldSpace, getActor()->getTransformMtx(), desc, u.dt, getWorld()->getUpdateThreadPool());
 	}
+
+	getActor()->markBBoxDirty();
 }
 
 Box3f TraitParticlesSimple::getBBoxOS() const
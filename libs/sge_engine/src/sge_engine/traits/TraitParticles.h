@@ -1,6 +1,7 @@
 #pragma once
 
 #include "sge_core/materials/DefaultPBRMtl/DefaultPBRMtl.h"
+#include "sge_core/shaders/SpriteParticlesShader.h"
 #include "sge_engine/Actor.h"
 #include "sge_engine/AssetProperty.h"
 #include "sge_utils/containers/Optional.h"
@@ -13,6 +14,7 @@
 namespace sge {
 
 struct ICamera;
+struct ThreadPool;
 struct TraitParticlesSimpleRenderItem;
 struct TraitParticlesProgrammableRenderItem;
 
@@ -152,27 +154,55 @@ struct ParticleGroupDesc {
 // ParticleGroupState
 //--------------------------------------------------------------
 struct SGE_ENGINE_API ParticleGroupState {
-	struct ParticleState {
-		vec3f pos = vec3f(0.f);
-		vec3f velocity = vec3f(0.f);
-		float scale = 1.f;
-		float m_maxLife = 0.f;
-		float opacity = 1.f;
-
-		float m_timeSpendAlive = 0.f;
-		float m_fSpriteIndex =
-		    0.f; // The sprites are used for rendering this points to the sub-image being used for visualization.
-
-		bool isDead() const { return m_timeSpendAlive >= m_maxLife; }
+	/// The state of all particles in the group stored as a structure of arrays, each member holds one property of all
+	/// particles. This way the simulation could process many particles at once with SIMD.
+	/// The order of the particles is not preserved, dead particles are removed by moving the last one in their place.
+	struct ParticlesSoA {
+		int size() const { return int(posX.size()); }
+		bool empty() const { return posX.empty(); }
+
+		void reserve(size_t capacity);
+		void clear();
+
+		void add(const vec3f& pos, const vec3f& velocity, float scale, float maxLife);
+
+		/// Removes the particle by moving the last one in its place (so the order is not preserved).
+		void swapRemove(int index);
+
+		vec3f getPosition(int index) const { return vec3f(posX[index], posY[index], posZ[index]); }
+		bool isDead(int index) const { return timeSpendAlive[index] >= maxLife[index]; }
+
+		std::vector<float> posX;
+		std::vector<float> posY;
+		std::vector<float> posZ;
+		std::vector<float> velX;
+		std::vector<float> velY;
+		std::vector<float> velZ;
+		std::vector<float> scale;
+		std::vector<float> maxLife;
+		std::vector<float> timeSpendAlive;
+		std::vector<float> opacity;
+		/// The sprites are used for rendering this points to the sub-image being used for visualization.
+		std::vector<float> spriteIndex;
 	};
 
+	/// Groups with at least this many particles get simulated on multiple threads, if a thread pool is provided.
+	static constexpr int kMinParticlesForParallelUpdate = 16384;
+
 	// Sprite visulaization mode
+	// The particles are drawn as instances of a single quad, see @SpriteParticlesShader.
 	struct SpriteRendData {
-		GpuHandle<Buffer> vertexBuffer;
-		// GpuHandle<Buffer> indexBuffer;
-
-		Geometry geometry;
-		DefaultPBRMtlData material;
+		/// A persistent dynamic buffer of @SpriteParticleInstance used as a ring buffer.
+		/// Each call to @computeSpriteRenderData appends the instances after the ones from the previous call
+		/// (mapped with Map::WriteNoOverwrite) and the buffer gets discarded only when it wraps around.
+		/// This way the buffer isn't reallocated every frame and we do not stall waiting for the GPU.
+		GpuHandle<Buffer> instanceBuffer;
+		uint32 ringWriteByteOffset = 0;
+
+		/// The instances to be drawn.
+		uint32 instancesByteOffset = 0;
+		int numInstances = 0;
+		Texture* texture = nullptr;
 	};
 
 	mat4f getParticlesToWorldMtx() const { return m_isInWorldSpace ? mat4f::getIdentity() : m_n2w; }
@@ -187,28 +217,46 @@ struct SGE_ENGINE_API ParticleGroupState {
 
 	float m_timeRunning = 0.f; // Time in seconds the simulation went running.
 
-	std::vector<ParticleState> m_particles;
+	ParticlesSoA m_particles;
 	Optional<PerlinNoise3D> m_noise;
 
 	std::vector<Pair<vec2f, vec2f>> spriteFramesUVCache;
 
 	Optional<SpriteRendData> spriteRenderData;
-	struct SortingData {
-		int index;
-		float distanceAlongRay = FLT_MAX;
-	};
-	std::vector<SortingData> indicesForSorting;
+
+	/// The particle indices sorted back to front. The order from the previous frame is used as a starting point
+	/// for the current one, as usually it changes very little between frames.
+	std::vector<uint32> m_drawOrder;
+	std::vector<uint16> m_drawOrderDepthKeys;
+	std::vector<uint32> m_drawOrderScratch;
+	std::vector<uint16> m_drawOrderDepthKeysScratch;
+	std::vector<SpriteParticleInstance> m_spriteInstances;
 
 	mat4f m_n2w = mat4f::getIdentity();
 	bool m_isInWorldSpace = true;
 
   public:
-	void update(bool isInWorldSpace, const mat4f node2world, const ParticleGroupDesc& spawnDesc, float dt);
+	/// @param threadPool (optional) if specified large groups are simulated on its workers,
+	///        see @kMinParticlesForParallelUpdate.
+	void update(
+	    bool isInWorldSpace,
+	    const mat4f node2world,
+	    const ParticleGroupDesc& spawnDesc,
+	    float dt,
+	    ThreadPool* const threadPool = nullptr);
+
+	/// Sorts the particles back to front (along @camLookWs) and returns their indices in that order.
+	/// The depth is quantized to 16 bits and the particles are radix sorted, starting from the order computed
+	/// in the previous call. If that order is still valid no sorting is done at all.
+	const std::vector<uint32>& computeDrawOrder(const vec3f& camPosWs, const vec3f& camLookWs);
 
 	/// @param camera the camera to be used to billboard the particles.
-	SpriteRendData* computeSpriteRenderData(SGEContext& sgecon, const ParticleGroupDesc& pdesc, const ICamera& camera);
+	/// @param sortBackToFront false when the order doesn't matter (shadow maps), it also keeps the order computed
+	///        for the main camera as a starting point for the next frame.
+	SpriteRendData* computeSpriteRenderData(
+	    SGEContext& sgecon, const ParticleGroupDesc& pdesc, const ICamera& camera, const bool sortBackToFront);
 
-	const std::vector<ParticleState>& getParticles() const { return m_particles; }
+	const ParticlesSoA& getParticles() const { return m_particles; }
 
 	/// Returns the bounding box in the space they are being simulated (world or node).
 	Box3f getBBox() const { return m_bboxFromLastUpdate; }
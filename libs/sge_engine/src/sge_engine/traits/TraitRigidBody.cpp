@@ -87,6 +87,8 @@ void TraitRigidBody::onPlayStateChanged(bool const isStartingToPlay)
 
 void TraitRigidBody::setTrasnform(const transf3d& transf, bool killVelocity)
 {
+	sgeAssert(getWorld()->isUpdatingInParallel() == false && "Rigid bodies cannot be moved from the update workers!");
+
 	if (m_rigidBody.isValid()) {
 		m_rigidBody.setTransformAndScaling(transf, killVelocity);
 
@@ -99,6 +101,8 @@ void TraitRigidBody::setTrasnform(const transf3d& transf, bool killVelocity)
 		else if (m_rigidBody.getBulletGhostObject()) {
 			// getWorld()->physicsWorld.dynamicsWorld->updateSingleAabb(m_rigidBody.getBulletGhostObject());
 		}
+
+		getWorld()->physicsWorld.onRigidBodyChanged.invokeEvent(&m_rigidBody);
 	}
 }
 
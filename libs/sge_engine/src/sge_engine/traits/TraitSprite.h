@@ -129,6 +129,10 @@ struct SGE_ENGINE_API TraitSprite : public Trait {
 		for (TraitSpriteEntry& image : images) {
 			hadChange = image.m_assetProperty.update() || hadChange;
 		}
+
+		if (hadChange && getActor() != nullptr) {
+			getActor()->markBBoxDirty();
+		}
 		return hadChange;
 	}
 
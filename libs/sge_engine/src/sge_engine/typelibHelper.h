@@ -2,6 +2,11 @@
 
 #include "sge_core/typelib/typeLib.h"
 
-#define ReflAddActor(T) ReflAddType(T) ReflInherits(T, sge::Actor)
-#define ReflAddObject(T) ReflAddType(T) ReflInherits(T, sge::GameObject)
-#define ReflAddScript(T) ReflAddType(T) ReflInherits(T, sge::Script)
+/// Start a definition of a game object type. Besides the inheritance these add the @TypeFlags
+/// that could be deduced form the type itself (see @computeGameObjectTypeFlags).
+#define ReflAddActor(T) \
+	ReflAddType(T) ReflInherits(T, sge::Actor).addTypeFlag(sge::computeGameObjectTypeFlags<T>())
+#define ReflAddObject(T) \
+	ReflAddType(T) ReflInherits(T, sge::GameObject).addTypeFlag(sge::computeGameObjectTypeFlags<T>())
+#define ReflAddScript(T) \
+	ReflAddType(T) ReflInherits(T, sge::Script).addTypeFlag(sge::computeGameObjectTypeFlags<T>())
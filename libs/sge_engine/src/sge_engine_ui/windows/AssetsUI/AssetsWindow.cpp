@@ -66,6 +66,20 @@ JsonValue* createDefaultPBRFromImportedMtl(ExternalPBRMaterialSettings& external
 	return jMaterial;
 }
 
+/// Cooks the block compressed *.dds equivalent of the texture on all threads,
+/// otherwise it would get cooked on a single thread when the texture gets loaded.
+static void cookTextureOnAllThreads(const std::string& texturePath, const AssetTextureMeta& textureMeta)
+{
+	if (textureMeta.compression == textureCompression_none || extractFileExtension(texturePath.c_str()) == "dds") {
+		return;
+	}
+
+	std::vector<char> ddsFileData;
+	if (cookTextureAsset(texturePath.c_str(), textureMeta, ddsFileData, getCore()->getWorkerThreadPool()) == false) {
+		sgeLogError("Failed to cook the texture %s!", texturePath.c_str());
+	}
+}
+
 AssetsWindow::AssetsWindow(std::string windowName)
     : m_windowName(std::move(windowName))
 {
@@ -123,9 +137,9 @@ bool AssetsWindow::importAsset(AssetImportData& aid)
 			// Make sure the import directory exists.
 			createDirectory(extractFileDir(aid.outputDir.c_str(), false).c_str());
 
-			// Convert the 3d model to our internal type.
+			// Convert the 3d model to our internal type. The binary format is used as it loads faster.
 			ModelWriter modelWriter;
-			[[maybe_unused]] const bool succeeded = modelWriter.write(importedModel, fullAssetPath.c_str());
+			[[maybe_unused]] const bool succeeded = modelWriter.writeBinary(importedModel, fullAssetPath.c_str());
 
 			std::string notificationMsg = string_format("Imported %s", fullAssetPath.c_str());
 			sgeLogInfo(notificationMsg.c_str());
@@ -241,9 +255,9 @@ bool AssetsWindow::importAsset(AssetImportData& aid)
 
 				std::string path = aid.outputDir + "/" + model.propsedFilename;
 
-				// Convert the 3d model to our internal type.
+				// Convert the 3d model to our internal type. The binary format is used as it loads faster.
 				ModelWriter modelWriter;
-				[[maybe_unused]] const bool succeeded = modelWriter.write(model.importedModel, path.c_str());
+				[[maybe_unused]] const bool succeeded = modelWriter.writeBinary(model.importedModel, path.c_str());
 
 				AssetPtr assetModel = assetLib->getAssetFromFile(path.c_str());
 				assetLib->reloadAssetModified(assetModel);
@@ -264,10 +278,15 @@ bool AssetsWindow::importAsset(AssetImportData& aid)
 		}
 	}
 	else if (aid.assetType == assetIface_texture2d) {
-		// TODO: DDS conversion.
 		createDirectory(extractFileDir(aid.outputDir.c_str(), false).c_str());
 		copyFile(aid.fileToImportPath.c_str(), fullAssetPath.c_str());
 
+		// The newly imported textures are not block compressed, as the importer cannot tell what they hold.
+		// Normal maps for example look bad in BC1/BC3 and BC5 drops the 3rd channel used by the shaders.
+		// The compression could be enabled per texture in its settings, the re-imported ones keep their settings.
+		const AssetTextureMeta textureMeta = loadAssetTextureMeta2(fullAssetPath);
+		cookTextureOnAllThreads(fullAssetPath, textureMeta);
+
 		AssetPtr assetTexture = assetLib->getAssetFromFile(fullAssetPath.c_str());
 		assetLib->reloadAssetModified(assetTexture);
 
@@ -981,6 +1000,23 @@ void AssetsWindow::doPreviewAssetTexture2D(AssetIface_Texture2D* texIface)
 		}
 	};
 
+	const auto getCompressionName = [](TextureCompression compression) -> const char* {
+		switch (compression) {
+			case textureCompression_none:
+				return "None (decoded on load)";
+			case textureCompression_auto:
+				return "Auto (BC1 or BC3 if there is alpha)";
+			case textureCompression_bc1:
+				return "BC1 (RGB)";
+			case textureCompression_bc3:
+				return "BC3 (RGBA)";
+			case textureCompression_bc5:
+				return "BC5 (RG, for normal maps)";
+			default:
+				return "Unknown";
+		}
+	};
+
 	const auto doAddressModeUI = [&getAddressModeName](const char* comboLabel, TextureAddressMode::Enum& mode) -> bool {
 		bool hadChange = false;
 		if (ImGui::BeginCombo(comboLabel, getAddressModeName(mode))) {
@@ -1019,6 +1055,25 @@ void AssetsWindow::doPreviewAssetTexture2D(AssetIface_Texture2D* texIface)
 		getLog()->writeWarning("Auto MipMap generation will take effect after a restart!");
 	}
 
+	if (extractFileExtension(explorePreviewAsset->getPath().c_str()) != "dds") {
+		ImGuiEx::Label("Compression");
+		if (ImGui::BeginCombo("##Compression", getCompressionName(texMeta.compression))) {
+			for (const TextureCompression compression :
+			     {textureCompression_none,
+			      textureCompression_auto,
+			      textureCompression_bc1,
+			      textureCompression_bc3,
+			      textureCompression_bc5}) {
+				if (ImGui::Selectable(getCompressionName(compression))) {
+					texMeta.compression = compression;
+					hadChange = true;
+				}
+			}
+
+			ImGui::EndCombo();
+		}
+	}
+
 	hadChange |= doAddressModeUI("Tiling X", texMeta.assetSamplerDesc.addressModes[0]);
 	hadChange |= doAddressModeUI("Tiling Y", texMeta.assetSamplerDesc.addressModes[1]);
 	hadChange |= doAddressModeUI("Tiling Z", texMeta.assetSamplerDesc.addressModes[2]);
@@ -1046,6 +1101,7 @@ void AssetsWindow::doPreviewAssetTexture2D(AssetIface_Texture2D* texIface)
 		// Save the modified settings to the *.info file of the texture.
 		if (AssetTexture2d* assetTex2d = dynamic_cast<AssetTexture2d*>(explorePreviewAsset.get())) {
 			assetTex2d->saveTextureSettingsToInfoFile();
+			cookTextureOnAllThreads(assetTex2d->getPath(), texMeta);
 			getCore()->getAssetLib()->queueAssetForReload(explorePreviewAsset);
 		}
 		else {
@@ -247,28 +247,39 @@ void EditorWindow::newScene(bool UNUSED(forceKeepSameInspector))
 	//}
 }
 
-void EditorWindow::loadWorldFromFile(
-    const char* const filename, const char* overrideWorkingFilename, bool forceKeepSameInspector)
+/// Creates a window that plays a copy of the specified world.
+/// The world is copied through the binary level format as it is much faster to save and load than the json.
+static GamePlayWindow* createGamePlayWindow(const GameWorld& world)
 {
-	std::vector<char> fileContents;
-	if (FileReadStream::readFile(filename, fileContents)) {
-		fileContents.push_back('\0');
-		loadWorldFromJson(
-		    fileContents.data(),
-		    true,
-		    overrideWorkingFilename != nullptr ? overrideWorkingFilename : filename,
-		    forceKeepSameInspector);
+	const double startTime = Timer::now_seconds();
 
-		addReasecentScene(filename);
+	const std::vector<char> worldData = serializeGameWorldBinary(&world);
+	GamePlayWindow* const gameplayWindow = new GamePlayWindow("Game Play", worldData.data(), worldData.size());
 
-		return;
-	}
+	sgeLogInfo("Entered play mode in %f seconds.\n", Timer::now_seconds() - startTime);
+	return gameplayWindow;
+}
 
-	sgeAssert(false);
+void EditorWindow::loadWorldFromFile(
+    const char* const filename, const char* overrideWorkingFilename, bool forceKeepSameInspector)
+{
+	// The file could be a json or a binary level, SceneInstance detects the format.
+	PerSceneInstanceData* const sceneInstData = prepareInstanceForLoading(
+	    overrideWorkingFilename != nullptr ? overrideWorkingFilename : filename, forceKeepSameInspector);
+	sceneInstData->sceneInstace->loadWorldFromFile(filename, true);
+
+	addReasecentScene(filename);
 }
 
 void EditorWindow::loadWorldFromJson(
     const char* const json, bool disableAutoSepping, const char* const workingFileName, bool loadInNewInstance)
+{
+	PerSceneInstanceData* const sceneInstData = prepareInstanceForLoading(workingFileName, loadInNewInstance);
+	sceneInstData->sceneInstace->loadWorldFromJson(json, disableAutoSepping);
+}
+
+EditorWindow::PerSceneInstanceData*
+    EditorWindow::prepareInstanceForLoading(const char* const workingFileName, bool loadInNewInstance)
 {
 	if (loadInNewInstance && getActiveInstance() == nullptr) {
 		int iInstance = newEmptyInstance();
@@ -288,7 +299,7 @@ void EditorWindow::loadWorldFromJson(
 		sceneInstData->displayName = "Unsaved Scene";
 	}
 
-	sceneInstData->sceneInstace->loadWorldFromJson(json, disableAutoSepping);
+	return sceneInstData;
 }
 
 void EditorWindow::saveInstanceToFile(int iInstance, bool forceAskForFilename)
@@ -323,6 +334,34 @@ void EditorWindow::saveInstanceToFile(int iInstance, bool forceAskForFilename)
 	saveInstanceToSpecificFile(iInstance, filename.c_str());
 }
 
+void EditorWindow::exportInstanceAsBinaryLevel(int iInstance)
+{
+	PerSceneInstanceData* instData = getInstanceData(iInstance);
+	if (instData == nullptr) {
+		return;
+	}
+
+	std::filesystem::create_directories("./assets/levels");
+	std::string filename = FileSaveDialog("Export Binary Level...", "*.lvl\0*.lvl\0", "lvl", "./assets/levels");
+	if (filename.empty()) {
+		return;
+	}
+
+	if (extractFileExtension(filename.c_str()).empty()) {
+		filename += ".lvl";
+	}
+
+	// The working file of the instance stays the same, the binary level is just an exported copy.
+	if (instData->sceneInstace->saveWorldToFile(filename.c_str(), true)) {
+		getEngineGlobal()->showNotification(string_format("SUCCEEDED exporting '%s'", filename.c_str()));
+		sgeLogInfo("[SAVE_LEVEL] Exporting binary game level succeeded. File is %s\n", filename.c_str());
+	}
+	else {
+		getEngineGlobal()->showNotification(string_format("FAILED exporting '%s'", filename.c_str()));
+		sgeLogError("[SAVE_LEVEL] Exporting binary game level failed. File is %s\n", filename.c_str());
+	}
+}
+
 void EditorWindow::saveInstanceToSpecificFile(int iInstance, const char* filename)
 {
 	if (isStringEmpty(filename)) {
@@ -472,6 +511,10 @@ void EditorWindow::update(SGEContext* const sgecon, GameInspector* UNUSED(inspec
 			if (ImGui::MenuItem(ICON_FK_FLOPPY_O " Save As...")) {
 				saveInstanceToFile(iActiveInstance, true);
 			}
+
+			if (ImGui::MenuItem(ICON_FK_FLOPPY_O " Export Binary Level...")) {
+				exportInstanceAsBinaryLevel(iActiveInstance);
+			}
 			ImGui::EndMenu();
 		}
 
@@ -546,14 +589,7 @@ void EditorWindow::update(SGEContext* const sgecon, GameInspector* UNUSED(inspec
 				GamePlayWindow* gameplayWindow = getEngineGlobal()->findFirstWindowOfType<GamePlayWindow>();
 
 				if (gameplayWindow == nullptr) {
-					JsonValueBuffer jvb;
-					JsonValue* jWorld = serializeGameWorld(&getActiveInstance()->getWorld(), jvb);
-					JsonWriter jw;
-					WriteStdStringStream stringStream;
-					jw.write(&stringStream, jWorld);
-
-					gameplayWindow = new GamePlayWindow("Game Play", stringStream.serializedString.c_str());
-					getEngineGlobal()->addWindow(gameplayWindow);
+					getEngineGlobal()->addWindow(createGamePlayWindow(getActiveInstance()->getWorld()));
 				}
 			}
 
@@ -728,12 +764,7 @@ void EditorWindow::update(SGEContext* const sgecon, GameInspector* UNUSED(inspec
 				getEngineGlobal()->removeWindow(oldGameplayWindow);
 			}
 
-			JsonValueBuffer jvb;
-			JsonValue* jWorld = serializeGameWorld(&getActiveInstance()->getWorld(), jvb);
-			JsonWriter jw;
-			WriteStdStringStream stringStream;
-			jw.write(&stringStream, jWorld);
-			getEngineGlobal()->addWindow(new GamePlayWindow("Game Play", stringStream.serializedString.c_str()));
+			getEngineGlobal()->addWindow(createGamePlayWindow(getActiveInstance()->getWorld()));
 		}
 		ImGuiEx::TextTooltip("Play the level in isolation.");
 
@@ -68,6 +68,8 @@ struct SGE_ENGINE_API EditorWindow : public IImGuiWindow {
 	    const char* const json, bool disableAutoSepping, const char* const workingFileName, bool loadInNewInstance);
 	void saveInstanceToFile(int iInstance, bool forceAskForFilename);
 	void saveInstanceToSpecificFile(int iInstance, const char* filename);
+	/// Asks for a filename and saves the instance there as a binary level (see serializeGameWorldBinary).
+	void exportInstanceAsBinaryLevel(int iInstance);
 
 	void prepareForHotReload(SceneInstanceSerializedData& sceneInstancesData);
 	void recoverFromHotReload(const SceneInstanceSerializedData& sceneInstancesData);
@@ -93,6 +95,10 @@ struct SGE_ENGINE_API EditorWindow : public IImGuiWindow {
 	PerSceneInstanceData* getActiveInstanceData();
 	PerSceneInstanceData* getInstanceData(int iInstance);
 
+  private:
+	/// Prepares the active instance (or a new one) for a world to be loaded in it.
+	PerSceneInstanceData* prepareInstanceForLoading(const char* const workingFileName, bool loadInNewInstance);
+
   private:
 	Assets m_assets;
 
@@ -12,7 +12,8 @@
 
 namespace sge {
 
-GamePlayWindow::GamePlayWindow(std::string windowName, const char* const worldJsonString)
+GamePlayWindow::GamePlayWindow(
+    std::string windowName, const char* const worldData, const size_t worldDataSizeBytes)
     : m_windowName(std::move(windowName))
     , m_isOpened(true)
 {
@@ -21,7 +22,7 @@ GamePlayWindow::GamePlayWindow(std::string windowName, const char* const worldJs
 	m_sceneInstance.newScene();
 	m_gameDrawer->initialize(&m_sceneInstance.getWorld());
 
-	m_sceneInstance.loadWorldFromJson(worldJsonString, false);
+	m_sceneInstance.loadWorldFromMemory(worldData, worldDataSizeBytes, false);
 
 	m_sceneInstance.getWorld().m_useEditorCamera = false;
 	m_sceneInstance.getWorld().isEdited = false;
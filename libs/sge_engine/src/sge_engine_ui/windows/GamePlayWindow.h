@@ -14,7 +14,8 @@ struct InputState;
 struct IGameDrawer;
 
 struct SGE_ENGINE_API GamePlayWindow : public IImGuiWindow {
-	GamePlayWindow(std::string windowName, const char* const worldJsonString);
+	/// @param [in] worldData the world to be played, as json or as a binary level (see serializeGameWorldBinary).
+	GamePlayWindow(std::string windowName, const char* const worldData, const size_t worldDataSizeBytes);
 
 	void close() override { m_isOpened = false; }
 	bool isClosed() override { return !m_isOpened; }
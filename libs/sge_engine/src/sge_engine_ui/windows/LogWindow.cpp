@@ -23,15 +23,21 @@ void LogWindow::update(
 
 		const Log& log = *getLog();
 
-		if (ImGui::BeginChild("MessagesWindow", ImVec2(-1.f, -1.f))) {
-			const std::vector<Log::Message>& messages = log.getMessages();
+		// The messages are copied only when there are new ones.
+		const uint64 numProcessedMessages = log.getNumProcessedMessages();
+		const bool hasNewMessages = numProcessedMessages != m_numCopiedMessages;
+		if (hasNewMessages) {
+			log.copyMessages(m_messages);
+			m_numCopiedMessages = numProcessedMessages;
+		}
 
+		if (ImGui::BeginChild("MessagesWindow", ImVec2(-1.f, -1.f))) {
 			int startMessage = 0;
 			if (!m_showOldMessages) {
-				startMessage = maxOf(0, (int)messages.size() - 40);
+				startMessage = maxOf(0, (int)m_messages.size() - 40);
 			}
-			for (int iMessage = startMessage; iMessage < messages.size(); iMessage++) {
-				const Log::Message& msg = messages[iMessage];
+			for (int iMessage = startMessage; iMessage < m_messages.size(); iMessage++) {
+				const Log::Message& msg = m_messages[iMessage];
 				switch (msg.type) {
 					case Log::messageType_check:
 						ImGui::TextColored(ImVec4(0.f, 1.f, 0.f, 1.f), msg.message.c_str());
@@ -55,10 +61,9 @@ void LogWindow::update(
 
 			// Check if new messages have appeared since the last update.
 			// If so, scroll to the bottom of the messages.
-			if (prevUpdateMessageCount != int(log.getMessages().size())) {
+			if (hasNewMessages) {
 				ImGui::SetScrollHereY(1.0f);
 			}
-			prevUpdateMessageCount = int(log.getMessages().size());
 		}
 		ImGui::EndChild();
 	}
@@ -4,7 +4,9 @@
 
 #include "imgui/imgui.h"
 #include "sge_engine/GameObject.h"
+#include "sge_log/Log.h"
 #include <string>
+#include <vector>
 
 namespace sge {
 
@@ -25,7 +27,9 @@ struct SGE_ENGINE_API LogWindow : public IImGuiWindow {
 	bool m_showOldMessages = false;
 	bool m_showInfoMessages = true;
 	std::string m_windowName;
-	int prevUpdateMessageCount = 0;
+	/// A copy of the messages kept by the log, updated when there are new messages.
+	std::vector<Log::Message> m_messages;
+	uint64 m_numCopiedMessages = 0;
 };
 
 
@@ -138,6 +138,11 @@ void ProperyEditorUIGen::doMemberUI(
 		static bool uiTransformInLocalSpace = false;
 
 		const bool isLogicTransform = member.is(&Actor::m_logicTransform);
+		if (isLogicTransform && actor) {
+			// The member is read directly below, make sure it isn't waiting on a moved parent to get resolved.
+			actor->getTransform();
+		}
+
 		const bool actorHasParent = inspector.getWorld()->getParentActor(gameObject->getId()) != nullptr;
 
 		ImGuiEx::BeginGroupPanel(memberName, ImVec2(-1.f, -1.f));
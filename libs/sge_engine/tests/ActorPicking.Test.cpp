@@ -0,0 +1,112 @@
+#include "doctest/doctest.h"
+#include "sge_core/Camera.h"
+#include "sge_engine/ActorPicking.h"
+#include "sge_engine/GameWorld.h"
+#include "sge_engine/traits/TraitPath.h"
+#include "sge_engine/typelibHelper.h"
+#include "sge_renderer/renderer/renderer.h"
+
+namespace sge {
+
+/// An actor with a bounding box only, it gets picked by its oriented box.
+struct ATestPickBox : public Actor {
+	Box3f getBBoxOS() const override { return Box3f::getFromHalfDiagonal(vec3f(1.f)); }
+	void create() override {}
+};
+
+/// A straight path from the origin of the actor to +X.
+struct TraitPath3DTestLine final : public TraitPath3D {
+	SGE_TraitDecl_Final(TraitPath3DTestLine);
+
+	bool isEmpty() const final { return false; }
+	float getTotalLength() final { return length; }
+	bool evaluateAtDistance(vec3f* outPosition, vec3f* outTanget, float const distance) final
+	{
+		if (outPosition) {
+			*outPosition = vec3f(clamp(distance, 0.f, length), 0.f, 0.f);
+		}
+
+		if (outTanget) {
+			*outTanget = vec3f(1.f, 0.f, 0.f);
+		}
+
+		return true;
+	}
+
+	float length = 10.f;
+};
+
+/// An actor picked by its path, it has no bounding box.
+struct ATestPickPath : public Actor {
+	Box3f getBBoxOS() const override { return Box3f(); }
+	void create() override { registerTrait(traitPath); }
+
+	TraitPath3DTestLine traitPath;
+};
+
+ReflBlock()
+{
+	ReflAddActor(ATestPickBox);
+	ReflAddActor(ATestPickPath);
+}
+
+namespace {
+	RawCamera makeTestCamera(const vec3f& camPos)
+	{
+		const mat4f view = mat4f::getLookAtRH(camPos, vec3f(0.f), vec3f(0.f, 1.f, 0.f));
+		return RawCamera(
+		    camPos, view, mat4f::getPerspectiveFovRH(deg2rad(60.f), 1.f, 0.1f, 1000.f, 0.f, kIsTexcoordStyleD3D));
+	}
+} // namespace
+
+TEST_CASE("ActorPicker oriented boxes are not hit from inside")
+{
+	GameWorld world;
+	world.create();
+
+	ATestPickBox* const actor = world.allocObjectT<ATestPickBox>();
+	actor->setOrientation(quatf::getAxisAngle(vec3f::getAxis(1), deg2rad(45.f)));
+	world.update(GameUpdateSets(1.f / 60.f, false, InputState()));
+
+	const RawCamera camera = makeTestCamera(vec3f(0.f, 0.f, 10.f));
+	ActorPicker picker;
+	picker.build(world, camera);
+
+	float t = 0.f;
+	const int iPicked = picker.pickRay(Ray(vec3f(0.f, 0.f, 10.f), vec3f(0.f, 0.f, -1.f)), &t);
+	REQUIRE(picker.getItemActor(iPicked) == actor);
+	CHECK(t == doctest::Approx(10.f - sqrtf(2.f)).epsilon(1e-4f));
+
+	// The ray passes through the world space bounding box but misses the rotated box.
+	CHECK(picker.pickRay(Ray(vec3f(1.2f, 10.f, 1.2f), vec3f(0.f, -1.f, 0.f))) == -1);
+
+	// A ray starting inside of the box.
+	CHECK(picker.pickRay(Ray(vec3f(0.f), vec3f(0.f, 0.f, -1.f))) == -1);
+
+	std::vector<int> items;
+	picker.pickFrustum(*camera.getFrustumWS(), items);
+	CHECK(items.size() == 1);
+}
+
+TEST_CASE("ActorPicker paths are picked near their segments")
+{
+	GameWorld world;
+	world.create();
+
+	ATestPickPath* const actor = world.allocObjectT<ATestPickPath>();
+	actor->setPosition(vec3f(-5.f, 0.f, 0.f));
+	world.update(GameUpdateSets(1.f / 60.f, false, InputState()));
+
+	ActorPicker picker;
+	picker.build(world, makeTestCamera(vec3f(0.f, 0.f, 10.f)));
+
+	float t = 0.f;
+	const int iPicked = picker.pickRay(Ray(vec3f(0.f, 0.02f, 10.f), vec3f(0.f, 0.f, -1.f)), &t);
+	REQUIRE(picker.getItemActor(iPicked) == actor);
+	CHECK(t == doctest::Approx(10.f).epsilon(1e-3f));
+
+	CHECK(picker.pickRay(Ray(vec3f(0.f, 1.f, 10.f), vec3f(0.f, 0.f, -1.f))) == -1);
+	CHECK(picker.pickRay(Ray(vec3f(6.f, 0.f, 10.f), vec3f(0.f, 0.f, -1.f))) == -1);
+}
+
+} // namespace sge
@@ -0,0 +1,107 @@
+#include "doctest/doctest.h"
+#include "sge_core/Camera.h"
+#include "sge_engine/GameWorld.h"
+#include "sge_engine/traits/TraitModel.h"
+#include "sge_engine/typelibHelper.h"
+#include "sge_renderer/renderer/renderer.h"
+
+namespace sge {
+
+/// An actor with a model of known bounds, the model itself is never rendered.
+struct ATestAnimatedModel : public Actor {
+	Box3f getBBoxOS() const override { return m_traitModel.getBBoxOS(); }
+	void create() override
+	{
+		registerTrait(m_traitModel);
+
+		EvaluatedModel evalModel;
+		evalModel.aabox = Box3f::getFromHalfDiagonal(vec3f(1.f));
+		m_traitModel.m_models.push_back(ModelEntry());
+		m_traitModel.m_models.back().customEvalModel = std::move(evalModel);
+	}
+
+	TraitModel m_traitModel;
+};
+
+ReflBlock()
+{
+	ReflAddActor(ATestAnimatedModel);
+}
+
+TEST_CASE("TraitModel shouldEvaluateAnimation skips by screen size and visibility")
+{
+	GameWorld world;
+	world.create();
+
+	ATestAnimatedModel* const actor = world.allocObjectT<ATestAnimatedModel>();
+	TraitModel& traitModel = actor->m_traitModel;
+
+	// A 60 degrees vertical field of view, the box at a distance of 10 covers 0.3 of the screen height.
+	const vec3f camPos = vec3f(0.f, 0.f, 10.f);
+	const mat4f view = mat4f::getLookAtRH(camPos, vec3f(0.f), vec3f(0.f, 1.f, 0.f));
+	const RawCamera camera(
+	    camPos, view, mat4f::getPerspectiveFovRH(deg2rad(60.f), 1.f, 0.1f, 1000.f, 0.f, kIsTexcoordStyleD3D));
+
+	const auto evaluateFrames = [&](const int numFrames) -> std::vector<bool> {
+		std::vector<bool> result;
+		for (int t = 0; t < numFrames; ++t) {
+			result.push_back(traitModel.shouldEvaluateAnimation(&camera));
+		}
+		return result;
+	};
+
+	SUBCASE("Disabled by default")
+	{
+		actor->setPosition(vec3f(0.f, 0.f, 20.f));
+		CHECK(evaluateFrames(3) == std::vector<bool>{true, true, true});
+	}
+
+	SUBCASE("Always evaluated without a camera")
+	{
+		traitModel.animationLOD.enabled = true;
+		traitModel.animationLOD.skipWhenOffscreen = true;
+		actor->setPosition(vec3f(0.f, 0.f, 20.f));
+		CHECK(traitModel.shouldEvaluateAnimation(nullptr));
+	}
+
+	SUBCASE("Big models are evaluated every frame")
+	{
+		traitModel.animationLOD.enabled = true;
+		CHECK(evaluateFrames(3) == std::vector<bool>{true, true, true});
+	}
+
+	SUBCASE("Small models are evaluated every minRateFrameInterval frames")
+	{
+		traitModel.animationLOD.enabled = true;
+		traitModel.animationLOD.minRateFrameInterval = 4;
+		actor->setPosition(vec3f(0.f, 0.f, -90.f));
+		CHECK(evaluateFrames(9) == std::vector<bool>{true, false, false, false, true, false, false, false, true});
+	}
+
+	SUBCASE("Models in between get an interval in between")
+	{
+		traitModel.animationLOD.enabled = true;
+		traitModel.animationLOD.fullRateScreenSize = 0.3f;
+		traitModel.animationLOD.minRateScreenSize = 0.1f;
+		traitModel.animationLOD.minRateFrameInterval = 3;
+		// About 0.2 of the screen height, halfway between the two sizes.
+		actor->setPosition(vec3f(0.f, 0.f, -5.f));
+		CHECK(evaluateFrames(5) == std::vector<bool>{true, false, true, false, true});
+	}
+
+	SUBCASE("Offscreen models are skipped only with skipWhenOffscreen")
+	{
+		traitModel.animationLOD.enabled = true;
+		actor->setPosition(vec3f(0.f, 0.f, 20.f));
+		CHECK(evaluateFrames(3) == std::vector<bool>{true, true, true});
+
+		traitModel.animationLOD.skipWhenOffscreen = true;
+		CHECK(evaluateFrames(3) == std::vector<bool>{false, false, false});
+
+		// Once visible again the model gets evaluated immediately.
+		actor->setPosition(vec3f(0.f));
+		CHECK(evaluateFrames(1) == std::vector<bool>{true});
+	}
+}
+
+} // namespace sge
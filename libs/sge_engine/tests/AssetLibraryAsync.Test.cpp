@@ -0,0 +1,153 @@
+#include "doctest/doctest.h"
+#include "sge_core/AssetLibrary/AssetLibrary.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace sge {
+
+/// A text asset that needs no files. It records when it gets decoded and finalized.
+struct TestAsyncAsset : public Asset, public IAssetInterface_Text {
+	TestAsyncAsset(std::string assetPath, AssetLibrary& ownerAssetLib)
+	    : Asset(assetPath, ownerAssetLib)
+	{
+	}
+
+	const std::string& getText() const override { return m_assetPath; }
+
+	bool loadAssetFromFile(const char* const UNUSED(path)) override { return true; }
+
+	void prepareLoadAssetFromFile(const char* const UNUSED(path)) override
+	{
+		isPrepareStarted = true;
+		while (shouldBlockPrepare) {
+			std::this_thread::yield();
+		}
+
+		numPrepares++;
+	}
+
+	bool finalizeLoadAssetFromFile(const char* const UNUSED(path)) override
+	{
+		if (finalizeOrder) {
+			finalizeOrder->push_back(m_assetPath);
+		}
+
+		return true;
+	}
+
+	void getPreparedDependencies(std::vector<AssetDependency>& outDependencies) const override
+	{
+		for (const std::string& dependency : dependencies) {
+			outDependencies.push_back(AssetDependency{dependency, std::string()});
+		}
+	}
+
+	std::vector<std::string> dependencies;
+	std::vector<std::string>* finalizeOrder = nullptr;
+	std::atomic<bool> shouldBlockPrepare{false};
+	std::atomic<bool> isPrepareStarted{false};
+	std::atomic<int> numPrepares{0};
+};
+
+TEST_CASE("AssetLibrary asynchronous loads finalize the dependencies first")
+{
+	AssetLibrary assetLib;
+	assetLib.setNumLoadingWorkers(2);
+
+	std::vector<std::string> finalizeOrder;
+	std::shared_ptr<TestAsyncAsset> model = assetLib.newAsset<TestAsyncAsset>("async_test/model.txt");
+	std::shared_ptr<TestAsyncAsset> texture = assetLib.newAsset<TestAsyncAsset>("async_test/texture.txt");
+	model->dependencies.push_back("async_test/texture.txt");
+	model->finalizeOrder = &finalizeOrder;
+	texture->finalizeOrder = &finalizeOrder;
+
+	CHECK(assetLib.getAssetFromFileAsync("async_test/model.txt").get() == model.get());
+	CHECK(model->getStatus() == AssetStatus_Loading);
+
+	assetLib.waitForAsyncLoading();
+
+	CHECK(assetLib.getNumAsyncLoadsPending() == 0);
+	CHECK(model->getStatus() == AssetStatus_Loaded);
+	CHECK(texture->getStatus() == AssetStatus_Loaded);
+	CHECK(model->numPrepares == 1);
+	CHECK(texture->numPrepares == 1);
+	REQUIRE(finalizeOrder.size() == 2);
+	CHECK(finalizeOrder[0] == "async_test/texture.txt");
+	CHECK(finalizeOrder[1] == "async_test/model.txt");
+}
+
+TEST_CASE("AssetLibrary asynchronous loads of assets depending on each other")
+{
+	AssetLibrary assetLib;
+	assetLib.setNumLoadingWorkers(2);
+
+	std::shared_ptr<TestAsyncAsset> first = assetLib.newAsset<TestAsyncAsset>("async_test/first.txt");
+	std::shared_ptr<TestAsyncAsset> second = assetLib.newAsset<TestAsyncAsset>("async_test/second.txt");
+	first->dependencies.push_back("async_test/second.txt");
+	second->dependencies.push_back("async_test/first.txt");
+
+	assetLib.getAssetFromFileAsync("async_test/first.txt");
+	assetLib.waitForAsyncLoading();
+
+	CHECK(assetLib.getNumAsyncLoadsPending() == 0);
+	CHECK(first->getStatus() == AssetStatus_Loaded);
+	CHECK(second->getStatus() == AssetStatus_Loaded);
+	CHECK(first->numPrepares == 1);
+	CHECK(second->numPrepares == 1);
+}
+
+TEST_CASE("AssetLibrary asynchronous loads requested synchronously are finished immediately")
+{
+	AssetLibrary assetLib;
+	assetLib.setNumLoadingWorkers(2);
+
+	std::shared_ptr<TestAsyncAsset> asset = assetLib.newAsset<TestAsyncAsset>("async_test/asset.txt");
+	assetLib.getAssetFromFileAsync("async_test/asset.txt");
+
+	CHECK(assetLib.getAssetFromFile("async_test/asset.txt").get() == asset.get());
+	CHECK(asset->getStatus() == AssetStatus_Loaded);
+	CHECK(asset->numPrepares == 1);
+	CHECK(assetLib.updateAsyncLoading() == 0);
+}
+
+TEST_CASE("AssetLibrary cancelled asynchronous loads skip the decoding that hasn't started")
+{
+	AssetLibrary assetLib;
+	assetLib.setNumLoadingWorkers(1);
+
+	std::shared_ptr<TestAsyncAsset> busy = assetLib.newAsset<TestAsyncAsset>("async_test/busy.txt");
+	std::shared_ptr<TestAsyncAsset> queued = assetLib.newAsset<TestAsyncAsset>("async_test/queued.txt");
+
+	// Keep the only loading worker busy, so the next asset stays queued.
+	busy->shouldBlockPrepare = true;
+	assetLib.getAssetFromFileAsync("async_test/busy.txt");
+	while (busy->isPrepareStarted == false) {
+		std::this_thread::yield();
+	}
+
+	assetLib.getAssetFromFileAsync("async_test/queued.txt");
+
+	// The decoding that has already started cannot be interrupted, the cancellation waits for it.
+	std::thread unblocker([&busy]() -> void {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		busy->shouldBlockPrepare = false;
+	});
+	assetLib.cancelAsyncLoading();
+	unblocker.join();
+
+	CHECK(assetLib.getNumAsyncLoadsPending() == 0);
+	CHECK(busy->numPrepares == 1);
+	CHECK(queued->numPrepares == 0);
+	CHECK(busy->getStatus() == AssetStatus_NotLoaded);
+	CHECK(queued->getStatus() == AssetStatus_NotLoaded);
+
+	// The cancelled assets could be requested again.
+	assetLib.getAssetFromFileAsync("async_test/queued.txt");
+	assetLib.waitForAsyncLoading();
+	CHECK(queued->getStatus() == AssetStatus_Loaded);
+	CHECK(queued->numPrepares == 1);
+}
+
+} // namespace sge
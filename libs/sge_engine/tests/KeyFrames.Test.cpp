@@ -0,0 +1,126 @@
+#include "doctest/doctest.h"
+#include "sge_core/model/Model.h"
+
+namespace sge {
+
+namespace {
+	/// Position keyframes at the times 1, 2 and 3 with x equal to 10 times the time.
+	KeyFrames makeTestPositionKeyFrames()
+	{
+		KeyFrames keyFrames;
+		keyFrames.positionKeyFrames.setKey(1.f, vec3f(10.f, 0.f, 0.f));
+		keyFrames.positionKeyFrames.setKey(2.f, vec3f(20.f, 0.f, 0.f));
+		keyFrames.positionKeyFrames.setKey(3.f, vec3f(30.f, 0.f, 0.f));
+		return keyFrames;
+	}
+
+	float evaluatePositionX(const KeyFrames& keyFrames, const float t, KeyFramesCursor* const cursor)
+	{
+		transf3d result;
+		keyFrames.evaluate(result, t, cursor);
+		return result.p.x;
+	}
+} // namespace
+
+TEST_CASE("KeyFrameTrack keeps the keyframes sorted")
+{
+	KeyFrameTrack<float> track;
+	track.setKey(3.f, 30.f);
+	track.setKey(1.f, 10.f);
+	track.setKey(2.f, 20.f);
+	track.setKey(2.f, 25.f);
+
+	CHECK(track.times == std::vector<float>{1.f, 2.f, 3.f});
+	CHECK(track.values == std::vector<float>{10.f, 25.f, 30.f});
+}
+
+TEST_CASE("KeyFrames evaluation outside of the keyframes range")
+{
+	const KeyFrames keyFrames = makeTestPositionKeyFrames();
+	KeyFramesCursor cursor;
+
+	CHECK(evaluatePositionX(keyFrames, 0.f, &cursor) == doctest::Approx(10.f));
+	CHECK(cursor.positionKey == -1);
+
+	CHECK(evaluatePositionX(keyFrames, 5.f, &cursor) == doctest::Approx(30.f));
+	CHECK(cursor.positionKey == 2);
+
+	// Without a cursor the result must be the same.
+	CHECK(evaluatePositionX(keyFrames, 0.f, nullptr) == doctest::Approx(10.f));
+	CHECK(evaluatePositionX(keyFrames, 5.f, nullptr) == doctest::Approx(30.f));
+}
+
+TEST_CASE("KeyFrames evaluation exactly at the keyframes")
+{
+	const KeyFrames keyFrames = makeTestPositionKeyFrames();
+	KeyFramesCursor cursor;
+
+	for (int iKey = 0; iKey < keyFrames.positionKeyFrames.size(); ++iKey) {
+		const float t = keyFrames.positionKeyFrames.times[iKey];
+		CHECK(evaluatePositionX(keyFrames, t, &cursor) == doctest::Approx(t * 10.f));
+		CHECK(cursor.positionKey == iKey);
+	}
+}
+
+TEST_CASE("KeyFrames evaluation with a cursor when seeking")
+{
+	const KeyFrames keyFrames = makeTestPositionKeyFrames();
+	KeyFramesCursor cursor;
+
+	SUBCASE("Forward")
+	{
+		CHECK(evaluatePositionX(keyFrames, 1.5f, &cursor) == doctest::Approx(15.f));
+		CHECK(cursor.positionKey == 0);
+
+		// The next keyframe.
+		CHECK(evaluatePositionX(keyFrames, 2.5f, &cursor) == doctest::Approx(25.f));
+		CHECK(cursor.positionKey == 1);
+	}
+
+	SUBCASE("Forward over multiple keyframes")
+	{
+		CHECK(evaluatePositionX(keyFrames, 0.5f, &cursor) == doctest::Approx(10.f));
+		CHECK(evaluatePositionX(keyFrames, 2.75f, &cursor) == doctest::Approx(27.5f));
+		CHECK(cursor.positionKey == 1);
+	}
+
+	SUBCASE("Backwards")
+	{
+		CHECK(evaluatePositionX(keyFrames, 2.5f, &cursor) == doctest::Approx(25.f));
+		CHECK(evaluatePositionX(keyFrames, 1.25f, &cursor) == doctest::Approx(12.5f));
+		CHECK(cursor.positionKey == 0);
+		CHECK(evaluatePositionX(keyFrames, 0.f, &cursor) == doctest::Approx(10.f));
+		CHECK(cursor.positionKey == -1);
+	}
+
+	SUBCASE("Cursor out of range")
+	{
+		cursor.positionKey = 100;
+		CHECK(evaluatePositionX(keyFrames, 2.5f, &cursor) == doctest::Approx(25.f));
+		CHECK(cursor.positionKey == 1);
+	}
+}
+
+TEST_CASE("KeyFrames quantized rotations match the original ones")
+{
+	KeyFrames keyFrames;
+	keyFrames.rotationKeyFrames.setKey(0.f, quatf::getAxisAngle(vec3f::getAxis(1), 0.f));
+	keyFrames.rotationKeyFrames.setKey(1.f, quatf::getAxisAngle(vec3f::getAxis(1), deg2rad(90.f)));
+
+	transf3d original;
+	keyFrames.evaluate(original, 0.5f);
+
+	keyFrames.quantizeRotations();
+	REQUIRE(keyFrames.hasQuantizedRotations());
+	CHECK(keyFrames.rotationKeyFrames.values.empty());
+	CHECK(keyFrames.rotationKeyFrames.times.size() == 2);
+
+	transf3d quantized;
+	keyFrames.evaluate(quantized, 0.5f);
+	CHECK(quantized.r.x == doctest::Approx(original.r.x).epsilon(1e-3f));
+	CHECK(quantized.r.y == doctest::Approx(original.r.y).epsilon(1e-3f));
+	CHECK(quantized.r.z == doctest::Approx(original.r.z).epsilon(1e-3f));
+	CHECK(quantized.r.w == doctest::Approx(original.r.w).epsilon(1e-3f));
+}
+
+} // namespace sge
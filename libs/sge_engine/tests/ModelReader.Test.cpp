@@ -0,0 +1,171 @@
+#include "doctest/doctest.h"
+#include "sge_core/model/Model.h"
+#include "sge_core/model/ModelBinaryFormat.h"
+#include "sge_core/model/ModelReader.h"
+#include "sge_core/model/ModelWriter.h"
+#include "sge_utils/io/IStream.h"
+
+#include <cstring>
+
+namespace sge {
+
+namespace {
+	/// Creates a model with a single triangle attached to a child of the root node.
+	void createTriangleModel(Model& model)
+	{
+		const int iRoot = model.makeNewNode();
+		model.setRootNodeIndex(iRoot);
+		model.nodeAt(iRoot)->name = "root";
+
+		const int iMaterial = model.makeNewMaterial();
+		model.materialAt(iMaterial)->name = "material";
+
+		const int iMesh = model.makeNewMesh();
+		ModelMesh* const mesh = model.meshAt(iMesh);
+		mesh->name = "triangle";
+		mesh->primitiveTopology = PrimitiveTopology::TriangleList;
+		mesh->vertexDecl.push_back(VertexDecl(0, "a_position", UniformType::Float3, 0));
+		mesh->stride = int(sizeof(vec3f));
+		mesh->numVertices = 3;
+		mesh->numElements = 3;
+		mesh->ibFmt = UniformType::Uint;
+
+		const vec3f positions[3] = {vec3f(0.f), vec3f(1.f, 0.f, 0.f), vec3f(0.f, 0.f, 1.f)};
+		mesh->vertexBufferRaw.resize(sizeof(positions));
+		memcpy(mesh->vertexBufferRaw.data(), positions, sizeof(positions));
+
+		const uint32 indices[3] = {0, 1, 2};
+		mesh->indexBufferRaw.resize(sizeof(indices));
+		memcpy(mesh->indexBufferRaw.data(), indices, sizeof(indices));
+
+		mesh->aabox = Box3f(vec3f(0.f), vec3f(1.f, 0.f, 1.f));
+
+		const int iNode = model.makeNewNode();
+		model.nodeAt(iNode)->name = "node";
+		model.nodeAt(iNode)->meshAttachments.push_back(MeshAttachment(iMesh, iMaterial));
+		model.nodeAt(iRoot)->childNodes.push_back(iNode);
+	}
+
+	std::vector<char> writeBinaryModel(const Model& model)
+	{
+		WriteByteStream stream;
+		ModelWriter().writeBinary(model, &stream);
+		return stream.serializedData;
+	}
+
+	bool loadModelFromMemory(const std::vector<char>& fileData, Model& model)
+	{
+		ReadByteStream stream(fileData);
+		return ModelReader().loadModel(ModelLoadSettings(), &stream, model);
+	}
+} // namespace
+
+TEST_CASE("ModelReader binary models are loaded from streams")
+{
+	Model sourceModel;
+	createTriangleModel(sourceModel);
+
+	Model model;
+	REQUIRE(loadModelFromMemory(writeBinaryModel(sourceModel), model));
+	REQUIRE(model.numMeshes() == 1);
+	REQUIRE(model.numNodes() == 2);
+
+	const span<const char> sourceVertices = sourceModel.meshAt(0)->getVertexBufferData();
+	const span<const char> vertices = model.meshAt(0)->getVertexBufferData();
+	REQUIRE(vertices.size() == sourceVertices.size());
+	CHECK(memcmp(vertices.data(), sourceVertices.data(), vertices.size()) == 0);
+	CHECK(model.meshAt(0)->getIndexBufferData().size() == sourceModel.meshAt(0)->getIndexBufferData().size());
+}
+
+TEST_CASE("ModelReader binary models with chunks out of the file are rejected")
+{
+	Model sourceModel;
+	createTriangleModel(sourceModel);
+	const std::vector<char> fileData = writeBinaryModel(sourceModel);
+
+	ModelBinaryHeader header;
+	REQUIRE(fileData.size() >= sizeof(header));
+	memcpy(&header, fileData.data(), sizeof(header));
+	REQUIRE(header.numChunks > 1);
+
+	Model model;
+
+	SUBCASE("Truncated chunk table")
+	{
+		const std::vector<char> truncatedData(fileData.begin(), fileData.end() - sizeof(ModelBinaryChunkDesc) / 2);
+		CHECK(loadModelFromMemory(truncatedData, model) == false);
+	}
+
+	SUBCASE("Chunk table offset overflowing with its size")
+	{
+		std::vector<char> corruptedData = fileData;
+		header.chunkTableByteOffset = ~uint64(0) - 8;
+		memcpy(corruptedData.data(), &header, sizeof(header));
+		CHECK(loadModelFromMemory(corruptedData, model) == false);
+	}
+
+	SUBCASE("Chunk offset overflowing with its size")
+	{
+		std::vector<char> corruptedData = fileData;
+		ModelBinaryChunkDesc chunk;
+		const size_t lastChunkOffset = size_t(header.chunkTableByteOffset) + (header.numChunks - 1) * sizeof(chunk);
+		memcpy(&chunk, corruptedData.data() + lastChunkOffset, sizeof(chunk));
+		chunk.byteOffset = ~uint64(0) - 8;
+		memcpy(corruptedData.data() + lastChunkOffset, &chunk, sizeof(chunk));
+		CHECK(loadModelFromMemory(corruptedData, model) == false);
+	}
+}
+
+TEST_CASE("ModelReader binary models with indices out of range are rejected")
+{
+	Model sourceModel;
+	createTriangleModel(sourceModel);
+	ModelNode* const childNode = sourceModel.nodeAt(sourceModel.nodeAt(sourceModel.getRootNodeIndex())->childNodes[0]);
+
+	SUBCASE("Child node index")
+	{
+		childNode->childNodes.push_back(sourceModel.numNodes());
+	}
+
+	SUBCASE("Mesh attachment index")
+	{
+		childNode->meshAttachments.push_back(MeshAttachment(sourceModel.numMeshes(), -1));
+	}
+
+	SUBCASE("Material attachment index")
+	{
+		childNode->meshAttachments.push_back(MeshAttachment(0, sourceModel.numMaterials()));
+	}
+
+	SUBCASE("Bone node index")
+	{
+		sourceModel.meshAt(0)->bones.push_back(ModelMeshBone(mat4f::getIdentity(), -1));
+	}
+
+	Model model;
+	CHECK(loadModelFromMemory(writeBinaryModel(sourceModel), model) == false);
+}
+
+TEST_CASE("ModelReader binary models with the root node index out of range are rejected")
+{
+	Model sourceModel;
+	createTriangleModel(sourceModel);
+	std::vector<char> fileData = writeBinaryModel(sourceModel);
+
+	// The model doesn't allow an invalid root node index, patch the file instead.
+	// The index is the first value in the metadata chunk.
+	ModelBinaryHeader header;
+	memcpy(&header, fileData.data(), sizeof(header));
+	ModelBinaryChunkDesc metadataChunk;
+	const size_t metadataChunkDescOffset =
+	    size_t(header.chunkTableByteOffset) + kModelBinaryMetadataChunkId * sizeof(metadataChunk);
+	memcpy(&metadataChunk, fileData.data() + metadataChunkDescOffset, sizeof(metadataChunk));
+
+	const sint32 rootNodeIndex = sint32(sourceModel.numNodes());
+	memcpy(fileData.data() + metadataChunk.byteOffset, &rootNodeIndex, sizeof(rootNodeIndex));
+
+	Model model;
+	CHECK(loadModelFromMemory(fileData, model) == false);
+}
+
+} // namespace sge
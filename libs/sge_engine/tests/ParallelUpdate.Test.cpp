@@ -0,0 +1,61 @@
+#include "doctest/doctest.h"
+#include "sge_engine/GameWorld.h"
+#include "sge_engine/traits/TraitRigidBody.h"
+#include "sge_engine/typelibHelper.h"
+
+namespace sge {
+
+/// A static box that moves itself on every update, safe to be updated in parallel.
+struct ATestParallelMover : public Actor {
+	Box3f getBBoxOS() const override { return Box3f::getFromHalfDiagonal(vec3f(0.5f)); }
+
+	void create() override
+	{
+		registerTrait(m_traitRB);
+		m_traitRB.getRigidBody()->create(this, CollsionShapeDesc::createBox(getBBoxOS()), 0.f, false);
+	}
+
+	void update(const GameUpdateSets& UNUSED(u)) override { setPosition(getPosition() + vec3f(1.f, 0.f, 0.f)); }
+
+	TraitRigidBody m_traitRB;
+};
+
+ReflBlock()
+{
+	ReflAddActor(ATestParallelMover).addTypeFlag(TF_ParallelUpdate);
+}
+
+TEST_CASE("GameWorld the rigid bodies and the spatial index follow the actors updated in parallel")
+{
+	GameWorld world;
+	world.setNumUpdateWorkers(4);
+	world.create();
+
+	// Enough actors for the update to get split between the workers.
+	std::vector<ATestParallelMover*> movers;
+	for (int t = 0; t < 1000; ++t) {
+		ATestParallelMover* const mover = world.allocObjectT<ATestParallelMover>();
+		mover->setPosition(vec3f(0.f, 0.f, float(t) * 2.f));
+		movers.push_back(mover);
+	}
+
+	const GameUpdateSets updateSets(1.f / 60.f, false, InputState());
+	for (int iFrame = 0; iFrame < 3; ++iFrame) {
+		world.update(updateSets);
+	}
+
+	for (ATestParallelMover* const mover : movers) {
+		const vec3f rigidBodyPosition = mover->m_traitRB.getRigidBody()->getTransformAndScaling().p;
+		CHECK(mover->getPosition().x > 0.f);
+		CHECK(rigidBodyPosition.x == mover->getPosition().x);
+		CHECK(rigidBodyPosition.z == mover->getPosition().z);
+	}
+
+	// The spatial index should have moved them as well.
+	int numFound = 0;
+	const Box3f boxWs = Box3f::getFromHalfDiagonal(vec3f(0.1f), movers[500]->getPosition());
+	world.queryActorsInBox(boxWs, [&](Actor* const actor) -> void { numFound += actor == movers[500] ? 1 : 0; });
+	CHECK(numFound == 1);
+}
+
+} // namespace sge
@@ -0,0 +1,94 @@
+#include "doctest/doctest.h"
+#include "sge_engine/GameWorld.h"
+#include "sge_engine/traits/TraitRigidBody.h"
+#include "sge_engine/typelibHelper.h"
+
+#include <algorithm>
+
+namespace sge {
+
+/// A dynamic unit box.
+struct ATestPhysicsBox : public Actor {
+	Box3f getBBoxOS() const override { return Box3f::getFromHalfDiagonal(vec3f(0.5f)); }
+
+	void create() override
+	{
+		registerTrait(m_traitRB);
+		m_traitRB.getRigidBody()->create(this, CollsionShapeDesc::createBox(getBBoxOS()), 1.f, false);
+	}
+
+	TraitRigidBody m_traitRB;
+};
+
+/// A static box the boxes are standing on, its top is at y = 0.
+struct ATestPhysicsGround : public Actor {
+	Box3f getBBoxOS() const override { return Box3f(vec3f(-100.f, -1.f, -100.f), vec3f(100.f, 0.f, 100.f)); }
+
+	void create() override
+	{
+		registerTrait(m_traitRB);
+		m_traitRB.getRigidBody()->create(this, CollsionShapeDesc::createBox(getBBoxOS()), 0.f, false);
+	}
+
+	TraitRigidBody m_traitRB;
+};
+
+ReflBlock()
+{
+	ReflAddActor(ATestPhysicsBox);
+	ReflAddActor(ATestPhysicsGround);
+}
+
+TEST_CASE("GameWorld the manifold list shard is always in range")
+{
+	// Any pointer should map to a valid shard of the manifold list.
+	for (uint64 iPtr = 0; iPtr < 4096; ++iPtr) {
+		const RigidBody* const rb = reinterpret_cast<const RigidBody*>(uintptr_t(iPtr * 0x10ull + 0x7ff012340000ull));
+		const int iShard = GameWorld::getPhysicsManifoldListShard(rb);
+		REQUIRE(iShard >= 0);
+		REQUIRE(iShard < GameWorld::kNumPhysicsManifoldListShards);
+	}
+}
+
+TEST_CASE("GameWorld the contact manifolds of every rigid body can be found")
+{
+	// Enough contacts for the manifolds to be gathered on the update workers.
+	for (int numWorkers : {1, 4}) {
+		GameWorld world;
+		world.setNumUpdateWorkers(numWorkers);
+		world.create();
+
+		world.allocObjectT<ATestPhysicsGround>();
+		for (int iX = 0; iX < 8; ++iX) {
+			for (int iZ = 0; iZ < 8; ++iZ) {
+				for (int iY = 0; iY < 10; ++iY) {
+					ATestPhysicsBox* const box = world.allocObjectT<ATestPhysicsBox>();
+					box->setPosition(vec3f(float(iX) * 1.5f, 0.5f + float(iY) * 1.01f, float(iZ) * 1.5f));
+				}
+			}
+		}
+
+		const GameUpdateSets updateSets(1.f / 60.f, false, InputState());
+		for (int iFrame = 0; iFrame < 10; ++iFrame) {
+			world.update(updateSets);
+		}
+
+		const btDispatcher* const dispatcher = world.physicsWorld.dynamicsWorld->getDispatcher();
+		REQUIRE(dispatcher->getNumManifolds() >= 512);
+
+		const auto hasManifold = [&world](const btCollisionObject* co, const btPersistentManifold* manifold) -> bool {
+			const ArrayView<const btPersistentManifold* const> manifolds = world.getRigidBodyManifolds(fromBullet(co));
+			return std::find(manifolds.begin(), manifolds.end(), manifold) != manifolds.end();
+		};
+
+		for (int iManifold = 0; iManifold < dispatcher->getNumManifolds(); ++iManifold) {
+			const btPersistentManifold* const manifold = dispatcher->getManifoldByIndexInternal(iManifold);
+			if (manifold->getNumContacts() != 0) {
+				CHECK(hasManifold(manifold->getBody0(), manifold));
+				CHECK(hasManifold(manifold->getBody1(), manifold));
+			}
+		}
+	}
+}
+
+} // namespace sge
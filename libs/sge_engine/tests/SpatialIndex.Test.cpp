@@ -0,0 +1,50 @@
+#include "doctest/doctest.h"
+#include "sge_engine/GameWorld.h"
+#include "sge_engine/typelibHelper.h"
+
+namespace sge {
+
+/// An actor that never updates and whose bounding box changes only when told so.
+struct ATestResizable : public Actor {
+	Box3f getBBoxOS() const override { return Box3f::getFromHalfDiagonal(vec3f(halfSize)); }
+	void create() override {}
+
+	float halfSize = 1.f;
+};
+
+ReflBlock()
+{
+	ReflAddActor(ATestResizable);
+}
+
+TEST_CASE("GameWorld the spatial index follows the bounding boxes marked as dirty")
+{
+	GameWorld world;
+	world.create();
+
+	ATestResizable* const actor = world.allocObjectT<ATestResizable>();
+	const GameUpdateSets updateSets(1.f / 60.f, false, InputState());
+	world.update(updateSets);
+
+	const auto isActorInBox = [&](const Box3f& boxWs) -> bool {
+		bool isFound = false;
+		world.queryActorsInBox(boxWs, [&](Actor* const found) -> void { isFound |= found == actor; });
+		return isFound;
+	};
+
+	const Box3f farBox(vec3f(9.f), vec3f(10.f));
+	CHECK(isActorInBox(Box3f(vec3f(-0.5f), vec3f(0.5f))));
+	CHECK(!isActorInBox(farBox));
+
+	actor->halfSize = 9.5f;
+	actor->markBBoxDirty();
+	world.update(updateSets);
+	CHECK(isActorInBox(farBox));
+
+	actor->setPosition(vec3f(100.f, 0.f, 0.f));
+	world.update(updateSets);
+	CHECK(!isActorInBox(farBox));
+	CHECK(isActorInBox(Box3f(vec3f(99.f, -1.f, -1.f), vec3f(101.f, 1.f, 1.f))));
+}
+
+} // namespace sge
@@ -1,10 +1,32 @@
 #include "Log.h"
+#include "sge_utils/math/common.h"
 #include "sge_utils/sge_utils.h"
 #include "sge_utils/text/format.h"
+#include <chrono>
 #include <stdarg.h>
 
 namespace sge {
 
+/// How often the background thread processes the queued messages when nobody is waiting for them.
+static constexpr int kLogProcessingIntervalMs = 5;
+
+Log::~Log()
+{
+	if (m_processingThread.joinable()) {
+		{
+			const std::lock_guard<std::mutex> lock(m_processingLock);
+			m_shouldStopProcessing = true;
+		}
+		m_processingWakeUp.notify_all();
+		m_processingThread.join();
+	}
+
+	// The messages written after the thread has stopped.
+	if (m_queue.capacity() != 0) {
+		processQueuedRecords();
+	}
+}
+
 void Log::write(const char* format, ...)
 {
 	va_list args;
@@ -13,7 +35,7 @@ void Log::write(const char* format, ...)
 	string_format(buffer, format, args);
 	va_end(args);
 
-	m_messages.emplace_back(Message(messageType_log, buffer));
+	writeFormatted(messageType_log, std::move(buffer));
 }
 
 void Log::writeCheck(const char* format, ...)
@@ -24,7 +46,7 @@ void Log::writeCheck(const char* format, ...)
 	string_format(buffer, format, args);
 	va_end(args);
 
-	m_messages.emplace_back(Message(messageType_check, buffer));
+	writeFormatted(messageType_check, std::move(buffer));
 }
 
 void Log::writeError(const char* format, ...)
@@ -35,7 +57,7 @@ void Log::writeError(const char* format, ...)
 	string_format(buffer, format, args);
 	va_end(args);
 
-	m_messages.emplace_back(Message(messageType_error, buffer));
+	writeFormatted(messageType_error, std::move(buffer));
 }
 
 void Log::writeWarning(const char* format, ...)
@@ -46,7 +68,172 @@ void Log::writeWarning(const char* format, ...)
 	string_format(buffer, format, args);
 	va_end(args);
 
-	m_messages.emplace_back(Message(messageType_warning, buffer));
+	writeFormatted(messageType_warning, std::move(buffer));
+}
+
+void Log::writeFormatted(MessageType type, std::string message)
+{
+	Record record;
+	record.formatFn = nullptr;
+	record.longMessage = nullptr;
+	record.type = type;
+
+	if (message.size() < kRecordDataBytes) {
+		memcpy(record.data, message.c_str(), message.size() + 1);
+	}
+	else {
+		record.longMessage = new std::string(std::move(message));
+	}
+
+	pushRecord(record);
+}
+
+void Log::pushRecord(Record& record)
+{
+	std::call_once(m_startOnce, [this]() -> void { startProcessingThread(); });
+
+	if (!m_queue.tryPush(record)) {
+		delete record.longMessage;
+		m_numDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+	}
+
+#ifdef __EMSCRIPTEN__
+	// There is no background thread, see @startProcessingThread.
+	processQueuedRecords();
+#endif
+}
+
+void Log::startProcessingThread()
+{
+	m_queue.create(m_queueCapacity);
+
+#ifndef __EMSCRIPTEN__
+	m_processingThread = std::thread([this]() -> void { processingThreadMain(); });
+#endif
+}
+
+void Log::processingThreadMain()
+{
+	while (true) {
+		processQueuedRecords();
+
+		std::unique_lock<std::mutex> lock(m_processingLock);
+		m_numProcessingCycles++;
+		m_processingCycleDone.notify_all();
+
+		if (m_shouldStopProcessing) {
+			break;
+		}
+
+		// The writers never wake up the thread, that would cost them a system call.
+		m_processingWakeUp.wait_for(lock, std::chrono::milliseconds(kLogProcessingIntervalMs), [this]() -> bool {
+			return m_isFlushRequested || m_shouldStopProcessing;
+		});
+		m_isFlushRequested = false;
+	}
+}
+
+void Log::processQueuedRecords()
+{
+	m_processedTemp.clear();
+
+	// Limited to one queue worth of messages, so a flood of messages can't keep the thread here forever.
+	Record record;
+	for (int t = 0; t < m_queue.capacity() && m_queue.tryPop(record); ++t) {
+		Message& message = m_processedTemp.emplace_back(record.type, std::string());
+		if (record.longMessage) {
+			message.message = std::move(*record.longMessage);
+			delete record.longMessage;
+		}
+		else if (record.formatFn) {
+			record.formatFn(message.message, record.data);
+		}
+		else {
+			message.message = record.data;
+		}
+	}
+
+	const uint64 numDroppedMessages = getNumDroppedMessages();
+	if (numDroppedMessages != m_numReportedDroppedMessages) {
+		m_processedTemp.emplace_back(
+		    messageType_warning,
+		    string_format(
+		        "%d log messages were dropped, the log queue is full",
+		        int(numDroppedMessages - m_numReportedDroppedMessages)));
+		m_numReportedDroppedMessages = numDroppedMessages;
+	}
+
+	if (m_processedTemp.empty()) {
+		return;
+	}
+
+	{
+		const std::lock_guard<std::mutex> lock(m_sinksLock);
+		for (const std::shared_ptr<ILogSink>& sink : m_sinks) {
+			for (const Message& message : m_processedTemp) {
+				sink->writeMessage(message);
+			}
+			sink->flush();
+		}
+	}
+
+	{
+		const std::lock_guard<std::mutex> lock(m_messagesLock);
+		for (Message& message : m_processedTemp) {
+			m_messages.emplace_back(std::move(message));
+		}
+
+		const size_t retentionCap = size_t(maxOf(m_retentionCap.load(), 0));
+		while (m_messages.size() > retentionCap) {
+			m_messages.pop_front();
+		}
+	}
+
+	m_numProcessedMessages.fetch_add(m_processedTemp.size(), std::memory_order_release);
+}
+
+void Log::flush()
+{
+	std::call_once(m_startOnce, [this]() -> void { startProcessingThread(); });
+	if (!m_processingThread.joinable()) {
+		return;
+	}
+
+	// The cycle that is running now might have already passed the new messages, so wait for the next one to finish.
+	std::unique_lock<std::mutex> lock(m_processingLock);
+	const uint64 waitedCycle = m_numProcessingCycles + 2;
+	m_isFlushRequested = true;
+	m_processingWakeUp.notify_all();
+	m_processingCycleDone.wait(lock, [this, waitedCycle]() -> bool { return m_numProcessingCycles >= waitedCycle; });
+}
+
+void Log::copyMessages(std::vector<Message>& result, int maxMessages) const
+{
+	result.clear();
+
+	const std::lock_guard<std::mutex> lock(m_messagesLock);
+	const int numMessages = minOf(maxMessages, int(m_messages.size()));
+	result.reserve(numMessages);
+	result.insert(result.end(), m_messages.end() - numMessages, m_messages.end());
+}
+
+void Log::addSink(std::shared_ptr<ILogSink> sink)
+{
+	if (sink) {
+		const std::lock_guard<std::mutex> lock(m_sinksLock);
+		m_sinks.emplace_back(std::move(sink));
+	}
+}
+
+void Log::removeSink(const ILogSink* sink)
+{
+	const std::lock_guard<std::mutex> lock(m_sinksLock);
+	for (int t = 0; t < int(m_sinks.size()); ++t) {
+		if (m_sinks[t].get() == sink) {
+			m_sinks.erase(m_sinks.begin() + t);
+			break;
+		}
+	}
 }
 
 Log g_moduleLocalLog;
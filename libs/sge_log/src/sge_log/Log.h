@@ -2,13 +2,34 @@
 
 #include "sge_log_api.h"
 
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
+#include "sge_utils/text/format.h"
+#include "sge_utils/threading/MPSCQueue.h"
 #include "sge_utils/types.h"
 
 namespace sge {
 
+struct ILogSink;
+
+/// Log collects the messages written by all threads.
+///
+/// Writing a message never blocks and never takes a lock. The message is put in a record in a bounded lock-free
+/// queue and a background thread formats it, passes it to the sinks (see @addSink) and keeps the last few messages
+/// (see @setRetentionCap) for the editor LogWindow. With @writeDeferred (used by the sgeLog* macros) the arguments
+/// are captured as they are and even the formatting is done by the background thread.
+/// If the queue is full the message is dropped and the amount of dropped messages is reported later.
 struct SGE_LOG_API Log : public NoCopy {
 	enum MessageType : int {
 		/// Just a message that something has been done.
@@ -33,51 +54,265 @@ struct SGE_LOG_API Log : public NoCopy {
 		std::string message;
 	};
 
+	static constexpr int kDefaultQueueCapacity = 8192;
+	static constexpr int kDefaultRetentionCap = 10000;
+
+	/// @param [in] queueCapacity the amount of messages that could be waiting for the background thread.
+	explicit Log(int queueCapacity = kDefaultQueueCapacity)
+	    : m_queueCapacity(queueCapacity)
+	{
+	}
+
+	/// Processes the remaining messages and stops the background thread.
+	~Log();
+
+	/// These format the message on the calling thread, prefer the sgeLog* macros.
 	void write(const char* format, ...);
 	void writeCheck(const char* format, ...);
 	void writeError(const char* format, ...);
 	void writeWarning(const char* format, ...);
 
-	const std::vector<Message>& getMessages() const { return m_messages; }
+	/// Captures the format string and the arguments, the message is formatted later by the background thread.
+	/// The arguments could be numbers, enums, pointers and C-strings, the C-strings are copied.
+	/// If they do not fit in a record the message is formatted on the calling thread.
+	template <typename... TArgs>
+	void writeDeferred(MessageType type, const char* format, const TArgs&... args);
+
+	/// Waits for the background thread to process all messages written so far.
+	/// Must not be called by a sink.
+	void flush();
+
+	/// Sets how many of the last messages are kept in memory, see @copyMessages.
+	void setRetentionCap(int maxMessages) { m_retentionCap = maxMessages; }
+	int getRetentionCap() const { return m_retentionCap; }
+
+	/// Copies the last @maxMessages of the kept messages, the oldest one first.
+	void copyMessages(std::vector<Message>& result, int maxMessages = INT_MAX) const;
+
+	/// Returns the amount of messages processed by the background thread so far.
+	/// Useful to check if there are new messages without copying them.
+	uint64 getNumProcessedMessages() const { return m_numProcessedMessages.load(std::memory_order_acquire); }
+
+	/// Returns the amount of messages that were dropped because the queue was full.
+	uint64 getNumDroppedMessages() const { return m_numDroppedMessages.load(std::memory_order_relaxed); }
+
+	/// Adds a destination for the messages. The sink is called by the background thread.
+	void addSink(std::shared_ptr<ILogSink> sink);
+	void removeSink(const ILogSink* sink);
 
   private:
-	std::string m_logFilename;
-	std::vector<Message> m_messages;
+	/// The size of the captured format string and arguments that fit in a record.
+	static constexpr int kRecordDataBytes = 232;
+
+	/// Formats the message in @data into @result.
+	using FormatFn = void (*)(std::string& result, const char* data);
+
+	/// A message waiting in the queue.
+	struct Record {
+		/// nullptr if the message is already formatted.
+		FormatFn formatFn;
+		/// A message formatted on the writing thread that didn't fit in @data, owned by the record.
+		std::string* longMessage;
+		MessageType type;
+		/// The format string and the arguments captured by @writeDeferred, each argument aligned to 8 bytes,
+		/// or the formatted message.
+		alignas(8) char data[kRecordDataBytes];
+	};
+
+	template <typename T>
+	static constexpr bool isStringArg =
+	    std::is_same_v<std::decay_t<T>, char*> || std::is_same_v<std::decay_t<T>, const char*>;
+
+	static int alignArgOffset(int offset) { return (offset + 7) & ~7; }
+
+	/// Appends the argument to @data. Returns false if it doesn't fit.
+	template <typename T>
+	static bool packArg(char* const data, int& offset, const T& arg);
+
+	template <typename T>
+	static auto unpackArg(const char* const data, int& offset);
+
+	template <typename... TArgs>
+	static void formatRecord(std::string& result, const char* const data);
+
+	void writeFormatted(MessageType type, std::string message);
+	void pushRecord(Record& record);
+
+	/// Starts the background thread on the first written message.
+	void startProcessingThread();
+	void processingThreadMain();
+
+	/// Called by the background thread, formats the queued messages and passes them to the sinks.
+	void processQueuedRecords();
+
+  private:
+	int m_queueCapacity = kDefaultQueueCapacity;
+	std::once_flag m_startOnce;
+	MPSCQueue<Record> m_queue;
+	std::atomic<uint64> m_numDroppedMessages = 0;
+	std::atomic<uint64> m_numProcessedMessages = 0;
+
+	std::thread m_processingThread;
+	std::mutex m_processingLock;
+	std::condition_variable m_processingWakeUp;
+	std::condition_variable m_processingCycleDone;
+	uint64 m_numProcessingCycles = 0;
+	bool m_isFlushRequested = false;
+	bool m_shouldStopProcessing = false;
+
+	// Background thread state.
+	std::vector<Message> m_processedTemp;
+	uint64 m_numReportedDroppedMessages = 0;
+
+	mutable std::mutex m_messagesLock;
+	std::deque<Message> m_messages;
+	std::atomic<int> m_retentionCap = kDefaultRetentionCap;
+
+	std::mutex m_sinksLock;
+	std::vector<std::shared_ptr<ILogSink>> m_sinks;
 };
 
-#if defined(SGE_USE_DEBUG)
-    // https://stackoverflow.com/questions/5588855/standard-alternative-to-gccs-va-args-trick
-	#define sgeLogInfo(_str_msg_, ...)                        \
-		{                                                     \
-			sge::getLog()->write((_str_msg_), ##__VA_ARGS__); \
+/// A destination for the log messages, like a file or the standard output.
+struct SGE_LOG_API ILogSink {
+	virtual ~ILogSink() = default;
+
+	/// Called by the background thread of the log for each message.
+	virtual void writeMessage(const Log::Message& message) = 0;
+
+	/// Called by the background thread of the log after a batch of messages.
+	virtual void flush() {}
+};
+
+template <typename T>
+bool Log::packArg(char* const data, int& offset, const T& arg)
+{
+	offset = alignArgOffset(offset);
+
+	if constexpr (isStringArg<T>) {
+		const char* str = arg;
+		if (str == nullptr) {
+			str = "(null)";
 		}
-	#define sgeLogCheck(_str_msg_, ...)                            \
-		{                                                          \
-			sge::getLog()->writeCheck((_str_msg_), ##__VA_ARGS__); \
+		const int size = int(strlen(str)) + 1;
+		if (offset + size > kRecordDataBytes) {
+			return false;
 		}
-	#define sgeLogError(_str_msg_, ...)                            \
-		{                                                          \
-			sge::getLog()->writeError((_str_msg_), ##__VA_ARGS__); \
+		memcpy(data + offset, str, size);
+		offset += size;
+	}
+	else {
+		static_assert(
+		    std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> || std::is_null_pointer_v<T>,
+		    "Log arguments should be the ones accepted by printf");
+		if (offset + int(sizeof(T)) > kRecordDataBytes) {
+			return false;
 		}
-	#define sgeLogWarn(_str_msg_, ...)                               \
-		{                                                            \
-			sge::getLog()->writeWarning((_str_msg_), ##__VA_ARGS__); \
+		memcpy(data + offset, &arg, sizeof(T));
+		offset += int(sizeof(T));
+	}
+
+	return true;
+}
+
+template <typename T>
+auto Log::unpackArg(const char* const data, int& offset)
+{
+	offset = alignArgOffset(offset);
+
+	if constexpr (isStringArg<T>) {
+		const char* const str = data + offset;
+		offset += int(strlen(str)) + 1;
+		return str;
+	}
+	else {
+		T value;
+		memcpy(&value, data + offset, sizeof(T));
+		offset += int(sizeof(T));
+		return value;
+	}
+}
+
+template <typename... TArgs>
+void Log::formatRecord(std::string& result, const char* const data)
+{
+	// The format string is first, followed by the arguments.
+	int offset = int(strlen(data)) + 1;
+
+	// The arguments of a braced initializer are evaluated in order, so they are read in the order they were packed.
+	const std::tuple<decltype(unpackArg<TArgs>(data, offset))...> args{unpackArg<TArgs>(data, offset)...};
+	std::apply([&result, data](const auto&... values) -> void { string_format(result, data, values...); }, args);
+}
+
+template <typename... TArgs>
+void Log::writeDeferred(MessageType type, const char* const format, const TArgs&... args)
+{
+	Record record;
+	record.formatFn = &formatRecord<std::decay_t<TArgs>...>;
+	record.longMessage = nullptr;
+	record.type = type;
+
+	int offset = 0;
+	const bool fits = packArg(record.data, offset, format) && (packArg(record.data, offset, args) && ...);
+	if (!fits) {
+		std::string message;
+		string_format(message, format, args...);
+		writeFormatted(type, std::move(message));
+		return;
+	}
+
+	pushRecord(record);
+}
+
+/// The minimal level of messages that are compiled in the sgeLog* macros, the others are removed at compile time.
+/// The levels are the values of Log::MessageType: 0 log (info), 1 check, 2 warning, 3 error.
+#if !defined(SGE_LOG_MIN_LEVEL)
+	#define SGE_LOG_MIN_LEVEL 0
+#endif
+
+#if defined(SGE_USE_DEBUG)
+	// https://stackoverflow.com/questions/5588855/standard-alternative-to-gccs-va-args-trick
+	#define SGE_LOG_WRITE_DEFERRED(_type_, _str_msg_, ...)                              \
+		{                                                                               \
+			sge::getLog()->writeDeferred(sge::Log::_type_, (_str_msg_), ##__VA_ARGS__); \
 		}
+#else
+	#define SGE_LOG_WRITE_DEFERRED(_type_, _str_msg_, ...) \
+		{                                                  \
+		}
+#endif
+
+#if SGE_LOG_MIN_LEVEL <= 0
+	#define sgeLogInfo(_str_msg_, ...) SGE_LOG_WRITE_DEFERRED(messageType_log, (_str_msg_), ##__VA_ARGS__)
 #else
 	#define sgeLogInfo(_str_msg_, ...) \
 		{                              \
 		}
+#endif
+
+#if SGE_LOG_MIN_LEVEL <= 1
+	#define sgeLogCheck(_str_msg_, ...) SGE_LOG_WRITE_DEFERRED(messageType_check, (_str_msg_), ##__VA_ARGS__)
+#else
 	#define sgeLogCheck(_str_msg_, ...) \
 		{                               \
 		}
-	#define sgeLogError(_str_msg_, ...) \
-		{                               \
-		}
+#endif
+
+#if SGE_LOG_MIN_LEVEL <= 2
+	#define sgeLogWarn(_str_msg_, ...) SGE_LOG_WRITE_DEFERRED(messageType_warning, (_str_msg_), ##__VA_ARGS__)
+#else
 	#define sgeLogWarn(_str_msg_, ...) \
 		{                              \
 		}
 #endif
 
+#if SGE_LOG_MIN_LEVEL <= 3
+	#define sgeLogError(_str_msg_, ...) SGE_LOG_WRITE_DEFERRED(messageType_error, (_str_msg_), ##__VA_ARGS__)
+#else
+	#define sgeLogError(_str_msg_, ...) \
+		{                               \
+		}
+#endif
+
 /// The global of the current module(dll, exe, ect.). However we could "borrow" another modules "ICore" and use theirs.
 SGE_LOG_API Log* getLog();
 SGE_LOG_API void setLog(Log* global);
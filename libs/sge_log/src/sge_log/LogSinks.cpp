@@ -0,0 +1,64 @@
+#include "LogSinks.h"
+#include "sge_utils/io/fopen.h"
+
+namespace sge {
+
+/// Writes the message on its own line. Some messages already end with a new line, so it is not doubled.
+static void writeLogMessageLine(FILE* const file, const Log::Message& message)
+{
+	const bool endsWithNewLine = !message.message.empty() && message.message.back() == '\n';
+	fprintf(file, "%s%s%s", getLogMessagePrefix(message.type), message.message.c_str(), endsWithNewLine ? "" : "\n");
+}
+
+const char* getLogMessagePrefix(Log::MessageType type)
+{
+	switch (type) {
+		case Log::messageType_check:
+			return "[CHECK] ";
+		case Log::messageType_warning:
+			return "[WARNING] ";
+		case Log::messageType_error:
+			return "[ERROR] ";
+		case Log::messageType_log:
+		default:
+			return "";
+	}
+}
+
+LogFileSink::LogFileSink(const char* filename)
+{
+	sge_fopen(&m_file, filename, "wt");
+}
+
+LogFileSink::~LogFileSink()
+{
+	sge_fclose_safe(m_file);
+	m_file = nullptr;
+}
+
+void LogFileSink::writeMessage(const Log::Message& message)
+{
+	if (m_file) {
+		writeLogMessageLine(m_file, message);
+	}
+}
+
+void LogFileSink::flush()
+{
+	if (m_file) {
+		fflush(m_file);
+	}
+}
+
+void LogStdoutSink::writeMessage(const Log::Message& message)
+{
+	const bool isProblem = message.type == Log::messageType_warning || message.type == Log::messageType_error;
+	writeLogMessageLine(isProblem ? stderr : stdout, message);
+}
+
+void LogStdoutSink::flush()
+{
+	fflush(stdout);
+}
+
+} // namespace sge
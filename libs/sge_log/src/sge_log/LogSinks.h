@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Log.h"
+
+#include <cstdio>
+
+namespace sge {
+
+/// Returns the prefix that the text sinks write before the messages of the specified type.
+SGE_LOG_API const char* getLogMessagePrefix(Log::MessageType type);
+
+/// Writes the log messages to a text file, one message per line.
+struct SGE_LOG_API LogFileSink : public ILogSink, public NoCopy {
+	/// @param [in] filename the file is created, or truncated if it already exists.
+	explicit LogFileSink(const char* filename);
+	~LogFileSink();
+
+	bool isOpened() const { return m_file != nullptr; }
+
+	void writeMessage(const Log::Message& message) override;
+	void flush() override;
+
+  private:
+	FILE* m_file = nullptr;
+};
+
+/// Writes the log messages to the standard output, errors and warnings go to the standard error.
+struct SGE_LOG_API LogStdoutSink : public ILogSink {
+	void writeMessage(const Log::Message& message) override;
+	void flush() override;
+};
+
+} // namespace sge
@@ -61,6 +61,8 @@ D3D11_MAP Map_D3D11_Native(const Map::Enum map)
 			return D3D11_MAP_READ_WRITE;
 		case Map::WriteDiscard:
 			return D3D11_MAP_WRITE_DISCARD;
+		case Map::WriteNoOverwrite:
+			return D3D11_MAP_WRITE_NO_OVERWRITE;
 	}
 
 	// Unimplemented type.
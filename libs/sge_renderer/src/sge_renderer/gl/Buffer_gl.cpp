@@ -86,7 +86,23 @@ void* BufferGL::map([[maybe_unused]] const Map::Enum map, SGEContext* UNUSED(sge
 	GLContextStateCache* const glcon = getDevice<SGEDeviceImpl>()->GL_GetContextStateCache();
 
 	glcon->BindBuffer(GL_GetTargetBufferType(), m_glBuffer);
-	void* result = glcon->MapBuffer(GL_GetTargetBufferType(), Map_GetGLNative(map));
+
+	void* result = nullptr;
+	if (map == Map::WriteNoOverwrite) {
+		// The caller guarantees that the regions used by pending draw calls will not be touched,
+		// so there is no need to wait for the GPU to finish with the buffer.
+		result = glcon->MapBufferRange(
+		    GL_GetTargetBufferType(), 0, m_bufferDesc.sizeBytes, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	}
+	else if (map == Map::WriteDiscard) {
+		// Let the driver orphan the old storage instead of synchronizing with the GPU.
+		result = glcon->MapBufferRange(
+		    GL_GetTargetBufferType(), 0, m_bufferDesc.sizeBytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	}
+	else {
+		result = glcon->MapBuffer(GL_GetTargetBufferType(), Map_GetGLNative(map));
+	}
+
 	DumpAllGLErrors();
 	return result;
 #endif
@@ -48,6 +48,29 @@ void* GLContextStateCache::MapBuffer(const GLenum target, const GLenum access)
 #endif
 }
 
+void* GLContextStateCache::MapBufferRange(
+    const GLenum target, const GLintptr offset, const GLsizeiptr length, const GLbitfield access)
+{
+#if !defined(__EMSCRIPTEN__)
+	IsBufferTargetSupported(target);
+
+	const BUFFER_FREQUENCY freq = GetBufferTargetByFrequency(target);
+
+	if (m_boundBuffers[freq].buffer == 0) {
+		sgeAssert(false && "Trying to call glMapBufferRange on slot with no bound buffer!");
+		return nullptr;
+	}
+
+	m_boundBuffers[freq].isMapped = true;
+	void* result = glMapBufferRange(target, offset, length, access);
+	DumpAllGLErrors();
+	return result;
+#else
+	sgeLogError("WebGL doesn't support glMapBufferRange");
+	return nullptr;
+#endif
+}
+
 void GLContextStateCache::UnmapBuffer(const GLenum target)
 {
 #if !defined(__EMSCRIPTEN__)
@@ -99,7 +122,8 @@ void GLContextStateCache::SetVertexAttribSlotState(
     const GLenum type,
     const GLboolean normalized,
     const GLuint stride,
-    const GLuint byteOffset)
+    const GLuint byteOffset,
+    const GLuint divisor)
 {
 	VertexAttribSlotDesc& currentState = m_vertAttribPointers[index];
 
@@ -163,6 +187,12 @@ void GLContextStateCache::SetVertexAttribSlotState(
 			}
 			DumpAllGLErrors();
 		}
+
+		if (currentState.divisor != divisor || justEnabled) {
+			currentState.divisor = divisor;
+			glVertexAttribDivisor(index, divisor);
+			DumpAllGLErrors();
+		}
 	}
 }
 
@@ -462,7 +492,7 @@ void GLContextStateCache::DeleteBuffers(const GLsizei numBuffers, GLuint* const
 		for (int t = 0; t < m_vertAttribPointers.size(); ++t) {
 			auto& vad = m_vertAttribPointers[t];
 			if (vad.buffer == buffer) {
-				SetVertexAttribSlotState(false, t, 0, 1, GL_FLOAT, GL_FALSE, 0, 0);
+				SetVertexAttribSlotState(false, t, 0, 1, GL_FLOAT, GL_FALSE, 0, 0, 0);
 			}
 		}
 
@@ -46,7 +46,8 @@ struct GLContextStateCache {
 		    GLenum a_type = GL_FLOAT, // GL_NONE isn't accepted by standard.
 		    GLboolean a_normalized = GL_FALSE,
 		    GLuint a_stride = 0,     // vertex buffer element size.
-		    GLuint a_byteOffset = 0) // data offset in the buffer stride.
+		    GLuint a_byteOffset = 0, // data offset in the buffer stride.
+		    GLuint a_divisor = 0)    // 0 - per vertex data, 1 - per instance data.
 		    : isEnabled(a_enabled)
 		    , buffer(a_buffer)
 		    , size(a_size)
@@ -54,6 +55,7 @@ struct GLContextStateCache {
 		    , normalized(a_normalized)
 		    , stride(a_stride)
 		    , byteOffset(a_byteOffset)
+		    , divisor(a_divisor)
 		{
 		}
 
@@ -64,6 +66,7 @@ struct GLContextStateCache {
 		GLboolean normalized;
 		GLuint stride;
 		GLuint byteOffset;
+		GLuint divisor;
 	};
 
 	// Bond textures description.
@@ -92,6 +95,10 @@ struct GLContextStateCache {
 	    const GLenum access // = GL_READ_ONLY, GL_WRITE_ONLY, GL_READ_WRITE
 	);
 
+	/// A wrapper around glMapBufferRange.
+	/// @param access - a combination of GL_MAP_*_BIT flags.
+	void* MapBufferRange(const GLenum target, const GLintptr offset, const GLsizeiptr length, const GLbitfield access);
+
 	void UnmapBuffer(const GLenum target);
 
 	/// A wrapper aound glBindBuffer.
@@ -115,7 +122,8 @@ struct GLContextStateCache {
 	    const GLenum type,
 	    const GLboolean normalized,
 	    const GLuint stride,
-	    const GLuint byteOffset);
+	    const GLuint byteOffset,
+	    const GLuint divisor);
 
 	/// Binds the specified shading program. Basically calls glUseProgram.
 	/// @param program resource id to get bound.
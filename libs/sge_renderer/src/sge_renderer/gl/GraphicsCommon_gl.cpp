@@ -36,6 +36,8 @@ GLenum Map_GetGLNative(const Map::Enum map)
 			return GL_READ_WRITE;
 		case Map::WriteDiscard:
 			return GL_WRITE_ONLY; // [TODO]
+		case Map::WriteNoOverwrite:
+			return GL_WRITE_ONLY;
 	}
 
 	sgeAssert(false); // Unknown type
@@ -301,6 +303,26 @@ void TextureFormat_GetGLNative(
 			glFormat = GL_NONE;
 			glType = GL_NONE;
 			return;
+		case TextureFormat::BC4_UNORM:
+			glInternalFormat = GL_COMPRESSED_RED_RGTC1;
+			glFormat = GL_NONE;
+			glType = GL_NONE;
+			return;
+		case TextureFormat::BC4_SNORM:
+			glInternalFormat = GL_COMPRESSED_SIGNED_RED_RGTC1;
+			glFormat = GL_NONE;
+			glType = GL_NONE;
+			return;
+		case TextureFormat::BC5_UNORM:
+			glInternalFormat = GL_COMPRESSED_RG_RGTC2;
+			glFormat = GL_NONE;
+			glType = GL_NONE;
+			return;
+		case TextureFormat::BC5_SNORM:
+			glInternalFormat = GL_COMPRESSED_SIGNED_RG_RGTC2;
+			glFormat = GL_NONE;
+			glType = GL_NONE;
+			return;
 #endif
 
 		case TextureFormat::D24:
@@ -408,13 +408,14 @@ void SGEContextImmediate::executeDrawCall(
 
 			GLuint const buffer =
 			    ((BufferGL*)(stateGroup->m_vertexBuffers[glAttribLayout[t].bufferSlot]))->GL_GetResource();
-			GLuint const byteOffset = glAttribLayout[t].byteOffset;
+			GLuint const byteOffset =
+			    stateGroup->m_vbOffsets[glAttribLayout[t].bufferSlot] + glAttribLayout[t].byteOffset;
 			GLuint const stride = stateGroup->m_vbStrides[glAttribLayout[t].bufferSlot];
 
 			// Due to the lack of "glDrawElementsBaseVertex" under OpenGL ES*
-			// we are forced to add that offset here.
+			// we are forced to add that offset here. The base vertex doesn't affect per-instance data.
 			int drawIndexedBaseVertexAdditionOffset = 0;
-			if (drawCall.m_drawExec.GetType() == DrawExecDesc::Type_Indexed) {
+			if (drawCall.m_drawExec.GetType() == DrawExecDesc::Type_Indexed && !glAttribLayout[t].isPerInstance) {
 				drawIndexedBaseVertexAdditionOffset = drawCall.m_drawExec.IndexedCall().startVertex * stride;
 			}
 
@@ -426,7 +427,8 @@ void SGEContextImmediate::executeDrawCall(
 			    attrbType,
 			    attibNormalized,
 			    stride,
-			    byteOffset + drawIndexedBaseVertexAdditionOffset);
+			    byteOffset + drawIndexedBaseVertexAdditionOffset,
+			    glAttribLayout[t].isPerInstance ? 1 : 0);
 		}
 	}
 
@@ -59,6 +59,7 @@ bool VertexMapperGL::create(const ShadingProgram* shadingProgram, const VertexDe
 		layoutGL.index = attrib.attributeLocation;
 		layoutGL.byteOffset = int(declItr->byteOffset);
 		layoutGL.type = declItr->format;
+		layoutGL.isPerInstance = declItr->isPerInstance;
 
 		m_glVertexLayout.push_back(layoutGL);
 	}
@@ -134,6 +135,22 @@ CreateShaderResult
 	return CreateShaderResult(true, "");
 }
 
+CreateShaderResult ShaderGL::createFromNativeBytecode(const ShaderType::Enum type, std::vector<char> nativeBytecode)
+{
+	const std::string code(nativeBytecode.begin(), nativeBytecode.end());
+	return createNative(type, code.c_str(), nullptr);
+}
+
+bool ShaderGL::getCreationBytecode(std::vector<char>& outMemory) const
+{
+	if (m_glShader == 0) {
+		return false;
+	}
+
+	outMemory.assign(m_cachedCode.begin(), m_cachedCode.end());
+	return true;
+}
+
 void ShaderGL::destroy()
 {
 	if (m_glShader != 0) {
@@ -19,6 +19,7 @@ struct VertexMapperGL : public RAIResource {
 		GLuint index;
 		GLint byteOffset;
 		UniformType::Enum type;
+		bool isPerInstance; ///< If true the attribute advances once per instance (glVertexAttribDivisor = 1).
 	};
 
 	VertexMapperGL() { destroy(); }
@@ -50,18 +51,16 @@ struct ShaderGL : public Shader {
 	CreateShaderResult
 	    createNative(const ShaderType::Enum type, const char* pCode, const char* const entryPoint) override;
 
-	CreateShaderResult
-	    createFromNativeBytecode(const ShaderType::Enum UNUSED(type), std::vector<char> UNUSED(nativeBytecode)) override
-	{
-		return CreateShaderResult();
-	}
+	/// OpenGL has no portable shader bytecode, the "bytecode" is the GLSL code of the shader.
+	CreateShaderResult createFromNativeBytecode(const ShaderType::Enum type, std::vector<char> nativeBytecode) override;
 
 	virtual void destroy() override;
 	virtual bool isValid() const override;
 
 	const ShaderType::Enum getShaderType() const final { return m_shaderType; }
 
-	virtual bool getCreationBytecode(std::vector<char>& UNUSED(outMemory)) const override { return false; }
+	/// Returns the GLSL code used to create the shader, see @createFromNativeBytecode.
+	virtual bool getCreationBytecode(std::vector<char>& outMemory) const override;
 
 	GLuint GL_GetShader() { return m_glShader; }
 
@@ -4,10 +4,33 @@
 #include "sge_log/Log.h"
 
 #include <algorithm>
+#include <cstring>
 #include <stdio.h>
 
 namespace sge {
 
+/// Returns true if linked programs could be saved and loaded (GL_ARB_get_program_binary).
+static bool isProgramBinarySupported()
+{
+#if !defined(__EMSCRIPTEN__)
+	static const bool isSupported = [] {
+		if (!GLEW_ARB_get_program_binary) {
+			return false;
+		}
+
+		// Some drivers expose the extension without supporting any binary format.
+		GLint numFormats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+		return numFormats > 0;
+	}();
+
+	return isSupported;
+#else
+	// WebGL has no way of saving the programs.
+	return false;
+#endif
+}
+
 bool ShadingProgramGL::create(Shader* vertShdr, Shader* pixelShdr)
 {
 	if (!vertShdr || !pixelShdr) {
@@ -26,6 +49,13 @@ bool ShadingProgramGL::create(Shader* vertShdr, Shader* pixelShdr)
 	glAttachShader(m_glProgram, ((ShaderGL*)vertShdr)->GL_GetShader()); // attach vertex shader
 	glAttachShader(m_glProgram, ((ShaderGL*)pixelShdr)->GL_GetShader());
 
+#if !defined(__EMSCRIPTEN__)
+	// Needed in order to be able to retrieve the program binary with getProgramBinary().
+	if (isProgramBinarySupported()) {
+		glProgramParameteri(m_glProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+#endif
+
 	// Link the program
 	glLinkProgram(m_glProgram);
 
@@ -76,6 +106,78 @@ CreateShaderResult ShadingProgramGL::createFromNativeCode(const char* const pVSC
 	return CreateShaderResult();
 }
 
+bool ShadingProgramGL::getProgramBinary(std::vector<char>& outBinary) const
+{
+#if !defined(__EMSCRIPTEN__)
+	if (m_glProgram == 0 || !isProgramBinarySupported()) {
+		return false;
+	}
+
+	GLint binaryLength = 0;
+	glGetProgramiv(m_glProgram, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+	if (binaryLength <= 0) {
+		return false;
+	}
+
+	GLenum binaryFormat = 0;
+	GLsizei writtenLength = 0;
+	outBinary.resize(sizeof(binaryFormat) + size_t(binaryLength));
+	glGetProgramBinary(
+	    m_glProgram, binaryLength, &writtenLength, &binaryFormat, outBinary.data() + sizeof(binaryFormat));
+
+	if (writtenLength <= 0) {
+		outBinary.clear();
+		return false;
+	}
+
+	memcpy(outBinary.data(), &binaryFormat, sizeof(binaryFormat));
+	outBinary.resize(sizeof(binaryFormat) + size_t(writtenLength));
+	return true;
+#else
+	return false;
+#endif
+}
+
+CreateShaderResult ShadingProgramGL::createFromProgramBinary(
+    const std::vector<char>& programBinary,
+    const char* const pVSCode,
+    const char* const pPSCode,
+    bool& outUsedProgramBinary)
+{
+	outUsedProgramBinary = false;
+
+#if !defined(__EMSCRIPTEN__)
+	GLenum binaryFormat = 0;
+	if (isProgramBinarySupported() && programBinary.size() > sizeof(binaryFormat)) {
+		destroy();
+
+		memcpy(&binaryFormat, programBinary.data(), sizeof(binaryFormat));
+
+		m_glProgram = glCreateProgram();
+		glProgramBinary(
+		    m_glProgram,
+		    binaryFormat,
+		    programBinary.data() + sizeof(binaryFormat),
+		    GLsizei(programBinary.size() - sizeof(binaryFormat)));
+
+		GLint linkingStatus = GL_FALSE;
+		glGetProgramiv(m_glProgram, GL_LINK_STATUS, &linkingStatus);
+
+		// Note that there are no shader objects when the program is loaded this way,
+		// getVertexShader() and getPixelShader() are going to return nullptr.
+		if (linkingStatus != GL_FALSE && m_reflection.create(this)) {
+			outUsedProgramBinary = true;
+			return CreateShaderResult(true, "");
+		}
+
+		// The driver rejected the binary, fallback to compiling the code.
+		destroy();
+	}
+#endif
+
+	return createFromNativeCode(pVSCode, pPSCode);
+}
+
 void ShadingProgramGL::destroy()
 {
 	// drop shader usage
@@ -17,6 +17,14 @@ struct ShadingProgramGL : public ShadingProgram {
 	// bool createFromNativeCode(const char* const pVSCode, const char* const pPSCode, std::set<std::string>*
 	// outIncludedFiles = nullptr) final;
 
+	/// The binary is made with GL_ARB_get_program_binary, the GLenum binary format is stored in the first bytes.
+	bool getProgramBinary(std::vector<char>& outBinary) const final;
+	CreateShaderResult createFromProgramBinary(
+	    const std::vector<char>& programBinary,
+	    const char* const pVSCode,
+	    const char* const pPSCode,
+	    bool& outUsedProgramBinary) final;
+
 	void destroy() override;
 	bool isValid() const override;
 
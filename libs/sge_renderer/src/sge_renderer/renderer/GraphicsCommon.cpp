@@ -76,13 +76,13 @@ size_t TextureFormat::GetSizeBits(const TextureFormat::Enum format)
 		case A8_UNORM:
 			return 8;
 
-		// Note that the block compression sizes could be wrong!
+		// For the block compressed formats this is the size of a 4x4 block in bytes.
 		case BC1_UNORM:
 			return 8;
 		case BC2_UNORM:
-			return 8;
+			return 16;
 		case BC3_UNORM:
-			return 8;
+			return 16;
 
 		case BC4_UNORM:
 			return 8;
@@ -177,7 +177,10 @@ struct ResourceType {
 //
 //-------------------------------------------------------------------
 struct Map {
-	enum Enum { Read, Write, ReadWrite, WriteDiscard };
+	/// WriteNoOverwrite maps the buffer for writing without discarding its contents. The caller promises that it
+	/// will not modify any region that could still be used by a draw call that is in flight. This enables ring buffers
+	/// that append data every frame without stalling the CPU or reallocating the buffer.
+	enum Enum { Read, Write, ReadWrite, WriteDiscard, WriteNoOverwrite };
 
 	SGE_GPRAHICS_COMMON_ENUM_HIDE;
 };
@@ -276,7 +279,8 @@ struct TextureFormat {
 		MARKER_DEPTH_END,
 	};
 
-	// Returns the corresponding format size in bits
+	// Returns the corresponding format size in bits.
+	// For the block compressed formats this is the size of a 4x4 block in bytes.
 	static size_t GetSizeBits(const TextureFormat::Enum format);
 
 	// Returns the corresponding format size in bytes
@@ -740,22 +744,27 @@ struct VertexDecl {
 	std::string semantic;
 	UniformType::Enum format;
 	int byteOffset;
+	/// If true the element advances once per instance instead of once per vertex.
+	/// All elements sharing the same buffer slot must have the same value.
+	bool isPerInstance = false;
 
 	VertexDecl() = default;
 	~VertexDecl() = default;
 
-	VertexDecl(short bufferSlot, const char* semantic, UniformType::Enum format, short byteOffset)
+	VertexDecl(
+	    short bufferSlot, const char* semantic, UniformType::Enum format, short byteOffset, bool isPerInstance = false)
 	    : bufferSlot(bufferSlot)
 	    , semantic(semantic ? semantic : "")
 	    , format(format)
 	    , byteOffset(byteOffset)
+	    , isPerInstance(isPerInstance)
 	{
 	}
 
 	bool operator==(const VertexDecl& other) const
 	{
 		return (bufferSlot == other.bufferSlot) && (semantic == other.semantic) && (byteOffset == other.byteOffset) &&
-		       (format == other.format);
+		       (format == other.format) && (isPerInstance == other.isPerInstance);
 	}
 
 	bool operator!=(const VertexDecl& other) const { return !operator==(other); }
@@ -763,7 +772,7 @@ struct VertexDecl {
 	bool operator<(const VertexDecl& ref) const
 	{
 		return ref.bufferSlot > bufferSlot || ref.format > format || ref.byteOffset > byteOffset ||
-		       strcmp(ref.semantic.c_str(), semantic.c_str()) < 0;
+		       ref.isPerInstance > isPerInstance || strcmp(ref.semantic.c_str(), semantic.c_str()) < 0;
 	}
 
 	// Reorders the vertex declaration.
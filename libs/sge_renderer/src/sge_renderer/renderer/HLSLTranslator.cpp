@@ -21,9 +21,19 @@ bool translateHLSL(
     std::string& compilationErrors,
     std::set<std::string>* outIncludedFiles)
 {
-	M4::g_hlslParserErrors.clear();
+	const std::string preprocessedCode = preprocessHLSL(pCode, shadingLanguage, shaderType, outIncludedFiles);
+	return translatePreprocessedHLSL(preprocessedCode, shadingLanguage, shaderType, result, compilationErrors);
+}
 
+std::string preprocessHLSL(
+    const char* const pCode,
+    const ShadingLanguage::Enum shadingLanguage,
+    const ShaderType::Enum shaderType,
+    std::set<std::string>* outIncludedFiles,
+    bool* const outIsShaderTypeDependant)
+{
 	const char* const mOpenGL = "OpenGL";
+	const char* const mPixelShader = "SGE_PIXEL_SHADER";
 
 	std::vector<const char*> macros;
 
@@ -32,15 +42,32 @@ bool translateHLSL(
 	}
 
 	if (shaderType == ShaderType::PixelShader) {
-		macros.push_back("SGE_PIXEL_SHADER");
+		macros.push_back(mPixelShader);
 	}
 
+	return preprocessCode(
+	    pCode,
+	    "<NO-FILE>",
+	    macros.data(),
+	    int(macros.size()),
+	    "core_shaders/",
+	    outIncludedFiles,
+	    mPixelShader,
+	    outIsShaderTypeDependant);
+}
 
-	const std::string processsedCode =
-	    preprocessCode(pCode, "<NO-FILE>", macros.data(), int(macros.size()), "core_shaders/", outIncludedFiles);
+bool translatePreprocessedHLSL(
+    const std::string& preprocessedCode,
+    const ShadingLanguage::Enum shadingLanguage,
+    const ShaderType::Enum shaderType,
+    std::string& result,
+    std::string& compilationErrors)
+{
+	// The errors are thread_local, so many shaders could be translated at the same time.
+	M4::g_hlslParserErrors.clear();
 
 	M4::Allocator m4Alloc;
-	M4::HLSLParser hlslParser(&m4Alloc, "<NO-FILE>", processsedCode.c_str(), processsedCode.size());
+	M4::HLSLParser hlslParser(&m4Alloc, "<NO-FILE>", preprocessedCode.c_str(), preprocessedCode.size());
 	M4::HLSLTree tree(&m4Alloc);
 
 	if (hlslParser.Parse(&tree) == false) {
@@ -7,7 +7,7 @@
 namespace sge {
 
 // Translates the input D3D9 Style HLSL to the specified language.
-// Does preprocessing (+ #include directives) using MCPP.
+// Does preprocessing (+ #include directives) using @preprocessHLSL.
 // Assumes that the vertex shader main function is named vsMain
 // Assumes that the pixel shader main function is named psMain
 bool translateHLSL(
@@ -18,4 +18,22 @@ bool translateHLSL(
     std::string& compilationErrors,
     std::set<std::string>* outIncludedFiles = nullptr);
 
+// Preprocesses the code with the macros for the specified language (OpenGL) and shader type (SGE_PIXEL_SHADER).
+// @param [out] outIsShaderTypeDependant optional, set to false if the code never checks SGE_PIXEL_SHADER, meaning that
+// the result could be used for all shader types.
+std::string preprocessHLSL(
+    const char* const pCode,
+    const ShadingLanguage::Enum shadingLanguage,
+    const ShaderType::Enum shaderType,
+    std::set<std::string>* outIncludedFiles = nullptr,
+    bool* const outIsShaderTypeDependant = nullptr);
+
+// Same as @translateHLSL but for code that is already preprocessed with @preprocessHLSL.
+bool translatePreprocessedHLSL(
+    const std::string& preprocessedCode,
+    const ShadingLanguage::Enum shadingLanguage,
+    const ShaderType::Enum shaderType,
+    std::string& result,
+    std::string& compilationErrors);
+
 } // namespace sge
@@ -1,5 +1,6 @@
 #include "renderer.h"
 #include "HLSLTranslator.h"
+#include <cstring>
 
 namespace sge {
 
@@ -32,32 +33,57 @@ SGE_Impl_request_resource(Query, ResourceType::Query);
 
 CreateShaderResult ShadingProgram::createFromCustomHLSL(
     const char* const pVSCode, const char* const pPSCode, std::set<std::string>* outIncludedFiles)
+{
+	std::string vsTranslated;
+	std::string psTranslated;
+	const CreateShaderResult translateResult =
+	    translateCustomHLSL(pVSCode, pPSCode, vsTranslated, psTranslated, outIncludedFiles);
+	if (!translateResult.succeeded) {
+		return translateResult;
+	}
+
+	return createFromNativeCode(vsTranslated.c_str(), psTranslated.c_str());
+}
+
+CreateShaderResult ShadingProgram::translateCustomHLSL(
+    const char* const pVSCode,
+    const char* const pPSCode,
+    std::string& outVSNativeCode,
+    std::string& outPSNativeCode,
+    std::set<std::string>* outIncludedFiles)
 {
 	std::string compilationErrors;
 
-	std::string vsTranslated;
-	if (!translateHLSL(
-	        pVSCode,
-	        ShadingLanguage::ApiNative,
-	        ShaderType::VertexShader,
-	        vsTranslated,
-	        compilationErrors,
-	        outIncludedFiles)) {
+	bool isShaderTypeDependant = true;
+	const std::string vsPreprocessed = preprocessHLSL(
+	    pVSCode, ShadingLanguage::ApiNative, ShaderType::VertexShader, outIncludedFiles, &isShaderTypeDependant);
+
+	if (!translatePreprocessedHLSL(
+	        vsPreprocessed, ShadingLanguage::ApiNative, ShaderType::VertexShader, outVSNativeCode, compilationErrors)) {
 		return CreateShaderResult(false, compilationErrors);
 	}
 
-	std::string psTranslated;
-	if (!translateHLSL(
-	        pPSCode,
+	// Usually both stages are in the same code. If it doesn't check SGE_PIXEL_SHADER the preprocessed code is the same
+	// for both stages, so it is preprocessed only once.
+	const bool isSameCode = pVSCode == pPSCode || (pVSCode && pPSCode && strcmp(pVSCode, pPSCode) == 0);
+	std::string psPreprocessedOwn;
+	const std::string* psPreprocessed = &vsPreprocessed;
+	if (!isSameCode || isShaderTypeDependant) {
+		psPreprocessedOwn =
+		    preprocessHLSL(pPSCode, ShadingLanguage::ApiNative, ShaderType::PixelShader, outIncludedFiles);
+		psPreprocessed = &psPreprocessedOwn;
+	}
+
+	if (!translatePreprocessedHLSL(
+	        *psPreprocessed,
 	        ShadingLanguage::ApiNative,
 	        ShaderType::PixelShader,
-	        psTranslated,
-	        compilationErrors,
-	        outIncludedFiles)) {
+	        outPSNativeCode,
+	        compilationErrors)) {
 		return CreateShaderResult(false, compilationErrors);
 	}
 
-	return createFromNativeCode(vsTranslated.c_str(), psTranslated.c_str());
+	return CreateShaderResult(true, std::string());
 }
 
 } // namespace sge
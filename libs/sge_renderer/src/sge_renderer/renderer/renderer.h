@@ -237,6 +237,34 @@ struct ShadingProgram : public RAIResource {
 	CreateShaderResult createFromCustomHLSL(
 	    const char* const pVSCode, const char* const pPSCode, std::set<std::string>* outIncludedFiles = nullptr);
 
+	/// Does the CPU side of @createFromCustomHLSL - preprocesses and translates the code to the native shading language
+	/// of the API. It doesn't touch the graphics API so it could be called from any thread. The result should be passed
+	/// to @createFromNativeCode on the rendering thread.
+	static CreateShaderResult translateCustomHLSL(
+	    const char* const pVSCode,
+	    const char* const pPSCode,
+	    std::string& outVSNativeCode,
+	    std::string& outPSNativeCode,
+	    std::set<std::string>* outIncludedFiles = nullptr);
+
+	/// Retrieves the linked program in an API (and driver) specific binary form, that could be passed later to
+	/// @createFromProgramBinary in order to skip the shaders compilation and linking.
+	/// Returns false if the API doesn't support this.
+	virtual bool getProgramBinary(std::vector<char>& UNUSED(outBinary)) const { return false; }
+
+	/// Creates the program from a binary obtained by @getProgramBinary. The driver may reject the binary
+	/// (for example if it was updated since the binary was made). In that case the program is created from the
+	/// specified native code as @createFromNativeCode would do and @outUsedProgramBinary is set to false.
+	virtual CreateShaderResult createFromProgramBinary(
+	    const std::vector<char>& UNUSED(programBinary),
+	    const char* const pVSCode,
+	    const char* const pPSCode,
+	    bool& outUsedProgramBinary)
+	{
+		outUsedProgramBinary = false;
+		return createFromNativeCode(pVSCode, pPSCode);
+	}
+
 	virtual Shader* getVertexShader() const = 0;
 	virtual Shader* getPixelShader() const = 0;
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "sge_utils/sge_utils.h"
+
 namespace sge {
 
 template <typename T>
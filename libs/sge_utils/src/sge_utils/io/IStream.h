@@ -1,7 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <string.h>
 #include <string>
+#include <vector>
+
+#include "sge_utils/sge_utils.h"
 
 namespace sge {
 //[TODO] Add seeking in those streams
@@ -54,14 +58,10 @@ class ReadCStringStream : public IReadStream {
 	inline size_t read(void* destination, size_t numBytes) override
 	{
 		sgeAssert(destination);
-		char* chdest = (char*)destination;
 
-		size_t bytesRead = 0;
-		while ((bytesRead < numBytes) && (pointer < lenght)) {
-			chdest[bytesRead] = string[pointer];
-			pointer++;
-			bytesRead++;
-		}
+		const size_t bytesRead = (pointer < lenght) ? std::min(numBytes, lenght - pointer) : 0;
+		memcpy(destination, string + pointer, bytesRead);
+		pointer += bytesRead;
 
 		return bytesRead;
 	}
@@ -102,17 +102,7 @@ class WriteStdStringStream : public IWriteStream {
 	// @retval: the amount of data actually written
 	size_t write(const char* src, size_t numBytes) final
 	{
-		serializedString.reserve(serializedString.size() + numBytes);
-
-		const char* srcChar = (char*)src;
-		size_t bytesToWrite = numBytes;
-		while (bytesToWrite) {
-			serializedString += *srcChar;
-
-			srcChar++;
-			bytesToWrite--;
-		}
-
+		serializedString.append(src, numBytes);
 		return numBytes;
 	}
 };
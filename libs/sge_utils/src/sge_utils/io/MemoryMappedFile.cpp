@@ -0,0 +1,121 @@
+#include "MemoryMappedFile.h"
+
+#ifdef WIN32
+	#define NOMINMAX
+	#define WIN32_LEAN_AND_MEAN
+	#include <Windows.h>
+#elif defined(__EMSCRIPTEN__)
+	#include "sge_utils/io/FileStream.h"
+	#include <cstring>
+	#include <vector>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace sge {
+
+bool MemoryMappedFile::open(const char* const filename)
+{
+	close();
+
+	if (filename == nullptr) {
+		return false;
+	}
+
+#ifdef WIN32
+	HANDLE hFile =
+	    CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(hFile);
+		return false;
+	}
+
+	HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (hMapping == nullptr) {
+		CloseHandle(hFile);
+		return false;
+	}
+
+	const void* const mappedData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (mappedData == nullptr) {
+		CloseHandle(hMapping);
+		CloseHandle(hFile);
+		return false;
+	}
+
+	m_hFile = hFile;
+	m_hMapping = hMapping;
+	m_data = (const char*)mappedData;
+	m_sizeBytes = size_t(fileSize.QuadPart);
+#elif defined(__EMSCRIPTEN__)
+	std::vector<char> fileData;
+	if (!FileReadStream::readFile(filename, fileData) || fileData.empty()) {
+		return false;
+	}
+
+	m_readData = new char[fileData.size()];
+	memcpy(m_readData, fileData.data(), fileData.size());
+	m_data = m_readData;
+	m_sizeBytes = fileData.size();
+#else
+	const int fd = ::open(filename, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+		::close(fd);
+		return false;
+	}
+
+	void* const mappedData = mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps its own reference to the file.
+	::close(fd);
+	if (mappedData == MAP_FAILED) {
+		return false;
+	}
+
+	m_data = (const char*)mappedData;
+	m_sizeBytes = size_t(fileStat.st_size);
+#endif
+
+	return true;
+}
+
+void MemoryMappedFile::close()
+{
+#ifdef WIN32
+	if (m_data) {
+		UnmapViewOfFile(m_data);
+	}
+	if (m_hMapping) {
+		CloseHandle(m_hMapping);
+	}
+	if (m_hFile) {
+		CloseHandle(m_hFile);
+	}
+	m_hFile = nullptr;
+	m_hMapping = nullptr;
+#elif defined(__EMSCRIPTEN__)
+	delete[] m_readData;
+	m_readData = nullptr;
+#else
+	if (m_data) {
+		munmap((void*)m_data, m_sizeBytes);
+	}
+#endif
+
+	m_data = nullptr;
+	m_sizeBytes = 0;
+}
+
+} // namespace sge
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "sge_utils/sge_utils.h"
+
+namespace sge {
+
+/// Maps the contents of a file in the address space of the process (read only).
+/// The operating system loads the pages of the file on demand, so no copy of the data is made when opening the file.
+/// On platforms without memory mapping (Emscripten) the file gets read in memory instead.
+struct MemoryMappedFile : public NoCopyNoMove {
+	MemoryMappedFile() = default;
+	~MemoryMappedFile() { close(); }
+
+	/// Maps the specified file. Returns false if the file could not be opened or mapped.
+	bool open(const char* const filename);
+	void close();
+
+	bool isOpened() const { return m_data != nullptr; }
+
+	/// Returns a pointer to the beginning of the mapped file, nullptr if nothing is mapped.
+	const char* data() const { return m_data; }
+	size_t size() const { return m_sizeBytes; }
+
+  private:
+	const char* m_data = nullptr;
+	size_t m_sizeBytes = 0;
+
+#ifdef WIN32
+	void* m_hFile = nullptr;
+	void* m_hMapping = nullptr;
+#elif defined(__EMSCRIPTEN__)
+	char* m_readData = nullptr;
+#endif
+};
+
+} // namespace sge
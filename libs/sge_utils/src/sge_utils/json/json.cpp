@@ -1,11 +1,15 @@
 #include "sge_utils/json/json.h"
+#include "sge_utils/hash/hash_combine.h"
 #include "sge_utils/io/FileStream.h"
 #include "sge_utils/io/IStream.h"
+#include "sge_utils/io/MemoryMappedFile.h"
 #include "sge_utils/sge_utils.h"
 #include "sge_utils/text/format.h"
 
+#include <algorithm>
 #include <charconv>
 #include <cstring>
+#include <new>
 
 namespace sge {
 
@@ -56,23 +60,98 @@ int cstr2int(const char* cstr)
 /////////////////////////////////////////////////////////////////////////
 JsonValue* JsonValueBuffer::GetNewValue()
 {
-	const bool shouldAllocateChunk = (m_valuesBuffer.empty() || m_pointer == ChunkSize);
+	JsonValue* const value = new (allocate(sizeof(JsonValue), alignof(JsonValue))) JsonValue();
+	value->m_buffer = this;
+	return value;
+}
 
-	if (shouldAllocateChunk) {
-		m_pointer = 0;
-		m_valuesBuffer.push_back(new JsonValue[ChunkSize]);
+void* JsonValueBuffer::allocate(size_t numBytes, size_t alignment)
+{
+	if (numBytes == 0) {
+		return nullptr;
 	}
 
-	return &((m_valuesBuffer.back())[m_pointer++]);
+	const size_t blockSizeBytes = ChunkSize * sizeof(JsonValue);
+
+	// Big allocations (long strings or arrays) get a block of their own,
+	// so the space left in the current block could still be used.
+	if (numBytes > blockSizeBytes / 4) {
+		m_blocks.emplace_back(new char[numBytes]);
+		return m_blocks.back().get();
+	}
+
+	char* const alignedCursor = (char*)((uintptr_t(m_blockCursor) + alignment - 1) & ~uintptr_t(alignment - 1));
+	if (m_blockCursor == nullptr || alignedCursor + numBytes > m_blockEnd) {
+		m_blocks.emplace_back(new char[blockSizeBytes]);
+		m_blockCursor = m_blocks.back().get() + numBytes;
+		m_blockEnd = m_blocks.back().get() + blockSizeBytes;
+		return m_blocks.back().get();
+	}
+
+	m_blockCursor = alignedCursor + numBytes;
+	return alignedCursor;
 }
 
-void JsonValueBuffer::clearAllValues()
+const char* JsonValueBuffer::copyString(const char* const str, const size_t length)
+{
+	char* const result = allocateArray<char>(length + 1);
+	memcpy(result, str, length);
+	result[length] = '\0';
+	return result;
+}
+
+const char* JsonValueBuffer::internKey(const char* const key, const size_t length, const uint32 hash)
 {
-	for (size_t t = 0; t < m_valuesBuffer.size(); ++t) {
-		delete[] m_valuesBuffer[t];
+	// Keep the table at most half full, so the probing stays short.
+	if ((m_numInternedKeys + 1) * 2 > m_internedKeys.size()) {
+		std::vector<InternedKey> oldKeys = std::move(m_internedKeys);
+		m_internedKeys.clear();
+		m_internedKeys.resize(std::max<size_t>(64, oldKeys.size() * 2));
+
+		const size_t mask = m_internedKeys.size() - 1;
+		for (const InternedKey& oldKey : oldKeys) {
+			if (oldKey.key != nullptr) {
+				size_t slot = oldKey.hash & mask;
+				while (m_internedKeys[slot].key != nullptr) {
+					slot = (slot + 1) & mask;
+				}
+				m_internedKeys[slot] = oldKey;
+			}
+		}
 	}
 
-	m_valuesBuffer.clear();
+	const size_t mask = m_internedKeys.size() - 1;
+	size_t slot = hash & mask;
+	while (m_internedKeys[slot].key != nullptr) {
+		const InternedKey& existing = m_internedKeys[slot];
+		if (existing.hash == hash && existing.length == length && memcmp(existing.key, key, length) == 0) {
+			return existing.key;
+		}
+		slot = (slot + 1) & mask;
+	}
+
+	InternedKey& newKey = m_internedKeys[slot];
+	newKey.key = copyString(key, length);
+	newKey.length = uint32(length);
+	newKey.hash = hash;
+	m_numInternedKeys++;
+
+	return newKey.key;
+}
+
+uint32 JsonValueBuffer::hashKey(const char* const key, const size_t length)
+{
+	return hash_djb2(key, length);
+}
+
+void JsonValueBuffer::clearAllValues()
+{
+	m_blocks.clear();
+	m_blockCursor = nullptr;
+	m_blockEnd = nullptr;
+
+	m_internedKeys.clear();
+	m_numInternedKeys = 0;
 }
 
 JsonValue* JsonValueBuffer::operator()(const std::string& str)
@@ -129,6 +208,7 @@ JsonValue* JsonValueBuffer::operator()(const float* const arr, int size)
 	if (!arr)
 		size = 0;
 	JsonValue* retval = (*this)(JID_ARRAY_BEGIN);
+	retval->arrReserve(size);
 	for (int t = 0; t < size; ++t) {
 		retval->arrPush((*this)(arr[t]));
 	}
@@ -140,6 +220,7 @@ JsonValue* JsonValueBuffer::operator()(const int* const arr, int size)
 	if (!arr)
 		size = 0;
 	JsonValue* retval = (*this)(JID_ARRAY_BEGIN);
+	retval->arrReserve(size);
 	for (int t = 0; t < size; ++t) {
 		retval->arrPush((*this)(arr[t]));
 	}
@@ -159,6 +240,7 @@ JsonValue* JsonValueBuffer::operator()(const std::vector<int>& vec)
 JsonValue* JsonValueBuffer::operator()(const std::vector<std::string>& vec)
 {
 	JsonValue* retval = (*this)(JID_ARRAY_BEGIN);
+	retval->arrReserve(vec.size());
 	for (const auto& v : vec) {
 		retval->arrPush((*this)(v));
 	}
@@ -171,32 +253,94 @@ JsonValue* JsonValueBuffer::operator()(const std::vector<std::string>& vec)
 /////////////////////////////////////////////////////////////////////////
 void JsonValue::setFloat(const float v)
 {
-	*this = JsonValue();
+	clear();
 	jid = JID_REAL32;
 	value_float = v;
 }
 
 void JsonValue::setInt32(const sint32 v)
 {
-	*this = JsonValue();
+	clear();
 	jid = JID_INT32;
 	value_int32 = v;
 }
 
 void JsonValue::setUInt32(const uint32 v)
 {
-	*this = JsonValue();
+	clear();
 	jid = JID_INT32;
 	value_uint32 = v;
 }
 
 void JsonValue::setString(const char* const str)
 {
-	*this = JsonValue();
+	sgeAssert(m_buffer != nullptr && "JsonValues must be allocated by a JsonValueBuffer");
+
+	// Copy the string first, as it might be the current string of this value.
+	const size_t length = strlen(str);
+	const char* const strCopy = m_buffer->copyString(str, length);
+
+	clear();
 	jid = JID_STRING;
-	size_t len = strlen(str) + 1;
-	uniformData.resize(len);
-	memcpy(uniformData.data(), str, len);
+	m_string = strCopy;
+	m_size = uint32(length);
+}
+
+int JsonValue::findMemberIndex(const char* const name) const
+{
+	// The small maps are just scanned, no need to hash the name.
+	if (m_membersIndex == nullptr) {
+		for (uint32 t = 0; t < m_size; ++t) {
+			if (strcmp(m_members[t].key, name) == 0) {
+				return int(t);
+			}
+		}
+
+		return -1;
+	}
+
+	const uint32 nameHash = JsonValueBuffer::hashKey(name, strlen(name));
+	const uint32 mask = m_membersIndexCapacity - 1;
+	for (uint32 slot = nameHash & mask; m_membersIndex[slot] >= 0; slot = (slot + 1) & mask) {
+		const JsonMember& member = m_members[m_membersIndex[slot]];
+		if (member.keyHash == nameHash && strcmp(member.key, name) == 0) {
+			return m_membersIndex[slot];
+		}
+	}
+
+	return -1;
+}
+
+void JsonValue::rebuildMembersIndex()
+{
+	// Small maps are faster to just scan.
+	const uint32 kMinMembersForHashIndex = 16;
+	if (m_size < kMinMembersForHashIndex) {
+		m_membersIndex = nullptr;
+		m_membersIndexCapacity = 0;
+		return;
+	}
+
+	uint32 capacity = kMinMembersForHashIndex * 2;
+	while (capacity < m_size * 2) {
+		capacity *= 2;
+	}
+
+	if (capacity != m_membersIndexCapacity) {
+		m_membersIndex = m_buffer->allocateArray<int>(capacity);
+		m_membersIndexCapacity = capacity;
+	}
+
+	std::fill(m_membersIndex, m_membersIndex + capacity, -1);
+
+	const uint32 mask = capacity - 1;
+	for (uint32 iMember = 0; iMember < m_size; ++iMember) {
+		uint32 slot = m_members[iMember].keyHash & mask;
+		while (m_membersIndex[slot] >= 0) {
+			slot = (slot + 1) & mask;
+		}
+		m_membersIndex[slot] = int(iMember);
+	}
 }
 
 JsonValue* JsonValue::setMember(const char* const name, JsonValue* value)
@@ -212,48 +356,72 @@ JsonValue* JsonValue::setMember(const char* const name, JsonValue* value)
 	// minor curcular references check
 	sgeAssert(value != this);
 
-	for (size_t t = 0; t < members.size(); ++t) {
-		if (strcmp((char*)members[t].first.data(), name) == 0) {
-			members[t].second = value;
-			return value;
-		}
+	const int iExistingMember = findMemberIndex(name);
+	if (iExistingMember >= 0) {
+		m_members[iExistingMember].value = value;
+		return value;
+	}
+
+	const size_t nameLength = strlen(name);
+	const uint32 nameHash = JsonValueBuffer::hashKey(name, nameLength);
+
+	if (m_size == m_capacity) {
+		// The old members stay in the arena until the buffer gets cleared.
+		const uint32 newCapacity = std::max<uint32>(4, m_capacity * 2);
+		JsonMember* const newMembers = m_buffer->allocateArray<JsonMember>(newCapacity);
+		std::copy(m_members, m_members + m_size, newMembers);
+		m_members = newMembers;
+		m_capacity = newCapacity;
 	}
 
-	std::pair<std::vector<unsigned char>, JsonValue*> elem;
-	elem.first.resize(strlen(name) + 1);
-	sge_strcpy((char*)elem.first.data(), elem.first.size(), name);
-	elem.second = value;
+	const uint32 iNewMember = m_size;
+	m_members[iNewMember] = JsonMember{m_buffer->internKey(name, nameLength, nameHash), nameHash, value};
+	m_size++;
+
+	if (m_membersIndex != nullptr && m_size * 2 <= m_membersIndexCapacity) {
+		const uint32 mask = m_membersIndexCapacity - 1;
+		uint32 slot = nameHash & mask;
+		while (m_membersIndex[slot] >= 0) {
+			slot = (slot + 1) & mask;
+		}
+		m_membersIndex[slot] = int(iNewMember);
+	}
+	else {
+		rebuildMembersIndex();
+	}
 
-	members.push_back(std::move(elem));
 	return value;
 }
 
 const JsonValue* JsonValue::getMember(const char* const name) const
 {
 	sgeAssert(jid == JID_MAP_BEGIN);
-	for (size_t t = 0; t < members.size(); ++t) {
-		if (strcmp((char*)members[t].first.data(), name) == 0) {
-			return members[t].second;
-		}
+	if (jid != JID_MAP_BEGIN) {
+		return nullptr;
 	}
-	return nullptr;
+
+	const int iMember = findMemberIndex(name);
+	return iMember >= 0 ? m_members[iMember].value : nullptr;
 }
 
 const JsonValue& JsonValue::getMemberOrThrow(const char* const name, JID explectedType) const
 {
 	sgeAssert(jid == JID_MAP_BEGIN);
-	for (size_t t = 0; t < members.size(); ++t) {
-		if (strcmp((char*)members[t].first.data(), name) == 0) {
-			if (members[t].second != nullptr) {
-				if (explectedType != JID_NULL && members[t].second->jid != explectedType) {
-					throw JsonExceptAccess();
-				}
+	if (jid != JID_MAP_BEGIN) {
+		throw JsonExceptAccess();
+	}
 
-				return *members[t].second;
-			}
-		}
+	const int iMember = findMemberIndex(name);
+	if (iMember < 0 || m_members[iMember].value == nullptr) {
+		throw JsonExceptAccess();
 	}
-	throw JsonExceptAccess();
+
+	const JsonValue& member = *m_members[iMember].value;
+	if (explectedType != JID_NULL && member.jid != explectedType) {
+		throw JsonExceptAccess();
+	}
+
+	return member;
 }
 
 JsonValue* JsonValue::arrPush(JsonValue* value)
@@ -266,29 +434,54 @@ JsonValue* JsonValue::arrPush(JsonValue* value)
 	// minor curcular references check
 	sgeAssert(value != this);
 
-	arrayValues.push_back(value);
+	if (m_size == m_capacity) {
+		arrReserve(std::max<size_t>(4, size_t(m_capacity) * 2));
+	}
+
+	m_arrayValues[m_size++] = value;
 	return value;
 }
 
+void JsonValue::arrReserve(size_t numElements)
+{
+	if (jid != JID_ARRAY_BEGIN) {
+		sgeAssert(false);
+		return;
+	}
+
+	if (numElements <= m_capacity) {
+		return;
+	}
+
+	// The old elements stay in the arena until the buffer gets cleared.
+	JsonValue** const newArrayValues = m_buffer->allocateArray<JsonValue*>(numElements);
+	std::copy(m_arrayValues, m_arrayValues + m_size, newArrayValues);
+	m_arrayValues = newArrayValues;
+	m_capacity = uint32(numElements);
+}
+
 JsonValue* JsonValue::Clone(const JsonValue& root, JsonValueBuffer& jvb)
 {
 	JsonValue* const result = jvb(root.jid);
 	sgeAssert(result);
 
-	// Just duplicate the numeric value and the uniform data.
+	// Just duplicate the numeric value, the strings, arrays and members need to be in the new buffer.
 	result->value_uint64 = root.value_uint64;
-	result->uniformData = root.uniformData;
 
-	if (result->jid == JID_ARRAY) {
-		result->arrayValues.reserve(root.arrayValues.size());
+	if (result->jid == JID_STRING) {
+		result->m_string = jvb.copyString(root.m_string, root.m_size);
+		result->m_size = root.m_size;
+	}
+	else if (result->jid == JID_ARRAY) {
+		result->arrReserve(root.arrSize());
 
-		for (const JsonValue* const val : root.arrayValues) {
+		for (const JsonValue* const val : root.arr()) {
 			result->arrPush(JsonValue::Clone(*val, jvb));
 		}
 	}
 	else if (result->jid == JID_MAP) {
-		for (const auto& pair : root.members) {
-			result->setMember((const char*)pair.first.data(), JsonValue::Clone(*pair.second, jvb));
+		for (const JsonMember& member : root.getMembers()) {
+			result->setMember(member.key, JsonValue::Clone(*member.value, jvb));
 		}
 	}
 
@@ -301,8 +494,13 @@ JsonValue* JsonValue::Clone(const JsonValue& root, JsonValueBuffer& jvb)
 void JsonParser::Clear()
 {
 	root = nullptr;
-	accumCh = 0;
 	stream = nullptr;
+	streamText.clear();
+	textBegin = nullptr;
+	cursor = nullptr;
+	textEnd = nullptr;
+	arrayValuesStack.clear();
+	membersStack.clear();
 	parsingErrorMsg = nullptr;
 	clearAllValues();
 }
@@ -317,17 +515,98 @@ bool JsonParser::parse(IReadStream* instream)
 		return false;
 
 	stream = instream;
+	const size_t streamStartOffset = instream->pointerOffset();
+
+	const bool succeeded = parseText();
+
+	// The stream is read ahead in big pieces. Some files (the models for example) have binary data right after
+	// the json, so leave the stream right after the parsed value as if it was read char by char.
+	instream->seek(SeekOrigin::Begining, streamStartOffset + size_t(cursor - textBegin));
+
+	stream = nullptr;
+	streamText = std::vector<char>();
+	textBegin = nullptr;
+	cursor = nullptr;
+	textEnd = nullptr;
+
+	return succeeded;
+}
+
+bool JsonParser::parse(const char* const text, const size_t textLength)
+{
+	// reset the parser to inital state
+	Clear();
+
+	// validate the input
+	if (!text)
+		return false;
+
+	textBegin = text;
+	cursor = text;
+	textEnd = text + textLength;
+
+	const bool succeeded = parseText();
+
+	textBegin = nullptr;
+	cursor = nullptr;
+	textEnd = nullptr;
+
+	return succeeded;
+}
 
+bool JsonParser::parseFile(const char* const filename)
+{
+	MemoryMappedFile file;
+	if (!file.open(filename)) {
+		Clear();
+		return false;
+	}
+
+	// All strings are copied in the arena, so the file isn't needed after parsing.
+	return parse(file.data(), file.size());
+}
+
+bool JsonParser::parseText()
+{
 	try {
 		root = parseValue(getNextJID());
 	}
-	catch ([[maybe_unused]] const JsonParseError& except) {
+	catch (const JsonParseError& except) {
+		root = nullptr;
+		parsingErrorMsg = except.error;
 		return false;
 	}
 
 	return true;
 }
 
+bool JsonParser::refillFromStream()
+{
+	if (stream == nullptr) {
+		return false;
+	}
+
+	const size_t kStreamReadSize = 64 * 1024;
+
+	// The text read so far is kept, as the values being parsed may point in it.
+	const size_t cursorOffset = size_t(cursor - textBegin);
+	const size_t textSize = streamText.size();
+	streamText.resize(textSize + kStreamReadSize);
+	const size_t numBytesRead = stream->read(streamText.data() + textSize, kStreamReadSize);
+	streamText.resize(textSize + numBytesRead);
+
+	textBegin = streamText.data();
+	cursor = textBegin + cursorOffset;
+	textEnd = textBegin + streamText.size();
+
+	return numBytesRead > 0;
+}
+
+void JsonParser::throwUnexpectedEnd()
+{
+	throw JsonParseError("Unexpected end of stream!");
+}
+
 JID JsonParser::getNextJID()
 {
 	skipSpacesAhead();
@@ -347,7 +626,7 @@ JID JsonParser::getNextJID()
 		retval = JID_STRING;
 	else if (ch == '-' || ch == '+' || sge_isdigit(ch)) {
 		retval = JID_SOME_NUMBER;
-		returnChar(ch); // return this for later parsing
+		returnChar(); // return this for later parsing
 	}
 	else if (ch == 't') {
 		retval = JID_TRUE;
@@ -371,7 +650,7 @@ bool JsonParser::skipSeparatorAhead(char separator)
 				return true;
 			}
 			else {
-				returnChar(ch);
+				returnChar();
 				return false;
 			}
 		}
@@ -383,19 +662,59 @@ void JsonParser::skipSpacesAhead()
 	while (true) {
 		char ch = GetChar();
 		if (!sge_isspace(ch)) {
-			returnChar(ch);
+			returnChar();
+			break;
+		}
+	}
+}
+
+const char* JsonParser::readRawString(size_t& outLength, const bool procStringTokens, bool& outHasTokens)
+{
+	outHasTokens = false;
+
+	// Use an offset, as the text gets reallocated when more of the stream is read.
+	const size_t startOffset = size_t(cursor - textBegin);
+	while (true) {
+		// Skip the ordinary characters that are already read, GetChar() below refills the text if needed.
+		while (cursor != textEnd && *cursor != '"' && *cursor != '\\') {
+			cursor++;
+		}
+
+		const char ch = GetChar();
+		if (ch == '"') {
 			break;
 		}
+
+		if (procStringTokens && ch == '\\') {
+			outHasTokens = true;
+			GetChar(); // The character after the slash, it might be a '"' that doesn't end the string.
+		}
 	}
+
+	outLength = size_t(cursor - textBegin) - startOffset - 1;
+	return textBegin + startOffset;
 }
 
-void JsonParser::readString(std::vector<unsigned char>& str, const bool procStringTokens)
+const char* JsonParser::readString(size_t& outLength)
 {
-	str.reserve(32); // good enough for the most common cases
-	char ch;
-	while ((ch = GetChar()) != '"') {
-		if (procStringTokens == true && ch == '\\') {
-			const char nextCh = GetChar();
+	bool hasTokens = false;
+	size_t rawLength = 0;
+	const char* const rawString = readRawString(rawLength, true, hasTokens);
+
+	if (hasTokens == false) {
+		outLength = rawLength;
+		return copyString(rawString, rawLength);
+	}
+
+	// Converting the tokens only makes the string shorter.
+	char* const str = allocateArray<char>(rawLength + 1);
+	size_t length = 0;
+	for (size_t t = 0; t < rawLength; ++t) {
+		char ch = rawString[t];
+
+		if (ch == '\\') {
+			// readRawString guarantees that there is a character after the slash.
+			const char nextCh = rawString[++t];
 
 			if (nextCh == 't')
 				ch = '\t';
@@ -405,12 +724,14 @@ void JsonParser::readString(std::vector<unsigned char>& str, const bool procStri
 				ch = '\r';
 			else if (nextCh == 'b')
 				ch = '\b';
-			else if (nextCh == '\\')
-				ch = '\\';
-			else if (nextCh == '\f')
+			else if (nextCh == 'f')
 				ch = '\f';
-			else if (nextCh == '"')
-				ch = '\"';
+			else if (nextCh == 'a')
+				ch = '\a';
+			else if (nextCh == 'v')
+				ch = '\v';
+			else if (nextCh == '\\' || nextCh == '"' || nextCh == '\'' || nextCh == '?' || nextCh == '/')
+				ch = nextCh;
 			else if (nextCh == 'u') {
 				sgeAssert(false);
 				throw JsonParseError("'\\u' tokens aren't supported!");
@@ -421,11 +742,12 @@ void JsonParser::readString(std::vector<unsigned char>& str, const bool procStri
 			}
 		}
 
-		str.push_back(ch);
+		str[length++] = ch;
 	}
 
-	// add the null terimanor
-	str.push_back(0);
+	str[length] = '\0';
+	outLength = length;
+	return str;
 }
 
 void JsonParser::readNumber()
@@ -435,16 +757,19 @@ void JsonParser::readNumber()
 	while (true) {
 		const char ch = GetChar();
 		if (sge_isdigit(ch) || ch == '.' || ch == '-' || ch == '+' || ch == 'e' || ch == 'E') {
+			if (numconvertidx + 1 >= numconvert.size()) {
+				throw JsonParseError("The number is too long!");
+			}
+
 			numAppearsFloaty = numAppearsFloaty || ch == '.' || ch == 'e' || ch == 'E';
 			numconvert[numconvertidx++] = ch;
 		}
 		else {
-			returnChar(ch);
+			returnChar();
 			break;
 		}
 	}
 
-	sgeAssert(numconvertidx < numconvert.size());
 	numconvert[numconvertidx] = 0;
 }
 
@@ -504,7 +829,10 @@ JsonValue* JsonParser::parseValue(const JID selfJID)
 	else if (selfJID == JID_STRING) {
 		JsonValue* result = GetNewValue();
 		result->jid = JID_STRING;
-		readString(result->uniformData, true);
+
+		size_t length = 0;
+		result->m_string = readString(length);
+		result->m_size = uint32(length);
 		return result;
 	}
 	// ARRAYS
@@ -512,8 +840,9 @@ JsonValue* JsonParser::parseValue(const JID selfJID)
 		JsonValue* result = GetNewValue();
 		result->jid = JID_ARRAY_BEGIN;
 
-		//[NOTE] That helps a bit but leave it commented
-		// result->arrayValues.reserve(8);
+		// The elements are collected on the stack (after the ones of the arrays containing this one)
+		// and are moved in the arena once their count is known.
+		const size_t firstElementIndex = arrayValuesStack.size();
 		while (true) {
 			JID jid = getNextJID();
 
@@ -524,7 +853,7 @@ JsonValue* JsonParser::parseValue(const JID selfJID)
 
 			// read and add the member
 			JsonValue* member = parseValue(jid);
-			result->arrayValues.emplace_back(member);
+			arrayValuesStack.push_back(member);
 #if 1
 			// if there isn't comma then
 			// this is the end of the array
@@ -541,6 +870,15 @@ JsonValue* JsonParser::parseValue(const JID selfJID)
 #endif
 		}
 
+		const size_t numElements = arrayValuesStack.size() - firstElementIndex;
+		if (numElements != 0) {
+			result->m_arrayValues = allocateArray<JsonValue*>(numElements);
+			std::copy(arrayValuesStack.begin() + firstElementIndex, arrayValuesStack.end(), result->m_arrayValues);
+			result->m_size = uint32(numElements);
+			result->m_capacity = uint32(numElements);
+			arrayValuesStack.resize(firstElementIndex);
+		}
+
 		return result;
 	}
 	// MAPS
@@ -548,8 +886,8 @@ JsonValue* JsonParser::parseValue(const JID selfJID)
 		JsonValue* result = GetNewValue();
 		result->jid = JID_MAP_BEGIN;
 
-		//[NOTE] That helps a bit but leave it commented
-		// result->members.reserve(8);
+		// Same as the arrays, the members are collected on the stack first.
+		const size_t firstMemberIndex = membersStack.size();
 		while (true) {
 			JID jid = getNextJID();
 
@@ -563,9 +901,12 @@ JsonValue* JsonParser::parseValue(const JID selfJID)
 				throw JsonParseError("Expected indentifier!");
 			}
 
-			// read the variable name
-			std::vector<unsigned char> idnetifier;
-			readString(idnetifier, false);
+			// read the variable name, the names are interned as most of them repeat a lot.
+			bool hasTokens = false;
+			size_t identifierLength = 0;
+			const char* const identifier = readRawString(identifierLength, false, hasTokens);
+			const uint32 identifierHash = hashKey(identifier, identifierLength);
+			const char* const key = internKey(identifier, identifierLength, identifierHash);
 
 			// read the :
 #if 1
@@ -578,8 +919,7 @@ JsonValue* JsonParser::parseValue(const JID selfJID)
 
 			// get the member value
 			JsonValue* member = parseValue(getNextJID());
-			result->members.emplace_back(
-			    std::pair<std::vector<unsigned char>, JsonValue*>(std::move(idnetifier), std::move(member)));
+			membersStack.push_back(JsonMember{key, identifierHash, member});
 
 #if 1
 			// ckeck for comma ahead.
@@ -598,6 +938,16 @@ JsonValue* JsonParser::parseValue(const JID selfJID)
 #endif
 		}
 
+		const size_t numMembers = membersStack.size() - firstMemberIndex;
+		if (numMembers != 0) {
+			result->m_members = allocateArray<JsonMember>(numMembers);
+			std::copy(membersStack.begin() + firstMemberIndex, membersStack.end(), result->m_members);
+			result->m_size = uint32(numMembers);
+			result->m_capacity = uint32(numMembers);
+			result->rebuildMembersIndex();
+			membersStack.resize(firstMemberIndex);
+		}
+
 		return result;
 	}
 	// UNKNOWN
@@ -606,33 +956,6 @@ JsonValue* JsonParser::parseValue(const JID selfJID)
 	}
 }
 
-char JsonParser::GetChar()
-{
-	if (accumCh != 0) {
-		char retval = accumCh;
-		accumCh = 0;
-		return retval;
-	}
-
-	char ch;
-	if (stream->read(&ch, 1) == 0) {
-		throw JsonParseError("Unexpected end of stream!");
-	}
-
-	return ch;
-}
-
-void JsonParser::returnChar(char ch)
-{
-#ifdef SGE_USE_DEBUG
-	if (accumCh != 0) {
-		throw JsonParseError("Json Parser Implementation error! ReturnChar() called multiple times!");
-	}
-#endif
-
-	accumCh = ch;
-}
-
 /////////////////////////////////////////////////////////////////////////
 // JsonWriter
 /////////////////////////////////////////////////////////////////////////
@@ -646,19 +969,30 @@ bool JsonWriter::write(IWriteStream* wstream, const JsonValue* const root, const
 
 	bPretty = prettify;
 	prettyIdentation = 0;
+	encodedData.clear();
 
 	try {
 		writeVairable(root);
+		flushEncodedData();
 	}
 	catch (const JsonParseError& except) {
 		[[maybe_unused]] const char* const err = except.error;
 		sgeAssert(false);
+		encodedData.clear();
 		return false;
 	}
 
 	return true;
 }
 
+void JsonWriter::flushEncodedData()
+{
+	if (encodedData.empty() == false) {
+		stream->write(encodedData.data(), encodedData.size());
+		encodedData.clear();
+	}
+}
+
 bool JsonWriter::WriteInFile(const char* const filename, const JsonValue* const root, const bool prettify)
 {
 	FileWriteStream fws;
@@ -689,7 +1023,7 @@ void JsonWriter::write(const char ch, bool forceNoPretty)
 				write('\t');
 		}
 
-		stream->write(&ch, 1);
+		encodedData.push_back(ch);
 
 		if (isOpenBlock || ch == ',') {
 			write('\n');
@@ -698,14 +1032,14 @@ void JsonWriter::write(const char ch, bool forceNoPretty)
 		}
 	}
 	else {
-		stream->write(&ch, 1);
+		encodedData.push_back(ch);
 	}
 }
 
 void JsonWriter::writeString(const char* str, const bool procStringTokens)
 {
 	if (procStringTokens == false) {
-		stream->write(str, strlen(str));
+		encodedData.insert(encodedData.end(), str, str + strlen(str));
 		return;
 	}
 
@@ -741,6 +1075,12 @@ void JsonWriter::writeString(const char* str, const bool procStringTokens)
 
 void JsonWriter::writeVairable(const JsonValue* const value)
 {
+	// Write the output in big pieces, the streams are slow with many small writes.
+	const size_t kFlushSizeBytes = 64 * 1024;
+	if (encodedData.size() >= kFlushSizeBytes) {
+		flushEncodedData();
+	}
+
 	const JID jid = value->jid;
 
 	if (jid == JID_INT8) {
@@ -780,7 +1120,7 @@ void JsonWriter::writeVairable(const JsonValue* const value)
 	}
 	else if (jid == JID_STRING) {
 		write('"');
-		writeString((char*)value->uniformData.data(), true);
+		writeString(value->GetString(), true);
 		write('"');
 	}
 	else if (jid == JID_FALSE) {
@@ -791,10 +1131,11 @@ void JsonWriter::writeVairable(const JsonValue* const value)
 	}
 	else if (jid == JID_ARRAY_BEGIN) {
 		write('[');
-		for (size_t t = 0; t < value->arrayValues.size(); ++t) {
-			writeVairable(value->arrayValues[t]);
+		const span<JsonValue* const> arrayValues = value->arr();
+		for (size_t t = 0; t < arrayValues.size(); ++t) {
+			writeVairable(arrayValues[t]);
 
-			if (t != value->arrayValues.size() - 1) {
+			if (t != arrayValues.size() - 1) {
 				write(',');
 			}
 		}
@@ -802,17 +1143,18 @@ void JsonWriter::writeVairable(const JsonValue* const value)
 	}
 	else if (jid == JID_MAP_BEGIN) {
 		write('{');
-		for (size_t t = 0; t < value->members.size(); ++t) {
+		const span<const JsonMember> members = value->getMembers();
+		for (size_t t = 0; t < members.size(); ++t) {
 			// the variable name
 			write('"');
-			writeString((char*)value->members[t].first.data(), false);
+			writeString(members[t].key, false);
 			write('"');
 			write(':');
 
 			// the value
-			writeVairable(value->members[t].second);
+			writeVairable(members[t].value);
 
-			if (t + 1 != value->members.size()) {
+			if (t + 1 != members.size()) {
 				write(',');
 			}
 		}
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "sge_utils/containers/span.h"
 #include "sge_utils/sge_utils.h"
 
 namespace sge {
@@ -12,6 +14,7 @@ class IReadStream;
 class IWriteStream;
 
 struct JsonValueBuffer;
+class JsonParser;
 
 /////////////////////////////////////////////////////////////////////////
 // Json control characters IDs
@@ -52,16 +55,31 @@ enum JID : unsigned char {
 struct JsonExceptAccess {
 };
 
+struct JsonValue;
+
+/// A member of a json map. The key is interned by the JsonValueBuffer that owns the map,
+/// so all members with the same name in that buffer share the same string.
+struct JsonMember {
+	const char* key = nullptr;
+	uint32 keyHash = 0;
+	JsonValue* value = nullptr;
+};
+
 /////////////////////////////////////////////////////////////////////////
 // struct JsonValue
+// The strings, arrays and members of the value live in the memory of the JsonValueBuffer that allocated it.
+// Because of this values must be created only with JsonValueBuffer.
 /////////////////////////////////////////////////////////////////////////
 struct JsonValue {
 	void clear()
 	{
 		jid = JID_NULL;
-		uniformData.clear();
-		arrayValues.clear();
-		members.clear();
+		value_uint64 = 0;
+		m_data = nullptr;
+		m_size = 0;
+		m_capacity = 0;
+		m_membersIndex = nullptr;
+		m_membersIndexCapacity = 0;
 	}
 
 	JsonValue() { clear(); }
@@ -90,6 +108,8 @@ struct JsonValue {
 	// map operators
 	JsonValue* setMember(const char* const name, JsonValue* value); // Returns value.
 	const JsonValue* getMember(const char* const name) const;
+	size_t numMembers() const { return isMap() ? m_size : 0; }
+	span<const JsonMember> getMembers() const { return span<const JsonMember>(m_members, numMembers()); }
 
 	/// @brief Retrieves a member or throws JsonExceptAccess is missing or its type is different form @explectedType if
 	/// != JID_NULL.
@@ -99,19 +119,23 @@ struct JsonValue {
 
 	// Array operators
 	JsonValue* arrPush(JsonValue* value); // returns value
-	size_t arrSize() const { return arrayValues.size(); }
-	const JsonValue* arrAt(const size_t index) const { return arrayValues[index]; }
-	const std::vector<JsonValue*>& arr() const { return arrayValues; }
+	void arrReserve(size_t numElements);
+	size_t arrSize() const { return isArray() ? m_size : 0; }
+	const JsonValue* arrAt(const size_t index) const { return m_arrayValues[index]; }
+	span<JsonValue* const> arr() const { return span<JsonValue* const>(m_arrayValues, arrSize()); }
 
-	const char* GetString() const { return (char*)uniformData.data(); }
+	const char* GetString() const { return isString() ? m_string : nullptr; }
 	const char* GetStringOrThrow() const
 	{
 		if (jid != JID_STRING) {
 			throw JsonExceptAccess();
 		}
-		return (char*)uniformData.data();
+		return m_string;
 	}
 
+	/// Returns the length of the string without the null terminator, 0 if the value isn't a string.
+	size_t getStringLength() const { return isString() ? m_size : 0; }
+
 	template <typename T>
 	T getNumberAs() const
 	{
@@ -230,23 +254,51 @@ struct JsonValue {
 	bool isMap() const { return jid == JID_MAP_BEGIN; }
 	bool isString() const { return jid == JID_STRING; }
 
-	JID jid;                                // The ID of the variable type.
-	std::vector<unsigned char> uniformData; // Just a data buffer, currently used for strings.
-	std::vector<JsonValue*> arrayValues;
-	std::vector<std::pair<std::vector<unsigned char>, JsonValue*>> members;
+	JID jid; // The ID of the variable type.
 
 	static JsonValue* Clone(const JsonValue& root, JsonValueBuffer& jvb);
+
+  private:
+	friend JsonValueBuffer;
+	friend class JsonParser;
+
+	/// Returns the index of the member or -1 if there isn't such member.
+	int findMemberIndex(const char* const name) const;
+	/// (Re)builds the hash table used to look up the members, if the map is big enough to need one.
+	void rebuildMembersIndex();
+
+	/// The buffer that allocated this value. Strings, arrays and members are allocated from it as well.
+	JsonValueBuffer* m_buffer = nullptr;
+
+	/// The string (null terminated), the array elements or the map members depending on @jid.
+	union {
+		void* m_data;
+		const char* m_string;
+		JsonValue** m_arrayValues;
+		JsonMember* m_members;
+	};
+
+	/// The length of the string, the number of array elements or map members.
+	uint32 m_size;
+	uint32 m_capacity;
+
+	/// Big maps have an open addressing hash table of member indices (-1 for empty slots), so lookups don't
+	/// have to check every member.
+	int* m_membersIndex;
+	uint32 m_membersIndexCapacity;
 };
 
 /// JsonValueBuffer provides an easy way to allocate @JsonValue and leaving
 /// the deletion of the newly allocated objects to it.
-struct JsonValueBuffer {
+/// It is an arena, the values, their strings, arrays and members are allocated linearly in big blocks of memory,
+/// which are freed all at once. Map member names are interned, each unique name is stored once per buffer.
+struct JsonValueBuffer : public NoCopy {
   public:
+	// @ChunkSize is the number of values that fit in each block of memory of the arena.
 	// TODO: the default value of ChunkSize wasn't picked by any
 	// obersvation or measurement.
-	JsonValueBuffer(size_t ChunkSize = 100)
+	JsonValueBuffer(size_t ChunkSize = 1024)
 	    : ChunkSize(ChunkSize)
-	    , m_pointer(0)
 	{
 	}
 
@@ -255,6 +307,24 @@ struct JsonValueBuffer {
 	// allocates a new value
 	JsonValue* GetNewValue();
 
+	/// Allocates uninitialized memory that lives until @clearAllValues is called.
+	void* allocate(size_t numBytes, size_t alignment);
+
+	template <typename T>
+	T* allocateArray(size_t numElements)
+	{
+		return static_cast<T*>(allocate(sizeof(T) * numElements, alignof(T)));
+	}
+
+	/// Copies the string in the arena and adds a null terminator.
+	const char* copyString(const char* const str, const size_t length);
+
+	/// Returns the copy of the string that is shared by all map members with that name in this buffer.
+	const char* internKey(const char* const key, const size_t length, const uint32 hash);
+
+	/// The hash used for the interned map member names.
+	static uint32 hashKey(const char* const key, const size_t length);
+
 	JsonValue* operator()(const std::string& str);
 	JsonValue* operator()(const char* const str);
 	JsonValue* operator()(const float);
@@ -274,58 +344,99 @@ struct JsonValueBuffer {
 	void clearAllValues();
 
   private:
+	struct InternedKey {
+		const char* key = nullptr;
+		uint32 length = 0;
+		uint32 hash = 0;
+	};
+
 	size_t ChunkSize;
-	std::vector<JsonValue*> m_valuesBuffer;
-	size_t m_pointer;
+	std::vector<std::unique_ptr<char[]>> m_blocks;
+	char* m_blockCursor = nullptr;
+	char* m_blockEnd = nullptr;
+
+	/// An open addressing hash table of the interned map member names.
+	std::vector<InternedKey> m_internedKeys;
+	size_t m_numInternedKeys = 0;
 };
 
 /////////////////////////////////////////////////////////////////////////
 // JsonParser
+// Parses json text from memory. Streams are read in big pieces as the parsing goes.
 /////////////////////////////////////////////////////////////////////////
 class JsonParser : protected JsonValueBuffer {
   public:
 	JsonParser() {}
 	void Clear();
 
-	bool parse(IReadStream& instream) { parse(&instream); }
+	bool parse(IReadStream& instream) { return parse(&instream); }
 	bool parse(IReadStream* instream);
 
+	/// Parses the json text in the specified memory. The memory isn't needed after the function returns.
+	bool parse(const char* const text, const size_t textLength);
+
+	/// Parses the json text in the specified file, the file is memory mapped while parsing.
+	bool parseFile(const char* const filename);
+
 	JsonValue* getRoot() { return root; }
 	const JsonValue* getRoot() const { return root; }
 	const char* getErrorMsg() const { return parsingErrorMsg; }
 
   private:
+	bool parseText(); // parses the text between cursor and textEnd (refilled from the stream if any)
+
 	JID getNextJID();                        // returns the JID of the next element
 	bool skipSeparatorAhead(char separator); // skips to 1st non space symbol. retval is (symbol == separator)
 	void skipSpacesAhead();                  // skips all spaces ahead
-	void readString(
-	    std::vector<unsigned char>& str,
-	    const bool
-	        procStringTokens); // if procStringTokens is true than the parser will try to convert \n \r \t symbols
-	void readNumber();         // reads a number and stores the string in (numconvert,numconvertidx)
+
+	// Reads the string up to the closing quote and returns a pointer to it in the parsed text (valid until the next
+	// GetChar). If procStringTokens is true, \" does not end the string and outHasTokens is set if \n \r \t symbols
+	// are present and need to be converted.
+	const char* readRawString(size_t& outLength, const bool procStringTokens, bool& outHasTokens);
+	const char* readString(size_t& outLength); // reads a string value and stores it in the arena.
+	void readNumber(); // reads a number and stores the string in (numconvert,numconvertidx)
 
 	// reads a value form the stream
 	JsonValue* parseValue(JID selfJID);
 
 	// returns the next character
-	char GetChar();
+	char GetChar()
+	{
+		if (cursor == textEnd && !refillFromStream()) {
+			throwUnexpectedEnd();
+		}
+		return *cursor++;
+	}
 
 	// while trying to read tokens we may accidentaly
 	// read something that belongs to other token
-	// ch will be the next result form GetChar()
-	void returnChar(char ch);
+	// this steps back so that character is returned by the next GetChar()
+	void returnChar() { cursor--; }
+
+	// Appends the next piece of the stream to the parsed text. Returns false if there is nothing more to read.
+	bool refillFromStream();
+
+	[[noreturn]] static void throwUnexpectedEnd();
 
   private:
-	IReadStream* stream; // json source, do not delete this the parser doesnt own that object
-	char accumCh;        // the buffer for GetChar()/ReturnChar()
+	IReadStream* stream = nullptr;       // json source, do not delete this the parser doesnt own that object
+	std::vector<char> streamText;        // the text read so far from the stream.
+	const char* textBegin = nullptr;     // the beginning of the json text.
+	const char* cursor = nullptr;        // the next character to be parsed.
+	const char* textEnd = nullptr;       // one past the last character of the json text read so far.
+
+	// The elements of the arrays and maps being parsed, the nested ones are stacked at the back.
+	// Once an array or a map is parsed its elements are moved in the arena with their exact count.
+	std::vector<JsonValue*> arrayValuesStack;
+	std::vector<JsonMember> membersStack;
 
 	// used for converting from string to double/float/int/ect.
 	std::array<char, 32> numconvert; // If you modify the array size, please do NOT forget to update it the writer too.
 	unsigned numconvertidx;
 	bool numAppearsFloaty;
 
-	JsonValue* root; // a pointer to root value
-	const char* parsingErrorMsg;
+	JsonValue* root = nullptr; // a pointer to root value
+	const char* parsingErrorMsg = nullptr;
 };
 
 /////////////////////////////////////////////////////////////////////////
@@ -347,6 +458,9 @@ class JsonWriter {
 	    const char* string,
 	    const bool procStringTokens); // set procStringTokens to true to convert \t\n\r ect to '\' + 'n' ect..
 
+	// The output is accumulated here and written to the stream in big pieces.
+	void flushEncodedData();
+
 	std::vector<char> encodedData;
 	std::array<char, 32> numconvert;
 	IWriteStream* stream;
@@ -0,0 +1,72 @@
+#include "BoxBVH.h"
+#include <algorithm>
+
+namespace sge {
+
+void BoxBVH::build(const Box3f* const boxes, const int numBoxes, const int maxItemsPerLeaf)
+{
+	clear();
+
+	m_itemBoxes.assign(boxes, boxes + numBoxes);
+	m_centroids.resize(numBoxes);
+	m_items.reserve(numBoxes);
+	for (int iBox = 0; iBox < numBoxes; ++iBox) {
+		if (boxes[iBox].isEmpty() == false) {
+			m_items.push_back(iBox);
+			m_centroids[iBox] = boxes[iBox].center();
+		}
+	}
+
+	if (m_items.empty()) {
+		return;
+	}
+
+	// A balanced binary tree has less than 2*N nodes.
+	m_nodes.reserve(2 * (m_items.size() / std::max(maxItemsPerLeaf, 1) + 1));
+	m_nodes.emplace_back();
+	buildNode(0, 0, int(m_items.size()), std::max(maxItemsPerLeaf, 1));
+
+	m_centroids.clear();
+}
+
+void BoxBVH::buildNode(const int iNode, const int firstItem, const int numItems, const int maxItemsPerLeaf)
+{
+	Box3f nodeBox;
+	Box3f centroidsBox;
+	for (int t = firstItem; t < firstItem + numItems; ++t) {
+		nodeBox.expand(m_itemBoxes[m_items[t]]);
+		centroidsBox.expand(m_centroids[m_items[t]]);
+	}
+
+	m_nodes[iNode].box = nodeBox;
+
+	// Stop splitting when the node is small enough or all the items are at the same location.
+	const vec3f centroidsSize = centroidsBox.size();
+	const int splitAxis = centroidsSize.x >= centroidsSize.y && centroidsSize.x >= centroidsSize.z
+	                          ? 0
+	                          : (centroidsSize.y >= centroidsSize.z ? 1 : 2);
+	if (numItems <= maxItemsPerLeaf || centroidsSize[splitAxis] <= 0.f) {
+		m_nodes[iNode].firstItem = firstItem;
+		m_nodes[iNode].numItems = numItems;
+		return;
+	}
+
+	// Split the items in two equal halves along the longest axis, this keeps the tree balanced.
+	const int numItemsLeft = numItems / 2;
+	std::nth_element(
+	    m_items.begin() + firstItem,
+	    m_items.begin() + firstItem + numItemsLeft,
+	    m_items.begin() + firstItem + numItems,
+	    [&](const int a, const int b) -> bool { return m_centroids[a][splitAxis] < m_centroids[b][splitAxis]; });
+
+	// The children must be next to each other, allocate both before building their sub-trees.
+	const int iFirstChild = int(m_nodes.size());
+	m_nodes.emplace_back();
+	m_nodes.emplace_back();
+	m_nodes[iNode].firstChild = iFirstChild;
+
+	buildNode(iFirstChild, firstItem, numItemsLeft, maxItemsPerLeaf);
+	buildNode(iFirstChild + 1, firstItem + numItemsLeft, numItems - numItemsLeft, maxItemsPerLeaf);
+}
+
+} // namespace sge
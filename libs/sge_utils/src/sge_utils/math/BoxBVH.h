@@ -0,0 +1,228 @@
+#pragma once
+
+#include "sge_utils/math/Box3f.h"
+#include "sge_utils/math/Frustum.h"
+#include <cfloat>
+#include <vector>
+
+namespace sge {
+
+/// BoxBVH is a bounding volume hierarchy over a fixed set of axis aligned boxes.
+/// It is built once (in O(n log n)) and then queried with rays or frustums. Every box is identified by its index in
+/// the array passed to @build. The hierarchy cannot be modified, call @build again if the boxes change.
+struct BoxBVH {
+	struct Node {
+		Box3f box;
+		/// For inner nodes the index of the 1st child node, the 2nd child is right after it. -1 for leaves.
+		int firstChild = -1;
+		/// For leaves the range of items in @m_items.
+		int firstItem = 0;
+		int numItems = 0;
+
+		bool isLeaf() const { return firstChild < 0; }
+	};
+
+	/// Builds the hierarchy. Empty boxes are ignored and never returned by the queries.
+	void build(const Box3f* const boxes, const int numBoxes, const int maxItemsPerLeaf = 4);
+
+	void clear()
+	{
+		m_nodes.clear();
+		m_items.clear();
+		m_itemBoxes.clear();
+	}
+
+	bool isEmpty() const { return m_nodes.empty(); }
+
+	/// Finds the closest item along the ray.
+	/// @param [in] intersectItem a callback "float (int itemIndex, float tBoxEnter)" called for every item whose box
+	///        is hit by the ray, closer than the closest hit found so far. It should return the ray parameter of the
+	///        exact intersection with the item or FLT_MAX if there is none. The items get visited roughly front to back
+	///        so the traversal could skip most of the hierarchy.
+	/// @param [out] outT the ray parameter of the closest hit.
+	/// @return the index of the closest item or -1 if nothing was hit.
+	template <typename TIntersectItem>
+	int raycast(const vec3f& rayOrigin, const vec3f& rayDir, TIntersectItem&& intersectItem, float* const outT = nullptr)
+	    const;
+
+	/// Calls @fn "void (int itemIndex)" for every item whose box is not outside of the frustum.
+	template <typename TFn>
+	void queryFrustum(const Frustum& frustum, TFn&& fn) const;
+
+	/// Calls @fn "void (int itemIndex)" for every item whose box overlaps @box.
+	template <typename TFn>
+	void queryBox(const Box3f& box, TFn&& fn) const;
+
+	const std::vector<Node>& getNodes() const { return m_nodes; }
+
+  private:
+	/// Fills the already allocated node @iNode with the specified items, splitting it if needed.
+	void buildNode(const int iNode, const int firstItem, const int numItems, const int maxItemsPerLeaf);
+
+	static bool intersectRayBox(const Box3f& box, const vec3f& origin, const vec3f& invDir, float& tEnter)
+	{
+		if (!box.intersectFast(origin, invDir, tEnter)) {
+			return false;
+		}
+
+		// The ray starts inside the box.
+		if (tEnter < 0.f) {
+			tEnter = 0.f;
+		}
+
+		return true;
+	}
+
+  private:
+	std::vector<Node> m_nodes;
+	std::vector<int> m_items;        ///< The box indices sorted so each leaf references a continuous range.
+	std::vector<Box3f> m_itemBoxes;  ///< The boxes of the items, indexed by the box index.
+	std::vector<vec3f> m_centroids;  ///< Used only while building.
+};
+
+template <typename TIntersectItem>
+int BoxBVH::raycast(const vec3f& rayOrigin, const vec3f& rayDir, TIntersectItem&& intersectItem, float* const outT)
+    const
+{
+	int closestItem = -1;
+	float closestT = FLT_MAX;
+
+	if (m_nodes.empty()) {
+		return closestItem;
+	}
+
+	const vec3f invDir = vec3f(1.f / rayDir.x, 1.f / rayDir.y, 1.f / rayDir.z);
+
+	struct StackEntry {
+		int iNode;
+		float tEnter;
+	};
+
+	StackEntry stack[64];
+	int stackSize = 0;
+
+	float tRoot = 0.f;
+	if (intersectRayBox(m_nodes[0].box, rayOrigin, invDir, tRoot)) {
+		stack[stackSize++] = StackEntry{0, tRoot};
+	}
+
+	while (stackSize > 0) {
+		const StackEntry entry = stack[--stackSize];
+		if (entry.tEnter >= closestT) {
+			continue;
+		}
+
+		const Node& node = m_nodes[entry.iNode];
+		if (node.isLeaf()) {
+			for (int t = 0; t < node.numItems; ++t) {
+				const int iItem = m_items[node.firstItem + t];
+				float tItemBox = 0.f;
+				if (intersectRayBox(m_itemBoxes[iItem], rayOrigin, invDir, tItemBox) && tItemBox < closestT) {
+					const float tHit = intersectItem(iItem, tItemBox);
+					if (tHit < closestT) {
+						closestT = tHit;
+						closestItem = iItem;
+					}
+				}
+			}
+			continue;
+		}
+
+		// Push the farther child first, so the nearer one gets visited first.
+		const int iChildA = node.firstChild;
+		const int iChildB = node.firstChild + 1;
+		float tA = 0.f;
+		float tB = 0.f;
+		const bool hitA = intersectRayBox(m_nodes[iChildA].box, rayOrigin, invDir, tA) && tA < closestT;
+		const bool hitB = intersectRayBox(m_nodes[iChildB].box, rayOrigin, invDir, tB) && tB < closestT;
+
+		if (hitA && hitB) {
+			if (tA <= tB) {
+				stack[stackSize++] = StackEntry{iChildB, tB};
+				stack[stackSize++] = StackEntry{iChildA, tA};
+			}
+			else {
+				stack[stackSize++] = StackEntry{iChildA, tA};
+				stack[stackSize++] = StackEntry{iChildB, tB};
+			}
+		}
+		else if (hitA) {
+			stack[stackSize++] = StackEntry{iChildA, tA};
+		}
+		else if (hitB) {
+			stack[stackSize++] = StackEntry{iChildB, tB};
+		}
+	}
+
+	if (outT) {
+		*outT = closestT;
+	}
+
+	return closestItem;
+}
+
+template <typename TFn>
+void BoxBVH::queryFrustum(const Frustum& frustum, TFn&& fn) const
+{
+	if (m_nodes.empty()) {
+		return;
+	}
+
+	int stack[64];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		const Node& node = m_nodes[stack[--stackSize]];
+		if (frustum.isBoxOutside(node.box)) {
+			continue;
+		}
+
+		if (node.isLeaf()) {
+			for (int t = 0; t < node.numItems; ++t) {
+				const int iItem = m_items[node.firstItem + t];
+				if (node.numItems == 1 || frustum.isBoxOutside(m_itemBoxes[iItem]) == false) {
+					fn(iItem);
+				}
+			}
+		}
+		else {
+			stack[stackSize++] = node.firstChild;
+			stack[stackSize++] = node.firstChild + 1;
+		}
+	}
+}
+
+template <typename TFn>
+void BoxBVH::queryBox(const Box3f& box, TFn&& fn) const
+{
+	if (m_nodes.empty()) {
+		return;
+	}
+
+	int stack[64];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		const Node& node = m_nodes[stack[--stackSize]];
+		if (node.box.overlaps(box) == false) {
+			continue;
+		}
+
+		if (node.isLeaf()) {
+			for (int t = 0; t < node.numItems; ++t) {
+				const int iItem = m_items[node.firstItem + t];
+				if (m_itemBoxes[iItem].overlaps(box)) {
+					fn(iItem);
+				}
+			}
+		}
+		else {
+			stack[stackSize++] = node.firstChild;
+			stack[stackSize++] = node.firstChild + 1;
+		}
+	}
+}
+
+} // namespace sge
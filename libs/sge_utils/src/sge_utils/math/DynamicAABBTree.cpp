@@ -0,0 +1,305 @@
+#include "DynamicAABBTree.h"
+#include <algorithm>
+
+namespace sge {
+
+namespace {
+	Box3f getUnion(const Box3f& a, const Box3f& b)
+	{
+		Box3f result = a;
+		result.expand(b);
+		return result;
+	}
+
+	float getSurfaceArea(const Box3f& box)
+	{
+		const vec3f size = box.max - box.min;
+		return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	bool isBoxInside(const Box3f& outer, const Box3f& inner)
+	{
+		return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+		       outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+	}
+} // namespace
+
+int DynamicAABBTree::createProxy(const Box3f& box, void* const userData)
+{
+	const int iLeaf = allocateNode();
+	m_nodes[iLeaf].box = Box3f(box.min - vec3f(m_boxMargin), box.max + vec3f(m_boxMargin));
+	m_nodes[iLeaf].userData = userData;
+	m_nodes[iLeaf].height = 0;
+
+	insertLeaf(iLeaf);
+	m_numProxies++;
+
+	return iLeaf;
+}
+
+void DynamicAABBTree::destroyProxy(int const proxyId)
+{
+	sgeAssert(proxyId >= 0 && proxyId < int(m_nodes.size()) && m_nodes[proxyId].isLeaf());
+
+	removeLeaf(proxyId);
+	freeNode(proxyId);
+	m_numProxies--;
+}
+
+bool DynamicAABBTree::moveProxy(int const proxyId, const Box3f& box)
+{
+	sgeAssert(proxyId >= 0 && proxyId < int(m_nodes.size()) && m_nodes[proxyId].isLeaf());
+
+	if (isBoxInside(m_nodes[proxyId].box, box)) {
+		return false;
+	}
+
+	removeLeaf(proxyId);
+	m_nodes[proxyId].box = Box3f(box.min - vec3f(m_boxMargin), box.max + vec3f(m_boxMargin));
+	insertLeaf(proxyId);
+
+	return true;
+}
+
+void DynamicAABBTree::clear()
+{
+	m_nodes.clear();
+	m_root = -1;
+	m_freeList = -1;
+	m_numProxies = 0;
+}
+
+int DynamicAABBTree::allocateNode()
+{
+	int iNode = m_freeList;
+	if (iNode >= 0) {
+		m_freeList = m_nodes[iNode].parentOrNext;
+		m_nodes[iNode] = Node();
+	}
+	else {
+		iNode = int(m_nodes.size());
+		m_nodes.emplace_back();
+	}
+
+	m_nodes[iNode].height = 0;
+	return iNode;
+}
+
+void DynamicAABBTree::freeNode(int const iNode)
+{
+	m_nodes[iNode].parentOrNext = m_freeList;
+	m_nodes[iNode].height = -1;
+	m_nodes[iNode].userData = nullptr;
+	m_freeList = iNode;
+}
+
+void DynamicAABBTree::insertLeaf(int const iLeaf)
+{
+	if (m_root < 0) {
+		m_root = iLeaf;
+		m_nodes[iLeaf].parentOrNext = -1;
+		return;
+	}
+
+	// Find the best sibling for the new leaf, by descending in the child that would grow the least in surface area.
+	const Box3f leafBox = m_nodes[iLeaf].box;
+	int iSibling = m_root;
+	while (m_nodes[iSibling].isLeaf() == false) {
+		const Node& node = m_nodes[iSibling];
+
+		const float area = getSurfaceArea(node.box);
+		const float combinedArea = getSurfaceArea(getUnion(node.box, leafBox));
+
+		// The cost of creating a new parent for this node and the new leaf.
+		const float cost = 2.f * combinedArea;
+		// The minimum cost of pushing the leaf further down the tree.
+		const float inheritanceCost = 2.f * (combinedArea - area);
+
+		float childCosts[2];
+		for (int iChild = 0; iChild < 2; ++iChild) {
+			const Node& child = m_nodes[node.children[iChild]];
+			const float childCombinedArea = getSurfaceArea(getUnion(child.box, leafBox));
+			childCosts[iChild] = child.isLeaf() ? childCombinedArea + inheritanceCost
+			                                    : childCombinedArea - getSurfaceArea(child.box) + inheritanceCost;
+		}
+
+		if (cost < childCosts[0] && cost < childCosts[1]) {
+			break;
+		}
+
+		iSibling = childCosts[0] < childCosts[1] ? node.children[0] : node.children[1];
+	}
+
+	// Create a new parent for the sibling and the leaf.
+	const int iOldParent = m_nodes[iSibling].parentOrNext;
+	const int iNewParent = allocateNode();
+	m_nodes[iNewParent].parentOrNext = iOldParent;
+	m_nodes[iNewParent].box = getUnion(leafBox, m_nodes[iSibling].box);
+	m_nodes[iNewParent].height = m_nodes[iSibling].height + 1;
+	m_nodes[iNewParent].children[0] = iSibling;
+	m_nodes[iNewParent].children[1] = iLeaf;
+
+	if (iOldParent >= 0) {
+		int* const oldParentChildren = m_nodes[iOldParent].children;
+		oldParentChildren[oldParentChildren[0] == iSibling ? 0 : 1] = iNewParent;
+	}
+	else {
+		m_root = iNewParent;
+	}
+
+	m_nodes[iSibling].parentOrNext = iNewParent;
+	m_nodes[iLeaf].parentOrNext = iNewParent;
+
+	refitAncestors(iNewParent);
+}
+
+void DynamicAABBTree::removeLeaf(int const iLeaf)
+{
+	if (iLeaf == m_root) {
+		m_root = -1;
+		return;
+	}
+
+	const int iParent = m_nodes[iLeaf].parentOrNext;
+	const int iGrandParent = m_nodes[iParent].parentOrNext;
+	const int iSibling =
+	    m_nodes[iParent].children[0] == iLeaf ? m_nodes[iParent].children[1] : m_nodes[iParent].children[0];
+
+	// The sibling takes the place of the parent.
+	if (iGrandParent >= 0) {
+		int* const grandParentChildren = m_nodes[iGrandParent].children;
+		grandParentChildren[grandParentChildren[0] == iParent ? 0 : 1] = iSibling;
+		m_nodes[iSibling].parentOrNext = iGrandParent;
+		freeNode(iParent);
+
+		refitAncestors(iGrandParent);
+	}
+	else {
+		m_root = iSibling;
+		m_nodes[iSibling].parentOrNext = -1;
+		freeNode(iParent);
+	}
+
+	m_nodes[iLeaf].parentOrNext = -1;
+}
+
+void DynamicAABBTree::refitAncestors(int iNode)
+{
+	while (iNode >= 0) {
+		iNode = balance(iNode);
+
+		Node& node = m_nodes[iNode];
+		const Node& child0 = m_nodes[node.children[0]];
+		const Node& child1 = m_nodes[node.children[1]];
+
+		node.height = 1 + std::max(child0.height, child1.height);
+		node.box = getUnion(child0.box, child1.box);
+
+		iNode = node.parentOrNext;
+	}
+}
+
+int DynamicAABBTree::balance(int const iA)
+{
+	Node& A = m_nodes[iA];
+	if (A.isLeaf() || A.height < 2) {
+		return iA;
+	}
+
+	const int iB = A.children[0];
+	const int iC = A.children[1];
+	Node& B = m_nodes[iB];
+	Node& C = m_nodes[iC];
+
+	const int heightDiff = C.height - B.height;
+
+	// Rotate C up.
+	if (heightDiff > 1) {
+		const int iF = C.children[0];
+		const int iG = C.children[1];
+		Node& F = m_nodes[iF];
+		Node& G = m_nodes[iG];
+
+		// Swap A and C.
+		C.children[0] = iA;
+		C.parentOrNext = A.parentOrNext;
+		A.parentOrNext = iC;
+
+		if (C.parentOrNext >= 0) {
+			int* const parentChildren = m_nodes[C.parentOrNext].children;
+			parentChildren[parentChildren[0] == iA ? 0 : 1] = iC;
+		}
+		else {
+			m_root = iC;
+		}
+
+		// Keep the taller child of C, move the other one under A.
+		if (F.height > G.height) {
+			C.children[1] = iF;
+			A.children[1] = iG;
+			G.parentOrNext = iA;
+			A.box = getUnion(B.box, G.box);
+			C.box = getUnion(A.box, F.box);
+			A.height = 1 + std::max(B.height, G.height);
+			C.height = 1 + std::max(A.height, F.height);
+		}
+		else {
+			C.children[1] = iG;
+			A.children[1] = iF;
+			F.parentOrNext = iA;
+			A.box = getUnion(B.box, F.box);
+			C.box = getUnion(A.box, G.box);
+			A.height = 1 + std::max(B.height, F.height);
+			C.height = 1 + std::max(A.height, G.height);
+		}
+
+		return iC;
+	}
+
+	// Rotate B up.
+	if (heightDiff < -1) {
+		const int iD = B.children[0];
+		const int iE = B.children[1];
+		Node& D = m_nodes[iD];
+		Node& E = m_nodes[iE];
+
+		// Swap A and B.
+		B.children[0] = iA;
+		B.parentOrNext = A.parentOrNext;
+		A.parentOrNext = iB;
+
+		if (B.parentOrNext >= 0) {
+			int* const parentChildren = m_nodes[B.parentOrNext].children;
+			parentChildren[parentChildren[0] == iA ? 0 : 1] = iB;
+		}
+		else {
+			m_root = iB;
+		}
+
+		// Keep the taller child of B, move the other one under A.
+		if (D.height > E.height) {
+			B.children[1] = iD;
+			A.children[0] = iE;
+			E.parentOrNext = iA;
+			A.box = getUnion(C.box, E.box);
+			B.box = getUnion(A.box, D.box);
+			A.height = 1 + std::max(C.height, E.height);
+			B.height = 1 + std::max(A.height, D.height);
+		}
+		else {
+			B.children[1] = iE;
+			A.children[0] = iD;
+			D.parentOrNext = iA;
+			A.box = getUnion(C.box, D.box);
+			B.box = getUnion(A.box, E.box);
+			A.height = 1 + std::max(C.height, D.height);
+			B.height = 1 + std::max(A.height, E.height);
+		}
+
+		return iB;
+	}
+
+	return iA;
+}
+
+} // namespace sge
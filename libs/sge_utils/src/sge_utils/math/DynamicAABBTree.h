@@ -0,0 +1,153 @@
+#pragma once
+
+#include "sge_utils/math/Box3f.h"
+#include "sge_utils/math/Frustum.h"
+#include "sge_utils/sge_utils.h"
+#include <vector>
+
+namespace sge {
+
+/// DynamicAABBTree is a bounding volume hierarchy of axis aligned boxes that could be modified incrementally.
+/// Each box (called a proxy) is stored in a leaf, enlarged by @m_boxMargin, so small movements do not touch the tree.
+/// Inserting, removing and moving a proxy are O(log n), the tree is kept balanced with AVL-like rotations.
+/// Use it for objects that move around, for static sets of boxes BoxBVH is faster to build and to query.
+struct DynamicAABBTree {
+	/// @param [in] boxMargin the amount each proxy box is enlarged with on every side.
+	explicit DynamicAABBTree(float const boxMargin = 0.1f)
+	    : m_boxMargin(boxMargin)
+	{
+	}
+
+	/// Adds a new box to the tree, returns the id of the proxy.
+	int createProxy(const Box3f& box, void* const userData);
+
+	/// Removes a proxy created by @createProxy. The id might get reused by the following @createProxy calls.
+	void destroyProxy(int const proxyId);
+
+	/// Updates the box of a proxy. If the new box is still inside the enlarged box of the proxy nothing happens.
+	/// @return true if the proxy has been reinserted in the tree.
+	bool moveProxy(int const proxyId, const Box3f& box);
+
+	void clear();
+
+	void* getUserData(int const proxyId) const
+	{
+		sgeAssert(proxyId >= 0 && proxyId < int(m_nodes.size()) && m_nodes[proxyId].isLeaf());
+		return m_nodes[proxyId].userData;
+	}
+
+	/// Returns the enlarged box that is stored in the tree for the proxy.
+	const Box3f& getFatBox(int const proxyId) const
+	{
+		sgeAssert(proxyId >= 0 && proxyId < int(m_nodes.size()) && m_nodes[proxyId].isLeaf());
+		return m_nodes[proxyId].box;
+	}
+
+	int getNumProxies() const { return m_numProxies; }
+
+	/// Returns the height of the tree, 0 if empty, 1 if there is only one proxy.
+	int getHeight() const { return m_root < 0 ? 0 : m_nodes[m_root].height + 1; }
+
+	/// Calls @fn "void (int proxyId)" for every proxy whose enlarged box overlaps @box.
+	template <typename TFn>
+	void queryBox(const Box3f& box, TFn&& fn) const;
+
+	/// Calls @fn "void (int proxyId)" for every proxy whose enlarged box is not outside of the frustum.
+	template <typename TFn>
+	void queryFrustum(const Frustum& frustum, TFn&& fn) const;
+
+  private:
+	struct Node {
+		Box3f box;
+		void* userData = nullptr;
+		/// The parent node for nodes in the tree, the next free node for nodes in the free list.
+		int parentOrNext = -1;
+		int children[2] = {-1, -1};
+		/// The height of the sub-tree, 0 for leaves and -1 for free nodes.
+		int height = -1;
+
+		bool isLeaf() const { return children[0] < 0; }
+	};
+
+	int allocateNode();
+	void freeNode(int const iNode);
+
+	void insertLeaf(int const iLeaf);
+	void removeLeaf(int const iLeaf);
+
+	/// Performs a rotation on @iNode if its sub-tree isn't balanced. Returns the node that took its place.
+	int balance(int const iNode);
+
+	/// Recomputes the boxes and the heights of all nodes from @iNode up to the root, balancing them on the way.
+	void refitAncestors(int iNode);
+
+	/// The tree depth is bounded by its balancing, this is way more than what could fit in memory.
+	static constexpr int kMaxStackSize = 256;
+
+  private:
+	std::vector<Node> m_nodes;
+	int m_root = -1;
+	int m_freeList = -1;
+	int m_numProxies = 0;
+	float m_boxMargin = 0.1f;
+};
+
+template <typename TFn>
+void DynamicAABBTree::queryBox(const Box3f& box, TFn&& fn) const
+{
+	if (m_root < 0) {
+		return;
+	}
+
+	int stack[kMaxStackSize];
+	int stackSize = 0;
+	stack[stackSize++] = m_root;
+
+	while (stackSize > 0) {
+		const int iNode = stack[--stackSize];
+		const Node& node = m_nodes[iNode];
+		if (node.box.overlaps(box) == false) {
+			continue;
+		}
+
+		if (node.isLeaf()) {
+			fn(iNode);
+		}
+		else {
+			sgeAssert(stackSize + 2 <= kMaxStackSize);
+			stack[stackSize++] = node.children[0];
+			stack[stackSize++] = node.children[1];
+		}
+	}
+}
+
+template <typename TFn>
+void DynamicAABBTree::queryFrustum(const Frustum& frustum, TFn&& fn) const
+{
+	if (m_root < 0) {
+		return;
+	}
+
+	int stack[kMaxStackSize];
+	int stackSize = 0;
+	stack[stackSize++] = m_root;
+
+	while (stackSize > 0) {
+		const int iNode = stack[--stackSize];
+		const Node& node = m_nodes[iNode];
+		if (frustum.isBoxOutside(node.box)) {
+			continue;
+		}
+
+		if (node.isLeaf()) {
+			fn(iNode);
+		}
+		else {
+			sgeAssert(stackSize + 2 <= kMaxStackSize);
+			stack[stackSize++] = node.children[0];
+			stack[stackSize++] = node.children[1];
+		}
+	}
+}
+
+} // namespace sge
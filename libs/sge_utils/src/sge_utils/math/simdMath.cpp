@@ -0,0 +1,452 @@
+#include "simdMath.h"
+#include "common.h"
+#include "transform.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define SGE_SIMD_MATH_USE_SSE 1
+	#include <emmintrin.h>
+#endif
+
+namespace sge {
+
+#if SGE_SIMD_MATH_USE_SSE
+/// Loads 4 quaternions and transposes them, so each register holds the same component of all of them.
+static inline void loadQuats4(const quatf* const q, __m128& x, __m128& y, __m128& z, __m128& w)
+{
+	x = _mm_loadu_ps(q[0].data);
+	y = _mm_loadu_ps(q[1].data);
+	z = _mm_loadu_ps(q[2].data);
+	w = _mm_loadu_ps(q[3].data);
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+}
+
+/// acos(x) for x in [0;1]. Abramowitz and Stegun 4.4.45, max error 6.7e-5.
+static inline __m128 acos01_4(const __m128 x)
+{
+	__m128 p = _mm_set1_ps(-0.0187293f);
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(0.0742610f));
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(-0.2121144f));
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(1.5707288f));
+	const __m128 oneMinusX = _mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.f), x), _mm_setzero_ps());
+	return _mm_mul_ps(p, _mm_sqrt_ps(oneMinusX));
+}
+
+/// sin(x) for x in [0;pi/2], Taylor series up to x^9, max error ~1e-6 in that range.
+static inline __m128 sinHalfPi4(const __m128 x)
+{
+	const __m128 x2 = _mm_mul_ps(x, x);
+	__m128 p = _mm_set1_ps(1.f / 362880.f);
+	p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(-1.f / 5040.f));
+	p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(1.f / 120.f));
+	p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(-1.f / 6.f));
+	p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(1.f));
+	return _mm_mul_ps(p, x);
+}
+#endif
+
+void slerpBatch(quatf* const result, const quatf* const from, const quatf* const to, const float* const t, int count)
+{
+	int i = 0;
+
+#if SGE_SIMD_MATH_USE_SSE
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 signBit = _mm_set1_ps(-0.f);
+
+	for (; i + 4 <= count; i += 4) {
+		__m128 ax, ay, az, aw;
+		__m128 bx, by, bz, bw;
+		loadQuats4(from + i, ax, ay, az, aw);
+		loadQuats4(to + i, bx, by, bz, bw);
+		const __m128 vt = _mm_loadu_ps(t + i);
+
+		// Take the shortest path, if the dot product is negative flip the 2nd quaternion.
+		__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+		                      _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+		const __m128 dSign = _mm_and_ps(d, signBit);
+		d = _mm_xor_ps(d, dSign);
+		bx = _mm_xor_ps(bx, dSign);
+		by = _mm_xor_ps(by, dSign);
+		bz = _mm_xor_ps(bz, dSign);
+		bw = _mm_xor_ps(bw, dSign);
+
+		// Compute the slerp weights, when the quaternions are very close use the linear weights (nlerp) instead.
+		const __m128 angle = acos01_4(_mm_min_ps(d, one));
+		const __m128 oneMinusT = _mm_sub_ps(one, vt);
+		const __m128 sinAngle = sinHalfPi4(angle);
+		const __m128 isNlerp = _mm_cmpge_ps(d, _mm_set1_ps(0.9999f));
+		const __m128 safeSinAngle = _mm_or_ps(_mm_and_ps(isNlerp, one), _mm_andnot_ps(isNlerp, sinAngle));
+		const __m128 invSinAngle = _mm_div_ps(one, safeSinAngle);
+
+		const __m128 w0Slerp = _mm_mul_ps(sinHalfPi4(_mm_mul_ps(angle, oneMinusT)), invSinAngle);
+		const __m128 w1Slerp = _mm_mul_ps(sinHalfPi4(_mm_mul_ps(angle, vt)), invSinAngle);
+		const __m128 w0 = _mm_or_ps(_mm_and_ps(isNlerp, oneMinusT), _mm_andnot_ps(isNlerp, w0Slerp));
+		const __m128 w1 = _mm_or_ps(_mm_and_ps(isNlerp, vt), _mm_andnot_ps(isNlerp, w1Slerp));
+
+		__m128 rx = _mm_add_ps(_mm_mul_ps(ax, w0), _mm_mul_ps(bx, w1));
+		__m128 ry = _mm_add_ps(_mm_mul_ps(ay, w0), _mm_mul_ps(by, w1));
+		__m128 rz = _mm_add_ps(_mm_mul_ps(az, w0), _mm_mul_ps(bz, w1));
+		__m128 rw = _mm_add_ps(_mm_mul_ps(aw, w0), _mm_mul_ps(bw, w1));
+
+		// Normalize.
+		const __m128 lenSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+		                                 _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw)));
+		const __m128 invLen = _mm_div_ps(one, _mm_sqrt_ps(lenSqr));
+		rx = _mm_mul_ps(rx, invLen);
+		ry = _mm_mul_ps(ry, invLen);
+		rz = _mm_mul_ps(rz, invLen);
+		rw = _mm_mul_ps(rw, invLen);
+
+		_MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+		_mm_storeu_ps(result[i + 0].data, rx);
+		_mm_storeu_ps(result[i + 1].data, ry);
+		_mm_storeu_ps(result[i + 2].data, rz);
+		_mm_storeu_ps(result[i + 3].data, rw);
+	}
+#endif
+
+	for (; i < count; ++i) {
+		result[i] = slerp(from[i], to[i], t[i]);
+	}
+}
+
+void composeTransformMatricesBatch(
+    mat4f* const result, const vec3f* const positions, const quatf* const rotations, const vec3f* const scalings, int count)
+{
+	int i = 0;
+
+#if SGE_SIMD_MATH_USE_SSE
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+
+	for (; i + 4 <= count; i += 4) {
+		__m128 x, y, z, w;
+		loadQuats4(rotations + i, x, y, z, w);
+
+		const vec3f* const p = positions + i;
+		const vec3f* const s = scalings + i;
+		const __m128 px = _mm_setr_ps(p[0].x, p[1].x, p[2].x, p[3].x);
+		const __m128 py = _mm_setr_ps(p[0].y, p[1].y, p[2].y, p[3].y);
+		const __m128 pz = _mm_setr_ps(p[0].z, p[1].z, p[2].z, p[3].z);
+		const __m128 sx = _mm_setr_ps(s[0].x, s[1].x, s[2].x, s[3].x);
+		const __m128 sy = _mm_setr_ps(s[0].y, s[1].y, s[2].y, s[3].y);
+		const __m128 sz = _mm_setr_ps(s[0].z, s[1].z, s[2].z, s[3].z);
+
+		// The same as transf3d::toMatrix(), but for 4 transforms at once.
+		const __m128 x2 = _mm_add_ps(x, x);
+		const __m128 y2 = _mm_add_ps(y, y);
+		const __m128 z2 = _mm_add_ps(z, z);
+
+		const __m128 xx2 = _mm_mul_ps(x, x2);
+		const __m128 yy2 = _mm_mul_ps(y, y2);
+		const __m128 zz2 = _mm_mul_ps(z, z2);
+		const __m128 yz2 = _mm_mul_ps(y, z2);
+		const __m128 wx2 = _mm_mul_ps(w, x2);
+		const __m128 xy2 = _mm_mul_ps(x, y2);
+		const __m128 wz2 = _mm_mul_ps(w, z2);
+		const __m128 xz2 = _mm_mul_ps(x, z2);
+		const __m128 wy2 = _mm_mul_ps(w, y2);
+
+		// Each set of 4 registers is a column, the transpose converts them to the columns of the 4 matrices.
+		__m128 c0r0 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy2, zz2)), sx);
+		__m128 c0r1 = _mm_mul_ps(_mm_add_ps(xy2, wz2), sx);
+		__m128 c0r2 = _mm_mul_ps(_mm_sub_ps(xz2, wy2), sx);
+		__m128 c0r3 = zero;
+
+		__m128 c1r0 = _mm_mul_ps(_mm_sub_ps(xy2, wz2), sy);
+		__m128 c1r1 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx2, zz2)), sy);
+		__m128 c1r2 = _mm_mul_ps(_mm_add_ps(yz2, wx2), sy);
+		__m128 c1r3 = zero;
+
+		__m128 c2r0 = _mm_mul_ps(_mm_add_ps(xz2, wy2), sz);
+		__m128 c2r1 = _mm_mul_ps(_mm_sub_ps(yz2, wx2), sz);
+		__m128 c2r2 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx2, yy2)), sz);
+		__m128 c2r3 = zero;
+
+		__m128 c3r0 = px;
+		__m128 c3r1 = py;
+		__m128 c3r2 = pz;
+		__m128 c3r3 = one;
+
+		_MM_TRANSPOSE4_PS(c0r0, c0r1, c0r2, c0r3);
+		_MM_TRANSPOSE4_PS(c1r0, c1r1, c1r2, c1r3);
+		_MM_TRANSPOSE4_PS(c2r0, c2r1, c2r2, c2r3);
+		_MM_TRANSPOSE4_PS(c3r0, c3r1, c3r2, c3r3);
+
+		const __m128 columns[4][4] = {
+		    {c0r0, c1r0, c2r0, c3r0},
+		    {c0r1, c1r1, c2r1, c3r1},
+		    {c0r2, c1r2, c2r2, c3r2},
+		    {c0r3, c1r3, c2r3, c3r3},
+		};
+
+		for (int iMtx = 0; iMtx < 4; ++iMtx) {
+			for (int iColumn = 0; iColumn < 4; ++iColumn) {
+				_mm_storeu_ps(result[i + iMtx].data[iColumn].data, columns[iMtx][iColumn]);
+			}
+		}
+	}
+#endif
+
+	for (; i < count; ++i) {
+		result[i] = transf3d(positions[i], rotations[i], scalings[i]).toMatrix();
+	}
+}
+
+mat4f mulMatricesSimd(const mat4f& a, const mat4f& b)
+{
+#if SGE_SIMD_MATH_USE_SSE
+	const __m128 a0 = _mm_loadu_ps(a.data[0].data);
+	const __m128 a1 = _mm_loadu_ps(a.data[1].data);
+	const __m128 a2 = _mm_loadu_ps(a.data[2].data);
+	const __m128 a3 = _mm_loadu_ps(a.data[3].data);
+
+	// Each column of the result is a linear combination of the columns of a.
+	mat4f result;
+	for (int iColumn = 0; iColumn < 4; ++iColumn) {
+		const vec4f& bc = b.data[iColumn];
+		__m128 r = _mm_mul_ps(a0, _mm_set1_ps(bc.x));
+		r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(bc.y)));
+		r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(bc.z)));
+		r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(bc.w)));
+		_mm_storeu_ps(result.data[iColumn].data, r);
+	}
+
+	return result;
+#else
+	return a * b;
+#endif
+}
+
+void addBatch(float* const values, const float value, int count)
+{
+	int i = 0;
+
+#if SGE_SIMD_MATH_USE_SSE
+	const __m128 v = _mm_set1_ps(value);
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), v));
+	}
+#endif
+
+	for (; i < count; ++i) {
+		values[i] += value;
+	}
+}
+
+void mulBatch(float* const values, const float scale, int count)
+{
+	int i = 0;
+
+#if SGE_SIMD_MATH_USE_SSE
+	const __m128 s = _mm_set1_ps(scale);
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(values + i, _mm_mul_ps(_mm_loadu_ps(values + i), s));
+	}
+#endif
+
+	for (; i < count; ++i) {
+		values[i] *= scale;
+	}
+}
+
+void addScaledBatch(float* const result, const float* const values, const float scale, int count)
+{
+	int i = 0;
+
+#if SGE_SIMD_MATH_USE_SSE
+	const __m128 s = _mm_set1_ps(scale);
+	for (; i + 4 <= count; i += 4) {
+		const __m128 r = _mm_add_ps(_mm_loadu_ps(result + i), _mm_mul_ps(_mm_loadu_ps(values + i), s));
+		_mm_storeu_ps(result + i, r);
+	}
+#endif
+
+	for (; i < count; ++i) {
+		result[i] += values[i] * scale;
+	}
+}
+
+void addScaledStereoBatch(
+    float* const result, const float* const values, const float scaleLeft, const float scaleRight, int numFrames)
+{
+	int i = 0;
+	const int count = numFrames * 2;
+
+#if SGE_SIMD_MATH_USE_SSE
+	const __m128 s = _mm_setr_ps(scaleLeft, scaleRight, scaleLeft, scaleRight);
+	for (; i + 4 <= count; i += 4) {
+		const __m128 r = _mm_add_ps(_mm_loadu_ps(result + i), _mm_mul_ps(_mm_loadu_ps(values + i), s));
+		_mm_storeu_ps(result + i, r);
+	}
+#endif
+
+	for (; i < count; i += 2) {
+		result[i] += values[i] * scaleLeft;
+		result[i + 1] += values[i + 1] * scaleRight;
+	}
+}
+
+void expandMinMaxBatch(const float* const values, int count, float& ioMin, float& ioMax)
+{
+	int i = 0;
+
+#if SGE_SIMD_MATH_USE_SSE
+	if (count >= 4) {
+		__m128 vMin = _mm_set1_ps(ioMin);
+		__m128 vMax = _mm_set1_ps(ioMax);
+		for (; i + 4 <= count; i += 4) {
+			const __m128 v = _mm_loadu_ps(values + i);
+			vMin = _mm_min_ps(vMin, v);
+			vMax = _mm_max_ps(vMax, v);
+		}
+
+		alignas(16) float mins[4];
+		alignas(16) float maxs[4];
+		_mm_store_ps(mins, vMin);
+		_mm_store_ps(maxs, vMax);
+		for (int t = 0; t < 4; ++t) {
+			ioMin = std::min(ioMin, mins[t]);
+			ioMax = std::max(ioMax, maxs[t]);
+		}
+	}
+#endif
+
+	for (; i < count; ++i) {
+		ioMin = std::min(ioMin, values[i]);
+		ioMax = std::max(ioMax, values[i]);
+	}
+}
+
+void addDirectionsTowardsPointBatch(
+    float* const x,
+    float* const y,
+    float* const z,
+    const float* const px,
+    const float* const py,
+    const float* const pz,
+    const vec3f& point,
+    const float amount,
+    int count)
+{
+	int i = 0;
+
+#if SGE_SIMD_MATH_USE_SSE
+	const __m128 pointX = _mm_set1_ps(point.x);
+	const __m128 pointY = _mm_set1_ps(point.y);
+	const __m128 pointZ = _mm_set1_ps(point.z);
+	const __m128 vAmount = _mm_set1_ps(amount);
+	const __m128 minLenSqr = _mm_set1_ps(1e-6f);
+	const __m128 one = _mm_set1_ps(1.f);
+
+	for (; i + 4 <= count; i += 4) {
+		const __m128 dx = _mm_sub_ps(pointX, _mm_loadu_ps(px + i));
+		const __m128 dy = _mm_sub_ps(pointY, _mm_loadu_ps(py + i));
+		const __m128 dz = _mm_sub_ps(pointZ, _mm_loadu_ps(pz + i));
+
+		// The lanes that are too short are masked out (they get scaled by 0).
+		const __m128 lenSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		const __m128 isLongEnough = _mm_cmpge_ps(lenSqr, minLenSqr);
+		const __m128 safeLenSqr = _mm_or_ps(_mm_and_ps(isLongEnough, lenSqr), _mm_andnot_ps(isLongEnough, one));
+		const __m128 scale = _mm_and_ps(isLongEnough, _mm_div_ps(vAmount, _mm_sqrt_ps(safeLenSqr)));
+
+		_mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(dx, scale)));
+		_mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(dy, scale)));
+		_mm_storeu_ps(z + i, _mm_add_ps(_mm_loadu_ps(z + i), _mm_mul_ps(dz, scale)));
+	}
+#endif
+
+	for (; i < count; ++i) {
+		const vec3f dir = normalized0(point - vec3f(px[i], py[i], pz[i])) * amount;
+		x[i] += dir.x;
+		y[i] += dir.y;
+		z[i] += dir.z;
+	}
+}
+
+void transformDirectionsBatch(const mat4f& mtx, float* const x, float* const y, float* const z, int count)
+{
+	int i = 0;
+
+#if SGE_SIMD_MATH_USE_SSE
+	const __m128 m00 = _mm_set1_ps(mtx.data[0][0]);
+	const __m128 m01 = _mm_set1_ps(mtx.data[0][1]);
+	const __m128 m02 = _mm_set1_ps(mtx.data[0][2]);
+	const __m128 m10 = _mm_set1_ps(mtx.data[1][0]);
+	const __m128 m11 = _mm_set1_ps(mtx.data[1][1]);
+	const __m128 m12 = _mm_set1_ps(mtx.data[1][2]);
+	const __m128 m20 = _mm_set1_ps(mtx.data[2][0]);
+	const __m128 m21 = _mm_set1_ps(mtx.data[2][1]);
+	const __m128 m22 = _mm_set1_ps(mtx.data[2][2]);
+
+	for (; i + 4 <= count; i += 4) {
+		const __m128 vx = _mm_loadu_ps(x + i);
+		const __m128 vy = _mm_loadu_ps(y + i);
+		const __m128 vz = _mm_loadu_ps(z + i);
+
+		// data[c][r] is the element in column c and row r.
+		const __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, vx), _mm_mul_ps(m10, vy)), _mm_mul_ps(m20, vz));
+		const __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, vx), _mm_mul_ps(m11, vy)), _mm_mul_ps(m21, vz));
+		const __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m02, vx), _mm_mul_ps(m12, vy)), _mm_mul_ps(m22, vz));
+
+		_mm_storeu_ps(x + i, rx);
+		_mm_storeu_ps(y + i, ry);
+		_mm_storeu_ps(z + i, rz);
+	}
+#endif
+
+	for (; i < count; ++i) {
+		const vec3f r = mat_mul_dir(mtx, vec3f(x[i], y[i], z[i]));
+		x[i] = r.x;
+		y[i] = r.y;
+		z[i] = r.z;
+	}
+}
+
+void computeFadeInOutBatch(
+    float* const outOpacity,
+    const float* const age,
+    const float* const maxLife,
+    const float fadeInTime,
+    const float fadeOutTime,
+    int count)
+{
+	// Fading by a huge time is the same as not fading at all, this way the loops have no branches.
+	const bool hasFadeIn = fadeInTime > 1e-3f;
+	const bool hasFadeOut = fadeOutTime > 1e-3f;
+	const float invFadeInTime = hasFadeIn ? 1.f / fadeInTime : 0.f;
+	const float invFadeOutTime = hasFadeOut ? 1.f / fadeOutTime : 0.f;
+	const float fadeInBias = hasFadeIn ? 0.f : 1.f;
+	const float fadeOutBias = hasFadeOut ? 0.f : 1.f;
+
+	int i = 0;
+
+#if SGE_SIMD_MATH_USE_SSE
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 vInvFadeIn = _mm_set1_ps(invFadeInTime);
+	const __m128 vInvFadeOut = _mm_set1_ps(invFadeOutTime);
+	const __m128 vFadeInBias = _mm_set1_ps(fadeInBias);
+	const __m128 vFadeOutBias = _mm_set1_ps(fadeOutBias);
+
+	for (; i + 4 <= count; i += 4) {
+		const __m128 vAge = _mm_loadu_ps(age + i);
+		const __m128 vTimeLeft = _mm_sub_ps(_mm_loadu_ps(maxLife + i), vAge);
+
+		__m128 fadeIn = _mm_add_ps(_mm_mul_ps(vAge, vInvFadeIn), vFadeInBias);
+		fadeIn = _mm_min_ps(_mm_max_ps(fadeIn, zero), one);
+		__m128 fadeOut = _mm_add_ps(_mm_mul_ps(vTimeLeft, vInvFadeOut), vFadeOutBias);
+		fadeOut = _mm_min_ps(_mm_max_ps(fadeOut, zero), one);
+
+		const __m128 opacity = _mm_mul_ps(fadeIn, fadeOut);
+		_mm_storeu_ps(outOpacity + i, _mm_mul_ps(opacity, opacity));
+	}
+#endif
+
+	for (; i < count; ++i) {
+		const float fadeIn = clamp01(age[i] * invFadeInTime + fadeInBias);
+		const float fadeOut = clamp01((maxLife[i] - age[i]) * invFadeOutTime + fadeOutBias);
+		outOpacity[i] = sqr(fadeIn * fadeOut);
+	}
+}
+
+} // namespace sge
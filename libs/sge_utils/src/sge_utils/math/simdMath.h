@@ -0,0 +1,74 @@
+#pragma once
+
+#include "sge_utils/math/mat4f.h"
+#include "sge_utils/math/quatf.h"
+#include "sge_utils/math/vec3f.h"
+
+namespace sge {
+
+/// Functions that process arrays of math types at once.
+/// When SSE is available they process 4 elements at a time, otherwise they fall back to the usual scalar functions.
+/// Useful when a lot of the same work needs to be done, for example evaluating the animations of many characters.
+
+/// Spherically interpolates @count quaternion pairs.
+/// The SSE path uses polynomial approximations for acos and sin, the error is about 1e-4 before the final
+/// normalization, which is plenty for animations.
+/// @param [out] result the interpolated quaternions. Could be the same array as @from or @to.
+/// @param [in] t the interpolation coefficient for each pair.
+void slerpBatch(quatf* const result, const quatf* const from, const quatf* const to, const float* const t, int count);
+
+/// Does the same as transf3d::toMatrix() for @count transforms, given their positions, rotations and scalings.
+void composeTransformMatricesBatch(
+    mat4f* const result, const vec3f* const positions, const quatf* const rotations, const vec3f* const scalings, int count);
+
+/// Multiplies two matrices, the same as a * b.
+mat4f mulMatricesSimd(const mat4f& a, const mat4f& b);
+
+/// The functions below work on plain float arrays, usually the components of data stored as a structure of arrays.
+
+/// Computes values[i] += value.
+void addBatch(float* const values, const float value, int count);
+
+/// Computes values[i] *= scale.
+void mulBatch(float* const values, const float scale, int count);
+
+/// Computes result[i] += values[i] * scale.
+void addScaledBatch(float* const result, const float* const values, const float scale, int count);
+
+/// Computes result[i] += values[i] * scale for interleaved stereo frames, with a separate scale for each channel.
+/// @param [in] numFrames the number of frames, each of them is two floats.
+void addScaledStereoBatch(
+    float* const result, const float* const values, const float scaleLeft, const float scaleRight, int numFrames);
+
+/// Expands the range [ioMin, ioMax] so it contains all the values.
+void expandMinMaxBatch(const float* const values, int count, float& ioMin, float& ioMax);
+
+/// Adds @amount times the normalized direction from each (px, py, pz) position towards @point to the (x, y, z)
+/// vectors. Nothing is added for positions that are too close to @point, the same as vec3f::normalized0.
+void addDirectionsTowardsPointBatch(
+    float* const x,
+    float* const y,
+    float* const z,
+    const float* const px,
+    const float* const py,
+    const float* const pz,
+    const vec3f& point,
+    const float amount,
+    int count);
+
+/// Transforms the (x, y, z) directions with the 3x3 part of @mtx in place, the same as mat_mul_dir.
+void transformDirectionsBatch(const mat4f& mtx, float* const x, float* const y, float* const z, int count);
+
+/// Computes an opacity that fades in (squared) during the first @fadeInTime seconds of the life of something and
+/// fades out (squared) during the last @fadeOutTime seconds of it. Fade times below 1e-3 are treated as no fade.
+/// @param [in] age the time each thing has been alive.
+/// @param [in] maxLife the time after which each thing is dead.
+void computeFadeInOutBatch(
+    float* const outOpacity,
+    const float* const age,
+    const float* const maxLife,
+    const float fadeInTime,
+    const float fadeOutTime,
+    int count);
+
+} // namespace sge
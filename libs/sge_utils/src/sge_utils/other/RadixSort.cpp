@@ -0,0 +1,94 @@
+#include "RadixSort.h"
+#include <algorithm>
+
+namespace sge {
+
+void radixSortByKey16(
+    uint32* const values,
+    uint16* const keys,
+    const size_t count,
+    std::vector<uint32>& scratchValues,
+    std::vector<uint16>& scratchKeys)
+{
+	if (count < 2) {
+		return;
+	}
+
+	if (scratchValues.size() < count) {
+		scratchValues.resize(count);
+	}
+
+	if (scratchKeys.size() < count) {
+		scratchKeys.resize(count);
+	}
+
+	// Build the histograms for both passes at once.
+	size_t histLow[256] = {0};
+	size_t histHigh[256] = {0};
+	for (size_t t = 0; t < count; ++t) {
+		histLow[keys[t] & 0xFF]++;
+		histHigh[keys[t] >> 8]++;
+	}
+
+	// If all keys share the same byte, the pass for that byte would not change the order and could be skipped.
+	const bool needsLowPass = histLow[keys[0] & 0xFF] != count;
+	const bool needsHighPass = histHigh[keys[0] >> 8] != count;
+
+	// Convert the histograms to the starting offset of each bucket.
+	size_t offsetLow = 0;
+	size_t offsetHigh = 0;
+	for (int iBucket = 0; iBucket < 256; ++iBucket) {
+		const size_t numLow = histLow[iBucket];
+		const size_t numHigh = histHigh[iBucket];
+		histLow[iBucket] = offsetLow;
+		histHigh[iBucket] = offsetHigh;
+		offsetLow += numLow;
+		offsetHigh += numHigh;
+	}
+
+	uint32* srcValues = values;
+	uint16* srcKeys = keys;
+	uint32* dstValues = scratchValues.data();
+	uint16* dstKeys = scratchKeys.data();
+
+	if (needsLowPass) {
+		for (size_t t = 0; t < count; ++t) {
+			const size_t iDest = histLow[srcKeys[t] & 0xFF]++;
+			dstValues[iDest] = srcValues[t];
+			dstKeys[iDest] = srcKeys[t];
+		}
+
+		std::swap(srcValues, dstValues);
+		std::swap(srcKeys, dstKeys);
+	}
+
+	if (needsHighPass) {
+		for (size_t t = 0; t < count; ++t) {
+			const size_t iDest = histHigh[srcKeys[t] >> 8]++;
+			dstValues[iDest] = srcValues[t];
+			dstKeys[iDest] = srcKeys[t];
+		}
+
+		std::swap(srcValues, dstValues);
+		std::swap(srcKeys, dstKeys);
+	}
+
+	// If an odd number of passes were made the sorted data is in the scratch buffers.
+	if (srcValues != values) {
+		std::copy(srcValues, srcValues + count, values);
+		std::copy(srcKeys, srcKeys + count, keys);
+	}
+}
+
+bool isSortedByKey16(const uint16* const keys, const size_t count)
+{
+	for (size_t t = 1; t < count; ++t) {
+		if (keys[t - 1] > keys[t]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+} // namespace sge
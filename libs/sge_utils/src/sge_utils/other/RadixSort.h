@@ -0,0 +1,24 @@
+#pragma once
+
+#include "sge_utils/types.h"
+#include <vector>
+
+namespace sge {
+
+/// Sorts @values in ascending order of @keys, where keys[i] is the key of values[i].
+/// The sort is a stable, two pass (8 bits per pass) LSD radix sort, so values with equal keys keep their
+/// relative order. This makes it suitable for sorting data that is almost sorted already (for example the order
+/// from the previous frame) without elements with the same key flickering between frames.
+/// Both arrays are modified in place. @scratchValues and @scratchKeys are used as temporary storage and are
+/// resized if needed, keep them around between calls to avoid allocations.
+void radixSortByKey16(
+    uint32* const values,
+    uint16* const keys,
+    const size_t count,
+    std::vector<uint32>& scratchValues,
+    std::vector<uint16>& scratchKeys);
+
+/// Returns true if @keys is sorted in ascending order.
+bool isSortedByKey16(const uint16* const keys, const size_t count);
+
+} // namespace sge
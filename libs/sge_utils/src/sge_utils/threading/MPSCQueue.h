@@ -0,0 +1,114 @@
+#pragma once
+
+#include "sge_utils/sge_utils.h"
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+namespace sge {
+
+/// @brief MPSCQueue is a fixed capacity, lock-free queue for any number of producer threads and exactly one consumer
+/// thread. Nothing is allocated after @create and the producers never block, if the queue is full @tryPush fails.
+/// The elements are copied in and out of the queue, so they should be trivially copyable.
+///
+/// Each cell has a sequence number that tells whose turn it is to use it. A producer reserves a cell by advancing
+/// the tail with a compare-and-swap, writes the element and then publishes it by bumping the sequence number.
+/// The consumer waits for that before reading the cell, so an element being written is never read.
+template <typename T>
+struct MPSCQueue : public NoCopyNoMove {
+	static_assert(std::is_trivially_copyable_v<T>, "MPSCQueue elements are copied with memcpy-like semantics");
+
+	MPSCQueue() = default;
+	explicit MPSCQueue(int minCapacity) { create(minCapacity); }
+
+	/// @brief Allocates the storage. Not thread-safe, call it before the producers and the consumer start.
+	/// @param [in] minCapacity the queue can hold at least that many elements, it is rounded up to a power of 2.
+	void create(int minCapacity)
+	{
+		int capacity = 1;
+		while (capacity < minCapacity) {
+			capacity *= 2;
+		}
+
+		m_cells.reset(new Cell[capacity]);
+		for (int t = 0; t < capacity; ++t) {
+			m_cells[t].sequence.store(uint32(t), std::memory_order_relaxed);
+		}
+		m_mask = uint32(capacity - 1);
+		m_head.store(0, std::memory_order_relaxed);
+		m_tail.store(0, std::memory_order_relaxed);
+	}
+
+	int capacity() const { return m_cells ? int(m_mask + 1) : 0; }
+
+	/// @brief Returns the number of elements in the queue, including the ones still being written.
+	/// It is a snapshot that may be already outdated.
+	int size() const
+	{
+		return int(m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire));
+	}
+
+	bool isEmpty() const { return size() == 0; }
+
+	/// @brief Called by any producer. Returns false if the queue is full.
+	bool tryPush(const T& value)
+	{
+		uint32 tail = m_tail.load(std::memory_order_relaxed);
+		Cell* cell = nullptr;
+		while (true) {
+			cell = &m_cells[tail & m_mask];
+			const int diff = int(cell->sequence.load(std::memory_order_acquire) - tail);
+			if (diff == 0) {
+				// The cell is free, try to reserve it. On failure @tail is updated with the current value.
+				if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			}
+			else if (diff < 0) {
+				// The cell still holds the element pushed a whole lap ago, the queue is full.
+				return false;
+			}
+			else {
+				// Another producer took the cell.
+				tail = m_tail.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->value = value;
+		cell->sequence.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// @brief Called by the consumer. Returns false if the queue is empty or the next element is still being written.
+	bool tryPop(T& value)
+	{
+		const uint32 head = m_head.load(std::memory_order_relaxed);
+		Cell& cell = m_cells[head & m_mask];
+		if (int(cell.sequence.load(std::memory_order_acquire) - (head + 1)) < 0) {
+			return false;
+		}
+
+		value = cell.value;
+		// Makes the cell free for the producers in the next lap.
+		cell.sequence.store(head + m_mask + 1, std::memory_order_release);
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+  private:
+	struct Cell {
+		std::atomic<uint32> sequence = 0;
+		T value;
+	};
+
+	std::unique_ptr<Cell[]> m_cells;
+	uint32 m_mask = 0;
+
+	/// The head is written only by the consumer and the tail by the producers.
+	/// They are on separate cache lines, so the consumer and the producers do not invalidate each other's cache.
+	alignas(64) std::atomic<uint32> m_head = 0;
+	alignas(64) std::atomic<uint32> m_tail = 0;
+};
+
+} // namespace sge
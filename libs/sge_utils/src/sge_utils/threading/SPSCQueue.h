@@ -0,0 +1,97 @@
+#pragma once
+
+#include "sge_utils/sge_utils.h"
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+namespace sge {
+
+/// @brief SPSCQueue is a fixed capacity, lock-free queue for exactly one producer thread and one consumer thread.
+/// Nothing is allocated after @create, so the queue is safe to use on real-time threads (like the audio thread).
+/// The elements are copied in and out of the queue, so they should be small and trivially copyable.
+template <typename T>
+struct SPSCQueue : public NoCopyNoMove {
+	static_assert(std::is_trivially_copyable_v<T>, "SPSCQueue elements are copied with memcpy-like semantics");
+
+	SPSCQueue() = default;
+	explicit SPSCQueue(int minCapacity) { create(minCapacity); }
+
+	/// @brief Allocates the storage. Not thread-safe, call it before the producer and the consumer start.
+	/// @param [in] minCapacity the queue can hold at least that many elements, it is rounded up to a power of 2.
+	void create(int minCapacity)
+	{
+		int capacity = 1;
+		while (capacity < minCapacity) {
+			capacity *= 2;
+		}
+
+		m_elements.reset(new T[capacity]);
+		m_mask = uint32(capacity - 1);
+		m_head.store(0, std::memory_order_relaxed);
+		m_tail.store(0, std::memory_order_relaxed);
+	}
+
+	int capacity() const { return m_elements ? int(m_mask + 1) : 0; }
+
+	/// @brief Returns the number of elements in the queue. Exact only when called by the producer or the consumer
+	/// while the other one is idle, otherwise it is a snapshot that may be already outdated.
+	int size() const
+	{
+		return int(m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire));
+	}
+
+	bool isEmpty() const { return size() == 0; }
+
+	/// @brief Called by the producer. Returns false if the queue is full.
+	bool tryPush(const T& value) { return pushMany(&value, 1) == 1; }
+
+	/// @brief Called by the consumer. Returns false if the queue is empty.
+	bool tryPop(T& value) { return popMany(&value, 1) == 1; }
+
+	/// @brief Called by the producer. Pushes as many of the @count values as there is space for.
+	/// @retval the number of values pushed.
+	int pushMany(const T* const values, int count)
+	{
+		const uint32 tail = m_tail.load(std::memory_order_relaxed);
+		const uint32 head = m_head.load(std::memory_order_acquire);
+		const int numFree = capacity() - int(tail - head);
+		const int numToPush = count < numFree ? count : numFree;
+
+		for (int t = 0; t < numToPush; ++t) {
+			m_elements[(tail + uint32(t)) & m_mask] = values[t];
+		}
+
+		m_tail.store(tail + uint32(numToPush), std::memory_order_release);
+		return numToPush;
+	}
+
+	/// @brief Called by the consumer. Pops up to @maxCount values.
+	/// @retval the number of values popped.
+	int popMany(T* const values, int maxCount)
+	{
+		const uint32 head = m_head.load(std::memory_order_relaxed);
+		const uint32 tail = m_tail.load(std::memory_order_acquire);
+		const int numAvailable = int(tail - head);
+		const int numToPop = maxCount < numAvailable ? maxCount : numAvailable;
+
+		for (int t = 0; t < numToPop; ++t) {
+			values[t] = m_elements[(head + uint32(t)) & m_mask];
+		}
+
+		m_head.store(head + uint32(numToPop), std::memory_order_release);
+		return numToPop;
+	}
+
+  private:
+	std::unique_ptr<T[]> m_elements;
+	uint32 m_mask = 0;
+
+	/// The head is written only by the consumer and the tail only by the producer.
+	/// They are on separate cache lines, so the two threads do not invalidate each other's cache on every operation.
+	alignas(64) std::atomic<uint32> m_head = 0;
+	alignas(64) std::atomic<uint32> m_tail = 0;
+};
+
+} // namespace sge
@@ -0,0 +1,193 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace sge {
+
+int ThreadPool::getHardwareConcurrency()
+{
+	const int numHardwareThreads = int(std::thread::hardware_concurrency());
+	return numHardwareThreads > 0 ? numHardwareThreads : 1;
+}
+
+void ThreadPool::create(int numWorkers)
+{
+	destroy();
+
+	if (numWorkers <= 0) {
+		numWorkers = getHardwareConcurrency();
+	}
+
+#ifdef __EMSCRIPTEN__
+	// Web builds are compiled without thread support, everything is executed on the waiting thread.
+	numWorkers = 1;
+#endif
+
+	m_isCreated = true;
+	m_shouldQuit = false;
+
+	// The last queue is for the thread(s) waiting on jobs, the rest are for the worker threads.
+	m_queues.resize(numWorkers);
+	for (std::unique_ptr<WorkerQueue>& queue : m_queues) {
+		queue.reset(new WorkerQueue());
+	}
+
+	m_workers.reserve(numWorkers - 1);
+	for (int iWorker = 0; iWorker < numWorkers - 1; ++iWorker) {
+		m_workers.emplace_back([this, iWorker]() { workerMain(iWorker); });
+	}
+}
+
+void ThreadPool::destroy()
+{
+	if (!m_isCreated) {
+		return;
+	}
+
+	// Finish all jobs that are still waiting.
+	while (tryExecuteOneJob(int(m_queues.size()) - 1)) {
+	}
+
+	{
+		const std::lock_guard<std::mutex> g(m_sleepLock);
+		m_shouldQuit = true;
+	}
+	m_sleepCondition.notify_all();
+
+	for (std::thread& worker : m_workers) {
+		worker.join();
+	}
+
+	m_workers.clear();
+	m_queues.clear();
+	m_numQueuedJobs = 0;
+	m_isCreated = false;
+}
+
+void ThreadPool::enqueue(JobFn job, JobCounter* const counter)
+{
+	if (!job) {
+		return;
+	}
+
+	if (m_isCreated == false) {
+		// The pool isn't running, just execute the job on the calling thread.
+		job();
+		return;
+	}
+
+	if (counter) {
+		counter->numPendingJobs.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	const int iQueue = int(m_nextQueueToPush.fetch_add(1, std::memory_order_relaxed) % unsigned(m_queues.size()));
+	{
+		WorkerQueue& queue = *m_queues[iQueue];
+		const std::lock_guard<std::mutex> g(queue.lock);
+		queue.jobs.emplace_back(std::move(job), counter);
+	}
+
+	// Increment under the lock, so a worker going to sleep cannot miss the job.
+	{
+		const std::lock_guard<std::mutex> g(m_sleepLock);
+		m_numQueuedJobs.fetch_add(1, std::memory_order_relaxed);
+	}
+	m_sleepCondition.notify_one();
+}
+
+void ThreadPool::wait(const JobCounter& counter)
+{
+	const int iWaitingThreadQueue = int(m_queues.size()) - 1;
+	while (!counter.isDone()) {
+		// Instead of blocking help with the jobs.
+		if (m_isCreated == false || tryExecuteOneJob(iWaitingThreadQueue) == false) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+void ThreadPool::parallelFor(int numItems, int chunkSize, const std::function<void(int begin, int end)>& fn)
+{
+	if (numItems <= 0) {
+		return;
+	}
+
+	chunkSize = std::max(1, chunkSize);
+
+	// Do not bother with the workers if there is no one to share the work with.
+	if (m_workers.empty() || numItems <= chunkSize) {
+		fn(0, numItems);
+		return;
+	}
+
+	JobCounter counter;
+	for (int begin = 0; begin < numItems; begin += chunkSize) {
+		const int end = std::min(begin + chunkSize, numItems);
+		enqueue([&fn, begin, end]() { fn(begin, end); }, &counter);
+	}
+
+	wait(counter);
+}
+
+bool ThreadPool::tryExecuteOneJob(int iPreferredQueue)
+{
+	const int numQueues = int(m_queues.size());
+	if (numQueues == 0) {
+		return false;
+	}
+
+	std::pair<JobFn, JobCounter*> job;
+	bool hasJob = false;
+
+	// Take the most recent job from our own queue, if there are none steal the oldest job from the other queues.
+	for (int iStep = 0; iStep < numQueues && !hasJob; ++iStep) {
+		const bool isOwnQueue = iStep == 0;
+		WorkerQueue& queue = *m_queues[(iPreferredQueue + iStep) % numQueues];
+
+		const std::lock_guard<std::mutex> g(queue.lock);
+		if (queue.jobs.empty() == false) {
+			if (isOwnQueue) {
+				job = std::move(queue.jobs.back());
+				queue.jobs.pop_back();
+			}
+			else {
+				job = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+			}
+			hasJob = true;
+		}
+	}
+
+	if (!hasJob) {
+		return false;
+	}
+
+	m_numQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+	job.first();
+	if (job.second) {
+		job.second->numPendingJobs.fetch_sub(1, std::memory_order_release);
+	}
+
+	return true;
+}
+
+void ThreadPool::workerMain(int iWorker)
+{
+	while (true) {
+		if (tryExecuteOneJob(iWorker)) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepLock);
+		m_sleepCondition.wait(lock, [this]() -> bool {
+			return m_shouldQuit || m_numQueuedJobs.load(std::memory_order_relaxed) > 0;
+		});
+
+		if (m_shouldQuit && m_numQueuedJobs.load(std::memory_order_relaxed) == 0) {
+			return;
+		}
+	}
+}
+
+} // namespace sge
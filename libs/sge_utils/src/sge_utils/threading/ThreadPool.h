@@ -0,0 +1,92 @@
+#pragma once
+
+#include "sge_utils/sge_utils.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sge {
+
+/// @brief A counter used to wait for a group of jobs to finish.
+/// Each job submitted with a counter increments it and decrements it when the job is done.
+struct JobCounter {
+	bool isDone() const { return numPendingJobs.load(std::memory_order_acquire) == 0; }
+
+	std::atomic<int> numPendingJobs = 0;
+};
+
+/// @brief ThreadPool is a fixed set of worker threads that execute jobs.
+/// Each worker has its own job queue. Jobs are distributed between the queues in a round-robin manner
+/// and a worker that has run out of jobs steals from the queues of the other workers.
+/// The thread that waits for jobs to finish (see @wait and @parallelFor) is treated as a worker as well,
+/// it executes pending jobs instead of blocking. This means that a pool created with 1 worker has no threads and all
+/// jobs are executed on the waiting thread.
+struct ThreadPool : public NoCopyNoMove {
+	using JobFn = std::function<void()>;
+
+	ThreadPool() = default;
+	explicit ThreadPool(int numWorkers) { create(numWorkers); }
+	~ThreadPool() { destroy(); }
+
+	/// @brief Starts the worker threads.
+	/// @param [in] numWorkers the total amount of threads that will participate in executing jobs,
+	///             including the thread that waits for them. If <= 0 the number of hardware threads is used.
+	void create(int numWorkers);
+
+	/// @brief Waits for all queued jobs to finish and stops the worker threads.
+	void destroy();
+
+	/// @brief Returns the number of threads executing jobs, including the thread that waits for them.
+	int getNumWorkers() const { return int(m_workers.size()) + 1; }
+
+	/// @brief Returns true if the pool has been created.
+	bool isCreated() const { return m_isCreated; }
+
+	/// @brief Adds a job to be executed by the workers.
+	/// @param [in] counter (optional) incremented now and decremented once the job is done. Use it with @wait.
+	void enqueue(JobFn job, JobCounter* const counter = nullptr);
+
+	/// @brief Executes pending jobs on the calling thread until all jobs associated with the counter are done.
+	void wait(const JobCounter& counter);
+
+	/// @brief Splits the range [0, numItems) into chunks of @chunkSize elements, executes @fn for each chunk
+	/// on the workers and waits for all of them to finish.
+	/// @param [in] fn a function called with the [begin, end) range of each chunk.
+	void parallelFor(int numItems, int chunkSize, const std::function<void(int begin, int end)>& fn);
+
+	/// @brief Returns the recommended number of workers for the current machine.
+	static int getHardwareConcurrency();
+
+  private:
+	struct WorkerQueue {
+		std::mutex lock;
+		std::deque<std::pair<JobFn, JobCounter*>> jobs;
+	};
+
+	/// Tries to execute one pending job. Returns false if there weren't any.
+	/// @param [in] iPreferredQueue the queue to check first, other queues are stolen from.
+	bool tryExecuteOneJob(int iPreferredQueue);
+	void workerMain(int iWorker);
+
+  private:
+	bool m_isCreated = false;
+	std::vector<std::thread> m_workers;
+
+	/// One queue per worker thread and one for the waiting thread(s).
+	std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+	std::atomic<unsigned> m_nextQueueToPush = 0;
+
+	/// Used to put the workers to sleep while there is nothing to do.
+	std::mutex m_sleepLock;
+	std::condition_variable m_sleepCondition;
+	std::atomic<int> m_numQueuedJobs = 0;
+	bool m_shouldQuit = false;
+};
+
+} // namespace sge
@@ -0,0 +1,112 @@
+#include "sge_utils/math/BoxBVH.h"
+#include "doctest/doctest.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace sge;
+
+namespace {
+	std::vector<Box3f> generateRandomBoxes(const int numBoxes, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> posDist(-100.f, 100.f);
+		std::uniform_real_distribution<float> sizeDist(0.1f, 3.f);
+
+		std::vector<Box3f> boxes(numBoxes);
+		for (Box3f& box : boxes) {
+			const vec3f center(posDist(rng), posDist(rng), posDist(rng));
+			box = Box3f::getFromHalfDiagonal(vec3f(sizeDist(rng), sizeDist(rng), sizeDist(rng)), center);
+		}
+
+		// Empty boxes must be skipped.
+		boxes[numBoxes / 2] = Box3f();
+
+		return boxes;
+	}
+} // namespace
+
+TEST_CASE("BoxBVH raycast matches brute force")
+{
+	std::mt19937 rng(7);
+	const std::vector<Box3f> boxes = generateRandomBoxes(2000, rng);
+
+	BoxBVH bvh;
+	bvh.build(boxes.data(), int(boxes.size()));
+	REQUIRE(bvh.isEmpty() == false);
+
+	std::uniform_real_distribution<float> dirDist(-1.f, 1.f);
+	bool allMatch = true;
+	for (int iRay = 0; iRay < 200; ++iRay) {
+		const vec3f origin(0.f, 0.f, 0.f);
+		const vec3f dir = normalized(vec3f(dirDist(rng), dirDist(rng), dirDist(rng)) + vec3f(1e-3f));
+
+		// Use the box entry point as an exact intersection.
+		const auto intersectItem = [&](int iItem, float tBoxEnter) -> float { return tBoxEnter; };
+
+		float tBvh = FLT_MAX;
+		const int iBvh = bvh.raycast(origin, dir, intersectItem, &tBvh);
+
+		int iExpected = -1;
+		float tExpected = FLT_MAX;
+		for (int iBox = 0; iBox < int(boxes.size()); ++iBox) {
+			float t0 = 0.f;
+			float t1 = 0.f;
+			if (!boxes[iBox].isEmpty() && boxes[iBox].intersect(origin, dir, t0, t1) && t1 >= 0.f) {
+				const float tEnter = std::max(t0, 0.f);
+				if (tEnter < tExpected) {
+					tExpected = tEnter;
+					iExpected = iBox;
+				}
+			}
+		}
+
+		allMatch &= (iBvh == iExpected);
+		if (iExpected >= 0) {
+			allMatch &= fabsf(tBvh - tExpected) < 1e-3f;
+		}
+	}
+
+	CHECK(allMatch);
+}
+
+TEST_CASE("BoxBVH box and frustum queries match brute force")
+{
+	std::mt19937 rng(11);
+	const std::vector<Box3f> boxes = generateRandomBoxes(2000, rng);
+
+	BoxBVH bvh;
+	bvh.build(boxes.data(), int(boxes.size()), 2);
+
+	const Box3f queryBox(vec3f(-20.f, -10.f, -30.f), vec3f(25.f, 15.f, 5.f));
+	std::vector<int> found;
+	bvh.queryBox(queryBox, [&](int iItem) { found.push_back(iItem); });
+
+	std::vector<int> expected;
+	for (int iBox = 0; iBox < int(boxes.size()); ++iBox) {
+		if (!boxes[iBox].isEmpty() && boxes[iBox].overlaps(queryBox)) {
+			expected.push_back(iBox);
+		}
+	}
+
+	std::sort(found.begin(), found.end());
+	CHECK(found == expected);
+
+	// A camera looking down the -Z axis.
+	const mat4f proj = mat4f::getPerspectiveFovRH(deg2rad(45.f), 1.f, 0.1f, 50.f, 0.f, true);
+	const mat4f view = mat4f::getLookAtRH(vec3f(0.f, 0.f, 60.f), vec3f(0.f), vec3f(0.f, 1.f, 0.f));
+	const Frustum frustum = Frustum::extractClippingPlanes(proj * view, true);
+
+	std::vector<int> foundInFrustum;
+	bvh.queryFrustum(frustum, [&](int iItem) { foundInFrustum.push_back(iItem); });
+
+	std::vector<int> expectedInFrustum;
+	for (int iBox = 0; iBox < int(boxes.size()); ++iBox) {
+		if (!boxes[iBox].isEmpty() && !frustum.isBoxOutside(boxes[iBox])) {
+			expectedInFrustum.push_back(iBox);
+		}
+	}
+
+	std::sort(foundInFrustum.begin(), foundInFrustum.end());
+	CHECK(foundInFrustum.empty() == false);
+	CHECK(foundInFrustum == expectedInFrustum);
+}
@@ -0,0 +1,112 @@
+#include "sge_utils/math/DynamicAABBTree.h"
+#include "doctest/doctest.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace sge;
+
+namespace {
+	Box3f generateRandomBox(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> posDist(-100.f, 100.f);
+		std::uniform_real_distribution<float> sizeDist(0.1f, 3.f);
+
+		const vec3f center(posDist(rng), posDist(rng), posDist(rng));
+		return Box3f::getFromHalfDiagonal(vec3f(sizeDist(rng), sizeDist(rng), sizeDist(rng)), center);
+	}
+} // namespace
+
+TEST_CASE("DynamicAABBTree queries match brute force while modified")
+{
+	std::mt19937 rng(11);
+	std::uniform_int_distribution<int> actionDist(0, 9);
+
+	DynamicAABBTree tree(0.5f);
+
+	// The boxes are indexed by the proxy id.
+	std::vector<Box3f> boxes;
+	std::vector<bool> isAlive;
+
+	for (int iStep = 0; iStep < 5000; ++iStep) {
+		const int action = actionDist(rng);
+		std::vector<int> aliveProxies;
+		for (int t = 0; t < int(isAlive.size()); ++t) {
+			if (isAlive[t]) {
+				aliveProxies.push_back(t);
+			}
+		}
+
+		if (action < 5 || aliveProxies.empty()) {
+			const Box3f box = generateRandomBox(rng);
+			const int proxyId = tree.createProxy(box, nullptr);
+			if (proxyId >= int(boxes.size())) {
+				boxes.resize(proxyId + 1);
+				isAlive.resize(proxyId + 1, false);
+			}
+			REQUIRE(isAlive[proxyId] == false);
+			boxes[proxyId] = box;
+			isAlive[proxyId] = true;
+		}
+		else {
+			const int proxyId = aliveProxies[rng() % aliveProxies.size()];
+			if (action == 5) {
+				// Small movements should not touch the tree.
+				const Box3f movedBox = Box3f(boxes[proxyId].min + vec3f(0.1f), boxes[proxyId].max + vec3f(0.1f));
+				CHECK(tree.moveProxy(proxyId, movedBox) == false);
+			}
+			else if (action < 8) {
+				boxes[proxyId] = generateRandomBox(rng);
+				tree.moveProxy(proxyId, boxes[proxyId]);
+			}
+			else {
+				tree.destroyProxy(proxyId);
+				isAlive[proxyId] = false;
+			}
+		}
+	}
+
+	int numAlive = 0;
+	for (int t = 0; t < int(isAlive.size()); ++t) {
+		numAlive += isAlive[t] ? 1 : 0;
+	}
+	CHECK(tree.getNumProxies() == numAlive);
+
+	// The tree should stay balanced.
+	CHECK(tree.getHeight() <= int(2.f * log2f(float(numAlive)) + 2.f));
+
+	for (int iQuery = 0; iQuery < 100; ++iQuery) {
+		const Box3f queryBox = Box3f::getFromHalfDiagonal(vec3f(15.f), generateRandomBox(rng).center());
+
+		std::vector<int> treeResult;
+		tree.queryBox(queryBox, [&](const int proxyId) -> void { treeResult.push_back(proxyId); });
+		std::sort(treeResult.begin(), treeResult.end());
+
+		std::vector<int> bruteForceResult;
+		for (int t = 0; t < int(isAlive.size()); ++t) {
+			if (isAlive[t] && tree.getFatBox(t).overlaps(queryBox)) {
+				bruteForceResult.push_back(t);
+			}
+		}
+
+		CHECK(treeResult == bruteForceResult);
+	}
+
+	const mat4f view = mat4f::getLookAtRH(vec3f(0.f, 50.f, 150.f), vec3f(0.f), vec3f(0.f, 1.f, 0.f));
+	const mat4f proj = mat4f::getPerspectiveFovRH(deg2rad(45.f), 1.f, 0.1f, 1000.f, 0.f, true);
+	const Frustum frustum = Frustum::extractClippingPlanes(proj * view, true);
+
+	std::vector<int> treeResult;
+	tree.queryFrustum(frustum, [&](const int proxyId) -> void { treeResult.push_back(proxyId); });
+	std::sort(treeResult.begin(), treeResult.end());
+
+	std::vector<int> bruteForceResult;
+	for (int t = 0; t < int(isAlive.size()); ++t) {
+		if (isAlive[t] && frustum.isBoxOutside(tree.getFatBox(t)) == false) {
+			bruteForceResult.push_back(t);
+		}
+	}
+
+	CHECK(treeResult == bruteForceResult);
+	CHECK(treeResult.empty() == false);
+}
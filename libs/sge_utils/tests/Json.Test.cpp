@@ -0,0 +1,154 @@
+#include "sge_utils/io/IStream.h"
+#include "sge_utils/json/json.h"
+#include "doctest/doctest.h"
+
+#include <cstring>
+#include <string>
+
+using namespace sge;
+
+namespace {
+	std::string writeJson(const JsonValue* const root, const bool prettify = false)
+	{
+		WriteStdStringStream wss;
+		JsonWriter writer;
+		writer.write(&wss, root, prettify);
+		return wss.serializedString;
+	}
+} // namespace
+
+TEST_CASE("Json parse values and members")
+{
+	const char* const text =
+	    R"({"name" : "actor\t\"one\"", "id": 42, "scale": -1.5, "visible": true, "hidden": false, )"
+	    R"("position": [1, 2.5, -3], "empty": {}, "emptyArr": [], "child": {"name": "child"}})";
+
+	JsonParser parser;
+	REQUIRE(parser.parse(text, strlen(text)));
+	const JsonValue* const root = parser.getRoot();
+	REQUIRE(root != nullptr);
+	REQUIRE(root->isMap());
+	CHECK(root->numMembers() == 9);
+
+	CHECK(strcmp(root->getMember("name")->GetString(), "actor\t\"one\"") == 0);
+	CHECK(root->getMember("name")->getStringLength() == 11);
+	CHECK(root->getMember("id")->getNumberAs<int>() == 42);
+	CHECK(root->getMember("scale")->getNumberAs<float>() == -1.5f);
+	CHECK(root->getMember("visible")->getAsBool() == true);
+	CHECK(root->getMember("hidden")->getAsBool() == false);
+	CHECK(root->getMember("missing") == nullptr);
+	CHECK_THROWS_AS(root->getMemberOrThrow("missing"), JsonExceptAccess);
+	CHECK_THROWS_AS(root->getMemberOrThrow("id", JID_STRING), JsonExceptAccess);
+	CHECK(root->getMember("empty")->numMembers() == 0);
+	CHECK(root->getMember("emptyArr")->arrSize() == 0);
+
+	float position[3] = {0.f};
+	CHECK(root->getMember("position")->getNumberArrayAs<float>(position, 3));
+	CHECK(position[0] == 1.f);
+	CHECK(position[1] == 2.5f);
+	CHECK(position[2] == -3.f);
+
+	// The members keep their order and the same names share the interned string.
+	CHECK(strcmp(root->getMembers()[0].key, "name") == 0);
+	CHECK(strcmp(root->getMembers()[8].key, "child") == 0);
+	CHECK(root->getMembers()[0].key == root->getMember("child")->getMembers()[0].key);
+
+	// Broken json.
+	const char* const brokenText = R"({"name": "actor", "id": )";
+	CHECK(parser.parse(brokenText, strlen(brokenText)) == false);
+	CHECK(parser.getRoot() == nullptr);
+	CHECK(parser.getErrorMsg() != nullptr);
+}
+
+TEST_CASE("Json big maps")
+{
+	JsonValueBuffer jvb;
+	JsonValue* const jMap = jvb(JID_MAP);
+
+	const int kNumMembers = 1000;
+	for (int t = 0; t < kNumMembers; ++t) {
+		jMap->setMember(("member" + std::to_string(t)).c_str(), jvb(t));
+	}
+
+	// Replace a few members, the count should not change.
+	jMap->setMember("member7", jvb("seven"));
+	jMap->setMember("member700", jvb("seven hundred"));
+
+	CHECK(jMap->numMembers() == kNumMembers);
+	CHECK(strcmp(jMap->getMember("member7")->GetString(), "seven") == 0);
+	CHECK(strcmp(jMap->getMember("member700")->GetString(), "seven hundred") == 0);
+	CHECK(jMap->getMember("member1000") == nullptr);
+
+	bool allFound = true;
+	for (int t = 0; t < kNumMembers; ++t) {
+		if (t == 7 || t == 700) {
+			continue;
+		}
+
+		const JsonValue* const jMember = jMap->getMember(("member" + std::to_string(t)).c_str());
+		allFound &= jMember != nullptr && jMember->getNumberAs<int>() == t;
+	}
+	CHECK(allFound);
+
+	// The same after writing and parsing it again.
+	const std::string json = writeJson(jMap);
+	JsonParser parser;
+	REQUIRE(parser.parse(json.c_str(), json.size()));
+	CHECK(parser.getRoot()->numMembers() == kNumMembers);
+	CHECK(parser.getRoot()->getMember("member999")->getNumberAs<int>() == 999);
+	CHECK(strcmp(parser.getRoot()->getMember("member700")->GetString(), "seven hundred") == 0);
+}
+
+TEST_CASE("Json write, parse and clone round trip")
+{
+	JsonValueBuffer jvb;
+	JsonValue* const jRoot = jvb(JID_MAP);
+	jRoot->setMember("text", jvb("it's a \"quote\"\n\tand a \\ slash"));
+	jRoot->setMember("numbers", jvb(std::vector<int>{1, -2, 3}));
+	jRoot->setMember("names", jvb(std::vector<std::string>{"a", "", "c"}));
+	JsonValue* const jChild = jRoot->setMember("child", jvb(JID_MAP));
+	jChild->setMember("flag", jvb(true));
+
+	const std::string json = writeJson(jRoot);
+
+	for (const bool prettify : {false, true}) {
+		JsonParser parser;
+		const std::string text = writeJson(jRoot, prettify);
+		REQUIRE(parser.parse(text.c_str(), text.size()));
+		CHECK(writeJson(parser.getRoot()) == json);
+	}
+
+	// The clone doesn't depend on the original buffer.
+	JsonValueBuffer cloneBuffer;
+	const JsonValue* jClone = nullptr;
+	{
+		JsonParser parser;
+		REQUIRE(parser.parse(json.c_str(), json.size()));
+		jClone = JsonValue::Clone(*parser.getRoot(), cloneBuffer);
+	}
+	CHECK(writeJson(jClone) == json);
+}
+
+TEST_CASE("Json parse from a stream stops right after the value")
+{
+	// Some files have binary data right after the json, the stream must be left at the beginning of that data.
+	// Make the json bigger than the pieces read from the stream at once.
+	std::string text = "[";
+	for (int t = 0; t < 50000; ++t) {
+		text += (t == 0 ? "" : ",") + std::string("\"value") + std::to_string(t) + "\"";
+	}
+	text += "]";
+	const size_t jsonLength = text.size();
+	text += "BINARY DATA";
+
+	ReadCStringStream stream(text.c_str());
+	JsonParser parser;
+	REQUIRE(parser.parse(&stream));
+	CHECK(stream.pointerOffset() == jsonLength);
+	CHECK(parser.getRoot()->arrSize() == 50000);
+	CHECK(strcmp(parser.getRoot()->arrAt(49999)->GetString(), "value49999") == 0);
+
+	char binaryData[7] = {0};
+	CHECK(stream.read(binaryData, 6) == 6);
+	CHECK(strcmp(binaryData, "BINARY") == 0);
+}
@@ -0,0 +1,71 @@
+#include "doctest/doctest.h"
+#include "sge_utils/threading/MPSCQueue.h"
+
+#include <thread>
+#include <vector>
+using namespace sge;
+
+TEST_CASE("MPSCQueue push and pop until full and empty")
+{
+	MPSCQueue<int> queue(3);
+	CHECK(queue.capacity() == 4);
+	CHECK(queue.isEmpty());
+
+	for (int t = 0; t < 4; ++t) {
+		CHECK(queue.tryPush(t));
+	}
+	CHECK_FALSE(queue.tryPush(4));
+	CHECK(queue.size() == 4);
+
+	int value = -1;
+	CHECK(queue.tryPop(value));
+	CHECK(value == 0);
+
+	// Wraps around the end of the storage.
+	CHECK(queue.tryPush(4));
+	CHECK_FALSE(queue.tryPush(5));
+
+	for (int t = 1; t <= 4; ++t) {
+		CHECK(queue.tryPop(value));
+		CHECK(value == t);
+	}
+	CHECK_FALSE(queue.tryPop(value));
+	CHECK(queue.isEmpty());
+}
+
+TEST_CASE("MPSCQueue many producer threads and one consumer")
+{
+	const int kNumProducers = 4;
+	const int kNumValuesPerProducer = 50000;
+	MPSCQueue<int> queue(64);
+
+	std::vector<std::thread> producers;
+	for (int iProducer = 0; iProducer < kNumProducers; ++iProducer) {
+		producers.emplace_back([&queue, iProducer]() -> void {
+			int next = 0;
+			while (next < kNumValuesPerProducer) {
+				next += queue.tryPush(iProducer * kNumValuesPerProducer + next) ? 1 : 0;
+			}
+		});
+	}
+
+	// The values of each producer should arrive in the order they were pushed.
+	std::vector<int> nextExpected(kNumProducers, 0);
+	bool isInOrder = true;
+	int numPopped = 0;
+	while (numPopped < kNumProducers * kNumValuesPerProducer) {
+		int value = 0;
+		if (queue.tryPop(value)) {
+			const int iProducer = value / kNumValuesPerProducer;
+			isInOrder &= value % kNumValuesPerProducer == nextExpected[iProducer];
+			nextExpected[iProducer]++;
+			numPopped++;
+		}
+	}
+
+	for (std::thread& producer : producers) {
+		producer.join();
+	}
+	CHECK(isInOrder);
+	CHECK(queue.isEmpty());
+}
@@ -0,0 +1,63 @@
+#include "sge_utils/other/RadixSort.h"
+#include "doctest/doctest.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace sge;
+
+TEST_CASE("RadixSort sorts by key and is stable")
+{
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<int> keyDist(0, 0xFFFF);
+
+	const size_t kCount = 10000;
+	std::vector<uint32> values(kCount);
+	std::vector<uint16> keys(kCount);
+	for (size_t t = 0; t < kCount; ++t) {
+		values[t] = uint32(t);
+		// Use a narrow range for half of the elements, so there are many duplicate keys.
+		keys[t] = uint16(t % 2 ? keyDist(rng) : keyDist(rng) % 16);
+	}
+
+	// The reference result, std::stable_sort keeps the order of the values with equal keys.
+	std::vector<std::pair<uint16, uint32>> expected(kCount);
+	for (size_t t = 0; t < kCount; ++t) {
+		expected[t] = std::make_pair(keys[t], values[t]);
+	}
+	std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+	std::vector<uint32> scratchValues;
+	std::vector<uint16> scratchKeys;
+	radixSortByKey16(values.data(), keys.data(), kCount, scratchValues, scratchKeys);
+
+	CHECK(isSortedByKey16(keys.data(), kCount));
+	bool allMatch = true;
+	for (size_t t = 0; t < kCount; ++t) {
+		allMatch &= keys[t] == expected[t].first && values[t] == expected[t].second;
+	}
+	CHECK(allMatch);
+}
+
+TEST_CASE("RadixSort single pass and sorted input")
+{
+	std::vector<uint32> scratchValues;
+	std::vector<uint16> scratchKeys;
+
+	// Only the low byte differs, a single pass is made and the result must still end up in the input arrays.
+	std::vector<uint32> values = {0, 1, 2, 3, 4};
+	std::vector<uint16> keys = {0x0105, 0x0103, 0x0101, 0x0103, 0x0100};
+	radixSortByKey16(values.data(), keys.data(), values.size(), scratchValues, scratchKeys);
+	CHECK(values == std::vector<uint32>{4, 2, 1, 3, 0});
+	CHECK(isSortedByKey16(keys.data(), keys.size()));
+
+	// Already sorted input must not change.
+	std::vector<uint32> sortedValues = {7, 8, 9};
+	std::vector<uint16> sortedKeys = {1, 1, 0x300};
+	radixSortByKey16(sortedValues.data(), sortedKeys.data(), sortedValues.size(), scratchValues, scratchKeys);
+	CHECK(sortedValues == std::vector<uint32>{7, 8, 9});
+
+	CHECK(isSortedByKey16(nullptr, 0));
+	CHECK(isSortedByKey16(keys.data(), 1));
+	CHECK(isSortedByKey16(std::vector<uint16>{2, 1}.data(), 2) == false);
+}
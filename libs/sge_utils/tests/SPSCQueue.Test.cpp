@@ -0,0 +1,62 @@
+#include "doctest/doctest.h"
+#include "sge_utils/threading/SPSCQueue.h"
+
+#include <thread>
+#include <vector>
+using namespace sge;
+
+TEST_CASE("SPSCQueue push and pop until full and empty")
+{
+	SPSCQueue<int> queue(5);
+	CHECK(queue.capacity() == 8);
+	CHECK(queue.isEmpty());
+
+	for (int t = 0; t < 8; ++t) {
+		CHECK(queue.tryPush(t));
+	}
+	CHECK_FALSE(queue.tryPush(8));
+	CHECK(queue.size() == 8);
+
+	int value = -1;
+	CHECK(queue.tryPop(value));
+	CHECK(value == 0);
+
+	// Wraps around the end of the storage.
+	const int values[3] = {8, 9, 10};
+	CHECK(queue.pushMany(values, 3) == 1);
+
+	int popped[16] = {};
+	CHECK(queue.popMany(popped, 16) == 8);
+	for (int t = 0; t < 8; ++t) {
+		CHECK(popped[t] == t + 1);
+	}
+	CHECK_FALSE(queue.tryPop(value));
+}
+
+TEST_CASE("SPSCQueue one producer and one consumer thread")
+{
+	const int kNumValues = 200000;
+	SPSCQueue<int> queue(64);
+
+	std::thread producer([&queue]() -> void {
+		int next = 0;
+		while (next < kNumValues) {
+			next += queue.tryPush(next) ? 1 : 0;
+		}
+	});
+
+	bool isInOrder = true;
+	int expected = 0;
+	while (expected < kNumValues) {
+		int values[16];
+		const int numPopped = queue.popMany(values, 16);
+		for (int t = 0; t < numPopped; ++t) {
+			isInOrder &= values[t] == expected;
+			expected++;
+		}
+	}
+
+	producer.join();
+	CHECK(isInOrder);
+	CHECK(queue.isEmpty());
+}
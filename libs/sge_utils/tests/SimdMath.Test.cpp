@@ -0,0 +1,153 @@
+#include "doctest/doctest.h"
+#include "sge_utils/math/Random.h"
+#include "sge_utils/math/simdMath.h"
+#include "sge_utils/math/transform.h"
+
+#include <cfloat>
+#include <vector>
+using namespace sge;
+
+static quatf randomRotation(Random& rnd)
+{
+	const vec3f axis = vec3f(rnd.nextSnorm(), rnd.nextSnorm(), rnd.nextSnorm()).normalized0();
+	return quatf::getAxisAngle(axis.lengthSqr() > 0.f ? axis : vec3f::getAxis(1), rnd.nextInRange(-sgePi, sgePi));
+}
+
+static bool isMatrixNear(const mat4f& a, const mat4f& b, const float eps)
+{
+	for (int c = 0; c < 4; ++c) {
+		for (int r = 0; r < 4; ++r) {
+			if (std::abs(a.data[c][r] - b.data[c][r]) > eps) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+TEST_CASE("slerpBatch matches slerp")
+{
+	Random rnd;
+
+	// An odd count, so the scalar tail gets tested as well.
+	const int count = 103;
+	std::vector<quatf> from(count), to(count), result(count);
+	std::vector<float> t(count);
+	for (int i = 0; i < count; ++i) {
+		from[i] = randomRotation(rnd);
+		// Some of the pairs are very close, so the nlerp branch gets tested as well.
+		to[i] = (i % 5 == 0) ? normalized(from[i] + quatf(1e-4f, 0.f, 0.f, 0.f)) : randomRotation(rnd);
+		t[i] = rnd.next01();
+	}
+
+	slerpBatch(result.data(), from.data(), to.data(), t.data(), count);
+
+	bool allNear = true;
+	for (int i = 0; i < count; ++i) {
+		const quatf expected = slerp(from[i], to[i], t[i]);
+		// q and -q are the same rotation.
+		allNear &= std::abs(std::abs(expected.dot(result[i])) - 1.f) < 1e-4f;
+	}
+	CHECK(allNear);
+}
+
+TEST_CASE("composeTransformMatricesBatch matches transf3d::toMatrix")
+{
+	Random rnd;
+
+	const int count = 10;
+	std::vector<vec3f> positions(count), scalings(count);
+	std::vector<quatf> rotations(count);
+	std::vector<mat4f> result(count);
+	for (int i = 0; i < count; ++i) {
+		positions[i] = vec3f(rnd.nextSnorm(), rnd.nextSnorm(), rnd.nextSnorm()) * 10.f;
+		rotations[i] = randomRotation(rnd);
+		scalings[i] = vec3f(rnd.nextInRange(0.1f, 2.f), rnd.nextInRange(0.1f, 2.f), rnd.nextInRange(0.1f, 2.f));
+	}
+
+	composeTransformMatricesBatch(result.data(), positions.data(), rotations.data(), scalings.data(), count);
+
+	bool allNear = true;
+	for (int i = 0; i < count; ++i) {
+		const mat4f expected = transf3d(positions[i], rotations[i], scalings[i]).toMatrix();
+		allNear &= isMatrixNear(expected, result[i], 1e-5f);
+	}
+	CHECK(allNear);
+
+	const mat4f product = mulMatricesSimd(result[0], result[1]);
+	CHECK(isMatrixNear(product, result[0] * result[1], 1e-4f));
+}
+
+TEST_CASE("Float array batch functions match the scalar math")
+{
+	Random rnd;
+
+	// An odd count, so the scalar tail gets tested as well.
+	const int count = 103;
+	std::vector<float> x(count), y(count), z(count);
+	std::vector<float> px(count), py(count), pz(count);
+	std::vector<float> age(count), maxLife(count), opacity(count);
+	for (int i = 0; i < count; ++i) {
+		px[i] = rnd.nextSnorm() * 10.f;
+		py[i] = rnd.nextSnorm() * 10.f;
+		pz[i] = rnd.nextSnorm() * 10.f;
+		maxLife[i] = rnd.nextInRange(1.f, 3.f);
+		age[i] = rnd.nextInRange(0.f, maxLife[i]);
+	}
+
+	// One of the positions is at the point, nothing should be added for it.
+	const vec3f point(1.f, 2.f, 3.f);
+	px[7] = point.x;
+	py[7] = point.y;
+	pz[7] = point.z;
+
+	addDirectionsTowardsPointBatch(x.data(), y.data(), z.data(), px.data(), py.data(), pz.data(), point, 2.f, count);
+
+	const mat4f mtx = transf3d(vec3f(5.f), randomRotation(rnd), vec3f(2.f)).toMatrix();
+	transformDirectionsBatch(mtx, x.data(), y.data(), z.data(), count);
+
+	computeFadeInOutBatch(opacity.data(), age.data(), maxLife.data(), 0.5f, 0.7f, count);
+
+	bool allNear = true;
+	for (int i = 0; i < count; ++i) {
+		const vec3f expected = mat_mul_dir(mtx, normalized0(point - vec3f(px[i], py[i], pz[i])) * 2.f);
+		allNear &= (expected - vec3f(x[i], y[i], z[i])).length() < 1e-4f;
+
+		float expectedOpacity = 1.f;
+		if (age[i] < 0.5f) {
+			expectedOpacity *= sqr(age[i] / 0.5f);
+		}
+		if (age[i] > maxLife[i] - 0.7f) {
+			expectedOpacity *= sqr((maxLife[i] - age[i]) / 0.7f);
+		}
+		allNear &= std::abs(expectedOpacity - opacity[i]) < 1e-5f;
+	}
+	CHECK(allNear);
+	CHECK(x[7] == 0.f);
+
+	addScaledBatch(px.data(), x.data(), 0.5f, count);
+	mulBatch(py.data(), 2.f, count);
+	addBatch(pz.data(), 1.f, count);
+
+	float minX = FLT_MAX;
+	float maxX = -FLT_MAX;
+	expandMinMaxBatch(px.data(), count, minX, maxX);
+
+	float expectedMinX = FLT_MAX;
+	float expectedMaxX = -FLT_MAX;
+	for (int i = 0; i < count; ++i) {
+		expectedMinX = std::min(expectedMinX, px[i]);
+		expectedMaxX = std::max(expectedMaxX, px[i]);
+	}
+	CHECK(minX == expectedMinX);
+	CHECK(maxX == expectedMaxX);
+
+	// The x and y arrays used as interleaved stereo frames, an odd number of frames tests the scalar tail.
+	std::vector<float> stereo = x;
+	addScaledStereoBatch(stereo.data(), y.data(), 0.25f, 2.f, count / 2);
+	bool isStereoNear = true;
+	for (int i = 0; i < (count / 2) * 2; ++i) {
+		isStereoNear &= std::abs(stereo[i] - (x[i] + y[i] * (i % 2 == 0 ? 0.25f : 2.f))) < 1e-5f;
+	}
+	CHECK(isStereoNear);
+}
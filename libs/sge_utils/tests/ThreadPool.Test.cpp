@@ -0,0 +1,54 @@
+#include "doctest/doctest.h"
+#include "sge_utils/threading/ThreadPool.h"
+
+#include <vector>
+using namespace sge;
+
+TEST_CASE("ThreadPool parallelFor visits every item once")
+{
+	for (int numWorkers : {1, 2, 4}) {
+		ThreadPool pool(numWorkers);
+		CHECK(pool.getNumWorkers() == numWorkers);
+
+		std::vector<int> visitCount(1000, 0);
+		pool.parallelFor(int(visitCount.size()), 7, [&](int begin, int end) {
+			for (int t = begin; t < end; ++t) {
+				visitCount[t]++;
+			}
+		});
+
+		bool allVisitedOnce = true;
+		for (int count : visitCount) {
+			allVisitedOnce &= count == 1;
+		}
+		CHECK(allVisitedOnce);
+	}
+}
+
+TEST_CASE("ThreadPool wait on counter")
+{
+	ThreadPool pool(3);
+
+	std::atomic<int> sum = 0;
+	JobCounter counter;
+	for (int t = 1; t <= 100; ++t) {
+		pool.enqueue([&sum, t]() { sum += t; }, &counter);
+	}
+
+	pool.wait(counter);
+	CHECK(counter.isDone());
+	CHECK(sum == 5050);
+}
+
+TEST_CASE("ThreadPool not created executes inline")
+{
+	ThreadPool pool;
+	CHECK_FALSE(pool.isCreated());
+
+	int value = 0;
+	pool.enqueue([&value]() { value = 42; });
+	CHECK(value == 42);
+
+	pool.parallelFor(10, 3, [&value](int begin, int end) { value += end - begin; });
+	CHECK(value == 52);
+}
@@ -8,7 +8,7 @@
 
 namespace M4 {
 
-std::string g_hlslParserErrors;
+thread_local std::string g_hlslParserErrors;
 
 // Engine/String.cpp
 
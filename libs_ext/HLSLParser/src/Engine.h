@@ -58,7 +58,8 @@ int String_ToInteger(const char * str, char ** end);
 
 // Engine/Log.h
 
-extern std::string g_hlslParserErrors;
+// Thread local, so multiple shaders could be translated in parallel.
+extern thread_local std::string g_hlslParserErrors;
 
 void Log_Error(const char * format, ...);
 void Log_ErrorArgList(const char * format, va_list args);
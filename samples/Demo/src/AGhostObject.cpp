@@ -33,9 +33,7 @@ struct ACoin : public Actor {
 			return;
 		}
 
-		const auto& itr = getWorld()->m_physicsManifoldList.find(ttRb.getRigidBody());
-
-		if (itr != getWorld()->m_physicsManifoldList.end()) {
+		if (getWorld()->getRigidBodyManifolds(ttRb.getRigidBody()).size() != 0) {
 			getWorld()->objectDelete(getId());
 		}
 	}
@@ -139,10 +137,12 @@ void AGhostObject::onPlayStateChanged(bool const isStartingToPlay)
 void AGhostObject::update(const GameUpdateSets& updateSets)
 {
 	animator.advanceAnimation(updateSets.dt);
-	std::vector<mat4f> transfBones;
-
-	animator.computeModleNodesTrasnforms(transfBones);
-	m_traitModel.m_models[0].customEvalModel->evaluate(transfBones.data(), int(transfBones.size()));
+	// Small or hidden ghosts may skip the evaluation and keep their last pose, but the 1st one is always needed.
+	if (bones.empty() || m_traitModel.shouldEvaluateAnimation(getWorld()->getRenderCamera())) {
+		animator.computeModleNodesTrasnforms(bones);
+		m_traitModel.m_models[0].customEvalModel->evaluate(bones.data(), int(bones.size()));
+		markBBoxDirty();
+	}
 
 	isCharCtrlInputHandled = false;
 	inputWorldSpace = cameraFollowMe.inputToWorldSpace(getWorld(), updateSets.is.GetArrowKeysDir(true, false, 0));
@@ -55,6 +55,8 @@ struct SGE_ENGINE_API AGhostObject : public Actor {
 	GhostAction action;
 	CharacterCtrlKinematic charCtrl;
 	ModelAnimator animator;
+	/// The pose of the model from the last time the animation was evaluated.
+	std::vector<mat4f> bones;
 	CameraFollowMe cameraFollowMe;
 
 	ObjectId cameraId;
@@ -93,9 +93,14 @@ struct AKnight : public Actor {
 			modelAnimator.playTrack(tyAnim_idle);
 		}
 
-		// Compute the skinning animation.
+		// Compute the skinning animation. Small or hidden knights may skip the evaluation and keep their last pose.
 		modelAnimator.advanceAnimation(u.dt);
-		modelAnimator.computeModleNodesTrasnforms(bones);
+		if (bones.empty() || ttModel.shouldEvaluateAnimation(getWorld()->getRenderCamera())) {
+			modelAnimator.computeModleNodesTrasnforms(bones);
+
+			// Set the skinning for the character model.
+			ttModel.m_models[0].customEvalModel->evaluate(bones.data(), int(bones.size()));
+		}
 
 		// Move the attached sword to the parm of the actor.
 		if (palmMeshNodeIndex >= 0) {
@@ -103,8 +108,8 @@ struct AKnight : public Actor {
 			    ttModel.m_models[0].m_additionalTransform * bones[palmMeshNodeIndex];
 		}
 
-		// Set the skinning for the character model.
-		ttModel.m_models[0].customEvalModel->evaluate(bones.data(), int(bones.size()));
+		// The pose and the sword change the bounding box.
+		markBBoxDirty();
 	}
 };
 
@@ -132,6 +132,7 @@ struct Player : public Actor {
 		    mat4f::getRotationQuat(getTransform().r.inverse()) * mat4f::getTranslation(0.f, -0.5f, 0.f) *
 		    mat4f::getSquashyScalingY(squash) * mat4f::getTranslation(0.f, 0.5f, 0.f) *
 		    mat4f::getRotationQuat(getTransform().r);
+		markBBoxDirty();
 	}
 };
 
@@ -22,6 +22,7 @@ __declspec(dllexport) int AmdPowerXpressRequestHighPerformance = 1;
 #include "sge_core/SGEImGui.h"
 #include "sge_core/application/application.h"
 #include "sge_core/setImGuiContexCore.h"
+#include "sge_core/shaders/ShadingProgramPermuator.h"
 #include "sge_core/typelib/typeLib.h"
 #include "sge_engine/EngineGlobal.h"
 #include "sge_engine/IPlugin.h"
@@ -29,6 +30,7 @@ __declspec(dllexport) int AmdPowerXpressRequestHighPerformance = 1;
 #include "sge_engine_ui/windows/AssetsUI/AssetsWindow.h"
 #include "sge_engine_ui/windows/EditorWindow/EditorWindow.h"
 #include "sge_log/Log.h"
+#include "sge_log/LogSinks.h"
 #include "sge_utils/DLL/DLLHandler.h"
 #include "sge_utils/io/FileStream.h"
 #include "sge_utils/json/json.h"
@@ -43,6 +45,7 @@ using namespace sge;
 
 int g_argc = 0;
 char** g_argv = nullptr;
+double g_startupBeginTime = 0.0;
 
 struct SGEGameWindow : public WindowBase {
 	Timer m_timer;
@@ -54,6 +57,7 @@ struct SGEGameWindow : public WindowBase {
 	DummyPlugin dummyPlugin;
 
 	vec2i cachedWindowSize = vec2i(0);
+	bool m_isStartupTimeReported = false;
 
 	void HandleEvent(const WindowEvent event, const void* const eventData) final
 	{
@@ -190,6 +194,10 @@ struct SGEGameWindow : public WindowBase {
 				m_pluginInst = nullptr;
 			}
 
+			// The messages written by the plugin might be formatted by code in its DLL,
+			// process them before unloading it.
+			getLog()->flush();
+
 			// Unload the old plugin DLL and load the new one.
 			m_dllHandler.unload();
 
@@ -262,6 +270,17 @@ struct SGEGameWindow : public WindowBase {
 		getCore()->setLastFrameStatistics(getCore()->getDevice()->getFrameStatistics());
 		getCore()->getDevice()->present();
 
+		// Report how long it took to display the 1st frame and how much of that was spent compiling shaders.
+		if (!m_isStartupTimeReported) {
+			m_isStartupTimeReported = true;
+			const ShadingProgramPermuator::CompilationStats shaderStats = ShadingProgramPermuator::getCompilationStats();
+			sgeLogInfo(
+			    "Editor startup took %.3f seconds. %d shader permutations were compiled in %.3f seconds.\n",
+			    Timer::now_seconds() - g_startupBeginTime,
+			    shaderStats.numPermutations,
+			    shaderStats.wallTimeSeconds);
+		}
+
 		getCore()->getAssetLib()->reloadAssets();
 
 		return;
@@ -281,7 +300,9 @@ void sgeMainLoop()
 
 int sge_main(int argc, char** argv)
 {
+	getLog()->addSink(std::make_shared<LogFileSink>("appdata/log.txt"));
 	sgeLogInfo("sge_main()\n");
+	g_startupBeginTime = Timer::now_seconds();
 
 	// Force the numeric locale to use "." for demical numbers as
 	// we have calls like atof scanf that so on that rely on this.